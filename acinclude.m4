@@ -6,6 +6,33 @@ dnl Function to detect if libvshadow dependencies are available
 AC_DEFUN([AX_LIBVSHADOW_CHECK_LOCAL],
   [dnl Check for internationalization functions in libvshadow/libvshadow_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
+
+  dnl Headers included in libvshadow/libvshadow_store_mapping.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_HEADERS([linux/userfaultfd.h poll.h sys/ioctl.h sys/mman.h sys/syscall.h unistd.h])
+  ])
+
+  dnl Headers included in libvshadow/libvshadow_file_mapping.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_HEADERS([fcntl.h sys/mman.h sys/stat.h unistd.h])
+  ])
+
+  dnl Headers and functions included in libvshadow/libvshadow_shared_cache.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_HEADERS([fcntl.h sys/mman.h sys/stat.h time.h unistd.h])
+    AC_SEARCH_LIBS([shm_open], [rt])
+    AC_CHECK_FUNCS([shm_open shm_unlink])
+  ])
+
+  dnl Functions included in libvshadow/libvshadow_trace.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_SEARCH_LIBS([clock_gettime], [rt])
+    AC_CHECK_FUNCS([clock_gettime])
+  ])
 ])
 
 dnl Function to detect if vshadowtools dependencies are available
@@ -24,6 +51,12 @@ AC_DEFUN([AX_VSHADOWTOOLS_CHECK_LOCAL],
   dnl Headers included in vshadowtools/vshadowmount.c
   AC_CHECK_HEADERS([errno.h sys/time.h])
 
+  dnl Headers included in vshadowtools/nbd_connection.c and vshadowtools/nbd_handle.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_HEADERS([arpa/inet.h netinet/in.h sys/socket.h sys/un.h])
+  ])
+
   dnl Functions included in vshadowtools/mount_file_system.c and vshadowtools/mount_file_entry.c
   AS_IF(
     [test "x$ac_cv_enable_winapi" = xno],
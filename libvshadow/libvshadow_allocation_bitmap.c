@@ -0,0 +1,1236 @@
+/*
+ * Allocation bitmap functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_allocation_bitmap.h"
+#include "libvshadow_io_handle.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcnotify.h"
+#include "libvshadow_ntfs_volume_header.h"
+#include "libvshadow_store_descriptor.h"
+
+#include "vshadow_volume.h"
+
+/* Creates an allocation bitmap
+ * Make sure the value allocation_bitmap is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_allocation_bitmap_initialize(
+     libvshadow_allocation_bitmap_t **allocation_bitmap,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_allocation_bitmap_initialize";
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_bitmap != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid allocation bitmap value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*allocation_bitmap = memory_allocate_structure(
+	                      libvshadow_allocation_bitmap_t );
+
+	if( *allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create allocation bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *allocation_bitmap,
+	     0,
+	     sizeof( libvshadow_allocation_bitmap_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear allocation bitmap.",
+		 function );
+
+		memory_free(
+		 *allocation_bitmap );
+
+		*allocation_bitmap = NULL;
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( *allocation_bitmap != NULL )
+	{
+		memory_free(
+		 *allocation_bitmap );
+
+		*allocation_bitmap = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an allocation bitmap
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_allocation_bitmap_free(
+     libvshadow_allocation_bitmap_t **allocation_bitmap,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_allocation_bitmap_free";
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( *allocation_bitmap != NULL )
+	{
+		if( ( *allocation_bitmap )->bitmap_data != NULL )
+		{
+			memory_free(
+			 ( *allocation_bitmap )->bitmap_data );
+		}
+		memory_free(
+		 *allocation_bitmap );
+
+		*allocation_bitmap = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads (store) data at a specific offset using the block descriptors of the store
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_allocation_bitmap_read_store_data(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int store_descriptor_index,
+     uint8_t *data,
+     size_t data_size,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_allocation_bitmap_read_store_data";
+	ssize_t read_count    = 0;
+
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libvshadow_store_descriptor_read_buffer(
+	              store_descriptor,
+	              io_handle,
+	              file_io_handle,
+	              data,
+	              data_size,
+	              offset,
+	              store_descriptor_index,
+	              error );
+
+	if( read_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ") from store descriptor: %d.",
+		 function,
+		 offset,
+		 offset,
+		 store_descriptor_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Applies the fixup values of a MFT entry
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_allocation_bitmap_apply_fixup_values(
+     uint8_t *mft_entry_data,
+     size_t mft_entry_data_size,
+     libcerror_error_t **error )
+{
+	static char *function           = "libvshadow_allocation_bitmap_apply_fixup_values";
+	size_t fixup_placeholder_offset = 0;
+	uint16_t fixup_value_index      = 0;
+	uint16_t fixup_values_offset    = 0;
+	uint16_t number_of_fixup_values = 0;
+
+	if( mft_entry_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mft_entry_data_size < 42 )
+	 || ( mft_entry_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint16_little_endian(
+	 &( mft_entry_data[ 4 ] ),
+	 fixup_values_offset );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 &( mft_entry_data[ 6 ] ),
+	 number_of_fixup_values );
+
+	if( ( (size_t) fixup_values_offset + ( (size_t) number_of_fixup_values * 2 ) ) > mft_entry_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid fixup values offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The first value is the fixup placeholder value, the remaining values
+	 * replace the last 2 bytes of every 512-byte segment of the MFT entry
+	 */
+	for( fixup_value_index = 1;
+	     fixup_value_index < number_of_fixup_values;
+	     fixup_value_index++ )
+	{
+		fixup_placeholder_offset = ( (size_t) fixup_value_index * 512 ) - 2;
+
+		if( ( fixup_placeholder_offset + 2 ) > mft_entry_data_size )
+		{
+			break;
+		}
+		if( memory_compare(
+		     &( mft_entry_data[ fixup_placeholder_offset ] ),
+		     &( mft_entry_data[ fixup_values_offset ] ),
+		     2 ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISMATCH,
+			 "%s: mismatch in fixup placeholder value: %" PRIu16 ".",
+			 function,
+			 fixup_value_index );
+
+			return( -1 );
+		}
+		mft_entry_data[ fixup_placeholder_offset ]     = mft_entry_data[ fixup_values_offset + ( fixup_value_index * 2 ) ];
+		mft_entry_data[ fixup_placeholder_offset + 1 ] = mft_entry_data[ fixup_values_offset + ( fixup_value_index * 2 ) + 1 ];
+	}
+	return( 1 );
+}
+
+/* Retrieves the unnamed $DATA attribute of a MFT entry
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvshadow_allocation_bitmap_get_data_attribute(
+     const uint8_t *mft_entry_data,
+     size_t mft_entry_data_size,
+     const uint8_t **attribute_data,
+     size_t *attribute_data_size,
+     libcerror_error_t **error )
+{
+	static char *function      = "libvshadow_allocation_bitmap_get_data_attribute";
+	size_t attribute_offset    = 0;
+	uint32_t attribute_size    = 0;
+	uint32_t attribute_type    = 0;
+	uint16_t attributes_offset = 0;
+
+	if( mft_entry_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid MFT entry data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mft_entry_data_size < 42 )
+	 || ( mft_entry_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT entry data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( attribute_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid attribute data.",
+		 function );
+
+		return( -1 );
+	}
+	if( attribute_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid attribute data size.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint16_little_endian(
+	 &( mft_entry_data[ 20 ] ),
+	 attributes_offset );
+
+	attribute_offset = (size_t) attributes_offset;
+
+	while( ( attribute_offset + 16 ) <= mft_entry_data_size )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( mft_entry_data[ attribute_offset ] ),
+		 attribute_type );
+
+		if( attribute_type == 0xffffffffUL )
+		{
+			break;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 &( mft_entry_data[ attribute_offset + 4 ] ),
+		 attribute_size );
+
+		if( ( attribute_size < 16 )
+		 || ( (size_t) attribute_size > ( mft_entry_data_size - attribute_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid attribute size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		/* The $DATA attribute of $Bitmap has no name
+		 */
+		if( ( attribute_type == 0x00000080UL )
+		 && ( mft_entry_data[ attribute_offset + 9 ] == 0 ) )
+		{
+			*attribute_data      = &( mft_entry_data[ attribute_offset ] );
+			*attribute_data_size = (size_t) attribute_size;
+
+			return( 1 );
+		}
+		attribute_offset += attribute_size;
+	}
+	return( 0 );
+}
+
+/* Reads the bitmap data from the $DATA attribute
+ * The data of a non-resident attribute is read using the block descriptors of the store
+ * Returns 1 if successful, 0 if the attribute is not supported or -1 on error
+ */
+int libvshadow_allocation_bitmap_read_data_attribute(
+     libvshadow_allocation_bitmap_t *allocation_bitmap,
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int store_descriptor_index,
+     const uint8_t *attribute_data,
+     size_t attribute_data_size,
+     libcerror_error_t **error )
+{
+	static char *function           = "libvshadow_allocation_bitmap_read_data_attribute";
+	size64_t data_size              = 0;
+	size64_t run_number_of_blocks   = 0;
+	size_t bitmap_data_offset       = 0;
+	size_t data_run_offset          = 0;
+	size_t run_size                 = 0;
+	uint64_t first_vcn              = 0;
+	uint64_t number_of_bitmap_bytes = 0;
+	int64_t cluster_block_number    = 0;
+	int64_t relative_block_number   = 0;
+	uint32_t resident_data_size     = 0;
+	uint16_t data_flags             = 0;
+	uint16_t data_offset            = 0;
+	uint8_t data_run_header         = 0;
+	uint8_t number_of_blocks_size   = 0;
+	uint8_t relative_block_size     = 0;
+	uint8_t value_index             = 0;
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_bitmap->bitmap_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid allocation bitmap - bitmap data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_bitmap->cluster_block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid allocation bitmap - cluster block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( attribute_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid attribute data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( attribute_data_size < 24 )
+	 || ( attribute_data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid attribute data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Compressed data is not supported
+	 */
+	byte_stream_copy_to_uint16_little_endian(
+	 &( attribute_data[ 12 ] ),
+	 data_flags );
+
+	if( ( data_flags & 0x00ff ) != 0 )
+	{
+		return( 0 );
+	}
+	if( attribute_data[ 8 ] == 0 )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( attribute_data[ 16 ] ),
+		 resident_data_size );
+
+		byte_stream_copy_to_uint16_little_endian(
+		 &( attribute_data[ 20 ] ),
+		 data_offset );
+
+		if( ( (size_t) data_offset > attribute_data_size )
+		 || ( (size_t) resident_data_size > ( attribute_data_size - data_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid resident data size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		data_size = (size64_t) resident_data_size;
+	}
+	else
+	{
+		if( attribute_data_size < 64 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid attribute data size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		byte_stream_copy_to_uint64_little_endian(
+		 &( attribute_data[ 16 ] ),
+		 first_vcn );
+
+		byte_stream_copy_to_uint16_little_endian(
+		 &( attribute_data[ 32 ] ),
+		 data_offset );
+
+		byte_stream_copy_to_uint64_little_endian(
+		 &( attribute_data[ 48 ] ),
+		 data_size );
+
+		/* Data that is continued in another MFT entry is not supported
+		 */
+		if( first_vcn != 0 )
+		{
+			return( 0 );
+		}
+		if( (size_t) data_offset > attribute_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid data runs offset value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The bitmap data beyond the last cluster block is not used
+	 */
+	number_of_bitmap_bytes = allocation_bitmap->number_of_cluster_blocks / 8;
+
+	if( ( allocation_bitmap->number_of_cluster_blocks % 8 ) != 0 )
+	{
+		number_of_bitmap_bytes += 1;
+	}
+	if( data_size > number_of_bitmap_bytes )
+	{
+		data_size = number_of_bitmap_bytes;
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size64_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bitmap data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	allocation_bitmap->bitmap_data = (uint8_t *) memory_allocate(
+	                                              sizeof( uint8_t ) * (size_t) data_size );
+
+	if( allocation_bitmap->bitmap_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create bitmap data.",
+		 function );
+
+		goto on_error;
+	}
+	allocation_bitmap->bitmap_data_size = (size_t) data_size;
+
+	/* Bitmap data that is not stored in the data runs is considered allocated
+	 */
+	if( memory_set(
+	     allocation_bitmap->bitmap_data,
+	     0xff,
+	     allocation_bitmap->bitmap_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear bitmap data.",
+		 function );
+
+		goto on_error;
+	}
+	if( attribute_data[ 8 ] == 0 )
+	{
+		if( memory_copy(
+		     allocation_bitmap->bitmap_data,
+		     &( attribute_data[ data_offset ] ),
+		     allocation_bitmap->bitmap_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy resident bitmap data.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+	data_run_offset = (size_t) data_offset;
+
+	while( ( data_run_offset < attribute_data_size )
+	    && ( bitmap_data_offset < allocation_bitmap->bitmap_data_size ) )
+	{
+		data_run_header = attribute_data[ data_run_offset++ ];
+
+		if( data_run_header == 0 )
+		{
+			break;
+		}
+		number_of_blocks_size = data_run_header & 0x0f;
+		relative_block_size   = data_run_header >> 4;
+
+		if( ( number_of_blocks_size == 0 )
+		 || ( number_of_blocks_size > 8 )
+		 || ( relative_block_size > 8 )
+		 || ( (size_t) ( number_of_blocks_size + relative_block_size ) > ( attribute_data_size - data_run_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported data run header: 0x%02" PRIx8 ".",
+			 function,
+			 data_run_header );
+
+			goto on_error;
+		}
+		run_number_of_blocks = 0;
+
+		for( value_index = number_of_blocks_size;
+		     value_index > 0;
+		     value_index-- )
+		{
+			run_number_of_blocks <<= 8;
+			run_number_of_blocks  |= attribute_data[ data_run_offset + value_index - 1 ];
+		}
+		data_run_offset += number_of_blocks_size;
+
+		if( relative_block_size > 0 )
+		{
+			/* The relative block number is a signed value
+			 */
+			relative_block_number = 0;
+
+			if( ( attribute_data[ data_run_offset + relative_block_size - 1 ] & 0x80 ) != 0 )
+			{
+				relative_block_number = -1;
+			}
+			for( value_index = relative_block_size;
+			     value_index > 0;
+			     value_index-- )
+			{
+				relative_block_number = (int64_t) ( ( (uint64_t) relative_block_number << 8 ) | attribute_data[ data_run_offset + value_index - 1 ] );
+			}
+			data_run_offset += relative_block_size;
+
+			if( ( ( relative_block_number > 0 )
+			  &&  ( cluster_block_number > ( INT64_MAX - relative_block_number ) ) )
+			 || ( ( cluster_block_number + relative_block_number ) < 0 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid data run cluster block number value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			cluster_block_number += relative_block_number;
+		}
+		run_size = allocation_bitmap->bitmap_data_size - bitmap_data_offset;
+
+		if( run_number_of_blocks < (size64_t) ( run_size / allocation_bitmap->cluster_block_size ) )
+		{
+			run_size = (size_t) run_number_of_blocks * allocation_bitmap->cluster_block_size;
+		}
+		if( relative_block_size == 0 )
+		{
+			/* A sparse data run contains 0-byte values
+			 */
+			if( memory_set(
+			     &( allocation_bitmap->bitmap_data[ bitmap_data_offset ] ),
+			     0,
+			     run_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear sparse bitmap data.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			if( cluster_block_number > (int64_t) ( INT64_MAX / allocation_bitmap->cluster_block_size ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid data run cluster block number value out of bounds.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvshadow_allocation_bitmap_read_store_data(
+			     store_descriptor,
+			     io_handle,
+			     file_io_handle,
+			     store_descriptor_index,
+			     &( allocation_bitmap->bitmap_data[ bitmap_data_offset ] ),
+			     run_size,
+			     (off64_t) cluster_block_number * allocation_bitmap->cluster_block_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data run.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		bitmap_data_offset += run_size;
+	}
+	return( 1 );
+
+on_error:
+	if( allocation_bitmap->bitmap_data != NULL )
+	{
+		memory_free(
+		 allocation_bitmap->bitmap_data );
+
+		allocation_bitmap->bitmap_data = NULL;
+	}
+	allocation_bitmap->bitmap_data_size = 0;
+
+	return( -1 );
+}
+
+/* Reads the allocation bitmap from the $Bitmap metadata file of the NTFS file system in a store
+ * The data is read using the block descriptors of the store
+ * Returns 1 if successful, 0 if the store does not contain a supported NTFS file system or -1 on error
+ */
+int libvshadow_allocation_bitmap_read_store(
+     libvshadow_allocation_bitmap_t *allocation_bitmap,
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int store_descriptor_index,
+     libcerror_error_t **error )
+{
+	uint8_t ntfs_volume_header_data[ sizeof( vshadow_ntfs_volume_header_t ) ];
+
+	libvshadow_ntfs_volume_header_t *ntfs_volume_header = NULL;
+	const uint8_t *attribute_data                       = NULL;
+	uint8_t *mft_entry_data                             = NULL;
+	static char *function                               = "libvshadow_allocation_bitmap_read_store";
+	size_t attribute_data_size                          = 0;
+	off64_t mft_entry_offset                            = 0;
+	int result                                          = 0;
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_bitmap->bitmap_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid allocation bitmap - bitmap data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_allocation_bitmap_read_store_data(
+	     store_descriptor,
+	     io_handle,
+	     file_io_handle,
+	     store_descriptor_index,
+	     ntfs_volume_header_data,
+	     sizeof( vshadow_ntfs_volume_header_t ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read NTFS volume header data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     ( (vshadow_ntfs_volume_header_t *) ntfs_volume_header_data )->file_system_signature,
+	     "NTFS    ",
+	     8 ) != 0 )
+	{
+		return( 0 );
+	}
+	if( libvshadow_ntfs_volume_header_initialize(
+	     &ntfs_volume_header,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create NTFS volume header.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_ntfs_volume_header_read_data(
+	     ntfs_volume_header,
+	     ntfs_volume_header_data,
+	     sizeof( vshadow_ntfs_volume_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read NTFS volume header.",
+		 function );
+
+		goto on_error;
+	}
+	if( ntfs_volume_header->mft_offset > (off64_t) ( INT64_MAX - ( (off64_t) LIBVSHADOW_ALLOCATION_BITMAP_MFT_ENTRY_INDEX * ntfs_volume_header->mft_entry_size ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT offset value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	mft_entry_offset = ntfs_volume_header->mft_offset
+	                 + ( (off64_t) LIBVSHADOW_ALLOCATION_BITMAP_MFT_ENTRY_INDEX * ntfs_volume_header->mft_entry_size );
+
+	/* The volume size includes the backup NTFS volume header, which is not part of a cluster block
+	 */
+	allocation_bitmap->cluster_block_size       = ntfs_volume_header->cluster_block_size;
+	allocation_bitmap->number_of_cluster_blocks = ( ntfs_volume_header->volume_size - ntfs_volume_header->bytes_per_sector )
+	                                            / ntfs_volume_header->cluster_block_size;
+
+	mft_entry_data = (uint8_t *) memory_allocate(
+	                              sizeof( uint8_t ) * ntfs_volume_header->mft_entry_size );
+
+	if( mft_entry_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create MFT entry data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading $Bitmap MFT entry at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 mft_entry_offset,
+		 mft_entry_offset );
+	}
+#endif
+	if( libvshadow_allocation_bitmap_read_store_data(
+	     store_descriptor,
+	     io_handle,
+	     file_io_handle,
+	     store_descriptor_index,
+	     mft_entry_data,
+	     (size_t) ntfs_volume_header->mft_entry_size,
+	     mft_entry_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read $Bitmap MFT entry data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     mft_entry_data,
+	     "FILE",
+	     4 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported $Bitmap MFT entry signature.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_allocation_bitmap_apply_fixup_values(
+	     mft_entry_data,
+	     (size_t) ntfs_volume_header->mft_entry_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to apply fixup values to $Bitmap MFT entry.",
+		 function );
+
+		goto on_error;
+	}
+	result = libvshadow_allocation_bitmap_get_data_attribute(
+	          mft_entry_data,
+	          (size_t) ntfs_volume_header->mft_entry_size,
+	          &attribute_data,
+	          &attribute_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve $DATA attribute of $Bitmap MFT entry.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		result = libvshadow_allocation_bitmap_read_data_attribute(
+		          allocation_bitmap,
+		          store_descriptor,
+		          io_handle,
+		          file_io_handle,
+		          store_descriptor_index,
+		          attribute_data,
+		          attribute_data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read $DATA attribute of $Bitmap MFT entry.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* Cluster blocks that are not covered by the bitmap data are considered allocated
+	 */
+	if( allocation_bitmap->number_of_cluster_blocks > ( (uint64_t) allocation_bitmap->bitmap_data_size * 8 ) )
+	{
+		allocation_bitmap->number_of_cluster_blocks = (uint64_t) allocation_bitmap->bitmap_data_size * 8;
+	}
+	memory_free(
+	 mft_entry_data );
+
+	mft_entry_data = NULL;
+
+	if( libvshadow_ntfs_volume_header_free(
+	     &ntfs_volume_header,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free NTFS volume header.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( mft_entry_data != NULL )
+	{
+		memory_free(
+		 mft_entry_data );
+	}
+	if( ntfs_volume_header != NULL )
+	{
+		libvshadow_ntfs_volume_header_free(
+		 &ntfs_volume_header,
+		 NULL );
+	}
+	if( allocation_bitmap->bitmap_data != NULL )
+	{
+		memory_free(
+		 allocation_bitmap->bitmap_data );
+
+		allocation_bitmap->bitmap_data = NULL;
+	}
+	allocation_bitmap->bitmap_data_size = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the range of cluster blocks with the same allocation status at a specific offset
+ * The range size is limited to the maximum size
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_allocation_bitmap_get_range_at_offset(
+     libvshadow_allocation_bitmap_t *allocation_bitmap,
+     off64_t offset,
+     size64_t maximum_size,
+     uint8_t *is_allocated,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	static char *function         = "libvshadow_allocation_bitmap_get_range_at_offset";
+	uint64_t cluster_block_number = 0;
+	uint64_t last_block_number    = 0;
+	uint64_t range_end_offset     = 0;
+	uint8_t bitmap_byte           = 0;
+	uint8_t bitmap_value          = 0;
+
+	if( allocation_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid allocation bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_bitmap->cluster_block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid allocation bitmap - cluster block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( allocation_bitmap->number_of_cluster_blocks > ( (uint64_t) allocation_bitmap->bitmap_data_size * 8 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid allocation bitmap - number of cluster blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_size == 0 )
+	 || ( maximum_size > (size64_t) ( INT64_MAX - offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_allocated == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is allocated.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	cluster_block_number = (uint64_t) offset / allocation_bitmap->cluster_block_size;
+
+	if( cluster_block_number >= allocation_bitmap->number_of_cluster_blocks )
+	{
+		*is_allocated = 1;
+		*range_size   = maximum_size;
+
+		return( 1 );
+	}
+	last_block_number = ( (uint64_t) offset + maximum_size + allocation_bitmap->cluster_block_size - 1 )
+	                  / allocation_bitmap->cluster_block_size;
+
+	if( last_block_number > allocation_bitmap->number_of_cluster_blocks )
+	{
+		last_block_number = allocation_bitmap->number_of_cluster_blocks;
+	}
+	bitmap_value = ( allocation_bitmap->bitmap_data[ cluster_block_number / 8 ] >> ( cluster_block_number % 8 ) ) & 0x01;
+
+	/* Whole bitmap bytes with the same value are skipped
+	 */
+	if( bitmap_value != 0 )
+	{
+		bitmap_byte = 0xff;
+	}
+	else
+	{
+		bitmap_byte = 0x00;
+	}
+
+	cluster_block_number++;
+
+	while( cluster_block_number < last_block_number )
+	{
+		if( ( ( cluster_block_number % 8 ) == 0 )
+		 && ( ( cluster_block_number + 8 ) <= last_block_number )
+		 && ( allocation_bitmap->bitmap_data[ cluster_block_number / 8 ] == bitmap_byte ) )
+		{
+			cluster_block_number += 8;
+
+			continue;
+		}
+		if( ( ( allocation_bitmap->bitmap_data[ cluster_block_number / 8 ] >> ( cluster_block_number % 8 ) ) & 0x01 ) != bitmap_value )
+		{
+			break;
+		}
+		cluster_block_number++;
+	}
+	*is_allocated = bitmap_value;
+
+	/* Cluster blocks beyond the bitmap are considered allocated
+	 */
+	if( ( bitmap_value != 0 )
+	 && ( cluster_block_number >= allocation_bitmap->number_of_cluster_blocks ) )
+	{
+		*range_size = maximum_size;
+	}
+	else
+	{
+		range_end_offset = cluster_block_number * allocation_bitmap->cluster_block_size;
+
+		*range_size = (size64_t) ( range_end_offset - (uint64_t) offset );
+
+		if( *range_size > maximum_size )
+		{
+			*range_size = maximum_size;
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,127 @@
+/*
+ * Allocation bitmap functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_ALLOCATION_BITMAP_H )
+#define _LIBVSHADOW_ALLOCATION_BITMAP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_io_handle.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_store_descriptor.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The MFT entry index of the NTFS $Bitmap metadata file
+ */
+#define LIBVSHADOW_ALLOCATION_BITMAP_MFT_ENTRY_INDEX	6
+
+typedef struct libvshadow_allocation_bitmap libvshadow_allocation_bitmap_t;
+
+/* The allocation bitmap contains the allocation status of the cluster blocks
+ * of the NTFS file system in a store, as stored in the $Bitmap metadata file
+ */
+struct libvshadow_allocation_bitmap
+{
+	/* The cluster block size
+	 */
+	uint32_t cluster_block_size;
+
+	/* The number of cluster blocks
+	 * Cluster blocks that are not covered by the bitmap data are considered allocated
+	 */
+	uint64_t number_of_cluster_blocks;
+
+	/* The bitmap data
+	 */
+	uint8_t *bitmap_data;
+
+	/* The bitmap data size
+	 */
+	size_t bitmap_data_size;
+};
+
+int libvshadow_allocation_bitmap_initialize(
+     libvshadow_allocation_bitmap_t **allocation_bitmap,
+     libcerror_error_t **error );
+
+int libvshadow_allocation_bitmap_free(
+     libvshadow_allocation_bitmap_t **allocation_bitmap,
+     libcerror_error_t **error );
+
+int libvshadow_allocation_bitmap_read_store_data(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int store_descriptor_index,
+     uint8_t *data,
+     size_t data_size,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libvshadow_allocation_bitmap_apply_fixup_values(
+     uint8_t *mft_entry_data,
+     size_t mft_entry_data_size,
+     libcerror_error_t **error );
+
+int libvshadow_allocation_bitmap_get_data_attribute(
+     const uint8_t *mft_entry_data,
+     size_t mft_entry_data_size,
+     const uint8_t **attribute_data,
+     size_t *attribute_data_size,
+     libcerror_error_t **error );
+
+int libvshadow_allocation_bitmap_read_data_attribute(
+     libvshadow_allocation_bitmap_t *allocation_bitmap,
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int store_descriptor_index,
+     const uint8_t *attribute_data,
+     size_t attribute_data_size,
+     libcerror_error_t **error );
+
+int libvshadow_allocation_bitmap_read_store(
+     libvshadow_allocation_bitmap_t *allocation_bitmap,
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int store_descriptor_index,
+     libcerror_error_t **error );
+
+int libvshadow_allocation_bitmap_get_range_at_offset(
+     libvshadow_allocation_bitmap_t *allocation_bitmap,
+     off64_t offset,
+     size64_t maximum_size,
+     uint8_t *is_allocated,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_ALLOCATION_BITMAP_H ) */
+
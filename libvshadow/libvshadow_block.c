@@ -102,8 +102,23 @@ int libvshadow_block_initialize(
 
 		goto on_error;
 	}
-	internal_block->block_descriptor = block_descriptor;
+	/* The block descriptor is copied since the block descriptors of a store
+	 * can be freed when they are evicted
+	 */
+	if( libvshadow_block_descriptor_clone(
+	     &( internal_block->block_descriptor ),
+	     block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create block descriptor.",
+		 function );
 
+		goto on_error;
+	}
 	*block = (libvshadow_block_t *) internal_block;
 
 	return( 1 );
@@ -144,6 +159,19 @@ int libvshadow_block_free(
 		internal_block = (libvshadow_internal_block_t *) *block;
 		*block         = NULL;
 
+		if( libvshadow_block_descriptor_free(
+		     &( internal_block->block_descriptor ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free block descriptor.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 internal_block );
 	}
@@ -196,7 +224,8 @@ int libvshadow_block_get_original_offset(
 
 		return( -1 );
 	}
-	*original_offset = internal_block->block_descriptor->original_offset;
+	*original_offset = LIBVSHADOW_BLOCK_DESCRIPTOR_GET_ORIGINAL_OFFSET(
+	                    internal_block->block_descriptor );
 
 	return( 1 );
 }
@@ -247,7 +276,8 @@ int libvshadow_block_get_relative_offset(
 
 		return( -1 );
 	}
-	*relative_offset = internal_block->block_descriptor->relative_offset;
+	*relative_offset = LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET(
+	                    internal_block->block_descriptor );
 
 	return( 1 );
 }
@@ -298,7 +328,8 @@ int libvshadow_block_get_offset(
 
 		return( -1 );
 	}
-	*offset = internal_block->block_descriptor->offset;
+	*offset = LIBVSHADOW_BLOCK_DESCRIPTOR_GET_OFFSET(
+	           internal_block->block_descriptor );
 
 	return( 1 );
 }
@@ -397,9 +428,12 @@ int libvshadow_block_get_values(
 
 		return( -1 );
 	}
-	*original_offset = internal_block->block_descriptor->original_offset;
-	*relative_offset = internal_block->block_descriptor->relative_offset;
-	*offset          = internal_block->block_descriptor->offset;
+	*original_offset = LIBVSHADOW_BLOCK_DESCRIPTOR_GET_ORIGINAL_OFFSET(
+	                    internal_block->block_descriptor );
+	*relative_offset = LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET(
+	                    internal_block->block_descriptor );
+	*offset          = LIBVSHADOW_BLOCK_DESCRIPTOR_GET_OFFSET(
+	                    internal_block->block_descriptor );
 	*flags           = internal_block->block_descriptor->flags;
 	*bitmap          = internal_block->block_descriptor->bitmap;
 
@@ -36,6 +36,12 @@ const uint8_t vshadow_empty_store_block_list_entry[ 32 ] = {
 	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
 	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 
+/* The bit positions for the de Bruijn sequence 0x077cb531
+ */
+const uint8_t libvshadow_block_descriptor_de_bruijn_bit_positions[ 32 ] = {
+	0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8,
+	31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9 };
+
 /* Creates a block descriptor
  * Make sure the value block_descriptor is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -96,9 +102,6 @@ int libvshadow_block_descriptor_initialize(
 
 		goto on_error;
 	}
-	( *block_descriptor )->index         = -1;
-	( *block_descriptor )->reverse_index = -1;
-
 	return( 1 );
 
 on_error:
@@ -120,7 +123,6 @@ int libvshadow_block_descriptor_free(
      libcerror_error_t **error )
 {
 	static char *function = "libvshadow_block_descriptor_free";
-	int result            = 1;
 
 	if( block_descriptor == NULL )
 	{
@@ -135,28 +137,14 @@ int libvshadow_block_descriptor_free(
 	}
 	if( *block_descriptor != NULL )
 	{
-		if( ( *block_descriptor )->overlay != NULL )
-		{
-			if( libvshadow_block_descriptor_free(
-			     &( ( *block_descriptor )->overlay ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free overlay block descriptor.",
-				 function );
-
-				result = -1;
-			}
-		}
+		/* The overlay block descriptor is freed by the forward block tree
+		 */
 		memory_free(
 		 *block_descriptor );
 
 		*block_descriptor = NULL;
 	}
-	return( result );
+	return( 1 );
 }
 
 /* Frees a block descriptor if stored in the reverse block tree only
@@ -167,7 +155,6 @@ int libvshadow_block_descriptor_free_reverse(
      libcerror_error_t **error )
 {
 	static char *function = "libvshadow_block_descriptor_free_reverse";
-	int result            = 1;
 
 	if( block_descriptor == NULL )
 	{
@@ -181,30 +168,14 @@ int libvshadow_block_descriptor_free_reverse(
 		return( -1 );
 	}
 	if( ( *block_descriptor != NULL )
-	 && ( ( *block_descriptor )->index == -1 ) )
+	 && ( ( ( *block_descriptor )->tree_flags & LIBVSHADOW_BLOCK_DESCRIPTOR_TREE_FLAG_IN_FORWARD_TREE ) == 0 ) )
 	{
-		if( ( *block_descriptor )->overlay != NULL )
-		{
-			if( libvshadow_block_descriptor_free(
-			     &( ( *block_descriptor )->overlay ),
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free overlay block descriptor.",
-				 function );
-
-				result = -1;
-			}
-		}
 		memory_free(
 		 *block_descriptor );
 
 		*block_descriptor = NULL;
 	}
-	return( result );
+	return( 1 );
 }
 
 /* Clones a block descriptor
@@ -274,25 +245,10 @@ int libvshadow_block_descriptor_clone(
 
 		goto on_error;
 	}
-	if( source_block_descriptor->overlay != NULL )
-	{
-		if( libvshadow_block_descriptor_clone(
-		     &( ( *destination_block_descriptor )->overlay ),
-		     source_block_descriptor->overlay,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create destination overlay block descriptor.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	( *destination_block_descriptor )->index         = -1;
-	( *destination_block_descriptor )->reverse_index = -1;
+	/* The overlay index refers to the overlay block descriptor of the source
+	 * which remains owned by the forward block tree
+	 */
+	( *destination_block_descriptor )->tree_flags = 0;
 
 	return( 1 );
 
@@ -307,6 +263,125 @@ on_error:
 	return( -1 );
 }
 
+/* Sets the values of the block descriptor
+ * The offsets of a block descriptor that is used must be block aligned,
+ * except for the relative offset of which the lower bits are retained
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_descriptor_set_values(
+     libvshadow_block_descriptor_t *block_descriptor,
+     off64_t original_offset,
+     off64_t relative_offset,
+     off64_t offset,
+     uint32_t flags,
+     uint32_t bitmap,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_descriptor_set_values";
+
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( original_offset < 0 )
+	 || ( original_offset > LIBVSHADOW_BLOCK_DESCRIPTOR_MAXIMUM_OFFSET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid original offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( relative_offset < 0 )
+	 || ( relative_offset > ( LIBVSHADOW_BLOCK_DESCRIPTOR_MAXIMUM_OFFSET + (off64_t) ( LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_SIZE - 1 ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid relative offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( offset > LIBVSHADOW_BLOCK_DESCRIPTOR_MAXIMUM_OFFSET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Flags that are not supported are not retained since the block descriptor
+	 * only has room for the supported flags
+	 */
+	if( ( flags & ~( LIBVSHADOW_BLOCK_DESCRIPTOR_SUPPORTED_FLAGS ) ) != 0 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unsupported flags: 0x%08" PRIx32 ", ignoring unsupported flags.\n",
+			 function,
+			 flags & ~( LIBVSHADOW_BLOCK_DESCRIPTOR_SUPPORTED_FLAGS ) );
+		}
+#endif
+		flags &= LIBVSHADOW_BLOCK_DESCRIPTOR_SUPPORTED_FLAGS;
+	}
+	/* The offsets of a block descriptor that is not used are not validated
+	 * since the block descriptor is ignored
+	 */
+	if( ( flags & LIBVSHADOW_BLOCK_FLAG_NOT_USED ) == 0 )
+	{
+		if( ( original_offset % LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_SIZE ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported original offset: 0x%08" PRIx64 " - value not block aligned.",
+			 function,
+			 original_offset );
+
+			return( -1 );
+		}
+		if( ( offset % LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_SIZE ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported offset: 0x%08" PRIx64 " - value not block aligned.",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+	}
+	block_descriptor->original_block_number     = (uint32_t) ( original_offset >> LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT );
+	block_descriptor->relative_block_number     = (uint32_t) ( relative_offset >> LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT );
+	block_descriptor->relative_offset_remainder = (uint16_t) ( relative_offset % LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_SIZE );
+	block_descriptor->block_number              = (uint32_t) ( offset >> LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT );
+	block_descriptor->flags                     = (uint8_t) flags;
+	block_descriptor->bitmap                    = bitmap;
+
+	return( 1 );
+}
+
 /* Reads the block descriptor
  * Returns 1 if successful, 0 if block list entry is empty or -1 on error
  */
@@ -317,7 +392,12 @@ int libvshadow_block_descriptor_read_data(
      int store_index LIBVSHADOW_ATTRIBUTE_UNUSED,
      libcerror_error_t **error )
 {
-	static char *function = "libvshadow_block_descriptor_read_data";
+	static char *function    = "libvshadow_block_descriptor_read_data";
+	uint64_t offset          = 0;
+	uint64_t original_offset = 0;
+	uint64_t relative_offset = 0;
+	uint32_t bitmap          = 0;
+	uint32_t flags           = 0;
 
 	LIBVSHADOW_UNREFERENCED_PARAMETER( store_index )
 
@@ -377,23 +457,23 @@ int libvshadow_block_descriptor_read_data(
 #endif
 	byte_stream_copy_to_uint64_little_endian(
 	 ( (vshadow_store_block_list_entry_t *) data )->original_offset,
-	 block_descriptor->original_offset );
+	 original_offset );
 
 	byte_stream_copy_to_uint64_little_endian(
 	 ( (vshadow_store_block_list_entry_t *) data )->relative_offset,
-	 block_descriptor->relative_offset );
+	 relative_offset );
 
 	byte_stream_copy_to_uint64_little_endian(
 	 ( (vshadow_store_block_list_entry_t *) data )->offset,
-	 block_descriptor->offset );
+	 offset );
 
 	byte_stream_copy_to_uint32_little_endian(
 	 ( (vshadow_store_block_list_entry_t *) data )->flags,
-	 block_descriptor->flags );
+	 flags );
 
 	byte_stream_copy_to_uint32_little_endian(
 	 ( (vshadow_store_block_list_entry_t *) data )->allocation_bitmap,
-	 block_descriptor->bitmap );
+	 bitmap );
 
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -402,40 +482,40 @@ int libvshadow_block_descriptor_read_data(
 		 "%s: store: %02d original offset\t: 0x%08" PRIx64 "\n",
 		 function,
 		 store_index,
-		 block_descriptor->original_offset );
+		 original_offset );
 
 		libcnotify_printf(
 		 "%s: store: %02d relative offset\t: 0x%08" PRIx64 "\n",
 		 function,
 		 store_index,
-		 block_descriptor->relative_offset );
+		 relative_offset );
 
 		libcnotify_printf(
 		 "%s: store: %02d offset\t\t\t: 0x%08" PRIx64 "\n",
 		 function,
 		 store_index,
-		 block_descriptor->offset );
+		 offset );
 
 		libcnotify_printf(
 		 "%s: store: %02d flags\t\t\t: 0x%08" PRIx32 "\n",
 		 function,
 		 store_index,
-		 block_descriptor->flags );
+		 flags );
 
 		libcnotify_printf(
 		 "%s: store: %02d allocation bitmap\t: 0x%08" PRIx32 "\n",
 		 function,
 		 store_index,
-		 block_descriptor->bitmap );
+		 bitmap );
 
 		libcnotify_printf(
 		 "\n" );
 	}
 #endif /* defined( HAVE_DEBUG_OUTPUT ) */
 
-	if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
+	if( ( flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
 	{
-		if( block_descriptor->offset != 0 )
+		if( offset != 0 )
 		{
 			libcerror_error_set(
 			 error,
@@ -447,6 +527,106 @@ int libvshadow_block_descriptor_read_data(
 			return( -1 );
 		}
 	}
+	if( libvshadow_block_descriptor_set_values(
+	     block_descriptor,
+	     (off64_t) original_offset,
+	     (off64_t) relative_offset,
+	     (off64_t) offset,
+	     flags,
+	     bitmap,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set values.",
+		 function );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
+/* Retrieves the bitmap range at a specific relative block offset
+ * The bitmap range is the part of the block, starting at the relative block offset,
+ * of which the bits in the (allocation) bitmap are either all set or all unset
+ * Returns 1 if the bits of the bitmap range are set, 0 if not or -1 on error
+ */
+int libvshadow_block_descriptor_get_bitmap_range_at_offset(
+     libvshadow_block_descriptor_t *block_descriptor,
+     uint32_t relative_block_offset,
+     size_t *range_size,
+     libcerror_error_t **error )
+{
+	static char *function   = "libvshadow_block_descriptor_get_bitmap_range_at_offset";
+	uint32_t bitmap         = 0;
+	uint32_t number_of_bits = 0;
+	uint32_t sector_index   = 0;
+	int result              = 0;
+
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( relative_block_offset >= LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid relative block offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	sector_index = relative_block_offset / LIBVSHADOW_BLOCK_DESCRIPTOR_BITMAP_SECTOR_SIZE;
+	bitmap       = block_descriptor->bitmap >> sector_index;
+	result       = (int) ( bitmap & 0x00000001UL );
+
+	/* The range ends at the first bit that differs from the bit of the sector
+	 * that contains the relative block offset, which is determined by counting
+	 * the trailing zero bits with a de Bruijn multiplication
+	 */
+	if( result != 0 )
+	{
+		bitmap = ~bitmap;
+	}
+	if( bitmap == 0 )
+	{
+		number_of_bits = 32;
+	}
+	else
+	{
+		number_of_bits = libvshadow_block_descriptor_de_bruijn_bit_positions[ (uint32_t) ( ( bitmap & ( ~bitmap + 1 ) ) * 0x077cb531UL ) >> 27 ];
+	}
+	/* The unset bits shifted in should not extend the range beyond the end of the block
+	 */
+	if( number_of_bits > ( 32 - sector_index ) )
+	{
+		number_of_bits = 32 - sector_index;
+	}
+	*range_size = ( (size_t) number_of_bits * LIBVSHADOW_BLOCK_DESCRIPTOR_BITMAP_SECTOR_SIZE )
+	            - ( relative_block_offset % LIBVSHADOW_BLOCK_DESCRIPTOR_BITMAP_SECTOR_SIZE );
+
+	return( result );
+}
+
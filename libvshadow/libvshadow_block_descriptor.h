@@ -25,47 +25,97 @@
 #include <common.h>
 #include <types.h>
 
+#include "libvshadow_definitions.h"
 #include "libvshadow_libcerror.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The block descriptor offsets are stored as block numbers of 16 KiB blocks
+ */
+#define LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_SIZE			0x00004000UL
+#define LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT		14
+
+/* The maximum offset that can be represented by a block number
+ */
+#define LIBVSHADOW_BLOCK_DESCRIPTOR_MAXIMUM_OFFSET		( (off64_t) UINT32_MAX << LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT )
+
+/* The maximum size of a volume of which all blocks can be represented by a block number
+ */
+#define LIBVSHADOW_BLOCK_DESCRIPTOR_MAXIMUM_VOLUME_SIZE		( (size64_t) LIBVSHADOW_BLOCK_DESCRIPTOR_MAXIMUM_OFFSET + LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_SIZE )
+
+/* The block flags retained by the block descriptor
+ */
+#define LIBVSHADOW_BLOCK_DESCRIPTOR_SUPPORTED_FLAGS \
+	( LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER | LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY | LIBVSHADOW_BLOCK_FLAG_NOT_USED )
+
+/* The (allocation) bitmap of a block descriptor contains a bit per 512 bytes of the block
+ */
+#define LIBVSHADOW_BLOCK_DESCRIPTOR_BITMAP_SECTOR_SIZE		512
+
+/* The block descriptor tree flags
+ */
+#define LIBVSHADOW_BLOCK_DESCRIPTOR_TREE_FLAG_IN_FORWARD_TREE	0x01
+#define LIBVSHADOW_BLOCK_DESCRIPTOR_TREE_FLAG_IN_REVERSE_TREE	0x02
+
+/* Retrieves the original (volume) offset of a block descriptor
+ */
+#define LIBVSHADOW_BLOCK_DESCRIPTOR_GET_ORIGINAL_OFFSET( block_descriptor ) \
+	( (off64_t) ( block_descriptor )->original_block_number << LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT )
+
+/* Retrieves the relative (block) offset of a block descriptor
+ */
+#define LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET( block_descriptor ) \
+	( ( (off64_t) ( block_descriptor )->relative_block_number << LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT ) \
+	 | (off64_t) ( block_descriptor )->relative_offset_remainder )
+
+/* Retrieves the (block) offset of a block descriptor
+ */
+#define LIBVSHADOW_BLOCK_DESCRIPTOR_GET_OFFSET( block_descriptor ) \
+	( (off64_t) ( block_descriptor )->block_number << LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT )
+
 typedef struct libvshadow_block_descriptor libvshadow_block_descriptor_t;
 
+/* The block descriptor is packed into 24 bytes since there is one
+ * for every (copy-on-write) block of every store
+ */
 struct libvshadow_block_descriptor
 {
-	/* The original (volume) offset
-	 */
-	off64_t original_offset;
-
-	/* The (block) offset
+	/* The original (volume) block number
 	 */
-	off64_t offset;
+	uint32_t original_block_number;
 
-	/* The relative (block) offset
+	/* The relative (block) block number
 	 */
-	off64_t relative_offset;
+	uint32_t relative_block_number;
 
-	/* The (block) flags
+	/* The (block) block number
 	 */
-	uint32_t flags;
+	uint32_t block_number;
 
 	/* The (allocation) bitmap
 	 */
 	uint32_t bitmap;
 
-	/* The block index
+	/* The overlay block descriptor index
+	 * Contains the index in the overlay block descriptors array of the forward block tree + 1
+	 * or 0 if the block descriptor has no overlay
 	 */
-	int index;
+	uint32_t overlay_index;
 
-	/* The reverse block index
+	/* The remainder of the relative (block) offset
+	 * The lower bits of the relative offset are used for other purposes
 	 */
-	int reverse_index;
+	uint16_t relative_offset_remainder;
 
-	/* The overlay block descriptor
+	/* The (block) flags
 	 */
-	libvshadow_block_descriptor_t *overlay;
+	uint8_t flags;
+
+	/* The tree flags
+	 */
+	uint8_t tree_flags;
 };
 
 int libvshadow_block_descriptor_initialize(
@@ -85,6 +135,15 @@ int libvshadow_block_descriptor_clone(
      libvshadow_block_descriptor_t *source_block_descriptor,
      libcerror_error_t **error );
 
+int libvshadow_block_descriptor_set_values(
+     libvshadow_block_descriptor_t *block_descriptor,
+     off64_t original_offset,
+     off64_t relative_offset,
+     off64_t offset,
+     uint32_t flags,
+     uint32_t bitmap,
+     libcerror_error_t **error );
+
 int libvshadow_block_descriptor_read_data(
      libvshadow_block_descriptor_t *block_descriptor,
      const uint8_t *data,
@@ -92,6 +151,12 @@ int libvshadow_block_descriptor_read_data(
      int store_index,
      libcerror_error_t **error );
 
+int libvshadow_block_descriptor_get_bitmap_range_at_offset(
+     libvshadow_block_descriptor_t *block_descriptor,
+     uint32_t relative_block_offset,
+     size_t *range_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
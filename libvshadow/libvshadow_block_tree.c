@@ -115,6 +115,20 @@ int libvshadow_block_tree_initialize(
 
 		goto on_error;
 	}
+	if( libcdata_array_initialize(
+	     &( ( *block_tree )->overlay_block_descriptors_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create overlay block descriptors array.",
+		 function );
+
+		goto on_error;
+	}
 	( *block_tree )->leaf_value_size = leaf_value_size;
 
 	return( 1 );
@@ -122,6 +136,13 @@ int libvshadow_block_tree_initialize(
 on_error:
 	if( *block_tree != NULL )
 	{
+		if( ( *block_tree )->root_node != NULL )
+		{
+			libvshadow_block_tree_node_free(
+			 &( ( *block_tree )->root_node ),
+			 NULL,
+			 NULL );
+		}
 		memory_free(
 		 *block_tree );
 
@@ -170,6 +191,20 @@ int libvshadow_block_tree_free(
 
 			result = -1;
 		}
+		if( libcdata_array_free(
+		     &( ( *block_tree )->overlay_block_descriptors_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free overlay block descriptors array.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *block_tree );
 
@@ -561,7 +596,159 @@ int libvshadow_block_tree_remove_block_descriptor_by_offset(
 	return( 1 );
 }
 
+/* Appends an overlay block descriptor to the block tree
+ * The block tree takes over management of the overlay block descriptor
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_block_tree_append_overlay_block_descriptor(
+     libvshadow_block_tree_t *block_tree,
+     libvshadow_block_descriptor_t *overlay_block_descriptor,
+     uint32_t *overlay_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_tree_append_overlay_block_descriptor";
+	int entry_index       = 0;
+
+	if( block_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( overlay_block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid overlay block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( overlay_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid overlay index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_append_entry(
+	     block_tree->overlay_block_descriptors_array,
+	     &entry_index,
+	     (intptr_t *) overlay_block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append overlay block descriptor to array.",
+		 function );
+
+		return( -1 );
+	}
+	overlay_block_descriptor->tree_flags &= ~( LIBVSHADOW_BLOCK_DESCRIPTOR_TREE_FLAG_IN_FORWARD_TREE );
+
+	/* The overlay index is stored + 1 so that 0 represents no overlay
+	 */
+	*overlay_index = (uint32_t) entry_index + 1;
+
+	return( 1 );
+}
+
+/* Retrieves the overlay block descriptor of a specific block descriptor
+ * Returns 1 if successful, 0 if the block descriptor has no overlay or -1 on error
+ */
+int libvshadow_block_tree_get_overlay_block_descriptor(
+     libvshadow_block_tree_t *block_tree,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libvshadow_block_descriptor_t **overlay_block_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_block_tree_get_overlay_block_descriptor";
+
+	if( block_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( overlay_block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid overlay block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor->overlay_index == 0 )
+	{
+		*overlay_block_descriptor = NULL;
+
+		return( 0 );
+	}
+	if( block_descriptor->overlay_index > (uint32_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block descriptor - overlay index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     block_tree->overlay_block_descriptors_array,
+	     (int) block_descriptor->overlay_index - 1,
+	     (intptr_t **) overlay_block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve overlay block descriptor: %" PRIu32 " from array.",
+		 function,
+		 block_descriptor->overlay_index - 1 );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Inserts a block descriptor in the block tree
+ * The reverse block tree is only required for forwarder block descriptors,
+ * if NULL no forwarder block descriptors have been inserted
  * Returns 1 if successful or -1 on error
  */
 int libvshadow_block_tree_insert(
@@ -579,6 +766,8 @@ int libvshadow_block_tree_insert(
 	static char *function                                    = "libvshadow_block_tree_insert";
 	off64_t block_offset                                     = 0;
 	off64_t new_original_offset                              = 0;
+	uint32_t new_original_block_number                       = 0;
+	int leaf_value_index                                     = 0;
 	int result                                               = 0;
 
 	LIBVSHADOW_UNREFERENCED_PARAMETER( store_index )
@@ -594,24 +783,26 @@ int libvshadow_block_tree_insert(
 
 		return( -1 );
 	}
-	if( reverse_block_tree == NULL )
+	if( block_descriptor == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid reverse block tree.",
+		 "%s: invalid block descriptor.",
 		 function );
 
 		return( -1 );
 	}
-	if( block_descriptor == NULL )
+	if( ( reverse_block_tree == NULL )
+	 && ( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_NOT_USED ) == 0 )
+	 && ( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid block descriptor.",
+		 "%s: invalid reverse block tree.",
 		 function );
 
 		return( -1 );
@@ -631,15 +822,18 @@ int libvshadow_block_tree_insert(
 #endif
 		return( 1 );
 	}
-	new_original_offset = block_descriptor->original_offset;
+	new_original_block_number = block_descriptor->original_block_number;
+	new_original_offset       = LIBVSHADOW_BLOCK_DESCRIPTOR_GET_ORIGINAL_OFFSET(
+	                             block_descriptor );
 
-	if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) == 0 )
+	if( ( reverse_block_tree != NULL )
+	 && ( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) == 0 ) )
 	{
 		/* The reverse block tree is used to detect forwarder block descriptors that point to each other
 		 */
 		result = libvshadow_block_tree_get_block_descriptor_by_offset(
 			  reverse_block_tree,
-			  block_descriptor->original_offset,
+			  new_original_offset,
 			  &reverse_block_descriptor,
 			  &block_offset,
 			  error );
@@ -652,8 +846,8 @@ int libvshadow_block_tree_insert(
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
 			 "%s: unable to retrieve reverse block descriptor for offset: %" PRIi64 " (0x%08" PRIx64 ").",
 			 function,
-			 block_descriptor->original_offset,
-			 block_descriptor->original_offset );
+			 new_original_offset,
+			 new_original_offset );
 
 			goto on_error;
 		}
@@ -677,8 +871,8 @@ int libvshadow_block_tree_insert(
 				 "%s: store: %02d found reverse block descriptor: %" PRIi64 " (0x%08" PRIx64 ").\n",
 				 function,
 				 store_index,
-				 reverse_block_descriptor->original_offset,
-				 reverse_block_descriptor->original_offset );
+				 LIBVSHADOW_BLOCK_DESCRIPTOR_GET_ORIGINAL_OFFSET( reverse_block_descriptor ),
+				 LIBVSHADOW_BLOCK_DESCRIPTOR_GET_ORIGINAL_OFFSET( reverse_block_descriptor ) );
 
 				libcnotify_printf(
 				 "%s: store: %02d swapping original offset.\n",
@@ -686,11 +880,13 @@ int libvshadow_block_tree_insert(
 				 store_index );
 			}
 #endif
-			new_original_offset = reverse_block_descriptor->original_offset;
+			new_original_block_number = reverse_block_descriptor->original_block_number;
+			new_original_offset       = LIBVSHADOW_BLOCK_DESCRIPTOR_GET_ORIGINAL_OFFSET(
+			                             reverse_block_descriptor );
 
 			if( libvshadow_block_tree_remove_block_descriptor_by_offset(
 			     reverse_block_tree,
-			     reverse_block_descriptor->relative_offset,
+			     LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET( reverse_block_descriptor ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -699,14 +895,14 @@ int libvshadow_block_tree_insert(
 				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
 				 "%s: unable to remove reverse block descriptor: %" PRIi64 " (0x%08" PRIx64 ") from reverse block tree node.",
 				 function,
-				 reverse_block_descriptor->original_offset,
-				 reverse_block_descriptor->original_offset );
+				 new_original_offset,
+				 new_original_offset );
 
 				goto on_error;
 			}
-			reverse_block_descriptor->reverse_index = -1;
+			reverse_block_descriptor->tree_flags &= ~( LIBVSHADOW_BLOCK_DESCRIPTOR_TREE_FLAG_IN_REVERSE_TREE );
 
-			if( reverse_block_descriptor->index == -1 )
+			if( ( reverse_block_descriptor->tree_flags & LIBVSHADOW_BLOCK_DESCRIPTOR_TREE_FLAG_IN_FORWARD_TREE ) == 0 )
 			{
 				if( libvshadow_block_descriptor_free(
 				     &reverse_block_descriptor,
@@ -726,7 +922,7 @@ int libvshadow_block_tree_insert(
 	}
 	if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
 	{
-		if( new_original_offset == block_descriptor->relative_offset )
+		if( new_original_offset == LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET( block_descriptor ) )
 		{
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
@@ -756,13 +952,13 @@ int libvshadow_block_tree_insert(
 
 		goto on_error;
 	}
-	new_block_descriptor->original_offset = new_original_offset;
+	new_block_descriptor->original_block_number = new_original_block_number;
 
 	result = libvshadow_block_tree_insert_block_descriptor_by_offset(
 		  forward_block_tree,
-	          new_block_descriptor->original_offset,
+	          new_original_offset,
 	          new_block_descriptor,
-	          &( new_block_descriptor->index ),
+	          &leaf_value_index,
 	          &leaf_block_tree_node,
 	          &existing_block_descriptor,
 	          error );
@@ -797,38 +993,49 @@ int libvshadow_block_tree_insert(
 			{
 				overlay_block_descriptor = existing_block_descriptor;
 			}
-			else
+			else if( libvshadow_block_tree_get_overlay_block_descriptor(
+			          forward_block_tree,
+			          existing_block_descriptor,
+			          &overlay_block_descriptor,
+			          error ) == -1 )
 			{
-				overlay_block_descriptor = existing_block_descriptor->overlay;
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve overlay block descriptor.",
+				 function );
+
+				goto on_error;
 			}
 			if( overlay_block_descriptor != NULL )
 			{
 #if defined( HAVE_DEBUG_OUTPUT )
 				if( libcnotify_verbose != 0 )
 				{
-					if( new_block_descriptor->original_offset != overlay_block_descriptor->original_offset )
+					if( new_block_descriptor->original_block_number != overlay_block_descriptor->original_block_number )
 					{
 						libcnotify_printf(
 						 "%s: store: %02d mismatch in block descriptor store original offset (0x%08" PRIx64 ").\n",
 						 function,
 						 store_index,
-						 overlay_block_descriptor->original_offset );
+						 LIBVSHADOW_BLOCK_DESCRIPTOR_GET_ORIGINAL_OFFSET( overlay_block_descriptor ) );
 					}
-					if( new_block_descriptor->offset != overlay_block_descriptor->offset )
+					if( new_block_descriptor->block_number != overlay_block_descriptor->block_number )
 					{
 						libcnotify_printf(
 						 "%s: store: %02d mismatch in block descriptor store offset (0x%08" PRIx64 ").\n",
 						 function,
 						 store_index,
-						 overlay_block_descriptor->offset );
+						 LIBVSHADOW_BLOCK_DESCRIPTOR_GET_OFFSET( overlay_block_descriptor ) );
 					}
-					if( new_block_descriptor->relative_offset != 0x00000001UL )
+					if( LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET( new_block_descriptor ) != 0x00000001UL )
 					{
 						libcnotify_printf(
 						 "%s: store: %02d mismatch in block descriptor relative store offset (0x%08" PRIx64 ").\n",
 						 function,
 						 store_index,
-						 new_block_descriptor->relative_offset );
+						 LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET( new_block_descriptor ) );
 					}
 					libcnotify_printf(
 					 "%s: store: %02d expanding overlay.\n",
@@ -858,13 +1065,13 @@ int libvshadow_block_tree_insert(
 #if defined( HAVE_DEBUG_OUTPUT )
 				if( libcnotify_verbose != 0 )
 				{
-					if( new_block_descriptor->relative_offset == 0x00000001UL )
+					if( LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET( new_block_descriptor ) == 0x00000001UL )
 					{
 						libcnotify_printf(
 						 "%s: store: %02d mismatch in block descriptor relative store offset (0x%08" PRIx64 ").\n",
 						 function,
 						 store_index,
-						 new_block_descriptor->relative_offset );
+						 LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET( new_block_descriptor ) );
 					}
 					libcnotify_printf(
 					 "%s: store: %02d creating overlay.\n",
@@ -872,7 +1079,21 @@ int libvshadow_block_tree_insert(
 					 store_index );
 				}
 #endif
-				existing_block_descriptor->overlay = new_block_descriptor;
+				if( libvshadow_block_tree_append_overlay_block_descriptor(
+				     forward_block_tree,
+				     new_block_descriptor,
+				     &( existing_block_descriptor->overlay_index ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append overlay block descriptor.",
+					 function );
+
+					goto on_error;
+				}
 			}
 #if defined( HAVE_DEBUG_OUTPUT )
 			if( libcnotify_verbose != 0 )
@@ -894,7 +1115,7 @@ int libvshadow_block_tree_insert(
 #endif
 		if( libvshadow_block_tree_node_set_leaf_value_at_offset(
 		     leaf_block_tree_node,
-		     new_block_descriptor->original_offset,
+		     new_original_offset,
 		     new_block_descriptor,
 		     error ) != 1 )
 		{
@@ -904,13 +1125,13 @@ int libvshadow_block_tree_insert(
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
 			 "%s: unable to set leaf value at offset: %" PRIi64 " (0x%08" PRIx64 ").",
 			 function,
-			 new_block_descriptor->original_offset,
-			 new_block_descriptor->original_offset );
+			 new_original_offset,
+			 new_original_offset );
 
 			goto on_error;
 		}
-		new_block_descriptor->index      = existing_block_descriptor->index;
-		existing_block_descriptor->index = -1;
+		new_block_descriptor->tree_flags      |= LIBVSHADOW_BLOCK_DESCRIPTOR_TREE_FLAG_IN_FORWARD_TREE;
+		existing_block_descriptor->tree_flags &= ~( LIBVSHADOW_BLOCK_DESCRIPTOR_TREE_FLAG_IN_FORWARD_TREE );
 
 		if( ( existing_block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
 		{
@@ -923,7 +1144,7 @@ int libvshadow_block_tree_insert(
 				 store_index );
 			}
 #endif
-			if( existing_block_descriptor->overlay != NULL )
+			if( existing_block_descriptor->overlay_index != 0 )
 			{
 				libcerror_error_set(
 				 error,
@@ -934,7 +1155,26 @@ int libvshadow_block_tree_insert(
 
 				goto on_error;
 			}
-			new_block_descriptor->overlay = existing_block_descriptor;
+			/* The new block descriptor is stored in the forward block tree
+			 * so it must be freed by the forward block tree
+			 */
+			if( libvshadow_block_tree_append_overlay_block_descriptor(
+			     forward_block_tree,
+			     existing_block_descriptor,
+			     &( new_block_descriptor->overlay_index ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append existing block descriptor as overlay.",
+				 function );
+
+				new_block_descriptor = NULL;
+
+				goto on_error;
+			}
 		}
 		else
 		{
@@ -949,10 +1189,10 @@ int libvshadow_block_tree_insert(
 #endif
 			/* Swap the overlay block descriptor of the existing block descriptor with the new block descriptor
 			 */
-			new_block_descriptor->overlay      = existing_block_descriptor->overlay;
-			existing_block_descriptor->overlay = NULL;
+			new_block_descriptor->overlay_index      = existing_block_descriptor->overlay_index;
+			existing_block_descriptor->overlay_index = 0;
 
-			if( existing_block_descriptor->reverse_index == -1 )
+			if( ( existing_block_descriptor->tree_flags & LIBVSHADOW_BLOCK_DESCRIPTOR_TREE_FLAG_IN_REVERSE_TREE ) == 0 )
 			{
 				if( libvshadow_block_descriptor_free(
 				     &existing_block_descriptor,
@@ -970,22 +1210,26 @@ int libvshadow_block_tree_insert(
 			}
 		}
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	else if( libcnotify_verbose != 0 )
+	else
 	{
-		libcnotify_printf(
-		 "%s: store: %02d adding block descriptor.\n",
-		 function,
-		 store_index );
-	}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: store: %02d adding block descriptor.\n",
+			 function,
+			 store_index );
+		}
 #endif
+		new_block_descriptor->tree_flags |= LIBVSHADOW_BLOCK_DESCRIPTOR_TREE_FLAG_IN_FORWARD_TREE;
+	}
 	if( ( new_block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
 	{
 		result = libvshadow_block_tree_insert_block_descriptor_by_offset(
 			  reverse_block_tree,
-			  new_block_descriptor->relative_offset,
+			  LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET( new_block_descriptor ),
 			  new_block_descriptor,
-			  &( new_block_descriptor->reverse_index ),
+			  &leaf_value_index,
 			  &leaf_block_tree_node,
 			  &reverse_block_descriptor,
 			  error );
@@ -1025,12 +1269,12 @@ int libvshadow_block_tree_insert(
 				 "%s: store: %02d replacing existing reverse block descriptor: 0x08%" PRIx64 ".\n",
 				 function,
 				 store_index,
-				 reverse_block_descriptor->original_offset );
+				 LIBVSHADOW_BLOCK_DESCRIPTOR_GET_ORIGINAL_OFFSET( reverse_block_descriptor ) );
 			}
 #endif
 			if( libvshadow_block_tree_node_set_leaf_value_at_offset(
 			     leaf_block_tree_node,
-			     new_block_descriptor->relative_offset,
+			     LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET( new_block_descriptor ),
 			     new_block_descriptor,
 			     error ) != 1 )
 			{
@@ -1040,17 +1284,17 @@ int libvshadow_block_tree_insert(
 				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
 				 "%s: unable to set reverse leaf value at offset: %" PRIi64 " (0x%08" PRIx64 ").",
 				 function,
-				 new_block_descriptor->relative_offset,
-				 new_block_descriptor->relative_offset );
+				 LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET( new_block_descriptor ),
+				 LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET( new_block_descriptor ) );
 
 				new_block_descriptor = NULL;
 
 				goto on_error;
 			}
-			new_block_descriptor->reverse_index     = reverse_block_descriptor->reverse_index;
-			reverse_block_descriptor->reverse_index = -1;
+			new_block_descriptor->tree_flags     |= LIBVSHADOW_BLOCK_DESCRIPTOR_TREE_FLAG_IN_REVERSE_TREE;
+			reverse_block_descriptor->tree_flags &= ~( LIBVSHADOW_BLOCK_DESCRIPTOR_TREE_FLAG_IN_REVERSE_TREE );
 
-			if( reverse_block_descriptor->index == -1 )
+			if( ( reverse_block_descriptor->tree_flags & LIBVSHADOW_BLOCK_DESCRIPTOR_TREE_FLAG_IN_FORWARD_TREE ) == 0 )
 			{
 				if( libvshadow_block_descriptor_free(
 				     &reverse_block_descriptor,
@@ -1069,15 +1313,19 @@ int libvshadow_block_tree_insert(
 				}
 			}
 		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		else if( libcnotify_verbose != 0 )
+		else
 		{
-			libcnotify_printf(
-			 "%s: store: %02d adding reverse block descriptor.\n",
-			 function,
-			 store_index );
-		}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: store: %02d adding reverse block descriptor.\n",
+				 function,
+				 store_index );
+			}
 #endif
+			new_block_descriptor->tree_flags |= LIBVSHADOW_BLOCK_DESCRIPTOR_TREE_FLAG_IN_REVERSE_TREE;
+		}
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
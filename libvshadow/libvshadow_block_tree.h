@@ -27,6 +27,7 @@
 
 #include "libvshadow_block_descriptor.h"
 #include "libvshadow_block_tree_node.h"
+#include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 
 #if defined( __cplusplus )
@@ -44,6 +45,11 @@ struct libvshadow_block_tree
 	/* The leaf value size
 	 */
 	size64_t leaf_value_size;
+
+	/* The overlay block descriptors array
+	 * Contains the overlay block descriptors that are not stored as leaf values
+	 */
+	libcdata_array_t *overlay_block_descriptors_array;
 };
 
 int libvshadow_block_tree_initialize(
@@ -80,6 +86,18 @@ int libvshadow_block_tree_remove_block_descriptor_by_offset(
      off64_t offset,
      libcerror_error_t **error );
 
+int libvshadow_block_tree_append_overlay_block_descriptor(
+     libvshadow_block_tree_t *block_tree,
+     libvshadow_block_descriptor_t *overlay_block_descriptor,
+     uint32_t *overlay_index,
+     libcerror_error_t **error );
+
+int libvshadow_block_tree_get_overlay_block_descriptor(
+     libvshadow_block_tree_t *block_tree,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libvshadow_block_descriptor_t **overlay_block_descriptor,
+     libcerror_error_t **error );
+
 int libvshadow_block_tree_insert(
      libvshadow_block_tree_t *forward_block_tree,
      libvshadow_block_tree_t *reverse_block_tree,
@@ -0,0 +1,285 @@
+/*
+ * Data segment functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_data_segment.h"
+#include "libvshadow_definitions.h"
+#include "libvshadow_libcerror.h"
+
+/* Creates a data segment that references data
+ * The data is not owned by the data segment and must remain valid while the data segment is used
+ * Make sure the value data_segment is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_data_segment_initialize(
+     libvshadow_data_segment_t **data_segment,
+     int segment_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_data_segment_initialize";
+
+	if( data_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_segment != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data segment value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( segment_type != LIBVSHADOW_DATA_SEGMENT_TYPE_BUFFER )
+	 && ( segment_type != LIBVSHADOW_DATA_SEGMENT_TYPE_MAPPED )
+	 && ( segment_type != LIBVSHADOW_DATA_SEGMENT_TYPE_ZERO ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported segment type.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*data_segment = memory_allocate_structure(
+	                 libvshadow_data_segment_t );
+
+	if( *data_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *data_segment,
+	     0,
+	     sizeof( libvshadow_data_segment_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data segment.",
+		 function );
+
+		goto on_error;
+	}
+	( *data_segment )->segment_type = segment_type;
+	( *data_segment )->data         = data;
+	( *data_segment )->data_size    = data_size;
+
+	return( 1 );
+
+on_error:
+	if( *data_segment != NULL )
+	{
+		memory_free(
+		 *data_segment );
+
+		*data_segment = NULL;
+	}
+	return( -1 );
+}
+
+/* Creates a data segment that owns a buffer
+ * Make sure the value data_segment is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_data_segment_initialize_with_buffer(
+     libvshadow_data_segment_t **data_segment,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_data_segment_initialize_with_buffer";
+
+	if( data_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_segment != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data segment value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*data_segment = memory_allocate_structure(
+	                 libvshadow_data_segment_t );
+
+	if( *data_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *data_segment,
+	     0,
+	     sizeof( libvshadow_data_segment_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data segment.",
+		 function );
+
+		goto on_error;
+	}
+	( *data_segment )->buffer = (uint8_t *) memory_allocate(
+	                                         sizeof( uint8_t ) * data_size );
+
+	if( ( *data_segment )->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	( *data_segment )->segment_type = LIBVSHADOW_DATA_SEGMENT_TYPE_BUFFER;
+	( *data_segment )->data         = ( *data_segment )->buffer;
+	( *data_segment )->data_size    = data_size;
+
+	return( 1 );
+
+on_error:
+	if( *data_segment != NULL )
+	{
+		memory_free(
+		 *data_segment );
+
+		*data_segment = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a data segment
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_data_segment_free(
+     libvshadow_data_segment_t **data_segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_data_segment_free";
+
+	if( data_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_segment != NULL )
+	{
+		if( ( *data_segment )->buffer != NULL )
+		{
+			memory_free(
+			 ( *data_segment )->buffer );
+		}
+		memory_free(
+		 *data_segment );
+
+		*data_segment = NULL;
+	}
+	return( 1 );
+}
+
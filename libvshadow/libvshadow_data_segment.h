@@ -0,0 +1,77 @@
+/*
+ * Data segment functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_DATA_SEGMENT_H )
+#define _LIBVSHADOW_DATA_SEGMENT_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_data_segment libvshadow_data_segment_t;
+
+struct libvshadow_data_segment
+{
+	/* The segment type
+	 */
+	int segment_type;
+
+	/* The data
+	 */
+	const uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The buffer
+	 * NULL if the data is not owned by the segment
+	 */
+	uint8_t *buffer;
+};
+
+int libvshadow_data_segment_initialize(
+     libvshadow_data_segment_t **data_segment,
+     int segment_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvshadow_data_segment_initialize_with_buffer(
+     libvshadow_data_segment_t **data_segment,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvshadow_data_segment_free(
+     libvshadow_data_segment_t **data_segment,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_DATA_SEGMENT_H ) */
+
@@ -0,0 +1,691 @@
+/*
+ * Data view functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_data_segment.h"
+#include "libvshadow_data_view.h"
+#include "libvshadow_definitions.h"
+#include "libvshadow_libcdata.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_types.h"
+
+/* The zero page that is shared by all zero data segments
+ */
+static const uint8_t libvshadow_data_view_zero_page[ LIBVSHADOW_DATA_VIEW_ZERO_PAGE_SIZE ] = { 0 };
+
+/* Creates a data view
+ * Make sure the value data_view is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_data_view_initialize(
+     libvshadow_data_view_t **data_view,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_data_view_t *internal_data_view = NULL;
+	static char *function                               = "libvshadow_data_view_initialize";
+
+	if( data_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data view.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_view != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data view value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_view = memory_allocate_structure(
+	                      libvshadow_internal_data_view_t );
+
+	if( internal_data_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data view.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_data_view,
+	     0,
+	     sizeof( libvshadow_internal_data_view_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data view.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( internal_data_view->segments_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create segments array.",
+		 function );
+
+		goto on_error;
+	}
+	internal_data_view->offset = offset;
+
+	*data_view = (libvshadow_data_view_t *) internal_data_view;
+
+	return( 1 );
+
+on_error:
+	if( internal_data_view != NULL )
+	{
+		memory_free(
+		 internal_data_view );
+	}
+	return( -1 );
+}
+
+/* Frees a data view
+ * This ends the borrow of the data referenced by the data view
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_data_view_free(
+     libvshadow_data_view_t **data_view,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_data_view_t *internal_data_view = NULL;
+	static char *function                               = "libvshadow_data_view_free";
+	int result                                          = 1;
+
+	if( data_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data view.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_view != NULL )
+	{
+		internal_data_view = (libvshadow_internal_data_view_t *) *data_view;
+		*data_view         = NULL;
+
+		if( libcdata_array_free(
+		     &( internal_data_view->segments_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_data_segment_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free segments array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 internal_data_view );
+	}
+	return( result );
+}
+
+/* Appends a data segment to the data view
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_data_view_append_segment(
+     libvshadow_internal_data_view_t *internal_data_view,
+     libvshadow_data_segment_t *data_segment,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_internal_data_view_append_segment";
+	int entry_index       = 0;
+
+	if( internal_data_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data view.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data segment.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_segment->data_size > ( (size_t) SSIZE_MAX - internal_data_view->size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data segment - data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_append_entry(
+	     internal_data_view->segments_array,
+	     &entry_index,
+	     (intptr_t *) data_segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append data segment to array.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_view->size += data_segment->data_size;
+
+	return( 1 );
+}
+
+/* Appends data that is not owned by the data view
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_data_view_append_data(
+     libvshadow_internal_data_view_t *internal_data_view,
+     int segment_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libvshadow_data_segment_t *data_segment = NULL;
+	static char *function                   = "libvshadow_internal_data_view_append_data";
+	int number_of_segments                  = 0;
+
+	if( internal_data_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data view.",
+		 function );
+
+		return( -1 );
+	}
+	/* Mapped data that directly follows the data of the last segment is merged into it
+	 */
+	if( segment_type == LIBVSHADOW_DATA_SEGMENT_TYPE_MAPPED )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     internal_data_view->segments_array,
+		     &number_of_segments,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of segments.",
+			 function );
+
+			return( -1 );
+		}
+		if( number_of_segments > 0 )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     internal_data_view->segments_array,
+			     number_of_segments - 1,
+			     (intptr_t **) &data_segment,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve data segment: %d.",
+				 function,
+				 number_of_segments - 1 );
+
+				return( -1 );
+			}
+			if( ( data_segment != NULL )
+			 && ( data_segment->segment_type == LIBVSHADOW_DATA_SEGMENT_TYPE_MAPPED )
+			 && ( data == &( data_segment->data[ data_segment->data_size ] ) )
+			 && ( data_size <= ( (size_t) SSIZE_MAX - internal_data_view->size ) ) )
+			{
+				data_segment->data_size  += data_size;
+				internal_data_view->size += data_size;
+
+				return( 1 );
+			}
+			data_segment = NULL;
+		}
+	}
+	if( libvshadow_data_segment_initialize(
+	     &data_segment,
+	     segment_type,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_internal_data_view_append_segment(
+	     internal_data_view,
+	     data_segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append data segment.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( data_segment != NULL )
+	{
+		libvshadow_data_segment_free(
+		 &data_segment,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Appends zero data that references the shared zero page
+ * Zero data larger than the zero page is split into multiple data segments
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_data_view_append_zero_data(
+     libvshadow_internal_data_view_t *internal_data_view,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_internal_data_view_append_zero_data";
+	size_t segment_size   = 0;
+
+	while( data_size > 0 )
+	{
+		segment_size = data_size;
+
+		if( segment_size > LIBVSHADOW_DATA_VIEW_ZERO_PAGE_SIZE )
+		{
+			segment_size = LIBVSHADOW_DATA_VIEW_ZERO_PAGE_SIZE;
+		}
+		if( libvshadow_internal_data_view_append_data(
+		     internal_data_view,
+		     LIBVSHADOW_DATA_SEGMENT_TYPE_ZERO,
+		     libvshadow_data_view_zero_page,
+		     segment_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append zero data.",
+			 function );
+
+			return( -1 );
+		}
+		data_size -= segment_size;
+	}
+	return( 1 );
+}
+
+/* Appends a buffer that is owned by the data view
+ * The buffer is returned so that it can be filled by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_data_view_append_buffer(
+     libvshadow_internal_data_view_t *internal_data_view,
+     size_t buffer_size,
+     uint8_t **buffer,
+     libcerror_error_t **error )
+{
+	libvshadow_data_segment_t *data_segment = NULL;
+	static char *function                   = "libvshadow_internal_data_view_append_buffer";
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_data_segment_initialize_with_buffer(
+	     &data_segment,
+	     buffer_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data segment.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_internal_data_view_append_segment(
+	     internal_data_view,
+	     data_segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append data segment.",
+		 function );
+
+		goto on_error;
+	}
+	*buffer = data_segment->buffer;
+
+	return( 1 );
+
+on_error:
+	if( data_segment != NULL )
+	{
+		libvshadow_data_segment_free(
+		 &data_segment,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the offset of the data view relative to the start of the store
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_data_view_get_offset(
+     libvshadow_data_view_t *data_view,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_data_view_t *internal_data_view = NULL;
+	static char *function                               = "libvshadow_data_view_get_offset";
+
+	if( data_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data view.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_view = (libvshadow_internal_data_view_t *) data_view;
+
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	*offset = internal_data_view->offset;
+
+	return( 1 );
+}
+
+/* Retrieves the size of the data view
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_data_view_get_size(
+     libvshadow_data_view_t *data_view,
+     size_t *size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_data_view_t *internal_data_view = NULL;
+	static char *function                               = "libvshadow_data_view_get_size";
+
+	if( data_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data view.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_view = (libvshadow_internal_data_view_t *) data_view;
+
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	*size = internal_data_view->size;
+
+	return( 1 );
+}
+
+/* Retrieves the number of segments
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_data_view_get_number_of_segments(
+     libvshadow_data_view_t *data_view,
+     int *number_of_segments,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_data_view_t *internal_data_view = NULL;
+	static char *function                               = "libvshadow_data_view_get_number_of_segments";
+
+	if( data_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data view.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_view = (libvshadow_internal_data_view_t *) data_view;
+
+	if( libcdata_array_get_number_of_entries(
+	     internal_data_view->segments_array,
+	     number_of_segments,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific segment
+ * The segment type contains a LIBVSHADOW_DATA_SEGMENT_TYPE value
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_data_view_get_segment_by_index(
+     libvshadow_data_view_t *data_view,
+     int segment_index,
+     int *segment_type,
+     const uint8_t **segment_data,
+     size_t *segment_data_size,
+     libcerror_error_t **error )
+{
+	libvshadow_data_segment_t *data_segment             = NULL;
+	libvshadow_internal_data_view_t *internal_data_view = NULL;
+	static char *function                               = "libvshadow_data_view_get_segment_by_index";
+
+	if( data_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data view.",
+		 function );
+
+		return( -1 );
+	}
+	internal_data_view = (libvshadow_internal_data_view_t *) data_view;
+
+	if( segment_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment type.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment data.",
+		 function );
+
+		return( -1 );
+	}
+	if( segment_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid segment data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     internal_data_view->segments_array,
+	     segment_index,
+	     (intptr_t **) &data_segment,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data segment: %d.",
+		 function,
+		 segment_index );
+
+		return( -1 );
+	}
+	if( data_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing data segment: %d.",
+		 function,
+		 segment_index );
+
+		return( -1 );
+	}
+	*segment_type      = data_segment->segment_type;
+	*segment_data      = data_segment->data;
+	*segment_data_size = data_segment->data_size;
+
+	return( 1 );
+}
+
@@ -0,0 +1,128 @@
+/*
+ * Data view functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_INTERNAL_DATA_VIEW_H )
+#define _LIBVSHADOW_INTERNAL_DATA_VIEW_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_data_segment.h"
+#include "libvshadow_extern.h"
+#include "libvshadow_libcdata.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the shared zero page referenced by zero data segments
+ */
+#define LIBVSHADOW_DATA_VIEW_ZERO_PAGE_SIZE		65536
+
+/* The maximum size of a buffer data segment
+ */
+#define LIBVSHADOW_DATA_VIEW_MAXIMUM_BUFFER_SIZE	( 16 * 1024 * 1024 )
+
+typedef struct libvshadow_internal_data_view libvshadow_internal_data_view_t;
+
+struct libvshadow_internal_data_view
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The segments array
+	 */
+	libcdata_array_t *segments_array;
+};
+
+int libvshadow_data_view_initialize(
+     libvshadow_data_view_t **data_view,
+     off64_t offset,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_data_view_free(
+     libvshadow_data_view_t **data_view,
+     libcerror_error_t **error );
+
+int libvshadow_internal_data_view_append_segment(
+     libvshadow_internal_data_view_t *internal_data_view,
+     libvshadow_data_segment_t *data_segment,
+     libcerror_error_t **error );
+
+int libvshadow_internal_data_view_append_data(
+     libvshadow_internal_data_view_t *internal_data_view,
+     int segment_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvshadow_internal_data_view_append_zero_data(
+     libvshadow_internal_data_view_t *internal_data_view,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvshadow_internal_data_view_append_buffer(
+     libvshadow_internal_data_view_t *internal_data_view,
+     size_t buffer_size,
+     uint8_t **buffer,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_data_view_get_offset(
+     libvshadow_data_view_t *data_view,
+     off64_t *offset,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_data_view_get_size(
+     libvshadow_data_view_t *data_view,
+     size_t *size,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_data_view_get_number_of_segments(
+     libvshadow_data_view_t *data_view,
+     int *number_of_segments,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_data_view_get_segment_by_index(
+     libvshadow_data_view_t *data_view,
+     int segment_index,
+     int *segment_type,
+     const uint8_t **segment_data,
+     size_t *segment_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_INTERNAL_DATA_VIEW_H ) */
+
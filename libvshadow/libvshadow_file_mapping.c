@@ -0,0 +1,1057 @@
+/*
+ * File memory mapping functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#include "libvshadow_file_mapping.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libclocale.h"
+#include "libvshadow_libcnotify.h"
+#include "libvshadow_libcthreads.h"
+#include "libvshadow_libuna.h"
+
+#if defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#endif /* defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT ) */
+
+/* Creates a file mapping
+ * Make sure the value file_mapping is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_file_mapping_initialize(
+     libvshadow_file_mapping_t **file_mapping,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_file_mapping_initialize";
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_mapping != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file mapping value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*file_mapping = memory_allocate_structure(
+	                 libvshadow_file_mapping_t );
+
+	if( *file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file mapping.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *file_mapping,
+	     0,
+	     sizeof( libvshadow_file_mapping_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file mapping.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *file_mapping )->access_pattern_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize access pattern mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *file_mapping != NULL )
+	{
+		memory_free(
+		 *file_mapping );
+
+		*file_mapping = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a file mapping
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_file_mapping_free(
+     libvshadow_file_mapping_t **file_mapping,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_file_mapping_free";
+	int result            = 1;
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_mapping != NULL )
+	{
+		if( ( *file_mapping )->data != NULL )
+		{
+			if( libvshadow_file_mapping_close(
+			     *file_mapping,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file mapping.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *file_mapping )->access_pattern_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free access pattern mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *file_mapping );
+
+		*file_mapping = NULL;
+	}
+	return( result );
+}
+
+/* Opens a file mapping of a regular file
+ * Returns 1 if successful, 0 if the file cannot be mapped or -1 on error
+ */
+int libvshadow_file_mapping_open(
+     libvshadow_file_mapping_t *file_mapping,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_file_mapping_open";
+
+#if defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+	struct stat file_statistics;
+
+	void *data          = NULL;
+	int file_descriptor = -1;
+#endif
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_mapping->data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file mapping - data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( fstat(
+	     file_descriptor,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 errno,
+		 "%s: unable to retrieve file statistics.",
+		 function );
+
+		goto on_error;
+	}
+	/* Only regular files that fit in the address space are mapped
+	 */
+	if( !S_ISREG( file_statistics.st_mode )
+	 || ( file_statistics.st_size <= 0 )
+	 || ( (uint64_t) file_statistics.st_size > (uint64_t) SSIZE_MAX ) )
+	{
+		close(
+		 file_descriptor );
+
+		return( 0 );
+	}
+	data = mmap(
+	        NULL,
+	        (size_t) file_statistics.st_size,
+	        PROT_READ,
+	        MAP_SHARED,
+	        file_descriptor,
+	        0 );
+
+	if( data == MAP_FAILED )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 errno,
+		 "%s: unable to map file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	/* The mapping remains valid after the file descriptor has been closed
+	 */
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close file: %s.",
+		 function,
+		 filename );
+
+		file_descriptor = -1;
+
+		goto on_error;
+	}
+	file_mapping->data                       = (uint8_t *) data;
+	file_mapping->data_size                  = (size_t) file_statistics.st_size;
+	file_mapping->last_read_end_offset       = -1;
+	file_mapping->number_of_sequential_reads = 0;
+	file_mapping->number_of_random_reads     = 0;
+
+	/* Metadata and file system structures are read at random offsets
+	 */
+	if( libvshadow_file_mapping_advise(
+	     file_mapping,
+	     LIBVSHADOW_FILE_MAPPING_ACCESS_PATTERN_RANDOM,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to advise access pattern.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_mapping->data != NULL )
+	{
+		munmap(
+		 file_mapping->data,
+		 file_mapping->data_size );
+
+		file_mapping->data      = NULL;
+		file_mapping->data_size = 0;
+	}
+	else if( data != NULL )
+	{
+		munmap(
+		 data,
+		 (size_t) file_statistics.st_size );
+	}
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	return( -1 );
+#else
+	return( 0 );
+#endif /* defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT ) */
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Opens a file mapping of a regular file
+ * The filename is converted to a narrow string using the codepage of the locale
+ * Returns 1 if successful, 0 if the file cannot be mapped or -1 on error
+ */
+int libvshadow_file_mapping_open_wide(
+     libvshadow_file_mapping_t *file_mapping,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_file_mapping_open_wide";
+
+#if defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+	char *narrow_filename       = NULL;
+	size_t filename_size        = 0;
+	size_t narrow_filename_size = 0;
+	int result                  = 0;
+#endif
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+	filename_size = wide_string_length(
+	                 filename ) + 1;
+
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf8_string_size_from_utf32(
+		          (libuna_utf32_character_t *) filename,
+		          filename_size,
+		          &narrow_filename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf8_string_size_from_utf16(
+		          (libuna_utf16_character_t *) filename,
+		          filename_size,
+		          &narrow_filename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_byte_stream_size_from_utf32(
+		          (libuna_utf32_character_t *) filename,
+		          filename_size,
+		          libclocale_codepage,
+		          &narrow_filename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_byte_stream_size_from_utf16(
+		          (libuna_utf16_character_t *) filename,
+		          filename_size,
+		          libclocale_codepage,
+		          &narrow_filename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine narrow filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( narrow_filename_size == 0 )
+	 || ( narrow_filename_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid narrow filename size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	narrow_filename = narrow_string_allocate(
+	                   narrow_filename_size );
+
+	if( narrow_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create narrow filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libclocale_codepage == 0 )
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_utf8_string_copy_from_utf32(
+		          (libuna_utf8_character_t *) narrow_filename,
+		          narrow_filename_size,
+		          (libuna_utf32_character_t *) filename,
+		          filename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_utf8_string_copy_from_utf16(
+		          (libuna_utf8_character_t *) narrow_filename,
+		          narrow_filename_size,
+		          (libuna_utf16_character_t *) filename,
+		          filename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	else
+	{
+#if SIZEOF_WCHAR_T == 4
+		result = libuna_byte_stream_copy_from_utf32(
+		          (uint8_t *) narrow_filename,
+		          narrow_filename_size,
+		          libclocale_codepage,
+		          (libuna_utf32_character_t *) filename,
+		          filename_size,
+		          error );
+#elif SIZEOF_WCHAR_T == 2
+		result = libuna_byte_stream_copy_from_utf16(
+		          (uint8_t *) narrow_filename,
+		          narrow_filename_size,
+		          libclocale_codepage,
+		          (libuna_utf16_character_t *) filename,
+		          filename_size,
+		          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set narrow filename.",
+		 function );
+
+		goto on_error;
+	}
+	result = libvshadow_file_mapping_open(
+	          file_mapping,
+	          narrow_filename,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file mapping.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 narrow_filename );
+
+	return( result );
+
+on_error:
+	if( narrow_filename != NULL )
+	{
+		memory_free(
+		 narrow_filename );
+	}
+	return( -1 );
+#else
+	return( 0 );
+#endif /* defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT ) */
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Closes a file mapping
+ * Returns 0 if successful or -1 on error
+ */
+int libvshadow_file_mapping_close(
+     libvshadow_file_mapping_t *file_mapping,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_file_mapping_close";
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+	if( file_mapping->data != NULL )
+	{
+		if( munmap(
+		     file_mapping->data,
+		     file_mapping->data_size ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to unmap file.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	file_mapping->data      = NULL;
+	file_mapping->data_size = 0;
+
+	return( 0 );
+}
+
+/* Advises the kernel about the access pattern of the file mapping
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_file_mapping_advise(
+     libvshadow_file_mapping_t *file_mapping,
+     int access_pattern,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_file_mapping_advise";
+
+#if defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+	int advice            = 0;
+#endif
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_pattern != LIBVSHADOW_FILE_MAPPING_ACCESS_PATTERN_RANDOM )
+	 && ( access_pattern != LIBVSHADOW_FILE_MAPPING_ACCESS_PATTERN_SEQUENTIAL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access pattern.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+	if( file_mapping->data != NULL )
+	{
+		if( access_pattern == LIBVSHADOW_FILE_MAPPING_ACCESS_PATTERN_SEQUENTIAL )
+		{
+			advice = MADV_SEQUENTIAL;
+		}
+		else
+		{
+			advice = MADV_RANDOM;
+		}
+		/* The advice is only a hint, hence a failure is not considered an error
+		 */
+		if( madvise(
+		     file_mapping->data,
+		     file_mapping->data_size,
+		     advice ) != 0 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to advise access pattern: %d.\n",
+				 function,
+				 access_pattern );
+			}
+#endif
+		}
+	}
+	__atomic_store_n(
+	 &( file_mapping->access_pattern ),
+	 access_pattern,
+	 __ATOMIC_RELAXED );
+#else
+	file_mapping->access_pattern = access_pattern;
+#endif
+	return( 1 );
+}
+
+/* Updates the access pattern of the file mapping based on a read
+ * Switches to sequential read-ahead after a number of consecutive reads and back
+ * to random access after the same number of consecutive non-sequential reads,
+ * so that interleaved reads of concurrent readers do not change the advice on every read
+ * The read counters are updated atomically and the access pattern mutex is only
+ * grabbed when the access pattern changes
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_file_mapping_update_access_pattern(
+     libvshadow_file_mapping_t *file_mapping,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function          = "libvshadow_file_mapping_update_access_pattern";
+
+#if defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+	off64_t last_read_end_offset   = 0;
+	size_t page_offset             = 0;
+	long page_size                 = 0;
+	int access_pattern             = 0;
+	int current_access_pattern     = 0;
+	int number_of_random_reads     = 0;
+	int number_of_sequential_reads = 0;
+	int result                     = 1;
+#endif
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+	last_read_end_offset = __atomic_exchange_n(
+	                        &( file_mapping->last_read_end_offset ),
+	                        offset + (off64_t) size,
+	                        __ATOMIC_RELAXED );
+
+	/* The counters stop at the threshold, concurrent reads can exceed it
+	 * by the number of readers which does not affect the comparisons below
+	 */
+	if( offset == last_read_end_offset )
+	{
+		number_of_sequential_reads = __atomic_load_n(
+		                              &( file_mapping->number_of_sequential_reads ),
+		                              __ATOMIC_RELAXED );
+
+		if( number_of_sequential_reads < LIBVSHADOW_FILE_MAPPING_SEQUENTIAL_READ_THRESHOLD )
+		{
+			number_of_sequential_reads = __atomic_add_fetch(
+			                              &( file_mapping->number_of_sequential_reads ),
+			                              1,
+			                              __ATOMIC_RELAXED );
+		}
+		__atomic_store_n(
+		 &( file_mapping->number_of_random_reads ),
+		 0,
+		 __ATOMIC_RELAXED );
+	}
+	else
+	{
+		number_of_random_reads = __atomic_load_n(
+		                          &( file_mapping->number_of_random_reads ),
+		                          __ATOMIC_RELAXED );
+
+		if( number_of_random_reads < LIBVSHADOW_FILE_MAPPING_SEQUENTIAL_READ_THRESHOLD )
+		{
+			number_of_random_reads = __atomic_add_fetch(
+			                          &( file_mapping->number_of_random_reads ),
+			                          1,
+			                          __ATOMIC_RELAXED );
+		}
+		__atomic_store_n(
+		 &( file_mapping->number_of_sequential_reads ),
+		 0,
+		 __ATOMIC_RELAXED );
+	}
+	current_access_pattern = __atomic_load_n(
+	                          &( file_mapping->access_pattern ),
+	                          __ATOMIC_RELAXED );
+
+	access_pattern = current_access_pattern;
+
+	if( number_of_sequential_reads >= LIBVSHADOW_FILE_MAPPING_SEQUENTIAL_READ_THRESHOLD )
+	{
+		access_pattern = LIBVSHADOW_FILE_MAPPING_ACCESS_PATTERN_SEQUENTIAL;
+	}
+	else if( number_of_random_reads >= LIBVSHADOW_FILE_MAPPING_SEQUENTIAL_READ_THRESHOLD )
+	{
+		access_pattern = LIBVSHADOW_FILE_MAPPING_ACCESS_PATTERN_RANDOM;
+	}
+	if( access_pattern != current_access_pattern )
+	{
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     file_mapping->access_pattern_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab access pattern mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		/* Another reader could have changed the access pattern in the meantime
+		 */
+		if( access_pattern != file_mapping->access_pattern )
+		{
+			if( libvshadow_file_mapping_advise(
+			     file_mapping,
+			     access_pattern,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to advise access pattern.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     file_mapping->access_pattern_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release access pattern mutex.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+	/* Ask the kernel to read ahead the pages of large random reads
+	 */
+	if( ( result == 1 )
+	 && ( access_pattern == LIBVSHADOW_FILE_MAPPING_ACCESS_PATTERN_RANDOM )
+	 && ( size >= LIBVSHADOW_FILE_MAPPING_WILL_NEED_READ_SIZE ) )
+	{
+		page_size = sysconf(
+		             _SC_PAGESIZE );
+
+		if( page_size > 0 )
+		{
+			page_offset = (size_t) offset % (size_t) page_size;
+
+			madvise(
+			 &( file_mapping->data[ offset - page_offset ] ),
+			 size + page_offset,
+			 MADV_WILLNEED );
+		}
+	}
+	return( result );
+#else
+	return( 1 );
+#endif /* defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT ) */
+}
+
+/* Reads data at a specific offset from the file mapping
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_file_mapping_read_buffer_at_offset(
+         libvshadow_file_mapping_t *file_mapping,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libvshadow_file_mapping_read_buffer_at_offset";
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_mapping->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file mapping - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (uint64_t) offset >= (uint64_t) file_mapping->data_size )
+	{
+		return( 0 );
+	}
+	if( size > ( file_mapping->data_size - (size_t) offset ) )
+	{
+		size = file_mapping->data_size - (size_t) offset;
+	}
+	if( libvshadow_file_mapping_update_access_pattern(
+	     file_mapping,
+	     offset,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update access pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     buffer,
+	     &( file_mapping->data[ offset ] ),
+	     size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy data.",
+		 function );
+
+		return( -1 );
+	}
+	return( (ssize_t) size );
+}
+
+/* Retrieves a pointer to the data at a specific offset in the file mapping
+ * The data remains valid until the file mapping is closed
+ * Returns 1 if successful, 0 if the offset is outside the file mapping or -1 on error
+ */
+int libvshadow_file_mapping_get_data_at_offset(
+     libvshadow_file_mapping_t *file_mapping,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_file_mapping_get_data_at_offset";
+
+	if( file_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_mapping->data == NULL )
+	 || ( (uint64_t) offset >= (uint64_t) file_mapping->data_size ) )
+	{
+		return( 0 );
+	}
+	*data      = &( file_mapping->data[ offset ] );
+	*data_size = file_mapping->data_size - (size_t) offset;
+
+	return( 1 );
+}
+
@@ -0,0 +1,151 @@
+/*
+ * File memory mapping functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_FILE_MAPPING_H )
+#define _LIBVSHADOW_FILE_MAPPING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* Files are mapped read-only into memory using mmap
+ * The access pattern is tracked using the GCC atomic built-in functions
+ */
+#if defined( __GNUC__ ) && defined( HAVE_SYS_MMAN_H ) && defined( HAVE_SYS_STAT_H ) && defined( HAVE_FCNTL_H ) && defined( HAVE_UNISTD_H )
+#define HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT
+#endif
+
+/* The number of consecutive sequential reads after which the access pattern
+ * of a file mapping is considered sequential, and the number of consecutive
+ * non-sequential reads after which it is considered random again
+ */
+#define LIBVSHADOW_FILE_MAPPING_SEQUENTIAL_READ_THRESHOLD	8
+
+/* The minimum size of a read for which the kernel is asked
+ * to read ahead the corresponding pages
+ */
+#define LIBVSHADOW_FILE_MAPPING_WILL_NEED_READ_SIZE		( 1024 * 1024 )
+
+enum LIBVSHADOW_FILE_MAPPING_ACCESS_PATTERNS
+{
+	LIBVSHADOW_FILE_MAPPING_ACCESS_PATTERN_RANDOM		= 0,
+	LIBVSHADOW_FILE_MAPPING_ACCESS_PATTERN_SEQUENTIAL	= 1
+};
+
+typedef struct libvshadow_file_mapping libvshadow_file_mapping_t;
+
+struct libvshadow_file_mapping
+{
+	/* The mapped data
+	 */
+	uint8_t *data;
+
+	/* The mapped data size
+	 */
+	size_t data_size;
+
+	/* The access pattern the kernel was advised about
+	 */
+	int access_pattern;
+
+	/* The end offset of the last read
+	 */
+	off64_t last_read_end_offset;
+
+	/* The number of consecutive sequential reads
+	 */
+	int number_of_sequential_reads;
+
+	/* The number of consecutive non-sequential reads
+	 */
+	int number_of_random_reads;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	/* The access pattern mutex
+	 * Serializes changes of the access pattern, the read counters are updated atomically
+	 */
+	libcthreads_mutex_t *access_pattern_mutex;
+#endif
+};
+
+int libvshadow_file_mapping_initialize(
+     libvshadow_file_mapping_t **file_mapping,
+     libcerror_error_t **error );
+
+int libvshadow_file_mapping_free(
+     libvshadow_file_mapping_t **file_mapping,
+     libcerror_error_t **error );
+
+int libvshadow_file_mapping_open(
+     libvshadow_file_mapping_t *file_mapping,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+int libvshadow_file_mapping_open_wide(
+     libvshadow_file_mapping_t *file_mapping,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libvshadow_file_mapping_close(
+     libvshadow_file_mapping_t *file_mapping,
+     libcerror_error_t **error );
+
+int libvshadow_file_mapping_advise(
+     libvshadow_file_mapping_t *file_mapping,
+     int access_pattern,
+     libcerror_error_t **error );
+
+int libvshadow_file_mapping_update_access_pattern(
+     libvshadow_file_mapping_t *file_mapping,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error );
+
+ssize_t libvshadow_file_mapping_read_buffer_at_offset(
+         libvshadow_file_mapping_t *file_mapping,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+int libvshadow_file_mapping_get_data_at_offset(
+     libvshadow_file_mapping_t *file_mapping,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_FILE_MAPPING_H ) */
+
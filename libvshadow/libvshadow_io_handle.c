@@ -29,14 +29,17 @@
 #include "libvshadow_block_tree_node.h"
 #include "libvshadow_debug.h"
 #include "libvshadow_definitions.h"
+#include "libvshadow_file_mapping.h"
 #include "libvshadow_io_handle.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcnotify.h"
+#include "libvshadow_libcthreads.h"
 #include "libvshadow_libfdatetime.h"
 #include "libvshadow_libfguid.h"
 #include "libvshadow_store_descriptor.h"
+#include "libvshadow_trace.h"
 
 #include "vshadow_catalog.h"
 #include "vshadow_volume.h"
@@ -104,6 +107,21 @@ int libvshadow_io_handle_initialize(
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *io_handle )->metadata_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize metadata mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	( *io_handle )->block_size = 0x4000;
 
 	return( 1 );
@@ -127,6 +145,7 @@ int libvshadow_io_handle_free(
      libcerror_error_t **error )
 {
 	static char *function = "libvshadow_io_handle_free";
+	int result            = 1;
 
 	if( io_handle == NULL )
 	{
@@ -141,22 +160,43 @@ int libvshadow_io_handle_free(
 	}
 	if( *io_handle != NULL )
 	{
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *io_handle )->metadata_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free metadata mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *io_handle );
 
 		*io_handle = NULL;
 	}
-	return( 1 );
+	return( result );
 }
 
 /* Clears the IO handle
+ * The metadata memory limit and the metadata mutex are retained
  * Returns 1 if successful or -1 on error
  */
 int libvshadow_io_handle_clear(
      libvshadow_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libvshadow_io_handle_clear";
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_t *metadata_mutex = NULL;
+#endif
+
+	static char *function          = "libvshadow_io_handle_clear";
+	size64_t metadata_memory_limit = 0;
 
 	if( io_handle == NULL )
 	{
@@ -169,6 +209,11 @@ int libvshadow_io_handle_clear(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	metadata_mutex = io_handle->metadata_mutex;
+#endif
+	metadata_memory_limit = io_handle->metadata_memory_limit;
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -183,26 +228,26 @@ int libvshadow_io_handle_clear(
 
 		return( -1 );
 	}
-	io_handle->block_size = 0x4000;
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	io_handle->metadata_mutex = metadata_mutex;
+#endif
+	io_handle->metadata_memory_limit = metadata_memory_limit;
+	io_handle->block_size            = 0x4000;
 
 	return( 1 );
 }
 
-/* Checks if this is the first time the block is being read
+/* Sets the maximum size of the resident block metadata of the stores
+ * A value of 0 represents no maximum
  * Returns 1 if successful or -1 on error
  */
-int libvshadow_io_handle_check_if_block_first_read(
+int libvshadow_io_handle_set_metadata_memory_limit(
      libvshadow_io_handle_t *io_handle,
-     libvshadow_block_tree_t *block_tree,
-     off64_t block_offset,
+     size64_t metadata_memory_limit,
      libcerror_error_t **error )
 {
-	libvshadow_block_descriptor_t *existing_block_descriptor = NULL;
-	libvshadow_block_descriptor_t *new_block_descriptor      = NULL;
-	libvshadow_block_tree_node_t *leaf_block_tree_node       = NULL;
-	static char *function                                    = "libvshadow_io_handle_check_if_block_first_read";
-	int leaf_value_index                                     = 0;
-	int result                                               = 0;
+	static char *function = "libvshadow_io_handle_set_metadata_memory_limit";
+	int result            = 1;
 
 	if( io_handle == NULL )
 	{
@@ -215,21 +260,1055 @@ int libvshadow_io_handle_check_if_block_first_read(
 
 		return( -1 );
 	}
-	if( libvshadow_block_descriptor_initialize(
-	     &new_block_descriptor,
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->metadata_mutex,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create block descriptor.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab metadata mutex.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+#endif
+	io_handle->metadata_memory_limit = metadata_memory_limit;
+
+	if( libvshadow_io_handle_evict_store_metadata(
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to evict store metadata.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->metadata_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release metadata mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the (estimated) size of the resident block metadata of the stores
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_io_handle_get_metadata_memory_size(
+     libvshadow_io_handle_t *io_handle,
+     size64_t *metadata_memory_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_io_handle_get_metadata_memory_size";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_memory_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata memory size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->metadata_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab metadata mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*metadata_memory_size = io_handle->metadata_memory_size;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->metadata_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release metadata mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the number of times the block metadata of a store was evicted
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_io_handle_get_number_of_metadata_evictions(
+     libvshadow_io_handle_t *io_handle,
+     uint64_t *number_of_metadata_evictions,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_io_handle_get_number_of_metadata_evictions";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_metadata_evictions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of metadata evictions.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->metadata_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab metadata mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*number_of_metadata_evictions = io_handle->number_of_metadata_evictions;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->metadata_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release metadata mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Grabs the block metadata of a store descriptor for use
+ * Block metadata that is in use is not evicted
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_io_handle_grab_store_metadata(
+     libvshadow_io_handle_t *io_handle,
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_io_handle_grab_store_metadata";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->metadata_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab metadata mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	store_descriptor->metadata_use_count += 1;
+
+	/* Move the store descriptor to the front of the most recently used list
+	 */
+	if( ( store_descriptor->metadata_is_resident != 0 )
+	 && ( io_handle->most_recently_used_store_descriptor != store_descriptor ) )
+	{
+		libvshadow_io_handle_unlink_store_metadata(
+		 io_handle,
+		 store_descriptor );
+
+		libvshadow_io_handle_link_store_metadata(
+		 io_handle,
+		 store_descriptor );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->metadata_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release metadata mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Adds the block metadata of a store descriptor, that was grabbed for use,
+ * to the resident block metadata if it was (re)read
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_io_handle_add_store_metadata(
+     libvshadow_io_handle_t *io_handle,
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_io_handle_add_store_metadata";
+	int result            = 1;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
 	}
-	new_block_descriptor->offset = block_offset;
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->metadata_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab metadata mutex.",
+		 function );
 
+		return( -1 );
+	}
+#endif
+	if( ( store_descriptor->metadata_is_resident == 0 )
+	 && ( store_descriptor->block_descriptors_read != 0 ) )
+	{
+		if( libvshadow_store_descriptor_get_block_descriptors_size(
+		     store_descriptor,
+		     &( store_descriptor->metadata_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block descriptors size.",
+			 function );
+
+			result = -1;
+		}
+		else
+		{
+			libvshadow_io_handle_link_store_metadata(
+			 io_handle,
+			 store_descriptor );
+
+			store_descriptor->metadata_is_resident = 1;
+
+			io_handle->metadata_memory_size += store_descriptor->metadata_size;
+		}
+	}
+	if( result == 1 )
+	{
+		if( libvshadow_io_handle_evict_store_metadata(
+		     io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to evict store metadata.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->metadata_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release metadata mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Releases the block metadata of a store descriptor that was grabbed for use
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_io_handle_release_store_metadata(
+     libvshadow_io_handle_t *io_handle,
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_io_handle_release_store_metadata";
+	int result            = 1;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     io_handle->metadata_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab metadata mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( store_descriptor->metadata_use_count > 0 )
+	{
+		store_descriptor->metadata_use_count -= 1;
+	}
+	if( libvshadow_io_handle_evict_store_metadata(
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to evict store metadata.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     io_handle->metadata_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release metadata mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Evicts the block metadata of the least recently used store descriptors
+ * until the resident block metadata no longer exceeds the metadata memory limit
+ * Block metadata that is in use is not evicted. Since no other thread can
+ * access the block metadata of a store descriptor that is not in use,
+ * the store descriptor does not need to be locked.
+ * The caller must hold the metadata mutex
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_io_handle_evict_store_metadata(
+     libvshadow_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	libvshadow_store_descriptor_t *more_recently_used_store_descriptor = NULL;
+	libvshadow_store_descriptor_t *store_descriptor                    = NULL;
+	static char *function                                              = "libvshadow_io_handle_evict_store_metadata";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->metadata_memory_limit == 0 )
+	{
+		return( 1 );
+	}
+	store_descriptor = io_handle->least_recently_used_store_descriptor;
+
+	while( ( store_descriptor != NULL )
+	    && ( io_handle->metadata_memory_size > io_handle->metadata_memory_limit ) )
+	{
+		more_recently_used_store_descriptor = store_descriptor->more_recently_used_store_descriptor;
+
+		if( store_descriptor->metadata_use_count == 0 )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: evicting block metadata of store: %02d of size: %" PRIu64 "\n",
+				 function,
+				 store_descriptor->index,
+				 store_descriptor->metadata_size );
+			}
+#endif
+			if( libvshadow_store_descriptor_free_block_descriptors(
+			     store_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free block descriptors of store: %d.",
+				 function,
+				 store_descriptor->index );
+
+				return( -1 );
+			}
+			libvshadow_io_handle_unlink_store_metadata(
+			 io_handle,
+			 store_descriptor );
+
+			io_handle->metadata_memory_size -= store_descriptor->metadata_size;
+
+			store_descriptor->metadata_size        = 0;
+			store_descriptor->metadata_is_resident = 0;
+
+			io_handle->number_of_metadata_evictions += 1;
+		}
+		store_descriptor = more_recently_used_store_descriptor;
+	}
+	return( 1 );
+}
+
+/* Links a store descriptor at the front of the most recently used list
+ * The caller must hold the metadata mutex
+ */
+void libvshadow_io_handle_link_store_metadata(
+      libvshadow_io_handle_t *io_handle,
+      libvshadow_store_descriptor_t *store_descriptor )
+{
+	store_descriptor->more_recently_used_store_descriptor = NULL;
+	store_descriptor->less_recently_used_store_descriptor = io_handle->most_recently_used_store_descriptor;
+
+	if( io_handle->most_recently_used_store_descriptor != NULL )
+	{
+		io_handle->most_recently_used_store_descriptor->more_recently_used_store_descriptor = store_descriptor;
+	}
+	io_handle->most_recently_used_store_descriptor = store_descriptor;
+
+	if( io_handle->least_recently_used_store_descriptor == NULL )
+	{
+		io_handle->least_recently_used_store_descriptor = store_descriptor;
+	}
+}
+
+/* Unlinks a store descriptor from the most recently used list
+ * The caller must hold the metadata mutex
+ */
+void libvshadow_io_handle_unlink_store_metadata(
+      libvshadow_io_handle_t *io_handle,
+      libvshadow_store_descriptor_t *store_descriptor )
+{
+	if( store_descriptor->more_recently_used_store_descriptor != NULL )
+	{
+		store_descriptor->more_recently_used_store_descriptor->less_recently_used_store_descriptor = store_descriptor->less_recently_used_store_descriptor;
+	}
+	else
+	{
+		io_handle->most_recently_used_store_descriptor = store_descriptor->less_recently_used_store_descriptor;
+	}
+	if( store_descriptor->less_recently_used_store_descriptor != NULL )
+	{
+		store_descriptor->less_recently_used_store_descriptor->more_recently_used_store_descriptor = store_descriptor->more_recently_used_store_descriptor;
+	}
+	else
+	{
+		io_handle->least_recently_used_store_descriptor = store_descriptor->more_recently_used_store_descriptor;
+	}
+	store_descriptor->more_recently_used_store_descriptor = NULL;
+	store_descriptor->less_recently_used_store_descriptor = NULL;
+}
+
+/* Reads volume data at a specific offset
+ * The data is copied from the file mapping if the volume is memory mapped,
+ * otherwise it is read using the shared cache if available
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_io_handle_read_volume_data(
+         libvshadow_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "libvshadow_io_handle_read_volume_data";
+	ssize_t read_count    = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->file_mapping != NULL )
+	{
+		read_count = libvshadow_file_mapping_read_buffer_at_offset(
+		              io_handle->file_mapping,
+		              offset,
+		              buffer,
+		              size,
+		              error );
+	}
+	else if( io_handle->shared_cache != NULL )
+	{
+		read_count = libvshadow_io_handle_read_shared_cache_data(
+		              io_handle,
+		              file_io_handle,
+		              offset,
+		              buffer,
+		              size,
+		              error );
+	}
+	else
+	{
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              buffer,
+		              size,
+		              offset,
+		              error );
+	}
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads volume data at a specific offset on behalf of a store
+ * The read is recorded in the I/O trace if available
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_io_handle_read_store_data(
+         libvshadow_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         off64_t volume_offset,
+         int store_index,
+         int data_store_index,
+         uint8_t read_type,
+         libcerror_error_t **error )
+{
+	static char *function    = "libvshadow_io_handle_read_store_data";
+	ssize_t read_count       = 0;
+	uint64_t end_timestamp   = 0;
+	uint64_t start_timestamp = 0;
+	uint8_t flags            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->trace == NULL )
+	{
+		read_count = libvshadow_io_handle_read_volume_data(
+		              io_handle,
+		              file_io_handle,
+		              offset,
+		              buffer,
+		              size,
+		              error );
+
+		return( read_count );
+	}
+	if( libvshadow_trace_get_timestamp(
+	     &start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libvshadow_io_handle_read_volume_data(
+	              io_handle,
+	              file_io_handle,
+	              offset,
+	              buffer,
+	              size,
+	              error );
+
+	if( read_count != (ssize_t) size )
+	{
+		flags |= LIBVSHADOW_TRACE_RECORD_FLAG_READ_FAILED;
+	}
+	if( libvshadow_trace_get_timestamp(
+	     &end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_trace_append_record(
+	     io_handle->trace,
+	     start_timestamp,
+	     end_timestamp,
+	     offset,
+	     volume_offset,
+	     size,
+	     store_index,
+	     data_store_index,
+	     read_type,
+	     flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append trace record.",
+		 function );
+
+		return( -1 );
+	}
+	return( read_count );
+}
+
+/* Reads volume data at a specific offset using the shared cache
+ * Blocks that are not in the shared cache are read from the file IO handle and stored,
+ * a block that is only partially read is read completely so that it can be stored
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_io_handle_read_shared_cache_data(
+         libvshadow_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	uint8_t *block_data   = NULL;
+	static char *function = "libvshadow_io_handle_read_shared_cache_data";
+	size_t block_offset   = 0;
+	size_t buffer_offset  = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	uint64_t block_number = 0;
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		block_number = (uint64_t) offset / LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE;
+		block_offset = (size_t) ( (uint64_t) offset % LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE );
+		read_size    = LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE - block_offset;
+
+		if( read_size > ( size - buffer_offset ) )
+		{
+			read_size = size - buffer_offset;
+		}
+		/* The last block is not cached if it is not completely contained in the volume
+		 */
+		if( ( ( block_number + 1 ) * LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE ) > io_handle->volume_size )
+		{
+			read_count = libbfio_handle_read_buffer_at_offset(
+			              file_io_handle,
+			              &( buffer[ buffer_offset ] ),
+			              size - buffer_offset,
+			              offset,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+			buffer_offset += (size_t) read_count;
+
+			break;
+		}
+		result = libvshadow_shared_cache_read_block(
+		          io_handle->shared_cache,
+		          block_number,
+		          block_offset,
+		          &( buffer[ buffer_offset ] ),
+		          read_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read block: %" PRIu64 " from shared cache.",
+			 function,
+			 block_number );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( read_size == LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE )
+			{
+				read_count = libbfio_handle_read_buffer_at_offset(
+				              file_io_handle,
+				              &( buffer[ buffer_offset ] ),
+				              read_size,
+				              offset,
+				              error );
+			}
+			else
+			{
+				if( block_data == NULL )
+				{
+					block_data = (uint8_t *) memory_allocate(
+					                          sizeof( uint8_t ) * LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE );
+
+					if( block_data == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+						 "%s: unable to create block data.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				read_count = libbfio_handle_read_buffer_at_offset(
+				              file_io_handle,
+				              block_data,
+				              LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE,
+				              (off64_t) ( block_number * LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE ),
+				              error );
+			}
+			if( read_count != (ssize_t) LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read block: %" PRIu64 ".",
+				 function,
+				 block_number );
+
+				goto on_error;
+			}
+			if( read_size == LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE )
+			{
+				result = libvshadow_shared_cache_write_block(
+				          io_handle->shared_cache,
+				          block_number,
+				          &( buffer[ buffer_offset ] ),
+				          read_size,
+				          error );
+			}
+			else
+			{
+				result = libvshadow_shared_cache_write_block(
+				          io_handle->shared_cache,
+				          block_number,
+				          block_data,
+				          LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE,
+				          error );
+
+				if( result != -1 )
+				{
+					if( memory_copy(
+					     &( buffer[ buffer_offset ] ),
+					     &( block_data[ block_offset ] ),
+					     read_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+						 "%s: unable to copy block data.",
+						 function );
+
+						goto on_error;
+					}
+				}
+			}
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to write block: %" PRIu64 " to shared cache.",
+				 function,
+				 block_number );
+
+				goto on_error;
+			}
+		}
+		offset        += (off64_t) read_size;
+		buffer_offset += read_size;
+	}
+	if( block_data != NULL )
+	{
+		memory_free(
+		 block_data );
+	}
+	return( (ssize_t) buffer_offset );
+
+on_error:
+	if( block_data != NULL )
+	{
+		memory_free(
+		 block_data );
+	}
+	return( -1 );
+}
+
+/* Checks if this is the first time the block is being read
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_io_handle_check_if_block_first_read(
+     libvshadow_io_handle_t *io_handle,
+     libvshadow_block_tree_t *block_tree,
+     off64_t block_offset,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t *existing_block_descriptor = NULL;
+	libvshadow_block_descriptor_t *new_block_descriptor      = NULL;
+	libvshadow_block_tree_node_t *leaf_block_tree_node       = NULL;
+	static char *function                                    = "libvshadow_io_handle_check_if_block_first_read";
+	int leaf_value_index                                     = 0;
+	int result                                               = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_block_descriptor_initialize(
+	     &new_block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create block descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	/* The block descriptor only marks the block as read, the block offset
+	 * is maintained by the block tree
+	 */
 	result = libvshadow_block_tree_insert_block_descriptor_by_offset(
 	          block_tree,
 	          block_offset,
@@ -26,9 +26,13 @@
 #include <types.h>
 
 #include "libvshadow_block_tree.h"
+#include "libvshadow_file_mapping.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
+#include "libvshadow_libcthreads.h"
+#include "libvshadow_shared_cache.h"
+#include "libvshadow_trace.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -36,6 +40,8 @@ extern "C" {
 
 extern const uint8_t vshadow_vss_identifier[ 16 ];
 
+struct libvshadow_store_descriptor;
+
 typedef struct libvshadow_io_handle libvshadow_io_handle_t;
 
 struct libvshadow_io_handle
@@ -48,6 +54,52 @@ struct libvshadow_io_handle
 	 */
 	size_t block_size;
 
+	/* The maximum size of the resident block metadata of the stores
+	 * 0 represents no maximum
+	 */
+	size64_t metadata_memory_limit;
+
+	/* The (estimated) size of the resident block metadata of the stores
+	 */
+	size64_t metadata_memory_size;
+
+	/* The number of times the block metadata of a store was evicted
+	 */
+	uint64_t number_of_metadata_evictions;
+
+	/* The number of times the stores were refreshed
+	 */
+	uint32_t number_of_refreshes;
+
+	/* The most recently used store descriptor with resident block metadata
+	 */
+	struct libvshadow_store_descriptor *most_recently_used_store_descriptor;
+
+	/* The least recently used store descriptor with resident block metadata
+	 */
+	struct libvshadow_store_descriptor *least_recently_used_store_descriptor;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	/* The block metadata mutex
+	 */
+	libcthreads_mutex_t *metadata_mutex;
+#endif
+
+	/* The file mapping of the volume
+	 * NULL if the volume is not memory mapped
+	 */
+	libvshadow_file_mapping_t *file_mapping;
+
+	/* The shared block cache
+	 * NULL if blocks are not cached in shared memory
+	 */
+	libvshadow_shared_cache_t *shared_cache;
+
+	/* The I/O trace
+	 * NULL if reads are not traced
+	 */
+	libvshadow_trace_t *trace;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -65,6 +117,76 @@ int libvshadow_io_handle_clear(
      libvshadow_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libvshadow_io_handle_set_metadata_memory_limit(
+     libvshadow_io_handle_t *io_handle,
+     size64_t metadata_memory_limit,
+     libcerror_error_t **error );
+
+int libvshadow_io_handle_get_metadata_memory_size(
+     libvshadow_io_handle_t *io_handle,
+     size64_t *metadata_memory_size,
+     libcerror_error_t **error );
+
+int libvshadow_io_handle_get_number_of_metadata_evictions(
+     libvshadow_io_handle_t *io_handle,
+     uint64_t *number_of_metadata_evictions,
+     libcerror_error_t **error );
+
+int libvshadow_io_handle_grab_store_metadata(
+     libvshadow_io_handle_t *io_handle,
+     struct libvshadow_store_descriptor *store_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_io_handle_add_store_metadata(
+     libvshadow_io_handle_t *io_handle,
+     struct libvshadow_store_descriptor *store_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_io_handle_release_store_metadata(
+     libvshadow_io_handle_t *io_handle,
+     struct libvshadow_store_descriptor *store_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_io_handle_evict_store_metadata(
+     libvshadow_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+void libvshadow_io_handle_link_store_metadata(
+      libvshadow_io_handle_t *io_handle,
+      struct libvshadow_store_descriptor *store_descriptor );
+
+void libvshadow_io_handle_unlink_store_metadata(
+      libvshadow_io_handle_t *io_handle,
+      struct libvshadow_store_descriptor *store_descriptor );
+
+ssize_t libvshadow_io_handle_read_volume_data(
+         libvshadow_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+ssize_t libvshadow_io_handle_read_store_data(
+         libvshadow_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         off64_t volume_offset,
+         int store_index,
+         int data_store_index,
+         uint8_t read_type,
+         libcerror_error_t **error );
+
+ssize_t libvshadow_io_handle_read_shared_cache_data(
+         libvshadow_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
 int libvshadow_io_handle_check_if_block_first_read(
      libvshadow_io_handle_t *io_handle,
      libvshadow_block_tree_t *block_tree,
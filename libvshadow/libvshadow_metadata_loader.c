@@ -0,0 +1,859 @@
+/*
+ * Metadata loader functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_block_descriptor.h"
+#include "libvshadow_block_tree.h"
+#include "libvshadow_io_handle.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_metadata_loader.h"
+#include "libvshadow_store_descriptor.h"
+
+/* The number of store block chains per store
+ */
+#define LIBVSHADOW_METADATA_LOADER_NUMBER_OF_CHAINS_PER_STORE	4
+
+/* Creates a metadata loader
+ * Make sure the value metadata_loader is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_metadata_loader_initialize(
+     libvshadow_metadata_loader_t **metadata_loader,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int maximum_number_of_stores,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_metadata_loader_initialize";
+	size_t chains_size    = 0;
+	size_t stores_size    = 0;
+
+	if( metadata_loader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata loader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *metadata_loader != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid metadata loader value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_stores <= 0 )
+	 || ( (size_t) maximum_number_of_stores > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / ( sizeof( libvshadow_metadata_chain_t ) * LIBVSHADOW_METADATA_LOADER_NUMBER_OF_CHAINS_PER_STORE ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of stores value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*metadata_loader = memory_allocate_structure(
+	                    libvshadow_metadata_loader_t );
+
+	if( *metadata_loader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create metadata loader.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *metadata_loader,
+	     0,
+	     sizeof( libvshadow_metadata_loader_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear metadata loader.",
+		 function );
+
+		memory_free(
+		 *metadata_loader );
+
+		*metadata_loader = NULL;
+
+		return( -1 );
+	}
+	stores_size = sizeof( libvshadow_store_descriptor_t * ) * maximum_number_of_stores;
+
+	( *metadata_loader )->store_descriptors = (libvshadow_store_descriptor_t **) memory_allocate(
+	                                           stores_size );
+
+	if( ( *metadata_loader )->store_descriptors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create store descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	stores_size = sizeof( libvshadow_block_tree_t * ) * maximum_number_of_stores;
+
+	( *metadata_loader )->store_block_trees = (libvshadow_block_tree_t **) memory_allocate(
+	                                           stores_size );
+
+	if( ( *metadata_loader )->store_block_trees == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create store block trees.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *metadata_loader )->store_block_trees,
+	     0,
+	     stores_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear store block trees.",
+		 function );
+
+		goto on_error;
+	}
+	chains_size = sizeof( libvshadow_metadata_chain_t ) * maximum_number_of_stores * LIBVSHADOW_METADATA_LOADER_NUMBER_OF_CHAINS_PER_STORE;
+
+	( *metadata_loader )->chains = (libvshadow_metadata_chain_t *) memory_allocate(
+	                                chains_size );
+
+	if( ( *metadata_loader )->chains == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chains.",
+		 function );
+
+		goto on_error;
+	}
+	( *metadata_loader )->io_handle                = io_handle;
+	( *metadata_loader )->file_io_handle           = file_io_handle;
+	( *metadata_loader )->maximum_number_of_stores = maximum_number_of_stores;
+
+	return( 1 );
+
+on_error:
+	if( *metadata_loader != NULL )
+	{
+		if( ( *metadata_loader )->store_block_trees != NULL )
+		{
+			memory_free(
+			 ( *metadata_loader )->store_block_trees );
+		}
+		if( ( *metadata_loader )->store_descriptors != NULL )
+		{
+			memory_free(
+			 ( *metadata_loader )->store_descriptors );
+		}
+		memory_free(
+		 *metadata_loader );
+
+		*metadata_loader = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a metadata loader
+ * The block descriptors of stores that were added but not completely read are freed
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_metadata_loader_free(
+     libvshadow_metadata_loader_t **metadata_loader,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_metadata_loader_free";
+	int result            = 1;
+	int store_index       = 0;
+
+	if( metadata_loader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata loader.",
+		 function );
+
+		return( -1 );
+	}
+	if( *metadata_loader != NULL )
+	{
+		for( store_index = 0;
+		     store_index < ( *metadata_loader )->number_of_stores;
+		     store_index++ )
+		{
+			if( ( *metadata_loader )->store_block_trees[ store_index ] != NULL )
+			{
+				if( libvshadow_block_tree_free(
+				     &( ( *metadata_loader )->store_block_trees[ store_index ] ),
+				     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free store block tree: %d.",
+					 function,
+					 store_index );
+
+					result = -1;
+				}
+			}
+			if( ( *metadata_loader )->store_descriptors[ store_index ]->block_descriptors_read == 0 )
+			{
+				if( libvshadow_store_descriptor_free_block_descriptors(
+				     ( *metadata_loader )->store_descriptors[ store_index ],
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free block descriptors of store: %d.",
+					 function,
+					 store_index );
+
+					result = -1;
+				}
+			}
+		}
+		memory_free(
+		 ( *metadata_loader )->chains );
+
+		memory_free(
+		 ( *metadata_loader )->store_block_trees );
+
+		memory_free(
+		 ( *metadata_loader )->store_descriptors );
+
+		memory_free(
+		 *metadata_loader );
+
+		*metadata_loader = NULL;
+	}
+	return( result );
+}
+
+/* Appends a store block chain
+ * A chain with a block offset of 0 is empty and is not appended
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_metadata_loader_append_chain(
+     libvshadow_metadata_loader_t *metadata_loader,
+     int store_index,
+     uint8_t chain_type,
+     off64_t block_offset,
+     libcerror_error_t **error )
+{
+	libvshadow_metadata_chain_t *chain = NULL;
+	static char *function              = "libvshadow_metadata_loader_append_chain";
+
+	if( metadata_loader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata loader.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( store_index < 0 )
+	 || ( store_index >= metadata_loader->maximum_number_of_stores ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chain_type < LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_BITMAP )
+	 || ( chain_type > LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_BLOCK_RANGE_LIST ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported chain type.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_loader->number_of_chains >= ( metadata_loader->maximum_number_of_stores * LIBVSHADOW_METADATA_LOADER_NUMBER_OF_CHAINS_PER_STORE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid metadata loader - number of chains value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_offset == 0 )
+	{
+		return( 1 );
+	}
+	chain = &( metadata_loader->chains[ metadata_loader->number_of_chains ] );
+
+	chain->store_index   = store_index;
+	chain->chain_type    = chain_type;
+	chain->block_offset  = block_offset;
+	chain->bitmap_offset = 0;
+
+	metadata_loader->number_of_chains += 1;
+
+	return( 1 );
+}
+
+/* Adds a store to be read
+ * This function is not multi-thread safe acquire write lock of the store descriptor before call
+ * Returns 1 if successful, 0 if the block descriptors of the store were already read or -1 on error
+ */
+int libvshadow_metadata_loader_add_store(
+     libvshadow_metadata_loader_t *metadata_loader,
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_metadata_loader_add_store";
+	int store_index       = 0;
+
+	if( metadata_loader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata loader.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_loader->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid metadata loader - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_loader->number_of_stores >= metadata_loader->maximum_number_of_stores )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid metadata loader - number of stores value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->block_descriptors_read != 0 )
+	{
+		return( 0 );
+	}
+	store_index = metadata_loader->number_of_stores;
+
+	/* The store is added before its block trees are created so that
+	 * the loader frees them if the store cannot be read
+	 */
+	metadata_loader->store_descriptors[ store_index ] = store_descriptor;
+	metadata_loader->store_block_trees[ store_index ] = NULL;
+	metadata_loader->number_of_stores                += 1;
+
+	if( libvshadow_store_descriptor_start_read_block_descriptors(
+	     store_descriptor,
+	     metadata_loader->io_handle,
+	     &( metadata_loader->store_block_trees[ store_index ] ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to start reading block descriptors of store: %d.",
+		 function,
+		 store_descriptor->index );
+
+		return( -1 );
+	}
+	if( libvshadow_metadata_loader_append_chain(
+	     metadata_loader,
+	     store_index,
+	     LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_BITMAP,
+	     store_descriptor->store_bitmap_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append store bitmap chain.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_metadata_loader_append_chain(
+	     metadata_loader,
+	     store_index,
+	     LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_PREVIOUS_BITMAP,
+	     store_descriptor->store_previous_bitmap_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append store previous bitmap chain.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_metadata_loader_append_chain(
+	     metadata_loader,
+	     store_index,
+	     LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_BLOCK_LIST,
+	     store_descriptor->store_block_list_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append store block list chain.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_metadata_loader_append_chain(
+	     metadata_loader,
+	     store_index,
+	     LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_BLOCK_RANGE_LIST,
+	     store_descriptor->store_block_range_list_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append store block range list chain.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the chain of which the next store block should be read
+ * Returns 1 if successful, 0 if all chains were read or -1 on error
+ */
+int libvshadow_metadata_loader_get_next_chain(
+     libvshadow_metadata_loader_t *metadata_loader,
+     libvshadow_metadata_chain_t **chain,
+     libcerror_error_t **error )
+{
+	libvshadow_metadata_chain_t *next_chain      = NULL;
+	libvshadow_metadata_chain_t *candidate_chain = NULL;
+	static char *function                        = "libvshadow_metadata_loader_get_next_chain";
+	int chain_index                              = 0;
+	int number_of_sweeps                         = 0;
+
+	if( metadata_loader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata loader.",
+		 function );
+
+		return( -1 );
+	}
+	if( chain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chain.",
+		 function );
+
+		return( -1 );
+	}
+	/* If there is no pending store block in the direction of the sweep
+	 * the direction is reversed
+	 */
+	for( number_of_sweeps = 0;
+	     number_of_sweeps < 2;
+	     number_of_sweeps++ )
+	{
+		for( chain_index = 0;
+		     chain_index < metadata_loader->number_of_chains;
+		     chain_index++ )
+		{
+			candidate_chain = &( metadata_loader->chains[ chain_index ] );
+
+			if( candidate_chain->block_offset == 0 )
+			{
+				continue;
+			}
+			if( metadata_loader->sweep_is_descending == 0 )
+			{
+				if( ( candidate_chain->block_offset >= metadata_loader->current_offset )
+				 && ( ( next_chain == NULL )
+				  ||  ( candidate_chain->block_offset < next_chain->block_offset ) ) )
+				{
+					next_chain = candidate_chain;
+				}
+			}
+			else
+			{
+				if( ( candidate_chain->block_offset <= metadata_loader->current_offset )
+				 && ( ( next_chain == NULL )
+				  ||  ( candidate_chain->block_offset > next_chain->block_offset ) ) )
+				{
+					next_chain = candidate_chain;
+				}
+			}
+		}
+		if( next_chain != NULL )
+		{
+			break;
+		}
+		metadata_loader->sweep_is_descending ^= 1;
+	}
+	*chain = next_chain;
+
+	if( next_chain == NULL )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Reads the next store block of a chain
+ * This function is not multi-thread safe acquire write lock of the store descriptor before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_metadata_loader_read_chain_block(
+     libvshadow_metadata_loader_t *metadata_loader,
+     libvshadow_metadata_chain_t *chain,
+     libcerror_error_t **error )
+{
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_metadata_loader_read_chain_block";
+	off64_t block_offset                            = 0;
+	int result                                      = 0;
+
+	if( metadata_loader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata loader.",
+		 function );
+
+		return( -1 );
+	}
+	if( chain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chain.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chain->store_index < 0 )
+	 || ( chain->store_index >= metadata_loader->number_of_stores ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chain - store index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	store_descriptor = metadata_loader->store_descriptors[ chain->store_index ];
+	block_offset     = chain->block_offset;
+
+	if( libvshadow_io_handle_check_if_block_first_read(
+	     metadata_loader->io_handle,
+	     metadata_loader->store_block_trees[ chain->store_index ],
+	     block_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to check if first read of store: %d block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 store_descriptor->index,
+		 block_offset,
+		 block_offset );
+
+		return( -1 );
+	}
+	metadata_loader->current_offset = block_offset;
+
+	switch( chain->chain_type )
+	{
+		case LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_BITMAP:
+			result = libvshadow_store_descriptor_read_store_bitmap(
+			          store_descriptor,
+			          metadata_loader->io_handle,
+			          metadata_loader->file_io_handle,
+			          block_offset,
+			          store_descriptor->block_offset_list,
+			          &( chain->bitmap_offset ),
+			          &( chain->block_offset ),
+			          error );
+			break;
+
+		case LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_PREVIOUS_BITMAP:
+			result = libvshadow_store_descriptor_read_store_bitmap(
+			          store_descriptor,
+			          metadata_loader->io_handle,
+			          metadata_loader->file_io_handle,
+			          block_offset,
+			          store_descriptor->previous_block_offset_list,
+			          &( chain->bitmap_offset ),
+			          &( chain->block_offset ),
+			          error );
+			break;
+
+		case LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_BLOCK_LIST:
+			result = libvshadow_store_descriptor_read_store_block_list(
+			          store_descriptor,
+			          metadata_loader->io_handle,
+			          metadata_loader->file_io_handle,
+			          block_offset,
+			          &( chain->block_offset ),
+			          error );
+			break;
+
+		case LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_BLOCK_RANGE_LIST:
+			result = libvshadow_store_descriptor_read_store_block_range_list(
+			          store_descriptor,
+			          metadata_loader->io_handle,
+			          metadata_loader->file_io_handle,
+			          block_offset,
+			          &( chain->block_offset ),
+			          error );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported chain type.",
+			 function );
+
+			return( -1 );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read store: %d block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 store_descriptor->index,
+		 block_offset,
+		 block_offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the block descriptors of the stores that were added
+ * This function is not multi-thread safe acquire write lock of the store descriptors before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_metadata_loader_read(
+     libvshadow_metadata_loader_t *metadata_loader,
+     libcerror_error_t **error )
+{
+	libvshadow_metadata_chain_t *chain              = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_metadata_loader_read";
+	int result                                      = 0;
+	int store_index                                 = 0;
+
+	if( metadata_loader == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata loader.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		result = libvshadow_metadata_loader_get_next_chain(
+		          metadata_loader,
+		          &chain,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next chain.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			if( libvshadow_metadata_loader_read_chain_block(
+			     metadata_loader,
+			     chain,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chain block.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	while( result != 0 );
+
+	for( store_index = 0;
+	     store_index < metadata_loader->number_of_stores;
+	     store_index++ )
+	{
+		store_descriptor = metadata_loader->store_descriptors[ store_index ];
+
+		if( libvshadow_store_descriptor_finish_read_block_descriptors(
+		     store_descriptor,
+		     &( metadata_loader->store_block_trees[ store_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finish reading block descriptors of store: %d.",
+			 function,
+			 store_descriptor->index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,165 @@
+/*
+ * Metadata loader functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_METADATA_LOADER_H )
+#define _LIBVSHADOW_METADATA_LOADER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_block_tree.h"
+#include "libvshadow_io_handle.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_store_descriptor.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The metadata chain types
+ */
+enum LIBVSHADOW_METADATA_CHAIN_TYPES
+{
+	LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_BITMAP			= 1,
+	LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_PREVIOUS_BITMAP		= 2,
+	LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_BLOCK_LIST			= 3,
+	LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_BLOCK_RANGE_LIST		= 4
+};
+
+typedef struct libvshadow_metadata_chain libvshadow_metadata_chain_t;
+typedef struct libvshadow_metadata_loader libvshadow_metadata_loader_t;
+
+/* A chain of store blocks that are linked by their next offset
+ */
+struct libvshadow_metadata_chain
+{
+	/* The index of the store in the loader
+	 */
+	int store_index;
+
+	/* The chain type
+	 */
+	uint8_t chain_type;
+
+	/* The offset of the next store block to read, 0 if the chain was read
+	 */
+	off64_t block_offset;
+
+	/* The bitmap offset
+	 */
+	off64_t bitmap_offset;
+};
+
+/* The metadata loader reads the block metadata of multiple stores
+ * The store block chains of all stores are advanced together, where the next
+ * store block to read is chosen like an elevator: the pending store block closest
+ * to the current offset in the direction of the sweep, reversing the direction
+ * when there are no more pending store blocks ahead.
+ * Since the store blocks of a single chain are still read in order the block
+ * descriptors of a store are inserted in the same order as when read per store.
+ */
+struct libvshadow_metadata_loader
+{
+	/* The IO handle
+	 */
+	libvshadow_io_handle_t *io_handle;
+
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The store descriptors
+	 */
+	libvshadow_store_descriptor_t **store_descriptors;
+
+	/* The store block trees, used to detect store blocks that are read more than once
+	 */
+	libvshadow_block_tree_t **store_block_trees;
+
+	/* The number of stores
+	 */
+	int number_of_stores;
+
+	/* The maximum number of stores
+	 */
+	int maximum_number_of_stores;
+
+	/* The chains
+	 */
+	libvshadow_metadata_chain_t *chains;
+
+	/* The number of chains
+	 */
+	int number_of_chains;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* Value to indicate the sweep is towards lower offsets
+	 */
+	uint8_t sweep_is_descending;
+};
+
+int libvshadow_metadata_loader_initialize(
+     libvshadow_metadata_loader_t **metadata_loader,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int maximum_number_of_stores,
+     libcerror_error_t **error );
+
+int libvshadow_metadata_loader_free(
+     libvshadow_metadata_loader_t **metadata_loader,
+     libcerror_error_t **error );
+
+int libvshadow_metadata_loader_append_chain(
+     libvshadow_metadata_loader_t *metadata_loader,
+     int store_index,
+     uint8_t chain_type,
+     off64_t block_offset,
+     libcerror_error_t **error );
+
+int libvshadow_metadata_loader_add_store(
+     libvshadow_metadata_loader_t *metadata_loader,
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_metadata_loader_get_next_chain(
+     libvshadow_metadata_loader_t *metadata_loader,
+     libvshadow_metadata_chain_t **chain,
+     libcerror_error_t **error );
+
+int libvshadow_metadata_loader_read_chain_block(
+     libvshadow_metadata_loader_t *metadata_loader,
+     libvshadow_metadata_chain_t *chain,
+     libcerror_error_t **error );
+
+int libvshadow_metadata_loader_read(
+     libvshadow_metadata_loader_t *metadata_loader,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_METADATA_LOADER_H ) */
+
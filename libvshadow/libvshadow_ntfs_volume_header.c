@@ -594,6 +594,21 @@ int libvshadow_ntfs_volume_header_read_data(
 	ntfs_volume_header->volume_size *= ntfs_volume_header->bytes_per_sector;
 	ntfs_volume_header->volume_size += ntfs_volume_header->bytes_per_sector;
 
+	if( mft_cluster_block_number > (uint64_t) ( INT64_MAX / cluster_block_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid MFT cluster block number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	ntfs_volume_header->cluster_block_size = cluster_block_size;
+	ntfs_volume_header->mft_entry_size     = mft_entry_size;
+	ntfs_volume_header->mft_offset         = (off64_t) ( mft_cluster_block_number * cluster_block_size );
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -617,6 +632,11 @@ int libvshadow_ntfs_volume_header_read_data(
 		 function,
 		 ntfs_volume_header->volume_size );
 
+		libcnotify_printf(
+		 "%s: calculated MFT offset\t\t: 0x%08" PRIx64 "\n",
+		 function,
+		 ntfs_volume_header->mft_offset );
+
 		libcnotify_printf(
 		 "\n" );
 	}
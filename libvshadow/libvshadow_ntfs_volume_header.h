@@ -40,6 +40,18 @@ struct libvshadow_ntfs_volume_header
 	 */
 	uint16_t bytes_per_sector;
 
+	/* The cluster block size
+	 */
+	uint32_t cluster_block_size;
+
+	/* The MFT entry size
+	 */
+	uint32_t mft_entry_size;
+
+	/* The MFT offset
+	 */
+	off64_t mft_offset;
+
 	/* The volume size
 	 */
 	size64_t volume_size;
@@ -0,0 +1,146 @@
+/*
+ * Read request functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_READ_REQUEST_H )
+#define _LIBVSHADOW_READ_REQUEST_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_io_handle.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcthreads.h"
+#include "libvshadow_store_descriptor.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+
+typedef struct libvshadow_read_request libvshadow_read_request_t;
+typedef struct libvshadow_read_segment libvshadow_read_segment_t;
+
+struct libvshadow_read_request
+{
+	/* The store descriptor
+	 */
+	libvshadow_store_descriptor_t *store_descriptor;
+
+	/* The IO handle
+	 */
+	libvshadow_io_handle_t *io_handle;
+
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The active store descriptor index
+	 */
+	int active_store_descriptor_index;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The offset of the start of the buffer
+	 */
+	off64_t offset;
+
+	/* The segments
+	 */
+	libvshadow_read_segment_t *segments;
+
+	/* The number of segments
+	 */
+	int number_of_segments;
+
+	/* The number of segments that have not been completed
+	 */
+	int number_of_pending_segments;
+
+	/* Value to indicate a segment failed to read
+	 */
+	int read_failed;
+
+	/* The error of the first segment that failed to read
+	 */
+	libcerror_error_t *error;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when all segments have been completed
+	 */
+	libcthreads_condition_t *condition;
+};
+
+struct libvshadow_read_segment
+{
+	/* The read request
+	 */
+	libvshadow_read_request_t *read_request;
+
+	/* The offset of the segment relative to the start of the buffer
+	 */
+	size_t buffer_offset;
+
+	/* The size of the segment
+	 */
+	size_t size;
+};
+
+int libvshadow_read_request_initialize(
+     libvshadow_read_request_t **read_request,
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int active_store_descriptor_index,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t offset,
+     size_t segment_size,
+     libcerror_error_t **error );
+
+int libvshadow_read_request_free(
+     libvshadow_read_request_t **read_request,
+     libcerror_error_t **error );
+
+int libvshadow_read_request_complete_segments(
+     libvshadow_read_request_t *read_request,
+     int number_of_segments,
+     libcerror_error_t **segment_error,
+     libcerror_error_t **error );
+
+int libvshadow_read_request_wait(
+     libvshadow_read_request_t *read_request,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_READ_REQUEST_H ) */
+
@@ -0,0 +1,798 @@
+/*
+ * Read thread pool functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_io_handle.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcthreads.h"
+#include "libvshadow_read_request.h"
+#include "libvshadow_read_thread_pool.h"
+#include "libvshadow_store_descriptor.h"
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+
+/* Creates a read thread pool
+ * Make sure the value read_thread_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_read_thread_pool_initialize(
+     libvshadow_read_thread_pool_t **read_thread_pool,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_read_thread_pool_initialize";
+
+	if( read_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_thread_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read thread pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( (size_t) number_of_threads > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( libbfio_handle_t * ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*read_thread_pool = memory_allocate_structure(
+	                     libvshadow_read_thread_pool_t );
+
+	if( *read_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_thread_pool,
+	     0,
+	     sizeof( libvshadow_read_thread_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read thread pool.",
+		 function );
+
+		memory_free(
+		 *read_thread_pool );
+
+		*read_thread_pool = NULL;
+
+		return( -1 );
+	}
+	( *read_thread_pool )->file_io_handles = (libbfio_handle_t **) memory_allocate(
+	                                                                 sizeof( libbfio_handle_t * ) * number_of_threads );
+
+	if( ( *read_thread_pool )->file_io_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_thread_pool )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *read_thread_pool )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     number_of_threads * 2,
+	     (int (*)(intptr_t *, void *)) &libvshadow_read_thread_pool_read_segment,
+	     (void *) *read_thread_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+	( *read_thread_pool )->number_of_threads = number_of_threads;
+
+	return( 1 );
+
+on_error:
+	if( *read_thread_pool != NULL )
+	{
+		if( ( *read_thread_pool )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *read_thread_pool )->mutex ),
+			 NULL );
+		}
+		if( ( *read_thread_pool )->file_io_handles != NULL )
+		{
+			memory_free(
+			 ( *read_thread_pool )->file_io_handles );
+		}
+		memory_free(
+		 *read_thread_pool );
+
+		*read_thread_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read thread pool
+ * The threads are stopped after the pending segments have been read
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_read_thread_pool_free(
+     libvshadow_read_thread_pool_t **read_thread_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_read_thread_pool_free";
+	int result            = 1;
+
+	if( read_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( ( *read_thread_pool )->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+		if( libvshadow_read_thread_pool_free_file_io_handles(
+		     *read_thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handles.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *read_thread_pool )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *read_thread_pool )->file_io_handles );
+
+		memory_free(
+		 *read_thread_pool );
+
+		*read_thread_pool = NULL;
+	}
+	return( result );
+}
+
+/* Frees the file IO handles that are not in use by a thread
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_read_thread_pool_free_file_io_handles(
+     libvshadow_read_thread_pool_t *read_thread_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_read_thread_pool_free_file_io_handles";
+	int result            = 1;
+
+	if( read_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( read_thread_pool->number_of_file_io_handles > 0 )
+	{
+		read_thread_pool->number_of_file_io_handles -= 1;
+
+		if( libbfio_handle_free(
+		     &( read_thread_pool->file_io_handles[ read_thread_pool->number_of_file_io_handles ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle: %d.",
+			 function,
+			 read_thread_pool->number_of_file_io_handles );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     read_thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Grabs a file IO handle for use by a thread
+ * A clone of the source file IO handle is created if no file IO handle is available
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_read_thread_pool_grab_file_io_handle(
+     libvshadow_read_thread_pool_t *read_thread_pool,
+     libbfio_handle_t *source_file_io_handle,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *safe_file_io_handle = NULL;
+	static char *function                 = "libvshadow_read_thread_pool_grab_file_io_handle";
+	int result                            = 0;
+
+	if( read_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_thread_pool->number_of_file_io_handles > 0 )
+	{
+		read_thread_pool->number_of_file_io_handles -= 1;
+
+		safe_file_io_handle = read_thread_pool->file_io_handles[ read_thread_pool->number_of_file_io_handles ];
+
+		read_thread_pool->file_io_handles[ read_thread_pool->number_of_file_io_handles ] = NULL;
+	}
+	if( libcthreads_mutex_release(
+	     read_thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( safe_file_io_handle == NULL )
+	{
+		/* The clone is opened by libbfio if the source file IO handle is open
+		 */
+		if( libbfio_handle_clone(
+		     &safe_file_io_handle,
+		     source_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		result = libbfio_handle_is_open(
+		          safe_file_io_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if file IO handle is open.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libbfio_handle_open(
+			     safe_file_io_handle,
+			     LIBBFIO_OPEN_READ,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open file IO handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	*file_io_handle = safe_file_io_handle;
+
+	return( 1 );
+
+on_error:
+	if( safe_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &safe_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Releases a file IO handle that was in use by a thread
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_read_thread_pool_release_file_io_handle(
+     libvshadow_read_thread_pool_t *read_thread_pool,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_read_thread_pool_release_file_io_handle";
+
+	if( read_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     read_thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_thread_pool->number_of_file_io_handles < read_thread_pool->number_of_threads )
+	{
+		read_thread_pool->file_io_handles[ read_thread_pool->number_of_file_io_handles ] = *file_io_handle;
+
+		read_thread_pool->number_of_file_io_handles += 1;
+
+		*file_io_handle = NULL;
+	}
+	if( libcthreads_mutex_release(
+	     read_thread_pool->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_handle != NULL )
+	{
+		if( libbfio_handle_free(
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads a segment of a read request
+ * Callback function for the thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_read_thread_pool_read_segment(
+     libvshadow_read_segment_t *read_segment,
+     libvshadow_read_thread_pool_t *read_thread_pool )
+{
+	libbfio_handle_t *file_io_handle        = NULL;
+	libcerror_error_t *error                = NULL;
+	libvshadow_read_request_t *read_request = NULL;
+	static char *function                   = "libvshadow_read_thread_pool_read_segment";
+	ssize_t read_count                      = 0;
+
+	if( read_segment == NULL )
+	{
+		return( -1 );
+	}
+	read_request = read_segment->read_request;
+
+	if( read_request == NULL )
+	{
+		return( -1 );
+	}
+	/* The segment is not read if another segment of the read request failed
+	 */
+	if( read_request->read_failed == 0 )
+	{
+		if( libvshadow_read_thread_pool_grab_file_io_handle(
+		     read_thread_pool,
+		     read_request->file_io_handle,
+		     &file_io_handle,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab file IO handle.",
+			 function );
+		}
+		else
+		{
+			read_count = libvshadow_store_descriptor_read_buffer(
+			              read_request->store_descriptor,
+			              read_request->io_handle,
+			              file_io_handle,
+			              &( read_request->buffer[ read_segment->buffer_offset ] ),
+			              read_segment->size,
+			              read_request->offset + (off64_t) read_segment->buffer_offset,
+			              read_request->active_store_descriptor_index,
+			              &error );
+
+			if( read_count != (ssize_t) read_segment->size )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read segment at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 read_request->offset + (off64_t) read_segment->buffer_offset,
+				 read_request->offset + (off64_t) read_segment->buffer_offset );
+			}
+			if( libvshadow_read_thread_pool_release_file_io_handle(
+			     read_thread_pool,
+			     &file_io_handle,
+			     ( error == NULL ) ? &error : NULL ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release file IO handle.",
+				 function );
+			}
+		}
+	}
+	/* The read request takes over the error
+	 */
+	if( libvshadow_read_request_complete_segments(
+	     read_request,
+	     1,
+	     &error,
+	     NULL ) != 1 )
+	{
+		if( error != NULL )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads data at the specified offset into a buffer using the threads of the pool
+ * The calling thread waits until all the segments have been read
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_read_thread_pool_read_buffer(
+         libvshadow_read_thread_pool_t *read_thread_pool,
+         libvshadow_store_descriptor_t *store_descriptor,
+         libvshadow_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         int active_store_descriptor_index,
+         libcerror_error_t **error )
+{
+	libcerror_error_t *push_error           = NULL;
+	libvshadow_read_request_t *read_request = NULL;
+	static char *function                   = "libvshadow_read_thread_pool_read_buffer";
+	int segment_index                       = 0;
+
+	if( read_thread_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read thread pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_read_request_initialize(
+	     &read_request,
+	     store_descriptor,
+	     io_handle,
+	     file_io_handle,
+	     active_store_descriptor_index,
+	     buffer,
+	     buffer_size,
+	     offset,
+	     LIBVSHADOW_READ_THREAD_POOL_SEGMENT_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create read request.",
+		 function );
+
+		return( -1 );
+	}
+	for( segment_index = 0;
+	     segment_index < read_request->number_of_segments;
+	     segment_index++ )
+	{
+		if( libcthreads_thread_pool_push(
+		     read_thread_pool->thread_pool,
+		     (intptr_t *) &( read_request->segments[ segment_index ] ),
+		     &push_error ) != 1 )
+		{
+			libcerror_error_set(
+			 &push_error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push segment: %d onto thread pool queue.",
+			 function,
+			 segment_index );
+
+			/* The segments that were not pushed are completed as failed
+			 */
+			if( libvshadow_read_request_complete_segments(
+			     read_request,
+			     read_request->number_of_segments - segment_index,
+			     &push_error,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to complete segments.",
+				 function );
+
+				/* The read request cannot be freed safely since threads
+				 * could still reference it
+				 */
+				read_request = NULL;
+
+				goto on_error;
+			}
+			break;
+		}
+	}
+	if( libvshadow_read_request_wait(
+	     read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to wait for read request.",
+		 function );
+
+		read_request = NULL;
+
+		goto on_error;
+	}
+	if( read_request->read_failed != 0 )
+	{
+		if( ( error != NULL )
+		 && ( *error == NULL ) )
+		{
+			*error              = read_request->error;
+			read_request->error = NULL;
+		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		goto on_error;
+	}
+	if( libvshadow_read_request_free(
+	     &read_request,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free read request.",
+		 function );
+
+		goto on_error;
+	}
+	return( (ssize_t) buffer_size );
+
+on_error:
+	if( read_request != NULL )
+	{
+		libvshadow_read_request_free(
+		 &read_request,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT ) */
+
@@ -0,0 +1,122 @@
+/*
+ * Read thread pool functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_READ_THREAD_POOL_H )
+#define _LIBVSHADOW_READ_THREAD_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_io_handle.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcthreads.h"
+#include "libvshadow_read_request.h"
+#include "libvshadow_store_descriptor.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The minimum size of a read that is split into segments
+ * that are read in parallel
+ */
+#define LIBVSHADOW_READ_THREAD_POOL_MINIMUM_READ_SIZE	( 4 * 1024 * 1024 )
+
+/* The size of the segments that are read in parallel
+ */
+#define LIBVSHADOW_READ_THREAD_POOL_SEGMENT_SIZE	( 1024 * 1024 )
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+
+typedef struct libvshadow_read_thread_pool libvshadow_read_thread_pool_t;
+
+struct libvshadow_read_thread_pool
+{
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The thread pool
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The file IO handles that are not in use by a thread
+	 * These are clones of the file IO handle of the volume
+	 */
+	libbfio_handle_t **file_io_handles;
+
+	/* The number of file IO handles that are not in use by a thread
+	 */
+	int number_of_file_io_handles;
+
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+};
+
+int libvshadow_read_thread_pool_initialize(
+     libvshadow_read_thread_pool_t **read_thread_pool,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libvshadow_read_thread_pool_free(
+     libvshadow_read_thread_pool_t **read_thread_pool,
+     libcerror_error_t **error );
+
+int libvshadow_read_thread_pool_free_file_io_handles(
+     libvshadow_read_thread_pool_t *read_thread_pool,
+     libcerror_error_t **error );
+
+int libvshadow_read_thread_pool_grab_file_io_handle(
+     libvshadow_read_thread_pool_t *read_thread_pool,
+     libbfio_handle_t *source_file_io_handle,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libvshadow_read_thread_pool_release_file_io_handle(
+     libvshadow_read_thread_pool_t *read_thread_pool,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libvshadow_read_thread_pool_read_segment(
+     libvshadow_read_segment_t *read_segment,
+     libvshadow_read_thread_pool_t *read_thread_pool );
+
+ssize_t libvshadow_read_thread_pool_read_buffer(
+         libvshadow_read_thread_pool_t *read_thread_pool,
+         libvshadow_store_descriptor_t *store_descriptor,
+         libvshadow_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         int active_store_descriptor_index,
+         libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_READ_THREAD_POOL_H ) */
+
@@ -0,0 +1,721 @@
+/*
+ * Reference index functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "libvshadow_block_descriptor.h"
+#include "libvshadow_definitions.h"
+#include "libvshadow_io_handle.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcdata.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcthreads.h"
+#include "libvshadow_reference_index.h"
+#include "libvshadow_store_descriptor.h"
+
+/* Compares 2 references by their block number
+ * References to the same block are ordered by their store index
+ * Returns -1 if the first reference is less than the second, 0 if equal or 1 if greater
+ */
+int libvshadow_reference_compare(
+     const libvshadow_reference_t *first_reference,
+     const libvshadow_reference_t *second_reference )
+{
+	if( first_reference->block_number < second_reference->block_number )
+	{
+		return( -1 );
+	}
+	else if( first_reference->block_number > second_reference->block_number )
+	{
+		return( 1 );
+	}
+	if( first_reference->store_index < second_reference->store_index )
+	{
+		return( -1 );
+	}
+	else if( first_reference->store_index > second_reference->store_index )
+	{
+		return( 1 );
+	}
+	if( first_reference->original_block_number < second_reference->original_block_number )
+	{
+		return( -1 );
+	}
+	else if( first_reference->original_block_number > second_reference->original_block_number )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Creates a reference index
+ * Make sure the value reference_index is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_reference_index_initialize(
+     libvshadow_reference_index_t **reference_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_reference_index_initialize";
+
+	if( reference_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reference index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reference_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid reference index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*reference_index = memory_allocate_structure(
+	                    libvshadow_reference_index_t );
+
+	if( *reference_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reference index.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *reference_index,
+	     0,
+	     sizeof( libvshadow_reference_index_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reference index.",
+		 function );
+
+		memory_free(
+		 *reference_index );
+
+		*reference_index = NULL;
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( *reference_index != NULL )
+	{
+		memory_free(
+		 *reference_index );
+
+		*reference_index = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a reference index
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_reference_index_free(
+     libvshadow_reference_index_t **reference_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_reference_index_free";
+
+	if( reference_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reference index.",
+		 function );
+
+		return( -1 );
+	}
+	if( *reference_index != NULL )
+	{
+		if( ( *reference_index )->references != NULL )
+		{
+			memory_free(
+			 ( *reference_index )->references );
+		}
+		memory_free(
+		 *reference_index );
+
+		*reference_index = NULL;
+	}
+	return( 1 );
+}
+
+/* Resizes the references so that they can contain at least a specific number of references
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_reference_index_resize(
+     libvshadow_reference_index_t *reference_index,
+     int number_of_references,
+     libcerror_error_t **error )
+{
+	libvshadow_reference_t *references = NULL;
+	static char *function              = "libvshadow_reference_index_resize";
+	size_t references_size             = 0;
+	int number_of_allocated_references = 0;
+
+	if( reference_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reference index.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_references < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of references value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_references <= reference_index->number_of_allocated_references )
+	{
+		return( 1 );
+	}
+	number_of_allocated_references = reference_index->number_of_allocated_references;
+
+	if( number_of_allocated_references == 0 )
+	{
+		number_of_allocated_references = 1024;
+	}
+	while( number_of_allocated_references < number_of_references )
+	{
+		if( number_of_allocated_references >= ( INT_MAX / 2 ) )
+		{
+			number_of_allocated_references = number_of_references;
+
+			break;
+		}
+		number_of_allocated_references *= 2;
+	}
+	references_size = sizeof( libvshadow_reference_t ) * number_of_allocated_references;
+
+	if( references_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid references size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	references = (libvshadow_reference_t *) memory_reallocate(
+	                                          reference_index->references,
+	                                          references_size );
+
+	if( references == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize references.",
+		 function );
+
+		return( -1 );
+	}
+	reference_index->references                     = references;
+	reference_index->number_of_allocated_references = number_of_allocated_references;
+
+	return( 1 );
+}
+
+/* Appends the reference of a block descriptor
+ * Forwarder block descriptors and block descriptors that are not used do not reference
+ * a block in the store area and are not appended
+ * Returns 1 if successful, 0 if the block descriptor does not reference a block or -1 on error
+ */
+int libvshadow_reference_index_append_block_descriptor(
+     libvshadow_reference_index_t *reference_index,
+     int store_index,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libcerror_error_t **error )
+{
+	libvshadow_reference_t *reference = NULL;
+	static char *function             = "libvshadow_reference_index_append_block_descriptor";
+
+	if( reference_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reference index.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_descriptor->flags & ( LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER | LIBVSHADOW_BLOCK_FLAG_NOT_USED ) ) != 0 )
+	{
+		return( 0 );
+	}
+	if( reference_index->number_of_references == INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of references value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_reference_index_resize(
+	     reference_index,
+	     reference_index->number_of_references + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize references.",
+		 function );
+
+		return( -1 );
+	}
+	reference = &( reference_index->references[ reference_index->number_of_references ] );
+
+	reference->block_number          = block_descriptor->block_number;
+	reference->original_block_number = block_descriptor->original_block_number;
+	reference->store_index           = store_index;
+
+	reference_index->number_of_references += 1;
+
+	return( 1 );
+}
+
+/* Reads the references of the block descriptors of a store descriptor
+ * The references are not sorted until libvshadow_reference_index_sort is called
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_reference_index_read_store_descriptor(
+     libvshadow_reference_index_t *reference_index,
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libcdata_list_element_t *list_element           = NULL;
+	libvshadow_block_descriptor_t *block_descriptor = NULL;
+	static char *function                           = "libvshadow_reference_index_read_store_descriptor";
+	int number_of_block_descriptors                 = 0;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	uint8_t is_locked                               = 0;
+#endif
+
+	if( reference_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reference index.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->has_in_volume_store_data == 0 )
+	{
+		return( 1 );
+	}
+	/* This function will acquire the write lock if the block descriptors
+	 * need to be (re)read
+	 */
+	if( libvshadow_store_descriptor_acquire_block_descriptors(
+	     store_descriptor,
+	     io_handle,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to acquire block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+	is_locked = 1;
+#endif
+	if( libcdata_list_get_number_of_elements(
+	     store_descriptor->block_descriptors_list,
+	     &number_of_block_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of block descriptors.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_block_descriptors > ( INT_MAX - reference_index->number_of_references ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of block descriptors value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	/* Most block descriptors reference a block, hence the references
+	 * are allocated for all the block descriptors at once
+	 */
+	if( libvshadow_reference_index_resize(
+	     reference_index,
+	     reference_index->number_of_references + number_of_block_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize references.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_list_get_first_element(
+	     store_descriptor->block_descriptors_list,
+	     &list_element,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve first block descriptors list element.",
+		 function );
+
+		goto on_error;
+	}
+	while( list_element != NULL )
+	{
+		if( libcdata_list_element_get_value(
+		     list_element,
+		     (intptr_t **) &block_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block descriptor from list element.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvshadow_reference_index_append_block_descriptor(
+		     reference_index,
+		     store_descriptor->index,
+		     block_descriptor,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append block descriptor reference.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_list_element_get_next_element(
+		     list_element,
+		     &list_element,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next block descriptors list element.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	is_locked = 0;
+
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( libvshadow_store_descriptor_release_block_descriptors(
+	     store_descriptor,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( is_locked != 0 )
+	{
+		libcthreads_read_write_lock_release_for_read(
+		 store_descriptor->read_write_lock,
+		 NULL );
+	}
+#endif
+	libvshadow_store_descriptor_release_block_descriptors(
+	 store_descriptor,
+	 io_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Sorts the references by their block number
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_reference_index_sort(
+     libvshadow_reference_index_t *reference_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_reference_index_sort";
+
+	if( reference_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reference index.",
+		 function );
+
+		return( -1 );
+	}
+	if( reference_index->number_of_references > 1 )
+	{
+		qsort(
+		 reference_index->references,
+		 (size_t) reference_index->number_of_references,
+		 sizeof( libvshadow_reference_t ),
+		 (int (*)(const void *, const void *)) &libvshadow_reference_compare );
+	}
+	return( 1 );
+}
+
+/* Retrieves the references to the block at a specific (physical) offset
+ * The references must be sorted before calling this function
+ * Returns 1 if successful, 0 if no references were found or -1 on error
+ */
+int libvshadow_reference_index_get_references_at_offset(
+     libvshadow_reference_index_t *reference_index,
+     off64_t offset,
+     int *first_reference_index,
+     int *number_of_references,
+     libcerror_error_t **error )
+{
+	static char *function    = "libvshadow_reference_index_get_references_at_offset";
+	uint32_t block_number    = 0;
+	int last_reference_index = 0;
+	int lower_index          = 0;
+	int middle_index         = 0;
+	int upper_index          = 0;
+
+	if( reference_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reference index.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( first_reference_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid first reference index.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_references == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of references.",
+		 function );
+
+		return( -1 );
+	}
+	*first_reference_index = 0;
+	*number_of_references  = 0;
+
+	if( ( offset >> LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT ) > (off64_t) UINT32_MAX )
+	{
+		return( 0 );
+	}
+	block_number = (uint32_t) ( offset >> LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT );
+
+	/* Determine the first reference with a block number that is not less than the block number
+	 */
+	lower_index = 0;
+	upper_index = reference_index->number_of_references;
+
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( reference_index->references[ middle_index ].block_number < block_number )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
+	}
+	last_reference_index = lower_index;
+
+	while( ( last_reference_index < reference_index->number_of_references )
+	    && ( reference_index->references[ last_reference_index ].block_number == block_number ) )
+	{
+		last_reference_index++;
+	}
+	if( last_reference_index == lower_index )
+	{
+		return( 0 );
+	}
+	*first_reference_index = lower_index;
+	*number_of_references  = last_reference_index - lower_index;
+
+	return( 1 );
+}
+
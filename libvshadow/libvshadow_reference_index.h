@@ -0,0 +1,123 @@
+/*
+ * Reference index functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_REFERENCE_INDEX_H )
+#define _LIBVSHADOW_REFERENCE_INDEX_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_block_descriptor.h"
+#include "libvshadow_io_handle.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_store_descriptor.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvshadow_reference libvshadow_reference_t;
+typedef struct libvshadow_reference_index libvshadow_reference_index_t;
+
+/* A reference of a store to a block in the store area
+ */
+struct libvshadow_reference
+{
+	/* The (physical) block number of the block in the store area
+	 */
+	uint32_t block_number;
+
+	/* The original (volume) block number
+	 */
+	uint32_t original_block_number;
+
+	/* The store index
+	 */
+	int store_index;
+};
+
+/* The reference index maps the blocks in the store area to the stores that reference them
+ * The references are sorted by block number, so the references to a block can be looked up
+ * with a binary search
+ */
+struct libvshadow_reference_index
+{
+	/* The references
+	 */
+	libvshadow_reference_t *references;
+
+	/* The number of references
+	 */
+	int number_of_references;
+
+	/* The number of allocated references
+	 */
+	int number_of_allocated_references;
+};
+
+int libvshadow_reference_compare(
+     const libvshadow_reference_t *first_reference,
+     const libvshadow_reference_t *second_reference );
+
+int libvshadow_reference_index_initialize(
+     libvshadow_reference_index_t **reference_index,
+     libcerror_error_t **error );
+
+int libvshadow_reference_index_free(
+     libvshadow_reference_index_t **reference_index,
+     libcerror_error_t **error );
+
+int libvshadow_reference_index_resize(
+     libvshadow_reference_index_t *reference_index,
+     int number_of_references,
+     libcerror_error_t **error );
+
+int libvshadow_reference_index_append_block_descriptor(
+     libvshadow_reference_index_t *reference_index,
+     int store_index,
+     libvshadow_block_descriptor_t *block_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_reference_index_read_store_descriptor(
+     libvshadow_reference_index_t *reference_index,
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libvshadow_reference_index_sort(
+     libvshadow_reference_index_t *reference_index,
+     libcerror_error_t **error );
+
+int libvshadow_reference_index_get_references_at_offset(
+     libvshadow_reference_index_t *reference_index,
+     off64_t offset,
+     int *first_reference_index,
+     int *number_of_references,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_REFERENCE_INDEX_H ) */
+
@@ -0,0 +1,1089 @@
+/*
+ * Scanner functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( __SSE2__ )
+#include <emmintrin.h>
+
+#elif defined( __ARM_NEON ) && defined( __aarch64__ )
+#include <arm_neon.h>
+
+#endif
+
+#include "libvshadow_definitions.h"
+#include "libvshadow_io_handle.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_scanner.h"
+#include "libvshadow_types.h"
+
+#include "vshadow_store.h"
+#include "vshadow_volume.h"
+
+/* Creates a scanner
+ * Make sure the value scanner is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_scanner_initialize(
+     libvshadow_scanner_t **scanner,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_scanner_t *internal_scanner = NULL;
+	static char *function                           = "libvshadow_scanner_initialize";
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scanner != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid scanner value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_scanner = memory_allocate_structure(
+	                    libvshadow_internal_scanner_t );
+
+	if( internal_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create scanner.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_scanner,
+	     0,
+	     sizeof( libvshadow_internal_scanner_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scanner.",
+		 function );
+
+		goto on_error;
+	}
+	*scanner = (libvshadow_scanner_t *) internal_scanner;
+
+	return( 1 );
+
+on_error:
+	if( internal_scanner != NULL )
+	{
+		memory_free(
+		 internal_scanner );
+	}
+	return( -1 );
+}
+
+/* Frees a scanner
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_scanner_free(
+     libvshadow_scanner_t **scanner,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_scanner_t *internal_scanner = NULL;
+	static char *function                           = "libvshadow_scanner_free";
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scanner != NULL )
+	{
+		internal_scanner = (libvshadow_internal_scanner_t *) *scanner;
+		*scanner         = NULL;
+
+		if( internal_scanner->results != NULL )
+		{
+			memory_free(
+			 internal_scanner->results );
+		}
+		memory_free(
+		 internal_scanner );
+	}
+	return( 1 );
+}
+
+/* Signals the scanner to abort its current activity
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_scanner_signal_abort(
+     libvshadow_scanner_t *scanner,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_scanner_t *internal_scanner = NULL;
+	static char *function                           = "libvshadow_scanner_signal_abort";
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	internal_scanner = (libvshadow_internal_scanner_t *) scanner;
+
+	internal_scanner->abort = 1;
+
+	return( 1 );
+}
+
+/* Scans a file for volume headers, catalog blocks and store blocks
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_scanner_scan_file(
+     libvshadow_scanner_t *scanner,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libvshadow_scanner_scan_file";
+	size_t filename_length           = 0;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_scanner_scan_file_io_handle(
+	     scanner,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to scan file: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Scans a file for volume headers, catalog blocks and store blocks
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_scanner_scan_file_wide(
+     libvshadow_scanner_t *scanner,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libvshadow_scanner_scan_file_wide";
+	size_t filename_length           = 0;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = wide_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_scanner_scan_file_io_handle(
+	     scanner,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to scan file: %ls.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Scans a file for volume headers, catalog blocks and store blocks using a Basic File IO (bfio) handle
+ * The file is read sequentially in chunks of LIBVSHADOW_SCANNER_READ_SIZE
+ * The results of a previous scan are discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_scanner_scan_file_io_handle(
+     libvshadow_scanner_t *scanner,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_scanner_t *internal_scanner = NULL;
+	uint8_t *data                                   = NULL;
+	static char *function                           = "libvshadow_scanner_scan_file_io_handle";
+	size64_t file_size                              = 0;
+	size_t read_size                                = 0;
+	ssize_t read_count                              = 0;
+	off64_t file_offset                             = 0;
+	int file_io_handle_is_open                      = 0;
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	internal_scanner = (libvshadow_internal_scanner_t *) scanner;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_scanner->number_of_results = 0;
+	internal_scanner->abort             = 0;
+
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * LIBVSHADOW_SCANNER_READ_SIZE );
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	while( (size64_t) file_offset < file_size )
+	{
+		if( internal_scanner->abort != 0 )
+		{
+			break;
+		}
+		read_size = LIBVSHADOW_SCANNER_READ_SIZE;
+
+		if( (size64_t) read_size > ( file_size - (size64_t) file_offset ) )
+		{
+			read_size = (size_t) ( file_size - (size64_t) file_offset );
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              file_io_handle,
+		              data,
+		              read_size,
+		              file_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_offset,
+			 file_offset );
+
+			goto on_error;
+		}
+		if( libvshadow_internal_scanner_scan_buffer(
+		     internal_scanner,
+		     data,
+		     read_size,
+		     file_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to scan data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 file_offset,
+			 file_offset );
+
+			goto on_error;
+		}
+		file_offset += (off64_t) read_size;
+	}
+	memory_free(
+	 data );
+
+	data = NULL;
+
+	if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	if( file_io_handle_is_open == 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Finds the next sector that starts with the VSS identifier
+ * Only the start of every sector is compared, where the data offset
+ * is updated to the offset of the matching sector. The comparison uses
+ * SSE2 or NEON instructions if available, since the scan is bound by the
+ * speed of reading the data otherwise
+ * Returns 1 if found, 0 if not or -1 on error
+ */
+int libvshadow_scanner_find_identifier(
+     const uint8_t *data,
+     size_t data_size,
+     size_t *data_offset,
+     libcerror_error_t **error )
+{
+	static char *function   = "libvshadow_scanner_find_identifier";
+	size_t safe_data_offset = 0;
+
+#if defined( __SSE2__ )
+	__m128i identifier      = _mm_setzero_si128();
+	__m128i sector_data     = _mm_setzero_si128();
+
+#elif defined( __ARM_NEON ) && defined( __aarch64__ )
+	uint8x16_t identifier;
+	uint8x16_t sector_data;
+
+#endif
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( *data_offset % LIBVSHADOW_SCANNER_SECTOR_SIZE ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( __SSE2__ )
+	identifier = _mm_loadu_si128(
+	              (const __m128i *) vshadow_vss_identifier );
+
+#elif defined( __ARM_NEON ) && defined( __aarch64__ )
+	identifier = vld1q_u8(
+	              vshadow_vss_identifier );
+
+#endif
+	for( safe_data_offset = *data_offset;
+	     safe_data_offset < data_size;
+	     safe_data_offset += LIBVSHADOW_SCANNER_SECTOR_SIZE )
+	{
+		if( ( data_size - safe_data_offset ) < LIBVSHADOW_SCANNER_RECORD_HEADER_SIZE )
+		{
+			break;
+		}
+#if defined( __SSE2__ )
+		sector_data = _mm_loadu_si128(
+		               (const __m128i *) &( data[ safe_data_offset ] ) );
+
+		if( _mm_movemask_epi8(
+		     _mm_cmpeq_epi8(
+		      sector_data,
+		      identifier ) ) == 0x0000ffff )
+
+#elif defined( __ARM_NEON ) && defined( __aarch64__ )
+		sector_data = vld1q_u8(
+		               &( data[ safe_data_offset ] ) );
+
+		if( vminvq_u8(
+		     vceqq_u8(
+		      sector_data,
+		      identifier ) ) == 0xff )
+
+#else
+		if( ( data[ safe_data_offset ] == vshadow_vss_identifier[ 0 ] )
+		 && ( memory_compare(
+		       &( data[ safe_data_offset ] ),
+		       vshadow_vss_identifier,
+		       16 ) == 0 ) )
+#endif
+		{
+			*data_offset = safe_data_offset;
+
+			return( 1 );
+		}
+	}
+	*data_offset = safe_data_offset;
+
+	return( 0 );
+}
+
+/* Appends a result
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_scanner_append_result(
+     libvshadow_internal_scanner_t *internal_scanner,
+     off64_t offset,
+     off64_t volume_offset,
+     uint32_t record_type,
+     libcerror_error_t **error )
+{
+	libvshadow_scan_result_t *results = NULL;
+	static char *function             = "libvshadow_internal_scanner_append_result";
+	size_t results_size               = 0;
+	int number_of_allocated_results   = 0;
+
+	if( internal_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_scanner->number_of_results >= internal_scanner->number_of_allocated_results )
+	{
+		if( internal_scanner->number_of_allocated_results >= ( INT_MAX / 2 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of allocated results value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		number_of_allocated_results = internal_scanner->number_of_allocated_results * 2;
+
+		if( number_of_allocated_results == 0 )
+		{
+			number_of_allocated_results = 256;
+		}
+		results_size = sizeof( libvshadow_scan_result_t ) * number_of_allocated_results;
+
+		if( results_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid results size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		results = (libvshadow_scan_result_t *) memory_reallocate(
+		                                        internal_scanner->results,
+		                                        results_size );
+
+		if( results == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize results.",
+			 function );
+
+			return( -1 );
+		}
+		internal_scanner->results                     = results;
+		internal_scanner->number_of_allocated_results = number_of_allocated_results;
+	}
+	results = &( internal_scanner->results[ internal_scanner->number_of_results ] );
+
+	results->offset        = offset;
+	results->volume_offset = volume_offset;
+	results->record_type   = record_type;
+
+	internal_scanner->number_of_results += 1;
+
+	return( 1 );
+}
+
+/* Scans a buffer for volume headers, catalog blocks and store blocks
+ * The data offset is the offset of the buffer relative to the start of the scanned data
+ * and must be a multiple of the sector size.
+ *
+ * A volume header is stored at offset 0x1e00 of the volume and catalog and store blocks
+ * at 16 KiB boundaries relative to the start of the volume. Since a volume can start at
+ * any sector of a disk image, every sector is checked. The volume offset of a record is
+ * determined from the offset stored in the record header, this also allows to associate
+ * the blocks of deleted stores with a volume
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_scanner_scan_buffer(
+     libvshadow_internal_scanner_t *internal_scanner,
+     const uint8_t *data,
+     size_t data_size,
+     off64_t data_offset,
+     libcerror_error_t **error )
+{
+	static char *function  = "libvshadow_internal_scanner_scan_buffer";
+	size_t buffer_offset   = 0;
+	off64_t record_offset  = 0;
+	off64_t volume_offset  = 0;
+	uint64_t stored_offset = 0;
+	uint32_t record_type   = 0;
+	int result             = 0;
+
+	if( internal_scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_offset < 0 )
+	 || ( ( data_offset % LIBVSHADOW_SCANNER_SECTOR_SIZE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < data_size )
+	{
+		result = libvshadow_scanner_find_identifier(
+		          data,
+		          data_size,
+		          &buffer_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to find identifier.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		record_offset = data_offset + (off64_t) buffer_offset;
+
+		/* The volume header, catalog and store block headers share the layout
+		 * of the identifier and the record type
+		 */
+		byte_stream_copy_to_uint32_little_endian(
+		 ( (vshadow_store_block_header_t *) &( data[ buffer_offset ] ) )->record_type,
+		 record_type );
+
+		volume_offset = -1;
+
+		if( record_type == LIBVSHADOW_RECORD_TYPE_VOLUME_HEADER )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (vshadow_volume_header_t *) &( data[ buffer_offset ] ) )->offset,
+			 stored_offset );
+
+			if( ( stored_offset == LIBVSHADOW_SCANNER_VOLUME_HEADER_OFFSET )
+			 && ( record_offset >= (off64_t) LIBVSHADOW_SCANNER_VOLUME_HEADER_OFFSET ) )
+			{
+				volume_offset = record_offset - LIBVSHADOW_SCANNER_VOLUME_HEADER_OFFSET;
+			}
+		}
+		else if( ( record_type >= LIBVSHADOW_RECORD_TYPE_CATALOG )
+		      && ( record_type <= LIBVSHADOW_RECORD_TYPE_STORE_BITMAP ) )
+		{
+			byte_stream_copy_to_uint64_little_endian(
+			 ( (vshadow_store_block_header_t *) &( data[ buffer_offset ] ) )->offset,
+			 stored_offset );
+
+			if( ( ( stored_offset % LIBVSHADOW_SCANNER_BLOCK_SIZE ) == 0 )
+			 && ( stored_offset <= (uint64_t) record_offset ) )
+			{
+				volume_offset = record_offset - (off64_t) stored_offset;
+			}
+		}
+		else
+		{
+			/* Data that starts with the identifier but is not a known record is ignored
+			 */
+			record_type = 0;
+		}
+		if( record_type != 0 )
+		{
+			if( libvshadow_internal_scanner_append_result(
+			     internal_scanner,
+			     record_offset,
+			     volume_offset,
+			     record_type,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append result.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		buffer_offset += LIBVSHADOW_SCANNER_SECTOR_SIZE;
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of results
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_scanner_get_number_of_results(
+     libvshadow_scanner_t *scanner,
+     int *number_of_results,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_scanner_t *internal_scanner = NULL;
+	static char *function                           = "libvshadow_scanner_get_number_of_results";
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	internal_scanner = (libvshadow_internal_scanner_t *) scanner;
+
+	if( number_of_results == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of results.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_results = internal_scanner->number_of_results;
+
+	return( 1 );
+}
+
+/* Retrieves a specific result
+ * The record type contains a LIBVSHADOW_RECORD_TYPE value
+ * The volume offset is -1 if it could not be determined from the record
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_scanner_get_result_by_index(
+     libvshadow_scanner_t *scanner,
+     int result_index,
+     off64_t *offset,
+     uint32_t *record_type,
+     off64_t *volume_offset,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_scanner_t *internal_scanner = NULL;
+	libvshadow_scan_result_t *scan_result           = NULL;
+	static char *function                           = "libvshadow_scanner_get_result_by_index";
+
+	if( scanner == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scanner.",
+		 function );
+
+		return( -1 );
+	}
+	internal_scanner = (libvshadow_internal_scanner_t *) scanner;
+
+	if( ( result_index < 0 )
+	 || ( result_index >= internal_scanner->number_of_results ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid result index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( record_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record type.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	scan_result = &( internal_scanner->results[ result_index ] );
+
+	*offset        = scan_result->offset;
+	*record_type   = scan_result->record_type;
+	*volume_offset = scan_result->volume_offset;
+
+	return( 1 );
+}
+
@@ -0,0 +1,175 @@
+/*
+ * Scanner functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_INTERNAL_SCANNER_H )
+#define _LIBVSHADOW_INTERNAL_SCANNER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_extern.h"
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the data that is read and scanned at once
+ */
+#define LIBVSHADOW_SCANNER_READ_SIZE		( 4 * 1024 * 1024 )
+
+/* The sector size, every record starts at a sector boundary
+ */
+#define LIBVSHADOW_SCANNER_SECTOR_SIZE		512
+
+/* The size of a catalog or store block
+ */
+#define LIBVSHADOW_SCANNER_BLOCK_SIZE		0x00004000UL
+
+/* The offset of the volume header relative to the start of the volume
+ */
+#define LIBVSHADOW_SCANNER_VOLUME_HEADER_OFFSET	0x00001e00UL
+
+/* The size of the record header data that is needed to determine the record type
+ * and offset of a volume header, catalog block or store block
+ */
+#define LIBVSHADOW_SCANNER_RECORD_HEADER_SIZE	40
+
+typedef struct libvshadow_scan_result libvshadow_scan_result_t;
+
+/* A record found by the scanner
+ */
+struct libvshadow_scan_result
+{
+	/* The offset of the record relative to the start of the scanned data
+	 */
+	off64_t offset;
+
+	/* The offset of the volume that contains the record, -1 if it could not be determined
+	 */
+	off64_t volume_offset;
+
+	/* The record type
+	 */
+	uint32_t record_type;
+};
+
+typedef struct libvshadow_internal_scanner libvshadow_internal_scanner_t;
+
+struct libvshadow_internal_scanner
+{
+	/* The results
+	 */
+	libvshadow_scan_result_t *results;
+
+	/* The number of results
+	 */
+	int number_of_results;
+
+	/* The number of allocated results
+	 */
+	int number_of_allocated_results;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+LIBVSHADOW_EXTERN \
+int libvshadow_scanner_initialize(
+     libvshadow_scanner_t **scanner,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_scanner_free(
+     libvshadow_scanner_t **scanner,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_scanner_signal_abort(
+     libvshadow_scanner_t *scanner,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_scanner_scan_file(
+     libvshadow_scanner_t *scanner,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBVSHADOW_EXTERN \
+int libvshadow_scanner_scan_file_wide(
+     libvshadow_scanner_t *scanner,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBVSHADOW_EXTERN \
+int libvshadow_scanner_scan_file_io_handle(
+     libvshadow_scanner_t *scanner,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libvshadow_scanner_find_identifier(
+     const uint8_t *data,
+     size_t data_size,
+     size_t *data_offset,
+     libcerror_error_t **error );
+
+int libvshadow_internal_scanner_append_result(
+     libvshadow_internal_scanner_t *internal_scanner,
+     off64_t offset,
+     off64_t volume_offset,
+     uint32_t record_type,
+     libcerror_error_t **error );
+
+int libvshadow_internal_scanner_scan_buffer(
+     libvshadow_internal_scanner_t *internal_scanner,
+     const uint8_t *data,
+     size_t data_size,
+     off64_t data_offset,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_scanner_get_number_of_results(
+     libvshadow_scanner_t *scanner,
+     int *number_of_results,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_scanner_get_result_by_index(
+     libvshadow_scanner_t *scanner,
+     int result_index,
+     off64_t *offset,
+     uint32_t *record_type,
+     off64_t *volume_offset,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_INTERNAL_SCANNER_H ) */
+
@@ -0,0 +1,1233 @@
+/*
+ * Shared block cache functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcnotify.h"
+#include "libvshadow_shared_cache.h"
+
+#if defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT )
+
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#endif /* defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT ) */
+
+/* The signature of the shared memory object
+ */
+const uint8_t libvshadow_shared_cache_signature[ 8 ] = {
+	'v', 's', 's', 'c', 'a', 'c', 'h', 'e' };
+
+/* Creates a shared cache
+ * Make sure the value shared_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_shared_cache_initialize(
+     libvshadow_shared_cache_t **shared_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_shared_cache_initialize";
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *shared_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid shared cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*shared_cache = memory_allocate_structure(
+	                 libvshadow_shared_cache_t );
+
+	if( *shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shared cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *shared_cache,
+	     0,
+	     sizeof( libvshadow_shared_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shared cache.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *shared_cache != NULL )
+	{
+		memory_free(
+		 *shared_cache );
+
+		*shared_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a shared cache
+ * The shared memory object is not removed
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_shared_cache_free(
+     libvshadow_shared_cache_t **shared_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_shared_cache_free";
+	int result            = 1;
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *shared_cache != NULL )
+	{
+		if( ( *shared_cache )->segment != NULL )
+		{
+			if( libvshadow_shared_cache_close(
+			     *shared_cache,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close shared cache.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *shared_cache );
+
+		*shared_cache = NULL;
+	}
+	return( result );
+}
+
+/* Determines the offset of the slots in the shared memory object
+ * Returns the offset
+ */
+size_t libvshadow_shared_cache_get_slots_offset(
+        uint64_t number_of_sets )
+{
+	size_t slots_offset = 0;
+
+	slots_offset = LIBVSHADOW_SHARED_CACHE_HEADER_SIZE
+	             + ( (size_t) number_of_sets * sizeof( uint32_t ) );
+
+	/* The slots are aligned to the cache line size, which also aligns the 64-bit values
+	 * that are accessed atomically
+	 */
+	slots_offset = ( slots_offset + 63 ) & ~( (size_t) 63 );
+
+	return( slots_offset );
+}
+
+/* Determines the offset of the block data in the shared memory object
+ * Returns the offset
+ */
+size_t libvshadow_shared_cache_get_data_offset(
+        uint64_t number_of_sets,
+        uint32_t number_of_ways )
+{
+	size_t data_offset = 0;
+
+	data_offset = libvshadow_shared_cache_get_slots_offset(
+	               number_of_sets )
+	            + ( (size_t) number_of_sets * number_of_ways * sizeof( libvshadow_shared_cache_slot_t ) );
+
+	/* The block data is aligned to the page size
+	 */
+	data_offset = ( data_offset + 4095 ) & ~( (size_t) 4095 );
+
+	return( data_offset );
+}
+
+/* Opens a shared cache
+ * The shared memory object is created if it does not exist,
+ * in which case its size is based on the size argument
+ * Returns 1 if successful, 0 if the shared memory object cannot be used or -1 on error
+ */
+int libvshadow_shared_cache_open(
+     libvshadow_shared_cache_t *shared_cache,
+     const char *name,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_shared_cache_open";
+
+#if defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT )
+	struct stat file_statistics;
+	struct timespec sleep_time;
+
+	libvshadow_shared_cache_header_t *header = NULL;
+	void *segment                            = MAP_FAILED;
+	size_t data_offset                       = 0;
+	size_t segment_size                      = 0;
+	size_t set_size                          = 0;
+	uint64_t number_of_sets                  = 0;
+	int attach_attempt                       = 0;
+	int file_descriptor                      = -1;
+	int is_creator                           = 0;
+#endif
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( shared_cache->segment != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid shared cache - segment value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_shared_cache_check_name(
+	     name,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported name.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT )
+	sleep_time.tv_sec  = 0;
+	sleep_time.tv_nsec = 1000000;
+
+	file_descriptor = shm_open(
+	                   name,
+	                   O_RDWR | O_CREAT | O_EXCL,
+	                   0600 );
+
+	if( file_descriptor != -1 )
+	{
+		is_creator = 1;
+
+		set_size = ( sizeof( uint32_t ) + LIBVSHADOW_SHARED_CACHE_NUMBER_OF_WAYS
+		         * ( sizeof( libvshadow_shared_cache_slot_t ) + LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE ) );
+
+		if( (size_t) size > LIBVSHADOW_SHARED_CACHE_HEADER_SIZE )
+		{
+			number_of_sets = ( (size_t) size - LIBVSHADOW_SHARED_CACHE_HEADER_SIZE ) / set_size;
+		}
+		/* The alignment of the block data can require a set less
+		 */
+		while( number_of_sets > 0 )
+		{
+			data_offset = libvshadow_shared_cache_get_data_offset(
+			               number_of_sets,
+			               LIBVSHADOW_SHARED_CACHE_NUMBER_OF_WAYS );
+
+			segment_size = data_offset + ( (size_t) number_of_sets * LIBVSHADOW_SHARED_CACHE_NUMBER_OF_WAYS * LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE );
+
+			if( segment_size <= (size_t) size )
+			{
+				break;
+			}
+			number_of_sets--;
+		}
+		if( number_of_sets == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: invalid size value too small.",
+			 function );
+
+			goto on_error;
+		}
+		if( ftruncate(
+		     file_descriptor,
+		     (off_t) segment_size ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_RESIZE_FAILED,
+			 errno,
+			 "%s: unable to resize shared memory object: %s.",
+			 function,
+			 name );
+
+			goto on_error;
+		}
+	}
+	else if( errno == EEXIST )
+	{
+		file_descriptor = shm_open(
+		                   name,
+		                   O_RDWR,
+		                   0 );
+
+		if( file_descriptor == -1 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to open shared memory object: %s.",
+			 function,
+			 name );
+
+			goto on_error;
+		}
+		/* The process that created the object resizes it after creation
+		 */
+		for( attach_attempt = 0;
+		     attach_attempt < LIBVSHADOW_SHARED_CACHE_MAXIMUM_NUMBER_OF_ATTACH_ATTEMPTS;
+		     attach_attempt++ )
+		{
+			if( fstat(
+			     file_descriptor,
+			     &file_statistics ) != 0 )
+			{
+				libcerror_system_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 errno,
+				 "%s: unable to retrieve shared memory object statistics.",
+				 function );
+
+				goto on_error;
+			}
+			if( file_statistics.st_size > LIBVSHADOW_SHARED_CACHE_HEADER_SIZE )
+			{
+				break;
+			}
+			nanosleep(
+			 &sleep_time,
+			 NULL );
+		}
+		if( ( file_statistics.st_size <= LIBVSHADOW_SHARED_CACHE_HEADER_SIZE )
+		 || ( (uint64_t) file_statistics.st_size > (uint64_t) SSIZE_MAX ) )
+		{
+			close(
+			 file_descriptor );
+
+			return( 0 );
+		}
+		segment_size = (size_t) file_statistics.st_size;
+	}
+	else
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to create shared memory object: %s.",
+		 function,
+		 name );
+
+		goto on_error;
+	}
+	segment = mmap(
+	           NULL,
+	           segment_size,
+	           PROT_READ | PROT_WRITE,
+	           MAP_SHARED,
+	           file_descriptor,
+	           0 );
+
+	if( segment == MAP_FAILED )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 errno,
+		 "%s: unable to map shared memory object: %s.",
+		 function,
+		 name );
+
+		goto on_error;
+	}
+	/* The mapping remains valid after the file descriptor has been closed
+	 */
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 errno,
+		 "%s: unable to close shared memory object: %s.",
+		 function,
+		 name );
+
+		file_descriptor = -1;
+
+		goto on_error;
+	}
+	file_descriptor = -1;
+
+	header = (libvshadow_shared_cache_header_t *) segment;
+
+	if( is_creator != 0 )
+	{
+		/* The object is filled with 0-byte values on creation,
+		 * hence all slots are empty
+		 */
+		if( memory_copy(
+		     header->signature,
+		     libvshadow_shared_cache_signature,
+		     8 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy signature.",
+			 function );
+
+			goto on_error;
+		}
+		header->format_version = LIBVSHADOW_SHARED_CACHE_FORMAT_VERSION;
+		header->block_size     = (uint32_t) LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE;
+		header->number_of_ways = LIBVSHADOW_SHARED_CACHE_NUMBER_OF_WAYS;
+		header->number_of_sets = number_of_sets;
+		header->segment_size   = (uint64_t) segment_size;
+
+		__atomic_store_n(
+		 &( header->state ),
+		 LIBVSHADOW_SHARED_CACHE_STATE_READY,
+		 __ATOMIC_RELEASE );
+	}
+	else
+	{
+		for( attach_attempt = 0;
+		     attach_attempt < LIBVSHADOW_SHARED_CACHE_MAXIMUM_NUMBER_OF_ATTACH_ATTEMPTS;
+		     attach_attempt++ )
+		{
+			if( __atomic_load_n(
+			     &( header->state ),
+			     __ATOMIC_ACQUIRE ) == LIBVSHADOW_SHARED_CACHE_STATE_READY )
+			{
+				break;
+			}
+			nanosleep(
+			 &sleep_time,
+			 NULL );
+		}
+		/* The object is not used if it was not initialized in time or was created
+		 * with another format, for example by another version of the library
+		 */
+		if( ( __atomic_load_n(
+		       &( header->state ),
+		       __ATOMIC_ACQUIRE ) != LIBVSHADOW_SHARED_CACHE_STATE_READY )
+		 || ( memory_compare(
+		       header->signature,
+		       libvshadow_shared_cache_signature,
+		       8 ) != 0 )
+		 || ( header->format_version != LIBVSHADOW_SHARED_CACHE_FORMAT_VERSION )
+		 || ( header->block_size != (uint32_t) LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE )
+		 || ( header->number_of_ways != LIBVSHADOW_SHARED_CACHE_NUMBER_OF_WAYS )
+		 || ( header->segment_size != (uint64_t) segment_size )
+		 || ( header->number_of_sets == 0 )
+		 || ( header->number_of_sets > ( (uint64_t) segment_size / LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE ) ) )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unsupported shared memory object: %s.\n",
+				 function,
+				 name );
+			}
+#endif
+			munmap(
+			 segment,
+			 segment_size );
+
+			return( 0 );
+		}
+		number_of_sets = header->number_of_sets;
+
+		data_offset = libvshadow_shared_cache_get_data_offset(
+		               number_of_sets,
+		               LIBVSHADOW_SHARED_CACHE_NUMBER_OF_WAYS );
+
+		if( ( data_offset + ( (size_t) number_of_sets * LIBVSHADOW_SHARED_CACHE_NUMBER_OF_WAYS * LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE ) ) > segment_size )
+		{
+			munmap(
+			 segment,
+			 segment_size );
+
+			return( 0 );
+		}
+	}
+	shared_cache->segment        = (uint8_t *) segment;
+	shared_cache->segment_size   = segment_size;
+	shared_cache->header         = header;
+	shared_cache->clock_hands    = (uint32_t *) &( shared_cache->segment[ LIBVSHADOW_SHARED_CACHE_HEADER_SIZE ] );
+	shared_cache->slots          = (libvshadow_shared_cache_slot_t *) &( shared_cache->segment[ libvshadow_shared_cache_get_slots_offset( number_of_sets ) ] );
+	shared_cache->data           = &( shared_cache->segment[ data_offset ] );
+	shared_cache->number_of_sets = number_of_sets;
+	shared_cache->number_of_ways = LIBVSHADOW_SHARED_CACHE_NUMBER_OF_WAYS;
+	shared_cache->block_size     = LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE;
+
+	return( 1 );
+
+on_error:
+	if( segment != MAP_FAILED )
+	{
+		munmap(
+		 segment,
+		 segment_size );
+	}
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+	/* An object that was not initialized would block other processes
+	 */
+	if( is_creator != 0 )
+	{
+		shm_unlink(
+		 name );
+	}
+	return( -1 );
+#else
+	return( 0 );
+#endif /* defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT ) */
+}
+
+/* Closes a shared cache
+ * The shared memory object is not removed
+ * Returns 0 if successful or -1 on error
+ */
+int libvshadow_shared_cache_close(
+     libvshadow_shared_cache_t *shared_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_shared_cache_close";
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT )
+	if( shared_cache->segment != NULL )
+	{
+		if( munmap(
+		     shared_cache->segment,
+		     shared_cache->segment_size ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to unmap shared memory object.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	shared_cache->segment          = NULL;
+	shared_cache->segment_size     = 0;
+	shared_cache->header           = NULL;
+	shared_cache->clock_hands      = NULL;
+	shared_cache->slots            = NULL;
+	shared_cache->data             = NULL;
+	shared_cache->number_of_sets   = 0;
+	shared_cache->number_of_ways   = 0;
+	shared_cache->image_identifier = 0;
+
+	return( 0 );
+}
+
+/* Removes the shared memory object of a shared cache
+ * Processes that have the object open can continue to use it
+ * Returns 1 if successful, 0 if the object does not exist or -1 on error
+ */
+int libvshadow_shared_cache_remove(
+     const char *name,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_shared_cache_remove";
+
+	if( libvshadow_shared_cache_check_name(
+	     name,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported name.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT )
+	if( shm_unlink(
+	     name ) != 0 )
+	{
+		if( errno == ENOENT )
+		{
+			return( 0 );
+		}
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+		 errno,
+		 "%s: unable to remove shared memory object: %s.",
+		 function,
+		 name );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Checks if a name of a shared cache is valid
+ * The name must start with a / and cannot contain other / characters
+ * Returns 1 if valid or -1 on error
+ */
+int libvshadow_shared_cache_check_name(
+     const char *name,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_shared_cache_check_name";
+	size_t name_index     = 0;
+	size_t name_length    = 0;
+
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	name_length = narrow_string_length(
+	               name );
+
+	if( ( name_length < 2 )
+	 || ( name_length > 255 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid name length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( name[ 0 ] != '/' )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported name - missing leading /.",
+		 function );
+
+		return( -1 );
+	}
+	for( name_index = 1;
+	     name_index < name_length;
+	     name_index++ )
+	{
+		if( name[ name_index ] == '/' )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported name - / at index: %" PRIzd ".",
+			 function,
+			 name_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Updates a 64-bit FNV-1a hash with data
+ * Returns the updated hash
+ */
+uint64_t libvshadow_shared_cache_hash(
+          uint64_t hash,
+          const uint8_t *data,
+          size_t data_size )
+{
+	size_t data_offset = 0;
+
+	if( data == NULL )
+	{
+		return( hash );
+	}
+	for( data_offset = 0;
+	     data_offset < data_size;
+	     data_offset++ )
+	{
+		hash ^= data[ data_offset ];
+		hash *= 0x00000100000001b3ULL;
+	}
+	return( hash );
+}
+
+/* Sets the identifier of the image
+ * Blocks are looked up and stored under this identifier, 0 disables the shared cache
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_shared_cache_set_image_identifier(
+     libvshadow_shared_cache_t *shared_cache,
+     uint64_t image_identifier,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_shared_cache_set_image_identifier";
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	shared_cache->image_identifier = image_identifier;
+
+	return( 1 );
+}
+
+/* Determines the index of the set a block maps to
+ * Returns the set index
+ */
+uint64_t libvshadow_shared_cache_get_set_index(
+          libvshadow_shared_cache_t *shared_cache,
+          uint64_t block_number )
+{
+	uint64_t key = 0;
+
+	if( ( shared_cache == NULL )
+	 || ( shared_cache->number_of_sets == 0 ) )
+	{
+		return( 0 );
+	}
+	/* Mix the key so that consecutive blocks map to unrelated sets
+	 */
+	key  = shared_cache->image_identifier ^ ( block_number * 0x9e3779b97f4a7c15ULL );
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ULL;
+	key ^= key >> 33;
+
+	return( key % shared_cache->number_of_sets );
+}
+
+/* Reads (part of) a block from the shared cache
+ * The slots are read without locking, a slot that was changed while it was read is considered a miss
+ * Returns 1 if successful, 0 if the block is not in the cache or -1 on error
+ */
+int libvshadow_shared_cache_read_block(
+     libvshadow_shared_cache_t *shared_cache,
+     uint64_t block_number,
+     size_t block_offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_shared_cache_read_block";
+
+#if defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT )
+	libvshadow_shared_cache_slot_t *slot = NULL;
+	uint64_t first_sequence_number       = 0;
+	uint64_t second_sequence_number      = 0;
+	uint64_t slot_index                  = 0;
+	uint32_t way_index                   = 0;
+#endif
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_offset >= LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE )
+	 || ( size > ( LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE - block_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block offset or size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT )
+	if( ( shared_cache->segment == NULL )
+	 || ( shared_cache->image_identifier == 0 ) )
+	{
+		return( 0 );
+	}
+	slot_index = libvshadow_shared_cache_get_set_index(
+	              shared_cache,
+	              block_number ) * shared_cache->number_of_ways;
+
+	for( way_index = 0;
+	     way_index < shared_cache->number_of_ways;
+	     way_index++ )
+	{
+		slot = &( shared_cache->slots[ slot_index + way_index ] );
+
+		first_sequence_number = __atomic_load_n(
+		                         &( slot->sequence_number ),
+		                         __ATOMIC_ACQUIRE );
+
+		if( ( first_sequence_number == 0 )
+		 || ( ( first_sequence_number & 1 ) != 0 ) )
+		{
+			continue;
+		}
+		if( ( __atomic_load_n(
+		       &( slot->image_identifier ),
+		       __ATOMIC_RELAXED ) != shared_cache->image_identifier )
+		 || ( __atomic_load_n(
+		       &( slot->block_number ),
+		       __ATOMIC_RELAXED ) != block_number ) )
+		{
+			continue;
+		}
+		/* The data can be overwritten by another process while it is copied,
+		 * which is detected by a change of the sequence number
+		 */
+		if( memory_copy(
+		     buffer,
+		     &( shared_cache->data[ ( ( slot_index + way_index ) * shared_cache->block_size ) + block_offset ] ),
+		     size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block data.",
+			 function );
+
+			return( -1 );
+		}
+		__atomic_thread_fence(
+		 __ATOMIC_ACQUIRE );
+
+		second_sequence_number = __atomic_load_n(
+		                          &( slot->sequence_number ),
+		                          __ATOMIC_RELAXED );
+
+		if( second_sequence_number != first_sequence_number )
+		{
+			break;
+		}
+		/* Only write the reference flag when it changes, to keep the cache line shared
+		 */
+		if( __atomic_load_n(
+		     &( slot->is_referenced ),
+		     __ATOMIC_RELAXED ) == 0 )
+		{
+			__atomic_store_n(
+			 &( slot->is_referenced ),
+			 1,
+			 __ATOMIC_RELAXED );
+		}
+		__atomic_fetch_add(
+		 &( shared_cache->number_of_hits ),
+		 1,
+		 __ATOMIC_RELAXED );
+
+		return( 1 );
+	}
+	__atomic_fetch_add(
+	 &( shared_cache->number_of_misses ),
+	 1,
+	 __ATOMIC_RELAXED );
+#endif /* defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT ) */
+
+	return( 0 );
+}
+
+/* Writes a block to the shared cache
+ * The slot is selected with the clock algorithm: the clock hand of the set passes
+ * the slots and clears their reference flag, the first slot that was not referenced is replaced
+ * A block is stored unreferenced, so blocks that are read once are replaced first
+ * Returns 1 if successful, 0 if the block was not stored or -1 on error
+ */
+int libvshadow_shared_cache_write_block(
+     libvshadow_shared_cache_t *shared_cache,
+     uint64_t block_number,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_shared_cache_write_block";
+
+#if defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT )
+	libvshadow_shared_cache_slot_t *slot = NULL;
+	uint64_t sequence_number             = 0;
+	uint64_t set_index                   = 0;
+	uint64_t slot_index                  = 0;
+	uint32_t clock_hand                  = 0;
+	uint32_t iteration                   = 0;
+	uint32_t way_index                   = 0;
+#endif
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size != LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT )
+	if( ( shared_cache->segment == NULL )
+	 || ( shared_cache->image_identifier == 0 ) )
+	{
+		return( 0 );
+	}
+	set_index = libvshadow_shared_cache_get_set_index(
+	             shared_cache,
+	             block_number );
+
+	slot_index = set_index * shared_cache->number_of_ways;
+
+	/* Do not store a block that was stored by another process or thread in the meantime
+	 */
+	for( way_index = 0;
+	     way_index < shared_cache->number_of_ways;
+	     way_index++ )
+	{
+		slot = &( shared_cache->slots[ slot_index + way_index ] );
+
+		sequence_number = __atomic_load_n(
+		                   &( slot->sequence_number ),
+		                   __ATOMIC_ACQUIRE );
+
+		if( ( sequence_number != 0 )
+		 && ( ( sequence_number & 1 ) == 0 )
+		 && ( __atomic_load_n(
+		       &( slot->image_identifier ),
+		       __ATOMIC_RELAXED ) == shared_cache->image_identifier )
+		 && ( __atomic_load_n(
+		       &( slot->block_number ),
+		       __ATOMIC_RELAXED ) == block_number ) )
+		{
+			return( 0 );
+		}
+	}
+	clock_hand = __atomic_fetch_add(
+	              &( shared_cache->clock_hands[ set_index ] ),
+	              1,
+	              __ATOMIC_RELAXED );
+
+	/* After one pass all reference flags are cleared, hence 2 passes always find a slot
+	 * unless other processes are writing the slots
+	 */
+	for( iteration = 0;
+	     iteration < ( 2 * shared_cache->number_of_ways );
+	     iteration++ )
+	{
+		way_index = ( clock_hand + iteration ) % shared_cache->number_of_ways;
+
+		slot = &( shared_cache->slots[ slot_index + way_index ] );
+
+		sequence_number = __atomic_load_n(
+		                   &( slot->sequence_number ),
+		                   __ATOMIC_ACQUIRE );
+
+		if( ( sequence_number & 1 ) != 0 )
+		{
+			continue;
+		}
+		if( sequence_number != 0 )
+		{
+			if( __atomic_load_n(
+			     &( slot->is_referenced ),
+			     __ATOMIC_RELAXED ) != 0 )
+			{
+				__atomic_store_n(
+				 &( slot->is_referenced ),
+				 0,
+				 __ATOMIC_RELAXED );
+
+				continue;
+			}
+		}
+		/* Claim the slot by making its sequence number odd, if another process
+		 * claimed the slot in the meantime the next slot is tried
+		 */
+		if( __atomic_compare_exchange_n(
+		     &( slot->sequence_number ),
+		     &sequence_number,
+		     sequence_number + 1,
+		     0,
+		     __ATOMIC_ACQUIRE,
+		     __ATOMIC_RELAXED ) == 0 )
+		{
+			continue;
+		}
+		/* Make sure the claim is visible before the slot is changed
+		 */
+		__atomic_thread_fence(
+		 __ATOMIC_RELEASE );
+
+		__atomic_store_n(
+		 &( slot->image_identifier ),
+		 shared_cache->image_identifier,
+		 __ATOMIC_RELAXED );
+
+		__atomic_store_n(
+		 &( slot->block_number ),
+		 block_number,
+		 __ATOMIC_RELAXED );
+
+		__atomic_store_n(
+		 &( slot->is_referenced ),
+		 0,
+		 __ATOMIC_RELAXED );
+
+		memory_copy(
+		 &( shared_cache->data[ ( slot_index + way_index ) * shared_cache->block_size ] ),
+		 data,
+		 data_size );
+
+		__atomic_store_n(
+		 &( slot->sequence_number ),
+		 sequence_number + 2,
+		 __ATOMIC_RELEASE );
+
+		__atomic_fetch_add(
+		 &( shared_cache->header->number_of_insertions ),
+		 1,
+		 __ATOMIC_RELAXED );
+
+		if( sequence_number != 0 )
+		{
+			__atomic_fetch_add(
+			 &( shared_cache->header->number_of_evictions ),
+			 1,
+			 __ATOMIC_RELAXED );
+		}
+		return( 1 );
+	}
+#endif /* defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT ) */
+
+	return( 0 );
+}
+
+/* Retrieves the number of blocks this process found and did not find in the shared cache
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_shared_cache_get_statistics(
+     libvshadow_shared_cache_t *shared_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_shared_cache_get_statistics";
+
+	if( shared_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shared cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT )
+	*number_of_hits = __atomic_load_n(
+	                   &( shared_cache->number_of_hits ),
+	                   __ATOMIC_RELAXED );
+
+	*number_of_misses = __atomic_load_n(
+	                     &( shared_cache->number_of_misses ),
+	                     __ATOMIC_RELAXED );
+#else
+	*number_of_hits   = shared_cache->number_of_hits;
+	*number_of_misses = shared_cache->number_of_misses;
+#endif
+	return( 1 );
+}
+
@@ -0,0 +1,279 @@
+/*
+ * Shared block cache functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_SHARED_CACHE_H )
+#define _LIBVSHADOW_SHARED_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The cache is stored in a POSIX shared memory object that is mapped into memory
+ * The atomic built-in functions of GCC and Clang are used to access it without locking
+ */
+#if defined( HAVE_SHM_OPEN ) && defined( HAVE_SHM_UNLINK ) && defined( HAVE_SYS_MMAN_H ) && defined( HAVE_SYS_STAT_H ) && defined( HAVE_FCNTL_H ) && defined( HAVE_UNISTD_H ) && defined( __GNUC__ )
+#define HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT
+#endif
+
+/* The size of a cached block
+ */
+#define LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE			0x00004000UL
+
+/* The number of slots in a set, a block can only be stored in a slot of the set its key maps to
+ */
+#define LIBVSHADOW_SHARED_CACHE_NUMBER_OF_WAYS			8
+
+/* The size of the header at the start of the shared memory object
+ */
+#define LIBVSHADOW_SHARED_CACHE_HEADER_SIZE			4096
+
+/* The format version of the shared memory object
+ */
+#define LIBVSHADOW_SHARED_CACHE_FORMAT_VERSION			1
+
+/* The number of times an attaching process checks if the shared memory object
+ * was initialized by the process that created it, with an interval of 1 millisecond
+ */
+#define LIBVSHADOW_SHARED_CACHE_MAXIMUM_NUMBER_OF_ATTACH_ATTEMPTS	1000
+
+/* The maximum size of the caller supplied image identifier
+ */
+#define LIBVSHADOW_SHARED_CACHE_MAXIMUM_IMAGE_IDENTIFIER_SIZE	1024
+
+/* The initial value of a 64-bit FNV-1a hash
+ */
+#define LIBVSHADOW_SHARED_CACHE_HASH_INITIAL_VALUE		0xcbf29ce484222325ULL
+
+enum LIBVSHADOW_SHARED_CACHE_STATES
+{
+	LIBVSHADOW_SHARED_CACHE_STATE_INITIALIZING		= 0,
+	LIBVSHADOW_SHARED_CACHE_STATE_READY			= 1
+};
+
+typedef struct libvshadow_shared_cache_header libvshadow_shared_cache_header_t;
+
+/* The header of the shared memory object
+ * The fields are only changed by the process that created the object,
+ * before the state is set to ready, except for the statistics
+ */
+struct libvshadow_shared_cache_header
+{
+	/* The signature
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 */
+	uint32_t format_version;
+
+	/* The state
+	 */
+	uint32_t state;
+
+	/* The block size
+	 */
+	uint32_t block_size;
+
+	/* The number of slots per set
+	 */
+	uint32_t number_of_ways;
+
+	/* The number of sets
+	 */
+	uint64_t number_of_sets;
+
+	/* The size of the shared memory object
+	 */
+	uint64_t segment_size;
+
+	/* The number of blocks stored by all processes
+	 */
+	uint64_t number_of_insertions;
+
+	/* The number of blocks evicted by all processes
+	 */
+	uint64_t number_of_evictions;
+};
+
+typedef struct libvshadow_shared_cache_slot libvshadow_shared_cache_slot_t;
+
+/* A slot of the shared memory object
+ */
+struct libvshadow_shared_cache_slot
+{
+	/* The sequence number
+	 * 0 if the slot is empty, odd while the slot is being written
+	 * A reader copies the block and checks afterwards that the sequence number did not change
+	 */
+	uint64_t sequence_number;
+
+	/* The identifier of the image the block was read from
+	 */
+	uint64_t image_identifier;
+
+	/* The block number, which is the offset of the block divided by the block size
+	 */
+	uint64_t block_number;
+
+	/* Value to indicate the block was read since the clock hand last passed it
+	 */
+	uint32_t is_referenced;
+
+	/* Unused
+	 */
+	uint32_t unused;
+};
+
+typedef struct libvshadow_shared_cache libvshadow_shared_cache_t;
+
+/* The mapping of the shared memory object into the address space of the process
+ */
+struct libvshadow_shared_cache
+{
+	/* The mapped shared memory object
+	 */
+	uint8_t *segment;
+
+	/* The size of the mapped shared memory object
+	 */
+	size_t segment_size;
+
+	/* The header
+	 */
+	libvshadow_shared_cache_header_t *header;
+
+	/* The clock hand of every set
+	 */
+	uint32_t *clock_hands;
+
+	/* The slots
+	 */
+	libvshadow_shared_cache_slot_t *slots;
+
+	/* The block data of the slots
+	 */
+	uint8_t *data;
+
+	/* The number of sets
+	 */
+	uint64_t number_of_sets;
+
+	/* The number of slots per set
+	 */
+	uint32_t number_of_ways;
+
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The identifier of the image
+	 * 0 if not set, in which case blocks are not looked up or stored
+	 */
+	uint64_t image_identifier;
+
+	/* The number of blocks this process found in the cache
+	 */
+	uint64_t number_of_hits;
+
+	/* The number of blocks this process did not find in the cache
+	 */
+	uint64_t number_of_misses;
+};
+
+int libvshadow_shared_cache_initialize(
+     libvshadow_shared_cache_t **shared_cache,
+     libcerror_error_t **error );
+
+int libvshadow_shared_cache_free(
+     libvshadow_shared_cache_t **shared_cache,
+     libcerror_error_t **error );
+
+size_t libvshadow_shared_cache_get_slots_offset(
+        uint64_t number_of_sets );
+
+size_t libvshadow_shared_cache_get_data_offset(
+        uint64_t number_of_sets,
+        uint32_t number_of_ways );
+
+int libvshadow_shared_cache_open(
+     libvshadow_shared_cache_t *shared_cache,
+     const char *name,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libvshadow_shared_cache_close(
+     libvshadow_shared_cache_t *shared_cache,
+     libcerror_error_t **error );
+
+int libvshadow_shared_cache_remove(
+     const char *name,
+     libcerror_error_t **error );
+
+int libvshadow_shared_cache_check_name(
+     const char *name,
+     libcerror_error_t **error );
+
+uint64_t libvshadow_shared_cache_hash(
+          uint64_t hash,
+          const uint8_t *data,
+          size_t data_size );
+
+int libvshadow_shared_cache_set_image_identifier(
+     libvshadow_shared_cache_t *shared_cache,
+     uint64_t image_identifier,
+     libcerror_error_t **error );
+
+uint64_t libvshadow_shared_cache_get_set_index(
+          libvshadow_shared_cache_t *shared_cache,
+          uint64_t block_number );
+
+int libvshadow_shared_cache_read_block(
+     libvshadow_shared_cache_t *shared_cache,
+     uint64_t block_number,
+     size_t block_offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int libvshadow_shared_cache_write_block(
+     libvshadow_shared_cache_t *shared_cache,
+     uint64_t block_number,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvshadow_shared_cache_get_statistics(
+     libvshadow_shared_cache_t *shared_cache,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_SHARED_CACHE_H ) */
+
@@ -23,16 +23,21 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libvshadow_allocation_bitmap.h"
 #include "libvshadow_block.h"
 #include "libvshadow_block_descriptor.h"
 #include "libvshadow_block_tree.h"
+#include "libvshadow_data_view.h"
 #include "libvshadow_definitions.h"
+#include "libvshadow_file_mapping.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcthreads.h"
+#include "libvshadow_read_thread_pool.h"
 #include "libvshadow_store.h"
 #include "libvshadow_store_descriptor.h"
+#include "libvshadow_store_mapping.h"
 #include "libvshadow_volume.h"
 
 /* Creates a store
@@ -207,6 +212,45 @@ int libvshadow_store_free(
 
 		/* The file_io_handle, io_handle and internal_volume references are freed elsewhere
 		 */
+		if( internal_store->read_ahead_buffer != NULL )
+		{
+			memory_free(
+			 internal_store->read_ahead_buffer );
+		}
+		if( internal_store->allocation_bitmap != NULL )
+		{
+			if( libvshadow_allocation_bitmap_free(
+			     &( internal_store->allocation_bitmap ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free allocation bitmap.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT )
+		if( internal_store->store_mapping != NULL )
+		{
+			if( libvshadow_store_mapping_free(
+			     &( internal_store->store_mapping ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free store mapping.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 		if( libcthreads_read_write_lock_free(
 		     &( internal_store->read_write_lock ),
@@ -282,18 +326,19 @@ int libvshadow_store_has_in_volume_data(
 	return( result );
 }
 
-/* Reads (store) data at the current offset into a buffer using a Basic File IO (bfio) handle
+/* Reads (store) data at a specific offset into a buffer using a Basic File IO (bfio) handle
  * This function is not multi-thread safe acquire write lock before call
  * Returns the number of bytes read or -1 on error
  */
-ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
+ssize_t libvshadow_internal_store_read_data(
          libvshadow_internal_store_t *internal_store,
          libbfio_handle_t *file_io_handle,
-         void *buffer,
+         uint8_t *buffer,
          size_t buffer_size,
+         off64_t offset,
          libcerror_error_t **error )
 {
-	static char *function = "libvshadow_internal_store_read_buffer_from_file_io_handle";
+	static char *function = "libvshadow_internal_store_read_data";
 	ssize_t read_count    = 0;
 
 	if( internal_store == NULL )
@@ -318,89 +363,82 @@ ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
 
 		return( -1 );
 	}
-	if( internal_store->current_offset < 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid store - current offset value out of bounds.",
-		 function );
-
-		return( -1 );
-	}
-	if( buffer == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
-		 function );
-
-		return( -1 );
-	}
-	if( buffer_size > (size_t) SSIZE_MAX )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid element data size value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
-	if( ( buffer_size == 0 )
-	 || ( (size64_t) internal_store->current_offset >= internal_store->internal_volume->size ) )
-	{
-		return( 0 );
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	/* Large reads are split into segments that are read in parallel
+	 * by the read thread pool, if one is set for the volume.
+	 * The threads use clones of the file IO handle of the volume
+	 */
+	if( ( internal_store->internal_volume->read_thread_pool != NULL )
+	 && ( file_io_handle == internal_store->internal_volume->file_io_handle )
+	 && ( buffer_size >= LIBVSHADOW_READ_THREAD_POOL_MINIMUM_READ_SIZE ) )
+	{
+		read_count = libvshadow_read_thread_pool_read_buffer(
+			      internal_store->internal_volume->read_thread_pool,
+			      internal_store->store_descriptor,
+			      internal_store->io_handle,
+			      file_io_handle,
+			      buffer,
+			      buffer_size,
+			      offset,
+			      internal_store->store_descriptor_index,
+			      error );
 	}
-	if( (size64_t) buffer_size > ( internal_store->internal_volume->size - internal_store->current_offset ) )
+	else
+#endif
 	{
-		buffer_size = (size_t) ( internal_store->internal_volume->size - internal_store->current_offset );
+		read_count = libvshadow_store_descriptor_read_buffer(
+			      internal_store->store_descriptor,
+			      internal_store->io_handle,
+			      file_io_handle,
+			      buffer,
+			      buffer_size,
+			      offset,
+			      internal_store->store_descriptor_index,
+			      error );
 	}
-	read_count = libvshadow_store_descriptor_read_buffer(
-		      internal_store->store_descriptor,
-		      internal_store->io_handle,
-		      file_io_handle,
-		      (uint8_t *) buffer,
-		      buffer_size,
-		      internal_store->current_offset,
-		      internal_store->store_descriptor_index,
-		      error );
-
 	if( read_count != (ssize_t) buffer_size )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer from store descriptor: %d.",
+		 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ") from store descriptor: %d.",
 		 function,
+		 offset,
+		 offset,
 		 internal_store->store_descriptor_index );
 
 		return( -1 );
 	}
-	internal_store->current_offset += read_count;
-
 	return( read_count );
 }
 
-/* Reads (store) data at the current offset into a buffer
+/* Reads (store) data at a specific offset into a buffer using the read-ahead buffer
+ * Sequential reads grow the read-ahead window up to the maximum read-ahead size,
+ * other reads shrink it. When the data is not in the read-ahead buffer and the
+ * remaining size is smaller than the window, the read-ahead buffer is filled
+ * with the data of the window
+ * This function is not multi-thread safe acquire write lock before call
  * Returns the number of bytes read or -1 on error
  */
-ssize_t libvshadow_store_read_buffer(
-         libvshadow_store_t *store,
-         void *buffer,
+ssize_t libvshadow_internal_store_read_data_with_read_ahead(
+         libvshadow_internal_store_t *internal_store,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
          size_t buffer_size,
+         off64_t offset,
          libcerror_error_t **error )
 {
-	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_read_buffer";
-	ssize_t read_count                          = 0;
+	static char *function    = "libvshadow_internal_store_read_data_with_read_ahead";
+	size64_t remaining_size  = 0;
+	size_t buffer_offset     = 0;
+	size_t fill_size         = 0;
+	size_t read_ahead_offset = 0;
+	size_t read_size         = 0;
+	ssize_t read_count       = 0;
+	off64_t fill_offset      = 0;
 
-	if( store == NULL )
+	if( internal_store == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -411,152 +449,262 @@ ssize_t libvshadow_store_read_buffer(
 
 		return( -1 );
 	}
-	internal_store = (libvshadow_internal_store_t *) store;
-
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_store->read_write_lock,
-	     error ) != 1 )
+	if( internal_store->internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	read_count = libvshadow_internal_store_read_buffer_from_file_io_handle(
-		      internal_store,
-		      internal_store->file_io_handle,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
+	if( internal_store->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing IO handle.",
 		 function );
 
-		read_count = -1;
+		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_store->read_write_lock,
-	     error ) != 1 )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( read_count );
-}
-
-/* Reads (store) data at the current offset into a buffer using a Basic File IO (bfio) handle
- * Returns the number of bytes read or -1 on error
- */
-ssize_t libvshadow_store_read_buffer_from_file_io_handle(
-         libvshadow_store_t *store,
-         libbfio_handle_t *file_io_handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_read_buffer_from_file_io_handle";
-	ssize_t read_count                          = 0;
-
-	if( store == NULL )
+	if( buffer_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid store.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	internal_store = (libvshadow_internal_store_t *) store;
-
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_store->read_write_lock,
-	     error ) != 1 )
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= internal_store->internal_volume->size ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	read_count = libvshadow_internal_store_read_buffer_from_file_io_handle(
-		      internal_store,
-		      file_io_handle,
-		      buffer,
-		      buffer_size,
-		      error );
+	/* Grow the read-ahead window on sequential access and shrink it on non-sequential
+	 * access, so that an occasional out of order read does not discard the window
+	 * of a sequential reader while random access stops reading ahead after a few reads
+	 */
+	if( offset == internal_store->read_ahead_next_offset )
+	{
+		if( internal_store->read_ahead_window_size == 0 )
+		{
+			internal_store->read_ahead_window_size = LIBVSHADOW_STORE_READ_AHEAD_MINIMUM_WINDOW_SIZE;
+		}
+		else if( internal_store->read_ahead_window_size < internal_store->maximum_read_ahead_size )
+		{
+			internal_store->read_ahead_window_size *= 2;
+		}
+		if( internal_store->read_ahead_window_size > internal_store->maximum_read_ahead_size )
+		{
+			internal_store->read_ahead_window_size = internal_store->maximum_read_ahead_size;
+		}
+	}
+	else
+	{
+		internal_store->read_ahead_window_size /= 2;
 
-	if( read_count == -1 )
+		if( internal_store->read_ahead_window_size < LIBVSHADOW_STORE_READ_AHEAD_MINIMUM_WINDOW_SIZE )
+		{
+			internal_store->read_ahead_window_size = 0;
+		}
+	}
+	/* The data in the read-ahead buffer is discarded when the volume was refreshed
+	 * since the store can resolve its data from a newer store
+	 */
+	if( internal_store->read_ahead_number_of_refreshes != internal_store->io_handle->number_of_refreshes )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+		internal_store->read_ahead_data_size = 0;
+	}
+	if( ( internal_store->read_ahead_data_size > 0 )
+	 && ( offset >= internal_store->read_ahead_data_offset )
+	 && ( offset < ( internal_store->read_ahead_data_offset + (off64_t) internal_store->read_ahead_data_size ) ) )
+	{
+		read_ahead_offset = (size_t) ( offset - internal_store->read_ahead_data_offset );
+		read_size         = internal_store->read_ahead_data_size - read_ahead_offset;
 
-		read_count = -1;
+		if( read_size > buffer_size )
+		{
+			read_size = buffer_size;
+		}
+		if( memory_copy(
+		     buffer,
+		     &( internal_store->read_ahead_buffer[ read_ahead_offset ] ),
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data from read-ahead buffer.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset = read_size;
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_store->read_write_lock,
-	     error ) != 1 )
+	if( buffer_offset < buffer_size )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
+		read_size   = buffer_size - buffer_offset;
+		fill_offset = offset + (off64_t) buffer_offset;
 
-		return( -1 );
+		if( read_size >= internal_store->read_ahead_window_size )
+		{
+			/* The remaining data is read directly into the buffer
+			 */
+			read_count = libvshadow_internal_store_read_data(
+			              internal_store,
+			              file_io_handle,
+			              &( buffer[ buffer_offset ] ),
+			              read_size,
+			              fill_offset,
+			              error );
+
+			if( read_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			fill_size      = internal_store->read_ahead_window_size;
+			remaining_size = internal_store->internal_volume->size - (size64_t) fill_offset;
+
+			if( (size64_t) fill_size > remaining_size )
+			{
+				fill_size = (size_t) remaining_size;
+			}
+			if( fill_size > internal_store->read_ahead_buffer_size )
+			{
+				if( internal_store->read_ahead_buffer != NULL )
+				{
+					memory_free(
+					 internal_store->read_ahead_buffer );
+
+					internal_store->read_ahead_buffer      = NULL;
+					internal_store->read_ahead_buffer_size = 0;
+				}
+				internal_store->read_ahead_buffer = (uint8_t *) memory_allocate(
+				                                                 sizeof( uint8_t ) * internal_store->read_ahead_window_size );
+
+				if( internal_store->read_ahead_buffer == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create read-ahead buffer.",
+					 function );
+
+					goto on_error;
+				}
+				internal_store->read_ahead_buffer_size = internal_store->read_ahead_window_size;
+			}
+			/* The read-ahead data is invalidated before the read since
+			 * a failed read can leave the buffer partially filled
+			 */
+			internal_store->read_ahead_data_size = 0;
+
+			read_count = libvshadow_internal_store_read_data(
+			              internal_store,
+			              file_io_handle,
+			              internal_store->read_ahead_buffer,
+			              fill_size,
+			              fill_offset,
+			              error );
+
+			if( read_count != (ssize_t) fill_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to fill read-ahead buffer.",
+				 function );
+
+				goto on_error;
+			}
+			internal_store->read_ahead_data_offset         = fill_offset;
+			internal_store->read_ahead_data_size           = fill_size;
+			internal_store->read_ahead_number_of_refreshes = internal_store->io_handle->number_of_refreshes;
+
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     internal_store->read_ahead_buffer,
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data from read-ahead buffer.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
-#endif
-	return( read_count );
+	internal_store->read_ahead_next_offset = offset + (off64_t) buffer_size;
+
+	return( (ssize_t) buffer_size );
+
+on_error:
+	internal_store->read_ahead_window_size = 0;
+
+	return( -1 );
 }
 
-/* Reads (store) data at a specific offset
+/* Reads (store) data at a specific offset into a buffer using the allocation bitmap
+ * Unallocated data is not read but filled with 0-byte values
+ * This function is not multi-thread safe acquire write lock before call
  * Returns the number of bytes read or -1 on error
  */
-ssize_t libvshadow_store_read_buffer_at_offset(
-         libvshadow_store_t *store,
-         void *buffer,
+ssize_t libvshadow_internal_store_read_allocated_data(
+         libvshadow_internal_store_t *internal_store,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
          size_t buffer_size,
          off64_t offset,
          libcerror_error_t **error )
 {
-	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_read_buffer_at_offset";
-	ssize_t read_count                          = 0;
+	static char *function = "libvshadow_internal_store_read_allocated_data";
+	size64_t range_size   = 0;
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+	uint8_t is_allocated  = 0;
 
-	if( store == NULL )
+	if( internal_store == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -567,88 +715,122 @@ ssize_t libvshadow_store_read_buffer_at_offset(
 
 		return( -1 );
 	}
-	internal_store = (libvshadow_internal_store_t *) store;
-
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_store->read_write_lock,
-	     error ) != 1 )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libvshadow_internal_store_seek_offset(
-	     internal_store,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( buffer_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
 		 function );
 
-		read_count = -1;
+		return( -1 );
 	}
-	else
+	while( buffer_offset < buffer_size )
 	{
-		read_count = libvshadow_internal_store_read_buffer_from_file_io_handle(
-			      internal_store,
-			      internal_store->file_io_handle,
-			      buffer,
-			      buffer_size,
-			      error );
+		if( libvshadow_allocation_bitmap_get_range_at_offset(
+		     internal_store->allocation_bitmap,
+		     offset,
+		     (size64_t) ( buffer_size - buffer_offset ),
+		     &is_allocated,
+		     &range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocation range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
 
-		if( read_count == -1 )
+			return( -1 );
+		}
+		if( is_allocated == 0 )
+		{
+			if( memory_set(
+			     &( buffer[ buffer_offset ] ),
+			     0,
+			     (size_t) range_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear unallocated data.",
+				 function );
+
+				return( -1 );
+			}
+			read_count = (ssize_t) range_size;
+		}
+		/* Read-ahead is only applied to reads using the file IO handle of the store
+		 */
+		else if( ( internal_store->maximum_read_ahead_size > 0 )
+		      && ( file_io_handle == internal_store->file_io_handle ) )
+		{
+			read_count = libvshadow_internal_store_read_data_with_read_ahead(
+				      internal_store,
+				      file_io_handle,
+				      &( buffer[ buffer_offset ] ),
+				      (size_t) range_size,
+				      offset,
+				      error );
+		}
+		else
+		{
+			read_count = libvshadow_internal_store_read_data(
+				      internal_store,
+				      file_io_handle,
+				      &( buffer[ buffer_offset ] ),
+				      (size_t) range_size,
+				      offset,
+				      error );
+		}
+		if( read_count != (ssize_t) range_size )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer.",
-			 function );
+			 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
 
-			read_count = -1;
+			return( -1 );
 		}
+		buffer_offset += (size_t) range_size;
+		offset        += (off64_t) range_size;
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_store->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
-
-		return( -1 );
-	}
-#endif
-	return( read_count );
+	return( (ssize_t) buffer_size );
 }
 
-/* Seeks a certain offset of the (store) data
+/* Reads (store) data at the current offset into a buffer using a Basic File IO (bfio) handle
  * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+ * Returns the number of bytes read or -1 on error
  */
-off64_t libvshadow_internal_store_seek_offset(
+ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
          libvshadow_internal_store_t *internal_store,
-         off64_t offset,
-         int whence,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
          libcerror_error_t **error )
 {
-	static char *function = "libvshadow_internal_store_seek_offset";
+	static char *function = "libvshadow_internal_store_read_buffer_from_file_io_handle";
+	ssize_t read_count    = 0;
 
 	if( internal_store == NULL )
 	{
@@ -672,54 +854,110 @@ off64_t libvshadow_internal_store_seek_offset(
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	if( internal_store->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
+	if( buffer_size > (size_t) SSIZE_MAX )
 	{
-		offset += internal_store->current_offset;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid element data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
 	}
-	else if( whence == SEEK_END )
+	if( ( buffer_size == 0 )
+	 || ( (size64_t) internal_store->current_offset >= internal_store->internal_volume->size ) )
 	{
-		offset += (off64_t) internal_store->internal_volume->size;
+		return( 0 );
 	}
-	if( offset < 0 )
+	if( (size64_t) buffer_size > ( internal_store->internal_volume->size - internal_store->current_offset ) )
+	{
+		buffer_size = (size_t) ( internal_store->internal_volume->size - internal_store->current_offset );
+	}
+	if( internal_store->allocation_bitmap != NULL )
+	{
+		read_count = libvshadow_internal_store_read_allocated_data(
+			      internal_store,
+			      file_io_handle,
+			      (uint8_t *) buffer,
+			      buffer_size,
+			      internal_store->current_offset,
+			      error );
+	}
+	/* Read-ahead is only applied to reads using the file IO handle of the store
+	 */
+	else if( ( internal_store->maximum_read_ahead_size > 0 )
+	      && ( file_io_handle == internal_store->file_io_handle ) )
+	{
+		read_count = libvshadow_internal_store_read_data_with_read_ahead(
+			      internal_store,
+			      file_io_handle,
+			      (uint8_t *) buffer,
+			      buffer_size,
+			      internal_store->current_offset,
+			      error );
+	}
+	else
+	{
+		read_count = libvshadow_internal_store_read_data(
+			      internal_store,
+			      file_io_handle,
+			      (uint8_t *) buffer,
+			      buffer_size,
+			      internal_store->current_offset,
+			      error );
+	}
+	if( read_count != (ssize_t) buffer_size )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer from store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
 
 		return( -1 );
 	}
-	internal_store->current_offset = offset;
+	internal_store->current_offset += read_count;
 
-	return( offset );
+	return( read_count );
 }
 
-/* Seeks a certain offset of the (store) data
- * Returns the offset if seek is successful or -1 on error
+/* Reads (store) data at the current offset into a buffer
+ * Returns the number of bytes read or -1 on error
  */
-off64_t libvshadow_store_seek_offset(
+ssize_t libvshadow_store_read_buffer(
          libvshadow_store_t *store,
-         off64_t offset,
-         int whence,
+         void *buffer,
+         size_t buffer_size,
          libcerror_error_t **error )
 {
 	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_seek_offset";
+	static char *function                       = "libvshadow_store_read_buffer";
+	ssize_t read_count                          = 0;
 
 	if( store == NULL )
 	{
@@ -749,22 +987,23 @@ off64_t libvshadow_store_seek_offset(
 		return( -1 );
 	}
 #endif
-	offset = libvshadow_internal_store_seek_offset(
-	          internal_store,
-	          offset,
-	          whence,
-	          error );
+	read_count = libvshadow_internal_store_read_buffer_from_file_io_handle(
+		      internal_store,
+		      internal_store->file_io_handle,
+		      buffer,
+		      buffer_size,
+		      error );
 
-	if( offset == -1 )
+	if( read_count == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
 		 function );
 
-		offset = -1;
+		read_count = -1;
 	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -781,19 +1020,22 @@ off64_t libvshadow_store_seek_offset(
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( read_count );
 }
 
-/* Retrieves the current offset of the (store) data
- * Returns 1 if successful or -1 on error
+/* Reads (store) data at the current offset into a buffer using a Basic File IO (bfio) handle
+ * Returns the number of bytes read or -1 on error
  */
-int libvshadow_store_get_offset(
-     libvshadow_store_t *store,
-     off64_t *offset,
-     libcerror_error_t **error )
+ssize_t libvshadow_store_read_buffer_from_file_io_handle(
+         libvshadow_store_t *store,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
 {
 	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_get_offset";
+	static char *function                       = "libvshadow_store_read_buffer_from_file_io_handle";
+	ssize_t read_count                          = 0;
 
 	if( store == NULL )
 	{
@@ -808,19 +1050,8 @@ int libvshadow_store_get_offset(
 	}
 	internal_store = (libvshadow_internal_store_t *) store;
 
-	if( offset == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_store->read_write_lock,
 	     error ) != 1 )
 	{
@@ -828,16 +1059,32 @@ int libvshadow_store_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	*offset = internal_store->current_offset;
+	read_count = libvshadow_internal_store_read_buffer_from_file_io_handle(
+		      internal_store,
+		      file_io_handle,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
 
+		read_count = -1;
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_store->read_write_lock,
 	     error ) != 1 )
 	{
@@ -845,25 +1092,28 @@ int libvshadow_store_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( read_count );
 }
 
-/* Retrieves the size
- * Returns 1 if successful or -1 on error
+/* Reads (store) data at a specific offset
+ * Returns the number of bytes read or -1 on error
  */
-int libvshadow_store_get_size(
-     libvshadow_store_t *store,
-     size64_t *size,
-     libcerror_error_t **error )
+ssize_t libvshadow_store_read_buffer_at_offset(
+         libvshadow_store_t *store,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
 {
 	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_get_size";
+	static char *function                       = "libvshadow_store_read_buffer_at_offset";
+	ssize_t read_count                          = 0;
 
 	if( store == NULL )
 	{
@@ -878,33 +1128,1449 @@ int libvshadow_store_get_size(
 	}
 	internal_store = (libvshadow_internal_store_t *) store;
 
-	if( libvshadow_volume_get_size(
-	     (libvshadow_volume_t *) internal_store->internal_volume,
-	     size,
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_store->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve size from volume.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
-}
-
-/* Retrieves the volume size as stored in the store information
- * Returns 1 if successful or -1 on error
- */
-int libvshadow_store_get_volume_size(
-     libvshadow_store_t *store,
-     size64_t *volume_size,
-     libcerror_error_t **error )
+#endif
+	if( libvshadow_internal_store_seek_offset(
+	     internal_store,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		read_count = -1;
+	}
+	else
+	{
+		read_count = libvshadow_internal_store_read_buffer_from_file_io_handle(
+			      internal_store,
+			      internal_store->file_io_handle,
+			      buffer,
+			      buffer_size,
+			      error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer.",
+			 function );
+
+			read_count = -1;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Seeks a certain offset of the (store) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libvshadow_internal_store_seek_offset(
+         libvshadow_internal_store_t *internal_store,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libvshadow_internal_store_seek_offset";
+
+	if( internal_store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += internal_store->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) internal_store->internal_volume->size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (store) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libvshadow_store_seek_offset(
+         libvshadow_store_t *store,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_seek_offset";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libvshadow_internal_store_seek_offset(
+	          internal_store,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		offset = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (store) data
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_offset(
+     libvshadow_store_t *store,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_get_offset";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_store->current_offset;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum size of the read-ahead window
+ * A value of 0 disables read-ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_set_maximum_read_ahead_size(
+     libvshadow_store_t *store,
+     size_t maximum_read_ahead_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_set_maximum_read_ahead_size";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( maximum_read_ahead_size > (size_t) LIBVSHADOW_STORE_READ_AHEAD_MAXIMUM_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum read-ahead size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_store->maximum_read_ahead_size = maximum_read_ahead_size;
+
+	if( internal_store->read_ahead_window_size > maximum_read_ahead_size )
+	{
+		internal_store->read_ahead_window_size = maximum_read_ahead_size;
+	}
+	/* The read-ahead buffer is freed when it exceeds the new maximum
+	 */
+	if( internal_store->read_ahead_buffer_size > maximum_read_ahead_size )
+	{
+		memory_free(
+		 internal_store->read_ahead_buffer );
+
+		internal_store->read_ahead_buffer      = NULL;
+		internal_store->read_ahead_buffer_size = 0;
+		internal_store->read_ahead_data_size   = 0;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the maximum size of the read-ahead window
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_maximum_read_ahead_size(
+     libvshadow_store_t *store,
+     size_t *maximum_read_ahead_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_get_maximum_read_ahead_size";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( maximum_read_ahead_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum read-ahead size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*maximum_read_ahead_size = internal_store->maximum_read_ahead_size;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the size
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_size(
+     libvshadow_store_t *store,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_get_size";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( libvshadow_volume_get_size(
+	     (libvshadow_volume_t *) internal_store->internal_volume,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size from volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the volume size as stored in the store information
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_volume_size(
+     libvshadow_store_t *store,
+     size64_t *volume_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_get_volume_size";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_descriptor_get_volume_size(
+	     internal_store->store_descriptor,
+	     volume_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume size from store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_identifier(
+     libvshadow_store_t *store,
+     uint8_t *guid,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_get_identifier";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_descriptor_get_identifier(
+	     internal_store->store_descriptor,
+	     guid,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier from store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the creation date and time
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_creation_time(
+     libvshadow_store_t *store,
+     uint64_t *filetime,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_get_creation_time";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_descriptor_get_creation_time(
+	     internal_store->store_descriptor,
+	     filetime,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve creation time from store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the copy identifier
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvshadow_store_get_copy_identifier(
+     libvshadow_store_t *store,
+     uint8_t *guid,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_get_copy_identifier";
+	int result                                  = 0;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_store_descriptor_get_copy_identifier(
+	          internal_store->store_descriptor,
+	          guid,
+	          size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve copy identifier from store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the copy set identifier
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvshadow_store_get_copy_set_identifier(
+     libvshadow_store_t *store,
+     uint8_t *guid,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_get_copy_set_identifier";
+	int result                                  = 0;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_store_descriptor_get_copy_set_identifier(
+	          internal_store->store_descriptor,
+	          guid,
+	          size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve copy set identifier from store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the attribute flags
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvshadow_store_get_attribute_flags(
+     libvshadow_store_t *store,
+     uint32_t *attribute_flags,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_get_attribute_flags";
+	int result                                  = 0;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_store_descriptor_get_attribute_flags(
+	          internal_store->store_descriptor,
+	          attribute_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve attribute flags from store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves the number of blocks
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_number_of_blocks(
+     libvshadow_store_t *store,
+     int *number_of_blocks,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_get_number_of_blocks";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_descriptor_get_number_of_blocks(
+	     internal_store->store_descriptor,
+	     internal_store->io_handle,
+	     internal_store->file_io_handle,
+	     number_of_blocks,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of blocks store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific block
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_block_by_index(
+     libvshadow_store_t *store,
+     int block_index,
+     libvshadow_block_t **block,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t *block_descriptor = NULL;
+	libvshadow_internal_store_t *internal_store     = NULL;
+	static char *function                           = "libvshadow_store_get_block_by_index";
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( block == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block.",
+		 function );
+
+		return( -1 );
+	}
+	if( *block != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid block value already set.",
+		 function );
+
+		return( -1 );
+	}
+	/* Make sure the block descriptors are not evicted before the block
+	 * descriptor has been copied into the block
+	 */
+	if( libvshadow_store_descriptor_acquire_block_descriptors(
+	     internal_store->store_descriptor,
+	     internal_store->io_handle,
+	     internal_store->file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to acquire block descriptors of store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	if( libvshadow_store_descriptor_get_block_descriptor_by_index(
+	     internal_store->store_descriptor,
+	     internal_store->io_handle,
+	     internal_store->file_io_handle,
+	     block_index,
+	     &block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block descriptor: %d from store descriptor: %d.",
+		 function,
+		 block_index,
+		 internal_store->store_descriptor_index );
+
+		goto on_error;
+	}
+	if( libvshadow_block_initialize(
+	     block,
+	     block_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create block: %d.",
+		 function,
+		 block_index );
+
+		goto on_error;
+	}
+	if( libvshadow_store_descriptor_release_block_descriptors(
+	     internal_store->store_descriptor,
+	     internal_store->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release block descriptors of store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		libvshadow_block_free(
+		 block,
+		 NULL );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libvshadow_store_descriptor_release_block_descriptors(
+	 internal_store->store_descriptor,
+	 internal_store->io_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Reads the allocation bitmap of the NTFS file system in the store
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the store does not contain a supported NTFS file system or -1 on error
+ */
+int libvshadow_internal_store_read_allocation_bitmap(
+     libvshadow_internal_store_t *internal_store,
+     libcerror_error_t **error )
+{
+	libvshadow_allocation_bitmap_t *allocation_bitmap = NULL;
+	static char *function                             = "libvshadow_internal_store_read_allocation_bitmap";
+	int result                                        = 0;
+
+	if( internal_store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_store->allocation_bitmap != NULL )
+	{
+		return( 1 );
+	}
+	if( libvshadow_allocation_bitmap_initialize(
+	     &allocation_bitmap,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create allocation bitmap.",
+		 function );
+
+		goto on_error;
+	}
+	result = libvshadow_allocation_bitmap_read_store(
+	          allocation_bitmap,
+	          internal_store->store_descriptor,
+	          internal_store->io_handle,
+	          internal_store->file_io_handle,
+	          internal_store->store_descriptor_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read allocation bitmap from store descriptor: %d.",
+		 function,
+		 internal_store->store_descriptor_index );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		if( libvshadow_allocation_bitmap_free(
+		     &allocation_bitmap,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free allocation bitmap.",
+			 function );
+
+			goto on_error;
+		}
+		return( 0 );
+	}
+	internal_store->allocation_bitmap = allocation_bitmap;
+
+	return( 1 );
+
+on_error:
+	if( allocation_bitmap != NULL )
+	{
+		libvshadow_allocation_bitmap_free(
+		 &allocation_bitmap,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the allocation bitmap of the NTFS file system in the store
+ * Returns 1 if successful, 0 if the store does not contain a supported NTFS file system or -1 on error
+ */
+int libvshadow_store_read_allocation_bitmap(
+     libvshadow_store_t *store,
+     libcerror_error_t **error )
 {
 	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_get_volume_size";
+	static char *function                       = "libvshadow_store_read_allocation_bitmap";
+	int result                                  = 0;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvshadow_internal_store_read_allocation_bitmap(
+	          internal_store,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read allocation bitmap.",
+		 function );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the source of the store data at a specific offset
+ * Unallocated data is reported as LIBVSHADOW_DATA_SOURCE_TYPE_UNALLOCATED if the allocation bitmap was read
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_internal_store_get_data_source_at_offset(
+     libvshadow_internal_store_t *internal_store,
+     off64_t offset,
+     int *source_type,
+     int *source_store_index,
+     off64_t *source_offset,
+     size64_t *source_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "libvshadow_internal_store_get_data_source_at_offset";
+	size64_t range_size       = 0;
+	size64_t safe_source_size = 0;
+	uint8_t is_allocated      = 1;
+
+	if( internal_store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= internal_store->internal_volume->size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source type.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_store_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source store index.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The block descriptors do not need to be looked up for unallocated data
+	 */
+	if( internal_store->allocation_bitmap != NULL )
+	{
+		if( libvshadow_allocation_bitmap_get_range_at_offset(
+		     internal_store->allocation_bitmap,
+		     offset,
+		     internal_store->internal_volume->size - (size64_t) offset,
+		     &is_allocated,
+		     &range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocation range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( is_allocated == 0 )
+		{
+			*source_type        = LIBVSHADOW_DATA_SOURCE_TYPE_UNALLOCATED;
+			*source_store_index = -1;
+			*source_offset      = offset;
+			*source_size        = range_size;
+
+			return( 1 );
+		}
+	}
+	if( libvshadow_store_descriptor_get_data_source_at_offset(
+	     internal_store->store_descriptor,
+	     internal_store->io_handle,
+	     internal_store->file_io_handle,
+	     offset,
+	     internal_store->store_descriptor_index,
+	     source_type,
+	     source_store_index,
+	     source_offset,
+	     &safe_source_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data source at offset: %" PRIi64 " (0x%08" PRIx64 ") from store descriptor: %d.",
+		 function,
+		 offset,
+		 offset,
+		 internal_store->store_descriptor_index );
+
+		return( -1 );
+	}
+	if( safe_source_size > ( internal_store->internal_volume->size - (size64_t) offset ) )
+	{
+		safe_source_size = internal_store->internal_volume->size - (size64_t) offset;
+	}
+	if( ( internal_store->allocation_bitmap != NULL )
+	 && ( safe_source_size > range_size ) )
+	{
+		safe_source_size = range_size;
+	}
+	*source_size = safe_source_size;
+
+	return( 1 );
+}
+
+/* Retrieves the source of the store data at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_data_source_at_offset(
+     libvshadow_store_t *store,
+     off64_t offset,
+     int *source_type,
+     int *source_store_index,
+     off64_t *source_offset,
+     size64_t *source_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_get_data_source_at_offset";
+	int result                                  = 1;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_internal_store_get_data_source_at_offset(
+	     internal_store,
+	     offset,
+	     source_type,
+	     source_store_index,
+	     source_offset,
+	     source_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data source at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Borrows the store data at a specific offset from the file mapping of the volume
+ * The data remains valid until the volume is closed
+ * Returns 1 if successful, 0 if the data is not available in the file mapping or -1 on error
+ */
+int libvshadow_store_borrow_data_at_offset(
+     libvshadow_store_t *store,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_store_t *internal_store = NULL;
+	const uint8_t *mapped_data                  = NULL;
+	static char *function                       = "libvshadow_store_borrow_data_at_offset";
+	size64_t source_size                        = 0;
+	size_t mapped_data_size                     = 0;
+	off64_t source_offset                       = 0;
+	int result                                  = 0;
+	int source_store_index                      = 0;
+	int source_type                             = 0;
 
 	if( store == NULL )
 	{
@@ -930,37 +2596,117 @@ int libvshadow_store_get_volume_size(
 
 		return( -1 );
 	}
-	if( libvshadow_store_descriptor_get_volume_size(
-	     internal_store->store_descriptor,
-	     volume_size,
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= internal_store->internal_volume->size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_store->internal_volume->file_mapping == NULL )
+	{
+		return( 0 );
+	}
+	if( libvshadow_store_get_data_source_at_offset(
+	     store,
+	     offset,
+	     &source_type,
+	     &source_store_index,
+	     &source_offset,
+	     &source_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume size from store descriptor: %d.",
+		 "%s: unable to retrieve data source at offset: %" PRIi64 " (0x%08" PRIx64 ").",
 		 function,
-		 internal_store->store_descriptor_index );
+		 offset,
+		 offset );
 
 		return( -1 );
 	}
-	return( 1 );
+	if( ( source_type == LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE )
+	 || ( source_type == LIBVSHADOW_DATA_SOURCE_TYPE_UNALLOCATED ) )
+	{
+		return( 0 );
+	}
+	result = libvshadow_file_mapping_get_data_at_offset(
+	          internal_store->internal_volume->file_mapping,
+	          source_offset,
+	          &mapped_data,
+	          &mapped_data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data at offset: %" PRIi64 " (0x%08" PRIx64 ") from file mapping.",
+		 function,
+		 source_offset,
+		 source_offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( (size64_t) mapped_data_size > source_size )
+		{
+			mapped_data_size = (size_t) source_size;
+		}
+		*data      = mapped_data;
+		*data_size = mapped_data_size;
+	}
+	return( result );
 }
 
-/* Retrieves the identifier
+/* Appends a buffer with store data to a data view
+ * This function is not multi-thread safe acquire write lock before call
  * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_get_identifier(
-     libvshadow_store_t *store,
-     uint8_t *guid,
+int libvshadow_internal_store_append_data_view_buffer(
+     libvshadow_internal_store_t *internal_store,
+     libvshadow_internal_data_view_t *internal_data_view,
+     off64_t offset,
      size_t size,
      libcerror_error_t **error )
 {
-	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_get_identifier";
+	uint8_t *buffer       = NULL;
+	static char *function = "libvshadow_internal_store_append_data_view_buffer";
+	ssize_t read_count    = 0;
 
-	if( store == NULL )
+	if( internal_store == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -971,31 +2717,41 @@ int libvshadow_store_get_identifier(
 
 		return( -1 );
 	}
-	internal_store = (libvshadow_internal_store_t *) store;
-
-	if( internal_store->internal_volume == NULL )
+	if( libvshadow_internal_data_view_append_buffer(
+	     internal_data_view,
+	     size,
+	     &buffer,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid store - missing internal volume.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append buffer to data view.",
 		 function );
 
 		return( -1 );
 	}
-	if( libvshadow_store_descriptor_get_identifier(
-	     internal_store->store_descriptor,
-	     guid,
-	     size,
-	     error ) != 1 )
+	read_count = libvshadow_store_descriptor_read_buffer(
+		      internal_store->store_descriptor,
+		      internal_store->io_handle,
+		      internal_store->file_io_handle,
+		      buffer,
+		      size,
+		      offset,
+		      internal_store->store_descriptor_index,
+		      error );
+
+	if( read_count != (ssize_t) size )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve identifier from store descriptor: %d.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from store descriptor: %d.",
 		 function,
+		 offset,
+		 offset,
 		 internal_store->store_descriptor_index );
 
 		return( -1 );
@@ -1003,16 +2759,223 @@ int libvshadow_store_get_identifier(
 	return( 1 );
 }
 
-/* Retrieves the creation date and time
+/* Retrieves a read-only view of the store data at a specific offset
+ * This function is not multi-thread safe acquire write lock before call
  * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_get_creation_time(
+int libvshadow_internal_store_get_data_view(
+     libvshadow_internal_store_t *internal_store,
+     libvshadow_internal_data_view_t *internal_data_view,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error )
+{
+	const uint8_t *mapped_data = NULL;
+	static char *function      = "libvshadow_internal_store_get_data_view";
+	size64_t source_size       = 0;
+	size_t buffer_size         = 0;
+	size_t mapped_data_size    = 0;
+	size_t run_size            = 0;
+	off64_t buffer_offset      = 0;
+	off64_t source_offset      = 0;
+	int result                 = 0;
+	int source_store_index     = 0;
+	int source_type            = 0;
+
+	if( internal_store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_store->internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid store - missing internal volume.",
+		 function );
+
+		return( -1 );
+	}
+	/* Data that cannot be referenced is collected in a buffer
+	 * that is read once the run of such data ends
+	 */
+	while( size > 0 )
+	{
+		if( libvshadow_internal_store_get_data_source_at_offset(
+		     internal_store,
+		     offset,
+		     &source_type,
+		     &source_store_index,
+		     &source_offset,
+		     &source_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data source at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( source_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid source size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		run_size = size;
+
+		if( source_size < (size64_t) run_size )
+		{
+			run_size = (size_t) source_size;
+		}
+		result = 0;
+
+		if( ( source_type != LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE )
+		 && ( source_type != LIBVSHADOW_DATA_SOURCE_TYPE_UNALLOCATED ) )
+		{
+			if( internal_store->internal_volume->file_mapping != NULL )
+			{
+				result = libvshadow_file_mapping_get_data_at_offset(
+				          internal_store->internal_volume->file_mapping,
+				          source_offset,
+				          &mapped_data,
+				          &mapped_data_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve data at offset: %" PRIi64 " (0x%08" PRIx64 ") from file mapping.",
+					 function,
+					 source_offset,
+					 source_offset );
+
+					return( -1 );
+				}
+				else if( ( result != 0 )
+				      && ( mapped_data_size < run_size ) )
+				{
+					result = 0;
+				}
+			}
+			if( result == 0 )
+			{
+				if( buffer_size == 0 )
+				{
+					buffer_offset = offset;
+				}
+				if( run_size > ( LIBVSHADOW_DATA_VIEW_MAXIMUM_BUFFER_SIZE - buffer_size ) )
+				{
+					run_size = LIBVSHADOW_DATA_VIEW_MAXIMUM_BUFFER_SIZE - buffer_size;
+				}
+				buffer_size += run_size;
+				offset      += run_size;
+				size        -= run_size;
+
+				if( ( buffer_size < LIBVSHADOW_DATA_VIEW_MAXIMUM_BUFFER_SIZE )
+				 && ( size > 0 ) )
+				{
+					continue;
+				}
+				run_size = 0;
+			}
+		}
+		if( buffer_size > 0 )
+		{
+			if( libvshadow_internal_store_append_data_view_buffer(
+			     internal_store,
+			     internal_data_view,
+			     buffer_offset,
+			     buffer_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append buffer to data view.",
+				 function );
+
+				return( -1 );
+			}
+			buffer_size = 0;
+		}
+		if( run_size == 0 )
+		{
+			continue;
+		}
+		if( ( source_type == LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE )
+		 || ( source_type == LIBVSHADOW_DATA_SOURCE_TYPE_UNALLOCATED ) )
+		{
+			result = libvshadow_internal_data_view_append_zero_data(
+			          internal_data_view,
+			          run_size,
+			          error );
+		}
+		else
+		{
+			result = libvshadow_internal_data_view_append_data(
+			          internal_data_view,
+			          LIBVSHADOW_DATA_SEGMENT_TYPE_MAPPED,
+			          mapped_data,
+			          run_size,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append data at offset: %" PRIi64 " (0x%08" PRIx64 ") to data view.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		offset += run_size;
+		size   -= run_size;
+	}
+	return( 1 );
+}
+
+/* Retrieves a read-only view of the store data at a specific offset
+ * The data view consists of segments that reference the data without copying it where possible
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_get_data_view(
      libvshadow_store_t *store,
-     uint64_t *filetime,
+     off64_t offset,
+     size_t size,
+     libvshadow_data_view_t **data_view,
      libcerror_error_t **error )
 {
+	libvshadow_data_view_t *safe_data_view      = NULL;
 	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_get_creation_time";
+	static char *function                       = "libvshadow_store_get_data_view";
+	int result                                  = 1;
 
 	if( store == NULL )
 	{
@@ -1038,36 +3001,151 @@ int libvshadow_store_get_creation_time(
 
 		return( -1 );
 	}
-	if( libvshadow_store_descriptor_get_creation_time(
-	     internal_store->store_descriptor,
-	     filetime,
+	if( ( offset < 0 )
+	 || ( (size64_t) offset > internal_store->internal_volume->size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_view == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data view.",
+		 function );
+
+		return( -1 );
+	}
+	if( *data_view != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid data view value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) size > ( internal_store->internal_volume->size - (size64_t) offset ) )
+	{
+		size = (size_t) ( internal_store->internal_volume->size - (size64_t) offset );
+	}
+	if( libvshadow_data_view_initialize(
+	     &safe_data_view,
+	     offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create data view.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	if( libvshadow_internal_store_get_data_view(
+	     internal_store,
+	     (libvshadow_internal_data_view_t *) safe_data_view,
+	     offset,
+	     size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve creation time from store descriptor: %d.",
+		 "%s: unable to retrieve data view at offset: %" PRIi64 " (0x%08" PRIx64 ").",
 		 function,
-		 internal_store->store_descriptor_index );
+		 offset,
+		 offset );
 
-		return( -1 );
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		goto on_error;
 	}
+#endif
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	*data_view = safe_data_view;
+
 	return( 1 );
+
+on_error:
+	if( safe_data_view != NULL )
+	{
+		libvshadow_data_view_free(
+		 &safe_data_view,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves the copy identifier
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Maps the store data into memory
+ * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_get_copy_identifier(
+int libvshadow_store_map(
      libvshadow_store_t *store,
-     uint8_t *guid,
-     size_t size,
+     void **data,
+     size64_t *data_size,
      libcerror_error_t **error )
 {
 	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_get_copy_identifier";
-	int result                                  = 0;
+	static char *function                       = "libvshadow_store_map";
+
+#if defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT )
+	libvshadow_store_mapping_t *store_mapping   = NULL;
+	int result                                  = 1;
+#endif
 
 	if( store == NULL )
 	{
@@ -1093,96 +3171,118 @@ int libvshadow_store_get_copy_identifier(
 
 		return( -1 );
 	}
-	result = libvshadow_store_descriptor_get_copy_identifier(
-	          internal_store->store_descriptor,
-	          guid,
-	          size,
-	          error );
-
-	if( result == -1 )
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve copy identifier from store descriptor: %d.",
-		 function,
-		 internal_store->store_descriptor_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
 
 		return( -1 );
 	}
-	return( result );
-}
-
-/* Retrieves the copy set identifier
- * Returns 1 if successful, 0 if not available or -1 on error
- */
-int libvshadow_store_get_copy_set_identifier(
-     libvshadow_store_t *store,
-     uint8_t *guid,
-     size_t size,
-     libcerror_error_t **error )
-{
-	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_get_copy_set_identifier";
-	int result                                  = 0;
-
-	if( store == NULL )
+	if( data_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid store.",
+		 "%s: invalid data size.",
 		 function );
 
 		return( -1 );
 	}
-	internal_store = (libvshadow_internal_store_t *) store;
-
-	if( internal_store->internal_volume == NULL )
+#if defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid store - missing internal volume.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	result = libvshadow_store_descriptor_get_copy_set_identifier(
-	          internal_store->store_descriptor,
-	          guid,
-	          size,
-	          error );
+	if( internal_store->store_mapping != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid store - store mapping value already set.",
+		 function );
 
-	if( result == -1 )
+		result = -1;
+	}
+	else if( libvshadow_store_mapping_initialize(
+	          &( internal_store->store_mapping ),
+	          internal_store,
+	          internal_store->internal_volume->size,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve copy set identifier from store descriptor: %d.",
-		 function,
-		 internal_store->store_descriptor_index );
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create store mapping.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		store_mapping = internal_store->store_mapping;
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
 		return( -1 );
 	}
-	return( result );
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	*data      = (void *) store_mapping->data;
+	*data_size = store_mapping->data_size;
+
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: store mapping not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT ) */
 }
 
-/* Retrieves the attribute flags
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Unmaps the store data
+ * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_get_attribute_flags(
+int libvshadow_store_unmap(
      libvshadow_store_t *store,
-     uint32_t *attribute_flags,
      libcerror_error_t **error )
 {
+	static char *function = "libvshadow_store_unmap";
+
+#if defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT )
 	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_get_attribute_flags";
-	int result                                  = 0;
+	libvshadow_store_mapping_t *store_mapping   = NULL;
+#endif
 
 	if( store == NULL )
 	{
@@ -1195,106 +3295,93 @@ int libvshadow_store_get_attribute_flags(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT )
 	internal_store = (libvshadow_internal_store_t *) store;
 
-	if( internal_store->internal_volume == NULL )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid store - missing internal volume.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	result = libvshadow_store_descriptor_get_attribute_flags(
-	          internal_store->store_descriptor,
-	          attribute_flags,
-	          error );
-
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve attribute flags from store descriptor: %d.",
-		 function,
-		 internal_store->store_descriptor_index );
-
-		return( -1 );
-	}
-	return( result );
-}
+	store_mapping = internal_store->store_mapping;
 
-/* Retrieves the number of blocks
- * Returns 1 if successful or -1 on error
- */
-int libvshadow_store_get_number_of_blocks(
-     libvshadow_store_t *store,
-     int *number_of_blocks,
-     libcerror_error_t **error )
-{
-	libvshadow_internal_store_t *internal_store = NULL;
-	static char *function                       = "libvshadow_store_get_number_of_blocks";
+	internal_store->store_mapping = NULL;
 
-	if( store == NULL )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid store.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	internal_store = (libvshadow_internal_store_t *) store;
-
-	if( internal_store->internal_volume == NULL )
+	/* The store mapping is freed without holding the lock since
+	 * the fault handler thread needs the lock to resolve pending faults
+	 */
+	if( store_mapping == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid store - missing internal volume.",
+		 "%s: invalid store - missing store mapping.",
 		 function );
 
 		return( -1 );
 	}
-	if( libvshadow_store_descriptor_get_number_of_blocks(
-	     internal_store->store_descriptor,
-	     internal_store->io_handle,
-	     internal_store->file_io_handle,
-	     number_of_blocks,
+	if( libvshadow_store_mapping_free(
+	     &store_mapping,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of blocks store descriptor: %d.",
-		 function,
-		 internal_store->store_descriptor_index );
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free store mapping.",
+		 function );
 
 		return( -1 );
 	}
 	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: store mapping not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT ) */
 }
 
-/* Retrieves a specific block
- * Returns 1 if successful or -1 on error
+/* Retrieves the number of pages of the store mapping that could not be read and were zero-filled
+ * Returns 1 if successful, 0 if the store is not mapped or -1 on error
  */
-int libvshadow_store_get_block_by_index(
+int libvshadow_store_get_number_of_mapping_read_errors(
      libvshadow_store_t *store,
-     int block_index,
-     libvshadow_block_t **block,
+     int *number_of_read_errors,
      libcerror_error_t **error )
 {
-	libvshadow_block_descriptor_t *block_descriptor = NULL;
-	libvshadow_internal_store_t *internal_store     = NULL;
-	static char *function                           = "libvshadow_store_get_block_by_index";
+	static char *function = "libvshadow_store_get_number_of_mapping_read_errors";
+
+#if defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT )
+	libvshadow_internal_store_t *internal_store = NULL;
+	int result                                  = 0;
+#endif
 
 	if( store == NULL )
 	{
@@ -1307,75 +3394,67 @@ int libvshadow_store_get_block_by_index(
 
 		return( -1 );
 	}
-	internal_store = (libvshadow_internal_store_t *) store;
-
-	if( internal_store->internal_volume == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid store - missing internal volume.",
-		 function );
-
-		return( -1 );
-	}
-	if( block == NULL )
+	if( number_of_read_errors == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid block.",
+		 "%s: invalid number of read errors.",
 		 function );
 
 		return( -1 );
 	}
-	if( *block != NULL )
+#if defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT )
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid block value already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( libvshadow_store_descriptor_get_block_descriptor_by_index(
-	     internal_store->store_descriptor,
-	     internal_store->io_handle,
-	     internal_store->file_io_handle,
-	     block_index,
-	     &block_descriptor,
-	     error ) != 1 )
+	if( internal_store->store_mapping != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve block descriptor: %d from store descriptor: %d.",
-		 function,
-		 block_index,
-		 internal_store->store_descriptor_index );
+		result = libvshadow_store_mapping_get_number_of_read_errors(
+		          internal_store->store_mapping,
+		          number_of_read_errors,
+		          error );
 
-		return( -1 );
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of read errors from store mapping.",
+			 function );
+
+			result = -1;
+		}
 	}
-	if( libvshadow_block_initialize(
-	     block,
-	     block_descriptor,
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_store->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create block: %d.",
-		 function,
-		 block_index );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
 		return( -1 );
 	}
-	return( 1 );
+	return( result );
+#else
+	return( 0 );
+#endif /* defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT ) */
 }
-
@@ -25,11 +25,14 @@
 #include <common.h>
 #include <types.h>
 
+#include "libvshadow_allocation_bitmap.h"
+#include "libvshadow_data_view.h"
 #include "libvshadow_extern.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcthreads.h"
 #include "libvshadow_store_descriptor.h"
+#include "libvshadow_store_mapping.h"
 #include "libvshadow_types.h"
 #include "libvshadow_volume.h"
 
@@ -37,6 +40,14 @@
 extern "C" {
 #endif
 
+/* The minimum size of the read-ahead window
+ */
+#define LIBVSHADOW_STORE_READ_AHEAD_MINIMUM_WINDOW_SIZE		( 256 * 1024 )
+
+/* The upper bound of the maximum size of the read-ahead window
+ */
+#define LIBVSHADOW_STORE_READ_AHEAD_MAXIMUM_SIZE		( 64 * 1024 * 1024 )
+
 typedef struct libvshadow_internal_store libvshadow_internal_store_t;
 
 struct libvshadow_internal_store
@@ -65,6 +76,51 @@ struct libvshadow_internal_store
 	 */
 	off64_t current_offset;
 
+	/* The offset at which a sequential read is expected to continue
+	 */
+	off64_t read_ahead_next_offset;
+
+	/* The current size of the read-ahead window
+	 * The window grows on sequential access and shrinks on random access
+	 */
+	size_t read_ahead_window_size;
+
+	/* The maximum size of the read-ahead window
+	 * A value of 0, the default, disables read-ahead
+	 */
+	size_t maximum_read_ahead_size;
+
+	/* The read-ahead buffer
+	 */
+	uint8_t *read_ahead_buffer;
+
+	/* The size of the read-ahead buffer
+	 */
+	size_t read_ahead_buffer_size;
+
+	/* The (store) offset of the data in the read-ahead buffer
+	 */
+	off64_t read_ahead_data_offset;
+
+	/* The size of the data in the read-ahead buffer
+	 */
+	size_t read_ahead_data_size;
+
+	/* The number of refreshes of the volume when the read-ahead buffer was filled
+	 */
+	uint32_t read_ahead_number_of_refreshes;
+
+	/* The allocation bitmap
+	 * NULL if the allocation bitmap was not read
+	 */
+	libvshadow_allocation_bitmap_t *allocation_bitmap;
+
+#if defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT )
+	/* The store mapping
+	 */
+	libvshadow_store_mapping_t *store_mapping;
+#endif
+
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -90,6 +146,30 @@ int libvshadow_store_has_in_volume_data(
      libvshadow_store_t *store,
      libcerror_error_t **error );
 
+ssize_t libvshadow_internal_store_read_data(
+         libvshadow_internal_store_t *internal_store,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t libvshadow_internal_store_read_data_with_read_ahead(
+         libvshadow_internal_store_t *internal_store,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t libvshadow_internal_store_read_allocated_data(
+         libvshadow_internal_store_t *internal_store,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 ssize_t libvshadow_internal_store_read_buffer_from_file_io_handle(
          libvshadow_internal_store_t *internal_store,
          libbfio_handle_t *file_io_handle,
@@ -139,6 +219,18 @@ int libvshadow_store_get_offset(
      off64_t *offset,
      libcerror_error_t **error );
 
+LIBVSHADOW_EXTERN \
+int libvshadow_store_set_maximum_read_ahead_size(
+     libvshadow_store_t *store,
+     size_t maximum_read_ahead_size,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_maximum_read_ahead_size(
+     libvshadow_store_t *store,
+     size_t *maximum_read_ahead_size,
+     libcerror_error_t **error );
+
 LIBVSHADOW_EXTERN \
 int libvshadow_store_get_size(
      libvshadow_store_t *store,
@@ -197,6 +289,82 @@ int libvshadow_store_get_block_by_index(
      libvshadow_block_t **block,
      libcerror_error_t **error );
 
+int libvshadow_internal_store_read_allocation_bitmap(
+     libvshadow_internal_store_t *internal_store,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_read_allocation_bitmap(
+     libvshadow_store_t *store,
+     libcerror_error_t **error );
+
+int libvshadow_internal_store_get_data_source_at_offset(
+     libvshadow_internal_store_t *internal_store,
+     off64_t offset,
+     int *source_type,
+     int *source_store_index,
+     off64_t *source_offset,
+     size64_t *source_size,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_data_source_at_offset(
+     libvshadow_store_t *store,
+     off64_t offset,
+     int *source_type,
+     int *source_store_index,
+     off64_t *source_offset,
+     size64_t *source_size,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_borrow_data_at_offset(
+     libvshadow_store_t *store,
+     off64_t offset,
+     const uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error );
+
+int libvshadow_internal_store_append_data_view_buffer(
+     libvshadow_internal_store_t *internal_store,
+     libvshadow_internal_data_view_t *internal_data_view,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error );
+
+int libvshadow_internal_store_get_data_view(
+     libvshadow_internal_store_t *internal_store,
+     libvshadow_internal_data_view_t *internal_data_view,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_data_view(
+     libvshadow_store_t *store,
+     off64_t offset,
+     size_t size,
+     libvshadow_data_view_t **data_view,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_map(
+     libvshadow_store_t *store,
+     void **data,
+     size64_t *data_size,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_unmap(
+     libvshadow_store_t *store,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_store_get_number_of_mapping_read_errors(
+     libvshadow_store_t *store,
+     int *number_of_read_errors,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
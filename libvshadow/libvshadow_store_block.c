@@ -31,6 +31,7 @@
 #include "libvshadow_libfguid.h"
 #include "libvshadow_io_handle.h"
 #include "libvshadow_store_block.h"
+#include "libvshadow_trace.h"
 
 #include "vshadow_store.h"
 
@@ -174,12 +175,15 @@ int libvshadow_store_block_free(
 }
 
 /* Reads the store block
+ * The store index is the index of the store the block belongs to and is used for tracing
  * Returns 1 if successful or -1 on error
  */
 int libvshadow_store_block_read(
      libvshadow_store_block_t *store_block,
+     libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
+     int store_index,
      libcerror_error_t **error )
 {
 	static char *function = "libvshadow_store_block_read";
@@ -217,11 +221,16 @@ int libvshadow_store_block_read(
 		 file_offset );
 	}
 #endif
-	read_count = libbfio_handle_read_buffer_at_offset(
+	read_count = libvshadow_io_handle_read_store_data(
+	              io_handle,
 	              file_io_handle,
+	              file_offset,
 	              store_block->data,
 	              store_block->data_size,
 	              file_offset,
+	              store_index,
+	              store_index,
+	              LIBVSHADOW_TRACE_READ_TYPE_STORE_METADATA,
 	              error );
 
 	if( read_count != (ssize_t) store_block->data_size )
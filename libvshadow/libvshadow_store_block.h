@@ -25,6 +25,7 @@
 #include <common.h>
 #include <types.h>
 
+#include "libvshadow_io_handle.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcerror.h"
 
@@ -76,8 +77,10 @@ int libvshadow_store_block_free(
 
 int libvshadow_store_block_read(
      libvshadow_store_block_t *store_block,
+     libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
+     int store_index,
      libcerror_error_t **error );
 
 int libvshadow_store_block_read_header_data(
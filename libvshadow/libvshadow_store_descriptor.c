@@ -39,6 +39,7 @@
 #include "libvshadow_libuna.h"
 #include "libvshadow_store_block.h"
 #include "libvshadow_store_descriptor.h"
+#include "libvshadow_trace.h"
 
 #include "vshadow_store.h"
 
@@ -435,6 +436,64 @@ int libvshadow_store_descriptor_compare_by_identifier(
 	return( LIBCDATA_COMPARE_EQUAL );
 }
 
+/* Sets the next store descriptor
+ * The reverse block tree that was read while the store was the most recent store
+ * is retained until the block descriptors are freed
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_set_next_store_descriptor(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_descriptor_t *next_store_descriptor,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_set_next_store_descriptor";
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	store_descriptor->next_store_descriptor = next_store_descriptor;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
 /* Reads the catalog entry
  * Returns 1 if successful or -1 on error
  */
@@ -867,6 +926,7 @@ on_error:
  */
 int libvshadow_store_descriptor_read_store_header(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
@@ -921,8 +981,10 @@ int libvshadow_store_descriptor_read_store_header(
 	}
 	if( libvshadow_store_block_read(
 	     store_block,
+	     io_handle,
 	     file_io_handle,
 	     store_descriptor->store_header_offset,
+	     store_descriptor->index,
 	     error ) == -1 )
 	{
 		libcerror_error_set(
@@ -1316,6 +1378,7 @@ on_error:
  */
 int libvshadow_store_descriptor_read_store_bitmap(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      libcdata_range_list_t *offset_list,
@@ -1385,8 +1448,10 @@ int libvshadow_store_descriptor_read_store_bitmap(
 	}
 	if( libvshadow_store_block_read(
 	     store_block,
+	     io_handle,
 	     file_io_handle,
 	     file_offset,
+	     store_descriptor->index,
 	     error ) == -1 )
 	{
 		libcerror_error_set(
@@ -1569,6 +1634,7 @@ on_error:
  */
 int libvshadow_store_descriptor_read_store_block_list(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      off64_t *next_offset,
@@ -1618,8 +1684,10 @@ int libvshadow_store_descriptor_read_store_block_list(
 	}
 	if( libvshadow_store_block_read(
 	     store_block,
+	     io_handle,
 	     file_io_handle,
 	     file_offset,
+	     store_descriptor->index,
 	     error ) == -1 )
 	{
 		libcerror_error_set(
@@ -1684,6 +1752,28 @@ int libvshadow_store_descriptor_read_store_block_list(
 		}
 		else if( result != 0 )
 		{
+			/* The reverse block tree is only created once the store contains forwarder block descriptors
+			 */
+			if( ( store_descriptor->reverse_block_tree == NULL )
+			 && ( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_NOT_USED ) == 0 )
+			 && ( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 ) )
+			{
+				if( libvshadow_block_tree_initialize(
+				     &( store_descriptor->reverse_block_tree ),
+				     store_descriptor->volume_size,
+				     0x4000,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create reverse block tree.",
+					 function );
+
+					goto on_error;
+				}
+			}
 			if( libvshadow_block_tree_insert(
 			     store_descriptor->forward_block_tree,
 			     store_descriptor->reverse_block_tree,
@@ -1774,6 +1864,7 @@ on_error:
  */
 int libvshadow_store_descriptor_read_store_block_range_list(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      off64_t *next_offset,
@@ -1823,8 +1914,10 @@ int libvshadow_store_descriptor_read_store_block_range_list(
 	}
 	if( libvshadow_store_block_read(
 	     store_block,
+	     io_handle,
 	     file_io_handle,
 	     file_offset,
+	     store_descriptor->index,
 	     error ) == -1 )
 	{
 		libcerror_error_set(
@@ -1943,19 +2036,18 @@ on_error:
 	return( -1 );
 }
 
-/* Reads the block descriptors
+/* Starts reading the block descriptors
+ * Creates the forward block tree and the store block tree that is used to detect store blocks that are read more than once
+ * This function is not multi-thread safe acquire write lock before call
  * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_descriptor_read_block_descriptors(
+int libvshadow_store_descriptor_start_read_block_descriptors(
      libvshadow_store_descriptor_t *store_descriptor,
      libvshadow_io_handle_t *io_handle,
-     libbfio_handle_t *file_io_handle,
+     libvshadow_block_tree_t **store_block_tree,
      libcerror_error_t **error )
 {
-	libvshadow_block_tree_t *store_block_tree = NULL;
-	static char *function                     = "libvshadow_store_descriptor_read_block_descriptors";
-	off64_t bitmap_offset                     = 0;
-	off64_t store_block_offset                = 0;
+	static char *function = "libvshadow_store_descriptor_start_read_block_descriptors";
 
 	if( store_descriptor == NULL )
 	{
@@ -1968,6 +2060,17 @@ int libvshadow_store_descriptor_read_block_descriptors(
 
 		return( -1 );
 	}
+	if( store_descriptor->forward_block_tree != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid store descriptor - forward block tree value already set.",
+		 function );
+
+		return( -1 );
+	}
 	if( io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -1979,64 +2082,213 @@ int libvshadow_store_descriptor_read_block_descriptors(
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     store_descriptor->read_write_lock,
+	if( store_block_tree == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store block tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( *store_block_tree != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid store block tree value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_block_tree_initialize(
+	     &( store_descriptor->forward_block_tree ),
+	     store_descriptor->volume_size,
+	     0x4000,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create forward block tree.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_block_tree_initialize(
+	     store_block_tree,
+	     io_handle->volume_size,
+	     io_handle->block_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create store block tree.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( store_descriptor->forward_block_tree != NULL )
+	{
+		libvshadow_block_tree_free(
+		 &( store_descriptor->forward_block_tree ),
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Finishes reading the block descriptors
+ * Frees the store block tree and marks the block descriptors as read
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_finish_read_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_block_tree_t **store_block_tree,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_finish_read_block_descriptors";
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( store_descriptor->block_descriptors_read == 0 )
+	if( store_block_tree == NULL )
 	{
-		if( libvshadow_block_tree_initialize(
-		     &( store_descriptor->forward_block_tree ),
-		     store_descriptor->volume_size,
-		     0x4000,
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store block tree.",
+		 function );
+
+		return( -1 );
+	}
+	if( *store_block_tree != NULL )
+	{
+		if( libvshadow_block_tree_free(
+		     store_block_tree,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create forward block tree.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free store block tree.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( libvshadow_block_tree_initialize(
+	}
+	/* The reverse block tree is only consulted when reading from the most recent store
+	 * other stores only need it to detect forwarder block descriptors that point to each other
+	 * while the block descriptors are read
+	 */
+	if( ( store_descriptor->next_store_descriptor != NULL )
+	 && ( store_descriptor->reverse_block_tree != NULL ) )
+	{
+		if( libvshadow_block_tree_free(
 		     &( store_descriptor->reverse_block_tree ),
-		     store_descriptor->volume_size,
-		     0x4000,
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free_reverse,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create reverse block tree.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reverse block tree.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( libvshadow_block_tree_initialize(
+	}
+	store_descriptor->block_descriptors_read = 1;
+
+	return( 1 );
+}
+
+/* Reads the block descriptors
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_read_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libvshadow_block_tree_t *store_block_tree = NULL;
+	static char *function                     = "libvshadow_store_descriptor_read_block_descriptors";
+	off64_t bitmap_offset                     = 0;
+	off64_t store_block_offset                = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( store_descriptor->block_descriptors_read == 0 )
+	{
+		if( libvshadow_store_descriptor_start_read_block_descriptors(
+		     store_descriptor,
+		     io_handle,
 		     &store_block_tree,
-		     io_handle->volume_size,
-		     io_handle->block_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create store block tree.",
+			 "%s: unable to start reading block descriptors.",
 			 function );
 
 			goto on_error;
@@ -2065,6 +2317,7 @@ int libvshadow_store_descriptor_read_block_descriptors(
 			}
 			if( libvshadow_store_descriptor_read_store_bitmap(
 			     store_descriptor,
+			     io_handle,
 			     file_io_handle,
 			     store_block_offset,
 			     store_descriptor->block_offset_list,
@@ -2106,6 +2359,7 @@ int libvshadow_store_descriptor_read_block_descriptors(
 			}
 			if( libvshadow_store_descriptor_read_store_bitmap(
 			     store_descriptor,
+			     io_handle,
 			     file_io_handle,
 			     store_block_offset,
 			     store_descriptor->previous_block_offset_list,
@@ -2146,6 +2400,7 @@ int libvshadow_store_descriptor_read_block_descriptors(
 			}
 			if( libvshadow_store_descriptor_read_store_block_list(
 			     store_descriptor,
+			     io_handle,
 			     file_io_handle,
 			     store_block_offset,
 			     &store_block_offset,
@@ -2184,6 +2439,7 @@ int libvshadow_store_descriptor_read_block_descriptors(
 			}
 			if( libvshadow_store_descriptor_read_store_block_range_list(
 			     store_descriptor,
+			     io_handle,
 			     file_io_handle,
 			     store_block_offset,
 			     &store_block_offset,
@@ -2199,21 +2455,20 @@ int libvshadow_store_descriptor_read_block_descriptors(
 				goto on_error;
 			}
 		}
-		if( libvshadow_block_tree_free(
+		if( libvshadow_store_descriptor_finish_read_block_descriptors(
+		     store_descriptor,
 		     &store_block_tree,
-		     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free store block tree.",
+			 "%s: unable to finish reading block descriptors.",
 			 function );
 
 			goto on_error;
 		}
-		store_descriptor->block_descriptors_read = 1;
 	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -2265,31 +2520,16 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the block range for a specific offset
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Frees the block descriptors
+ * The block descriptors are read again when needed
+ * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_descriptor_get_block_range_at_offset(
+int libvshadow_store_descriptor_free_block_descriptors(
      libvshadow_store_descriptor_t *store_descriptor,
-     off64_t offset,
-     int active_store_descriptor_index,
-     libvshadow_block_descriptor_t **block_descriptor,
-     size_t *block_size,
-     int *in_block_descriptor_list,
-     off64_t *block_descriptor_offset,
      libcerror_error_t **error )
 {
-	libvshadow_block_descriptor_t *overlay_block_descriptor = NULL;
-	libvshadow_block_descriptor_t *safe_block_descriptor    = NULL;
-	static char *function                                   = "libvshadow_store_descriptor_get_block_range_at_offset";
-	size_t safe_block_size                                  = 0;
-	off64_t block_offset                                    = 0;
-	off64_t overlay_block_offset                            = 0;
-	off64_t safe_block_descriptor_offset                    = 0;
-	uint32_t overlay_bitmap                                 = 0;
-	uint32_t relative_block_offset                          = 0;
-	uint8_t bit_count                                       = 0;
-	int result                                              = 0;
-	int safe_in_block_descriptor_list                       = 0;
+	static char *function = "libvshadow_store_descriptor_free_block_descriptors";
+	int result            = 1;
 
 	if( store_descriptor == NULL )
 	{
@@ -2302,229 +2542,101 @@ int libvshadow_store_descriptor_get_block_range_at_offset(
 
 		return( -1 );
 	}
-	if( block_descriptor == NULL )
+	if( store_descriptor->reverse_block_tree != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid block descriptor.",
-		 function );
+		if( libvshadow_block_tree_free(
+		     &( store_descriptor->reverse_block_tree ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free_reverse,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reverse block tree.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( block_size == NULL )
+	if( store_descriptor->forward_block_tree != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid block size.",
-		 function );
+		if( libvshadow_block_tree_free(
+		     &( store_descriptor->forward_block_tree ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free forward block tree.",
+			 function );
 
-		return( -1 );
+			result = -1;
+		}
 	}
-	if( in_block_descriptor_list == NULL )
+	if( libcdata_list_empty(
+	     store_descriptor->block_descriptors_list,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_block_descriptor_free,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid in block descriptor list.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty block descriptors list.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( block_descriptor_offset == NULL )
+	if( libcdata_range_list_empty(
+	     store_descriptor->block_offset_list,
+	     NULL,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid block descriptor offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty block offsets list.",
 		 function );
 
-		return( -1 );
-	}
-	if( store_descriptor->current_block_descriptor != NULL )
-	{
-		if( ( offset >= store_descriptor->current_block_descriptor->original_offset )
-		 && ( offset < ( store_descriptor->current_block_descriptor->original_offset + 0x4000 ) ) )
-		{
-			result = 1;
-		}
-	}
-	if( result == 0 )
-	{
-		result = libvshadow_block_tree_get_block_descriptor_by_offset(
-		          store_descriptor->forward_block_tree,
-		          offset,
-		          &safe_block_descriptor,
-		          &block_offset,
-		          error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve block range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 offset,
-			 offset );
-
-			return( -1 );
-		}
-		else if( result != 0 )
-		{
-			store_descriptor->current_block_descriptor = safe_block_descriptor;
-		}
+		result = -1;
 	}
-	relative_block_offset = (uint32_t) (offset % 0x4000);
-	safe_block_size       = 0x4000 - relative_block_offset;
-
-	if( result != 0 )
+	if( libcdata_range_list_empty(
+	     store_descriptor->previous_block_offset_list,
+	     NULL,
+	     error ) != 1 )
 	{
-		if( store_descriptor->current_block_descriptor == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing current block descriptor.",
-			 function );
-
-			return( -1 );
-		}
-		safe_block_descriptor         = store_descriptor->current_block_descriptor;
-		safe_in_block_descriptor_list = 1;
-
-		if( ( safe_block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
-		{
-			safe_block_descriptor_offset = safe_block_descriptor->relative_offset;
-		}
-		else
-		{
-			safe_block_descriptor_offset = safe_block_descriptor->offset;
-		}
-		if( ( safe_block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
-		{
-			overlay_block_descriptor = safe_block_descriptor;
-		}
-		else
-		{
-			overlay_block_descriptor = safe_block_descriptor->overlay;
-		}
-		if( overlay_block_descriptor != NULL )
-		{
-			if( store_descriptor->index != active_store_descriptor_index )
-			{
-				if( safe_block_descriptor == overlay_block_descriptor )
-				{
-					safe_block_descriptor         = NULL;
-					safe_in_block_descriptor_list = 0;
-				}
-			}
-			else
-			{
-				overlay_block_offset = overlay_block_descriptor->original_offset;
-				overlay_bitmap       = overlay_block_descriptor->bitmap;
-
-				bit_count = 32;
-
-				while( overlay_block_offset < offset )
-				{
-					overlay_bitmap >>= 1;
-
-					overlay_block_offset += 512;
-
-					bit_count--;
-
-					if( bit_count == 0 )
-					{
-						break;
-					}
-				}
-				if( ( overlay_bitmap & 0x00000001UL ) != 0 )
-				{
-					safe_block_descriptor_offset = overlay_block_descriptor->offset;
-					safe_block_descriptor        = overlay_block_descriptor;
-
-					safe_block_size = 0;
-
-					while( ( overlay_bitmap & 0x00000001UL ) != 0 )
-					{
-						overlay_bitmap >>= 1;
-
-						safe_block_size += 512;
-
-						bit_count--;
-
-						if( bit_count == 0 )
-						{
-							break;
-						}
-					}
-				}
-				else
-				{
-					if( safe_block_descriptor == overlay_block_descriptor )
-					{
-						safe_block_descriptor         = NULL;
-						safe_in_block_descriptor_list = 0;
-					}
-					safe_block_size = 0;
-
-					while( ( overlay_bitmap & 0x00000001UL ) == 0 )
-					{
-						overlay_bitmap >>= 1;
-
-						safe_block_size += 512;
-
-						bit_count--;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty previous block offsets list.",
+		 function );
 
-						if( bit_count == 0 )
-						{
-							break;
-						}
-					}
-				}
-			}
-		}
-		safe_block_descriptor_offset += relative_block_offset;
+		result = -1;
 	}
-	*block_descriptor         = safe_block_descriptor;
-	*block_size               = safe_block_size;
-	*in_block_descriptor_list = safe_in_block_descriptor_list;
-	*block_descriptor_offset  = safe_block_descriptor_offset;
+	store_descriptor->block_descriptors_read = 0;
 
 	return( result );
 }
 
-/* Retrieves the reverse block range for a specific offset
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Retrieves the (estimated) size of the block descriptors
+ * The size is estimated from the number of block descriptors and
+ * block offset ranges
+ * Returns 1 if successful or -1 on error
  */
-int libvshadow_store_descriptor_get_reverse_block_range_at_offset(
+int libvshadow_store_descriptor_get_block_descriptors_size(
      libvshadow_store_descriptor_t *store_descriptor,
-     off64_t offset,
-     int *in_reverse_block_descriptor_list,
-     int *in_current_bitmap,
-     int *in_previous_bitmap,
+     size64_t *size,
      libcerror_error_t **error )
 {
-	libvshadow_block_descriptor_t *reverse_block_descriptor = NULL;
-	intptr_t *value                                         = NULL;
-	static char *function                                   = "libvshadow_store_descriptor_get_reverse_block_range_at_offset";
-	size64_t block_range_size                               = 0;
-	size64_t previous_block_range_size                      = 0;
-	off64_t block_offset                                    = 0;
-	off64_t block_range_offset                              = 0;
-	off64_t previous_block_range_offset                     = 0;
-	int result                                              = 0;
-	int safe_in_current_bitmap                              = 0;
-	int safe_in_previous_bitmap                             = 0;
-	int safe_in_reverse_block_descriptor_list               = 0;
+	static char *function           = "libvshadow_store_descriptor_get_block_descriptors_size";
+	int number_of_block_descriptors = 0;
+	int number_of_offset_ranges     = 0;
+	int number_of_previous_ranges   = 0;
 
 	if( store_descriptor == NULL )
 	{
@@ -2537,188 +2649,1048 @@ int libvshadow_store_descriptor_get_reverse_block_range_at_offset(
 
 		return( -1 );
 	}
-	if( in_reverse_block_descriptor_list == NULL )
+	if( size == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid in reverse block descriptor list.",
+		 "%s: invalid size.",
 		 function );
 
 		return( -1 );
 	}
-	if( in_current_bitmap == NULL )
+	if( libcdata_list_get_number_of_elements(
+	     store_descriptor->block_descriptors_list,
+	     &number_of_block_descriptors,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid in current bitmap.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of block descriptors.",
 		 function );
 
 		return( -1 );
 	}
-	if( in_previous_bitmap == NULL )
+	if( libcdata_range_list_get_number_of_elements(
+	     store_descriptor->block_offset_list,
+	     &number_of_offset_ranges,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid in previous bitmap.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of block offset ranges.",
 		 function );
 
 		return( -1 );
 	}
-	if( store_descriptor->current_reverse_block_descriptor != NULL )
-	{
-		if( ( offset >= store_descriptor->current_reverse_block_descriptor->relative_offset )
-		 && ( offset < ( store_descriptor->current_reverse_block_descriptor->relative_offset + 0x4000 ) ) )
-		{
-			result = 1;
-		}
-	}
-	if( result == 0 )
-	{
-		result = libvshadow_block_tree_get_block_descriptor_by_offset(
-			  store_descriptor->reverse_block_tree,
-			  offset,
-			  &reverse_block_descriptor,
-			  &block_offset,
-			  error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve reverse block descriptor from tree.",
-			 function );
-
-			return( -1 );
-		}
-		else if( result != 0 )
-		{
-			store_descriptor->current_reverse_block_descriptor = reverse_block_descriptor;
-		}
-	}
-	safe_in_reverse_block_descriptor_list = result;
-
-	result = libcdata_range_list_get_range_at_offset(
-		  store_descriptor->block_offset_list,
-		  (uint64_t) offset,
-		  (uint64_t *) &block_range_offset,
-		  (uint64_t *) &block_range_size,
-		  &value,
-		  error );
-
-	if( result == -1 )
+	if( libcdata_range_list_get_number_of_elements(
+	     store_descriptor->previous_block_offset_list,
+	     &number_of_previous_ranges,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve offset: %" PRIi64 " (0x%08" PRIx64 ") from block offset list.",
-		 function,
-		 offset,
-		 offset );
+		 "%s: unable to retrieve number of previous block offset ranges.",
+		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	else if( result != 0 )
+	/* Every block descriptor is stored in the list and in one of the block trees
+	 * together with the list element and block tree leaf overhead
+	 */
+	*size = ( (size64_t) number_of_block_descriptors * ( ( 2 * sizeof( libvshadow_block_descriptor_t ) ) + 64 ) )
+	      + ( (size64_t) ( number_of_offset_ranges + number_of_previous_ranges ) * 48 );
+
+	return( 1 );
+}
+
+/* Acquires the block descriptors for use
+ * The block descriptors are read if they were not read before or were evicted
+ * Every successful call must be matched by a call to
+ * libvshadow_store_descriptor_release_block_descriptors
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_acquire_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_acquire_block_descriptors";
+
+	if( libvshadow_io_handle_grab_store_metadata(
+	     io_handle,
+	     store_descriptor,
+	     error ) != 1 )
 	{
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: store: %02d block offset list: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
-			 function,
-			 store_descriptor->index,
-			 block_range_offset,
-			 block_range_offset + block_range_size,
-			 block_range_size );
-		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab store metadata.",
+		 function );
+
+		return( -1 );
 	}
-#endif
-	safe_in_current_bitmap = result;
+	if( libvshadow_store_descriptor_read_block_descriptors(
+	     store_descriptor,
+	     io_handle,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block descriptors.",
+		 function );
 
-	if( store_descriptor->store_previous_bitmap_offset == 0 )
+		goto on_error;
+	}
+	if( libvshadow_io_handle_add_store_metadata(
+	     io_handle,
+	     store_descriptor,
+	     error ) != 1 )
 	{
-		safe_in_previous_bitmap = 1;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to add store metadata.",
+		 function );
+
+		goto on_error;
 	}
-	else
+	return( 1 );
+
+on_error:
+	libvshadow_io_handle_release_store_metadata(
+	 io_handle,
+	 store_descriptor,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Releases the block descriptors after use
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_descriptor_release_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_descriptor_release_block_descriptors";
+
+	if( libvshadow_io_handle_release_store_metadata(
+	     io_handle,
+	     store_descriptor,
+	     error ) != 1 )
 	{
-		result = libcdata_range_list_get_range_at_offset(
-			  store_descriptor->previous_block_offset_list,
-			  (uint64_t) offset,
-			  (uint64_t *) &previous_block_range_offset,
-			  (uint64_t *) &previous_block_range_size,
-			  &value,
-			  error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release store metadata.",
+		 function );
 
-		if( result == -1 )
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the block range for a specific offset
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvshadow_store_descriptor_get_block_range_at_offset(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     int active_store_descriptor_index,
+     libvshadow_block_descriptor_t **block_descriptor,
+     size_t *block_size,
+     int *in_block_descriptor_list,
+     off64_t *block_descriptor_offset,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t *overlay_block_descriptor = NULL;
+	libvshadow_block_descriptor_t *safe_block_descriptor    = NULL;
+	static char *function                                   = "libvshadow_store_descriptor_get_block_range_at_offset";
+	size_t safe_block_size                                  = 0;
+	off64_t block_offset                                    = 0;
+	off64_t safe_block_descriptor_offset                    = 0;
+	uint32_t relative_block_offset                          = 0;
+	int in_overlay_range                                    = 0;
+	int result                                              = 0;
+	int safe_in_block_descriptor_list                       = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( in_block_descriptor_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid in block descriptor list.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_descriptor_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block descriptor offset.",
+		 function );
+
+		return( -1 );
+	}
+	/* The block descriptor is only kept in a local variable, since the store
+	 * descriptor can be read by multiple threads that hold the read lock
+	 */
+	result = libvshadow_block_tree_get_block_descriptor_by_offset(
+	          store_descriptor->forward_block_tree,
+	          offset,
+	          &safe_block_descriptor,
+	          &block_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	relative_block_offset = (uint32_t) (offset % 0x4000);
+	safe_block_size       = 0x4000 - relative_block_offset;
+
+	if( result != 0 )
+	{
+		if( safe_block_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing block descriptor.",
+			 function );
+
+			return( -1 );
+		}
+		safe_in_block_descriptor_list = 1;
+
+		if( ( safe_block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
+		{
+			safe_block_descriptor_offset = LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET(
+			                                safe_block_descriptor );
+		}
+		else
+		{
+			safe_block_descriptor_offset = LIBVSHADOW_BLOCK_DESCRIPTOR_GET_OFFSET(
+			                                safe_block_descriptor );
+		}
+		if( ( safe_block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
+		{
+			overlay_block_descriptor = safe_block_descriptor;
+		}
+		else if( libvshadow_block_tree_get_overlay_block_descriptor(
+		          store_descriptor->forward_block_tree,
+		          safe_block_descriptor,
+		          &overlay_block_descriptor,
+		          error ) == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve offset: %" PRIi64 " (0x%08" PRIx64 ") from previous block offset list.",
-			 function,
-			 offset,
-			 offset );
+			 "%s: unable to retrieve overlay block descriptor.",
+			 function );
 
 			return( -1 );
 		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		else if( result != 0 )
+		if( overlay_block_descriptor != NULL )
 		{
-			if( libcnotify_verbose != 0 )
+			if( store_descriptor->index != active_store_descriptor_index )
 			{
-				libcnotify_printf(
-				 "%s: store: %02d previous block offset list: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
-				 function,
-				 store_descriptor->index,
-				 previous_block_range_offset,
-				 previous_block_range_offset + previous_block_range_size,
-				 previous_block_range_size );
+				if( safe_block_descriptor == overlay_block_descriptor )
+				{
+					safe_block_descriptor         = NULL;
+					safe_in_block_descriptor_list = 0;
+				}
 			}
-		}
+			else
+			{
+				in_overlay_range = libvshadow_block_descriptor_get_bitmap_range_at_offset(
+				                    overlay_block_descriptor,
+				                    relative_block_offset,
+				                    &safe_block_size,
+				                    error );
+
+				if( in_overlay_range == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve overlay bitmap range.",
+					 function );
+
+					return( -1 );
+				}
+				else if( in_overlay_range != 0 )
+				{
+					safe_block_descriptor_offset = LIBVSHADOW_BLOCK_DESCRIPTOR_GET_OFFSET(
+					                                overlay_block_descriptor );
+					safe_block_descriptor        = overlay_block_descriptor;
+				}
+				else if( safe_block_descriptor == overlay_block_descriptor )
+				{
+					safe_block_descriptor         = NULL;
+					safe_in_block_descriptor_list = 0;
+				}
+			}
+		}
+		safe_block_descriptor_offset += relative_block_offset;
+	}
+	*block_descriptor         = safe_block_descriptor;
+	*block_size               = safe_block_size;
+	*in_block_descriptor_list = safe_in_block_descriptor_list;
+	*block_descriptor_offset  = safe_block_descriptor_offset;
+
+	return( result );
+}
+
+/* Retrieves the reverse block range for a specific offset
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libvshadow_store_descriptor_get_reverse_block_range_at_offset(
+     libvshadow_store_descriptor_t *store_descriptor,
+     off64_t offset,
+     int *in_reverse_block_descriptor_list,
+     int *in_current_bitmap,
+     int *in_previous_bitmap,
+     libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t *reverse_block_descriptor = NULL;
+	intptr_t *value                                         = NULL;
+	static char *function                                   = "libvshadow_store_descriptor_get_reverse_block_range_at_offset";
+	size64_t block_range_size                               = 0;
+	size64_t previous_block_range_size                      = 0;
+	off64_t block_offset                                    = 0;
+	off64_t block_range_offset                              = 0;
+	off64_t previous_block_range_offset                     = 0;
+	int result                                              = 0;
+	int safe_in_current_bitmap                              = 0;
+	int safe_in_previous_bitmap                             = 0;
+	int safe_in_reverse_block_descriptor_list               = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( in_reverse_block_descriptor_list == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid in reverse block descriptor list.",
+		 function );
+
+		return( -1 );
+	}
+	if( in_current_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid in current bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	if( in_previous_bitmap == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid in previous bitmap.",
+		 function );
+
+		return( -1 );
+	}
+	/* The reverse block tree is not created if the store contains no forwarder block descriptors
+	 */
+	if( store_descriptor->reverse_block_tree != NULL )
+	{
+		result = libvshadow_block_tree_get_block_descriptor_by_offset(
+			  store_descriptor->reverse_block_tree,
+			  offset,
+			  &reverse_block_descriptor,
+			  &block_offset,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reverse block descriptor from tree.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	safe_in_reverse_block_descriptor_list = result;
+
+	result = libcdata_range_list_get_range_at_offset(
+		  store_descriptor->block_offset_list,
+		  (uint64_t) offset,
+		  (uint64_t *) &block_range_offset,
+		  (uint64_t *) &block_range_size,
+		  &value,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve offset: %" PRIi64 " (0x%08" PRIx64 ") from block offset list.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	else if( result != 0 )
+	{
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: store: %02d block offset list: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 store_descriptor->index,
+			 block_range_offset,
+			 block_range_offset + block_range_size,
+			 block_range_size );
+		}
+	}
+#endif
+	safe_in_current_bitmap = result;
+
+	if( store_descriptor->store_previous_bitmap_offset == 0 )
+	{
+		safe_in_previous_bitmap = 1;
+	}
+	else
+	{
+		result = libcdata_range_list_get_range_at_offset(
+			  store_descriptor->previous_block_offset_list,
+			  (uint64_t) offset,
+			  (uint64_t *) &previous_block_range_offset,
+			  (uint64_t *) &previous_block_range_size,
+			  &value,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve offset: %" PRIi64 " (0x%08" PRIx64 ") from previous block offset list.",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		else if( result != 0 )
+		{
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: store: %02d previous block offset list: 0x%08" PRIx64 " - 0x%08" PRIx64 " (0x%08" PRIx64 ")\n",
+				 function,
+				 store_descriptor->index,
+				 previous_block_range_offset,
+				 previous_block_range_offset + previous_block_range_size,
+				 previous_block_range_size );
+			}
+		}
+#endif
+		safe_in_previous_bitmap = result;
+	}
+	*in_reverse_block_descriptor_list = safe_in_reverse_block_descriptor_list;
+	*in_current_bitmap                = safe_in_current_bitmap;
+	*in_previous_bitmap               = safe_in_previous_bitmap;
+
+	return( 1 );
+}
+
+/* Reads data at the specified offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvshadow_store_descriptor_read_buffer(
+         libvshadow_store_descriptor_t *store_descriptor,
+         libvshadow_io_handle_t *io_handle,
+         libbfio_handle_t *file_io_handle,
+         uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         int active_store_descriptor_index,
+         libcerror_error_t **error )
+{
+	libvshadow_block_descriptor_t *block_descriptor = NULL;
+	static char *function                           = "libvshadow_store_descriptor_read_buffer";
+	size_t block_size                               = 0;
+	size_t buffer_offset                            = 0;
+	size_t read_size                                = 0;
+	ssize_t read_count                              = 0;
+	off64_t block_descriptor_offset                 = 0;
+	int in_block_descriptor_list                    = 0;
+	int in_current_bitmap                           = 0;
+	int in_previous_bitmap                          = 0;
+	int in_reverse_block_descriptor_list            = 0;
+	int result                                      = 0;
+
+	if( store_descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_descriptor->has_in_volume_store_data == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store descriptor - missing in-volume store data.",
+		 function );
+
+		return( -1 );
+	}
+	/* This function will acquire the write lock if the block descriptors
+	 * need to be (re)read
+	 */
+	if( libvshadow_store_descriptor_acquire_block_descriptors(
+	     store_descriptor,
+	     io_handle,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to acquire block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		libvshadow_store_descriptor_release_block_descriptors(
+		 store_descriptor,
+		 io_handle,
+		 NULL );
+
+		return( -1 );
+	}
+#endif
+	while( buffer_size > 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: store: %02d requested offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 store_descriptor->index,
+			 offset,
+			 offset );
+		}
+#endif
+		in_reverse_block_descriptor_list = 0;
+		in_current_bitmap                = 0;
+		in_previous_bitmap               = 0;
+
+/* TODO determine if block_descriptor_offset can be determined later only when needed */
+		result = libvshadow_store_descriptor_get_block_range_at_offset(
+		          store_descriptor,
+		          offset,
+		          active_store_descriptor_index,
+		          &block_descriptor,
+		          &block_size,
+		          &in_block_descriptor_list,
+		          &block_descriptor_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+		if( in_block_descriptor_list == 0 )
+		{
+			/* Only the most recent store seems to bother checking the current bitmap
+			 */
+			if( ( store_descriptor->next_store_descriptor == NULL )
+			 && ( store_descriptor->index == active_store_descriptor_index ) )
+			{
+				result = libvshadow_store_descriptor_get_reverse_block_range_at_offset(
+				          store_descriptor,
+				          offset,
+				          &in_reverse_block_descriptor_list,
+				          &in_current_bitmap,
+				          &in_previous_bitmap,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve reverse block range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 offset,
+					 offset );
+
+					goto on_error;
+				}
+			}
+		}
+		if( buffer_size > block_size )
+		{
+			read_size = block_size;
+		}
+		else
+		{
+			read_size = buffer_size;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: store: %02d range: 0x%08" PRIx64 " - 0x%08" PRIx64 " size: %" PRIzd "",
+			 function,
+			 store_descriptor->index,
+			 offset,
+			 offset + block_size,
+			 block_size );
+
+			if( block_descriptor != NULL )
+			{
+				libcnotify_printf(
+				 ", flags: 0x%08" PRIx32 "",
+				 block_descriptor->flags );
+			}
+			libcnotify_printf(
+			 "\n" );
+
+			if( in_block_descriptor_list != 0 )
+			{
+				libcnotify_printf(
+				 "\tIn block list\n" );
+			}
+			if( block_descriptor != NULL )
+			{
+				if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
+				{
+					libcnotify_printf(
+					 "\tIs overlay\n" );
+				}
+			}
+			if( in_reverse_block_descriptor_list != 0 )
+			{
+				libcnotify_printf(
+				 "\tIn reverse block list\n" );
+			}
+			if( in_current_bitmap != 0 )
+			{
+				libcnotify_printf(
+				 "\tIn current bitmap\n" );
+			}
+			if( ( store_descriptor->store_previous_bitmap_offset != 0 )
+			 && ( in_previous_bitmap != 0 ) )
+			{
+				libcnotify_printf(
+				 "\tIn previous bitmap\n" );
+			}
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+
+		if( in_block_descriptor_list != 0 )
+		{
+			if( ( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
+			 && ( store_descriptor->next_store_descriptor != NULL ) )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: store: %02d reading block from next store at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+					 function,
+					 store_descriptor->index,
+					 block_descriptor_offset,
+					 block_descriptor_offset );
+				}
+#endif
+				read_count = libvshadow_store_descriptor_read_buffer(
+					      store_descriptor->next_store_descriptor,
+					      io_handle,
+					      file_io_handle,
+					      &( buffer[ buffer_offset ] ),
+					      read_size,
+					      block_descriptor_offset,
+					      active_store_descriptor_index,
+					      error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read buffer from next store descriptor.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			else
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: store: %02d reading block from current volume at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+					 function,
+					 store_descriptor->index,
+					 block_descriptor_offset,
+					 block_descriptor_offset );
+				}
+#endif
+				read_count = libvshadow_io_handle_read_store_data(
+					      io_handle,
+					      file_io_handle,
+					      block_descriptor_offset,
+					      &( buffer[ buffer_offset ] ),
+					      read_size,
+					      offset,
+					      active_store_descriptor_index,
+					      store_descriptor->index,
+					      LIBVSHADOW_TRACE_READ_TYPE_STORE_DATA,
+					      error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 block_descriptor_offset,
+					 block_descriptor_offset );
+
+					goto on_error;
+				}
+			}
+		}
+		else
+		{
+			/* Check if the next store defines the block
+			 */
+			if( store_descriptor->next_store_descriptor != NULL )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: store: %02d reading block from next store at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+					 function,
+					 store_descriptor->index,
+					 offset,
+					 offset );
+				}
+#endif
+				read_count = libvshadow_store_descriptor_read_buffer(
+					      store_descriptor->next_store_descriptor,
+					      io_handle,
+					      file_io_handle,
+					      &( buffer[ buffer_offset ] ),
+					      read_size,
+					      offset,
+					      active_store_descriptor_index,
+					      error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read buffer from next store descriptor.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			else if( ( in_reverse_block_descriptor_list == 0 )
+			      && ( in_current_bitmap != 0 )
+			      && ( in_previous_bitmap != 0 ) )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: store: %02d filling block with zero bytes\n",
+					 function,
+					 store_descriptor->index,
+					 offset,
+					 read_size );
+				}
+#endif
+				if( memory_set(
+				     &( buffer[ buffer_offset ] ),
+				     0,
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear buffer.",
+					 function );
+
+					goto on_error;
+				}
+				read_count = (ssize_t) read_size;
+			}
+			else
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: store: %02d reading block from current volume at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+					 function,
+					 store_descriptor->index,
+					 offset,
+					 offset );
+				}
+#endif
+				read_count = libvshadow_io_handle_read_store_data(
+					      io_handle,
+					      file_io_handle,
+					      offset,
+					      &( buffer[ buffer_offset ] ),
+					      read_size,
+					      offset,
+					      active_store_descriptor_index,
+					      LIBVSHADOW_TRACE_STORE_INDEX_NONE,
+					      LIBVSHADOW_TRACE_READ_TYPE_STORE_DATA,
+					      error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read buffer from file IO handle at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 offset,
+					 offset );
+
+					goto on_error;
+				}
+			}
+		}
+		offset        += read_count;
+		buffer_offset += read_count;
+		buffer_size   -= read_count;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		libvshadow_store_descriptor_release_block_descriptors(
+		 store_descriptor,
+		 io_handle,
+		 NULL );
+
+		return( -1 );
+	}
 #endif
-		safe_in_previous_bitmap = result;
+	if( libvshadow_store_descriptor_release_block_descriptors(
+	     store_descriptor,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release block descriptors.",
+		 function );
+
+		return( -1 );
 	}
-	*in_reverse_block_descriptor_list = safe_in_reverse_block_descriptor_list;
-	*in_current_bitmap                = safe_in_current_bitmap;
-	*in_previous_bitmap               = safe_in_previous_bitmap;
+	return( (ssize_t) buffer_offset );
 
-	return( 1 );
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 store_descriptor->read_write_lock,
+	 NULL );
+#endif
+	libvshadow_store_descriptor_release_block_descriptors(
+	 store_descriptor,
+	 io_handle,
+	 NULL );
+
+	return( -1 );
 }
 
-/* Reads data at the specified offset into a buffer
- * Returns the number of bytes read or -1 on error
+/* Retrieves the source of the data at the specified offset
+ * This function determines where libvshadow_store_descriptor_read_buffer would read
+ * the data from without reading the data itself
+ * The source size contains the number of bytes from offset that share the same source
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvshadow_store_descriptor_read_buffer(
-         libvshadow_store_descriptor_t *store_descriptor,
-         libvshadow_io_handle_t *io_handle,
-         libbfio_handle_t *file_io_handle,
-         uint8_t *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         int active_store_descriptor_index,
-         libcerror_error_t **error )
+int libvshadow_store_descriptor_get_data_source_at_offset(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     int active_store_descriptor_index,
+     int *source_type,
+     int *source_store_index,
+     off64_t *source_offset,
+     size64_t *source_size,
+     libcerror_error_t **error )
 {
 	libvshadow_block_descriptor_t *block_descriptor = NULL;
-	static char *function                           = "libvshadow_store_descriptor_read_buffer";
+	libvshadow_store_descriptor_t *next_store       = NULL;
+	static char *function                           = "libvshadow_store_descriptor_get_data_source_at_offset";
+	size64_t safe_source_size                       = 0;
 	size_t block_size                               = 0;
-	size_t buffer_offset                            = 0;
-	size_t read_size                                = 0;
-	ssize_t read_count                              = 0;
 	off64_t block_descriptor_offset                 = 0;
+	off64_t next_store_offset                       = 0;
+	off64_t safe_source_offset                      = 0;
 	int in_block_descriptor_list                    = 0;
 	int in_current_bitmap                           = 0;
 	int in_previous_bitmap                          = 0;
 	int in_reverse_block_descriptor_list            = 0;
 	int result                                      = 0;
+	int safe_source_store_index                     = -1;
+	int safe_source_type                            = 0;
 
 	if( store_descriptor == NULL )
 	{
@@ -2742,360 +3714,213 @@ ssize_t libvshadow_store_descriptor_read_buffer(
 
 		return( -1 );
 	}
-	/* This function will acquire the write lock
-	 */
-	if( libvshadow_store_descriptor_read_block_descriptors(
-	     store_descriptor,
-	     io_handle,
-	     file_io_handle,
-	     error ) != 1 )
+	if( source_type == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read block descriptors.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source type.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     store_descriptor->read_write_lock,
-	     error ) != 1 )
+	if( source_store_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source store index.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	while( buffer_size > 0 )
+	if( source_offset == NULL )
 	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: store: %02d requested offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-			 function,
-			 store_descriptor->index,
-			 offset,
-			 offset );
-		}
-#endif
-		in_reverse_block_descriptor_list = 0;
-		in_current_bitmap                = 0;
-		in_previous_bitmap               = 0;
-
-/* TODO determine if block_descriptor_offset can be determined later only when needed */
-		result = libvshadow_store_descriptor_get_block_range_at_offset(
-		          store_descriptor,
-		          offset,
-		          active_store_descriptor_index,
-		          &block_descriptor,
-		          &block_size,
-		          &in_block_descriptor_list,
-		          &block_descriptor_offset,
-		          error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve block range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-			 function,
-			 offset,
-			 offset );
-
-			goto on_error;
-		}
-		if( in_block_descriptor_list == 0 )
-		{
-			/* Only the most recent store seems to bother checking the current bitmap
-			 */
-			if( ( store_descriptor->next_store_descriptor == NULL )
-			 && ( store_descriptor->index == active_store_descriptor_index ) )
-			{
-				result = libvshadow_store_descriptor_get_reverse_block_range_at_offset(
-				          store_descriptor,
-				          offset,
-				          &in_reverse_block_descriptor_list,
-				          &in_current_bitmap,
-				          &in_previous_bitmap,
-				          error );
-
-				if( result == -1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve reverse block range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
-					 function,
-					 offset,
-					 offset );
-
-					goto on_error;
-				}
-			}
-		}
-		if( buffer_size > block_size )
-		{
-			read_size = block_size;
-		}
-		else
-		{
-			read_size = buffer_size;
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: store: %02d range: 0x%08" PRIx64 " - 0x%08" PRIx64 " size: %" PRIzd "",
-			 function,
-			 store_descriptor->index,
-			 offset,
-			 offset + block_size,
-			 block_size );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source offset.",
+		 function );
 
-			if( block_descriptor != NULL )
-			{
-				libcnotify_printf(
-				 ", flags: 0x%08" PRIx32 "",
-				 block_descriptor->flags );
-			}
-			libcnotify_printf(
-			 "\n" );
+		return( -1 );
+	}
+	if( source_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source size.",
+		 function );
 
-			if( in_block_descriptor_list != 0 )
-			{
-				libcnotify_printf(
-				 "\tIn block list\n" );
-			}
-			if( block_descriptor != NULL )
-			{
-				if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_OVERLAY ) != 0 )
-				{
-					libcnotify_printf(
-					 "\tIs overlay\n" );
-				}
-			}
-			if( in_reverse_block_descriptor_list != 0 )
-			{
-				libcnotify_printf(
-				 "\tIn reverse block list\n" );
-			}
-			if( in_current_bitmap != 0 )
-			{
-				libcnotify_printf(
-				 "\tIn current bitmap\n" );
-			}
-			if( ( store_descriptor->store_previous_bitmap_offset != 0 )
-			 && ( in_previous_bitmap != 0 ) )
-			{
-				libcnotify_printf(
-				 "\tIn previous bitmap\n" );
-			}
-			libcnotify_printf(
-			 "\n" );
-		}
-#endif /* defined( HAVE_DEBUG_OUTPUT ) */
+		return( -1 );
+	}
+	/* This function will acquire the write lock if the block descriptors
+	 * need to be (re)read
+	 */
+	if( libvshadow_store_descriptor_acquire_block_descriptors(
+	     store_descriptor,
+	     io_handle,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to acquire block descriptors.",
+		 function );
 
-		if( in_block_descriptor_list != 0 )
-		{
-			if( ( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
-			 && ( store_descriptor->next_store_descriptor != NULL ) )
-			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from next store at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-					 function,
-					 store_descriptor->index,
-					 block_descriptor_offset,
-					 block_descriptor_offset );
-				}
-#endif
-				read_count = libvshadow_store_descriptor_read_buffer(
-					      store_descriptor->next_store_descriptor,
-					      io_handle,
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      block_descriptor_offset,
-					      active_store_descriptor_index,
-					      error );
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     store_descriptor->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from next store descriptor.",
-					 function );
+		libvshadow_store_descriptor_release_block_descriptors(
+		 store_descriptor,
+		 io_handle,
+		 NULL );
 
-					goto on_error;
-				}
-			}
-			else
-			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from current volume at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-					 function,
-					 store_descriptor->index,
-					 block_descriptor_offset,
-					 block_descriptor_offset );
-				}
+		return( -1 );
+	}
 #endif
-				read_count = libbfio_handle_read_buffer_at_offset(
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      block_descriptor_offset,
-					      error );
+	result = libvshadow_store_descriptor_get_block_range_at_offset(
+	          store_descriptor,
+	          offset,
+	          active_store_descriptor_index,
+	          &block_descriptor,
+	          &block_size,
+	          &in_block_descriptor_list,
+	          &block_descriptor_offset,
+	          error );
 
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-					 function,
-					 block_descriptor_offset,
-					 block_descriptor_offset );
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
 
-					goto on_error;
-				}
-			}
-		}
-		else
+		goto on_error;
+	}
+	safe_source_size = (size64_t) block_size;
+
+	/* The decisions below mirror those of libvshadow_store_descriptor_read_buffer
+	 */
+	if( in_block_descriptor_list != 0 )
+	{
+		if( ( block_descriptor->flags & LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER ) != 0 )
 		{
-			/* Check if the next store defines the block
-			 */
 			if( store_descriptor->next_store_descriptor != NULL )
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from next store at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-					 function,
-					 store_descriptor->index,
-					 offset,
-					 offset );
-				}
-#endif
-				read_count = libvshadow_store_descriptor_read_buffer(
-					      store_descriptor->next_store_descriptor,
-					      io_handle,
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      offset,
-					      active_store_descriptor_index,
-					      error );
-
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from next store descriptor.",
-					 function );
-
-					goto on_error;
-				}
+				next_store        = store_descriptor->next_store_descriptor;
+				next_store_offset = block_descriptor_offset;
 			}
-			else if( ( in_reverse_block_descriptor_list == 0 )
-			      && ( in_current_bitmap != 0 )
-			      && ( in_previous_bitmap != 0 ) )
+			else
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d filling block with zero bytes\n",
-					 function,
-					 store_descriptor->index,
-					 offset,
-					 read_size );
-				}
-#endif
-				if( memory_set(
-				     &( buffer[ buffer_offset ] ),
-				     0,
-				     read_size ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to clear buffer.",
-					 function );
-
-					goto on_error;
-				}
-				read_count = (ssize_t) read_size;
+				safe_source_type   = LIBVSHADOW_DATA_SOURCE_TYPE_VOLUME;
+				safe_source_offset = block_descriptor_offset;
 			}
-			else
+		}
+		else
+		{
+			safe_source_type        = LIBVSHADOW_DATA_SOURCE_TYPE_STORE;
+			safe_source_store_index = store_descriptor->index;
+			safe_source_offset      = block_descriptor_offset;
+		}
+	}
+	else if( store_descriptor->next_store_descriptor != NULL )
+	{
+		next_store        = store_descriptor->next_store_descriptor;
+		next_store_offset = offset;
+	}
+	else
+	{
+		/* Only the most recent store seems to bother checking the current bitmap
+		 */
+		if( store_descriptor->index == active_store_descriptor_index )
+		{
+			result = libvshadow_store_descriptor_get_reverse_block_range_at_offset(
+			          store_descriptor,
+			          offset,
+			          &in_reverse_block_descriptor_list,
+			          &in_current_bitmap,
+			          &in_previous_bitmap,
+			          error );
+
+			if( result == -1 )
 			{
-#if defined( HAVE_DEBUG_OUTPUT )
-				if( libcnotify_verbose != 0 )
-				{
-					libcnotify_printf(
-					 "%s: store: %02d reading block from current volume at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-					 function,
-					 store_descriptor->index,
-					 offset,
-					 offset );
-				}
-#endif
-				read_count = libbfio_handle_read_buffer_at_offset(
-					      file_io_handle,
-					      &( buffer[ buffer_offset ] ),
-					      read_size,
-					      offset,
-					      error );
-
-				if( read_count != (ssize_t) read_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read buffer from file IO handle at offset: %" PRIi64 " (0x%08" PRIx64 ").",
-					 function,
-					 offset,
-					 offset );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve reverse block range for offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
 
-					goto on_error;
-				}
+				goto on_error;
 			}
 		}
-		offset        += read_count;
-		buffer_offset += read_count;
-		buffer_size   -= read_count;
+		if( ( in_reverse_block_descriptor_list == 0 )
+		 && ( in_current_bitmap != 0 )
+		 && ( in_previous_bitmap != 0 ) )
+		{
+			safe_source_type = LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE;
+		}
+		else
+		{
+			safe_source_type   = LIBVSHADOW_DATA_SOURCE_TYPE_VOLUME;
+			safe_source_offset = offset;
+		}
+	}
+	if( next_store != NULL )
+	{
+		if( libvshadow_store_descriptor_get_data_source_at_offset(
+		     next_store,
+		     io_handle,
+		     file_io_handle,
+		     next_store_offset,
+		     active_store_descriptor_index,
+		     &safe_source_type,
+		     &safe_source_store_index,
+		     &safe_source_offset,
+		     &safe_source_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data source from next store descriptor.",
+			 function );
 
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+			goto on_error;
+		}
+		if( safe_source_type == LIBVSHADOW_DATA_SOURCE_TYPE_STORE )
 		{
-			libcnotify_printf(
-			 "\n" );
+			safe_source_type = LIBVSHADOW_DATA_SOURCE_TYPE_NEXT_STORE;
+		}
+		if( safe_source_size > (size64_t) block_size )
+		{
+			safe_source_size = (size64_t) block_size;
 		}
-#endif
 	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -3109,10 +3934,34 @@ ssize_t libvshadow_store_descriptor_read_buffer(
 		 "%s: unable to release read/write lock for reading.",
 		 function );
 
+		libvshadow_store_descriptor_release_block_descriptors(
+		 store_descriptor,
+		 io_handle,
+		 NULL );
+
 		return( -1 );
 	}
 #endif
-	return( (ssize_t) buffer_offset );
+	if( libvshadow_store_descriptor_release_block_descriptors(
+	     store_descriptor,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release block descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	*source_type        = safe_source_type;
+	*source_store_index = safe_source_store_index;
+	*source_offset      = safe_source_offset;
+	*source_size        = safe_source_size;
+
+	return( 1 );
 
 on_error:
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
@@ -3120,6 +3969,11 @@ on_error:
 	 store_descriptor->read_write_lock,
 	 NULL );
 #endif
+	libvshadow_store_descriptor_release_block_descriptors(
+	 store_descriptor,
+	 io_handle,
+	 NULL );
+
 	return( -1 );
 }
 
@@ -3683,9 +4537,10 @@ int libvshadow_store_descriptor_get_number_of_blocks(
 
 		return( -1 );
 	}
-	/* This function will acquire the write lock
+	/* This function will acquire the write lock if the block descriptors
+	 * need to be (re)read
 	 */
-	if( libvshadow_store_descriptor_read_block_descriptors(
+	if( libvshadow_store_descriptor_acquire_block_descriptors(
 	     store_descriptor,
 	     io_handle,
 	     file_io_handle,
@@ -3695,7 +4550,7 @@ int libvshadow_store_descriptor_get_number_of_blocks(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read block descriptors.",
+		 "%s: unable to acquire block descriptors.",
 		 function );
 
 		return( -1 );
@@ -3712,6 +4567,11 @@ int libvshadow_store_descriptor_get_number_of_blocks(
 		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
+		libvshadow_store_descriptor_release_block_descriptors(
+		 store_descriptor,
+		 io_handle,
+		 NULL );
+
 		return( -1 );
 	}
 #endif
@@ -3741,9 +4601,28 @@ int libvshadow_store_descriptor_get_number_of_blocks(
 		 "%s: unable to release read/write lock for reading.",
 		 function );
 
+		libvshadow_store_descriptor_release_block_descriptors(
+		 store_descriptor,
+		 io_handle,
+		 NULL );
+
 		return( -1 );
 	}
 #endif
+	if( libvshadow_store_descriptor_release_block_descriptors(
+	     store_descriptor,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release block descriptors.",
+		 function );
+
+		result = -1;
+	}
 	return( result );
 }
 
@@ -3783,9 +4662,10 @@ int libvshadow_store_descriptor_get_block_descriptor_by_index(
 
 		return( -1 );
 	}
-	/* This function will acquire the write lock
+	/* This function will acquire the write lock if the block descriptors
+	 * need to be (re)read
 	 */
-	if( libvshadow_store_descriptor_read_block_descriptors(
+	if( libvshadow_store_descriptor_acquire_block_descriptors(
 	     store_descriptor,
 	     io_handle,
 	     file_io_handle,
@@ -3795,7 +4675,7 @@ int libvshadow_store_descriptor_get_block_descriptor_by_index(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read block descriptors.",
+		 "%s: unable to acquire block descriptors.",
 		 function );
 
 		return( -1 );
@@ -3812,6 +4692,11 @@ int libvshadow_store_descriptor_get_block_descriptor_by_index(
 		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
+		libvshadow_store_descriptor_release_block_descriptors(
+		 store_descriptor,
+		 io_handle,
+		 NULL );
+
 		return( -1 );
 	}
 #endif
@@ -3843,9 +4728,28 @@ int libvshadow_store_descriptor_get_block_descriptor_by_index(
 		 "%s: unable to release read/write lock for reading.",
 		 function );
 
+		libvshadow_store_descriptor_release_block_descriptors(
+		 store_descriptor,
+		 io_handle,
+		 NULL );
+
 		return( -1 );
 	}
 #endif
+	if( libvshadow_store_descriptor_release_block_descriptors(
+	     store_descriptor,
+	     io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release block descriptors.",
+		 function );
+
+		result = -1;
+	}
 	return( result );
 }
 
@@ -132,14 +132,6 @@ struct libvshadow_store_descriptor
 	 */
 	libvshadow_store_descriptor_t *next_store_descriptor;
 
-	/* The current block descriptor
-	 */
-	libvshadow_block_descriptor_t *current_block_descriptor;
-
-	/* The current reverse block descriptor
-	 */
-	libvshadow_block_descriptor_t *current_reverse_block_descriptor;
-
 	/* The index
 	 */
 	int index;
@@ -152,6 +144,26 @@ struct libvshadow_store_descriptor
 	 */
 	uint8_t block_descriptors_read;
 
+	/* The (estimated) size of the block metadata
+	 */
+	size64_t metadata_size;
+
+	/* The number of users of the block metadata
+	 */
+	int metadata_use_count;
+
+	/* Value to indicate the block metadata is resident
+	 */
+	uint8_t metadata_is_resident;
+
+	/* The more recently used store descriptor in the metadata list
+	 */
+	libvshadow_store_descriptor_t *more_recently_used_store_descriptor;
+
+	/* The less recently used store descriptor in the metadata list
+	 */
+	libvshadow_store_descriptor_t *less_recently_used_store_descriptor;
+
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -181,6 +193,11 @@ int libvshadow_store_descriptor_compare_by_identifier(
      libvshadow_store_descriptor_t *second_store_descriptor,
      libcerror_error_t **error );
 
+int libvshadow_store_descriptor_set_next_store_descriptor(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_store_descriptor_t *next_store_descriptor,
+     libcerror_error_t **error );
+
 int libvshadow_store_descriptor_read_catalog_entry(
      libvshadow_store_descriptor_t *store_descriptor,
      const uint8_t *catalog_block_data,
@@ -190,11 +207,13 @@ int libvshadow_store_descriptor_read_catalog_entry(
 
 int libvshadow_store_descriptor_read_store_header(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
 int libvshadow_store_descriptor_read_store_bitmap(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      libcdata_range_list_t *offset_list,
@@ -204,6 +223,7 @@ int libvshadow_store_descriptor_read_store_bitmap(
 
 int libvshadow_store_descriptor_read_store_block_list(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      off64_t *next_offset,
@@ -211,17 +231,49 @@ int libvshadow_store_descriptor_read_store_block_list(
 
 int libvshadow_store_descriptor_read_store_block_range_list(
      libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      off64_t *next_offset,
      libcerror_error_t **error );
 
+int libvshadow_store_descriptor_start_read_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libvshadow_block_tree_t **store_block_tree,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_finish_read_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_block_tree_t **store_block_tree,
+     libcerror_error_t **error );
+
 int libvshadow_store_descriptor_read_block_descriptors(
      libvshadow_store_descriptor_t *store_descriptor,
      libvshadow_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libvshadow_store_descriptor_free_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_get_block_descriptors_size(
+     libvshadow_store_descriptor_t *store_descriptor,
+     size64_t *size,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_acquire_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libvshadow_store_descriptor_release_block_descriptors(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
 ssize_t libvshadow_store_descriptor_read_buffer(
          libvshadow_store_descriptor_t *store_descriptor,
          libvshadow_io_handle_t *io_handle,
@@ -232,6 +284,18 @@ ssize_t libvshadow_store_descriptor_read_buffer(
          int active_store_descriptor_index,
          libcerror_error_t **error );
 
+int libvshadow_store_descriptor_get_data_source_at_offset(
+     libvshadow_store_descriptor_t *store_descriptor,
+     libvshadow_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t offset,
+     int active_store_descriptor_index,
+     int *source_type,
+     int *source_store_index,
+     off64_t *source_offset,
+     size64_t *source_size,
+     libcerror_error_t **error );
+
 int libvshadow_store_descriptor_get_volume_size(
      libvshadow_store_descriptor_t *store_descriptor,
      size64_t *volume_size,
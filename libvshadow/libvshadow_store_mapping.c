@@ -0,0 +1,924 @@
+/*
+ * Store memory mapping functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvshadow_definitions.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcnotify.h"
+#include "libvshadow_libcthreads.h"
+#include "libvshadow_store.h"
+#include "libvshadow_store_descriptor.h"
+#include "libvshadow_store_mapping.h"
+
+#if defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT )
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <linux/userfaultfd.h>
+
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+/* Creates a store mapping
+ * Make sure the value store_mapping is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_mapping_initialize(
+     libvshadow_store_mapping_t **store_mapping,
+     struct libvshadow_internal_store *internal_store,
+     size64_t data_size,
+     libcerror_error_t **error )
+{
+	struct uffdio_api userfault_api;
+	struct uffdio_register userfault_register;
+
+	libvshadow_store_mapping_t *safe_store_mapping = NULL;
+	static char *function                          = "libvshadow_store_mapping_initialize";
+	long page_size                                 = 0;
+
+	if( store_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( *store_mapping != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid store mapping value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid internal store.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	page_size = sysconf(
+	             _SC_PAGESIZE );
+
+	if( ( page_size <= 0 )
+	 || ( page_size > (long) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+	 || ( ( page_size & ( page_size - 1 ) ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported page size.",
+		 function );
+
+		return( -1 );
+	}
+	safe_store_mapping = memory_allocate_structure(
+	                      libvshadow_store_mapping_t );
+
+	if( safe_store_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create store mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     safe_store_mapping,
+	     0,
+	     sizeof( libvshadow_store_mapping_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear store mapping.",
+		 function );
+
+		memory_free(
+		 safe_store_mapping );
+
+		return( -1 );
+	}
+	safe_store_mapping->internal_store             = internal_store;
+	safe_store_mapping->data_size                  = data_size;
+	safe_store_mapping->page_size                  = (size_t) page_size;
+	safe_store_mapping->userfault_file_descriptor  = -1;
+	safe_store_mapping->stop_file_descriptors[ 0 ] = -1;
+	safe_store_mapping->stop_file_descriptors[ 1 ] = -1;
+
+	/* The size of the mapping is rounded up to the next page boundary
+	 */
+	safe_store_mapping->mapping_size = (size_t) ( ( data_size + (size64_t) page_size - 1 ) & ~( (size64_t) page_size - 1 ) );
+
+	safe_store_mapping->page_buffer = (uint8_t *) memory_allocate(
+	                                               sizeof( uint8_t ) * safe_store_mapping->page_size );
+
+	if( safe_store_mapping->page_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create page buffer.",
+		 function );
+
+		goto on_error;
+	}
+	/* Only faults caused by user-space access need to be handled, which
+	 * allows the mapping to be used without additional privileges
+	 */
+#if defined( UFFD_USER_MODE_ONLY )
+	safe_store_mapping->userfault_file_descriptor = (int) syscall(
+	                                                       __NR_userfaultfd,
+	                                                       O_CLOEXEC | O_NONBLOCK | UFFD_USER_MODE_ONLY );
+
+	if( ( safe_store_mapping->userfault_file_descriptor == -1 )
+	 && ( errno == EINVAL ) )
+#endif
+	{
+		safe_store_mapping->userfault_file_descriptor = (int) syscall(
+		                                                       __NR_userfaultfd,
+		                                                       O_CLOEXEC | O_NONBLOCK );
+	}
+	if( safe_store_mapping->userfault_file_descriptor == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to create userfaultfd.",
+		 function );
+
+		goto on_error;
+	}
+	userfault_api.api      = UFFD_API;
+	userfault_api.features = 0;
+	userfault_api.ioctls   = 0;
+
+	if( ioctl(
+	     safe_store_mapping->userfault_file_descriptor,
+	     UFFDIO_API,
+	     &userfault_api ) == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_IOCTL_FAILED,
+		 errno,
+		 "%s: unable to negotiate userfaultfd API.",
+		 function );
+
+		goto on_error;
+	}
+	safe_store_mapping->data = (uint8_t *) mmap(
+	                                        NULL,
+	                                        safe_store_mapping->mapping_size,
+	                                        PROT_READ,
+	                                        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+	                                        -1,
+	                                        0 );
+
+	if( safe_store_mapping->data == (uint8_t *) MAP_FAILED )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 errno,
+		 "%s: unable to reserve mapping.",
+		 function );
+
+		safe_store_mapping->data = NULL;
+
+		goto on_error;
+	}
+	userfault_register.range.start = (uint64_t) (uintptr_t) safe_store_mapping->data;
+	userfault_register.range.len   = (uint64_t) safe_store_mapping->mapping_size;
+	userfault_register.mode        = UFFDIO_REGISTER_MODE_MISSING;
+	userfault_register.ioctls      = 0;
+
+	if( ioctl(
+	     safe_store_mapping->userfault_file_descriptor,
+	     UFFDIO_REGISTER,
+	     &userfault_register ) == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_IOCTL_FAILED,
+		 errno,
+		 "%s: unable to register mapping with userfaultfd.",
+		 function );
+
+		goto on_error;
+	}
+	if( pipe(
+	     safe_store_mapping->stop_file_descriptors ) == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to create stop pipe.",
+		 function );
+
+		safe_store_mapping->stop_file_descriptors[ 0 ] = -1;
+		safe_store_mapping->stop_file_descriptors[ 1 ] = -1;
+
+		goto on_error;
+	}
+	if( libcthreads_thread_create(
+	     &( safe_store_mapping->fault_handler_thread ),
+	     NULL,
+	     (int (*)(void *)) &libvshadow_store_mapping_fault_handler_thread_callback,
+	     (void *) safe_store_mapping,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create fault handler thread.",
+		 function );
+
+		goto on_error;
+	}
+	*store_mapping = safe_store_mapping;
+
+	return( 1 );
+
+on_error:
+	libvshadow_store_mapping_free(
+	 &safe_store_mapping,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Frees a store mapping
+ * The mapped data is no longer accessible after this function returns
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_mapping_free(
+     libvshadow_store_mapping_t **store_mapping,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_mapping_free";
+	uint8_t stop_value    = 0;
+	int result            = 1;
+
+	if( store_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( *store_mapping != NULL )
+	{
+		if( ( *store_mapping )->fault_handler_thread != NULL )
+		{
+			if( write(
+			     ( *store_mapping )->stop_file_descriptors[ 1 ],
+			     &stop_value,
+			     1 ) != 1 )
+			{
+				libcerror_system_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 errno,
+				 "%s: unable to signal fault handler thread to stop.",
+				 function );
+
+				result = -1;
+			}
+			if( libcthreads_thread_join(
+			     &( ( *store_mapping )->fault_handler_thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join fault handler thread.",
+				 function );
+
+				result = -1;
+			}
+		}
+		/* Unmapping the data also unregisters it from userfaultfd
+		 */
+		if( ( *store_mapping )->data != NULL )
+		{
+			if( munmap(
+			     ( *store_mapping )->data,
+			     ( *store_mapping )->mapping_size ) != 0 )
+			{
+				libcerror_system_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_GENERIC,
+				 errno,
+				 "%s: unable to unmap data.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *store_mapping )->stop_file_descriptors[ 0 ] != -1 )
+		{
+			close(
+			 ( *store_mapping )->stop_file_descriptors[ 0 ] );
+		}
+		if( ( *store_mapping )->stop_file_descriptors[ 1 ] != -1 )
+		{
+			close(
+			 ( *store_mapping )->stop_file_descriptors[ 1 ] );
+		}
+		if( ( *store_mapping )->userfault_file_descriptor != -1 )
+		{
+			close(
+			 ( *store_mapping )->userfault_file_descriptor );
+		}
+		if( ( *store_mapping )->page_buffer != NULL )
+		{
+			memory_free(
+			 ( *store_mapping )->page_buffer );
+		}
+		memory_free(
+		 *store_mapping );
+
+		*store_mapping = NULL;
+	}
+	return( result );
+}
+
+/* Resolves a page fault by populating the page at a specific offset
+ * Pages that only contain sparse data are mapped to the zero page without reading
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_mapping_resolve_page(
+     libvshadow_store_mapping_t *store_mapping,
+     off64_t page_offset,
+     libcerror_error_t **error )
+{
+	struct uffdio_copy userfault_copy;
+
+	libvshadow_internal_store_t *internal_store = NULL;
+	static char *function                       = "libvshadow_store_mapping_resolve_page";
+	size64_t source_size                        = 0;
+	size_t read_size                            = 0;
+	ssize_t read_count                          = 0;
+	off64_t source_offset                       = 0;
+	int result                                  = 1;
+	int source_store_index                      = 0;
+	int source_type                             = 0;
+
+	if( store_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( page_offset < 0 )
+	 || ( (size64_t) page_offset >= store_mapping->data_size )
+	 || ( ( (size64_t) page_offset % store_mapping->page_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid page offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_store = (libvshadow_internal_store_t *) store_mapping->internal_store;
+
+	read_size = store_mapping->page_size;
+
+	if( (size64_t) read_size > ( store_mapping->data_size - (size64_t) page_offset ) )
+	{
+		read_size = (size_t) ( store_mapping->data_size - (size64_t) page_offset );
+	}
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_store_descriptor_get_data_source_at_offset(
+	     internal_store->store_descriptor,
+	     internal_store->io_handle,
+	     internal_store->file_io_handle,
+	     page_offset,
+	     internal_store->store_descriptor_index,
+	     &source_type,
+	     &source_store_index,
+	     &source_offset,
+	     &source_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data source at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 page_offset,
+		 page_offset );
+
+		result = -1;
+	}
+	else if( ( source_type != LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE )
+	      || ( source_size < (size64_t) read_size ) )
+	{
+		read_count = libvshadow_store_descriptor_read_buffer(
+		              internal_store->store_descriptor,
+		              internal_store->io_handle,
+		              internal_store->file_io_handle,
+		              store_mapping->page_buffer,
+		              read_size,
+		              page_offset,
+		              internal_store->store_descriptor_index,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read page at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 page_offset,
+			 page_offset );
+
+			result = -1;
+		}
+		source_type = 0;
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_store->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( result != 1 )
+	{
+		return( -1 );
+	}
+	if( source_type == LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE )
+	{
+		return( libvshadow_store_mapping_zero_fill_page(
+		         store_mapping,
+		         page_offset,
+		         error ) );
+	}
+	if( read_size < store_mapping->page_size )
+	{
+		if( memory_set(
+		     &( store_mapping->page_buffer[ read_size ] ),
+		     0,
+		     store_mapping->page_size - read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear page buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	userfault_copy.dst  = (uint64_t) (uintptr_t) &( store_mapping->data[ page_offset ] );
+	userfault_copy.src  = (uint64_t) (uintptr_t) store_mapping->page_buffer;
+	userfault_copy.len  = (uint64_t) store_mapping->page_size;
+	userfault_copy.mode = 0;
+	userfault_copy.copy = 0;
+
+	/* EEXIST indicates the page was already populated by an earlier fault
+	 * and EAGAIN that the copy was interrupted by a change of the mapping
+	 */
+	while( ioctl(
+	        store_mapping->userfault_file_descriptor,
+	        UFFDIO_COPY,
+	        &userfault_copy ) == -1 )
+	{
+		if( errno == EEXIST )
+		{
+			break;
+		}
+		if( errno != EAGAIN )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_IOCTL_FAILED,
+			 errno,
+			 "%s: unable to copy page at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 page_offset,
+			 page_offset );
+
+			return( -1 );
+		}
+		userfault_copy.copy = 0;
+	}
+	return( 1 );
+}
+
+/* Resolves a page fault by mapping the page at a specific offset to the zero page
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_mapping_zero_fill_page(
+     libvshadow_store_mapping_t *store_mapping,
+     off64_t page_offset,
+     libcerror_error_t **error )
+{
+	struct uffdio_zeropage userfault_zero_page;
+
+	static char *function = "libvshadow_store_mapping_zero_fill_page";
+
+	if( store_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store mapping.",
+		 function );
+
+		return( -1 );
+	}
+	userfault_zero_page.range.start = (uint64_t) (uintptr_t) &( store_mapping->data[ page_offset ] );
+	userfault_zero_page.range.len   = (uint64_t) store_mapping->page_size;
+	userfault_zero_page.mode        = 0;
+	userfault_zero_page.zeropage    = 0;
+
+	while( ioctl(
+	        store_mapping->userfault_file_descriptor,
+	        UFFDIO_ZEROPAGE,
+	        &userfault_zero_page ) == -1 )
+	{
+		if( errno == EEXIST )
+		{
+			break;
+		}
+		if( errno != EAGAIN )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_IOCTL_FAILED,
+			 errno,
+			 "%s: unable to zero-fill page at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 page_offset,
+			 page_offset );
+
+			return( -1 );
+		}
+		userfault_zero_page.zeropage = 0;
+	}
+	return( 1 );
+}
+
+/* Unregisters the mapping from userfaultfd
+ * Threads that are blocked on a page fault are woken up and pages that were not
+ * populated are no longer handled by the fault handler thread but read as zeros
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_mapping_unregister(
+     libvshadow_store_mapping_t *store_mapping,
+     libcerror_error_t **error )
+{
+	struct uffdio_range userfault_range;
+
+	static char *function = "libvshadow_store_mapping_unregister";
+
+	if( store_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store mapping.",
+		 function );
+
+		return( -1 );
+	}
+	userfault_range.start = (uint64_t) (uintptr_t) store_mapping->data;
+	userfault_range.len   = (uint64_t) store_mapping->mapping_size;
+
+	if( ioctl(
+	     store_mapping->userfault_file_descriptor,
+	     UFFDIO_UNREGISTER,
+	     &userfault_range ) == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_IOCTL_FAILED,
+		 errno,
+		 "%s: unable to unregister mapping from userfaultfd.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of pages that could not be read and were zero-filled
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_mapping_get_number_of_read_errors(
+     libvshadow_store_mapping_t *store_mapping,
+     int *number_of_read_errors,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_store_mapping_get_number_of_read_errors";
+
+	if( store_mapping == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store mapping.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_read_errors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of read errors.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_read_errors = __atomic_load_n(
+	                          &( store_mapping->number_of_read_errors ),
+	                          __ATOMIC_RELAXED );
+
+	return( 1 );
+}
+
+/* Handles the page faults of the mapping until signalled to stop
+ * Pages that cannot be read are zero-filled so that the faulting thread does not block indefinitely
+ * and are counted as read errors
+ * If the page faults can no longer be handled the mapping is unregistered before the thread exits
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_store_mapping_fault_handler_thread_callback(
+     libvshadow_store_mapping_t *store_mapping )
+{
+	struct pollfd poll_file_descriptors[ 2 ];
+	struct uffd_msg userfault_message;
+
+	libcerror_error_t *error = NULL;
+	static char *function    = "libvshadow_store_mapping_fault_handler_thread_callback";
+	ssize_t read_count       = 0;
+	off64_t page_offset      = 0;
+	int result               = 0;
+
+	if( store_mapping == NULL )
+	{
+		return( -1 );
+	}
+	poll_file_descriptors[ 0 ].fd      = store_mapping->userfault_file_descriptor;
+	poll_file_descriptors[ 0 ].events  = POLLIN;
+	poll_file_descriptors[ 0 ].revents = 0;
+	poll_file_descriptors[ 1 ].fd      = store_mapping->stop_file_descriptors[ 0 ];
+	poll_file_descriptors[ 1 ].events  = POLLIN;
+	poll_file_descriptors[ 1 ].revents = 0;
+
+	while( 1 )
+	{
+		result = poll(
+		          poll_file_descriptors,
+		          2,
+		          -1 );
+
+		if( result == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 errno,
+			 "%s: unable to poll userfaultfd.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( poll_file_descriptors[ 1 ].revents & ( POLLIN | POLLHUP ) ) != 0 )
+		{
+			break;
+		}
+		if( ( poll_file_descriptors[ 0 ].revents & ( POLLERR | POLLHUP | POLLNVAL ) ) != 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: invalid userfaultfd.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( poll_file_descriptors[ 0 ].revents & POLLIN ) == 0 )
+		{
+			continue;
+		}
+		read_count = read(
+		              store_mapping->userfault_file_descriptor,
+		              &userfault_message,
+		              sizeof( struct uffd_msg ) );
+
+		if( read_count == -1 )
+		{
+			if( ( errno == EAGAIN )
+			 || ( errno == EINTR ) )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read userfaultfd message.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( read_count != (ssize_t) sizeof( struct uffd_msg ) )
+		 || ( userfault_message.event != UFFD_EVENT_PAGEFAULT ) )
+		{
+			continue;
+		}
+		page_offset = (off64_t) ( ( userfault_message.arg.pagefault.address - (uint64_t) (uintptr_t) store_mapping->data )
+		                        & ~( (uint64_t) store_mapping->page_size - 1 ) );
+
+		if( libvshadow_store_mapping_resolve_page(
+		     store_mapping,
+		     page_offset,
+		     &error ) != 1 )
+		{
+#if defined( HAVE_VERBOSE_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to resolve page at offset: %" PRIi64 " (0x%08" PRIx64 ") zero-filling page.\n",
+				 function,
+				 page_offset,
+				 page_offset );
+
+				libcnotify_print_error_backtrace(
+				 error );
+			}
+#endif
+			libcerror_error_free(
+			 &error );
+
+			__atomic_fetch_add(
+			 &( store_mapping->number_of_read_errors ),
+			 1,
+			 __ATOMIC_RELAXED );
+
+			if( libvshadow_store_mapping_zero_fill_page(
+			     store_mapping,
+			     page_offset,
+			     &error ) != 1 )
+			{
+				goto on_error;
+			}
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	/* The mapping is unregistered since the faults can no longer be handled
+	 * and would otherwise block the faulting threads indefinitely
+	 */
+	if( libvshadow_store_mapping_unregister(
+	     store_mapping,
+	     &error ) != 1 )
+	{
+#if defined( HAVE_VERBOSE_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT ) */
+
@@ -0,0 +1,129 @@
+/*
+ * Store memory mapping functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_STORE_MAPPING_H )
+#define _LIBVSHADOW_STORE_MAPPING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The pages of a store mapping are populated on demand by a fault handler thread
+ * hence the mapping requires userfaultfd and multi-threading support
+ */
+#if defined( HAVE_LINUX_USERFAULTFD_H ) && defined( HAVE_SYS_MMAN_H ) && defined( HAVE_SYS_IOCTL_H ) && defined( HAVE_SYS_SYSCALL_H ) && defined( HAVE_POLL_H ) && defined( HAVE_UNISTD_H ) && defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+#define HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT
+#endif
+
+#if defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT )
+
+typedef struct libvshadow_store_mapping libvshadow_store_mapping_t;
+
+struct libvshadow_store_mapping
+{
+	/* The internal store
+	 */
+	struct libvshadow_internal_store *internal_store;
+
+	/* The mapped data
+	 */
+	uint8_t *data;
+
+	/* The mapped data size
+	 */
+	size64_t data_size;
+
+	/* The size of the mapping, which is a multitude of the page size
+	 */
+	size_t mapping_size;
+
+	/* The page size
+	 */
+	size_t page_size;
+
+	/* The page buffer
+	 */
+	uint8_t *page_buffer;
+
+	/* The userfaultfd file descriptor
+	 */
+	int userfault_file_descriptor;
+
+	/* The file descriptors of the pipe used to stop the fault handler thread
+	 */
+	int stop_file_descriptors[ 2 ];
+
+	/* The fault handler thread
+	 */
+	libcthreads_thread_t *fault_handler_thread;
+
+	/* The number of pages that could not be read and were zero-filled
+	 * The value is accessed atomically
+	 */
+	int number_of_read_errors;
+};
+
+int libvshadow_store_mapping_initialize(
+     libvshadow_store_mapping_t **store_mapping,
+     struct libvshadow_internal_store *internal_store,
+     size64_t data_size,
+     libcerror_error_t **error );
+
+int libvshadow_store_mapping_free(
+     libvshadow_store_mapping_t **store_mapping,
+     libcerror_error_t **error );
+
+int libvshadow_store_mapping_resolve_page(
+     libvshadow_store_mapping_t *store_mapping,
+     off64_t page_offset,
+     libcerror_error_t **error );
+
+int libvshadow_store_mapping_zero_fill_page(
+     libvshadow_store_mapping_t *store_mapping,
+     off64_t page_offset,
+     libcerror_error_t **error );
+
+int libvshadow_store_mapping_unregister(
+     libvshadow_store_mapping_t *store_mapping,
+     libcerror_error_t **error );
+
+int libvshadow_store_mapping_get_number_of_read_errors(
+     libvshadow_store_mapping_t *store_mapping,
+     int *number_of_read_errors,
+     libcerror_error_t **error );
+
+int libvshadow_store_mapping_fault_handler_thread_callback(
+     libvshadow_store_mapping_t *store_mapping );
+
+#endif /* defined( HAVE_LIBVSHADOW_STORE_MAPPING_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_STORE_MAPPING_H ) */
+
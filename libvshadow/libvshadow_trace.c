@@ -0,0 +1,814 @@
+/*
+ * I/O trace functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include <time.h>
+
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcthreads.h"
+#include "libvshadow_trace.h"
+
+#include "vshadow_trace.h"
+
+/* The signature of the trace file
+ */
+const uint8_t vshadow_trace_signature[ 8 ] = {
+	'v', 's', 'h', 't', 'r', 'a', 'c', 'e' };
+
+/* Creates a trace
+ * Make sure the value trace is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_trace_initialize(
+     libvshadow_trace_t **trace,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_trace_initialize";
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( *trace != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid trace value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*trace = memory_allocate_structure(
+	          libvshadow_trace_t );
+
+	if( *trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create trace.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *trace,
+	     0,
+	     sizeof( libvshadow_trace_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear trace.",
+		 function );
+
+		memory_free(
+		 *trace );
+
+		*trace = NULL;
+
+		return( -1 );
+	}
+	( *trace )->records_data = (uint8_t *) memory_allocate(
+	                                        sizeof( vshadow_trace_record_t ) * LIBVSHADOW_TRACE_MAXIMUM_NUMBER_OF_BUFFERED_RECORDS );
+
+	if( ( *trace )->records_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create records data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *trace )->records_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize records mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *trace != NULL )
+	{
+		if( ( *trace )->records_data != NULL )
+		{
+			memory_free(
+			 ( *trace )->records_data );
+		}
+		memory_free(
+		 *trace );
+
+		*trace = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a trace
+ * The trace file is closed if open
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_trace_free(
+     libvshadow_trace_t **trace,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_trace_free";
+	int result            = 1;
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( *trace != NULL )
+	{
+		if( ( *trace )->file_io_handle != NULL )
+		{
+			if( libvshadow_trace_close(
+			     *trace,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close trace.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *trace )->records_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free records mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 ( *trace )->records_data );
+
+		memory_free(
+		 *trace );
+
+		*trace = NULL;
+	}
+	return( result );
+}
+
+/* Opens a trace
+ * The trace file is truncated and starts with the file header
+ * The file IO handle is not managed by the trace and is closed by libvshadow_trace_close
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_trace_open(
+     libvshadow_trace_t *trace,
+     libbfio_handle_t *file_io_handle,
+     size64_t volume_size,
+     libcerror_error_t **error )
+{
+	vshadow_trace_file_header_t file_header;
+
+	static char *function      = "libvshadow_trace_open";
+	ssize_t write_count        = 0;
+	int file_io_handle_is_open = 0;
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid trace - file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open trace file.",
+		 function );
+
+		goto on_error;
+	}
+	file_io_handle_is_open = 1;
+
+	if( memory_set(
+	     &file_header,
+	     0,
+	     sizeof( vshadow_trace_file_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_copy(
+	     file_header.signature,
+	     vshadow_trace_signature,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header.format_version,
+	 LIBVSHADOW_TRACE_FORMAT_VERSION );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header.record_size,
+	 (uint32_t) sizeof( vshadow_trace_record_t ) );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header.volume_size,
+	 volume_size );
+
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               (uint8_t *) &file_header,
+	               sizeof( vshadow_trace_file_header_t ),
+	               error );
+
+	if( write_count != (ssize_t) sizeof( vshadow_trace_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_trace_get_timestamp(
+	     &( trace->start_timestamp ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	trace->file_io_handle             = file_io_handle;
+	trace->number_of_buffered_records = 0;
+	trace->number_of_records          = 0;
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle_is_open != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes a trace
+ * The buffered records are written to the trace file before it is closed
+ * Returns 0 if successful or -1 on error
+ */
+int libvshadow_trace_close(
+     libvshadow_trace_t *trace,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_trace_close";
+	int result            = 0;
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid trace - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_trace_flush(
+	     trace,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush trace.",
+		 function );
+
+		result = -1;
+	}
+	if( libbfio_handle_close(
+	     trace->file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close trace file.",
+		 function );
+
+		result = -1;
+	}
+	trace->file_io_handle = NULL;
+
+	return( result );
+}
+
+/* Retrieves the current value of a monotonic clock
+ * The timestamp is in nanoseconds and only meaningful relative to another timestamp
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_trace_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+
+#else
+	time_t current_time   = 0;
+#endif
+
+	static char *function = "libvshadow_trace_get_timestamp";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( frequency.QuadPart <= 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	/* Split the conversion to prevent the multiplication from overflowing
+	 */
+	*timestamp = ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000000 )
+	           + ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000000 / (uint64_t) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time structure.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_structure.tv_sec * 1000000000 ) + (uint64_t) time_structure.tv_nsec;
+
+#else
+	current_time = time(
+	                NULL );
+
+	if( current_time == (time_t) -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = (uint64_t) current_time * 1000000000;
+
+#endif /* defined( WINAPI ) */
+
+	return( 1 );
+}
+
+/* Appends a record to the trace
+ * The record is buffered and the buffered records are written when the buffer is full
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_trace_append_record(
+     libvshadow_trace_t *trace,
+     uint64_t start_timestamp,
+     uint64_t end_timestamp,
+     off64_t physical_offset,
+     off64_t volume_offset,
+     size_t size,
+     int store_index,
+     int data_store_index,
+     uint8_t read_type,
+     uint8_t flags,
+     libcerror_error_t **error )
+{
+	vshadow_trace_record_t *record = NULL;
+	static char *function          = "libvshadow_trace_append_record";
+	uint64_t latency               = 0;
+	uint64_t timestamp             = 0;
+	int result                     = 1;
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid trace - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( start_timestamp > trace->start_timestamp )
+	{
+		timestamp = start_timestamp - trace->start_timestamp;
+	}
+	if( end_timestamp > start_timestamp )
+	{
+		latency = end_timestamp - start_timestamp;
+	}
+	/* The latency saturates at 4.29 seconds
+	 */
+	if( latency > (uint64_t) UINT32_MAX )
+	{
+		latency = (uint64_t) UINT32_MAX;
+	}
+	if( ( store_index < 0 )
+	 || ( store_index >= (int) LIBVSHADOW_TRACE_STORE_INDEX_NONE ) )
+	{
+		store_index = LIBVSHADOW_TRACE_STORE_INDEX_NONE;
+	}
+	if( ( data_store_index < 0 )
+	 || ( data_store_index >= (int) LIBVSHADOW_TRACE_STORE_INDEX_NONE ) )
+	{
+		data_store_index = LIBVSHADOW_TRACE_STORE_INDEX_NONE;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     trace->records_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab records mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	record = (vshadow_trace_record_t *) &( trace->records_data[ trace->number_of_buffered_records * sizeof( vshadow_trace_record_t ) ] );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 record->timestamp,
+	 timestamp );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 record->physical_offset,
+	 (uint64_t) physical_offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 record->volume_offset,
+	 (uint64_t) volume_offset );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 record->size,
+	 (uint32_t) size );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 record->latency,
+	 (uint32_t) latency );
+
+	byte_stream_copy_from_uint16_little_endian(
+	 record->store_index,
+	 (uint16_t) store_index );
+
+	byte_stream_copy_from_uint16_little_endian(
+	 record->data_store_index,
+	 (uint16_t) data_store_index );
+
+	record->read_type   = read_type;
+	record->flags       = flags;
+	record->unused[ 0 ] = 0;
+	record->unused[ 1 ] = 0;
+
+	trace->number_of_buffered_records += 1;
+
+	if( trace->number_of_buffered_records >= LIBVSHADOW_TRACE_MAXIMUM_NUMBER_OF_BUFFERED_RECORDS )
+	{
+		if( libvshadow_trace_write_records(
+		     trace,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write records.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     trace->records_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release records mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Writes the buffered records to the trace file
+ * This function does not grab the records mutex
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_trace_write_records(
+     libvshadow_trace_t *trace,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_trace_write_records";
+	size_t write_size     = 0;
+	ssize_t write_count   = 0;
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace->number_of_buffered_records == 0 )
+	{
+		return( 1 );
+	}
+	write_size = (size_t) trace->number_of_buffered_records * sizeof( vshadow_trace_record_t );
+
+	/* The buffered records are discarded even if they cannot be written
+	 * so that a failing trace file does not grow the buffer
+	 */
+	trace->number_of_buffered_records = 0;
+
+	write_count = libbfio_handle_write_buffer(
+	               trace->file_io_handle,
+	               trace->records_data,
+	               write_size,
+	               error );
+
+	if( write_count != (ssize_t) write_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write records.",
+		 function );
+
+		return( -1 );
+	}
+	trace->number_of_records += write_size / sizeof( vshadow_trace_record_t );
+
+	return( 1 );
+}
+
+/* Writes the buffered records to the trace file
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_trace_flush(
+     libvshadow_trace_t *trace,
+     libcerror_error_t **error )
+{
+	static char *function = "libvshadow_trace_flush";
+	int result            = 1;
+
+	if( trace == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     trace->records_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab records mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_trace_write_records(
+	     trace,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write records.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     trace->records_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release records mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
@@ -0,0 +1,138 @@
+/*
+ * I/O trace functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVSHADOW_TRACE_H )
+#define _LIBVSHADOW_TRACE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvshadow_libbfio.h"
+#include "libvshadow_libcerror.h"
+#include "libvshadow_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The format version of the trace file
+ */
+#define LIBVSHADOW_TRACE_FORMAT_VERSION			1
+
+/* The number of records that are buffered before they are written to the trace file
+ */
+#define LIBVSHADOW_TRACE_MAXIMUM_NUMBER_OF_BUFFERED_RECORDS	1024
+
+/* The store index that indicates the data is read from the current volume
+ */
+#define LIBVSHADOW_TRACE_STORE_INDEX_NONE			0xffff
+
+enum LIBVSHADOW_TRACE_READ_TYPES
+{
+	LIBVSHADOW_TRACE_READ_TYPE_STORE_DATA			= 1,
+	LIBVSHADOW_TRACE_READ_TYPE_STORE_METADATA		= 2
+};
+
+enum LIBVSHADOW_TRACE_RECORD_FLAGS
+{
+	LIBVSHADOW_TRACE_RECORD_FLAG_READ_FAILED		= 0x01
+};
+
+typedef struct libvshadow_trace libvshadow_trace_t;
+
+struct libvshadow_trace
+{
+	/* The trace file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The buffered records
+	 */
+	uint8_t *records_data;
+
+	/* The number of buffered records
+	 */
+	int number_of_buffered_records;
+
+	/* The number of records written to the trace file
+	 */
+	uint64_t number_of_records;
+
+	/* The timestamp of the start of the trace
+	 */
+	uint64_t start_timestamp;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	/* The records mutex
+	 */
+	libcthreads_mutex_t *records_mutex;
+#endif
+};
+
+int libvshadow_trace_initialize(
+     libvshadow_trace_t **trace,
+     libcerror_error_t **error );
+
+int libvshadow_trace_free(
+     libvshadow_trace_t **trace,
+     libcerror_error_t **error );
+
+int libvshadow_trace_open(
+     libvshadow_trace_t *trace,
+     libbfio_handle_t *file_io_handle,
+     size64_t volume_size,
+     libcerror_error_t **error );
+
+int libvshadow_trace_close(
+     libvshadow_trace_t *trace,
+     libcerror_error_t **error );
+
+int libvshadow_trace_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error );
+
+int libvshadow_trace_append_record(
+     libvshadow_trace_t *trace,
+     uint64_t start_timestamp,
+     uint64_t end_timestamp,
+     off64_t physical_offset,
+     off64_t volume_offset,
+     size_t size,
+     int store_index,
+     int data_store_index,
+     uint8_t read_type,
+     uint8_t flags,
+     libcerror_error_t **error );
+
+int libvshadow_trace_write_records(
+     libvshadow_trace_t *trace,
+     libcerror_error_t **error );
+
+int libvshadow_trace_flush(
+     libvshadow_trace_t *trace,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVSHADOW_TRACE_H ) */
+
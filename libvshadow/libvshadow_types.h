@@ -35,11 +35,15 @@
  */
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
 typedef struct libvshadow_block {}	libvshadow_block_t;
+typedef struct libvshadow_data_view {}	libvshadow_data_view_t;
+typedef struct libvshadow_scanner {}	libvshadow_scanner_t;
 typedef struct libvshadow_store {}	libvshadow_store_t;
 typedef struct libvshadow_volume {}	libvshadow_volume_t;
 
 #else
 typedef intptr_t libvshadow_block_t;
+typedef intptr_t libvshadow_data_view_t;
+typedef intptr_t libvshadow_scanner_t;
 typedef intptr_t libvshadow_store_t;
 typedef intptr_t libvshadow_volume_t;
 
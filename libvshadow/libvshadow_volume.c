@@ -25,15 +25,22 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "libvshadow_block_descriptor.h"
 #include "libvshadow_debug.h"
 #include "libvshadow_definitions.h"
+#include "libvshadow_file_mapping.h"
 #include "libvshadow_io_handle.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcnotify.h"
 #include "libvshadow_libcthreads.h"
+#include "libvshadow_metadata_loader.h"
 #include "libvshadow_ntfs_volume_header.h"
+#include "libvshadow_read_thread_pool.h"
+#include "libvshadow_reference_index.h"
+#include "libvshadow_shared_cache.h"
+#include "libvshadow_trace.h"
 #include "libvshadow_store.h"
 #include "libvshadow_store_descriptor.h"
 #include "libvshadow_volume.h"
@@ -250,6 +257,32 @@ int libvshadow_volume_free(
 
 			result = -1;
 		}
+		if( internal_volume->trace_file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( internal_volume->trace_file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free trace file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( internal_volume->shared_cache_image_identifier != NULL )
+		{
+			memory_free(
+			 internal_volume->shared_cache_image_identifier );
+		}
+		if( internal_volume->shared_cache_name != NULL )
+		{
+			memory_free(
+			 internal_volume->shared_cache_name );
+		}
 		memory_free(
 		 internal_volume );
 	}
@@ -306,8 +339,10 @@ int libvshadow_volume_open(
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle              = NULL;
+	libvshadow_file_mapping_t *file_mapping       = NULL;
 	libvshadow_internal_volume_t *internal_volume = NULL;
 	static char *function                         = "libvshadow_volume_open";
+	int result                                    = 0;
 
 	if( volume == NULL )
 	{
@@ -401,6 +436,57 @@ int libvshadow_volume_open(
 
 		goto on_error;
 	}
+	if( ( access_flags & LIBVSHADOW_ACCESS_FLAG_MEMORY_MAPPED ) != 0 )
+	{
+		if( libvshadow_file_mapping_initialize(
+		     &file_mapping,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file mapping.",
+			 function );
+
+			goto on_error;
+		}
+		result = libvshadow_file_mapping_open(
+		          file_mapping,
+		          filename,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file mapping: %s.",
+			 function,
+			 filename );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			/* The file cannot be memory mapped, fall back to the file IO handle
+			 */
+			if( libvshadow_file_mapping_free(
+			     &file_mapping,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file mapping.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
 	if( libvshadow_volume_open_file_io_handle(
 	     volume,
 	     file_io_handle,
@@ -433,6 +519,8 @@ int libvshadow_volume_open(
 	}
 #endif
 	internal_volume->file_io_handle_created_in_library = 1;
+	internal_volume->file_mapping                      = file_mapping;
+	internal_volume->io_handle->file_mapping           = file_mapping;
 
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -452,6 +540,12 @@ int libvshadow_volume_open(
 	return( 1 );
 
 on_error:
+	if( file_mapping != NULL )
+	{
+		libvshadow_file_mapping_free(
+		 &file_mapping,
+		 NULL );
+	}
 	if( file_io_handle != NULL )
 	{
 		libbfio_handle_free(
@@ -473,8 +567,10 @@ int libvshadow_volume_open_wide(
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle              = NULL;
+	libvshadow_file_mapping_t *file_mapping       = NULL;
 	libvshadow_internal_volume_t *internal_volume = NULL;
 	static char *function                         = "libvshadow_volume_open_wide";
+	int result                                    = 0;
 
 	if( volume == NULL )
 	{
@@ -568,6 +664,57 @@ int libvshadow_volume_open_wide(
 
 		goto on_error;
 	}
+	if( ( access_flags & LIBVSHADOW_ACCESS_FLAG_MEMORY_MAPPED ) != 0 )
+	{
+		if( libvshadow_file_mapping_initialize(
+		     &file_mapping,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file mapping.",
+			 function );
+
+			goto on_error;
+		}
+		result = libvshadow_file_mapping_open_wide(
+		          file_mapping,
+		          filename,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file mapping: %ls.",
+			 function,
+			 filename );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			/* The file cannot be memory mapped, fall back to the file IO handle
+			 */
+			if( libvshadow_file_mapping_free(
+			     &file_mapping,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file mapping.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
 	if( libvshadow_volume_open_file_io_handle(
 	     volume,
 	     file_io_handle,
@@ -600,6 +747,8 @@ int libvshadow_volume_open_wide(
 	}
 #endif
 	internal_volume->file_io_handle_created_in_library = 1;
+	internal_volume->file_mapping                      = file_mapping;
+	internal_volume->io_handle->file_mapping           = file_mapping;
 
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -619,6 +768,12 @@ int libvshadow_volume_open_wide(
 	return( 1 );
 
 on_error:
+	if( file_mapping != NULL )
+	{
+		libvshadow_file_mapping_free(
+		 &file_mapping,
+		 NULL );
+	}
 	if( file_io_handle != NULL )
 	{
 		libbfio_handle_free(
@@ -837,6 +992,25 @@ int libvshadow_volume_close(
 
 		return( -1 );
 	}
+	/* The read thread pool is freed first since its threads use clones
+	 * of the file IO handle
+	 */
+	if( internal_volume->read_thread_pool != NULL )
+	{
+		if( libvshadow_read_thread_pool_free(
+		     &( internal_volume->read_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
 #endif
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -921,6 +1095,160 @@ int libvshadow_volume_close(
 
 		result = -1;
 	}
+	if( internal_volume->file_mapping != NULL )
+	{
+		if( libvshadow_file_mapping_free(
+		     &( internal_volume->file_mapping ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file mapping.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->reference_index != NULL )
+	{
+		if( libvshadow_reference_index_free(
+		     &( internal_volume->reference_index ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free reference index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* The shared memory object is retained for other processes
+	 */
+	if( internal_volume->shared_cache != NULL )
+	{
+		if( libvshadow_shared_cache_free(
+		     &( internal_volume->shared_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free shared cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	/* Freeing the trace writes the buffered records and closes the trace file
+	 */
+	if( internal_volume->trace != NULL )
+	{
+		if( libvshadow_trace_free(
+		     &( internal_volume->trace ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free trace.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Refreshes the stores of a volume
+ * Stores that were added to the catalog since the volume was opened are read,
+ * the stores that were already read are retained
+ * Returns 1 if successful, 0 if the stores cannot be refreshed or -1 on error
+ * The stores cannot be refreshed if stores were removed from the catalog,
+ * in which case the volume needs to be closed and opened again
+ */
+int libvshadow_volume_refresh(
+     libvshadow_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_refresh";
+	int result                                    = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvshadow_volume_refresh_read(
+	          internal_volume,
+	          internal_volume->file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to refresh stores.",
+		 function );
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -952,6 +1280,7 @@ int libvshadow_volume_open_read(
 	static char *function                                = "libvshadow_volume_open_read";
 	off64_t catalog_offset                               = 0;
 	int number_of_store_descriptors                      = 0;
+	int result                                           = 0;
 	int store_descriptor_index                           = 0;
 
 	if( internal_volume == NULL )
@@ -1005,6 +1334,53 @@ int libvshadow_volume_open_read(
 
 		goto on_error;
 	}
+	/* The block descriptors store the offsets in the volume as 32-bit block numbers
+	 */
+	if( internal_volume->io_handle->volume_size > LIBVSHADOW_BLOCK_DESCRIPTOR_MAXIMUM_VOLUME_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported volume size: %" PRIu64 " - volumes larger than 64 TiB are not supported.",
+		 function,
+		 internal_volume->io_handle->volume_size );
+
+		goto on_error;
+	}
+	if( ( internal_volume->trace_file_io_handle != NULL )
+	 && ( internal_volume->trace == NULL ) )
+	{
+		if( libvshadow_trace_initialize(
+		     &( internal_volume->trace ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create trace.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvshadow_trace_open(
+		     internal_volume->trace,
+		     internal_volume->trace_file_io_handle,
+		     internal_volume->io_handle->volume_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open trace.",
+			 function );
+
+			goto on_error;
+		}
+		internal_volume->io_handle->trace = internal_volume->trace;
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -1135,6 +1511,7 @@ int libvshadow_volume_open_read(
 #endif
 				if( libvshadow_store_descriptor_read_store_header(
 				     store_descriptor,
+				     internal_volume->io_handle,
 				     file_io_handle,
 				     error ) != 1 )
 				{
@@ -1160,16 +1537,104 @@ int libvshadow_volume_open_read(
 			store_descriptor = NULL;
 		}
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( ( internal_volume->shared_cache_name != NULL )
+	 && ( internal_volume->shared_cache == NULL ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		if( libvshadow_shared_cache_initialize(
+		     &( internal_volume->shared_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create shared cache.",
+			 function );
+
+			goto on_error;
+		}
+		result = libvshadow_shared_cache_open(
+		          internal_volume->shared_cache,
+		          internal_volume->shared_cache_name,
+		          internal_volume->shared_cache_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open shared cache: %s.",
+			 function,
+			 internal_volume->shared_cache_name );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			/* The shared memory object cannot be used, fall back to reading without the shared cache
+			 */
+			if( libvshadow_shared_cache_free(
+			     &( internal_volume->shared_cache ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free shared cache.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			if( libvshadow_volume_set_shared_cache_image_identifier(
+			     internal_volume,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set shared cache image identifier.",
+				 function );
+
+				goto on_error;
+			}
+			internal_volume->io_handle->shared_cache = internal_volume->shared_cache;
+		}
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( ( internal_volume->number_of_read_threads > 0 )
+	 && ( internal_volume->read_thread_pool == NULL ) )
+	{
+		if( libvshadow_read_thread_pool_initialize(
+		     &( internal_volume->read_thread_pool ),
+		     internal_volume->number_of_read_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -1180,6 +1645,30 @@ int libvshadow_volume_open_read(
 on_error:
 	internal_volume->size = 0;
 
+	if( internal_volume->shared_cache != NULL )
+	{
+		internal_volume->io_handle->shared_cache = NULL;
+
+		libvshadow_shared_cache_free(
+		 &( internal_volume->shared_cache ),
+		 NULL );
+	}
+	if( internal_volume->trace != NULL )
+	{
+		internal_volume->io_handle->trace = NULL;
+
+		libvshadow_trace_free(
+		 &( internal_volume->trace ),
+		 NULL );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( internal_volume->read_thread_pool != NULL )
+	{
+		libvshadow_read_thread_pool_free(
+		 &( internal_volume->read_thread_pool ),
+		 NULL );
+	}
+#endif
 	libcdata_array_empty(
 	 internal_volume->store_descriptors_array,
 	 (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_store_descriptor_free,
@@ -1332,18 +1821,29 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the size
- * Returns 1 if successful or -1 on error
+/* Reads the stores that were added to the catalog since the volume was opened
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the stores cannot be refreshed or -1 on error
  */
-int libvshadow_volume_get_size(
-     libvshadow_volume_t *volume,
-     size64_t *size,
+int libvshadow_volume_refresh_read(
+     libvshadow_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
-	libvshadow_internal_volume_t *internal_volume = NULL;
-	static char *function                         = "libvshadow_volume_get_size";
+	libcdata_array_t *refreshed_store_descriptors_array       = NULL;
+	libvshadow_store_descriptor_t *last_store_descriptor      = NULL;
+	libvshadow_store_descriptor_t *refreshed_store_descriptor = NULL;
+	libvshadow_store_descriptor_t *store_descriptor           = NULL;
+	static char *function                                     = "libvshadow_volume_refresh_read";
+	size64_t volume_size                                      = 0;
+	off64_t catalog_offset                                    = 0;
+	int entry_index                                           = 0;
+	int number_of_refreshed_store_descriptors                 = 0;
+	int number_of_store_descriptors                           = 0;
+	int result                                                = 1;
+	int store_descriptor_index                                = 0;
 
-	if( volume == NULL )
+	if( internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1354,171 +1854,2207 @@ int libvshadow_volume_get_size(
 
 		return( -1 );
 	}
-	internal_volume = (libvshadow_internal_volume_t *) volume;
-
-	if( size == NULL )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid size.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_store_descriptors,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors from array.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	*size = internal_volume->size;
-
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
+	if( libvshadow_io_handle_read_volume_header(
+	     internal_volume->io_handle,
+	     file_io_handle,
+	     (off64_t) 0x1e00,
+	     &catalog_offset,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume header.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( 1 );
-}
-
-/* Retrieves the number of stores
- * Returns 1 if successful or -1 on error
- */
-int libvshadow_volume_get_number_of_stores(
-     libvshadow_volume_t *volume,
-     int *number_of_stores,
-     libcerror_error_t **error )
-{
-	libvshadow_internal_volume_t *internal_volume = NULL;
-	static char *function                         = "libvshadow_volume_get_number_of_stores";
-	int result                                    = 1;
-
-	if( volume == NULL )
+	if( catalog_offset == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
-		 function );
-
-		return( -1 );
+		if( number_of_store_descriptors > 0 )
+		{
+			return( 0 );
+		}
+		return( 1 );
 	}
-	internal_volume = (libvshadow_internal_volume_t *) volume;
-
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
+	if( libcdata_array_initialize(
+	     &refreshed_store_descriptors_array,
+	     0,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create refreshed store descriptors array.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	if( libcdata_array_get_number_of_entries(
-	     internal_volume->store_descriptors_array,
-	     number_of_stores,
+	if( libvshadow_io_handle_read_catalog(
+	     internal_volume->io_handle,
+	     file_io_handle,
+	     catalog_offset,
+	     &volume_size,
+	     refreshed_store_descriptors_array,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of store descriptors.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read catalog.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
+	if( libcdata_array_get_number_of_entries(
+	     refreshed_store_descriptors_array,
+	     &number_of_refreshed_store_descriptors,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of refreshed store descriptors from array.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( result );
-}
-
-/* Retrieves a specific store
- * Returns 1 if successful or -1 on error
- */
-int libvshadow_volume_get_store(
-     libvshadow_volume_t *volume,
-     int store_index,
-     libvshadow_store_t **store,
-     libcerror_error_t **error )
-{
-	libvshadow_internal_volume_t *internal_volume = NULL;
-	static char *function                         = "libvshadow_volume_get_store";
-	int result                                    = 1;
-
-	if( volume == NULL )
+	/* Stores are added to the end of the catalog, if a store that was
+	 * already read is no longer at the same index the stores cannot be refreshed
+	 */
+	if( number_of_refreshed_store_descriptors < number_of_store_descriptors )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
-		 function );
-
-		return( -1 );
+		result = 0;
 	}
-	internal_volume = (libvshadow_internal_volume_t *) volume;
-
-	if( store == NULL )
+	for( store_descriptor_index = 0;
+	     ( result == 1 ) && ( store_descriptor_index < number_of_store_descriptors );
+	     store_descriptor_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid store.",
-		 function );
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &last_store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
 
-		return( -1 );
+			goto on_error;
+		}
+		if( libcdata_array_get_entry_by_index(
+		     refreshed_store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &refreshed_store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve refreshed store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( ( last_store_descriptor == NULL )
+		 || ( refreshed_store_descriptor == NULL ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     last_store_descriptor->identifier,
+		     refreshed_store_descriptor->identifier,
+		     16 ) != 0 )
+		{
+			result = 0;
+		}
 	}
-	if( *store != NULL )
+	if( result == 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid store value already set.",
-		 function );
+		for( store_descriptor_index = number_of_store_descriptors;
+		     store_descriptor_index < number_of_refreshed_store_descriptors;
+		     store_descriptor_index++ )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     refreshed_store_descriptors_array,
+			     store_descriptor_index,
+			     (intptr_t **) &store_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve refreshed store descriptor: %d.",
+				 function,
+				 store_descriptor_index );
+
+				goto on_error;
+			}
+			if( store_descriptor == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: invalid store descriptor: %d.",
+				 function,
+				 store_descriptor_index );
+
+				goto on_error;
+			}
+			if( libcdata_array_set_entry_by_index(
+			     refreshed_store_descriptors_array,
+			     store_descriptor_index,
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set refreshed store descriptor: %d.",
+				 function,
+				 store_descriptor_index );
+
+				store_descriptor = NULL;
+
+				goto on_error;
+			}
+			store_descriptor->index = store_descriptor_index;
+
+			if( store_descriptor->has_in_volume_store_data != 0 )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "Reading VSS store: %02d:\n",
+					 store_descriptor->index );
+				}
+#endif
+				if( libvshadow_store_descriptor_read_store_header(
+				     store_descriptor,
+				     internal_volume->io_handle,
+				     file_io_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read store: %d header.",
+					 function,
+					 store_descriptor->index );
+
+					goto on_error;
+				}
+			}
+			if( libcdata_array_append_entry(
+			     internal_volume->store_descriptors_array,
+			     &entry_index,
+			     (intptr_t *) store_descriptor,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append store descriptor: %d to array.",
+				 function,
+				 store_descriptor->index );
+
+				goto on_error;
+			}
+			store_descriptor->previous_store_descriptor = last_store_descriptor;
+
+			if( last_store_descriptor != NULL )
+			{
+				if( libvshadow_store_descriptor_set_next_store_descriptor(
+				     last_store_descriptor,
+				     store_descriptor,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set next store descriptor of store: %d.",
+					 function,
+					 last_store_descriptor->index );
+
+					store_descriptor = NULL;
+
+					goto on_error;
+				}
+			}
+			last_store_descriptor = store_descriptor;
+
+			store_descriptor = NULL;
+		}
+		if( number_of_refreshed_store_descriptors > number_of_store_descriptors )
+		{
+			internal_volume->io_handle->number_of_refreshes += 1;
+
+			/* The reference index is read again when needed so that it includes the new stores
+			 */
+			if( internal_volume->reference_index != NULL )
+			{
+				if( libvshadow_reference_index_free(
+				     &( internal_volume->reference_index ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free reference index.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			/* The new stores change the identifier so that blocks cached by processes
+			 * that read the volume before it was changed are no longer used
+			 */
+			if( internal_volume->shared_cache != NULL )
+			{
+				if( libvshadow_volume_set_shared_cache_image_identifier(
+				     internal_volume,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set shared cache image identifier.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		if( internal_volume->size == 0 )
+		{
+			internal_volume->size = volume_size;
+		}
+	}
+	if( libcdata_array_free(
+	     &refreshed_store_descriptors_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_store_descriptor_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free refreshed store descriptors array.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( store_descriptor != NULL )
+	{
+		libvshadow_store_descriptor_free(
+		 &store_descriptor,
+		 NULL );
+	}
+	if( refreshed_store_descriptors_array != NULL )
+	{
+		libcdata_array_free(
+		 &refreshed_store_descriptors_array,
+		 (int (*)(intptr_t **, libcerror_error_t **)) &libvshadow_store_descriptor_free,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the image identifier of the shared cache
+ * The identifier is a hash of the caller supplied image identifier, the volume size
+ * and the catalog entries of the stores. The catalog entries are the same in copies
+ * of a volume, hence the caller supplied image identifier distinguishes the images
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_set_shared_cache_image_identifier(
+     libvshadow_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_volume_set_shared_cache_image_identifier";
+	uint64_t image_identifier                       = LIBVSHADOW_SHARED_CACHE_HASH_INITIAL_VALUE;
+	int number_of_store_descriptors                 = 0;
+	int store_descriptor_index                      = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->shared_cache_image_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing shared cache image identifier.",
+		 function );
+
+		return( -1 );
+	}
+	image_identifier = libvshadow_shared_cache_hash(
+	                    image_identifier,
+	                    internal_volume->shared_cache_image_identifier,
+	                    internal_volume->shared_cache_image_identifier_size );
+
+	image_identifier = libvshadow_shared_cache_hash(
+	                    image_identifier,
+	                    (uint8_t *) &( internal_volume->io_handle->volume_size ),
+	                    sizeof( size64_t ) );
+
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors from array.",
+		 function );
+
+		return( -1 );
+	}
+	for( store_descriptor_index = 0;
+	     store_descriptor_index < number_of_store_descriptors;
+	     store_descriptor_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			return( -1 );
+		}
+		if( store_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			return( -1 );
+		}
+		image_identifier = libvshadow_shared_cache_hash(
+		                    image_identifier,
+		                    store_descriptor->identifier,
+		                    16 );
+
+		image_identifier = libvshadow_shared_cache_hash(
+		                    image_identifier,
+		                    (uint8_t *) &( store_descriptor->creation_time ),
+		                    sizeof( uint64_t ) );
+
+		image_identifier = libvshadow_shared_cache_hash(
+		                    image_identifier,
+		                    (uint8_t *) &( store_descriptor->store_header_offset ),
+		                    sizeof( off64_t ) );
+
+		image_identifier = libvshadow_shared_cache_hash(
+		                    image_identifier,
+		                    (uint8_t *) &( store_descriptor->store_block_list_offset ),
+		                    sizeof( off64_t ) );
+
+		image_identifier = libvshadow_shared_cache_hash(
+		                    image_identifier,
+		                    (uint8_t *) &( store_descriptor->store_block_range_list_offset ),
+		                    sizeof( off64_t ) );
+
+		image_identifier = libvshadow_shared_cache_hash(
+		                    image_identifier,
+		                    (uint8_t *) &( store_descriptor->store_bitmap_offset ),
+		                    sizeof( off64_t ) );
+	}
+	/* An identifier of 0 disables the shared cache
+	 */
+	if( image_identifier == 0 )
+	{
+		image_identifier = 1;
+	}
+	if( libvshadow_shared_cache_set_image_identifier(
+	     internal_volume->shared_cache,
+	     image_identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set image identifier.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the size
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_size(
+     libvshadow_volume_t *volume,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*size = internal_volume->size;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the number of stores
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_number_of_stores(
+     libvshadow_volume_t *volume,
+     int *number_of_stores,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_number_of_stores";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific store
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_store(
+     libvshadow_volume_t *volume,
+     int store_index,
+     libvshadow_store_t **store,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_store";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store.",
+		 function );
+
+		return( -1 );
+	}
+	if( *store != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid store value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_store_initialize(
+	     store,
+	     internal_volume->io_handle,
+	     internal_volume->file_io_handle,
+	     internal_volume,
+	     store_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create store: %d.",
+		 function,
+		 store_index );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific store identifier
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_store_identifier(
+     libvshadow_volume_t *volume,
+     int store_index,
+     uint8_t *guid,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume   = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_volume_get_store_identifier";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libcdata_array_get_entry_by_index(
+	     internal_volume->store_descriptors_array,
+	     store_index,
+	     (intptr_t **) &store_descriptor,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store descriptor: %d.",
+		 function,
+		 store_index );
+
+		goto on_error;
+	}
+	if( libvshadow_store_descriptor_get_identifier(
+	     store_descriptor,
+	     guid,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve identifier from store descriptor: %d.",
+		 function,
+		 store_index );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+
+/* Sets the maximum size of the block metadata of the stores kept in memory
+ * A value of 0 represents no maximum, which is the default
+ * When the maximum is exceeded the block metadata of the least recently used
+ * stores is freed, it is read again from the volume when needed
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_set_metadata_memory_limit(
+     libvshadow_volume_t *volume,
+     size64_t metadata_memory_limit,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_set_metadata_memory_limit";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_io_handle_set_metadata_memory_limit(
+	     internal_volume->io_handle,
+	     metadata_memory_limit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set metadata memory limit in IO handle.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the (estimated) size of the block metadata of the stores kept in memory
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_metadata_memory_size(
+     libvshadow_volume_t *volume,
+     size64_t *metadata_memory_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_metadata_memory_size";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_io_handle_get_metadata_memory_size(
+	     internal_volume->io_handle,
+	     metadata_memory_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve metadata memory size from IO handle.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of times the block metadata of a store was evicted from memory
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_get_number_of_metadata_evictions(
+     libvshadow_volume_t *volume,
+     uint64_t *number_of_metadata_evictions,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_number_of_metadata_evictions";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_io_handle_get_number_of_metadata_evictions(
+	     internal_volume->io_handle,
+	     number_of_metadata_evictions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of metadata evictions from IO handle.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads the block metadata of all stores
+ * The store blocks of all stores are read in order of their offset, which
+ * is considerably faster than reading the block metadata of each store when
+ * it is first needed if the volume is stored on rotating media
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_read_metadata(
+     libvshadow_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_read_metadata";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvshadow_volume_read_store_metadata(
+	     internal_volume,
+	     internal_volume->file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read store metadata.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads the block metadata of the stores that was not read before
+ * The block metadata of the stores is kept in use while it is read, so it is
+ * not evicted before all the stores were read
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_read_store_metadata(
+     libvshadow_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libvshadow_metadata_loader_t *metadata_loader   = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_volume_read_store_metadata";
+	int number_of_grabbed_store_descriptors         = 0;
+	int number_of_store_descriptors                 = 0;
+	int result                                      = 1;
+	int store_descriptor_index                      = 0;
+
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	int number_of_locked_store_descriptors          = 0;
+#endif
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors from array.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_store_descriptors == 0 )
+	{
+		return( 1 );
+	}
+	if( libvshadow_metadata_loader_initialize(
+	     &metadata_loader,
+	     internal_volume->io_handle,
+	     file_io_handle,
+	     number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create metadata loader.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_descriptor_index = 0;
+	     store_descriptor_index < number_of_store_descriptors;
+	     store_descriptor_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( libvshadow_io_handle_grab_store_metadata(
+		     internal_volume->io_handle,
+		     store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab metadata of store: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		number_of_grabbed_store_descriptors++;
+	}
+	/* The store descriptors are locked in order of their index, which is
+	 * the same order as in which the store descriptors are locked when
+	 * reading data that is stored in the next store
+	 */
+	for( store_descriptor_index = 0;
+	     store_descriptor_index < number_of_store_descriptors;
+	     store_descriptor_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     store_descriptor->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing of store: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		number_of_locked_store_descriptors++;
+#endif
+		if( libvshadow_metadata_loader_add_store(
+		     metadata_loader,
+		     store_descriptor,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add store: %d to metadata loader.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+	}
+	if( libvshadow_metadata_loader_read(
+	     metadata_loader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read store metadata.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_metadata_loader_free(
+	     &metadata_loader,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free metadata loader.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_descriptor_index = number_of_store_descriptors - 1;
+	     store_descriptor_index >= 0;
+	     store_descriptor_index-- )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+		number_of_locked_store_descriptors--;
+
+		if( libcthreads_read_write_lock_release_for_write(
+		     store_descriptor->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing of store: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+#endif
+		if( libvshadow_io_handle_add_store_metadata(
+		     internal_volume->io_handle,
+		     store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to add metadata of store: %d.",
+			 function,
+			 store_descriptor_index );
+
+			result = -1;
+		}
+		number_of_grabbed_store_descriptors--;
+
+		if( libvshadow_io_handle_release_store_metadata(
+		     internal_volume->io_handle,
+		     store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release metadata of store: %d.",
+			 function,
+			 store_descriptor_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+
+on_error:
+	/* The metadata loader is freed while the store descriptors are still locked
+	 * since it frees the block descriptors that were partially read
+	 */
+	if( metadata_loader != NULL )
+	{
+		libvshadow_metadata_loader_free(
+		 &metadata_loader,
+		 NULL );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	for( store_descriptor_index = number_of_locked_store_descriptors - 1;
+	     store_descriptor_index >= 0;
+	     store_descriptor_index-- )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     NULL ) == 1 )
+		{
+			libcthreads_read_write_lock_release_for_write(
+			 store_descriptor->read_write_lock,
+			 NULL );
+		}
+	}
+#endif
+	for( store_descriptor_index = number_of_grabbed_store_descriptors - 1;
+	     store_descriptor_index >= 0;
+	     store_descriptor_index-- )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     NULL ) == 1 )
+		{
+			libvshadow_io_handle_release_store_metadata(
+			 internal_volume->io_handle,
+			 store_descriptor,
+			 NULL );
+		}
+	}
+	return( -1 );
+}
+
+/* Retrieves the references of the stores to the store block at a specific physical offset
+ * The physical offset is relative to the start of the volume and points into the store area
+ * For every store that contains the data of the store block, the store index is stored
+ * in store_indexes and the corresponding offset in the volume in volume_offsets
+ * number_of_references contains the number of references, of which at most
+ * maximum_number_of_references are stored
+ * The references are determined using an index of the block descriptors of all stores,
+ * which is read when this function is first called
+ * Returns 1 if successful, 0 if no store references the physical offset or -1 on error
+ */
+int libvshadow_volume_get_references_at_physical_offset(
+     libvshadow_volume_t *volume,
+     off64_t physical_offset,
+     int *store_indexes,
+     off64_t *volume_offsets,
+     int maximum_number_of_references,
+     int *number_of_references,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	libvshadow_reference_t *reference             = NULL;
+	static char *function                         = "libvshadow_volume_get_references_at_physical_offset";
+	int first_reference_index                     = 0;
+	int reference_index                           = 0;
+	int result                                    = 0;
+	int safe_number_of_references                 = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( physical_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid physical offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_references < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid maximum number of references value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_references > 0 )
+	{
+		if( store_indexes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid store indexes.",
+			 function );
+
+			return( -1 );
+		}
+		if( volume_offsets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid volume offsets.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( number_of_references == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of references.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	/* The write lock is grabbed since the reference index can be read by this function
+	 */
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = 1;
+
+	if( internal_volume->reference_index == NULL )
+	{
+		if( libvshadow_volume_read_reference_index(
+		     internal_volume,
+		     internal_volume->file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read reference index.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		result = libvshadow_reference_index_get_references_at_offset(
+		          internal_volume->reference_index,
+		          physical_offset,
+		          &first_reference_index,
+		          &safe_number_of_references,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve references at physical offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 physical_offset,
+			 physical_offset );
+		}
+		else if( result != 0 )
+		{
+			for( reference_index = 0;
+			     ( reference_index < safe_number_of_references ) && ( reference_index < maximum_number_of_references );
+			     reference_index++ )
+			{
+				reference = &( internal_volume->reference_index->references[ first_reference_index + reference_index ] );
+
+				store_indexes[ reference_index ]  = reference->store_index;
+				volume_offsets[ reference_index ] = ( (off64_t) reference->original_block_number << LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT )
+				                                  | ( physical_offset & ( LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_SIZE - 1 ) );
+			}
+		}
+		*number_of_references = safe_number_of_references;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads the reference index from the block descriptors of all stores
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_read_reference_index(
+     libvshadow_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libvshadow_reference_index_t *reference_index   = NULL;
+	libvshadow_store_descriptor_t *store_descriptor = NULL;
+	static char *function                           = "libvshadow_volume_read_reference_index";
+	int number_of_store_descriptors                 = 0;
+	int store_descriptor_index                      = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->reference_index != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - reference index value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     internal_volume->store_descriptors_array,
+	     &number_of_store_descriptors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of store descriptors from array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_reference_index_initialize(
+	     &reference_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create reference index.",
+		 function );
+
+		goto on_error;
+	}
+	for( store_descriptor_index = 0;
+	     store_descriptor_index < number_of_store_descriptors;
+	     store_descriptor_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     internal_volume->store_descriptors_array,
+		     store_descriptor_index,
+		     (intptr_t **) &store_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store descriptor: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+		if( libvshadow_reference_index_read_store_descriptor(
+		     reference_index,
+		     store_descriptor,
+		     internal_volume->io_handle,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read references of store: %d.",
+			 function,
+			 store_descriptor_index );
+
+			goto on_error;
+		}
+	}
+	if( libvshadow_reference_index_sort(
+	     reference_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to sort reference index.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->reference_index = reference_index;
+
+	return( 1 );
+
+on_error:
+	if( reference_index != NULL )
+	{
+		libvshadow_reference_index_free(
+		 &reference_index,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the number of threads used to read large store buffers in parallel
+ * A value of 0 disables reading in parallel, which is the default
+ * The number of read threads can only be set when the volume is not open
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_set_number_of_read_threads(
+     libvshadow_volume_t *volume,
+     int number_of_read_threads,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_set_number_of_read_threads";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( number_of_read_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of read threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( number_of_read_threads > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of read threads - multi-threading support is not available.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		internal_volume->number_of_read_threads = number_of_read_threads;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the shared block cache
+ * The blocks of the volume are cached in a POSIX shared memory object with the name,
+ * which must start with a / and cannot contain other / characters
+ * The image identifier must uniquely identify the content of the image, for example
+ * the device and inode number, size and modification time of the image file
+ * Processes that use the same name and image identifier share the cached blocks
+ * The size is used when the shared memory object is created, otherwise the existing object is used
+ * The shared memory object is not removed when the volume is closed
+ * Only use the shared cache for images that are not modified, the cached blocks of
+ * the volume are not invalidated, and note that memory mapped volumes do not use it
+ * A name of NULL disables the shared cache, which is the default
+ * The shared cache can only be set when the volume is not open
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_set_shared_cache(
+     libvshadow_volume_t *volume,
+     const char *name,
+     size64_t size,
+     const uint8_t *image_identifier,
+     size_t image_identifier_size,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	char *shared_cache_name                       = NULL;
+	uint8_t *shared_cache_image_identifier        = NULL;
+	static char *function                         = "libvshadow_volume_set_shared_cache";
+	int result                                    = 1;
+
+#if defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT )
+	size_t name_length                            = 0;
+#endif
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( name != NULL )
+	{
+#if !defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported name - shared cache support is not available.",
+		 function );
+
+		return( -1 );
+#else
+		if( libvshadow_shared_cache_check_name(
+		     name,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported name.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( size == 0 )
+		 || ( size > (size64_t) SSIZE_MAX ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( image_identifier == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid image identifier.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( image_identifier_size == 0 )
+		 || ( image_identifier_size > LIBVSHADOW_SHARED_CACHE_MAXIMUM_IMAGE_IDENTIFIER_SIZE ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid image identifier size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		shared_cache_image_identifier = (uint8_t *) memory_allocate(
+		                                             sizeof( uint8_t ) * image_identifier_size );
+
+		if( shared_cache_image_identifier == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shared cache image identifier.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_copy(
+		     shared_cache_image_identifier,
+		     image_identifier,
+		     image_identifier_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy shared cache image identifier.",
+			 function );
+
+			memory_free(
+			 shared_cache_image_identifier );
+
+			return( -1 );
+		}
+		name_length = narrow_string_length(
+		               name );
+
+		shared_cache_name = narrow_string_allocate(
+		                     name_length + 1 );
+
+		if( shared_cache_name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shared cache name.",
+			 function );
+
+			memory_free(
+			 shared_cache_image_identifier );
+
+			return( -1 );
+		}
+		if( narrow_string_copy(
+		     shared_cache_name,
+		     name,
+		     name_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy shared cache name.",
+			 function );
+
+			memory_free(
+			 shared_cache_name );
+			memory_free(
+			 shared_cache_image_identifier );
+
+			return( -1 );
+		}
+		shared_cache_name[ name_length ] = 0;
+#endif /* !defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT ) */
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		if( shared_cache_name != NULL )
+		{
+			memory_free(
+			 shared_cache_name );
+		}
+		if( shared_cache_image_identifier != NULL )
+		{
+			memory_free(
+			 shared_cache_image_identifier );
+		}
+		return( -1 );
+	}
+#endif
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		if( shared_cache_name != NULL )
+		{
+			memory_free(
+			 shared_cache_name );
+		}
+		if( shared_cache_image_identifier != NULL )
+		{
+			memory_free(
+			 shared_cache_image_identifier );
+		}
+		result = -1;
+	}
+	else
+	{
+		if( internal_volume->shared_cache_name != NULL )
+		{
+			memory_free(
+			 internal_volume->shared_cache_name );
+		}
+		if( internal_volume->shared_cache_image_identifier != NULL )
+		{
+			memory_free(
+			 internal_volume->shared_cache_image_identifier );
+		}
+		internal_volume->shared_cache_name                  = shared_cache_name;
+		internal_volume->shared_cache_size                  = size;
+		internal_volume->shared_cache_image_identifier      = shared_cache_image_identifier;
+		internal_volume->shared_cache_image_identifier_size = image_identifier_size;
+	}
+#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of blocks that were and were not found in the shared cache
+ * The numbers only cover the reads of this process since the volume was opened
+ * Returns 1 if successful, 0 if the volume does not use a shared cache or -1 on error
+ */
+int libvshadow_volume_get_shared_cache_statistics(
+     libvshadow_volume_t *volume,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error )
+{
+	libvshadow_internal_volume_t *internal_volume = NULL;
+	static char *function                         = "libvshadow_volume_get_shared_cache_statistics";
+	int result                                    = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libvshadow_internal_volume_t *) volume;
+
+	if( number_of_hits == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of hits.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_misses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of misses.",
+		 function );
 
 		return( -1 );
 	}
@@ -1537,23 +4073,25 @@ int libvshadow_volume_get_store(
 		return( -1 );
 	}
 #endif
-	if( libvshadow_store_initialize(
-	     store,
-	     internal_volume->io_handle,
-	     internal_volume->file_io_handle,
-	     internal_volume,
-	     store_index,
-	     error ) != 1 )
+	if( internal_volume->shared_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create store: %d.",
-		 function,
-		 store_index );
+		result = libvshadow_shared_cache_get_statistics(
+		          internal_volume->shared_cache,
+		          number_of_hits,
+		          number_of_misses,
+		          error );
 
-		result = -1;
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve shared cache statistics.",
+			 function );
+
+			result = -1;
+		}
 	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -1573,19 +4111,22 @@ int libvshadow_volume_get_store(
 	return( result );
 }
 
-/* Retrieves a specific store identifier
+
+/* Sets the trace file
+ * When set, every read of store data and store metadata from the volume is recorded
+ * in the trace file, which is created or truncated when the volume is opened
+ * A filename of NULL disables tracing, which is the default
+ * The trace file can only be set when the volume is not open
  * Returns 1 if successful or -1 on error
  */
-int libvshadow_volume_get_store_identifier(
+int libvshadow_volume_set_trace_file(
      libvshadow_volume_t *volume,
-     int store_index,
-     uint8_t *guid,
-     size_t size,
+     const char *filename,
      libcerror_error_t **error )
 {
-	libvshadow_internal_volume_t *internal_volume   = NULL;
-	libvshadow_store_descriptor_t *store_descriptor = NULL;
-	static char *function                           = "libvshadow_volume_get_store_identifier";
+	libbfio_handle_t *trace_file_io_handle = NULL;
+	static char *function                  = "libvshadow_volume_set_trace_file";
+	size_t filename_length                 = 0;
 
 	if( volume == NULL )
 	{
@@ -1598,57 +4139,205 @@ int libvshadow_volume_get_store_identifier(
 
 		return( -1 );
 	}
-	internal_volume = (libvshadow_internal_volume_t *) volume;
+	if( filename != NULL )
+	{
+		filename_length = narrow_string_length(
+		                   filename );
 
-#if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
+		if( filename_length == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid filename.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_file_initialize(
+		     &trace_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create trace file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_file_set_name(
+		     trace_file_io_handle,
+		     filename,
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in trace file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvshadow_volume_set_trace_file_io_handle(
+	     (libvshadow_internal_volume_t *) volume,
+	     trace_file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to set trace file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( trace_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &trace_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the trace file
+ * When set, every read of store data and store metadata from the volume is recorded
+ * in the trace file, which is created or truncated when the volume is opened
+ * A filename of NULL disables tracing, which is the default
+ * The trace file can only be set when the volume is not open
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_set_trace_file_wide(
+     libvshadow_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *trace_file_io_handle = NULL;
+	static char *function                  = "libvshadow_volume_set_trace_file_wide";
+	size_t filename_length                 = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libcdata_array_get_entry_by_index(
-	     internal_volume->store_descriptors_array,
-	     store_index,
-	     (intptr_t **) &store_descriptor,
+	if( filename != NULL )
+	{
+		filename_length = wide_string_length(
+		                   filename );
+
+		if( filename_length == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid filename.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbfio_file_initialize(
+		     &trace_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create trace file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_file_set_name_wide(
+		     trace_file_io_handle,
+		     filename,
+		     filename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set filename in trace file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvshadow_volume_set_trace_file_io_handle(
+	     (libvshadow_internal_volume_t *) volume,
+	     trace_file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve store descriptor: %d.",
-		 function,
-		 store_index );
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set trace file IO handle.",
+		 function );
 
 		goto on_error;
 	}
-	if( libvshadow_store_descriptor_get_identifier(
-	     store_descriptor,
-	     guid,
-	     size,
-	     error ) != 1 )
+	return( 1 );
+
+on_error:
+	if( trace_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &trace_file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Sets the trace file IO handle
+ * The volume takes over the trace file IO handle if successful and frees the previous one
+ * Returns 1 if successful or -1 on error
+ */
+int libvshadow_volume_set_trace_file_io_handle(
+     libvshadow_internal_volume_t *internal_volume,
+     libbfio_handle_t *trace_file_io_handle,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *previous_trace_file_io_handle = NULL;
+	static char *function                           = "libvshadow_volume_set_trace_file_io_handle";
+	int result                                      = 1;
+
+	if( internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve identifier from store descriptor: %d.",
-		 function,
-		 store_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1656,20 +4345,59 @@ int libvshadow_volume_get_store_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
 
-on_error:
+		result = -1;
+	}
+	else
+	{
+		previous_trace_file_io_handle         = internal_volume->trace_file_io_handle;
+		internal_volume->trace_file_io_handle = trace_file_io_handle;
+	}
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
-	 internal_volume->read_write_lock,
-	 NULL );
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
 #endif
-	return( -1 );
+	if( previous_trace_file_io_handle != NULL )
+	{
+		if( libbfio_handle_free(
+		     &previous_trace_file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free previous trace file IO handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
 }
 
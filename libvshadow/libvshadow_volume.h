@@ -26,11 +26,16 @@
 #include <types.h>
 
 #include "libvshadow_extern.h"
+#include "libvshadow_file_mapping.h"
 #include "libvshadow_io_handle.h"
 #include "libvshadow_libbfio.h"
 #include "libvshadow_libcdata.h"
 #include "libvshadow_libcerror.h"
 #include "libvshadow_libcthreads.h"
+#include "libvshadow_read_thread_pool.h"
+#include "libvshadow_reference_index.h"
+#include "libvshadow_shared_cache.h"
+#include "libvshadow_trace.h"
 #include "libvshadow_types.h"
 
 #if defined( __cplusplus )
@@ -57,6 +62,16 @@ struct libvshadow_internal_volume
 	 */
 	libvshadow_io_handle_t *io_handle;
 
+	/* The file mapping
+	 * NULL if the volume is not memory mapped
+	 */
+	libvshadow_file_mapping_t *file_mapping;
+
+	/* The reference index
+	 * NULL if the reference index was not read
+	 */
+	libvshadow_reference_index_t *reference_index;
+
 	/* Value to indicate if the file IO handle was created inside the library
 	 */
 	uint8_t file_io_handle_created_in_library;
@@ -65,7 +80,48 @@ struct libvshadow_internal_volume
 	 */
 	uint8_t file_io_handle_opened_in_library;
 
+	/* The number of threads used to read large store buffers in parallel
+	 */
+	int number_of_read_threads;
+
+	/* The name of the shared memory object of the shared block cache
+	 * NULL if blocks are not cached in shared memory
+	 */
+	char *shared_cache_name;
+
+	/* The size of the shared memory object of the shared block cache
+	 */
+	size64_t shared_cache_size;
+
+	/* The caller supplied identifier of the image used as key of the shared block cache
+	 */
+	uint8_t *shared_cache_image_identifier;
+
+	/* The size of the caller supplied image identifier
+	 */
+	size_t shared_cache_image_identifier_size;
+
+	/* The shared block cache
+	 * NULL if the shared memory object is not mapped
+	 */
+	libvshadow_shared_cache_t *shared_cache;
+
+	/* The trace file IO handle
+	 * NULL if reads are not traced
+	 */
+	libbfio_handle_t *trace_file_io_handle;
+
+	/* The I/O trace
+	 * NULL if the trace file is not open
+	 */
+	libvshadow_trace_t *trace;
+
 #if defined( HAVE_LIBVSHADOW_MULTI_THREAD_SUPPORT )
+	/* The read thread pool
+	 * NULL if large store buffers are not read in parallel
+	 */
+	libvshadow_read_thread_pool_t *read_thread_pool;
+
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
@@ -117,6 +173,11 @@ int libvshadow_volume_close(
      libvshadow_volume_t *volume,
      libcerror_error_t **error );
 
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_refresh(
+     libvshadow_volume_t *volume,
+     libcerror_error_t **error );
+
 int libvshadow_volume_open_read(
      libvshadow_internal_volume_t *internal_volume,
      libbfio_handle_t *file_io_handle,
@@ -127,6 +188,15 @@ int libvshadow_volume_open_read_ntfs_volume_headers(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libvshadow_volume_refresh_read(
+     libvshadow_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libvshadow_volume_set_shared_cache_image_identifier(
+     libvshadow_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
 LIBVSHADOW_EXTERN \
 int libvshadow_volume_get_size(
      libvshadow_volume_t *volume,
@@ -154,6 +224,92 @@ int libvshadow_volume_get_store_identifier(
      size_t size,
      libcerror_error_t **error );
 
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_set_metadata_memory_limit(
+     libvshadow_volume_t *volume,
+     size64_t metadata_memory_limit,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_metadata_memory_size(
+     libvshadow_volume_t *volume,
+     size64_t *metadata_memory_size,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_number_of_metadata_evictions(
+     libvshadow_volume_t *volume,
+     uint64_t *number_of_metadata_evictions,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_read_metadata(
+     libvshadow_volume_t *volume,
+     libcerror_error_t **error );
+
+int libvshadow_volume_read_store_metadata(
+     libvshadow_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_references_at_physical_offset(
+     libvshadow_volume_t *volume,
+     off64_t physical_offset,
+     int *store_indexes,
+     off64_t *volume_offsets,
+     int maximum_number_of_references,
+     int *number_of_references,
+     libcerror_error_t **error );
+
+int libvshadow_volume_read_reference_index(
+     libvshadow_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_set_number_of_read_threads(
+     libvshadow_volume_t *volume,
+     int number_of_read_threads,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_set_shared_cache(
+     libvshadow_volume_t *volume,
+     const char *name,
+     size64_t size,
+     const uint8_t *image_identifier,
+     size_t image_identifier_size,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_get_shared_cache_statistics(
+     libvshadow_volume_t *volume,
+     uint64_t *number_of_hits,
+     uint64_t *number_of_misses,
+     libcerror_error_t **error );
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_set_trace_file(
+     libvshadow_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBVSHADOW_EXTERN \
+int libvshadow_volume_set_trace_file_wide(
+     libvshadow_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+int libvshadow_volume_set_trace_file_io_handle(
+     libvshadow_internal_volume_t *internal_volume,
+     libbfio_handle_t *trace_file_io_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
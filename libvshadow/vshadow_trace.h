@@ -0,0 +1,130 @@
+/*
+ * The I/O trace file definition
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _VSHADOW_TRACE_H )
+#define _VSHADOW_TRACE_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct vshadow_trace_file_header vshadow_trace_file_header_t;
+
+struct vshadow_trace_file_header
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * Contains: "vshtrace"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* The record size
+	 * Consists of 4 bytes
+	 */
+	uint8_t record_size[ 4 ];
+
+	/* The volume size
+	 * Consists of 8 bytes
+	 */
+	uint8_t volume_size[ 8 ];
+
+	/* Unused
+	 * Consists of 8 bytes
+	 */
+	uint8_t unused[ 8 ];
+};
+
+typedef struct vshadow_trace_record vshadow_trace_record_t;
+
+struct vshadow_trace_record
+{
+	/* The timestamp
+	 * Consists of 8 bytes
+	 * Contains the number of nanoseconds since the start of the trace
+	 */
+	uint8_t timestamp[ 8 ];
+
+	/* The physical offset
+	 * Consists of 8 bytes
+	 * Contains the offset of the read relative to the start of the volume
+	 */
+	uint8_t physical_offset[ 8 ];
+
+	/* The volume offset
+	 * Consists of 8 bytes
+	 * Contains the offset in the store that the read was resolved from
+	 */
+	uint8_t volume_offset[ 8 ];
+
+	/* The size
+	 * Consists of 4 bytes
+	 */
+	uint8_t size[ 4 ];
+
+	/* The latency
+	 * Consists of 4 bytes
+	 * Contains the number of nanoseconds the read took
+	 */
+	uint8_t latency[ 4 ];
+
+	/* The store index
+	 * Consists of 2 bytes
+	 * Contains the index of the store that was read from
+	 */
+	uint8_t store_index[ 2 ];
+
+	/* The data store index
+	 * Consists of 2 bytes
+	 * Contains the index of the store that contains the data
+	 * or 0xffff if the data is read from the current volume
+	 */
+	uint8_t data_store_index[ 2 ];
+
+	/* The read type
+	 * Consists of 1 byte
+	 */
+	uint8_t read_type;
+
+	/* The flags
+	 * Consists of 1 byte
+	 */
+	uint8_t flags;
+
+	/* Unused
+	 * Consists of 2 bytes
+	 */
+	uint8_t unused[ 2 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _VSHADOW_TRACE_H ) */
+
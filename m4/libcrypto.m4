@@ -0,0 +1,160 @@
+dnl Checks for libcrypto required headers and functions
+dnl
+dnl Version: 20240513
+
+dnl Function to detect if libcrypto (openssl) EVP functions are available
+AC_DEFUN([AX_LIBCRYPTO_CHECK_EVP],
+  [AC_CHECK_HEADERS([openssl/evp.h])
+
+  AS_IF(
+    [test "x$ac_cv_header_openssl_evp_h" = xno],
+    [ac_cv_libcrypto_evp=no],
+    [ac_cv_libcrypto_evp=yes
+
+    AX_CHECK_LIB_FUNCTIONS(
+      [libcrypto],
+      [crypto],
+      [[EVP_MD_CTX_new],
+       [EVP_MD_CTX_free],
+       [EVP_DigestInit_ex],
+       [EVP_DigestUpdate],
+       [EVP_DigestFinal_ex]])
+
+    AS_IF(
+      [test "x$ac_cv_lib_crypto_EVP_MD_CTX_new" = xno],
+      [ac_cv_libcrypto_evp=no])
+    ])
+  ])
+
+dnl Function to detect if libcrypto (openssl) SHA-256 functions are available
+AC_DEFUN([AX_LIBCRYPTO_CHECK_SHA256],
+  [ac_cv_libcrypto_sha256=no
+
+  AS_IF(
+    [test "x$ac_cv_libcrypto_evp" = xyes],
+    [AC_CHECK_LIB(
+      [crypto],
+      [EVP_sha256],
+      [ac_cv_libcrypto_sha256=libcrypto_evp],
+      [ac_cv_libcrypto_sha256=no])
+    ])
+
+  AS_IF(
+    [test "x$ac_cv_libcrypto_sha256" = xlibcrypto_evp],
+    [AC_DEFINE(
+      [HAVE_EVP_SHA256],
+      [1],
+      [Define to 1 if you have the `EVP_sha256' function".])
+    ])
+  ])
+
+dnl Function to detect if libcrypto (openssl) is available
+AC_DEFUN([AX_LIBCRYPTO_CHECK_LIB],
+  [AS_IF(
+    [test "x$ac_cv_enable_shared_libs" = xno || test "x$ac_cv_with_openssl" = xno],
+    [ac_cv_libcrypto=no],
+    [ac_cv_libcrypto=check
+    dnl Check if the directory provided as parameter exists
+    dnl For both --with-openssl which returns "yes" and --with-openssl= which returns ""
+    dnl treat them as auto-detection.
+    AS_IF(
+      [test "x$ac_cv_with_openssl" != x && test "x$ac_cv_with_openssl" != xauto-detect && test "x$ac_cv_with_openssl" != xyes],
+      [AX_CHECK_LIB_DIRECTORY_EXISTS([openssl])],
+      [dnl Check for a pkg-config file
+      AS_IF(
+        [test "x$cross_compiling" != "xyes" && test "x$PKGCONFIG" != "x"],
+        [PKG_CHECK_MODULES(
+          [openssl],
+          [openssl >= 1.1.0],
+          [ac_cv_libcrypto=yes],
+          [ac_cv_libcrypto=check])
+        ])
+      AS_IF(
+        [test "x$ac_cv_libcrypto" = xyes],
+        [ac_cv_libcrypto_CPPFLAGS="$pkg_cv_openssl_CFLAGS"
+        ac_cv_libcrypto_LIBADD="$pkg_cv_openssl_LIBS"
+        ac_cv_libcrypto_evp=yes])
+      ])
+
+    AS_IF(
+      [test "x$ac_cv_libcrypto" = xcheck],
+      [dnl Check for headers
+      AX_LIBCRYPTO_CHECK_EVP
+
+      AS_IF(
+        [test "x$ac_cv_libcrypto_evp" != xyes],
+        [ac_cv_libcrypto=no],
+        [ac_cv_libcrypto=yes
+        ac_cv_libcrypto_LIBADD="-lcrypto"])
+      ])
+
+    dnl Check if libcrypto requires libdl
+    AS_IF(
+      [test "x$ac_cv_libcrypto" = xyes],
+      [AC_CHECK_LIB(
+        [dl],
+        [dlopen],
+        [LIBDL_LIBADD="-ldl"],
+        [LIBDL_LIBADD=""])
+      ])
+
+    AX_CHECK_LIB_DIRECTORY_MSG_ON_FAILURE([openssl])
+    ])
+
+  AS_IF(
+    [test "x$ac_cv_libcrypto" = xyes],
+    [AC_DEFINE(
+      [HAVE_LIBCRYPTO],
+      [1],
+      [Define to 1 if you have the 'crypto' library (-lcrypto).])
+    ])
+  ])
+
+dnl Function to detect how to enable libcrypto (openssl)
+AC_DEFUN([AX_LIBCRYPTO_CHECK_ENABLE],
+  [AX_COMMON_ARG_WITH(
+    [openssl],
+    [openssl],
+    [search for OpenSSL in includedir and libdir or in the specified DIR, or no if not to use OpenSSL],
+    [auto-detect],
+    [DIR])
+
+  dnl Check for a shared library version
+  AX_LIBCRYPTO_CHECK_LIB
+
+  AS_IF(
+    [test "x$ac_cv_libcrypto_CPPFLAGS" != "x"],
+    [AC_SUBST(
+      [LIBCRYPTO_CPPFLAGS],
+      [$ac_cv_libcrypto_CPPFLAGS])
+    ])
+  AS_IF(
+    [test "x$ac_cv_libcrypto_LIBADD" != "x"],
+    [AC_SUBST(
+      [LIBCRYPTO_LIBADD],
+      [$ac_cv_libcrypto_LIBADD])
+    ])
+  AS_IF(
+    [test "x$ac_cv_libcrypto" = xyes],
+    [AC_SUBST(
+      [LIBDL_LIBADD])
+    ])
+
+  AS_IF(
+    [test "x$ac_cv_libcrypto" = xyes],
+    [AC_SUBST(
+      [ax_libcrypto_pc_libs_private],
+      [-lcrypto])
+    ])
+
+  AS_IF(
+    [test "x$ac_cv_libcrypto" = xyes],
+    [AC_SUBST(
+      [ax_libcrypto_spec_requires],
+      [openssl])
+    AC_SUBST(
+      [ax_libcrypto_spec_build_requires],
+      [openssl-devel])
+    ])
+  ])
+
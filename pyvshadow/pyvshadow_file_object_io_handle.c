@@ -102,7 +102,8 @@ int pyvshadow_file_object_io_handle_initialize(
 
 		goto on_error;
 	}
-	( *file_object_io_handle )->file_object = file_object;
+	( *file_object_io_handle )->file_object         = file_object;
+	( *file_object_io_handle )->has_readinto_method = -1;
 
 	Py_IncRef(
 	 ( *file_object_io_handle )->file_object );
@@ -232,6 +233,11 @@ int pyvshadow_file_object_io_handle_free(
 		Py_DecRef(
 		 ( *file_object_io_handle )->file_object );
 
+		if( ( *file_object_io_handle )->read_ahead_buffer != NULL )
+		{
+			PyMem_Free(
+			 ( *file_object_io_handle )->read_ahead_buffer );
+		}
 		PyMem_Free(
 		 *file_object_io_handle );
 
@@ -366,7 +372,10 @@ int pyvshadow_file_object_io_handle_open(
 	}
 	/* No need to do anything here, because the file object is already open
 	 */
-	file_object_io_handle->access_flags = access_flags;
+	file_object_io_handle->access_flags                = access_flags;
+	file_object_io_handle->current_offset              = 0;
+	file_object_io_handle->read_ahead_buffer_offset    = 0;
+	file_object_io_handle->read_ahead_buffer_data_size = 0;
 
 	return( 1 );
 }
@@ -404,7 +413,8 @@ int pyvshadow_file_object_io_handle_close(
 	}
 	/* Do not close the file object, have Python deal with it
 	 */
-	file_object_io_handle->access_flags = 0;
+	file_object_io_handle->access_flags                = 0;
+	file_object_io_handle->read_ahead_buffer_data_size = 0;
 
 	return( 0 );
 }
@@ -613,7 +623,291 @@ on_error:
 	return( -1 );
 }
 
+#if PY_MAJOR_VERSION >= 3
+
+/* Reads a buffer from the file object using the readinto method
+ * The data is read directly into the buffer, without creating an intermediate bytes object
+ * Make sure to hold the GIL state before calling this function
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t pyvshadow_file_object_readinto_buffer(
+         PyObject *file_object,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	PyObject *memory_view      = NULL;
+	PyObject *method_name      = NULL;
+	PyObject *method_result    = NULL;
+	PyObject *release_result   = NULL;
+	static char *function      = "pyvshadow_file_object_readinto_buffer";
+	Py_ssize_t safe_read_count = 0;
+
+	if( file_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file object.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == 0 )
+	{
+		return( 0 );
+	}
+	method_name = PyUnicode_FromString(
+	               "readinto" );
+
+	PyErr_Clear();
+
+	memory_view = PyMemoryView_FromMemory(
+	               (char *) buffer,
+	               (Py_ssize_t) size,
+	               PyBUF_WRITE );
+
+	if( memory_view == NULL )
+	{
+		pyvshadow_error_fetch(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create memory view.",
+		 function );
+
+		goto on_error;
+	}
+	method_result = PyObject_CallMethodObjArgs(
+	                 file_object,
+	                 method_name,
+	                 memory_view,
+	                 NULL );
+
+	if( PyErr_Occurred() )
+	{
+		pyvshadow_error_fetch(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file object.",
+		 function );
+
+		goto on_error;
+	}
+	/* Make sure the file object cannot retain access to the buffer
+	 */
+	release_result = PyObject_CallMethod(
+	                  memory_view,
+	                  "release",
+	                  NULL );
+
+	if( release_result == NULL )
+	{
+		pyvshadow_error_fetch(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release memory view.",
+		 function );
+
+		goto on_error;
+	}
+	Py_DecRef(
+	 release_result );
+
+	if( ( method_result == NULL )
+	 || ( method_result == Py_None ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing method result.",
+		 function );
+
+		goto on_error;
+	}
+	safe_read_count = PyLong_AsSsize_t(
+	                   method_result );
+
+	if( PyErr_Occurred() )
+	{
+		pyvshadow_error_fetch(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to convert method result into read count.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( safe_read_count < 0 )
+	 || ( safe_read_count > (Py_ssize_t) size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read count value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	Py_DecRef(
+	 method_result );
+
+	Py_DecRef(
+	 memory_view );
+
+	Py_DecRef(
+	 method_name );
+
+	return( (ssize_t) safe_read_count );
+
+on_error:
+	if( method_result != NULL )
+	{
+		Py_DecRef(
+		 method_result );
+	}
+	if( memory_view != NULL )
+	{
+		Py_DecRef(
+		 memory_view );
+	}
+	if( method_name != NULL )
+	{
+		Py_DecRef(
+		 method_name );
+	}
+	return( -1 );
+}
+
+#endif /* PY_MAJOR_VERSION >= 3 */
+
+/* Reads a buffer at a specific offset from the file object
+ * Uses the readinto method if supported by the file object, otherwise the read method
+ * Make sure to hold the GIL state before calling this function
+ * Returns the number of bytes read if successful, or -1 on error
+ */
+ssize_t pyvshadow_file_object_io_handle_read_from_file_object(
+         pyvshadow_file_object_io_handle_t *file_object_io_handle,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error )
+{
+	static char *function = "pyvshadow_file_object_io_handle_read_from_file_object";
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+
+	if( file_object_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file object IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_object_io_handle->has_readinto_method == -1 )
+	{
+#if PY_MAJOR_VERSION >= 3
+		file_object_io_handle->has_readinto_method = PyObject_HasAttrString(
+		                                              file_object_io_handle->file_object,
+		                                              "readinto" );
+#else
+		file_object_io_handle->has_readinto_method = 0;
+#endif
+	}
+	/* Since clones share the file object, always seek before reading
+	 */
+	if( pyvshadow_file_object_seek_offset(
+	     file_object_io_handle->file_object,
+	     offset,
+	     SEEK_SET,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in file object.",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+#if PY_MAJOR_VERSION >= 3
+		if( file_object_io_handle->has_readinto_method != 0 )
+		{
+			read_count = pyvshadow_file_object_readinto_buffer(
+			              file_object_io_handle->file_object,
+			              &( buffer[ buffer_offset ] ),
+			              size - buffer_offset,
+			              error );
+		}
+		else
+#endif
+		{
+			read_count = pyvshadow_file_object_read_buffer(
+			              file_object_io_handle->file_object,
+			              &( buffer[ buffer_offset ] ),
+			              size - buffer_offset,
+			              error );
+		}
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read from file object.",
+			 function );
+
+			return( -1 );
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	return( (ssize_t) buffer_offset );
+}
+
 /* Reads a buffer from the file object IO handle
+ * Small reads are served from a read-ahead buffer, which only requires the GIL
+ * when the read-ahead buffer needs to be (re)filled from the file object
  * Returns the number of bytes read if successful, or -1 on error
  */
 ssize_t pyvshadow_file_object_io_handle_read(
@@ -622,9 +916,13 @@ ssize_t pyvshadow_file_object_io_handle_read(
          size_t size,
          libcerror_error_t **error )
 {
-	static char *function      = "pyvshadow_file_object_io_handle_read";
-	PyGILState_STATE gil_state = 0;
-	ssize_t read_count         = 0;
+	static char *function           = "pyvshadow_file_object_io_handle_read";
+	PyGILState_STATE gil_state      = 0;
+	size_t buffer_offset            = 0;
+	size_t read_ahead_buffer_offset = 0;
+	size_t read_size                = 0;
+	ssize_t read_count              = 0;
+	int has_gil_state               = 0;
 
 	if( file_object_io_handle == NULL )
 	{
@@ -637,34 +935,160 @@ ssize_t pyvshadow_file_object_io_handle_read(
 
 		return( -1 );
 	}
-	gil_state = PyGILState_Ensure();
+	if( file_object_io_handle->file_object == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file object IO handle - missing file object.",
+		 function );
 
-	read_count = pyvshadow_file_object_read_buffer(
-	              file_object_io_handle->file_object,
-	              buffer,
-	              size,
-	              error );
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
 
-	if( read_count == -1 )
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read from file object.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	PyGILState_Release(
-	 gil_state );
+	while( buffer_offset < size )
+	{
+		if( ( file_object_io_handle->current_offset >= file_object_io_handle->read_ahead_buffer_offset )
+		 && ( file_object_io_handle->current_offset < (off64_t) ( file_object_io_handle->read_ahead_buffer_offset + file_object_io_handle->read_ahead_buffer_data_size ) ) )
+		{
+			read_ahead_buffer_offset = (size_t) ( file_object_io_handle->current_offset - file_object_io_handle->read_ahead_buffer_offset );
+			read_size                = file_object_io_handle->read_ahead_buffer_data_size - read_ahead_buffer_offset;
+
+			if( read_size > ( size - buffer_offset ) )
+			{
+				read_size = size - buffer_offset;
+			}
+			if( memory_copy(
+			     &( buffer[ buffer_offset ] ),
+			     &( file_object_io_handle->read_ahead_buffer[ read_ahead_buffer_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data from read-ahead buffer.",
+				 function );
+
+				goto on_error;
+			}
+			buffer_offset                         += read_size;
+			file_object_io_handle->current_offset += (off64_t) read_size;
+
+			continue;
+		}
+		if( has_gil_state == 0 )
+		{
+			gil_state = PyGILState_Ensure();
 
-	return( read_count );
+			has_gil_state = 1;
+		}
+		/* Reads that are at least the size of the read-ahead buffer bypass it
+		 */
+		if( ( size - buffer_offset ) >= PYVSHADOW_FILE_OBJECT_IO_HANDLE_READ_AHEAD_BUFFER_SIZE )
+		{
+			read_count = pyvshadow_file_object_io_handle_read_from_file_object(
+			              file_object_io_handle,
+			              file_object_io_handle->current_offset,
+			              &( buffer[ buffer_offset ] ),
+			              size - buffer_offset,
+			              error );
+
+			if( read_count == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read from file object.",
+				 function );
+
+				goto on_error;
+			}
+			buffer_offset                         += (size_t) read_count;
+			file_object_io_handle->current_offset += (off64_t) read_count;
+
+			break;
+		}
+		if( file_object_io_handle->read_ahead_buffer == NULL )
+		{
+			file_object_io_handle->read_ahead_buffer = (uint8_t *) PyMem_Malloc(
+			                                                        sizeof( uint8_t ) * PYVSHADOW_FILE_OBJECT_IO_HANDLE_READ_AHEAD_BUFFER_SIZE );
+
+			if( file_object_io_handle->read_ahead_buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create read-ahead buffer.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		file_object_io_handle->read_ahead_buffer_offset    = file_object_io_handle->current_offset;
+		file_object_io_handle->read_ahead_buffer_data_size = 0;
 
-on_error:
-	PyGILState_Release(
-	 gil_state );
+		read_count = pyvshadow_file_object_io_handle_read_from_file_object(
+		              file_object_io_handle,
+		              file_object_io_handle->current_offset,
+		              file_object_io_handle->read_ahead_buffer,
+		              PYVSHADOW_FILE_OBJECT_IO_HANDLE_READ_AHEAD_BUFFER_SIZE,
+		              error );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to fill read-ahead buffer from file object.",
+			 function );
+
+			goto on_error;
+		}
+		if( read_count == 0 )
+		{
+			break;
+		}
+		file_object_io_handle->read_ahead_buffer_data_size = (size_t) read_count;
+	}
+	if( has_gil_state != 0 )
+	{
+		PyGILState_Release(
+		 gil_state );
+	}
+	return( (ssize_t) buffer_offset );
 
+on_error:
+	if( has_gil_state != 0 )
+	{
+		PyGILState_Release(
+		 gil_state );
+	}
 	return( -1 );
 }
 
@@ -1130,6 +1554,8 @@ on_error:
 }
 
 /* Seeks a certain offset within the file object IO handle
+ * Seeking relative to the start or the current offset does not call into
+ * the file object, the offset is applied on the next read instead
  * Returns the offset if the seek is successful or -1 on error
  */
 off64_t pyvshadow_file_object_io_handle_seek_offset(
@@ -1152,39 +1578,71 @@ off64_t pyvshadow_file_object_io_handle_seek_offset(
 
 		return( -1 );
 	}
-	gil_state = PyGILState_Ensure();
-
-	if( pyvshadow_file_object_seek_offset(
-	     file_object_io_handle->file_object,
-	     offset,
-	     whence,
-	     error ) != 1 )
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek in file object.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( pyvshadow_file_object_get_offset(
-	     file_object_io_handle->file_object,
-	     &offset,
-	     error ) != 1 )
+	if( whence == SEEK_CUR )
+	{
+		offset += file_object_io_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		gil_state = PyGILState_Ensure();
+
+		if( pyvshadow_file_object_seek_offset(
+		     file_object_io_handle->file_object,
+		     offset,
+		     whence,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek in file object.",
+			 function );
+
+			goto on_error;
+		}
+		if( pyvshadow_file_object_get_offset(
+		     file_object_io_handle->file_object,
+		     &offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to retrieve current offset in file object.",
+			 function );
+
+			goto on_error;
+		}
+		PyGILState_Release(
+		 gil_state );
+	}
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to retrieve current offset in file object.",
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	PyGILState_Release(
-	 gil_state );
+	file_object_io_handle->current_offset = offset;
 
 	return( offset );
 
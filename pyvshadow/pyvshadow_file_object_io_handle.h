@@ -33,6 +33,10 @@
 extern "C" {
 #endif
 
+/* The size of the read-ahead buffer, which covers multiple 16 KiB store blocks
+ */
+#define PYVSHADOW_FILE_OBJECT_IO_HANDLE_READ_AHEAD_BUFFER_SIZE	( 4 * 0x4000 )
+
 typedef struct pyvshadow_file_object_io_handle pyvshadow_file_object_io_handle_t;
 
 struct pyvshadow_file_object_io_handle
@@ -44,6 +48,27 @@ struct pyvshadow_file_object_io_handle
 	/* The access flags
 	 */
 	int access_flags;
+
+	/* The current offset
+	 */
+	off64_t current_offset;
+
+	/* Value to indicate the file object has a readinto method
+	 * -1 if not yet determined
+	 */
+	int has_readinto_method;
+
+	/* The read-ahead buffer
+	 */
+	uint8_t *read_ahead_buffer;
+
+	/* The offset of the data in the read-ahead buffer
+	 */
+	off64_t read_ahead_buffer_offset;
+
+	/* The size of the data in the read-ahead buffer
+	 */
+	size_t read_ahead_buffer_data_size;
 };
 
 int pyvshadow_file_object_io_handle_initialize(
@@ -80,6 +105,23 @@ ssize_t pyvshadow_file_object_read_buffer(
          size_t size,
          libcerror_error_t **error );
 
+#if PY_MAJOR_VERSION >= 3
+
+ssize_t pyvshadow_file_object_readinto_buffer(
+         PyObject *file_object,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
+#endif /* PY_MAJOR_VERSION >= 3 */
+
+ssize_t pyvshadow_file_object_io_handle_read_from_file_object(
+         pyvshadow_file_object_io_handle_t *file_object_io_handle,
+         off64_t offset,
+         uint8_t *buffer,
+         size_t size,
+         libcerror_error_t **error );
+
 ssize_t pyvshadow_file_object_io_handle_read(
          pyvshadow_file_object_io_handle_t *file_object_io_handle,
          uint8_t *buffer,
@@ -0,0 +1,152 @@
+#!/usr/bin/env bash
+# Mount tool benchmark script
+#
+# Compares the read throughput of vshadowmount with and without the
+# immutable data profile (-I) on a sample image.
+#
+# Usage: bench_vshadowmount.sh image [ store_number ]
+#
+# For every profile the image is mounted and the store (default 1) is read:
+# * large read: the store is read sequentially once with 1 MiB reads;
+# * repeated read: the store is closed, reopened and read again, which is
+#   served from the page cache when the kernel is allowed to keep it.
+# The page cache is dropped before every mount when run as root.
+#
+# Requires FUSE and fusermount or umount.
+#
+# Version: 20261018
+
+EXIT_SUCCESS=0;
+EXIT_FAILURE=1;
+EXIT_IGNORE=77;
+
+PROFILES=("default" "immutable");
+OPTIONS_PER_PROFILE=("" "-I");
+
+READ_BLOCK_SIZE="1M";
+
+if test $# -lt 1;
+then
+	echo "Usage: bench_vshadowmount.sh image [ store_number ]";
+
+	exit ${EXIT_FAILURE};
+fi
+IMAGE=$1;
+STORE_NUMBER=${2:-1};
+
+if ! test -f "${IMAGE}" && ! test -b "${IMAGE}";
+then
+	echo "Missing image: ${IMAGE}";
+
+	exit ${EXIT_FAILURE};
+fi
+
+TEST_EXECUTABLE="../vshadowtools/vshadowmount";
+
+if ! test -x "${TEST_EXECUTABLE}";
+then
+	TEST_EXECUTABLE=`which vshadowmount 2> /dev/null`;
+fi
+
+if ! test -x "${TEST_EXECUTABLE}";
+then
+	echo "Missing test executable: vshadowmount";
+
+	exit ${EXIT_FAILURE};
+fi
+
+if test -x "`which fusermount3 2> /dev/null`";
+then
+	UNMOUNT="fusermount3 -u";
+
+elif test -x "`which fusermount 2> /dev/null`";
+then
+	UNMOUNT="fusermount -u";
+else
+	UNMOUNT="umount";
+fi
+
+MOUNT_POINT=`mktemp -d`;
+
+# Prints the time elapsed since the start time in milliseconds
+elapsed_milliseconds()
+{
+	local START_TIME=$1;
+	local END_TIME=`date +%s%N`;
+
+	echo $(( ( ${END_TIME} - ${START_TIME} ) / 1000000 ));
+}
+
+# Reads a file and prints the elapsed time in milliseconds
+read_file()
+{
+	local INPUT_FILE=$1;
+	local START_TIME=`date +%s%N`;
+
+	dd if="${INPUT_FILE}" of=/dev/null bs=${READ_BLOCK_SIZE} 2> /dev/null;
+
+	elapsed_milliseconds ${START_TIME};
+}
+
+# Prints the throughput in MiB/s
+throughput()
+{
+	local SIZE=$1;
+	local MILLISECONDS=$2;
+
+	if test ${MILLISECONDS} -eq 0;
+	then
+		MILLISECONDS=1;
+	fi
+	echo $(( ( ${SIZE} * 1000 ) / ( ${MILLISECONDS} * 1048576 ) ));
+}
+
+RESULT=${EXIT_SUCCESS};
+
+printf "%-10s %14s %14s\n" "profile" "large (MiB/s)" "repeat (MiB/s)";
+
+for PROFILE_INDEX in ${!PROFILES[*]};
+do
+	TEST_PROFILE=${PROFILES[${PROFILE_INDEX}]};
+
+	IFS=" " read -a PROFILE_OPTIONS <<< ${OPTIONS_PER_PROFILE[${PROFILE_INDEX}]};
+
+	if test `id -u` -eq 0;
+	then
+		sync;
+		echo 3 > /proc/sys/vm/drop_caches;
+	fi
+	${TEST_EXECUTABLE} ${PROFILE_OPTIONS[@]} "${IMAGE}" "${MOUNT_POINT}" > /dev/null;
+	RESULT=$?;
+
+	if test ${RESULT} -ne ${EXIT_SUCCESS};
+	then
+		echo "Unable to mount: ${IMAGE} with profile: ${TEST_PROFILE}";
+
+		break;
+	fi
+	INPUT_FILE="${MOUNT_POINT}/vss${STORE_NUMBER}";
+
+	if ! test -f "${INPUT_FILE}";
+	then
+		echo "Missing store: ${STORE_NUMBER}";
+
+		${UNMOUNT} "${MOUNT_POINT}";
+
+		RESULT=${EXIT_IGNORE};
+
+		break;
+	fi
+	SIZE=`stat -c %s "${INPUT_FILE}"`;
+
+	LARGE_READ_TIME=$(read_file "${INPUT_FILE}");
+	REPEATED_READ_TIME=$(read_file "${INPUT_FILE}");
+
+	${UNMOUNT} "${MOUNT_POINT}";
+
+	printf "%-10s %14d %14d\n" "${TEST_PROFILE}" $(throughput ${SIZE} ${LARGE_READ_TIME}) $(throughput ${SIZE} ${REPEATED_READ_TIME});
+done
+
+rmdir "${MOUNT_POINT}";
+
+exit ${RESULT};
@@ -6,7 +6,7 @@ $ExitSuccess = 0
 $ExitFailure = 1
 $ExitIgnore = 77
 
-$LibraryTests = "block block_descriptor block_range_descriptor block_tree block_tree_node error io_handle notify store_block store_descriptor"
+$LibraryTests = "allocation_bitmap block block_descriptor block_range_descriptor block_tree block_tree_node data_view error file_mapping io_handle metadata_loader notify reference_index scanner shared_cache store_block store_descriptor trace"
 $LibraryTestsWithInput = "store support volume"
 $OptionSets = "offset"
 
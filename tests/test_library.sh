@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-LIBRARY_TESTS="block block_descriptor block_range_descriptor block_tree block_tree_node error io_handle notify store_block store_descriptor";
+LIBRARY_TESTS="allocation_bitmap block block_descriptor block_range_descriptor block_tree block_tree_node data_view error file_mapping io_handle metadata_loader notify reference_index scanner shared_cache store_block store_descriptor trace";
 LIBRARY_TESTS_WITH_INPUT="store support volume";
 OPTION_SETS=("offset");
 
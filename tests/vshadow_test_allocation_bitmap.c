@@ -0,0 +1,1204 @@
+/*
+ * Library allocation_bitmap type test program
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_allocation_bitmap.h"
+
+/* The start of a 512-byte $Bitmap MFT entry with a resident $DATA attribute
+ */
+uint8_t vshadow_test_allocation_bitmap_mft_entry_data[ 96 ] = {
+	0x46, 0x49, 0x4c, 0x45, 0x30, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x01, 0x00, 0x38, 0x00, 0x01, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0xab, 0xcd, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00,
+	0xff, 0x0f, 0x00, 0x00, 0x00, 0xf0, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00
+};
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Copies the test MFT entry data into a 512-byte buffer
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_allocation_bitmap_get_mft_entry_data(
+     uint8_t *mft_entry_data,
+     size_t mft_entry_data_size )
+{
+	if( ( mft_entry_data == NULL )
+	 || ( mft_entry_data_size != 512 ) )
+	{
+		return( 0 );
+	}
+	if( memory_set(
+	     mft_entry_data,
+	     0,
+	     mft_entry_data_size ) == NULL )
+	{
+		return( 0 );
+	}
+	if( memory_copy(
+	     mft_entry_data,
+	     vshadow_test_allocation_bitmap_mft_entry_data,
+	     96 ) == NULL )
+	{
+		return( 0 );
+	}
+	/* The fixup placeholder value
+	 */
+	mft_entry_data[ 510 ] = 0x01;
+	mft_entry_data[ 511 ] = 0x00;
+
+	return( 1 );
+}
+
+/* Tests the libvshadow_allocation_bitmap_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_allocation_bitmap_initialize(
+     void )
+{
+	libcerror_error_t *error                          = NULL;
+	libvshadow_allocation_bitmap_t *allocation_bitmap = NULL;
+	int result                                        = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests                   = 1;
+	int number_of_memset_fail_tests                   = 1;
+	int test_number                                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvshadow_allocation_bitmap_initialize(
+	          &allocation_bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_allocation_bitmap_free(
+	          &allocation_bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_allocation_bitmap_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	allocation_bitmap = (libvshadow_allocation_bitmap_t *) 0x12345678UL;
+
+	result = libvshadow_allocation_bitmap_initialize(
+	          &allocation_bitmap,
+	          &error );
+
+	allocation_bitmap = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_allocation_bitmap_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_allocation_bitmap_initialize(
+		          &allocation_bitmap,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( allocation_bitmap != NULL )
+			{
+				libvshadow_allocation_bitmap_free(
+				 &allocation_bitmap,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "allocation_bitmap",
+			 allocation_bitmap );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_allocation_bitmap_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_allocation_bitmap_initialize(
+		          &allocation_bitmap,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( allocation_bitmap != NULL )
+			{
+				libvshadow_allocation_bitmap_free(
+				 &allocation_bitmap,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "allocation_bitmap",
+			 allocation_bitmap );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_bitmap != NULL )
+	{
+		libvshadow_allocation_bitmap_free(
+		 &allocation_bitmap,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_allocation_bitmap_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_allocation_bitmap_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_allocation_bitmap_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_allocation_bitmap_apply_fixup_values function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_allocation_bitmap_apply_fixup_values(
+     void )
+{
+	uint8_t mft_entry_data[ 512 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = vshadow_test_allocation_bitmap_get_mft_entry_data(
+	          mft_entry_data,
+	          512 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_allocation_bitmap_apply_fixup_values(
+	          mft_entry_data,
+	          512,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "mft_entry_data[ 510 ]",
+	 mft_entry_data[ 510 ],
+	 0xab );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "mft_entry_data[ 511 ]",
+	 mft_entry_data[ 511 ],
+	 0xcd );
+
+	/* Test error cases
+	 */
+	result = libvshadow_allocation_bitmap_apply_fixup_values(
+	          NULL,
+	          512,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_apply_fixup_values(
+	          mft_entry_data,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_apply_fixup_values(
+	          mft_entry_data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the fixup placeholder value does not match
+	 */
+	result = libvshadow_allocation_bitmap_apply_fixup_values(
+	          mft_entry_data,
+	          512,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_allocation_bitmap_get_data_attribute function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_allocation_bitmap_get_data_attribute(
+     void )
+{
+	uint8_t mft_entry_data[ 512 ];
+
+	libcerror_error_t *error      = NULL;
+	const uint8_t *attribute_data = NULL;
+	size_t attribute_data_size    = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = vshadow_test_allocation_bitmap_get_mft_entry_data(
+	          mft_entry_data,
+	          512 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_allocation_bitmap_get_data_attribute(
+	          mft_entry_data,
+	          512,
+	          &attribute_data,
+	          &attribute_data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "attribute_data",
+	 attribute_data );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "attribute_data_size",
+	 attribute_data_size,
+	 (size_t) 32 );
+
+	/* Test an MFT entry without a $DATA attribute
+	 */
+	mft_entry_data[ 56 ] = 0xff;
+	mft_entry_data[ 57 ] = 0xff;
+	mft_entry_data[ 58 ] = 0xff;
+	mft_entry_data[ 59 ] = 0xff;
+
+	result = libvshadow_allocation_bitmap_get_data_attribute(
+	          mft_entry_data,
+	          512,
+	          &attribute_data,
+	          &attribute_data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_allocation_bitmap_get_data_attribute(
+	          NULL,
+	          512,
+	          &attribute_data,
+	          &attribute_data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_get_data_attribute(
+	          mft_entry_data,
+	          0,
+	          &attribute_data,
+	          &attribute_data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_get_data_attribute(
+	          mft_entry_data,
+	          512,
+	          NULL,
+	          &attribute_data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_get_data_attribute(
+	          mft_entry_data,
+	          512,
+	          &attribute_data,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the attribute size is out of bounds
+	 */
+	mft_entry_data[ 56 ] = 0x80;
+	mft_entry_data[ 57 ] = 0x00;
+	mft_entry_data[ 58 ] = 0x00;
+	mft_entry_data[ 59 ] = 0x00;
+	mft_entry_data[ 60 ] = 0x00;
+	mft_entry_data[ 61 ] = 0x04;
+
+	result = libvshadow_allocation_bitmap_get_data_attribute(
+	          mft_entry_data,
+	          512,
+	          &attribute_data,
+	          &attribute_data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_allocation_bitmap_read_data_attribute function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_allocation_bitmap_read_data_attribute(
+     void )
+{
+	libcerror_error_t *error                          = NULL;
+	libvshadow_allocation_bitmap_t *allocation_bitmap = NULL;
+	int result                                        = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_allocation_bitmap_initialize(
+	          &allocation_bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	allocation_bitmap->cluster_block_size       = 4096;
+	allocation_bitmap->number_of_cluster_blocks = 64;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_allocation_bitmap_read_data_attribute(
+	          allocation_bitmap,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &( vshadow_test_allocation_bitmap_mft_entry_data[ 56 ] ),
+	          32,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "allocation_bitmap->bitmap_data_size",
+	 allocation_bitmap->bitmap_data_size,
+	 (size_t) 8 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "allocation_bitmap->bitmap_data[ 1 ]",
+	 allocation_bitmap->bitmap_data[ 1 ],
+	 0x0f );
+
+	/* Test error cases
+	 */
+	result = libvshadow_allocation_bitmap_read_data_attribute(
+	          NULL,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &( vshadow_test_allocation_bitmap_mft_entry_data[ 56 ] ),
+	          32,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the bitmap data was already read
+	 */
+	result = libvshadow_allocation_bitmap_read_data_attribute(
+	          allocation_bitmap,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &( vshadow_test_allocation_bitmap_mft_entry_data[ 56 ] ),
+	          32,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_allocation_bitmap_free(
+	          &allocation_bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_bitmap != NULL )
+	{
+		libvshadow_allocation_bitmap_free(
+		 &allocation_bitmap,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_allocation_bitmap_get_range_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_allocation_bitmap_get_range_at_offset(
+     void )
+{
+	libcerror_error_t *error                          = NULL;
+	libvshadow_allocation_bitmap_t *allocation_bitmap = NULL;
+	size64_t range_size                               = 0;
+	uint8_t is_allocated                              = 0;
+	int result                                        = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_allocation_bitmap_initialize(
+	          &allocation_bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	allocation_bitmap->cluster_block_size       = 4096;
+	allocation_bitmap->number_of_cluster_blocks = 64;
+
+	result = libvshadow_allocation_bitmap_read_data_attribute(
+	          allocation_bitmap,
+	          NULL,
+	          NULL,
+	          NULL,
+	          0,
+	          &( vshadow_test_allocation_bitmap_mft_entry_data[ 56 ] ),
+	          32,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * Cluster blocks 0 to 11 and 44 to 63 are allocated
+	 */
+	result = libvshadow_allocation_bitmap_get_range_at_offset(
+	          allocation_bitmap,
+	          0,
+	          1048576,
+	          &is_allocated,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 12 * 4096 );
+
+	result = libvshadow_allocation_bitmap_get_range_at_offset(
+	          allocation_bitmap,
+	          0,
+	          4096,
+	          &is_allocated,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 4096 );
+
+	result = libvshadow_allocation_bitmap_get_range_at_offset(
+	          allocation_bitmap,
+	          ( 12 * 4096 ) + 100,
+	          1048576,
+	          &is_allocated,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) ( 44 * 4096 ) - ( ( 12 * 4096 ) + 100 ) );
+
+	result = libvshadow_allocation_bitmap_get_range_at_offset(
+	          allocation_bitmap,
+	          20 * 4096,
+	          8192,
+	          &is_allocated,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 8192 );
+
+	/* Cluster blocks beyond the bitmap are considered allocated
+	 */
+	result = libvshadow_allocation_bitmap_get_range_at_offset(
+	          allocation_bitmap,
+	          44 * 4096,
+	          1048576,
+	          &is_allocated,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 1048576 );
+
+	result = libvshadow_allocation_bitmap_get_range_at_offset(
+	          allocation_bitmap,
+	          100 * 4096,
+	          4096,
+	          &is_allocated,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "is_allocated",
+	 is_allocated,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 4096 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_allocation_bitmap_get_range_at_offset(
+	          NULL,
+	          0,
+	          4096,
+	          &is_allocated,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_get_range_at_offset(
+	          allocation_bitmap,
+	          -1,
+	          4096,
+	          &is_allocated,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_get_range_at_offset(
+	          allocation_bitmap,
+	          0,
+	          0,
+	          &is_allocated,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_get_range_at_offset(
+	          allocation_bitmap,
+	          0,
+	          4096,
+	          NULL,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_allocation_bitmap_get_range_at_offset(
+	          allocation_bitmap,
+	          0,
+	          4096,
+	          &is_allocated,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_allocation_bitmap_free(
+	          &allocation_bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_bitmap != NULL )
+	{
+		libvshadow_allocation_bitmap_free(
+		 &allocation_bitmap,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_allocation_bitmap_initialize",
+	 vshadow_test_allocation_bitmap_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_allocation_bitmap_free",
+	 vshadow_test_allocation_bitmap_free );
+
+	/* TODO: add tests for libvshadow_allocation_bitmap_read_store_data */
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_allocation_bitmap_apply_fixup_values",
+	 vshadow_test_allocation_bitmap_apply_fixup_values );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_allocation_bitmap_get_data_attribute",
+	 vshadow_test_allocation_bitmap_get_data_attribute );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_allocation_bitmap_read_data_attribute",
+	 vshadow_test_allocation_bitmap_read_data_attribute );
+
+	/* TODO: add tests for libvshadow_allocation_bitmap_read_store */
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_allocation_bitmap_get_range_at_offset",
+	 vshadow_test_allocation_bitmap_get_range_at_offset );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+}
+
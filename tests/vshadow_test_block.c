@@ -348,11 +348,12 @@ on_error:
 int vshadow_test_block_get_original_offset(
      void )
 {
-	libcerror_error_t *error                        = NULL;
-	libvshadow_block_t *block                       = NULL;
-	libvshadow_block_descriptor_t *block_descriptor = NULL;
-	off64_t original_offset                         = 0;
-	int result                                      = 0;
+	libcerror_error_t *error                                 = NULL;
+	libvshadow_block_t *block                                = NULL;
+	libvshadow_block_descriptor_t *block_descriptor          = NULL;
+	libvshadow_block_descriptor_t *internal_block_descriptor = NULL;
+	off64_t original_offset                                  = 0;
+	int result                                               = 0;
 
 	/* Initialize test
 	 */
@@ -445,6 +446,8 @@ int vshadow_test_block_get_original_offset(
 
 	/* Test error case where internal block descriptor is NULL
 	 */
+	internal_block_descriptor = ( (libvshadow_internal_block_t *) block )->block_descriptor;
+
 	( (libvshadow_internal_block_t *) block )->block_descriptor = NULL;
 
 	result = libvshadow_block_get_original_offset(
@@ -464,6 +467,8 @@ int vshadow_test_block_get_original_offset(
 	libcerror_error_free(
 	 &error );
 
+	( (libvshadow_internal_block_t *) block )->block_descriptor = internal_block_descriptor;
+
 	/* Clean up
 	 */
 	result = libvshadow_block_free(
@@ -529,11 +534,12 @@ on_error:
 int vshadow_test_block_get_relative_offset(
      void )
 {
-	libcerror_error_t *error                        = NULL;
-	libvshadow_block_t *block                       = NULL;
-	libvshadow_block_descriptor_t *block_descriptor = NULL;
-	off64_t relative_offset                         = 0;
-	int result                                      = 0;
+	libcerror_error_t *error                                 = NULL;
+	libvshadow_block_t *block                                = NULL;
+	libvshadow_block_descriptor_t *block_descriptor          = NULL;
+	libvshadow_block_descriptor_t *internal_block_descriptor = NULL;
+	off64_t relative_offset                                  = 0;
+	int result                                               = 0;
 
 	/* Initialize test
 	 */
@@ -626,6 +632,8 @@ int vshadow_test_block_get_relative_offset(
 
 	/* Test error case where internal block descriptor is NULL
 	 */
+	internal_block_descriptor = ( (libvshadow_internal_block_t *) block )->block_descriptor;
+
 	( (libvshadow_internal_block_t *) block )->block_descriptor = NULL;
 
 	result = libvshadow_block_get_relative_offset(
@@ -645,6 +653,8 @@ int vshadow_test_block_get_relative_offset(
 	libcerror_error_free(
 	 &error );
 
+	( (libvshadow_internal_block_t *) block )->block_descriptor = internal_block_descriptor;
+
 	/* Clean up
 	 */
 	result = libvshadow_block_free(
@@ -710,11 +720,12 @@ on_error:
 int vshadow_test_block_get_offset(
      void )
 {
-	libcerror_error_t *error                        = NULL;
-	libvshadow_block_t *block                       = NULL;
-	libvshadow_block_descriptor_t *block_descriptor = NULL;
-	off64_t offset                                  = 0;
-	int result                                      = 0;
+	libcerror_error_t *error                                 = NULL;
+	libvshadow_block_t *block                                = NULL;
+	libvshadow_block_descriptor_t *block_descriptor          = NULL;
+	libvshadow_block_descriptor_t *internal_block_descriptor = NULL;
+	off64_t offset                                           = 0;
+	int result                                               = 0;
 
 	/* Initialize test
 	 */
@@ -807,6 +818,8 @@ int vshadow_test_block_get_offset(
 
 	/* Test error case where internal block descriptor is NULL
 	 */
+	internal_block_descriptor = ( (libvshadow_internal_block_t *) block )->block_descriptor;
+
 	( (libvshadow_internal_block_t *) block )->block_descriptor = NULL;
 
 	result = libvshadow_block_get_offset(
@@ -826,6 +839,8 @@ int vshadow_test_block_get_offset(
 	libcerror_error_free(
 	 &error );
 
+	( (libvshadow_internal_block_t *) block )->block_descriptor = internal_block_descriptor;
+
 	/* Clean up
 	 */
 	result = libvshadow_block_free(
@@ -891,15 +906,16 @@ on_error:
 int vshadow_test_block_get_values(
      void )
 {
-	libcerror_error_t *error                        = NULL;
-	libvshadow_block_t *block                       = NULL;
-	libvshadow_block_descriptor_t *block_descriptor = NULL;
-	off64_t relative_offset                         = 0;
-	off64_t offset                                  = 0;
-	off64_t original_offset                         = 0;
-	uint32_t bitmap                                 = 0;
-	uint32_t flags                                  = 0;
-	int result                                      = 0;
+	libcerror_error_t *error                                 = NULL;
+	libvshadow_block_t *block                                = NULL;
+	libvshadow_block_descriptor_t *block_descriptor          = NULL;
+	libvshadow_block_descriptor_t *internal_block_descriptor = NULL;
+	off64_t relative_offset                                  = 0;
+	off64_t offset                                           = 0;
+	off64_t original_offset                                  = 0;
+	uint32_t bitmap                                          = 0;
+	uint32_t flags                                           = 0;
+	int result                                               = 0;
 
 	/* Initialize test
 	 */
@@ -1088,6 +1104,8 @@ int vshadow_test_block_get_values(
 
 	/* Test error case where internal block descriptor is NULL
 	 */
+	internal_block_descriptor = ( (libvshadow_internal_block_t *) block )->block_descriptor;
+
 	( (libvshadow_internal_block_t *) block )->block_descriptor = NULL;
 
 	result = libvshadow_block_get_values(
@@ -1111,6 +1129,8 @@ int vshadow_test_block_get_values(
 	libcerror_error_free(
 	 &error );
 
+	( (libvshadow_internal_block_t *) block )->block_descriptor = internal_block_descriptor;
+
 	/* Clean up
 	 */
 	result = libvshadow_block_free(
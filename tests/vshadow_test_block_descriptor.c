@@ -45,6 +45,11 @@ uint8_t vshadow_test_block_descriptor_empty_data[ 32 ] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
+uint8_t vshadow_test_block_descriptor_unaligned_data[ 32 ] = {
+	0x00, 0x82, 0xfc, 0xb7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x80, 0x2c, 0x7e, 0x03, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00
+};
+
 uint8_t vshadow_test_block_descriptor_error_data[ 32 ] = {
 	0x00, 0x80, 0xfc, 0xb7, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,
 	0x00, 0x80, 0x2c, 0x7e, 0x03, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00
@@ -276,23 +281,6 @@ int vshadow_test_block_descriptor_free(
 	 "error",
 	 error );
 
-	result = libvshadow_block_descriptor_initialize(
-	          &( block_descriptor->overlay ),
-	          &error );
-
-	VSHADOW_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
-
-	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-	 "block_descriptor->overlay",
-	 block_descriptor->overlay );
-
-	VSHADOW_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
-
 	result = libvshadow_block_descriptor_free(
 	          &block_descriptor,
 	          &error );
@@ -372,23 +360,6 @@ int vshadow_test_block_descriptor_free_reverse(
 	 "error",
 	 error );
 
-	result = libvshadow_block_descriptor_initialize(
-	          &( block_descriptor->overlay ),
-	          &error );
-
-	VSHADOW_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 1 );
-
-	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-	 "block_descriptor->overlay",
-	 block_descriptor->overlay );
-
-	VSHADOW_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
-
 	result = libvshadow_block_descriptor_free_reverse(
 	          &block_descriptor,
 	          &error );
@@ -662,8 +633,6 @@ int vshadow_test_block_descriptor_clone(
 	}
 #endif /* defined( OPTIMIZATION_DISABLED ) */
 
-/* TODO cause libvshadow_block_descriptor_clone of overlay to fail */
-
 #endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
 
 	/* Clean up
@@ -708,6 +677,314 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvshadow_block_descriptor_set_values function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_descriptor_set_values(
+     void )
+{
+	libcerror_error_t *error                        = NULL;
+	libvshadow_block_descriptor_t *block_descriptor = NULL;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_block_descriptor_initialize(
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_descriptor",
+	 block_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7fc8000,
+	          0x00048000,
+	          0x37e2c8000,
+	          0x00000002,
+	          0x0000ff00,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "original_offset",
+	 (int64_t) LIBVSHADOW_BLOCK_DESCRIPTOR_GET_ORIGINAL_OFFSET( block_descriptor ),
+	 (int64_t) 0xb7fc8000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "relative_offset",
+	 (int64_t) LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET( block_descriptor ),
+	 (int64_t) 0x00048000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) LIBVSHADOW_BLOCK_DESCRIPTOR_GET_OFFSET( block_descriptor ),
+	 (int64_t) 0x37e2c8000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "bitmap",
+	 block_descriptor->bitmap,
+	 0x0000ff00 );
+
+	/* Test relative offset that is not block aligned
+	 */
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7fc8000,
+	          0x00000001,
+	          0x37e2c8000,
+	          0x00000002,
+	          0x0000ff00,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "relative_offset",
+	 (int64_t) LIBVSHADOW_BLOCK_DESCRIPTOR_GET_RELATIVE_OFFSET( block_descriptor ),
+	 (int64_t) 0x00000001 );
+
+	/* Test flags that are not supported
+	 */
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7fc8000,
+	          0x00048000,
+	          0x37e2c8000,
+	          0x00010102,
+	          0x0000ff00,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "flags",
+	 (uint32_t) block_descriptor->flags,
+	 (uint32_t) 0x00000002 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_block_descriptor_set_values(
+	          NULL,
+	          0xb7fc8000,
+	          0x00048000,
+	          0x37e2c8000,
+	          0x00000002,
+	          0x0000ff00,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          -1,
+	          0x00048000,
+	          0x37e2c8000,
+	          0x00000002,
+	          0x0000ff00,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          LIBVSHADOW_BLOCK_DESCRIPTOR_MAXIMUM_OFFSET + 0x4000,
+	          0x00048000,
+	          0x37e2c8000,
+	          0x00000002,
+	          0x0000ff00,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7fc8000,
+	          -1,
+	          0x37e2c8000,
+	          0x00000002,
+	          0x0000ff00,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7fc8000,
+	          0x00048000,
+	          -1,
+	          0x00000002,
+	          0x0000ff00,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test original offset that is not block aligned
+	 */
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7fc8200,
+	          0x00048000,
+	          0x37e2c8000,
+	          0x00000002,
+	          0x0000ff00,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test offset that is not block aligned
+	 */
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7fc8000,
+	          0x00048000,
+	          0x37e2c8200,
+	          0x00000002,
+	          0x0000ff00,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_descriptor_free(
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_descriptor",
+	 block_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_descriptor != NULL )
+	{
+		libvshadow_block_descriptor_free(
+		 &block_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libvshadow_block_descriptor_read_data function
  * Returns 1 if successful or 0 if not
  */
@@ -773,6 +1050,25 @@ int vshadow_test_block_descriptor_read_data(
 
 	/* Test error cases
 	 */
+	result = libvshadow_block_descriptor_read_data(
+	          block_descriptor,
+	          vshadow_test_block_descriptor_unaligned_data,
+	          32,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
 	result = libvshadow_block_descriptor_read_data(
 	          NULL,
 	          vshadow_test_block_descriptor_data,
@@ -906,6 +1202,246 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvshadow_block_descriptor_get_bitmap_range_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_block_descriptor_get_bitmap_range_at_offset(
+     void )
+{
+	uint32_t bitmaps[ 5 ] = { 0x00000000UL, 0xffffffffUL, 0x0000ff00UL, 0x80000001UL, 0x5a5a0ff0UL };
+
+	libcerror_error_t *error                        = NULL;
+	libvshadow_block_descriptor_t *block_descriptor = NULL;
+	size_t expected_range_size                      = 0;
+	size_t range_size                               = 0;
+	uint32_t relative_block_offset                  = 0;
+	uint32_t sector_index                           = 0;
+	int bitmap_index                                = 0;
+	int expected_result                             = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_block_descriptor_initialize(
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "block_descriptor",
+	 block_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	block_descriptor->bitmap = 0x0000ff00UL;
+
+	result = libvshadow_block_descriptor_get_bitmap_range_at_offset(
+	          block_descriptor,
+	          0,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "range_size",
+	 range_size,
+	 (size_t) 4096 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_descriptor_get_bitmap_range_at_offset(
+	          block_descriptor,
+	          4096 + 100,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "range_size",
+	 range_size,
+	 (size_t) 3996 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_descriptor_get_bitmap_range_at_offset(
+	          block_descriptor,
+	          8192,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "range_size",
+	 range_size,
+	 (size_t) 8192 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Compare the bitmap ranges with the ranges determined bit by bit
+	 */
+	for( bitmap_index = 0;
+	     bitmap_index < 5;
+	     bitmap_index++ )
+	{
+		block_descriptor->bitmap = bitmaps[ bitmap_index ];
+
+		for( relative_block_offset = 0;
+		     relative_block_offset < 0x4000;
+		     relative_block_offset += 256 )
+		{
+			sector_index        = relative_block_offset / 512;
+			expected_result     = (int) ( ( bitmaps[ bitmap_index ] >> sector_index ) & 0x00000001UL );
+			expected_range_size = 512 - ( relative_block_offset % 512 );
+
+			for( sector_index = sector_index + 1;
+			     sector_index < 32;
+			     sector_index++ )
+			{
+				if( (int) ( ( bitmaps[ bitmap_index ] >> sector_index ) & 0x00000001UL ) != expected_result )
+				{
+					break;
+				}
+				expected_range_size += 512;
+			}
+			result = libvshadow_block_descriptor_get_bitmap_range_at_offset(
+			          block_descriptor,
+			          relative_block_offset,
+			          &range_size,
+			          &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 expected_result );
+
+			VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+			 "range_size",
+			 range_size,
+			 expected_range_size );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	/* Test error cases
+	 */
+	result = libvshadow_block_descriptor_get_bitmap_range_at_offset(
+	          NULL,
+	          0,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_get_bitmap_range_at_offset(
+	          block_descriptor,
+	          0x4000,
+	          &range_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_block_descriptor_get_bitmap_range_at_offset(
+	          block_descriptor,
+	          0,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_block_descriptor_free(
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "block_descriptor",
+	 block_descriptor );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( block_descriptor != NULL )
+	{
+		libvshadow_block_descriptor_free(
+		 &block_descriptor,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
 
 /* The main program
@@ -941,10 +1477,18 @@ int main(
 	 "libvshadow_block_descriptor_clone",
 	 vshadow_test_block_descriptor_clone );
 
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_descriptor_set_values",
+	 vshadow_test_block_descriptor_set_values );
+
 	VSHADOW_TEST_RUN(
 	 "libvshadow_block_descriptor_read_data",
 	 vshadow_test_block_descriptor_read_data );
 
+	VSHADOW_TEST_RUN(
+	 "libvshadow_block_descriptor_get_bitmap_range_at_offset",
+	 vshadow_test_block_descriptor_get_bitmap_range_at_offset );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
 
 	return( EXIT_SUCCESS );
@@ -774,11 +774,23 @@ int vshadow_test_block_tree_insert(
 
 	/* Test insert of block descriptor
 	 */
-	block_descriptor->original_offset = 0xc0008000;
-	block_descriptor->relative_offset = 0x0419c000;
-	block_descriptor->offset          = 0x38241c000;
-	block_descriptor->flags           = 0x00000000;
-	block_descriptor->bitmap          = 0x00000000;
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xc0008000,
+	          0x0419c000,
+	          0x38241c000,
+	          0x00000000,
+	          0x00000000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
@@ -798,11 +810,23 @@ int vshadow_test_block_tree_insert(
 
 	/* Test insert of block descriptor: flags 0x00000088
 	 */
-	block_descriptor->original_offset = 0xb7f20000;
-	block_descriptor->relative_offset = 0x0006c000;
-	block_descriptor->offset          = 0x37e2ec000;
-	block_descriptor->flags           = 0x00000088;
-	block_descriptor->bitmap          = 0x00000000;
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7f20000,
+	          0x0006c000,
+	          0x37e2ec000,
+	          0x00000088,
+	          0x00000000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
@@ -822,11 +846,23 @@ int vshadow_test_block_tree_insert(
 
 	/* Test insert of block descriptor: is overlay flag
 	 */
-	block_descriptor->original_offset = 0xb7f1c000;
-	block_descriptor->relative_offset = 0x0004c000;
-	block_descriptor->offset          = 0x37e2cc000;
-	block_descriptor->flags           = 0x00000002;
-	block_descriptor->bitmap          = 0xff000000;
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7f1c000,
+	          0x0004c000,
+	          0x37e2cc000,
+	          0x00000002,
+	          0xff000000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
@@ -846,11 +882,23 @@ int vshadow_test_block_tree_insert(
 
 	/* Test insert of block descriptor: is overlay flag, overlapping offset range, alternating bitmap
 	 */
-	block_descriptor->original_offset = 0xb7f1c000;
-	block_descriptor->relative_offset = 0x00000001;
-	block_descriptor->offset          = 0x37e2cc000;
-	block_descriptor->flags           = 0x00000002;
-	block_descriptor->bitmap          = 0x00ff0000;
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7f1c000,
+	          0x00000001,
+	          0x37e2cc000,
+	          0x00000002,
+	          0x00ff0000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
@@ -870,11 +918,23 @@ int vshadow_test_block_tree_insert(
 
 	/* Test insert of block descriptor: replace existing
 	 */
-	block_descriptor->original_offset = 0xb7f1c000;
-	block_descriptor->relative_offset = 0x04184000;
-	block_descriptor->offset          = 0x382404000;
-	block_descriptor->flags           = 0x00000000;
-	block_descriptor->bitmap          = 0x00000000;
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7f1c000,
+	          0x04184000,
+	          0x382404000,
+	          0x00000000,
+	          0x00000000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
@@ -894,11 +954,23 @@ int vshadow_test_block_tree_insert(
 
 	/* Test insert of block descriptor: extend existing with overlay
 	 */
-	block_descriptor->original_offset = 0xb7f20000;
-	block_descriptor->relative_offset = 0x00050000;
-	block_descriptor->offset          = 0x37e2d0000;
-	block_descriptor->flags           = 0x00000002;
-	block_descriptor->bitmap          = 0x000000ff;
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7f20000,
+	          0x00050000,
+	          0x37e2d0000,
+	          0x00000002,
+	          0x000000ff,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
@@ -918,11 +990,23 @@ int vshadow_test_block_tree_insert(
 
 	/* Test insert of block descriptor: extend existing with overlay
 	 */
-	block_descriptor->original_offset = 0xb7f20000;
-	block_descriptor->relative_offset = 0x00000001;
-	block_descriptor->offset          = 0x37e2d0000;
-	block_descriptor->flags           = 0x00000002;
-	block_descriptor->bitmap          = 0x0000ff00;
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7f20000,
+	          0x00000001,
+	          0x37e2d0000,
+	          0x00000002,
+	          0x0000ff00,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
@@ -942,11 +1026,23 @@ int vshadow_test_block_tree_insert(
 
 	/* Test insert of block descriptor: is forwarder flag, original_offset equals relative_offset
 	 */
-	block_descriptor->original_offset = 0xbbed8000;
-	block_descriptor->relative_offset = 0xbbed8000;
-	block_descriptor->offset          = 0x3823b8000;
-	block_descriptor->flags           = 0x00000001;
-	block_descriptor->bitmap          = 0x00000000;
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xbbed8000,
+	          0xbbed8000,
+	          0x3823b8000,
+	          0x00000001,
+	          0x00000000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
@@ -966,11 +1062,23 @@ int vshadow_test_block_tree_insert(
 
 	/* Test insert of block descriptor: is forwarder flag
 	 */
-	block_descriptor->original_offset = 0xb7f1c000;
-	block_descriptor->relative_offset = 0x0004c000;
-	block_descriptor->offset          = 0x37e2cc000;
-	block_descriptor->flags           = 0x00000001;
-	block_descriptor->bitmap          = 0x00000000;
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7f1c000,
+	          0x0004c000,
+	          0x37e2cc000,
+	          0x00000001,
+	          0x00000000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
@@ -990,11 +1098,23 @@ int vshadow_test_block_tree_insert(
 
 	/* Test insert of block descriptor: is forwarder flag, override existing forwarder
 	 */
-	block_descriptor->original_offset = 0x0004c000;
-	block_descriptor->relative_offset = 0xb7f1c000;
-	block_descriptor->offset          = 0x37e2cc000;
-	block_descriptor->flags           = 0x00000001;
-	block_descriptor->bitmap          = 0x00000000;
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0x0004c000,
+	          0xb7f1c000,
+	          0x37e2cc000,
+	          0x00000001,
+	          0x00000000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
@@ -1014,11 +1134,23 @@ int vshadow_test_block_tree_insert(
 
 	/* Test insert of block descriptor: is forwarder flag
 	 */
-	block_descriptor->original_offset = 0xb7f38000;
-	block_descriptor->relative_offset = 0x00084000;
-	block_descriptor->offset          = 0x37e304000;
-	block_descriptor->flags           = 0x00000001;
-	block_descriptor->bitmap          = 0x00000000;
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7f38000,
+	          0x00084000,
+	          0x37e304000,
+	          0x00000001,
+	          0x00000000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
@@ -1038,11 +1170,23 @@ int vshadow_test_block_tree_insert(
 
 	/* Test insert of block descriptor: is forwarder flag, replaces existing forwarder
 	 */
-	block_descriptor->original_offset = 0xb7f44000;
-	block_descriptor->relative_offset = 0x00084000;
-	block_descriptor->offset          = 0x37e310000;
-	block_descriptor->flags           = 0x00000001;
-	block_descriptor->bitmap          = 0x00000000;
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7f44000,
+	          0x00084000,
+	          0x37e310000,
+	          0x00000001,
+	          0x00000000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
@@ -1062,11 +1206,23 @@ int vshadow_test_block_tree_insert(
 
 	/* Test insert of block descriptor: is forwarder flag, points to itself
 	 */
-	block_descriptor->original_offset = 0xb7f48000;
-	block_descriptor->relative_offset = 0xb7f48000;
-	block_descriptor->offset          = 0xb7f48000;
-	block_descriptor->flags           = 0x00000001;
-	block_descriptor->bitmap          = 0x00000000;
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7f48000,
+	          0xb7f48000,
+	          0xb7f48000,
+	          0x00000001,
+	          0x00000000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
@@ -1086,11 +1242,23 @@ int vshadow_test_block_tree_insert(
 
 	/* Test insert of block descriptor: not used flag
 	 */
-	block_descriptor->original_offset = 0x00001000;
-	block_descriptor->relative_offset = 0x00001000;
-	block_descriptor->offset          = 0x00001000;
-	block_descriptor->flags           = 0x00000004;
-	block_descriptor->bitmap          = 0x00000000;
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0x00001000,
+	          0x00001000,
+	          0x00001000,
+	          0x00000004,
+	          0x00000000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
@@ -1108,6 +1276,42 @@ int vshadow_test_block_tree_insert(
 	 "error",
 	 error );
 
+	/* Test insert of block descriptor without reverse block tree
+	 */
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7f50000,
+	          0x00090000,
+	          0x37e318000,
+	          0x00000000,
+	          0x00000000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_block_tree_insert(
+	          forward_block_tree,
+	          NULL,
+	          block_descriptor,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 /* TODO test not overlay and forwarder block descriptorand free existing reverse_block_descriptor */
 
 	/* Test error cases
@@ -1131,6 +1335,26 @@ int vshadow_test_block_tree_insert(
 	libcerror_error_free(
 	 &error );
 
+	/* Test error case where reverse block tree is missing for a forwarder block descriptor
+	 */
+	result = libvshadow_block_descriptor_set_values(
+	          block_descriptor,
+	          0xb7f54000,
+	          0x00094000,
+	          0x00000000,
+	          0x00000001,
+	          0x00000000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libvshadow_block_tree_insert(
 	          forward_block_tree,
 	          NULL,
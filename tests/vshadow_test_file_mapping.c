@@ -0,0 +1,1622 @@
+/*
+ * Library file_mapping type test program
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_functions.h"
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_file_mapping.h"
+#include "../libvshadow/libvshadow_volume.h"
+
+#if defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+#include <unistd.h>
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Tests the libvshadow_file_mapping_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_file_mapping_initialize(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libvshadow_file_mapping_t *file_mapping = NULL;
+	int result                              = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests         = 1;
+	int number_of_memset_fail_tests         = 1;
+	int test_number                         = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvshadow_file_mapping_initialize(
+	          &file_mapping,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_mapping",
+	 file_mapping );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_file_mapping_free(
+	          &file_mapping,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "file_mapping",
+	 file_mapping );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_file_mapping_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	file_mapping = (libvshadow_file_mapping_t *) 0x12345678UL;
+
+	result = libvshadow_file_mapping_initialize(
+	          &file_mapping,
+	          &error );
+
+	file_mapping = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_file_mapping_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_file_mapping_initialize(
+		          &file_mapping,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( file_mapping != NULL )
+			{
+				libvshadow_file_mapping_free(
+				 &file_mapping,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "file_mapping",
+			 file_mapping );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_file_mapping_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_file_mapping_initialize(
+		          &file_mapping,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( file_mapping != NULL )
+			{
+				libvshadow_file_mapping_free(
+				 &file_mapping,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "file_mapping",
+			 file_mapping );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_mapping != NULL )
+	{
+		libvshadow_file_mapping_free(
+		 &file_mapping,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_file_mapping_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_file_mapping_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_file_mapping_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+
+/* Creates a temporary file that contains the data
+ * The filename is a template that is replaced by the name of the file
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_file_mapping_create_file(
+     char *filename,
+     const uint8_t *data,
+     size_t data_size )
+{
+	ssize_t write_count = 0;
+	int file_descriptor = -1;
+
+	file_descriptor = mkstemp(
+	                   filename );
+
+	if( file_descriptor == -1 )
+	{
+		return( -1 );
+	}
+	while( data_size > 0 )
+	{
+		write_count = write(
+		               file_descriptor,
+		               data,
+		               data_size );
+
+		if( write_count <= 0 )
+		{
+			close(
+			 file_descriptor );
+
+			unlink(
+			 filename );
+
+			return( -1 );
+		}
+		data      += write_count;
+		data_size -= (size_t) write_count;
+	}
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		unlink(
+		 filename );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Tests the libvshadow_file_mapping_open and libvshadow_file_mapping_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_file_mapping_open_close(
+     const char *filename )
+{
+	libcerror_error_t *error                = NULL;
+	libvshadow_file_mapping_t *file_mapping = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_file_mapping_initialize(
+	          &file_mapping,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_mapping",
+	 file_mapping );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_file_mapping_open(
+	          file_mapping,
+	          filename,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_mapping->data",
+	 file_mapping->data );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "file_mapping->data_size",
+	 file_mapping->data_size,
+	 (size_t) VSHADOW_TEST_VOLUME_DATA_SIZE );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "file_mapping->access_pattern",
+	 file_mapping->access_pattern,
+	 LIBVSHADOW_FILE_MAPPING_ACCESS_PATTERN_RANDOM );
+
+	/* Test error cases
+	 */
+	result = libvshadow_file_mapping_open(
+	          file_mapping,
+	          filename,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_file_mapping_close(
+	          file_mapping,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "file_mapping->data",
+	 file_mapping->data );
+
+	/* Test error cases
+	 */
+	result = libvshadow_file_mapping_open(
+	          NULL,
+	          filename,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_file_mapping_open(
+	          file_mapping,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* A directory is not mapped
+	 */
+	result = libvshadow_file_mapping_open(
+	          file_mapping,
+	          ".",
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "file_mapping->data",
+	 file_mapping->data );
+
+	result = libvshadow_file_mapping_close(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_file_mapping_free(
+	          &file_mapping,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "file_mapping",
+	 file_mapping );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_mapping != NULL )
+	{
+		libvshadow_file_mapping_free(
+		 &file_mapping,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Tests the libvshadow_file_mapping_open_wide function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_file_mapping_open_wide(
+     const char *filename )
+{
+	wchar_t wide_filename[ 64 ];
+
+	libcerror_error_t *error                = NULL;
+	libvshadow_file_mapping_t *file_mapping = NULL;
+	size_t filename_index                   = 0;
+	size_t filename_length                  = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	filename_length = narrow_string_length(
+	                   filename );
+
+	VSHADOW_TEST_ASSERT_LESS_THAN_UINT64(
+	 "filename_length",
+	 (uint64_t) filename_length,
+	 (uint64_t) 64 );
+
+	/* The name of the temporary file only contains ASCII characters
+	 */
+	for( filename_index = 0;
+	     filename_index <= filename_length;
+	     filename_index++ )
+	{
+		wide_filename[ filename_index ] = (wchar_t) filename[ filename_index ];
+	}
+	result = libvshadow_file_mapping_initialize(
+	          &file_mapping,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_mapping",
+	 file_mapping );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_file_mapping_open_wide(
+	          file_mapping,
+	          wide_filename,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "file_mapping->data_size",
+	 file_mapping->data_size,
+	 (size_t) VSHADOW_TEST_VOLUME_DATA_SIZE );
+
+	result = libvshadow_file_mapping_close(
+	          file_mapping,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_file_mapping_open_wide(
+	          NULL,
+	          wide_filename,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_file_mapping_open_wide(
+	          file_mapping,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_file_mapping_free(
+	          &file_mapping,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_mapping != NULL )
+	{
+		libvshadow_file_mapping_free(
+		 &file_mapping,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Tests the libvshadow_file_mapping_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_file_mapping_read_buffer_at_offset(
+     libvshadow_file_mapping_t *file_mapping,
+     const uint8_t *volume_data )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error = NULL;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	/* Test read within the mapping
+	 */
+	read_count = libvshadow_file_mapping_read_buffer_at_offset(
+	              file_mapping,
+	              VSHADOW_TEST_CATALOG_OFFSET,
+	              buffer,
+	              512,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( volume_data[ VSHADOW_TEST_CATALOG_OFFSET ] ),
+	          512 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test read at the end of the mapping
+	 */
+	read_count = libvshadow_file_mapping_read_buffer_at_offset(
+	              file_mapping,
+	              VSHADOW_TEST_VOLUME_DATA_SIZE - 256,
+	              buffer,
+	              512,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 256 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( volume_data[ VSHADOW_TEST_VOLUME_DATA_SIZE - 256 ] ),
+	          256 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test read past the end of the mapping
+	 */
+	read_count = libvshadow_file_mapping_read_buffer_at_offset(
+	              file_mapping,
+	              VSHADOW_TEST_VOLUME_DATA_SIZE,
+	              buffer,
+	              512,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvshadow_file_mapping_read_buffer_at_offset(
+	              file_mapping,
+	              VSHADOW_TEST_VOLUME_DATA_SIZE + 0x1000,
+	              buffer,
+	              512,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	read_count = libvshadow_file_mapping_read_buffer_at_offset(
+	              NULL,
+	              0,
+	              buffer,
+	              512,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvshadow_file_mapping_read_buffer_at_offset(
+	              file_mapping,
+	              -1,
+	              buffer,
+	              512,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvshadow_file_mapping_read_buffer_at_offset(
+	              file_mapping,
+	              0,
+	              NULL,
+	              512,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvshadow_file_mapping_read_buffer_at_offset(
+	              file_mapping,
+	              0,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_file_mapping_get_data_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_file_mapping_get_data_at_offset(
+     libvshadow_file_mapping_t *file_mapping,
+     const uint8_t *volume_data )
+{
+	libcerror_error_t *error = NULL;
+	const uint8_t *data      = NULL;
+	size_t data_size         = 0;
+	int result               = 0;
+
+	/* Test data within the mapping
+	 */
+	result = libvshadow_file_mapping_get_data_at_offset(
+	          file_mapping,
+	          VSHADOW_TEST_CATALOG_OFFSET,
+	          &data,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) ( VSHADOW_TEST_VOLUME_DATA_SIZE - VSHADOW_TEST_CATALOG_OFFSET ) );
+
+	result = memory_compare(
+	          data,
+	          &( volume_data[ VSHADOW_TEST_CATALOG_OFFSET ] ),
+	          data_size );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test data at the end of the mapping
+	 */
+	data      = NULL;
+	data_size = 0;
+
+	result = libvshadow_file_mapping_get_data_at_offset(
+	          file_mapping,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE - 1,
+	          &data,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "data[ 0 ]",
+	 data[ 0 ],
+	 volume_data[ VSHADOW_TEST_VOLUME_DATA_SIZE - 1 ] );
+
+	/* Test data past the end of the mapping
+	 */
+	data      = NULL;
+	data_size = 0;
+
+	result = libvshadow_file_mapping_get_data_at_offset(
+	          file_mapping,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          &data,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "data",
+	 data );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) 0 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_file_mapping_get_data_at_offset(
+	          NULL,
+	          0,
+	          &data,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_file_mapping_get_data_at_offset(
+	          file_mapping,
+	          -1,
+	          &data,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_file_mapping_get_data_at_offset(
+	          file_mapping,
+	          0,
+	          NULL,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_file_mapping_get_data_at_offset(
+	          file_mapping,
+	          0,
+	          &data,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_file_mapping_update_access_pattern function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_file_mapping_update_access_pattern(
+     libvshadow_file_mapping_t *file_mapping )
+{
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	int read_index           = 0;
+	int result               = 0;
+
+	/* Test switching to sequential after consecutive sequential reads
+	 */
+	for( read_index = 0;
+	     read_index <= LIBVSHADOW_FILE_MAPPING_SEQUENTIAL_READ_THRESHOLD;
+	     read_index++ )
+	{
+		result = libvshadow_file_mapping_update_access_pattern(
+		          file_mapping,
+		          offset,
+		          512,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		offset += 512;
+	}
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "file_mapping->access_pattern",
+	 file_mapping->access_pattern,
+	 LIBVSHADOW_FILE_MAPPING_ACCESS_PATTERN_SEQUENTIAL );
+
+	/* Test that a single non-sequential read does not switch to random
+	 */
+	result = libvshadow_file_mapping_update_access_pattern(
+	          file_mapping,
+	          0x8000,
+	          512,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "file_mapping->access_pattern",
+	 file_mapping->access_pattern,
+	 LIBVSHADOW_FILE_MAPPING_ACCESS_PATTERN_SEQUENTIAL );
+
+	/* Test switching to random after consecutive non-sequential reads
+	 */
+	for( read_index = 0;
+	     read_index < LIBVSHADOW_FILE_MAPPING_SEQUENTIAL_READ_THRESHOLD;
+	     read_index++ )
+	{
+		result = libvshadow_file_mapping_update_access_pattern(
+		          file_mapping,
+		          (off64_t) read_index * 0x2000,
+		          512,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "file_mapping->access_pattern",
+	 file_mapping->access_pattern,
+	 LIBVSHADOW_FILE_MAPPING_ACCESS_PATTERN_RANDOM );
+
+	/* Test error cases
+	 */
+	result = libvshadow_file_mapping_update_access_pattern(
+	          NULL,
+	          0,
+	          512,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests opening a volume with LIBVSHADOW_OPEN_READ_MEMORY_MAPPED
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_file_mapping_volume_open(
+     const char *filename,
+     const uint8_t *volume_data )
+{
+	uint8_t buffer[ 512 ];
+
+	libcerror_error_t *error    = NULL;
+	libvshadow_store_t *store   = NULL;
+	libvshadow_volume_t *volume = NULL;
+	const uint8_t *data         = NULL;
+	size64_t source_size        = 0;
+	size_t data_size            = 0;
+	ssize_t read_count          = 0;
+	off64_t source_offset       = 0;
+	int result                  = 0;
+	int source_store_index      = 0;
+	int source_type             = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_open(
+	          volume,
+	          filename,
+	          LIBVSHADOW_OPEN_READ_MEMORY_MAPPED,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "internal_volume->file_mapping",
+	 ( (libvshadow_internal_volume_t *) volume )->file_mapping );
+
+	result = libvshadow_volume_get_store(
+	          volume,
+	          0,
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store",
+	 store );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_get_data_source_at_offset(
+	          store,
+	          VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ),
+	          &source_type,
+	          &source_store_index,
+	          &source_offset,
+	          &source_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The store data is read through the file mapping of the volume
+	 */
+	result = libvshadow_store_borrow_data_at_offset(
+	          store,
+	          VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ),
+	          &data,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INTPTR(
+	 "data",
+	 (intptr_t) data,
+	 (intptr_t) &( ( (libvshadow_internal_volume_t *) volume )->file_mapping->data[ source_offset ] ) );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "data_size",
+	 data_size,
+	 (size_t) source_size );
+
+	read_count = libvshadow_store_read_buffer_at_offset(
+	              store,
+	              buffer,
+	              512,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ),
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( volume_data[ source_offset ] ),
+	          512 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_free(
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_close(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "internal_volume->file_mapping",
+	 ( (libvshadow_internal_volume_t *) volume )->file_mapping );
+
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) && defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+	char filename[ 64 ]                     = "vshadow_test_file_mapping.XXXXXX";
+
+	libcerror_error_t *error                = NULL;
+	libvshadow_file_mapping_t *file_mapping = NULL;
+	uint8_t *volume_data                    = NULL;
+	int file_created                        = 0;
+	int result                              = 0;
+#endif
+
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_file_mapping_initialize",
+	 vshadow_test_file_mapping_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_file_mapping_free",
+	 vshadow_test_file_mapping_free );
+
+#if defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+
+	/* Initialize test
+	 */
+	volume_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * VSHADOW_TEST_VOLUME_DATA_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_data",
+	 volume_data );
+
+	result = vshadow_test_write_volume_data(
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          0,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_file_mapping_create_file(
+	          filename,
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	file_created = 1;
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_file_mapping_open",
+	 vshadow_test_file_mapping_open_close,
+	 filename );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_file_mapping_open_wide",
+	 vshadow_test_file_mapping_open_wide,
+	 filename );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+	result = libvshadow_file_mapping_initialize(
+	          &file_mapping,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_file_mapping_open(
+	          file_mapping,
+	          filename,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_file_mapping_read_buffer_at_offset",
+	 vshadow_test_file_mapping_read_buffer_at_offset,
+	 file_mapping,
+	 volume_data );
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_file_mapping_get_data_at_offset",
+	 vshadow_test_file_mapping_get_data_at_offset,
+	 file_mapping,
+	 volume_data );
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_file_mapping_update_access_pattern",
+	 vshadow_test_file_mapping_update_access_pattern,
+	 file_mapping );
+
+	result = libvshadow_file_mapping_free(
+	          &file_mapping,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_RUN_WITH_ARGS(
+	 "libvshadow_volume_open",
+	 vshadow_test_file_mapping_volume_open,
+	 filename,
+	 volume_data );
+
+	/* Clean up
+	 */
+	unlink(
+	 filename );
+
+	memory_free(
+	 volume_data );
+
+#endif /* defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+on_error:
+#if defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT )
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_mapping != NULL )
+	{
+		libvshadow_file_mapping_free(
+		 &file_mapping,
+		 NULL );
+	}
+	if( file_created != 0 )
+	{
+		unlink(
+		 filename );
+	}
+	if( volume_data != NULL )
+	{
+		memory_free(
+		 volume_data );
+	}
+#endif /* defined( HAVE_LIBVSHADOW_FILE_MAPPING_SUPPORT ) */
+
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+}
+
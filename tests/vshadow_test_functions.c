@@ -19,8 +19,10 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <byte_stream.h>
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -30,10 +32,15 @@
 #include <stdlib.h>
 #endif
 
+#include "vshadow_test_functions.h"
 #include "vshadow_test_libbfio.h"
 #include "vshadow_test_libcerror.h"
 #include "vshadow_test_libclocale.h"
 #include "vshadow_test_libuna.h"
+#include "vshadow_test_libvshadow.h"
+
+const uint8_t vshadow_test_vss_identifier[ 16 ] = {
+	0x6b, 0x87, 0x08, 0x38, 0x76, 0xc1, 0x48, 0x4e, 0xb7, 0xae, 0x04, 0x04, 0x6e, 0x6c, 0xc7, 0x52 };
 
 /* Retrieves source as a narrow string
  * Returns 1 if successful or -1 on error
@@ -670,3 +677,242 @@ int vshadow_test_close_file_io_handle(
 	return( result );
 }
 
+/* Writes a VSS block header for test data
+ */
+void vshadow_test_write_block_header(
+      uint8_t *data,
+      uint32_t record_type,
+      uint64_t offset,
+      uint64_t next_offset )
+{
+	memory_copy(
+	 data,
+	 vshadow_test_vss_identifier,
+	 16 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 16 ] ),
+	 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( data[ 20 ] ),
+	 record_type );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 32 ] ),
+	 offset );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 40 ] ),
+	 next_offset );
+}
+
+/* Writes volume test data
+ * The volume test data contains an NTFS volume header, a VSS volume header and a catalog
+ * with the stores from first_store_index up to first_store_index + number_of_stores
+ * Each store contains a single block with the original offset
+ * VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( store_index ), that is stored at
+ * VSHADOW_TEST_STORE_BLOCK_OFFSET( store_index ) and filled with the byte value 0x80 + store_index
+ * Returns 1 if successful or -1 on error
+ */
+int vshadow_test_write_volume_data(
+     uint8_t *data,
+     size_t data_size,
+     int first_store_index,
+     int number_of_stores,
+     libcerror_error_t **error )
+{
+	uint8_t *catalog_entry_data = NULL;
+	uint8_t *store_data         = NULL;
+	static char *function       = "vshadow_test_write_volume_data";
+	off64_t store_offset        = 0;
+	int store_index             = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size != VSHADOW_TEST_VOLUME_DATA_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( first_store_index < 0 )
+	 || ( number_of_stores < 0 )
+	 || ( number_of_stores > ( VSHADOW_TEST_MAXIMUM_NUMBER_OF_STORES - first_store_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid stores value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear data.",
+		 function );
+
+		return( -1 );
+	}
+	/* The NTFS volume header with 512 bytes per sector, 8 sectors per cluster block,
+	 * 1024 bytes per MFT entry and 4096 bytes per index entry
+	 */
+	data[ 0 ] = 0xeb;
+	data[ 1 ] = 0x52;
+	data[ 2 ] = 0x90;
+
+	memory_copy(
+	 &( data[ 3 ] ),
+	 "NTFS    ",
+	 (uint64_t) 8 );
+
+	byte_stream_copy_from_uint16_little_endian(
+	 &( data[ 11 ] ),
+	 512 );
+
+	data[ 13 ] = 8;
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 40 ] ),
+	 (uint64_t) ( ( data_size / 512 ) - 1 ) );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 48 ] ),
+	 (uint64_t) 4 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( data[ 56 ] ),
+	 (uint64_t) 8 );
+
+	data[ 64 ]  = 0xf6;
+	data[ 68 ]  = 1;
+	data[ 510 ] = 0x55;
+	data[ 511 ] = 0xaa;
+
+	/* The backup NTFS volume header is stored in the last sector of the volume
+	 */
+	memory_copy(
+	 &( data[ data_size - 512 ] ),
+	 data,
+	 512 );
+
+	/* The VSS volume header
+	 */
+	vshadow_test_write_block_header(
+	 &( data[ 0x1e00 ] ),
+	 LIBVSHADOW_RECORD_TYPE_VOLUME_HEADER,
+	 0,
+	 0 );
+
+	if( number_of_stores > 0 )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 &( data[ 0x1e00 + 48 ] ),
+		 (uint64_t) VSHADOW_TEST_CATALOG_OFFSET );
+
+		vshadow_test_write_block_header(
+		 &( data[ VSHADOW_TEST_CATALOG_OFFSET ] ),
+		 LIBVSHADOW_RECORD_TYPE_CATALOG,
+		 VSHADOW_TEST_CATALOG_OFFSET,
+		 0 );
+	}
+	catalog_entry_data = &( data[ VSHADOW_TEST_CATALOG_OFFSET + 128 ] );
+
+	for( store_index = first_store_index;
+	     store_index < ( first_store_index + number_of_stores );
+	     store_index++ )
+	{
+		store_offset = VSHADOW_TEST_STORE_HEADER_OFFSET( store_index );
+
+		/* The catalog entry that describes the store
+		 */
+		byte_stream_copy_from_uint64_little_endian(
+		 catalog_entry_data,
+		 (uint64_t) 2 );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( catalog_entry_data[ 8 ] ),
+		 (uint64_t) data_size );
+
+		catalog_entry_data[ 16 ] = (uint8_t) ( 1 + store_index );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( catalog_entry_data[ 48 ] ),
+		 (uint64_t) 0x01d0000000000000ULL + store_index );
+
+		catalog_entry_data += 128;
+
+		/* The catalog entry that describes the location of the store data
+		 */
+		byte_stream_copy_from_uint64_little_endian(
+		 catalog_entry_data,
+		 (uint64_t) 3 );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( catalog_entry_data[ 8 ] ),
+		 (uint64_t) ( store_offset + 0x4000 ) );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( catalog_entry_data[ 32 ] ),
+		 (uint64_t) store_offset );
+
+		catalog_entry_data += 128;
+
+		/* The store header with empty operating and service machine strings
+		 */
+		vshadow_test_write_block_header(
+		 &( data[ store_offset ] ),
+		 LIBVSHADOW_RECORD_TYPE_STORE_HEADER,
+		 store_offset,
+		 0 );
+
+		/* The store block list with a single entry
+		 */
+		vshadow_test_write_block_header(
+		 &( data[ store_offset + 0x4000 ] ),
+		 LIBVSHADOW_RECORD_TYPE_STORE_INDEX,
+		 store_offset + 0x4000,
+		 0 );
+
+		store_data = &( data[ store_offset + 0x4000 + 128 ] );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 store_data,
+		 (uint64_t) VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( store_index ) );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( store_data[ 16 ] ),
+		 (uint64_t) VSHADOW_TEST_STORE_BLOCK_OFFSET( store_index ) );
+
+		/* The store block data
+		 */
+		memory_set(
+		 &( data[ VSHADOW_TEST_STORE_BLOCK_OFFSET( store_index ) ] ),
+		 0x80 + store_index,
+		 0x4000 );
+	}
+	return( 1 );
+}
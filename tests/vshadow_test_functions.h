@@ -32,6 +32,21 @@
 extern "C" {
 #endif
 
+/* The layout of the volume test data
+ */
+#define VSHADOW_TEST_VOLUME_DATA_SIZE			0x00100000UL
+#define VSHADOW_TEST_MAXIMUM_NUMBER_OF_STORES		4
+#define VSHADOW_TEST_CATALOG_OFFSET			0x00004000UL
+
+#define VSHADOW_TEST_STORE_HEADER_OFFSET( store_index ) \
+	( (off64_t) 0x00010000UL + ( (off64_t) ( store_index ) * 0x00010000UL ) )
+
+#define VSHADOW_TEST_STORE_BLOCK_OFFSET( store_index ) \
+	( VSHADOW_TEST_STORE_HEADER_OFFSET( store_index ) + 0x00008000UL )
+
+#define VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( store_index ) \
+	( (off64_t) 0x00080000UL + ( (off64_t) ( store_index ) * 0x00004000UL ) )
+
 int vshadow_test_get_narrow_source(
      const system_character_t *source,
      char *narrow_string,
@@ -64,6 +79,19 @@ int vshadow_test_close_file_io_handle(
      libbfio_handle_t **file_io_handle,
      libcerror_error_t **error );
 
+void vshadow_test_write_block_header(
+      uint8_t *data,
+      uint32_t record_type,
+      uint64_t offset,
+      uint64_t next_offset );
+
+int vshadow_test_write_volume_data(
+     uint8_t *data,
+     size_t data_size,
+     int first_store_index,
+     int number_of_stores,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,699 @@
+/*
+ * Library metadata_loader type test program
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_io_handle.h"
+#include "../libvshadow/libvshadow_metadata_loader.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Tests the libvshadow_metadata_loader_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_metadata_loader_initialize(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libvshadow_io_handle_t *io_handle             = NULL;
+	libvshadow_metadata_loader_t *metadata_loader = NULL;
+	int result                                    = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests               = 4;
+	int number_of_memset_fail_tests               = 2;
+	int test_number                               = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = libvshadow_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_metadata_loader_initialize(
+	          &metadata_loader,
+	          io_handle,
+	          NULL,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_loader",
+	 metadata_loader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_metadata_loader_free(
+	          &metadata_loader,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "metadata_loader",
+	 metadata_loader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_metadata_loader_initialize(
+	          NULL,
+	          io_handle,
+	          NULL,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	metadata_loader = (libvshadow_metadata_loader_t *) 0x12345678UL;
+
+	result = libvshadow_metadata_loader_initialize(
+	          &metadata_loader,
+	          io_handle,
+	          NULL,
+	          2,
+	          &error );
+
+	metadata_loader = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_metadata_loader_initialize(
+	          &metadata_loader,
+	          NULL,
+	          NULL,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "metadata_loader",
+	 metadata_loader );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_metadata_loader_initialize(
+	          &metadata_loader,
+	          io_handle,
+	          NULL,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "metadata_loader",
+	 metadata_loader );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_metadata_loader_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_metadata_loader_initialize(
+		          &metadata_loader,
+		          io_handle,
+		          NULL,
+		          2,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( metadata_loader != NULL )
+			{
+				libvshadow_metadata_loader_free(
+				 &metadata_loader,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "metadata_loader",
+			 metadata_loader );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_metadata_loader_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_metadata_loader_initialize(
+		          &metadata_loader,
+		          io_handle,
+		          NULL,
+		          2,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( metadata_loader != NULL )
+			{
+				libvshadow_metadata_loader_free(
+				 &metadata_loader,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "metadata_loader",
+			 metadata_loader );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+
+	/* Clean up
+	 */
+	result = libvshadow_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_loader != NULL )
+	{
+		libvshadow_metadata_loader_free(
+		 &metadata_loader,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvshadow_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_metadata_loader_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_metadata_loader_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_metadata_loader_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_metadata_loader_get_next_chain function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_metadata_loader_get_next_chain(
+     void )
+{
+	off64_t block_offsets[ 5 ]          = { 0x00010000, 0x00050000, 0x00090000, 0x00030000, 0x00000000 };
+	off64_t expected_block_offsets[ 4 ] = { 0x00050000, 0x00090000, 0x00030000, 0x00010000 };
+
+	libcerror_error_t *error                      = NULL;
+	libvshadow_io_handle_t *io_handle             = NULL;
+	libvshadow_metadata_chain_t *chain            = NULL;
+	libvshadow_metadata_loader_t *metadata_loader = NULL;
+	int chain_index                               = 0;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_metadata_loader_initialize(
+	          &metadata_loader,
+	          io_handle,
+	          NULL,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_loader",
+	 metadata_loader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The empty chain is not appended
+	 */
+	for( chain_index = 0;
+	     chain_index < 5;
+	     chain_index++ )
+	{
+		result = libvshadow_metadata_loader_append_chain(
+		          metadata_loader,
+		          chain_index % 2,
+		          LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_BLOCK_LIST,
+		          block_offsets[ chain_index ],
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "metadata_loader->number_of_chains",
+	 metadata_loader->number_of_chains,
+	 4 );
+
+	/* Test regular cases
+	 */
+	metadata_loader->current_offset = 0x00040000;
+
+	for( chain_index = 0;
+	     chain_index < 4;
+	     chain_index++ )
+	{
+		result = libvshadow_metadata_loader_get_next_chain(
+		          metadata_loader,
+		          &chain,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "chain",
+		 chain );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT64(
+		 "chain->block_offset",
+		 (int64_t) chain->block_offset,
+		 (int64_t) expected_block_offsets[ chain_index ] );
+
+		/* Mimic reading the last store block of the chain
+		 */
+		metadata_loader->current_offset = chain->block_offset;
+
+		chain->block_offset = 0;
+	}
+	result = libvshadow_metadata_loader_get_next_chain(
+	          metadata_loader,
+	          &chain,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "chain",
+	 chain );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_metadata_loader_get_next_chain(
+	          NULL,
+	          &chain,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_metadata_loader_get_next_chain(
+	          metadata_loader,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_metadata_loader_append_chain(
+	          metadata_loader,
+	          2,
+	          LIBVSHADOW_METADATA_CHAIN_TYPE_STORE_BLOCK_LIST,
+	          0x00010000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_metadata_loader_append_chain(
+	          metadata_loader,
+	          0,
+	          0xff,
+	          0x00010000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_metadata_loader_free(
+	          &metadata_loader,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "metadata_loader",
+	 metadata_loader );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_loader != NULL )
+	{
+		libvshadow_metadata_loader_free(
+		 &metadata_loader,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvshadow_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_metadata_loader_initialize",
+	 vshadow_test_metadata_loader_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_metadata_loader_free",
+	 vshadow_test_metadata_loader_free );
+
+	/* TODO: add tests for libvshadow_metadata_loader_add_store */
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_metadata_loader_get_next_chain",
+	 vshadow_test_metadata_loader_get_next_chain );
+
+	/* TODO: add tests for libvshadow_metadata_loader_read_chain_block */
+
+	/* TODO: add tests for libvshadow_metadata_loader_read */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+}
+
@@ -0,0 +1,798 @@
+/*
+ * Library reference_index type test program
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_block_descriptor.h"
+#include "../libvshadow/libvshadow_definitions.h"
+#include "../libvshadow/libvshadow_reference_index.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Tests the libvshadow_reference_index_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_reference_index_initialize(
+     void )
+{
+	libcerror_error_t *error                      = NULL;
+	libvshadow_reference_index_t *reference_index = NULL;
+	int result                                    = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests               = 1;
+	int number_of_memset_fail_tests               = 1;
+	int test_number                               = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvshadow_reference_index_initialize(
+	          &reference_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "reference_index",
+	 reference_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_reference_index_free(
+	          &reference_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "reference_index",
+	 reference_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_reference_index_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	reference_index = (libvshadow_reference_index_t *) 0x12345678UL;
+
+	result = libvshadow_reference_index_initialize(
+	          &reference_index,
+	          &error );
+
+	reference_index = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_reference_index_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_reference_index_initialize(
+		          &reference_index,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( reference_index != NULL )
+			{
+				libvshadow_reference_index_free(
+				 &reference_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "reference_index",
+			 reference_index );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_reference_index_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_reference_index_initialize(
+		          &reference_index,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( reference_index != NULL )
+			{
+				libvshadow_reference_index_free(
+				 &reference_index,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "reference_index",
+			 reference_index );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( reference_index != NULL )
+	{
+		libvshadow_reference_index_free(
+		 &reference_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_reference_index_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_reference_index_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_reference_index_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_reference_index_append_block_descriptor function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_reference_index_append_block_descriptor(
+     void )
+{
+	libvshadow_block_descriptor_t block_descriptor;
+
+	libcerror_error_t *error                      = NULL;
+	libvshadow_reference_index_t *reference_index = NULL;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_reference_index_initialize(
+	          &reference_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "reference_index",
+	 reference_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 &block_descriptor,
+	 0,
+	 sizeof( libvshadow_block_descriptor_t ) );
+
+	block_descriptor.original_block_number = 3;
+	block_descriptor.block_number          = 7;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_reference_index_append_block_descriptor(
+	          reference_index,
+	          1,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "reference_index->number_of_references",
+	 reference_index->number_of_references,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "reference_index->references[ 0 ].block_number",
+	 reference_index->references[ 0 ].block_number,
+	 7 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "reference_index->references[ 0 ].original_block_number",
+	 reference_index->references[ 0 ].original_block_number,
+	 3 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "reference_index->references[ 0 ].store_index",
+	 reference_index->references[ 0 ].store_index,
+	 1 );
+
+	/* A forwarder block descriptor does not reference a block in the store area
+	 */
+	block_descriptor.flags = LIBVSHADOW_BLOCK_FLAG_IS_FORWARDER;
+
+	result = libvshadow_reference_index_append_block_descriptor(
+	          reference_index,
+	          1,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "reference_index->number_of_references",
+	 reference_index->number_of_references,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_reference_index_append_block_descriptor(
+	          NULL,
+	          1,
+	          &block_descriptor,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_reference_index_append_block_descriptor(
+	          reference_index,
+	          1,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_reference_index_free(
+	          &reference_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "reference_index",
+	 reference_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( reference_index != NULL )
+	{
+		libvshadow_reference_index_free(
+		 &reference_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_reference_index_get_references_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_reference_index_get_references_at_offset(
+     void )
+{
+	uint32_t block_numbers[ 5 ]          = { 9, 4, 9, 2, 9 };
+	uint32_t original_block_numbers[ 5 ] = { 1, 2, 3, 4, 5 };
+	int store_indexes[ 5 ]               = { 2, 0, 0, 1, 1 };
+
+	libvshadow_block_descriptor_t block_descriptor;
+
+	libcerror_error_t *error                      = NULL;
+	libvshadow_reference_index_t *reference_index = NULL;
+	int descriptor_index                          = 0;
+	int first_reference_index                     = 0;
+	int number_of_references                      = 0;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_reference_index_initialize(
+	          &reference_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "reference_index",
+	 reference_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 &block_descriptor,
+	 0,
+	 sizeof( libvshadow_block_descriptor_t ) );
+
+	for( descriptor_index = 0;
+	     descriptor_index < 5;
+	     descriptor_index++ )
+	{
+		block_descriptor.original_block_number = original_block_numbers[ descriptor_index ];
+		block_descriptor.block_number          = block_numbers[ descriptor_index ];
+
+		result = libvshadow_reference_index_append_block_descriptor(
+		          reference_index,
+		          store_indexes[ descriptor_index ],
+		          &block_descriptor,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libvshadow_reference_index_sort(
+	          reference_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_reference_index_get_references_at_offset(
+	          reference_index,
+	          ( 9 << LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT ) + 0x0100,
+	          &first_reference_index,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "first_reference_index",
+	 first_reference_index,
+	 2 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_references",
+	 number_of_references,
+	 3 );
+
+	/* The references to the same block are sorted by store index
+	 */
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "reference_index->references[ 2 ].store_index",
+	 reference_index->references[ 2 ].store_index,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "reference_index->references[ 2 ].original_block_number",
+	 reference_index->references[ 2 ].original_block_number,
+	 3 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "reference_index->references[ 4 ].store_index",
+	 reference_index->references[ 4 ].store_index,
+	 2 );
+
+	result = libvshadow_reference_index_get_references_at_offset(
+	          reference_index,
+	          2 << LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT,
+	          &first_reference_index,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "first_reference_index",
+	 first_reference_index,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_references",
+	 number_of_references,
+	 1 );
+
+	result = libvshadow_reference_index_get_references_at_offset(
+	          reference_index,
+	          5 << LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT,
+	          &first_reference_index,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_references",
+	 number_of_references,
+	 0 );
+
+	result = libvshadow_reference_index_get_references_at_offset(
+	          reference_index,
+	          10 << LIBVSHADOW_BLOCK_DESCRIPTOR_BLOCK_NUMBER_SHIFT,
+	          &first_reference_index,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_reference_index_get_references_at_offset(
+	          NULL,
+	          0,
+	          &first_reference_index,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_reference_index_get_references_at_offset(
+	          reference_index,
+	          -1,
+	          &first_reference_index,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_reference_index_get_references_at_offset(
+	          reference_index,
+	          0,
+	          NULL,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_reference_index_get_references_at_offset(
+	          reference_index,
+	          0,
+	          &first_reference_index,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_reference_index_free(
+	          &reference_index,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "reference_index",
+	 reference_index );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( reference_index != NULL )
+	{
+		libvshadow_reference_index_free(
+		 &reference_index,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_reference_index_initialize",
+	 vshadow_test_reference_index_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_reference_index_free",
+	 vshadow_test_reference_index_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_reference_index_append_block_descriptor",
+	 vshadow_test_reference_index_append_block_descriptor );
+
+	/* TODO: add tests for libvshadow_reference_index_read_store_descriptor */
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_reference_index_get_references_at_offset",
+	 vshadow_test_reference_index_get_references_at_offset );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+}
+
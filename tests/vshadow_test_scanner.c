@@ -0,0 +1,1081 @@
+/*
+ * Library scanner type test program
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libbfio.h"
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_definitions.h"
+#include "../libvshadow/libvshadow_scanner.h"
+
+#define VSHADOW_TEST_SCANNER_DATA_SIZE	65536
+
+uint8_t vshadow_test_scanner_identifier[ 16 ] = {
+	0x6b, 0x87, 0x08, 0x38, 0x76, 0xc1, 0x48, 0x4e, 0xb7, 0xae, 0x04, 0x04, 0x6e, 0x6c, 0xc7, 0x52 };
+
+uint8_t vshadow_test_scanner_data[ VSHADOW_TEST_SCANNER_DATA_SIZE ];
+
+/* Writes a record header into the test data
+ */
+void vshadow_test_scanner_set_record(
+      size_t data_offset,
+      uint32_t record_type,
+      uint64_t stored_offset )
+{
+	memory_copy(
+	 &( vshadow_test_scanner_data[ data_offset ] ),
+	 vshadow_test_scanner_identifier,
+	 16 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( vshadow_test_scanner_data[ data_offset + 16 ] ),
+	 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( vshadow_test_scanner_data[ data_offset + 20 ] ),
+	 record_type );
+
+	/* The volume header stores the offset directly after the record type
+	 */
+	if( record_type == LIBVSHADOW_RECORD_TYPE_VOLUME_HEADER )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 &( vshadow_test_scanner_data[ data_offset + 24 ] ),
+		 stored_offset );
+	}
+	else
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 &( vshadow_test_scanner_data[ data_offset + 32 ] ),
+		 stored_offset );
+	}
+}
+
+/* Initializes the test data
+ * The test data contains a volume that starts at offset 0x2000
+ */
+void vshadow_test_scanner_initialize_data(
+      void )
+{
+	memory_set(
+	 vshadow_test_scanner_data,
+	 0,
+	 VSHADOW_TEST_SCANNER_DATA_SIZE );
+
+	/* The volume header
+	 */
+	vshadow_test_scanner_set_record(
+	 0x3e00,
+	 LIBVSHADOW_RECORD_TYPE_VOLUME_HEADER,
+	 0x1e00 );
+
+	/* A catalog block
+	 */
+	vshadow_test_scanner_set_record(
+	 0x6000,
+	 LIBVSHADOW_RECORD_TYPE_CATALOG,
+	 0x4000 );
+
+	/* A store header
+	 */
+	vshadow_test_scanner_set_record(
+	 0xa000,
+	 LIBVSHADOW_RECORD_TYPE_STORE_HEADER,
+	 0x8000 );
+
+	/* The identifier followed by an unsupported record type
+	 */
+	vshadow_test_scanner_set_record(
+	 0xc000,
+	 9,
+	 0xa000 );
+
+	/* The identifier that does not start at a sector boundary
+	 */
+	vshadow_test_scanner_set_record(
+	 0xd010,
+	 LIBVSHADOW_RECORD_TYPE_STORE_INDEX,
+	 0xc000 );
+
+	/* A store block of which the offset is not aligned to the block size
+	 */
+	vshadow_test_scanner_set_record(
+	 0xe000,
+	 LIBVSHADOW_RECORD_TYPE_STORE_INDEX,
+	 0x1234 );
+}
+
+/* Checks the results of scanning the test data
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_scanner_check_results(
+     libvshadow_scanner_t *scanner )
+{
+	off64_t expected_offsets[ 4 ]        = { 0x3e00, 0x6000, 0xa000, 0xe000 };
+	off64_t expected_volume_offsets[ 4 ] = { 0x2000, 0x2000, 0x2000, -1 };
+	uint32_t expected_record_types[ 4 ]  = { 1, 2, 4, 3 };
+
+	libcerror_error_t *error             = NULL;
+	off64_t offset                       = 0;
+	off64_t volume_offset                = 0;
+	uint32_t record_type                 = 0;
+	int number_of_results                = 0;
+	int result                           = 0;
+	int result_index                     = 0;
+
+	result = libvshadow_scanner_get_number_of_results(
+	          scanner,
+	          &number_of_results,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_results",
+	 number_of_results,
+	 4 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( result_index = 0;
+	     result_index < 4;
+	     result_index++ )
+	{
+		result = libvshadow_scanner_get_result_by_index(
+		          scanner,
+		          result_index,
+		          &offset,
+		          &record_type,
+		          &volume_offset,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) expected_offsets[ result_index ] );
+
+		VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+		 "record_type",
+		 record_type,
+		 expected_record_types[ result_index ] );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT64(
+		 "volume_offset",
+		 (int64_t) volume_offset,
+		 (int64_t) expected_volume_offsets[ result_index ] );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_scanner_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_scanner_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libvshadow_scanner_t *scanner   = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvshadow_scanner_initialize(
+	          &scanner,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "scanner",
+	 scanner );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_scanner_free(
+	          &scanner,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "scanner",
+	 scanner );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_scanner_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	scanner = (libvshadow_scanner_t *) 0x12345678UL;
+
+	result = libvshadow_scanner_initialize(
+	          &scanner,
+	          &error );
+
+	scanner = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_scanner_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_scanner_initialize(
+		          &scanner,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( scanner != NULL )
+			{
+				libvshadow_scanner_free(
+				 &scanner,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "scanner",
+			 scanner );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_scanner_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_scanner_initialize(
+		          &scanner,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( scanner != NULL )
+			{
+				libvshadow_scanner_free(
+				 &scanner,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "scanner",
+			 scanner );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( scanner != NULL )
+	{
+		libvshadow_scanner_free(
+		 &scanner,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_scanner_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_scanner_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_scanner_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Tests the libvshadow_scanner_find_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_scanner_find_identifier(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	size_t data_offset       = 0;
+	int result               = 0;
+
+	vshadow_test_scanner_initialize_data();
+
+	/* Test regular cases
+	 */
+	data_offset = 0;
+
+	result = libvshadow_scanner_find_identifier(
+	          vshadow_test_scanner_data,
+	          VSHADOW_TEST_SCANNER_DATA_SIZE,
+	          &data_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "data_offset",
+	 data_offset,
+	 (size_t) 0x3e00 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The identifier at offset 0xd010 does not start at a sector boundary
+	 */
+	data_offset = 0xd000;
+
+	result = libvshadow_scanner_find_identifier(
+	          vshadow_test_scanner_data,
+	          VSHADOW_TEST_SCANNER_DATA_SIZE,
+	          &data_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "data_offset",
+	 data_offset,
+	 (size_t) 0xe000 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data_offset = 0xe200;
+
+	result = libvshadow_scanner_find_identifier(
+	          vshadow_test_scanner_data,
+	          VSHADOW_TEST_SCANNER_DATA_SIZE,
+	          &data_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	data_offset = 0;
+
+	result = libvshadow_scanner_find_identifier(
+	          NULL,
+	          VSHADOW_TEST_SCANNER_DATA_SIZE,
+	          &data_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_scanner_find_identifier(
+	          vshadow_test_scanner_data,
+	          (size_t) SSIZE_MAX + 1,
+	          &data_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_scanner_find_identifier(
+	          vshadow_test_scanner_data,
+	          VSHADOW_TEST_SCANNER_DATA_SIZE,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	data_offset = 16;
+
+	result = libvshadow_scanner_find_identifier(
+	          vshadow_test_scanner_data,
+	          VSHADOW_TEST_SCANNER_DATA_SIZE,
+	          &data_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_internal_scanner_scan_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_internal_scanner_scan_buffer(
+     void )
+{
+	libcerror_error_t *error      = NULL;
+	libvshadow_scanner_t *scanner = NULL;
+	int result                    = 0;
+
+	vshadow_test_scanner_initialize_data();
+
+	/* Initialize test
+	 */
+	result = libvshadow_scanner_initialize(
+	          &scanner,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "scanner",
+	 scanner );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The data is scanned in two parts to test that the offsets are relative to the start of the data
+	 */
+	result = libvshadow_internal_scanner_scan_buffer(
+	          (libvshadow_internal_scanner_t *) scanner,
+	          vshadow_test_scanner_data,
+	          0x8000,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_internal_scanner_scan_buffer(
+	          (libvshadow_internal_scanner_t *) scanner,
+	          &( vshadow_test_scanner_data[ 0x8000 ] ),
+	          VSHADOW_TEST_SCANNER_DATA_SIZE - 0x8000,
+	          0x8000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_scanner_check_results(
+	          scanner );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_internal_scanner_scan_buffer(
+	          NULL,
+	          vshadow_test_scanner_data,
+	          VSHADOW_TEST_SCANNER_DATA_SIZE,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_internal_scanner_scan_buffer(
+	          (libvshadow_internal_scanner_t *) scanner,
+	          vshadow_test_scanner_data,
+	          VSHADOW_TEST_SCANNER_DATA_SIZE,
+	          16,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_scanner_free(
+	          &scanner,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "scanner",
+	 scanner );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( scanner != NULL )
+	{
+		libvshadow_scanner_free(
+		 &scanner,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* Tests the libvshadow_scanner_scan_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_scanner_scan_file_io_handle(
+     void )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libvshadow_scanner_t *scanner    = NULL;
+	off64_t offset                   = 0;
+	off64_t volume_offset            = 0;
+	uint32_t record_type             = 0;
+	int number_of_results            = 0;
+	int result                       = 0;
+
+	vshadow_test_scanner_initialize_data();
+
+	/* Initialize test
+	 */
+	result = libvshadow_scanner_initialize(
+	          &scanner,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "scanner",
+	 scanner );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          vshadow_test_scanner_data,
+	          VSHADOW_TEST_SCANNER_DATA_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * A second scan discards the results of the first scan
+	 */
+	result = libvshadow_scanner_scan_file_io_handle(
+	          scanner,
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_scanner_scan_file_io_handle(
+	          scanner,
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_scanner_check_results(
+	          scanner );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_scanner_scan_file_io_handle(
+	          NULL,
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_scanner_scan_file_io_handle(
+	          scanner,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_scanner_get_number_of_results(
+	          NULL,
+	          &number_of_results,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_scanner_get_result_by_index(
+	          scanner,
+	          4,
+	          &offset,
+	          &record_type,
+	          &volume_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_scanner_get_result_by_index(
+	          scanner,
+	          0,
+	          NULL,
+	          &record_type,
+	          &volume_offset,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_scanner_free(
+	          &scanner,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "scanner",
+	 scanner );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( scanner != NULL )
+	{
+		libvshadow_scanner_free(
+		 &scanner,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_scanner_initialize",
+	 vshadow_test_scanner_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_scanner_free",
+	 vshadow_test_scanner_free );
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_scanner_find_identifier",
+	 vshadow_test_scanner_find_identifier );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_internal_scanner_scan_buffer",
+	 vshadow_test_internal_scanner_scan_buffer );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_scanner_scan_file_io_handle",
+	 vshadow_test_scanner_scan_file_io_handle );
+
+	/* TODO: add tests for libvshadow_scanner_scan_file */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1298 @@
+/*
+ * Library shared_cache type test program
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_shared_cache.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Tests the libvshadow_shared_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_shared_cache_initialize(
+     void )
+{
+	libcerror_error_t *error                = NULL;
+	libvshadow_shared_cache_t *shared_cache = NULL;
+	int result                              = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests               = 1;
+	int number_of_memset_fail_tests               = 1;
+	int test_number                               = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvshadow_shared_cache_initialize(
+	          &shared_cache,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_shared_cache_free(
+	          &shared_cache,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_shared_cache_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	shared_cache = (libvshadow_shared_cache_t *) 0x12345678UL;
+
+	result = libvshadow_shared_cache_initialize(
+	          &shared_cache,
+	          &error );
+
+	shared_cache = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_shared_cache_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_shared_cache_initialize(
+		          &shared_cache,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( shared_cache != NULL )
+			{
+				libvshadow_shared_cache_free(
+				 &shared_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "shared_cache",
+			 shared_cache );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_shared_cache_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_shared_cache_initialize(
+		          &shared_cache,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( shared_cache != NULL )
+			{
+				libvshadow_shared_cache_free(
+				 &shared_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "shared_cache",
+			 shared_cache );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( shared_cache != NULL )
+	{
+		libvshadow_shared_cache_free(
+		 &shared_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_shared_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_shared_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_shared_cache_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_shared_cache_check_name function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_shared_cache_check_name(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_shared_cache_check_name(
+	          "/vshadow_test",
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_shared_cache_check_name(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_shared_cache_check_name(
+	          "/",
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_shared_cache_check_name(
+	          "vshadow_test",
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_shared_cache_check_name(
+	          "/vshadow/test",
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_shared_cache_hash function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_shared_cache_hash(
+     void )
+{
+	uint8_t data[ 1 ] = { 'a' };
+	uint64_t hash     = 0;
+
+	/* Test regular cases
+	 */
+	hash = libvshadow_shared_cache_hash(
+	        LIBVSHADOW_SHARED_CACHE_HASH_INITIAL_VALUE,
+	        data,
+	        1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "hash",
+	 hash,
+	 (uint64_t) 0xaf63dc4c8601ec8cULL );
+
+	hash = libvshadow_shared_cache_hash(
+	        LIBVSHADOW_SHARED_CACHE_HASH_INITIAL_VALUE,
+	        data,
+	        0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "hash",
+	 hash,
+	 (uint64_t) LIBVSHADOW_SHARED_CACHE_HASH_INITIAL_VALUE );
+
+	/* Test error cases
+	 */
+	hash = libvshadow_shared_cache_hash(
+	        LIBVSHADOW_SHARED_CACHE_HASH_INITIAL_VALUE,
+	        NULL,
+	        1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "hash",
+	 hash,
+	 (uint64_t) LIBVSHADOW_SHARED_CACHE_HASH_INITIAL_VALUE );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#if defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT )
+
+/* Tests the libvshadow_shared_cache_open function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_shared_cache_open(
+     void )
+{
+	char name[ 64 ];
+
+	libcerror_error_t *error                = NULL;
+	libvshadow_shared_cache_t *shared_cache = NULL;
+	int result                              = 0;
+
+	narrow_string_snprintf(
+	 name,
+	 64,
+	 "/vshadow_test_open_%d",
+	 (int) getpid() );
+
+	libvshadow_shared_cache_remove(
+	 name,
+	 NULL );
+
+	/* Initialize test
+	 */
+	result = libvshadow_shared_cache_initialize(
+	          &shared_cache,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_shared_cache_open(
+	          shared_cache,
+	          name,
+	          1024 * 1024,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "shared_cache->number_of_sets",
+	 shared_cache->number_of_sets,
+	 (uint64_t) 7 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_shared_cache_open(
+	          NULL,
+	          name,
+	          1024 * 1024,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_shared_cache_open(
+	          shared_cache,
+	          name,
+	          1024 * 1024,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_shared_cache_close(
+	          shared_cache,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_shared_cache_remove(
+	          name,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open with a size that is too small for a single set
+	 */
+	result = libvshadow_shared_cache_open(
+	          shared_cache,
+	          name,
+	          LIBVSHADOW_SHARED_CACHE_HEADER_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The shared memory object that could not be initialized is removed
+	 */
+	result = libvshadow_shared_cache_remove(
+	          name,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_shared_cache_free(
+	          &shared_cache,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "shared_cache",
+	 shared_cache );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( shared_cache != NULL )
+	{
+		libvshadow_shared_cache_free(
+		 &shared_cache,
+		 NULL );
+	}
+	libvshadow_shared_cache_remove(
+	 name,
+	 NULL );
+
+	return( 0 );
+}
+
+/* Tests the libvshadow_shared_cache_read_block and libvshadow_shared_cache_write_block functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_shared_cache_read_write_block(
+     void )
+{
+	uint8_t block_data[ LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE ];
+	uint8_t buffer[ 64 ];
+	char name[ 64 ];
+
+	libcerror_error_t *error                      = NULL;
+	libvshadow_shared_cache_t *other_shared_cache = NULL;
+	libvshadow_shared_cache_t *shared_cache       = NULL;
+	uint64_t block_number                         = 0;
+	uint64_t number_of_hits                       = 0;
+	uint64_t number_of_misses                     = 0;
+	uint64_t set_index                            = 0;
+	uint32_t number_of_blocks                     = 0;
+	uint32_t number_of_cached_blocks              = 0;
+	int result                                    = 0;
+
+	narrow_string_snprintf(
+	 name,
+	 64,
+	 "/vshadow_test_block_%d",
+	 (int) getpid() );
+
+	libvshadow_shared_cache_remove(
+	 name,
+	 NULL );
+
+	for( block_number = 0;
+	     block_number < LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE;
+	     block_number++ )
+	{
+		block_data[ block_number ] = (uint8_t) ( block_number % 251 );
+	}
+	/* Initialize test
+	 */
+	result = libvshadow_shared_cache_initialize(
+	          &shared_cache,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_shared_cache_open(
+	          shared_cache,
+	          name,
+	          1024 * 1024,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that blocks are not stored without an image identifier
+	 */
+	result = libvshadow_shared_cache_write_block(
+	          shared_cache,
+	          5,
+	          block_data,
+	          LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_shared_cache_set_image_identifier(
+	          shared_cache,
+	          0x1234,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_shared_cache_read_block(
+	          shared_cache,
+	          5,
+	          16,
+	          buffer,
+	          64,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_shared_cache_write_block(
+	          shared_cache,
+	          5,
+	          block_data,
+	          LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_shared_cache_read_block(
+	          shared_cache,
+	          5,
+	          16,
+	          buffer,
+	          64,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          &( block_data[ 16 ] ),
+	          64 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test that a block is stored only once
+	 */
+	result = libvshadow_shared_cache_write_block(
+	          shared_cache,
+	          5,
+	          block_data,
+	          LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_shared_cache_get_statistics(
+	          shared_cache,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_hits",
+	 number_of_hits,
+	 (uint64_t) 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_misses",
+	 number_of_misses,
+	 (uint64_t) 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that another mapping of the shared memory object sees the block
+	 */
+	result = libvshadow_shared_cache_initialize(
+	          &other_shared_cache,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_shared_cache_open(
+	          other_shared_cache,
+	          name,
+	          2 * 1024 * 1024,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "other_shared_cache->number_of_sets",
+	 other_shared_cache->number_of_sets,
+	 shared_cache->number_of_sets );
+
+	result = libvshadow_shared_cache_set_image_identifier(
+	          other_shared_cache,
+	          0x5678,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_shared_cache_read_block(
+	          other_shared_cache,
+	          5,
+	          0,
+	          buffer,
+	          64,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_shared_cache_set_image_identifier(
+	          other_shared_cache,
+	          0x1234,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_shared_cache_read_block(
+	          other_shared_cache,
+	          5,
+	          0,
+	          buffer,
+	          64,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          buffer,
+	          block_data,
+	          64 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test that blocks are evicted when more blocks map to a set than it has slots
+	 */
+	set_index = libvshadow_shared_cache_get_set_index(
+	             shared_cache,
+	             5 );
+
+	VSHADOW_TEST_ASSERT_LESS_THAN_UINT64(
+	 "set_index",
+	 set_index,
+	 shared_cache->number_of_sets );
+
+	for( block_number = 1000;
+	     number_of_blocks < ( 2 * LIBVSHADOW_SHARED_CACHE_NUMBER_OF_WAYS );
+	     block_number++ )
+	{
+		if( libvshadow_shared_cache_get_set_index(
+		     shared_cache,
+		     block_number ) != set_index )
+		{
+			continue;
+		}
+		result = libvshadow_shared_cache_write_block(
+		          shared_cache,
+		          block_number,
+		          block_data,
+		          LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		number_of_blocks++;
+	}
+	number_of_blocks = 0;
+
+	for( block_number = 5;
+	     number_of_blocks <= ( 2 * LIBVSHADOW_SHARED_CACHE_NUMBER_OF_WAYS );
+	     block_number++ )
+	{
+		if( libvshadow_shared_cache_get_set_index(
+		     shared_cache,
+		     block_number ) != set_index )
+		{
+			continue;
+		}
+		result = libvshadow_shared_cache_read_block(
+		          shared_cache,
+		          block_number,
+		          0,
+		          buffer,
+		          64,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( result == 1 )
+		{
+			number_of_cached_blocks++;
+		}
+		number_of_blocks++;
+
+		if( block_number == 5 )
+		{
+			block_number = 999;
+		}
+	}
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_cached_blocks",
+	 number_of_cached_blocks,
+	 (uint32_t) LIBVSHADOW_SHARED_CACHE_NUMBER_OF_WAYS );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "shared_cache->header->number_of_evictions",
+	 shared_cache->header->number_of_evictions,
+	 (uint64_t) LIBVSHADOW_SHARED_CACHE_NUMBER_OF_WAYS + 1 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_shared_cache_read_block(
+	          NULL,
+	          5,
+	          0,
+	          buffer,
+	          64,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_shared_cache_read_block(
+	          shared_cache,
+	          5,
+	          0,
+	          NULL,
+	          64,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_shared_cache_read_block(
+	          shared_cache,
+	          5,
+	          LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE - 16,
+	          buffer,
+	          64,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_shared_cache_write_block(
+	          NULL,
+	          5,
+	          block_data,
+	          LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_shared_cache_write_block(
+	          shared_cache,
+	          5,
+	          NULL,
+	          LIBVSHADOW_SHARED_CACHE_BLOCK_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_shared_cache_write_block(
+	          shared_cache,
+	          5,
+	          block_data,
+	          64,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_shared_cache_get_statistics(
+	          NULL,
+	          &number_of_hits,
+	          &number_of_misses,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_shared_cache_free(
+	          &other_shared_cache,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_shared_cache_free(
+	          &shared_cache,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_shared_cache_remove(
+	          name,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( other_shared_cache != NULL )
+	{
+		libvshadow_shared_cache_free(
+		 &other_shared_cache,
+		 NULL );
+	}
+	if( shared_cache != NULL )
+	{
+		libvshadow_shared_cache_free(
+		 &shared_cache,
+		 NULL );
+	}
+	libvshadow_shared_cache_remove(
+	 name,
+	 NULL );
+
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_shared_cache_initialize",
+	 vshadow_test_shared_cache_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_shared_cache_free",
+	 vshadow_test_shared_cache_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_shared_cache_check_name",
+	 vshadow_test_shared_cache_check_name );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_shared_cache_hash",
+	 vshadow_test_shared_cache_hash );
+
+#if defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_shared_cache_open",
+	 vshadow_test_shared_cache_open );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_shared_cache_read_write_block",
+	 vshadow_test_shared_cache_read_write_block );
+
+#endif /* defined( HAVE_LIBVSHADOW_SHARED_CACHE_SUPPORT ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+}
+
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -933,6 +934,192 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvshadow_store_set_maximum_read_ahead_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_set_maximum_read_ahead_size(
+     libvshadow_store_t *store )
+{
+	libcerror_error_t *error       = NULL;
+	size_t maximum_read_ahead_size = 0;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_store_set_maximum_read_ahead_size(
+	          store,
+	          4 * 1024 * 1024,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_get_maximum_read_ahead_size(
+	          store,
+	          &maximum_read_ahead_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "maximum_read_ahead_size",
+	 maximum_read_ahead_size,
+	 (size_t) 4 * 1024 * 1024 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Restore the default maximum read-ahead size, which disables read-ahead
+	 */
+	result = libvshadow_store_set_maximum_read_ahead_size(
+	          store,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_set_maximum_read_ahead_size(
+	          NULL,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_set_maximum_read_ahead_size(
+	          store,
+	          (size_t) 128 * 1024 * 1024,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_get_maximum_read_ahead_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_get_maximum_read_ahead_size(
+     libvshadow_store_t *store )
+{
+	libcerror_error_t *error       = NULL;
+	size_t maximum_read_ahead_size = 0;
+	int result                     = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_store_get_maximum_read_ahead_size(
+	          store,
+	          &maximum_read_ahead_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "maximum_read_ahead_size",
+	 maximum_read_ahead_size,
+	 (size_t) 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_get_maximum_read_ahead_size(
+	          NULL,
+	          &maximum_read_ahead_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_get_maximum_read_ahead_size(
+	          store,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libvshadow_store_get_size function
  * Returns 1 if successful or 0 if not
  */
@@ -1564,89 +1751,2209 @@ on_error:
 	return( 0 );
 }
 
-/* The main program
+/* Tests the libvshadow_store_get_data_source_at_offset function
+ * Returns 1 if successful or 0 if not
  */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-int wmain(
-     int argc,
-     wchar_t * const argv[] )
-#else
-int main(
-     int argc,
-     char * const argv[] )
-#endif
+int vshadow_test_store_get_data_source_at_offset(
+     libvshadow_store_t *store )
 {
-	libbfio_handle_t *file_io_handle  = NULL;
-	libcerror_error_t *error          = NULL;
-	libvshadow_store_t *store         = NULL;
-	libvshadow_volume_t *volume       = NULL;
-	system_character_t *option_offset = NULL;
-	system_character_t *source        = NULL;
-	system_integer_t option           = 0;
-	size_t string_length              = 0;
-	off64_t volume_offset             = 0;
-	int number_of_stores              = 0;
-	int result                        = 0;
-
-	while( ( option = vshadow_test_getopt(
-	                   argc,
-	                   argv,
-	                   _SYSTEM_STRING( "o:" ) ) ) != (system_integer_t) -1 )
-	{
-		switch( option )
-		{
-			case (system_integer_t) '?':
-			default:
-				fprintf(
-				 stderr,
-				 "Invalid argument: %" PRIs_SYSTEM ".\n",
-				 argv[ optind - 1 ] );
+	libcerror_error_t *error = NULL;
+	size64_t source_size     = 0;
+	off64_t source_offset    = 0;
+	int result               = 0;
+	int source_store_index   = 0;
+	int source_type          = 0;
 
-				return( EXIT_FAILURE );
+	/* Test regular cases
+	 */
+	result = libvshadow_store_get_data_source_at_offset(
+	          store,
+	          0,
+	          &source_type,
+	          &source_store_index,
+	          &source_offset,
+	          &source_size,
+	          &error );
 
-			case (system_integer_t) 'o':
-				option_offset = optarg;
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-				break;
-		}
-	}
-	if( optind < argc )
-	{
-		source = argv[ optind ];
-	}
-	if( option_offset != NULL )
-	{
-		string_length = system_string_length(
-		                 option_offset );
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		result = vshadow_test_system_string_copy_from_64_bit_in_decimal(
-		          option_offset,
-		          string_length + 1,
-		          (uint64_t *) &volume_offset,
-		          &error );
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+	 "source_type",
+	 source_type,
+	 0 );
 
-		VSHADOW_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "source_size",
+	 (int64_t) source_size,
+	 (int64_t) 0 );
 
-	        VSHADOW_TEST_ASSERT_IS_NULL(
-	         "error",
-	         error );
-	}
-#if defined( HAVE_DEBUG_OUTPUT ) && defined( VSHADOW_TEST_STORE_VERBOSE )
-	libvshadow_notify_set_verbose(
-	 1 );
-	libvshadow_notify_set_stream(
-	 stderr,
-	 NULL );
-#endif
+	/* Test error cases
+	 */
+	result = libvshadow_store_get_data_source_at_offset(
+	          NULL,
+	          0,
+	          &source_type,
+	          &source_store_index,
+	          &source_offset,
+	          &source_size,
+	          &error );
 
-#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	VSHADOW_TEST_RUN(
-	 "libvshadow_store_initialize",
-	 vshadow_test_store_initialize );
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_get_data_source_at_offset(
+	          store,
+	          -1,
+	          &source_type,
+	          &source_store_index,
+	          &source_offset,
+	          &source_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_get_data_source_at_offset(
+	          store,
+	          0,
+	          NULL,
+	          &source_store_index,
+	          &source_offset,
+	          &source_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_get_data_source_at_offset(
+	          store,
+	          0,
+	          &source_type,
+	          &source_store_index,
+	          &source_offset,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_get_data_source_at_offset function with volume test data
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_get_data_source_at_offset_with_test_data(
+     void )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libvshadow_store_t *store        = NULL;
+	libvshadow_volume_t *volume      = NULL;
+	uint8_t *volume_data             = NULL;
+	size64_t source_size             = 0;
+	off64_t source_offset            = 0;
+	int result                       = 0;
+	int source_store_index           = 0;
+	int source_type                  = 0;
+
+	/* Initialize test
+	 */
+	volume_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * VSHADOW_TEST_VOLUME_DATA_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_data",
+	 volume_data );
+
+	result = vshadow_test_write_volume_data(
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          0,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_open_file_io_handle(
+	          &file_io_handle,
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_volume_open_source(
+	          &volume,
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_store(
+	          volume,
+	          0,
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store",
+	 store );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a block that is stored in the store itself
+	 */
+	result = libvshadow_store_get_data_source_at_offset(
+	          store,
+	          VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ),
+	          &source_type,
+	          &source_store_index,
+	          &source_offset,
+	          &source_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "source_type",
+	 source_type,
+	 LIBVSHADOW_DATA_SOURCE_TYPE_STORE );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "source_store_index",
+	 source_store_index,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "source_offset",
+	 (int64_t) source_offset,
+	 (int64_t) VSHADOW_TEST_STORE_BLOCK_OFFSET( 0 ) );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "source_size",
+	 (uint64_t) source_size,
+	 (uint64_t) 0x4000 );
+
+	/* Test an offset within a block that is stored in the next store
+	 */
+	result = libvshadow_store_get_data_source_at_offset(
+	          store,
+	          VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 1 ) + 0x1000,
+	          &source_type,
+	          &source_store_index,
+	          &source_offset,
+	          &source_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "source_type",
+	 source_type,
+	 LIBVSHADOW_DATA_SOURCE_TYPE_NEXT_STORE );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "source_store_index",
+	 source_store_index,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "source_offset",
+	 (int64_t) source_offset,
+	 (int64_t) VSHADOW_TEST_STORE_BLOCK_OFFSET( 1 ) + 0x1000 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "source_size",
+	 (uint64_t) source_size,
+	 (uint64_t) 0x3000 );
+
+	/* Test a block that is not stored in any of the stores
+	 */
+	result = libvshadow_store_get_data_source_at_offset(
+	          store,
+	          0,
+	          &source_type,
+	          &source_store_index,
+	          &source_offset,
+	          &source_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "source_type",
+	 source_type,
+	 LIBVSHADOW_DATA_SOURCE_TYPE_VOLUME );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "source_store_index",
+	 source_store_index,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "source_offset",
+	 (int64_t) source_offset,
+	 (int64_t) 0 );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_free(
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_volume_close_source(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 volume_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( volume_data != NULL )
+	{
+		memory_free(
+		 volume_data );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_read_allocation_bitmap function with volume test data
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_read_allocation_bitmap_with_test_data(
+     void )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libvshadow_store_t *store        = NULL;
+	libvshadow_volume_t *volume      = NULL;
+	uint8_t *volume_data             = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	volume_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * VSHADOW_TEST_VOLUME_DATA_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_data",
+	 volume_data );
+
+	result = vshadow_test_write_volume_data(
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          0,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_open_file_io_handle(
+	          &file_io_handle,
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_volume_open_source(
+	          &volume,
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_store(
+	          volume,
+	          0,
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store",
+	 store );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * The volume data at offset 0 is not stored in the store, hence removing
+	 * the file system signature from the NTFS volume header of the volume test data
+	 * makes the store unsupported
+	 */
+	volume_data[ 3 ] = 0;
+
+	result = libvshadow_store_read_allocation_bitmap(
+	          store,
+	          &error );
+
+	volume_data[ 3 ] = 'N';
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_read_allocation_bitmap(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libvshadow_store_read_allocation_bitmap with a NTFS volume header
+	 * that refers to a $Bitmap MFT entry that is not present in the volume test data
+	 */
+	result = libvshadow_store_read_allocation_bitmap(
+	          store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_free(
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_volume_close_source(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 volume_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( volume_data != NULL )
+	{
+		memory_free(
+		 volume_data );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Tests the libvshadow_internal_store_read_allocated_data function with volume test data
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_read_allocated_data_with_test_data(
+     void )
+{
+	uint8_t buffer[ 0x8000 ];
+
+	libbfio_handle_t *file_io_handle                  = NULL;
+	libcerror_error_t *error                          = NULL;
+	libvshadow_allocation_bitmap_t *allocation_bitmap = NULL;
+	libvshadow_internal_store_t *internal_store       = NULL;
+	libvshadow_store_t *store                         = NULL;
+	libvshadow_volume_t *volume                       = NULL;
+	uint8_t *volume_data                              = NULL;
+	uint64_t cluster_block_number                     = 0;
+	ssize_t read_count                                = 0;
+	size_t buffer_index                               = 0;
+	uint32_t cluster_block_size                       = 0;
+	int result                                        = 0;
+
+	/* Initialize test
+	 */
+	volume_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * VSHADOW_TEST_VOLUME_DATA_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_data",
+	 volume_data );
+
+	result = vshadow_test_write_volume_data(
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          0,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_open_file_io_handle(
+	          &file_io_handle,
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_volume_open_source(
+	          &volume,
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_store(
+	          volume,
+	          0,
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store",
+	 store );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	/* Set an allocation bitmap in which the cluster block of the store block
+	 * is allocated and the cluster block that follows it is not
+	 */
+	result = libvshadow_allocation_bitmap_initialize(
+	          &allocation_bitmap,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_bitmap",
+	 allocation_bitmap );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	cluster_block_size = 0x4000;
+
+	allocation_bitmap->bitmap_data_size = VSHADOW_TEST_VOLUME_DATA_SIZE / ( cluster_block_size * 8 );
+
+	allocation_bitmap->bitmap_data = (uint8_t *) memory_allocate(
+	                                              sizeof( uint8_t ) * allocation_bitmap->bitmap_data_size );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "allocation_bitmap->bitmap_data",
+	 allocation_bitmap->bitmap_data );
+
+	memory_set(
+	 allocation_bitmap->bitmap_data,
+	 0xff,
+	 allocation_bitmap->bitmap_data_size );
+
+	allocation_bitmap->cluster_block_size       = cluster_block_size;
+	allocation_bitmap->number_of_cluster_blocks = (uint64_t) allocation_bitmap->bitmap_data_size * 8;
+
+	cluster_block_number = ( VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ) / cluster_block_size ) + 1;
+
+	allocation_bitmap->bitmap_data[ cluster_block_number / 8 ] &= (uint8_t) ~( 1 << ( cluster_block_number % 8 ) );
+
+	internal_store->allocation_bitmap = allocation_bitmap;
+	allocation_bitmap                 = NULL;
+
+	/* Test regular cases
+	 * The allocation bitmap is not read again once it has been set
+	 */
+	result = libvshadow_store_read_allocation_bitmap(
+	          store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_set(
+	 buffer,
+	 0xff,
+	 0x8000 );
+
+	read_count = libvshadow_internal_store_read_allocated_data(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              buffer,
+	              0x8000,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ),
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 0x8000 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The allocated cluster block contains the data of the store block
+	 */
+	for( buffer_index = 0;
+	     buffer_index < 0x4000;
+	     buffer_index++ )
+	{
+		if( buffer[ buffer_index ] != 0x80 )
+		{
+			break;
+		}
+	}
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "buffer_index",
+	 buffer_index,
+	 (size_t) 0x4000 );
+
+	/* The unallocated cluster block is filled with 0-byte values
+	 */
+	for( buffer_index = 0x4000;
+	     buffer_index < 0x8000;
+	     buffer_index++ )
+	{
+		if( buffer[ buffer_index ] != 0 )
+		{
+			break;
+		}
+	}
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "buffer_index",
+	 buffer_index,
+	 (size_t) 0x8000 );
+
+	/* Test error cases
+	 */
+	read_count = libvshadow_internal_store_read_allocated_data(
+	              NULL,
+	              internal_store->file_io_handle,
+	              buffer,
+	              0x8000,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ),
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvshadow_internal_store_read_allocated_data(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              NULL,
+	              0x8000,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ),
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvshadow_internal_store_read_allocated_data(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ),
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvshadow_internal_store_read_allocated_data(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              buffer,
+	              0x8000,
+	              -1,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test libvshadow_internal_store_read_allocated_data with an invalid allocation bitmap
+	 */
+	internal_store->allocation_bitmap->cluster_block_size = 0;
+
+	read_count = libvshadow_internal_store_read_allocated_data(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              buffer,
+	              0x8000,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ),
+	              &error );
+
+	internal_store->allocation_bitmap->cluster_block_size = cluster_block_size;
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_free(
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_volume_close_source(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 volume_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( allocation_bitmap != NULL )
+	{
+		libvshadow_allocation_bitmap_free(
+		 &allocation_bitmap,
+		 NULL );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( volume_data != NULL )
+	{
+		memory_free(
+		 volume_data );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_internal_store_read_data_with_read_ahead function with volume test data
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_read_data_with_read_ahead_with_test_data(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libbfio_handle_t *file_io_handle            = NULL;
+	libcerror_error_t *error                    = NULL;
+	libvshadow_internal_store_t *internal_store = NULL;
+	libvshadow_store_t *store                   = NULL;
+	libvshadow_volume_t *volume                 = NULL;
+	uint8_t *volume_data                        = NULL;
+	ssize_t read_count                          = 0;
+	size_t buffer_index                         = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	volume_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * VSHADOW_TEST_VOLUME_DATA_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_data",
+	 volume_data );
+
+	result = vshadow_test_write_volume_data(
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          0,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_open_file_io_handle(
+	          &file_io_handle,
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_volume_open_source(
+	          &volume,
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_store(
+	          volume,
+	          0,
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store",
+	 store );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_store = (libvshadow_internal_store_t *) store;
+
+	result = libvshadow_store_set_maximum_read_ahead_size(
+	          store,
+	          LIBVSHADOW_STORE_READ_AHEAD_MINIMUM_WINDOW_SIZE * 4,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 * Sequential reads grow the read-ahead window up to the maximum read-ahead size
+	 */
+	internal_store->read_ahead_next_offset = VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 );
+
+	read_count = libvshadow_internal_store_read_data_with_read_ahead(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              buffer,
+	              512,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ),
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "internal_store->read_ahead_window_size",
+	 internal_store->read_ahead_window_size,
+	 (size_t) LIBVSHADOW_STORE_READ_AHEAD_MINIMUM_WINDOW_SIZE );
+
+	for( buffer_index = 0;
+	     buffer_index < 512;
+	     buffer_index++ )
+	{
+		if( buffer[ buffer_index ] != 0x80 )
+		{
+			break;
+		}
+	}
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "buffer_index",
+	 buffer_index,
+	 (size_t) 512 );
+
+	read_count = libvshadow_internal_store_read_data_with_read_ahead(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              buffer,
+	              512,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ) + 512,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "internal_store->read_ahead_window_size",
+	 internal_store->read_ahead_window_size,
+	 (size_t) LIBVSHADOW_STORE_READ_AHEAD_MINIMUM_WINDOW_SIZE * 2 );
+
+	read_count = libvshadow_internal_store_read_data_with_read_ahead(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              buffer,
+	              512,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ) + 1024,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "internal_store->read_ahead_window_size",
+	 internal_store->read_ahead_window_size,
+	 (size_t) LIBVSHADOW_STORE_READ_AHEAD_MINIMUM_WINDOW_SIZE * 4 );
+
+	read_count = libvshadow_internal_store_read_data_with_read_ahead(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              buffer,
+	              512,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ) + 1536,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "internal_store->read_ahead_window_size",
+	 internal_store->read_ahead_window_size,
+	 (size_t) LIBVSHADOW_STORE_READ_AHEAD_MINIMUM_WINDOW_SIZE * 4 );
+
+	/* Non-sequential reads shrink the read-ahead window until it is smaller
+	 * than the minimum read-ahead window size
+	 */
+	read_count = libvshadow_internal_store_read_data_with_read_ahead(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              buffer,
+	              512,
+	              0,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "internal_store->read_ahead_window_size",
+	 internal_store->read_ahead_window_size,
+	 (size_t) LIBVSHADOW_STORE_READ_AHEAD_MINIMUM_WINDOW_SIZE * 2 );
+
+	read_count = libvshadow_internal_store_read_data_with_read_ahead(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              buffer,
+	              512,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ),
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "internal_store->read_ahead_window_size",
+	 internal_store->read_ahead_window_size,
+	 (size_t) LIBVSHADOW_STORE_READ_AHEAD_MINIMUM_WINDOW_SIZE );
+
+	read_count = libvshadow_internal_store_read_data_with_read_ahead(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              buffer,
+	              512,
+	              0,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "internal_store->read_ahead_window_size",
+	 internal_store->read_ahead_window_size,
+	 (size_t) 0 );
+
+	/* A sequential read after random access starts with the minimum read-ahead window size
+	 */
+	read_count = libvshadow_internal_store_read_data_with_read_ahead(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              buffer,
+	              512,
+	              512,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "internal_store->read_ahead_window_size",
+	 internal_store->read_ahead_window_size,
+	 (size_t) LIBVSHADOW_STORE_READ_AHEAD_MINIMUM_WINDOW_SIZE );
+
+	/* Test error cases
+	 */
+	read_count = libvshadow_internal_store_read_data_with_read_ahead(
+	              NULL,
+	              internal_store->file_io_handle,
+	              buffer,
+	              512,
+	              0,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvshadow_internal_store_read_data_with_read_ahead(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              NULL,
+	              512,
+	              0,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvshadow_internal_store_read_data_with_read_ahead(
+	              internal_store,
+	              internal_store->file_io_handle,
+	              buffer,
+	              512,
+	              -1,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_free(
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_volume_close_source(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 volume_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( volume_data != NULL )
+	{
+		memory_free(
+		 volume_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* Tests the libvshadow_store_borrow_data_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_borrow_data_at_offset(
+     libvshadow_store_t *store )
+{
+	libcerror_error_t *error = NULL;
+	const uint8_t *data      = NULL;
+	size_t data_size         = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 * The volume is opened using a file IO handle and is not memory mapped
+	 */
+	result = libvshadow_store_borrow_data_at_offset(
+	          store,
+	          0,
+	          &data,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "data",
+	 data );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_borrow_data_at_offset(
+	          NULL,
+	          0,
+	          &data,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_borrow_data_at_offset(
+	          store,
+	          -1,
+	          &data,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_borrow_data_at_offset(
+	          store,
+	          0,
+	          NULL,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_borrow_data_at_offset(
+	          store,
+	          0,
+	          &data,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_get_data_view function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_get_data_view(
+     libvshadow_store_t *store )
+{
+	libcerror_error_t *error          = NULL;
+	libvshadow_data_view_t *data_view = NULL;
+	size_t size                       = 0;
+	int number_of_segments            = 0;
+	int result                        = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_store_get_data_view(
+	          store,
+	          0,
+	          4096,
+	          &data_view,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "data_view",
+	 data_view );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_data_view_get_size(
+	          data_view,
+	          &size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "size",
+	 size,
+	 (size_t) 4096 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_data_view_get_number_of_segments(
+	          data_view,
+	          &number_of_segments,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+	 "number_of_segments",
+	 number_of_segments,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_data_view_free(
+	          &data_view,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "data_view",
+	 data_view );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_store_get_data_view(
+	          NULL,
+	          0,
+	          4096,
+	          &data_view,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_get_data_view(
+	          store,
+	          -1,
+	          4096,
+	          &data_view,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_get_data_view(
+	          store,
+	          0,
+	          (size_t) SSIZE_MAX + 1,
+	          &data_view,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_get_data_view(
+	          store,
+	          0,
+	          4096,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( data_view != NULL )
+	{
+		libvshadow_data_view_free(
+		 &data_view,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_store_map, libvshadow_store_unmap and libvshadow_store_get_number_of_mapping_read_errors functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_store_map(
+     libvshadow_store_t *store )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error  = NULL;
+	void *data                = NULL;
+	size64_t data_size        = 0;
+	ssize_t read_count        = 0;
+	int number_of_read_errors = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_store_map(
+	          store,
+	          &data,
+	          &data_size,
+	          &error );
+
+	/* Mapping is not supported on every platform and userfaultfd can be disabled
+	 */
+	if( result == -1 )
+	{
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	else
+	{
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "data",
+		 data );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( data_size >= 16 )
+		{
+			read_count = libvshadow_store_read_buffer_at_offset(
+			              store,
+			              buffer,
+			              16,
+			              0,
+			              &error );
+
+			VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) 16 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          data,
+			          buffer,
+			          16 );
+
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+		result = libvshadow_store_get_number_of_mapping_read_errors(
+		          store,
+		          &number_of_read_errors,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "number_of_read_errors",
+		 number_of_read_errors,
+		 0 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test mapping a store that is already mapped
+		 */
+		result = libvshadow_store_map(
+		          store,
+		          &data,
+		          &data_size,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvshadow_store_unmap(
+		          store,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libvshadow_store_map(
+	          NULL,
+	          &data,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_map(
+	          store,
+	          NULL,
+	          &data_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_map(
+	          store,
+	          &data,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_unmap(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test unmapping a store that is not mapped
+	 */
+	result = libvshadow_store_unmap(
+	          store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test retrieving the number of read errors of a store that is not mapped
+	 */
+	result = libvshadow_store_get_number_of_mapping_read_errors(
+	          store,
+	          &number_of_read_errors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_store_get_number_of_mapping_read_errors(
+	          NULL,
+	          &number_of_read_errors,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_get_number_of_mapping_read_errors(
+	          store,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc,
+     wchar_t * const argv[] )
+#else
+int main(
+     int argc,
+     char * const argv[] )
+#endif
+{
+	libbfio_handle_t *file_io_handle  = NULL;
+	libcerror_error_t *error          = NULL;
+	libvshadow_store_t *store         = NULL;
+	libvshadow_volume_t *volume       = NULL;
+	system_character_t *option_offset = NULL;
+	system_character_t *source        = NULL;
+	system_integer_t option           = 0;
+	size_t string_length              = 0;
+	off64_t volume_offset             = 0;
+	int number_of_stores              = 0;
+	int result                        = 0;
+
+	while( ( option = vshadow_test_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "o:" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM ".\n",
+				 argv[ optind - 1 ] );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'o':
+				option_offset = optarg;
+
+				break;
+		}
+	}
+	if( optind < argc )
+	{
+		source = argv[ optind ];
+	}
+	if( option_offset != NULL )
+	{
+		string_length = system_string_length(
+		                 option_offset );
+
+		result = vshadow_test_system_string_copy_from_64_bit_in_decimal(
+		          option_offset,
+		          string_length + 1,
+		          (uint64_t *) &volume_offset,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        VSHADOW_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+	}
+#if defined( HAVE_DEBUG_OUTPUT ) && defined( VSHADOW_TEST_STORE_VERBOSE )
+	libvshadow_notify_set_verbose(
+	 1 );
+	libvshadow_notify_set_stream(
+	 stderr,
+	 NULL );
+#endif
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_initialize",
+	 vshadow_test_store_initialize );
 
 #endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
 
@@ -1654,6 +3961,26 @@ int main(
 	 "libvshadow_store_free",
 	 vshadow_test_store_free );
 
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_get_data_source_at_offset",
+	 vshadow_test_store_get_data_source_at_offset_with_test_data );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_store_read_allocation_bitmap",
+	 vshadow_test_store_read_allocation_bitmap_with_test_data );
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_internal_store_read_allocated_data",
+	 vshadow_test_store_read_allocated_data_with_test_data );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_internal_store_read_data_with_read_ahead",
+	 vshadow_test_store_read_data_with_read_ahead_with_test_data );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -1806,6 +4133,16 @@ int main(
 			 vshadow_test_store_seek_offset,
 			 store );
 
+			VSHADOW_TEST_RUN_WITH_ARGS(
+			 "libvshadow_store_get_data_view",
+			 vshadow_test_store_get_data_view,
+			 store );
+
+			VSHADOW_TEST_RUN_WITH_ARGS(
+			 "libvshadow_store_map",
+			 vshadow_test_store_map,
+			 store );
+
 #if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
 
 			VSHADOW_TEST_RUN_WITH_ARGS(
@@ -1813,6 +4150,16 @@ int main(
 			 vshadow_test_store_get_offset,
 			 store );
 
+			VSHADOW_TEST_RUN_WITH_ARGS(
+			 "libvshadow_store_set_maximum_read_ahead_size",
+			 vshadow_test_store_set_maximum_read_ahead_size,
+			 store );
+
+			VSHADOW_TEST_RUN_WITH_ARGS(
+			 "libvshadow_store_get_maximum_read_ahead_size",
+			 vshadow_test_store_get_maximum_read_ahead_size,
+			 store );
+
 			VSHADOW_TEST_RUN_WITH_ARGS(
 			 "libvshadow_store_get_size",
 			 vshadow_test_store_get_size,
@@ -1852,6 +4199,16 @@ int main(
 
 			/* TODO add tests for libvshadow_store_get_block_by_index */
 
+			VSHADOW_TEST_RUN_WITH_ARGS(
+			 "libvshadow_store_get_data_source_at_offset",
+			 vshadow_test_store_get_data_source_at_offset,
+			 store );
+
+			VSHADOW_TEST_RUN_WITH_ARGS(
+			 "libvshadow_store_borrow_data_at_offset",
+			 vshadow_test_store_borrow_data_at_offset,
+			 store );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
 
 			result = libvshadow_store_free(
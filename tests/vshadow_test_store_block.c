@@ -33,6 +33,7 @@
 #include "vshadow_test_memory.h"
 #include "vshadow_test_unused.h"
 
+#include "../libvshadow/libvshadow_io_handle.h"
 #include "../libvshadow/libvshadow_store_block.h"
 
 uint8_t vshadow_test_store_block_header_data[ 128 ] = {
@@ -322,11 +323,29 @@ int vshadow_test_store_block_read(
 {
 	libbfio_handle_t *file_io_handle      = NULL;
 	libcerror_error_t *error              = NULL;
+	libvshadow_io_handle_t *io_handle     = NULL;
 	libvshadow_store_block_t *store_block = NULL;
 	int result                            = 0;
 
 	/* Initialize test
 	 */
+	result = libvshadow_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	result = libbfio_memory_range_initialize(
 	          &file_io_handle,
 	          &error );
@@ -396,8 +415,10 @@ int vshadow_test_store_block_read(
 	 */
 	result = libvshadow_store_block_read(
 	          store_block,
+	          io_handle,
 	          file_io_handle,
 	          0,
+	          0,
 	          &error );
 
 	VSHADOW_TEST_FPRINT_ERROR( error );
@@ -415,8 +436,10 @@ int vshadow_test_store_block_read(
 	 */
 	result = libvshadow_store_block_read(
 	          NULL,
+	          io_handle,
 	          file_io_handle,
 	          0,
+	          0,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -434,6 +457,8 @@ int vshadow_test_store_block_read(
 	result = libvshadow_store_block_read(
 	          store_block,
 	          NULL,
+	          file_io_handle,
+	          0,
 	          0,
 	          &error );
 
@@ -451,8 +476,30 @@ int vshadow_test_store_block_read(
 
 	result = libvshadow_store_block_read(
 	          store_block,
+	          io_handle,
+	          NULL,
+	          0,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_store_block_read(
+	          store_block,
+	          io_handle,
 	          file_io_handle,
 	          -1,
+	          0,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -516,6 +563,23 @@ int vshadow_test_store_block_read(
 	 "error",
 	 error );
 
+	result = libvshadow_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -536,6 +600,12 @@ on_error:
 		 &file_io_handle,
 		 NULL );
 	}
+	if( io_handle != NULL )
+	{
+		libvshadow_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
 	return( 0 );
 }
 
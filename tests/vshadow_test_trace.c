@@ -0,0 +1,826 @@
+/*
+ * Library trace type test program
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vshadow_test_libbfio.h"
+#include "vshadow_test_libcerror.h"
+#include "vshadow_test_libvshadow.h"
+#include "vshadow_test_macros.h"
+#include "vshadow_test_memory.h"
+#include "vshadow_test_unused.h"
+
+#include "../libvshadow/libvshadow_trace.h"
+#include "../libvshadow/vshadow_trace.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Tests the libvshadow_trace_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_trace_initialize(
+     void )
+{
+	libcerror_error_t *error  = NULL;
+	libvshadow_trace_t *trace = NULL;
+	int result                = 0;
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 2;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvshadow_trace_initialize(
+	          &trace,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "trace",
+	 trace );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_trace_free(
+	          &trace,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "trace",
+	 trace );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_trace_initialize(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	trace = (libvshadow_trace_t *) 0x12345678UL;
+
+	result = libvshadow_trace_initialize(
+	          &trace,
+	          &error );
+
+	trace = NULL;
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VSHADOW_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_trace_initialize with malloc failing
+		 */
+		vshadow_test_malloc_attempts_before_fail = test_number;
+
+		result = libvshadow_trace_initialize(
+		          &trace,
+		          &error );
+
+		if( vshadow_test_malloc_attempts_before_fail != -1 )
+		{
+			vshadow_test_malloc_attempts_before_fail = -1;
+
+			if( trace != NULL )
+			{
+				libvshadow_trace_free(
+				 &trace,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "trace",
+			 trace );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvshadow_trace_initialize with memset failing
+		 */
+		vshadow_test_memset_attempts_before_fail = test_number;
+
+		result = libvshadow_trace_initialize(
+		          &trace,
+		          &error );
+
+		if( vshadow_test_memset_attempts_before_fail != -1 )
+		{
+			vshadow_test_memset_attempts_before_fail = -1;
+
+			if( trace != NULL )
+			{
+				libvshadow_trace_free(
+				 &trace,
+				 NULL );
+			}
+		}
+		else
+		{
+			VSHADOW_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VSHADOW_TEST_ASSERT_IS_NULL(
+			 "trace",
+			 trace );
+
+			VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VSHADOW_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( trace != NULL )
+	{
+		libvshadow_trace_free(
+		 &trace,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_trace_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_trace_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvshadow_trace_free(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_trace_get_timestamp function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_trace_get_timestamp(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	uint64_t end_timestamp   = 0;
+	uint64_t start_timestamp = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_trace_get_timestamp(
+	          &start_timestamp,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_trace_get_timestamp(
+	          &end_timestamp,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The clock is monotonic
+	 */
+	result = ( end_timestamp >= start_timestamp );
+
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_trace_get_timestamp(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_trace_open, libvshadow_trace_append_record and libvshadow_trace_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_trace_append_record(
+     void )
+{
+	uint8_t trace_data[ 65536 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libvshadow_trace_t *trace        = NULL;
+	uint8_t *record_data             = NULL;
+	uint64_t value_64bit             = 0;
+	uint32_t value_32bit             = 0;
+	uint16_t value_16bit             = 0;
+	int record_index                 = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_trace_initialize(
+	          &trace,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "trace",
+	 trace );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          trace_data,
+	          65536,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_trace_append_record(
+	          trace,
+	          0,
+	          0,
+	          0,
+	          0,
+	          512,
+	          0,
+	          0,
+	          LIBVSHADOW_TRACE_READ_TYPE_STORE_DATA,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_trace_open(
+	          NULL,
+	          file_io_handle,
+	          0x100000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_trace_open(
+	          trace,
+	          NULL,
+	          0x100000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_trace_open(
+	          trace,
+	          file_io_handle,
+	          0x100000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_trace_open(
+	          trace,
+	          file_io_handle,
+	          0x100000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Fill the buffer so that the records are written before the trace is closed
+	 */
+	for( record_index = 0;
+	     record_index < LIBVSHADOW_TRACE_MAXIMUM_NUMBER_OF_BUFFERED_RECORDS;
+	     record_index++ )
+	{
+		result = libvshadow_trace_append_record(
+		          trace,
+		          trace->start_timestamp + 1000,
+		          trace->start_timestamp + 1500,
+		          (off64_t) record_index * 16384,
+		          (off64_t) record_index * 512,
+		          16384,
+		          1,
+		          LIBVSHADOW_TRACE_STORE_INDEX_NONE,
+		          LIBVSHADOW_TRACE_READ_TYPE_STORE_DATA,
+		          0,
+		          &error );
+
+		VSHADOW_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VSHADOW_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "trace->number_of_records",
+	 trace->number_of_records,
+	 (uint64_t) LIBVSHADOW_TRACE_MAXIMUM_NUMBER_OF_BUFFERED_RECORDS );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "trace->number_of_buffered_records",
+	 trace->number_of_buffered_records,
+	 0 );
+
+	/* The latency is 0 if the end timestamp precedes the start timestamp
+	 */
+	result = libvshadow_trace_append_record(
+	          trace,
+	          trace->start_timestamp + 2000,
+	          trace->start_timestamp,
+	          0x1e00,
+	          0x1e00,
+	          16384,
+	          2,
+	          2,
+	          LIBVSHADOW_TRACE_READ_TYPE_STORE_METADATA,
+	          LIBVSHADOW_TRACE_RECORD_FLAG_READ_FAILED,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_trace_close(
+	          trace,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "trace->number_of_records",
+	 trace->number_of_records,
+	 (uint64_t) LIBVSHADOW_TRACE_MAXIMUM_NUMBER_OF_BUFFERED_RECORDS + 1 );
+
+	/* Check the file header
+	 */
+	result = memory_compare(
+	          trace_data,
+	          "vshtrace",
+	          8 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vshadow_trace_file_header_t *) trace_data )->record_size,
+	 value_32bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "record_size",
+	 value_32bit,
+	 (uint32_t) sizeof( vshadow_trace_record_t ) );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vshadow_trace_file_header_t *) trace_data )->volume_size,
+	 value_64bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "volume_size",
+	 value_64bit,
+	 (uint64_t) 0x100000 );
+
+	/* Check the second record
+	 */
+	record_data = &( trace_data[ sizeof( vshadow_trace_file_header_t ) + sizeof( vshadow_trace_record_t ) ] );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vshadow_trace_record_t *) record_data )->timestamp,
+	 value_64bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "timestamp",
+	 value_64bit,
+	 (uint64_t) 1000 );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vshadow_trace_record_t *) record_data )->physical_offset,
+	 value_64bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "physical_offset",
+	 value_64bit,
+	 (uint64_t) 16384 );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vshadow_trace_record_t *) record_data )->volume_offset,
+	 value_64bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT64(
+	 "volume_offset",
+	 value_64bit,
+	 (uint64_t) 512 );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vshadow_trace_record_t *) record_data )->latency,
+	 value_32bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "latency",
+	 value_32bit,
+	 (uint32_t) 500 );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 ( (vshadow_trace_record_t *) record_data )->data_store_index,
+	 value_16bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT16(
+	 "data_store_index",
+	 value_16bit,
+	 (uint16_t) LIBVSHADOW_TRACE_STORE_INDEX_NONE );
+
+	/* Check the last record
+	 */
+	record_data = &( trace_data[ sizeof( vshadow_trace_file_header_t ) + ( LIBVSHADOW_TRACE_MAXIMUM_NUMBER_OF_BUFFERED_RECORDS * sizeof( vshadow_trace_record_t ) ) ] );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vshadow_trace_record_t *) record_data )->latency,
+	 value_32bit );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "latency",
+	 value_32bit,
+	 (uint32_t) 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "read_type",
+	 ( (vshadow_trace_record_t *) record_data )->read_type,
+	 (uint8_t) LIBVSHADOW_TRACE_READ_TYPE_STORE_METADATA );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "flags",
+	 ( (vshadow_trace_record_t *) record_data )->flags,
+	 (uint8_t) LIBVSHADOW_TRACE_RECORD_FLAG_READ_FAILED );
+
+	/* Test error cases
+	 */
+	result = libvshadow_trace_close(
+	          trace,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_trace_free(
+	          &trace,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "trace",
+	 trace );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( trace != NULL )
+	{
+		libvshadow_trace_free(
+		 &trace,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VSHADOW_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VSHADOW_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argc )
+	VSHADOW_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_trace_initialize",
+	 vshadow_test_trace_initialize );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_trace_free",
+	 vshadow_test_trace_free );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_trace_get_timestamp",
+	 vshadow_test_trace_get_timestamp );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_trace_append_record",
+	 vshadow_test_trace_append_record );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+on_error:
+	return( EXIT_FAILURE );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+}
+
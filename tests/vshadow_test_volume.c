@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -38,6 +39,8 @@
 #include "vshadow_test_macros.h"
 #include "vshadow_test_memory.h"
 
+#include "../libvshadow/libvshadow_io_handle.h"
+#include "../libvshadow/libvshadow_store.h"
 #include "../libvshadow/libvshadow_volume.h"
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER ) && SIZEOF_WCHAR_T != 2 && SIZEOF_WCHAR_T != 4
@@ -1233,37 +1236,2019 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvshadow_volume_refresh function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_refresh(
+     libvshadow_volume_t *volume )
+{
+	libcerror_error_t *error           = NULL;
+	libvshadow_volume_t *closed_volume = NULL;
+	int number_of_stores               = 0;
+	int refreshed_number_of_stores     = 0;
+	int result                         = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_refresh(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &refreshed_number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "refreshed_number_of_stores",
+	 refreshed_number_of_stores,
+	 number_of_stores );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_refresh(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_initialize(
+	          &closed_volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "closed_volume",
+	 closed_volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_refresh(
+	          closed_volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_free(
+	          &closed_volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "closed_volume",
+	 closed_volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( closed_volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &closed_volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+/* Tests the libvshadow_volume_refresh function with volume test data to which stores are added and removed
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_refresh_with_test_data(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libvshadow_store_t *store        = NULL;
+	libvshadow_volume_t *volume      = NULL;
+	uint8_t *volume_data             = NULL;
+	size64_t source_size             = 0;
+	ssize_t read_count               = 0;
+	off64_t source_offset            = 0;
+	uint32_t number_of_refreshes     = 0;
+	int number_of_stores             = 0;
+	int result                       = 0;
+	int source_store_index           = 0;
+	int source_type                  = 0;
+
+	/* Initialize test
+	 */
+	volume_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * VSHADOW_TEST_VOLUME_DATA_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_data",
+	 volume_data );
+
+	result = vshadow_test_write_volume_data(
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          0,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_open_file_io_handle(
+	          &file_io_handle,
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_volume_open_source(
+	          &volume,
+	          file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	number_of_refreshes = ( (libvshadow_internal_volume_t *) volume )->io_handle->number_of_refreshes;
+
+	result = libvshadow_volume_get_store(
+	          volume,
+	          0,
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store",
+	 store );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Without a next store the block of the second store is read from the volume
+	 */
+	result = libvshadow_store_get_data_source_at_offset(
+	          store,
+	          VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 1 ),
+	          &source_type,
+	          &source_store_index,
+	          &source_offset,
+	          &source_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "source_type",
+	 source_type,
+	 LIBVSHADOW_DATA_SOURCE_TYPE_VOLUME );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "source_offset",
+	 (int64_t) source_offset,
+	 (int64_t) VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 1 ) );
+
+	/* Fill the read-ahead buffer with the data of the block of the second store
+	 * using 2 sequential reads
+	 */
+	result = libvshadow_store_set_maximum_read_ahead_size(
+	          store,
+	          0x40000,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvshadow_store_read_buffer_at_offset(
+	              store,
+	              buffer,
+	              512,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 1 ) - 0x1000,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvshadow_store_read_buffer_at_offset(
+	              store,
+	              buffer,
+	              512,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 1 ) - 0x0e00,
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "read_ahead_data_offset",
+	 (int64_t) ( (libvshadow_internal_store_t *) store )->read_ahead_data_offset,
+	 (int64_t) VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 1 ) - 0x0e00 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SIZE(
+	 "read_ahead_data_size",
+	 ( (libvshadow_internal_store_t *) store )->read_ahead_data_size,
+	 (size_t) 0x40000 );
+
+	read_count = libvshadow_store_read_buffer_at_offset(
+	              store,
+	              buffer,
+	              512,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 1 ),
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 (uint8_t) 0 );
+
+	/* Test refresh after a store was appended to the catalog
+	 */
+	result = vshadow_test_write_volume_data(
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          0,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_refresh(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_stores",
+	 number_of_stores,
+	 2 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_refreshes",
+	 ( (libvshadow_internal_volume_t *) volume )->io_handle->number_of_refreshes,
+	 number_of_refreshes + 1 );
+
+	/* The first store is linked to the appended store
+	 */
+	result = libvshadow_store_get_data_source_at_offset(
+	          store,
+	          VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 1 ),
+	          &source_type,
+	          &source_store_index,
+	          &source_offset,
+	          &source_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "source_type",
+	 source_type,
+	 LIBVSHADOW_DATA_SOURCE_TYPE_NEXT_STORE );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "source_store_index",
+	 source_store_index,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "source_offset",
+	 (int64_t) source_offset,
+	 (int64_t) VSHADOW_TEST_STORE_BLOCK_OFFSET( 1 ) );
+
+	/* The read-ahead buffer was filled before the refresh and is not used
+	 */
+	read_count = libvshadow_store_read_buffer_at_offset(
+	              store,
+	              buffer,
+	              512,
+	              VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 1 ),
+	              &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 512 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 0 ]",
+	 buffer[ 0 ],
+	 (uint8_t) 0x81 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT8(
+	 "buffer[ 511 ]",
+	 buffer[ 511 ],
+	 (uint8_t) 0x81 );
+
+	/* Test refresh after a store was removed from the catalog
+	 */
+	result = vshadow_test_write_volume_data(
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          1,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_refresh(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_stores",
+	 number_of_stores,
+	 2 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_refreshes",
+	 ( (libvshadow_internal_volume_t *) volume )->io_handle->number_of_refreshes,
+	 number_of_refreshes + 1 );
+
+	/* Clean up
+	 */
+	result = libvshadow_store_free(
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_volume_close_source(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 volume_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( volume_data != NULL )
+	{
+		memory_free(
+		 volume_data );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_read_metadata function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_read_metadata(
+     void )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libvshadow_volume_t *volume      = NULL;
+	uint8_t *volume_data             = NULL;
+	size64_t metadata_memory_size    = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	volume_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * VSHADOW_TEST_VOLUME_DATA_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_data",
+	 volume_data );
+
+	result = vshadow_test_write_volume_data(
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          0,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_open_file_io_handle(
+	          &file_io_handle,
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_read_metadata(
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test read metadata of a volume that is not open
+	 */
+	result = libvshadow_volume_read_metadata(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_open_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_read_metadata(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_metadata_memory_size(
+	          volume,
+	          &metadata_memory_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_NOT_EQUAL_INT64(
+	 "metadata_memory_size",
+	 (int64_t) metadata_memory_size,
+	 (int64_t) 0 );
+
+	/* Test read metadata that was read before
+	 */
+	result = libvshadow_volume_read_metadata(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test read metadata of a volume that was closed
+	 */
+	result = libvshadow_volume_close(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_read_metadata(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 volume_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( volume_data != NULL )
+	{
+		memory_free(
+		 volume_data );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_get_references_at_physical_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_get_references_at_physical_offset(
+     void )
+{
+	off64_t volume_offsets[ 4 ];
+	int store_indexes[ 4 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libvshadow_volume_t *volume      = NULL;
+	uint8_t *volume_data             = NULL;
+	int number_of_references         = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	volume_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * VSHADOW_TEST_VOLUME_DATA_SIZE );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_data",
+	 volume_data );
+
+	result = vshadow_test_write_volume_data(
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          0,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_open_file_io_handle(
+	          &file_io_handle,
+	          volume_data,
+	          VSHADOW_TEST_VOLUME_DATA_SIZE,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test references of a volume that is not open
+	 */
+	result = libvshadow_volume_get_references_at_physical_offset(
+	          volume,
+	          VSHADOW_TEST_STORE_BLOCK_OFFSET( 0 ),
+	          store_indexes,
+	          volume_offsets,
+	          4,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_open_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          LIBVSHADOW_OPEN_READ,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The block of the store is referenced by the store at its original offset
+	 */
+	result = libvshadow_volume_get_references_at_physical_offset(
+	          volume,
+	          VSHADOW_TEST_STORE_BLOCK_OFFSET( 0 ) + 0x200,
+	          store_indexes,
+	          volume_offsets,
+	          4,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_references",
+	 number_of_references,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "store_indexes[ 0 ]",
+	 store_indexes[ 0 ],
+	 0 );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT64(
+	 "volume_offsets[ 0 ]",
+	 (int64_t) volume_offsets[ 0 ],
+	 (int64_t) VSHADOW_TEST_STORE_BLOCK_ORIGINAL_OFFSET( 0 ) + 0x200 );
+
+	/* Test that only the number of references is determined when no references can be stored
+	 */
+	result = libvshadow_volume_get_references_at_physical_offset(
+	          volume,
+	          VSHADOW_TEST_STORE_BLOCK_OFFSET( 0 ),
+	          NULL,
+	          NULL,
+	          0,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_references",
+	 number_of_references,
+	 1 );
+
+	/* Test a physical offset that is not referenced by a store
+	 */
+	result = libvshadow_volume_get_references_at_physical_offset(
+	          volume,
+	          VSHADOW_TEST_CATALOG_OFFSET,
+	          store_indexes,
+	          volume_offsets,
+	          4,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "number_of_references",
+	 number_of_references,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_get_references_at_physical_offset(
+	          NULL,
+	          VSHADOW_TEST_STORE_BLOCK_OFFSET( 0 ),
+	          store_indexes,
+	          volume_offsets,
+	          4,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_references_at_physical_offset(
+	          volume,
+	          -1,
+	          store_indexes,
+	          volume_offsets,
+	          4,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_references_at_physical_offset(
+	          volume,
+	          VSHADOW_TEST_STORE_BLOCK_OFFSET( 0 ),
+	          NULL,
+	          volume_offsets,
+	          4,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_references_at_physical_offset(
+	          volume,
+	          VSHADOW_TEST_STORE_BLOCK_OFFSET( 0 ),
+	          store_indexes,
+	          NULL,
+	          4,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_references_at_physical_offset(
+	          volume,
+	          VSHADOW_TEST_STORE_BLOCK_OFFSET( 0 ),
+	          store_indexes,
+	          volume_offsets,
+	          -1,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_references_at_physical_offset(
+	          volume,
+	          VSHADOW_TEST_STORE_BLOCK_OFFSET( 0 ),
+	          store_indexes,
+	          volume_offsets,
+	          4,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test references of a volume that was closed
+	 */
+	result = libvshadow_volume_close(
+	          volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvshadow_volume_get_references_at_physical_offset(
+	          volume,
+	          VSHADOW_TEST_STORE_BLOCK_OFFSET( 0 ),
+	          store_indexes,
+	          volume_offsets,
+	          4,
+	          &number_of_references,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vshadow_test_close_file_io_handle(
+	          &file_io_handle,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 volume_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( volume_data != NULL )
+	{
+		memory_free(
+		 volume_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
 /* Tests the libvshadow_volume_get_size function
  * Returns 1 if successful or 0 if not
  */
-int vshadow_test_volume_get_size(
+int vshadow_test_volume_get_size(
+     libvshadow_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_get_size(
+	          volume,
+	          &size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_get_size(
+	          NULL,
+	          &size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_size(
+	          volume,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_get_number_of_stores function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_get_number_of_stores(
+     libvshadow_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	int number_of_stores     = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_get_number_of_stores(
+	          NULL,
+	          &number_of_stores,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_number_of_stores(
+	          volume,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_get_store function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_get_store(
+     libvshadow_volume_t *volume )
+{
+	libcerror_error_t *error  = NULL;
+	libvshadow_store_t *store = NULL;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_get_store(
+	          volume,
+	          0,
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "store",
+	 store );
+
+	result = libvshadow_store_free(
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_get_store(
+	          NULL,
+	          0,
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "store",
+	 store );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_store(
+	          volume,
+	          -1,
+	          &store,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "store",
+	 store );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_store(
+	          volume,
+	          0,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "store",
+	 store );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_set_metadata_memory_limit function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_set_metadata_memory_limit(
+     libvshadow_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_set_metadata_memory_limit(
+	          volume,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset the metadata memory limit to no maximum
+	 */
+	result = libvshadow_volume_set_metadata_memory_limit(
+	          volume,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_set_metadata_memory_limit(
+	          NULL,
+	          1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_get_metadata_memory_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_get_metadata_memory_size(
+     libvshadow_volume_t *volume )
+{
+	libcerror_error_t *error      = NULL;
+	size64_t metadata_memory_size = 0;
+	int result                    = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_get_metadata_memory_size(
+	          volume,
+	          &metadata_memory_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_get_metadata_memory_size(
+	          NULL,
+	          &metadata_memory_size,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_metadata_memory_size(
+	          volume,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_get_number_of_metadata_evictions function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_get_number_of_metadata_evictions(
      libvshadow_volume_t *volume )
 {
-	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	int result               = 0;
+	libcerror_error_t *error              = NULL;
+	uint64_t number_of_metadata_evictions = 0;
+	int result                            = 0;
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_get_number_of_metadata_evictions(
+	          volume,
+	          &number_of_metadata_evictions,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_get_number_of_metadata_evictions(
+	          NULL,
+	          &number_of_metadata_evictions,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_number_of_metadata_evictions(
+	          volume,
+	          NULL,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_set_number_of_read_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_set_number_of_read_threads(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	libvshadow_volume_t *volume = NULL;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_set_number_of_read_threads(
+	          volume,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	result = libvshadow_volume_set_number_of_read_threads(
+	          volume,
+	          2,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_set_number_of_read_threads(
+	          NULL,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_set_number_of_read_threads(
+	          volume,
+	          -1,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvshadow_volume_set_shared_cache function
+ * Returns 1 if successful or 0 if not
+ */
+int vshadow_test_volume_set_shared_cache(
+     void )
+{
+	uint8_t image_identifier[ 8 ] = {
+		0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08 };
+
+	libcerror_error_t *error      = NULL;
+	libvshadow_volume_t *volume   = NULL;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvshadow_volume_set_shared_cache(
+	          volume,
+	          NULL,
+	          0,
+	          NULL,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvshadow_volume_set_shared_cache(
+	          NULL,
+	          NULL,
+	          0,
+	          NULL,
+	          0,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	/* Test regular cases
-	 */
-	result = libvshadow_volume_get_size(
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_set_shared_cache(
 	          volume,
-	          &size,
+	          "vshadow_test",
+	          1024 * 1024,
+	          image_identifier,
+	          8,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-	VSHADOW_TEST_ASSERT_IS_NULL(
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libvshadow_volume_get_size(
-	          NULL,
-	          &size,
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_set_shared_cache(
+	          volume,
+	          "/vshadow_test",
+	          0,
+	          image_identifier,
+	          8,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -1278,9 +3263,32 @@ int vshadow_test_volume_get_size(
 	libcerror_error_free(
 	 &error );
 
-	result = libvshadow_volume_get_size(
+	result = libvshadow_volume_set_shared_cache(
 	          volume,
+	          "/vshadow_test",
+	          1024 * 1024,
 	          NULL,
+	          8,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_set_shared_cache(
+	          volume,
+	          "/vshadow_test",
+	          1024 * 1024,
+	          image_identifier,
+	          0,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -1295,6 +3303,25 @@ int vshadow_test_volume_get_size(
 	libcerror_error_free(
 	 &error );
 
+	/* Clean up
+	 */
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -1303,30 +3330,58 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libvshadow_volume_get_number_of_stores function
+/* Tests the libvshadow_volume_get_shared_cache_statistics function
  * Returns 1 if successful or 0 if not
  */
-int vshadow_test_volume_get_number_of_stores(
-     libvshadow_volume_t *volume )
+int vshadow_test_volume_get_shared_cache_statistics(
+     void )
 {
-	libcerror_error_t *error = NULL;
-	int number_of_stores     = 0;
-	int result               = 0;
+	libcerror_error_t *error    = NULL;
+	libvshadow_volume_t *volume = NULL;
+	uint64_t number_of_hits     = 0;
+	uint64_t number_of_misses   = 0;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test regular cases
 	 */
-	result = libvshadow_volume_get_number_of_stores(
+	result = libvshadow_volume_get_shared_cache_statistics(
 	          volume,
-	          &number_of_stores,
+	          &number_of_hits,
+	          &number_of_misses,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 0 );
 
 	VSHADOW_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -1334,9 +3389,10 @@ int vshadow_test_volume_get_number_of_stores(
 
 	/* Test error cases
 	 */
-	result = libvshadow_volume_get_number_of_stores(
+	result = libvshadow_volume_get_shared_cache_statistics(
 	          NULL,
-	          &number_of_stores,
+	          &number_of_hits,
+	          &number_of_misses,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -1351,8 +3407,27 @@ int vshadow_test_volume_get_number_of_stores(
 	libcerror_error_free(
 	 &error );
 
-	result = libvshadow_volume_get_number_of_stores(
+	result = libvshadow_volume_get_shared_cache_statistics(
+	          volume,
+	          NULL,
+	          &number_of_misses,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvshadow_volume_get_shared_cache_statistics(
 	          volume,
+	          &number_of_hits,
 	          NULL,
 	          &error );
 
@@ -1368,6 +3443,25 @@ int vshadow_test_volume_get_number_of_stores(
 	libcerror_error_free(
 	 &error );
 
+	/* Clean up
+	 */
+	result = libvshadow_volume_free(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
 	return( 1 );
 
 on_error:
@@ -1376,25 +3470,49 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( volume != NULL )
+	{
+		libvshadow_volume_free(
+		 &volume,
+		 NULL );
+	}
 	return( 0 );
 }
 
-/* Tests the libvshadow_volume_get_store function
+/* Tests the libvshadow_volume_set_trace_file function
  * Returns 1 if successful or 0 if not
  */
-int vshadow_test_volume_get_store(
-     libvshadow_volume_t *volume )
+int vshadow_test_volume_set_trace_file(
+     void )
 {
-	libcerror_error_t *error  = NULL;
-	libvshadow_store_t *store = NULL;
-	int result                = 0;
+	libcerror_error_t *error    = NULL;
+	libvshadow_volume_t *volume = NULL;
+	int result                  = 0;
+
+	/* Initialize test
+	 */
+	result = libvshadow_volume_initialize(
+	          &volume,
+	          &error );
+
+	VSHADOW_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	VSHADOW_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test regular cases
 	 */
-	result = libvshadow_volume_get_store(
+	result = libvshadow_volume_set_trace_file(
 	          volume,
-	          0,
-	          &store,
+	          "vshadow_test.trace",
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -1406,12 +3524,11 @@ int vshadow_test_volume_get_store(
 	 "error",
 	 error );
 
-	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
-	 "store",
-	 store );
-
-	result = libvshadow_store_free(
-	          &store,
+	/* The trace file is only created when the volume is opened
+	 */
+	result = libvshadow_volume_set_trace_file(
+	          volume,
+	          NULL,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -1425,10 +3542,9 @@ int vshadow_test_volume_get_store(
 
 	/* Test error cases
 	 */
-	result = libvshadow_volume_get_store(
+	result = libvshadow_volume_set_trace_file(
 	          NULL,
-	          0,
-	          &store,
+	          "vshadow_test.trace",
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -1436,10 +3552,6 @@ int vshadow_test_volume_get_store(
 	 result,
 	 -1 );
 
-	VSHADOW_TEST_ASSERT_IS_NULL(
-	 "store",
-	 store );
-
 	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -1447,10 +3559,9 @@ int vshadow_test_volume_get_store(
 	libcerror_error_free(
 	 &error );
 
-	result = libvshadow_volume_get_store(
+	result = libvshadow_volume_set_trace_file(
 	          volume,
-	          -1,
-	          &store,
+	          "",
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
@@ -1458,10 +3569,6 @@ int vshadow_test_volume_get_store(
 	 result,
 	 -1 );
 
-	VSHADOW_TEST_ASSERT_IS_NULL(
-	 "store",
-	 store );
-
 	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
@@ -1469,28 +3576,25 @@ int vshadow_test_volume_get_store(
 	libcerror_error_free(
 	 &error );
 
-	result = libvshadow_volume_get_store(
-	          volume,
-	          0,
-	          NULL,
+	/* Clean up
+	 */
+	result = libvshadow_volume_free(
+	          &volume,
 	          &error );
 
 	VSHADOW_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
 	VSHADOW_TEST_ASSERT_IS_NULL(
-	 "store",
-	 store );
+	 "volume",
+	 volume );
 
-	VSHADOW_TEST_ASSERT_IS_NOT_NULL(
+	VSHADOW_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
 	return( 1 );
 
 on_error:
@@ -1499,10 +3603,10 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( store != NULL )
+	if( volume != NULL )
 	{
-		libvshadow_store_free(
-		 &store,
+		libvshadow_volume_free(
+		 &volume,
 		 NULL );
 	}
 	return( 0 );
@@ -1592,6 +3696,38 @@ int main(
 	 "libvshadow_volume_free",
 	 vshadow_test_volume_free );
 
+	VSHADOW_TEST_RUN(
+	 "libvshadow_volume_set_number_of_read_threads",
+	 vshadow_test_volume_set_number_of_read_threads );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_volume_set_shared_cache",
+	 vshadow_test_volume_set_shared_cache );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_volume_get_shared_cache_statistics",
+	 vshadow_test_volume_get_shared_cache_statistics );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_volume_set_trace_file",
+	 vshadow_test_volume_set_trace_file );
+
+#if defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT )
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_volume_refresh",
+	 vshadow_test_volume_refresh_with_test_data );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_volume_read_metadata",
+	 vshadow_test_volume_read_metadata );
+
+	VSHADOW_TEST_RUN(
+	 "libvshadow_volume_get_references_at_physical_offset",
+	 vshadow_test_volume_get_references_at_physical_offset );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -1730,6 +3866,11 @@ int main(
 
 #endif /* defined( __GNUC__ ) && !defined( LIBVSHADOW_DLL_IMPORT ) */
 
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "libvshadow_volume_refresh",
+		 vshadow_test_volume_refresh,
+		 volume );
+
 		VSHADOW_TEST_RUN_WITH_ARGS(
 		 "libvshadow_volume_get_size",
 		 vshadow_test_volume_get_size,
@@ -1747,6 +3888,21 @@ int main(
 
 		/* TODO: add tests for libvshadow_volume_get_store_identifier */
 
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "libvshadow_volume_set_metadata_memory_limit",
+		 vshadow_test_volume_set_metadata_memory_limit,
+		 volume );
+
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "libvshadow_volume_get_metadata_memory_size",
+		 vshadow_test_volume_get_metadata_memory_size,
+		 volume );
+
+		VSHADOW_TEST_RUN_WITH_ARGS(
+		 "libvshadow_volume_get_number_of_metadata_evictions",
+		 vshadow_test_volume_get_number_of_metadata_evictions,
+		 volume );
+
 		/* Clean up
 		 */
 		result = vshadow_test_volume_close_source(
@@ -0,0 +1,3814 @@
+/*
+ * Export handle
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "export_handle.h"
+#include "qcow2_writer.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcfile.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libuna.h"
+#include "vshadowtools_libvshadow.h"
+
+#if !defined( LIBVSHADOW_HAVE_BFIO )
+
+extern \
+int libvshadow_volume_open_file_io_handle(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libvshadow_error_t **error );
+
+extern \
+int libvshadow_check_volume_signature_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#endif /* !defined( LIBVSHADOW_HAVE_BFIO ) */
+
+#define EXPORT_HANDLE_NOTIFY_STREAM		stdout
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "export_handle_system_string_copy_from_64_bit_in_decimal";
+	system_character_t character_value = 0;
+	size_t string_index                = 0;
+	uint8_t maximum_string_index       = 20;
+	int8_t sign                        = 1;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	if( string[ string_index ] == (system_character_t) '-' )
+	{
+		string_index++;
+		maximum_string_index++;
+
+		sign = -1;
+	}
+	else if( string[ string_index ] == (system_character_t) '+' )
+	{
+		string_index++;
+		maximum_string_index++;
+	}
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	if( sign == -1 )
+	{
+		*value_64bit *= (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+/* Creates an export handle
+ * Make sure the value export_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_initialize(
+     export_handle_t **export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_initialize";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*export_handle = memory_allocate_structure(
+	                  export_handle_t );
+
+	if( *export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create export handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *export_handle,
+	     0,
+	     sizeof( export_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear export handle.",
+		 function );
+
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_file_range_initialize(
+	     &( ( *export_handle )->input_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_initialize(
+	     &( ( *export_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input volume.",
+		 function );
+
+		goto on_error;
+	}
+	( *export_handle )->store_index   = -1;
+	( *export_handle )->read_size     = EXPORT_HANDLE_DEFAULT_READ_SIZE;
+	( *export_handle )->format        = EXPORT_HANDLE_FORMAT_RAW;
+	( *export_handle )->notify_stream = EXPORT_HANDLE_NOTIFY_STREAM;
+
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	( *export_handle )->number_of_threads = 4;
+#endif
+	return( 1 );
+
+on_error:
+	if( *export_handle != NULL )
+	{
+		if( ( *export_handle )->input_file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *export_handle )->input_file_io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an export handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_free(
+     export_handle_t **export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_free";
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_handle != NULL )
+	{
+		if( ( *export_handle )->output_files != NULL )
+		{
+			if( export_handle_close_outputs(
+			     *export_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close outputs.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libvshadow_volume_free(
+		     &( ( *export_handle )->input_volume ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input volume.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *export_handle )->input_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *export_handle )->extents != NULL )
+		{
+			memory_free(
+			 ( *export_handle )->extents );
+		}
+		if( ( *export_handle )->target_path != NULL )
+		{
+			memory_free(
+			 ( *export_handle )->target_path );
+		}
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the export handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_signal_abort(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_signal_abort";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->abort = 1;
+
+	if( export_handle->input_volume != NULL )
+	{
+		if( libvshadow_volume_signal_abort(
+		     export_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input volume to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the volume offset
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_volume_offset(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_volume_offset";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( export_handle_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->volume_offset = (off64_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the store index
+ * The string contains the store number, which starts at 1, or "all"
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_store_index(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_store_index";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 3 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "all" ),
+	       3 ) == 0 ) )
+	{
+		export_handle->store_index = -1;
+
+		return( 1 );
+	}
+	if( export_handle_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->store_index = (int) value_64bit - 1;
+
+	return( 1 );
+}
+
+/* Sets the number of worker threads
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_number_of_threads(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( export_handle_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > 64 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the output format
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int export_handle_set_format(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_format";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 3 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "raw" ),
+		     3 ) == 0 )
+		{
+			export_handle->format = EXPORT_HANDLE_FORMAT_RAW;
+			result                = 1;
+		}
+	}
+	else if( string_length == 5 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "qcow2" ),
+		     5 ) == 0 )
+		{
+			export_handle->format = EXPORT_HANDLE_FORMAT_QCOW2;
+			result                = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the target path prefix
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_target_path(
+     export_handle_t *export_handle,
+     const system_character_t *target_path,
+     libcerror_error_t **error )
+{
+	static char *function   = "export_handle_set_target_path";
+	size_t target_path_size = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->target_path != NULL )
+	{
+		memory_free(
+		 export_handle->target_path );
+
+		export_handle->target_path      = NULL;
+		export_handle->target_path_size = 0;
+	}
+	target_path_size = system_string_length(
+	                    target_path ) + 1;
+
+	if( target_path_size == 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing target path.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->target_path = system_string_allocate(
+	                              target_path_size );
+
+	if( export_handle->target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create target path.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     export_handle->target_path,
+	     target_path,
+	     target_path_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy target path.",
+		 function );
+
+		goto on_error;
+	}
+	export_handle->target_path[ target_path_size - 1 ] = 0;
+
+	export_handle->target_path_size = target_path_size;
+
+	return( 1 );
+
+on_error:
+	if( export_handle->target_path != NULL )
+	{
+		memory_free(
+		 export_handle->target_path );
+
+		export_handle->target_path = NULL;
+	}
+	export_handle->target_path_size = 0;
+
+	return( -1 );
+}
+
+/* Opens the input of the export handle
+ * Returns 1 if successful, 0 if no VSS enabled volume was found or -1 on error
+ */
+int export_handle_open_input(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "export_handle_open_input";
+	size_t filename_length = 0;
+	int result             = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_range_set_name_wide(
+	     export_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_range_set_name(
+	     export_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_range_set(
+	     export_handle->input_file_io_handle,
+	     export_handle->volume_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open set volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_check_volume_signature_file_io_handle(
+	          export_handle->input_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if volume has a VSS signature.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libvshadow_volume_open_file_io_handle(
+		     export_handle->input_volume,
+		     export_handle->input_file_io_handle,
+		     LIBVSHADOW_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open input volume.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvshadow_volume_get_size(
+		     export_handle->input_volume,
+		     &( export_handle->volume_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve volume size.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Closes the export handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int export_handle_close(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_close";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_close(
+	     export_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Compares 2 extents by their source offset
+ * Returns -1 if the first extent is less than the second, 0 if equal or 1 if greater
+ */
+int export_extent_compare_by_source_offset(
+     const export_extent_t *first_extent,
+     const export_extent_t *second_extent )
+{
+	if( first_extent->source_offset < second_extent->source_offset )
+	{
+		return( -1 );
+	}
+	else if( first_extent->source_offset > second_extent->source_offset )
+	{
+		return( 1 );
+	}
+	if( first_extent->output_index < second_extent->output_index )
+	{
+		return( -1 );
+	}
+	else if( first_extent->output_index > second_extent->output_index )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Appends an extent
+ * The extent is merged with the last extent if they are contiguous
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_append_extent(
+     export_handle_t *export_handle,
+     off64_t source_offset,
+     off64_t target_offset,
+     size64_t size,
+     int output_index,
+     libcerror_error_t **error )
+{
+	export_extent_t *extent  = NULL;
+	export_extent_t *extents = NULL;
+	static char *function    = "export_handle_append_extent";
+	size_t extents_size      = 0;
+	int number_of_extents    = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->number_of_extents > 0 )
+	{
+		extent = &( export_handle->extents[ export_handle->number_of_extents - 1 ] );
+
+		if( ( extent->output_index == output_index )
+		 && ( ( extent->source_offset + (off64_t) extent->size ) == source_offset )
+		 && ( ( extent->target_offset + (off64_t) extent->size ) == target_offset ) )
+		{
+			extent->size += size;
+
+			return( 1 );
+		}
+	}
+	if( export_handle->number_of_extents >= export_handle->number_of_allocated_extents )
+	{
+		if( export_handle->number_of_allocated_extents == 0 )
+		{
+			number_of_extents = 1024;
+		}
+		else if( export_handle->number_of_allocated_extents < ( INT_MAX / 2 ) )
+		{
+			number_of_extents = export_handle->number_of_allocated_extents * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of extents value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		extents_size = sizeof( export_extent_t ) * number_of_extents;
+
+		if( extents_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid extents size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		extents = (export_extent_t *) memory_reallocate(
+		                               export_handle->extents,
+		                               extents_size );
+
+		if( extents == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize extents.",
+			 function );
+
+			return( -1 );
+		}
+		export_handle->extents                     = extents;
+		export_handle->number_of_allocated_extents = number_of_extents;
+	}
+	extent = &( export_handle->extents[ export_handle->number_of_extents ] );
+
+	extent->source_offset = source_offset;
+	extent->target_offset = target_offset;
+	extent->size          = size;
+	extent->output_index  = output_index;
+
+	export_handle->number_of_extents += 1;
+
+	return( 1 );
+}
+
+/* Determines the extents of a store
+ * Sparse data is not added since it is not written to the output
+ * Unallocated data is not added if the allocation bitmap of the store was read
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_plan_store(
+     export_handle_t *export_handle,
+     int output_index,
+     libvshadow_store_t *store,
+     libcerror_error_t **error )
+{
+	static char *function  = "export_handle_plan_store";
+	size64_t source_size   = 0;
+	off64_t offset         = 0;
+	off64_t source_offset  = 0;
+	int source_store_index = 0;
+	int source_type        = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	while( (size64_t) offset < export_handle->volume_size )
+	{
+		if( export_handle->abort != 0 )
+		{
+			return( -1 );
+		}
+		if( libvshadow_store_get_data_source_at_offset(
+		     store,
+		     offset,
+		     &source_type,
+		     &source_store_index,
+		     &source_offset,
+		     &source_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data source at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( source_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid source size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( source_type != LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE )
+		 && ( source_type != LIBVSHADOW_DATA_SOURCE_TYPE_UNALLOCATED ) )
+		{
+			if( export_handle_append_extent(
+			     export_handle,
+			     source_offset,
+			     offset,
+			     source_size,
+			     output_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append extent.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		offset += (off64_t) source_size;
+	}
+	return( 1 );
+}
+
+/* Determines the extents of the stores to export and sorts them by source offset
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_plan(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	libvshadow_store_t *store = NULL;
+	static char *function     = "export_handle_plan";
+	size_t indexes_size       = 0;
+	int number_of_stores      = 0;
+	int output_index          = 0;
+	int result                = 0;
+	int store_index           = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_store_indexes != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - output store indexes value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_number_of_stores(
+	     export_handle->input_volume,
+	     &number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->store_index >= number_of_stores )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store number value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_stores > 0 )
+	{
+		indexes_size = sizeof( int ) * number_of_stores;
+
+		export_handle->output_store_indexes = (int *) memory_allocate(
+		                                               indexes_size );
+
+		if( export_handle->output_store_indexes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create output store indexes.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		if( ( export_handle->store_index != -1 )
+		 && ( export_handle->store_index != store_index ) )
+		{
+			continue;
+		}
+		if( libvshadow_volume_get_store(
+		     export_handle->input_volume,
+		     store_index,
+		     &store,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		result = libvshadow_store_has_in_volume_data(
+		          store,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if store: %d has in-volume data.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( export_handle->skip_unallocated != 0 )
+			{
+				result = libvshadow_store_read_allocation_bitmap(
+				          store,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read allocation bitmap of store: %d.",
+					 function,
+					 store_index );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					fprintf(
+					 export_handle->notify_stream,
+					 "Store: %d does not contain a supported NTFS file system, exporting all data\n",
+					 store_index + 1 );
+				}
+			}
+			fprintf(
+			 export_handle->notify_stream,
+			 "Determining extents of store: %d\n",
+			 store_index + 1 );
+
+			if( export_handle_plan_store(
+			     export_handle,
+			     output_index,
+			     store,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine extents of store: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+			export_handle->output_store_indexes[ output_index++ ] = store_index;
+		}
+		if( libvshadow_store_free(
+		     &store,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+	}
+	export_handle->number_of_outputs = output_index;
+
+	/* Sorting the extents by source offset allows the input to be read in a single pass
+	 */
+	if( export_handle->number_of_extents > 1 )
+	{
+		qsort(
+		 export_handle->extents,
+		 (size_t) export_handle->number_of_extents,
+		 sizeof( export_extent_t ),
+		 (int (*)(const void *, const void *)) &export_extent_compare_by_source_offset );
+	}
+	return( 1 );
+
+on_error:
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( export_handle->output_store_indexes != NULL )
+	{
+		memory_free(
+		 export_handle->output_store_indexes );
+
+		export_handle->output_store_indexes = NULL;
+	}
+	return( -1 );
+}
+
+/* Opens the outputs
+ * Every output is created with the size of the volume so that regions
+ * that are not written remain sparse
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_open_outputs(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	system_character_t *output_filename = NULL;
+	static char *function               = "export_handle_open_outputs";
+	size_t array_size                   = 0;
+	size_t output_filename_size         = 0;
+	int output_index                    = 0;
+	int print_count                     = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_files != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - output files value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->number_of_outputs == 0 )
+	{
+		return( 1 );
+	}
+	array_size = sizeof( libcfile_file_t * ) * export_handle->number_of_outputs;
+
+	export_handle->output_files = (libcfile_file_t **) memory_allocate(
+	                                                    array_size );
+
+	if( export_handle->output_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create output files.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     export_handle->output_files,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear output files.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	array_size = sizeof( libcthreads_mutex_t * ) * export_handle->number_of_outputs;
+
+	export_handle->output_mutexes = (libcthreads_mutex_t **) memory_allocate(
+	                                                          array_size );
+
+	if( export_handle->output_mutexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create output mutexes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     export_handle->output_mutexes,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear output mutexes.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	/* The target path is suffixed by the store number, which is at most 10 digits
+	 */
+	output_filename_size = export_handle->target_path_size + 10;
+
+	output_filename = system_string_allocate(
+	                   output_filename_size );
+
+	if( output_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create output filename.",
+		 function );
+
+		goto on_error;
+	}
+	for( output_index = 0;
+	     output_index < export_handle->number_of_outputs;
+	     output_index++ )
+	{
+		print_count = system_string_sprintf(
+		               output_filename,
+		               output_filename_size,
+		               _SYSTEM_STRING( "%" PRIs_SYSTEM "%d" ),
+		               export_handle->target_path,
+		               export_handle->output_store_indexes[ output_index ] + 1 );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= output_filename_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set output filename.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcfile_file_initialize(
+		     &( export_handle->output_files[ output_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create output file: %d.",
+			 function,
+			 output_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcfile_file_open_wide(
+		     export_handle->output_files[ output_index ],
+		     output_filename,
+		     LIBCFILE_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+#else
+		if( libcfile_file_open(
+		     export_handle->output_files[ output_index ],
+		     output_filename,
+		     LIBCFILE_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open output file: %" PRIs_SYSTEM ".",
+			 function,
+			 output_filename );
+
+			goto on_error;
+		}
+		if( libcfile_file_resize(
+		     export_handle->output_files[ output_index ],
+		     export_handle->volume_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to resize output file: %" PRIs_SYSTEM ".",
+			 function,
+			 output_filename );
+
+			goto on_error;
+		}
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_initialize(
+		     &( export_handle->output_mutexes[ output_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create output mutex: %d.",
+			 function,
+			 output_index );
+
+			goto on_error;
+		}
+#endif
+		fprintf(
+		 export_handle->notify_stream,
+		 "Exporting store: %d to: %" PRIs_SYSTEM "\n",
+		 export_handle->output_store_indexes[ output_index ] + 1,
+		 output_filename );
+	}
+	memory_free(
+	 output_filename );
+
+	return( 1 );
+
+on_error:
+	if( output_filename != NULL )
+	{
+		memory_free(
+		 output_filename );
+	}
+	if( export_handle->output_files != NULL )
+	{
+		export_handle_close_outputs(
+		 export_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the outputs
+ * Returns 0 if successful or -1 on error
+ */
+int export_handle_close_outputs(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_close_outputs";
+	int output_index      = 0;
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_files != NULL )
+	{
+		for( output_index = 0;
+		     output_index < export_handle->number_of_outputs;
+		     output_index++ )
+		{
+			if( export_handle->output_files[ output_index ] == NULL )
+			{
+				continue;
+			}
+			if( libcfile_file_close(
+			     export_handle->output_files[ output_index ],
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close output file: %d.",
+				 function,
+				 output_index );
+
+				result = -1;
+			}
+			if( libcfile_file_free(
+			     &( export_handle->output_files[ output_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free output file: %d.",
+				 function,
+				 output_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 export_handle->output_files );
+
+		export_handle->output_files = NULL;
+	}
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->output_mutexes != NULL )
+	{
+		for( output_index = 0;
+		     output_index < export_handle->number_of_outputs;
+		     output_index++ )
+		{
+			if( export_handle->output_mutexes[ output_index ] == NULL )
+			{
+				continue;
+			}
+			if( libcthreads_mutex_free(
+			     &( export_handle->output_mutexes[ output_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free output mutex: %d.",
+				 function,
+				 output_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 export_handle->output_mutexes );
+
+		export_handle->output_mutexes = NULL;
+	}
+#endif
+	if( export_handle->output_store_indexes != NULL )
+	{
+		memory_free(
+		 export_handle->output_store_indexes );
+
+		export_handle->output_store_indexes = NULL;
+	}
+	export_handle->number_of_outputs = 0;
+
+	return( result );
+}
+
+/* Writes the part of an extent that is contained in a buffer to its output
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_extent(
+     export_handle_t *export_handle,
+     const uint8_t *buffer,
+     off64_t buffer_source_offset,
+     export_extent_t *extent,
+     libcerror_error_t **error )
+{
+	libcfile_file_t *output_file = NULL;
+	static char *function        = "export_handle_write_extent";
+	size_t buffer_offset         = 0;
+	ssize_t write_count          = 0;
+	int result                   = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent->output_index < 0 )
+	 || ( extent->output_index >= export_handle->number_of_outputs ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent - output index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent->source_offset < buffer_source_offset )
+	 || ( extent->size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	output_file   = export_handle->output_files[ extent->output_index ];
+	buffer_offset = (size_t) ( extent->source_offset - buffer_source_offset );
+
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     export_handle->output_mutexes[ extent->output_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab output mutex: %d.",
+		 function,
+		 extent->output_index );
+
+		return( -1 );
+	}
+#endif
+	if( libcfile_file_seek_offset(
+	     output_file,
+	     extent->target_offset,
+	     SEEK_SET,
+	     error ) != extent->target_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in output: %d.",
+		 function,
+		 extent->target_offset,
+		 extent->target_offset,
+		 extent->output_index );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		write_count = libcfile_file_write_buffer(
+		               output_file,
+		               &( buffer[ buffer_offset ] ),
+		               (size_t) extent->size,
+		               error );
+
+		if( write_count != (ssize_t) extent->size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write data to output: %d.",
+			 function,
+			 extent->output_index );
+
+			result = -1;
+		}
+	}
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     export_handle->output_mutexes[ extent->output_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release output mutex: %d.",
+		 function,
+		 extent->output_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Frees a write job
+ * Returns 1 if successful or -1 on error
+ */
+int export_write_job_free(
+     export_write_job_t **write_job,
+     libcerror_error_t **error )
+{
+	static char *function = "export_write_job_free";
+
+	if( write_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_job != NULL )
+	{
+		if( ( *write_job )->extents != NULL )
+		{
+			memory_free(
+			 ( *write_job )->extents );
+		}
+		if( ( *write_job )->buffer != NULL )
+		{
+			memory_free(
+			 ( *write_job )->buffer );
+		}
+		memory_free(
+		 *write_job );
+
+		*write_job = NULL;
+	}
+	return( 1 );
+}
+
+/* Processes a write job
+ * This function is used as the write thread pool callback and frees the write job
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_process_write_job(
+     export_write_job_t *write_job,
+     export_handle_t *export_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "export_handle_process_write_job";
+	int extent_index         = 0;
+	int result               = 1;
+
+	if( write_job == NULL )
+	{
+		return( -1 );
+	}
+	if( export_handle == NULL )
+	{
+		export_handle = write_job->export_handle;
+	}
+	for( extent_index = 0;
+	     extent_index < write_job->number_of_extents;
+	     extent_index++ )
+	{
+		if( ( export_handle->abort != 0 )
+		 || ( export_handle->write_failed != 0 ) )
+		{
+			result = -1;
+
+			break;
+		}
+		if( export_handle_write_extent(
+		     export_handle,
+		     write_job->buffer,
+		     write_job->source_offset,
+		     &( write_job->extents[ extent_index ] ),
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write extent: %d.",
+			 function,
+			 extent_index );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			export_handle->write_failed = 1;
+
+			result = -1;
+
+			break;
+		}
+	}
+	export_write_job_free(
+	 &write_job,
+	 NULL );
+
+	return( result );
+}
+
+/* Exports the stores
+ * The input is read in order of source offset and every part that is read
+ * is written to all the outputs that contain it
+ * With the QCOW2 format the stores are exported as a chain of images instead
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_export(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	export_extent_t *extent       = NULL;
+	export_write_job_t *write_job = NULL;
+	int *active_extents           = NULL;
+	static char *function         = "export_handle_export";
+	size_t read_size              = 0;
+	ssize_t read_count            = 0;
+	off64_t extent_end_offset     = 0;
+	off64_t maximum_end_offset    = 0;
+	off64_t minimum_start_offset  = 0;
+	off64_t overlap_end_offset    = 0;
+	off64_t overlap_start_offset  = 0;
+	off64_t read_end_offset       = 0;
+	off64_t read_offset           = 0;
+	int active_index              = 0;
+	int extent_index              = 0;
+	int number_of_active_extents  = 0;
+	int result                    = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_handle->read_size == 0 )
+	 || ( export_handle->read_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid export handle - read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->format == EXPORT_HANDLE_FORMAT_QCOW2 )
+	{
+		return( export_handle_export_qcow2_chain(
+		         export_handle,
+		         error ) );
+	}
+	if( export_handle_plan(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle_open_outputs(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open outputs.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->number_of_extents == 0 )
+	{
+		return( 1 );
+	}
+	active_extents = (int *) memory_allocate(
+	                          sizeof( int ) * export_handle->number_of_extents );
+
+	if( active_extents == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create active extents.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_threads > 0 )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( export_handle->write_thread_pool ),
+		     NULL,
+		     export_handle->number_of_threads,
+		     export_handle->number_of_threads * 2,
+		     (int (*)(intptr_t *, void *)) &export_handle_process_write_job,
+		     (void *) export_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create write thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	while( ( extent_index < export_handle->number_of_extents )
+	    || ( number_of_active_extents > 0 ) )
+	{
+		if( ( export_handle->abort != 0 )
+		 || ( export_handle->write_failed != 0 ) )
+		{
+			break;
+		}
+		if( number_of_active_extents == 0 )
+		{
+			read_offset = export_handle->extents[ extent_index ].source_offset;
+		}
+		read_end_offset = read_offset + (off64_t) export_handle->read_size;
+
+		while( extent_index < export_handle->number_of_extents )
+		{
+			if( export_handle->extents[ extent_index ].source_offset >= read_end_offset )
+			{
+				break;
+			}
+			active_extents[ number_of_active_extents++ ] = extent_index++;
+		}
+		/* Skip the part before the first active extent and do not read
+		 * beyond the last active extent
+		 */
+		minimum_start_offset = read_end_offset;
+		maximum_end_offset   = read_offset;
+
+		for( active_index = 0;
+		     active_index < number_of_active_extents;
+		     active_index++ )
+		{
+			extent            = &( export_handle->extents[ active_extents[ active_index ] ] );
+			extent_end_offset = extent->source_offset + (off64_t) extent->size;
+
+			if( extent->source_offset <= read_offset )
+			{
+				minimum_start_offset = read_offset;
+			}
+			else if( extent->source_offset < minimum_start_offset )
+			{
+				minimum_start_offset = extent->source_offset;
+			}
+			if( extent_end_offset > maximum_end_offset )
+			{
+				maximum_end_offset = extent_end_offset;
+			}
+		}
+		if( minimum_start_offset > read_offset )
+		{
+			read_offset = minimum_start_offset;
+
+			continue;
+		}
+		if( read_end_offset > maximum_end_offset )
+		{
+			read_end_offset = maximum_end_offset;
+		}
+		read_size = (size_t) ( read_end_offset - read_offset );
+
+		write_job = memory_allocate_structure(
+		             export_write_job_t );
+
+		if( write_job == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create write job.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     write_job,
+		     0,
+		     sizeof( export_write_job_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear write job.",
+			 function );
+
+			memory_free(
+			 write_job );
+
+			write_job = NULL;
+
+			goto on_error;
+		}
+		write_job->export_handle = export_handle;
+		write_job->source_offset = read_offset;
+
+		write_job->buffer = (uint8_t *) memory_allocate(
+		                                 sizeof( uint8_t ) * read_size );
+
+		if( write_job->buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create write job buffer.",
+			 function );
+
+			goto on_error;
+		}
+		write_job->extents = (export_extent_t *) memory_allocate(
+		                                          sizeof( export_extent_t ) * number_of_active_extents );
+
+		if( write_job->extents == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create write job extents.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              export_handle->input_file_io_handle,
+		              write_job->buffer,
+		              read_size,
+		              read_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_offset,
+			 read_offset );
+
+			goto on_error;
+		}
+		export_handle->input_size += read_size;
+
+		/* Determine the parts of the active extents that are contained in the buffer
+		 * and remove the active extents that end in the buffer
+		 */
+		result = number_of_active_extents;
+
+		number_of_active_extents = 0;
+
+		for( active_index = 0;
+		     active_index < result;
+		     active_index++ )
+		{
+			extent            = &( export_handle->extents[ active_extents[ active_index ] ] );
+			extent_end_offset = extent->source_offset + (off64_t) extent->size;
+
+			if( extent->source_offset > read_offset )
+			{
+				overlap_start_offset = extent->source_offset;
+			}
+			else
+			{
+				overlap_start_offset = read_offset;
+			}
+			if( extent_end_offset < read_end_offset )
+			{
+				overlap_end_offset = extent_end_offset;
+			}
+			else
+			{
+				overlap_end_offset = read_end_offset;
+			}
+			if( overlap_end_offset > overlap_start_offset )
+			{
+				write_job->extents[ write_job->number_of_extents ].source_offset = overlap_start_offset;
+				write_job->extents[ write_job->number_of_extents ].target_offset = extent->target_offset + ( overlap_start_offset - extent->source_offset );
+				write_job->extents[ write_job->number_of_extents ].size          = (size64_t) ( overlap_end_offset - overlap_start_offset );
+				write_job->extents[ write_job->number_of_extents ].output_index  = extent->output_index;
+
+				export_handle->output_size += (size64_t) ( overlap_end_offset - overlap_start_offset );
+
+				write_job->number_of_extents += 1;
+			}
+			if( extent_end_offset > read_end_offset )
+			{
+				active_extents[ number_of_active_extents++ ] = active_extents[ active_index ];
+			}
+		}
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+		if( export_handle->write_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_push(
+			     export_handle->write_thread_pool,
+			     (intptr_t *) write_job,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push write job onto queue.",
+				 function );
+
+				goto on_error;
+			}
+			write_job = NULL;
+		}
+		else
+#endif
+		{
+			result = export_handle_process_write_job(
+			          write_job,
+			          export_handle );
+
+			write_job = NULL;
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to process write job.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		read_offset = read_end_offset;
+	}
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->write_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( export_handle->write_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join write thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	memory_free(
+	 active_extents );
+
+	active_extents = NULL;
+
+	if( export_handle->write_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write outputs.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->abort != 0 )
+	{
+		return( -1 );
+	}
+	fprintf(
+	 export_handle->notify_stream,
+	 "Read: %" PRIu64 " bytes from input and written: %" PRIu64 " bytes to %d output(s).\n",
+	 export_handle->input_size,
+	 export_handle->output_size,
+	 export_handle->number_of_outputs );
+
+	return( 1 );
+
+on_error:
+	if( write_job != NULL )
+	{
+		export_write_job_free(
+		 &write_job,
+		 NULL );
+	}
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->write_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( export_handle->write_thread_pool ),
+		 NULL );
+	}
+#endif
+	if( active_extents != NULL )
+	{
+		memory_free(
+		 active_extents );
+	}
+	return( -1 );
+}
+
+/* Retrieves the filename of a QCOW2 image
+ * The store index -1 represents the volume
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_get_qcow2_filename(
+     export_handle_t *export_handle,
+     int store_index,
+     system_character_t *filename,
+     size_t filename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_get_qcow2_filename";
+	int print_count       = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_index == -1 )
+	{
+		print_count = system_string_sprintf(
+		               filename,
+		               filename_size,
+		               _SYSTEM_STRING( "%" PRIs_SYSTEM "volume.qcow2" ),
+		               export_handle->target_path );
+	}
+	else
+	{
+		print_count = system_string_sprintf(
+		               filename,
+		               filename_size,
+		               _SYSTEM_STRING( "%" PRIs_SYSTEM "%d.qcow2" ),
+		               export_handle->target_path,
+		               store_index + 1 );
+	}
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= filename_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the backing file name of a QCOW2 image as an UTF-8 string
+ * The backing file name is the filename without the directory, since qemu
+ * resolves a relative backing file name relative to the directory of the image
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_get_backing_file_name(
+     const system_character_t *filename,
+     uint8_t *backing_file_name,
+     size_t backing_file_name_size,
+     size_t *name_size,
+     libcerror_error_t **error )
+{
+	const system_character_t *name = NULL;
+	static char *function          = "export_handle_get_backing_file_name";
+	size_t filename_length         = 0;
+	size_t name_index              = 0;
+	size_t safe_name_size          = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( backing_file_name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid backing file name.",
+		 function );
+
+		return( -1 );
+	}
+	if( name_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name size.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	for( name_index = filename_length;
+	     name_index > 0;
+	     name_index-- )
+	{
+#if defined( WINAPI )
+		if( ( filename[ name_index - 1 ] == (system_character_t) '\\' )
+		 || ( filename[ name_index - 1 ] == (system_character_t) '/' ) )
+#else
+		if( filename[ name_index - 1 ] == (system_character_t) '/' )
+#endif
+		{
+			break;
+		}
+	}
+	name = &( filename[ name_index ] );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#if SIZEOF_WCHAR_T == 4
+	if( libuna_utf8_string_size_from_utf32(
+	     (libuna_utf32_character_t *) name,
+	     filename_length - name_index + 1,
+	     &safe_name_size,
+	     error ) != 1 )
+#elif SIZEOF_WCHAR_T == 2
+	if( libuna_utf8_string_size_from_utf16(
+	     (libuna_utf16_character_t *) name,
+	     filename_length - name_index + 1,
+	     &safe_name_size,
+	     error ) != 1 )
+#else
+#error Unsupported size of wchar_t
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine backing file name size.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	safe_name_size = filename_length - name_index + 1;
+#endif
+	if( safe_name_size > backing_file_name_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid backing file name size value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#if SIZEOF_WCHAR_T == 4
+	if( libuna_utf8_string_copy_from_utf32(
+	     (libuna_utf8_character_t *) backing_file_name,
+	     backing_file_name_size,
+	     (libuna_utf32_character_t *) name,
+	     filename_length - name_index + 1,
+	     error ) != 1 )
+#elif SIZEOF_WCHAR_T == 2
+	if( libuna_utf8_string_copy_from_utf16(
+	     (libuna_utf8_character_t *) backing_file_name,
+	     backing_file_name_size,
+	     (libuna_utf16_character_t *) name,
+	     filename_length - name_index + 1,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy backing file name.",
+		 function );
+
+		return( -1 );
+	}
+#else
+	if( memory_copy(
+	     backing_file_name,
+	     name,
+	     safe_name_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy backing file name.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*name_size = safe_name_size;
+
+	return( 1 );
+}
+
+/* Retrieves the data source of an image at a specific offset
+ * If store is NULL the image represents the volume
+ * The source size is limited to the remainder of the volume
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_get_image_data_source(
+     export_handle_t *export_handle,
+     libvshadow_store_t *store,
+     off64_t offset,
+     int *source_type,
+     off64_t *source_offset,
+     size64_t *source_size,
+     libcerror_error_t **error )
+{
+	static char *function   = "export_handle_get_image_data_source";
+	size64_t remaining_size = 0;
+	int source_store_index  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= export_handle->volume_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source type.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source size.",
+		 function );
+
+		return( -1 );
+	}
+	remaining_size = export_handle->volume_size - (size64_t) offset;
+
+	if( store == NULL )
+	{
+		*source_type   = LIBVSHADOW_DATA_SOURCE_TYPE_VOLUME;
+		*source_offset = offset;
+		*source_size   = remaining_size;
+
+		return( 1 );
+	}
+	if( libvshadow_store_get_data_source_at_offset(
+	     store,
+	     offset,
+	     source_type,
+	     &source_store_index,
+	     source_offset,
+	     source_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data source at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	if( *source_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid source size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( *source_size > remaining_size )
+	{
+		*source_size = remaining_size;
+	}
+	return( 1 );
+}
+
+/* Reads a run of consecutive clusters of an image and writes them to the QCOW2 image
+ * If store is NULL the data is read from the volume
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_qcow2_run(
+     export_handle_t *export_handle,
+     qcow2_writer_t *qcow2_writer,
+     libvshadow_store_t *store,
+     uint8_t *buffer,
+     off64_t run_offset,
+     size_t run_size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_write_qcow2_run";
+	size_t buffer_offset  = 0;
+	size_t data_size      = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( run_offset < 0 )
+	 || ( (size64_t) run_offset >= export_handle->volume_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid run offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	read_size = run_size;
+
+	/* The last cluster can extend beyond the end of the volume
+	 */
+	if( (size64_t) read_size > ( export_handle->volume_size - (size64_t) run_offset ) )
+	{
+		read_size = (size_t) ( export_handle->volume_size - (size64_t) run_offset );
+	}
+	if( store == NULL )
+	{
+		read_count = libbfio_handle_read_buffer_at_offset(
+		              export_handle->input_file_io_handle,
+		              buffer,
+		              read_size,
+		              export_handle->volume_offset + run_offset,
+		              error );
+	}
+	else
+	{
+		read_count = libvshadow_store_read_buffer_at_offset(
+		              store,
+		              buffer,
+		              read_size,
+		              run_offset,
+		              error );
+	}
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 run_offset,
+		 run_offset );
+
+		return( -1 );
+	}
+	export_handle->input_size += read_size;
+
+	for( buffer_offset = 0;
+	     buffer_offset < read_size;
+	     buffer_offset += qcow2_writer->cluster_size )
+	{
+		data_size = read_size - buffer_offset;
+
+		if( data_size > qcow2_writer->cluster_size )
+		{
+			data_size = qcow2_writer->cluster_size;
+		}
+		if( qcow2_writer_write_cluster(
+		     qcow2_writer,
+		     run_offset + (off64_t) buffer_offset,
+		     &( buffer[ buffer_offset ] ),
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write cluster at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 run_offset + (off64_t) buffer_offset,
+			 run_offset + (off64_t) buffer_offset );
+
+			return( -1 );
+		}
+		export_handle->output_size += qcow2_writer->cluster_size;
+	}
+	return( 1 );
+}
+
+/* Appends a cluster that differs from the backing image to the QCOW2 image
+ * Consecutive clusters that contain data are combined into a run, which is
+ * read in one go when it reaches the buffer size or cannot be extended.
+ * A cluster without data is marked to read as zeros
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_append_qcow2_cluster(
+     export_handle_t *export_handle,
+     qcow2_writer_t *qcow2_writer,
+     libvshadow_store_t *store,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t *run_offset,
+     size_t *run_size,
+     off64_t cluster_offset,
+     int has_data,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_append_qcow2_cluster";
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( has_data != 0 )
+	 && ( *run_size > 0 )
+	 && ( cluster_offset == ( *run_offset + (off64_t) *run_size ) )
+	 && ( ( *run_size + qcow2_writer->cluster_size ) <= buffer_size ) )
+	{
+		*run_size += qcow2_writer->cluster_size;
+
+		return( 1 );
+	}
+	if( *run_size > 0 )
+	{
+		if( export_handle_write_qcow2_run(
+		     export_handle,
+		     qcow2_writer,
+		     store,
+		     buffer,
+		     *run_offset,
+		     *run_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write run at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 *run_offset,
+			 *run_offset );
+
+			return( -1 );
+		}
+		*run_size = 0;
+	}
+	if( has_data != 0 )
+	{
+		*run_offset = cluster_offset;
+		*run_size   = qcow2_writer->cluster_size;
+	}
+	else
+	{
+		if( qcow2_writer_write_cluster(
+		     qcow2_writer,
+		     cluster_offset,
+		     NULL,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write zero cluster at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 cluster_offset,
+			 cluster_offset );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Exports a store, or the volume if store is NULL, as a QCOW2 image
+ * If the image has a backing file only the clusters that differ from the backing
+ * store, or the volume if backing store is NULL, are written. The differences are
+ * determined from the data sources, without reading data: a part differs if it is
+ * sparse in only one of the images or if its data is stored at a different offset.
+ * Unallocated data, if the allocation bitmap of the store was read, never differs
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_export_qcow2_image(
+     export_handle_t *export_handle,
+     libvshadow_store_t *store,
+     libvshadow_store_t *backing_store,
+     int has_backing,
+     const system_character_t *filename,
+     const uint8_t *backing_file_name,
+     size_t backing_file_name_size,
+     libcerror_error_t **error )
+{
+	qcow2_writer_t *qcow2_writer  = NULL;
+	uint8_t *buffer               = NULL;
+	static char *function         = "export_handle_export_qcow2_image";
+	size64_t backing_source_size  = 0;
+	size64_t source_size          = 0;
+	size_t buffer_size            = 0;
+	size_t cluster_size           = 0;
+	size_t run_size               = 0;
+	off64_t backing_source_offset = 0;
+	off64_t cluster_offset        = -1;
+	off64_t offset                = 0;
+	off64_t range_end_offset      = 0;
+	off64_t run_offset            = 0;
+	off64_t skip_offset           = 0;
+	off64_t source_offset         = 0;
+	int backing_source_type       = 0;
+	int cluster_differs           = 0;
+	int cluster_has_data          = 0;
+	int differs                   = 0;
+	int has_data                  = 0;
+	int source_type               = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( qcow2_writer_initialize(
+	     &qcow2_writer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create QCOW2 writer.",
+		 function );
+
+		goto on_error;
+	}
+	if( has_backing == 0 )
+	{
+		backing_file_name      = NULL;
+		backing_file_name_size = 0;
+	}
+	if( qcow2_writer_open(
+	     qcow2_writer,
+	     filename,
+	     export_handle->volume_size,
+	     backing_file_name,
+	     backing_file_name_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open QCOW2 writer.",
+		 function );
+
+		goto on_error;
+	}
+	cluster_size = qcow2_writer->cluster_size;
+
+	/* The buffer contains a whole number of clusters
+	 */
+	buffer_size = export_handle->read_size - ( export_handle->read_size % cluster_size );
+
+	if( buffer_size == 0 )
+	{
+		buffer_size = cluster_size;
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * buffer_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	while( (size64_t) offset < export_handle->volume_size )
+	{
+		if( export_handle->abort != 0 )
+		{
+			goto on_error;
+		}
+		if( export_handle_get_image_data_source(
+		     export_handle,
+		     store,
+		     offset,
+		     &source_type,
+		     &source_offset,
+		     &source_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data source at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			goto on_error;
+		}
+		if( has_backing != 0 )
+		{
+			if( export_handle_get_image_data_source(
+			     export_handle,
+			     backing_store,
+			     offset,
+			     &backing_source_type,
+			     &backing_source_offset,
+			     &backing_source_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve backing data source at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+				 function,
+				 offset,
+				 offset );
+
+				goto on_error;
+			}
+			if( backing_source_size < source_size )
+			{
+				source_size = backing_source_size;
+			}
+		}
+		else
+		{
+			/* An image without backing file reads as zeros where no cluster is stored
+			 */
+			backing_source_type = LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE;
+		}
+		has_data = 0;
+
+		if( ( source_type != LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE )
+		 && ( source_type != LIBVSHADOW_DATA_SOURCE_TYPE_UNALLOCATED ) )
+		{
+			has_data = 1;
+		}
+		if( source_type == LIBVSHADOW_DATA_SOURCE_TYPE_UNALLOCATED )
+		{
+			differs = 0;
+		}
+		else if( source_type == LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE )
+		{
+			differs = (int) ( backing_source_type != LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE );
+		}
+		else if( ( backing_source_type == LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE )
+		      || ( backing_source_type == LIBVSHADOW_DATA_SOURCE_TYPE_UNALLOCATED ) )
+		{
+			differs = 1;
+		}
+		else
+		{
+			differs = (int) ( source_offset != backing_source_offset );
+		}
+		range_end_offset = offset + (off64_t) source_size;
+
+		while( offset < range_end_offset )
+		{
+			if( ( offset - ( offset % (off64_t) cluster_size ) ) != cluster_offset )
+			{
+				if( cluster_differs != 0 )
+				{
+					if( export_handle_append_qcow2_cluster(
+					     export_handle,
+					     qcow2_writer,
+					     store,
+					     buffer,
+					     buffer_size,
+					     &run_offset,
+					     &run_size,
+					     cluster_offset,
+					     cluster_has_data,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_WRITE_FAILED,
+						 "%s: unable to append cluster at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+						 function,
+						 cluster_offset,
+						 cluster_offset );
+
+						goto on_error;
+					}
+				}
+				cluster_offset   = offset - ( offset % (off64_t) cluster_size );
+				cluster_differs  = 0;
+				cluster_has_data = 0;
+			}
+			if( differs != 0 )
+			{
+				cluster_differs = 1;
+			}
+			if( has_data != 0 )
+			{
+				cluster_has_data = 1;
+			}
+			offset = cluster_offset + (off64_t) cluster_size;
+
+			if( offset > range_end_offset )
+			{
+				offset = range_end_offset;
+			}
+			/* Clusters that are entirely within a part that does not differ are skipped
+			 */
+			else if( differs == 0 )
+			{
+				skip_offset = range_end_offset - ( range_end_offset % (off64_t) cluster_size );
+
+				if( skip_offset > offset )
+				{
+					offset = skip_offset;
+				}
+			}
+		}
+	}
+	if( cluster_differs != 0 )
+	{
+		if( export_handle_append_qcow2_cluster(
+		     export_handle,
+		     qcow2_writer,
+		     store,
+		     buffer,
+		     buffer_size,
+		     &run_offset,
+		     &run_size,
+		     cluster_offset,
+		     cluster_has_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to append cluster at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 cluster_offset,
+			 cluster_offset );
+
+			goto on_error;
+		}
+	}
+	if( run_size > 0 )
+	{
+		if( export_handle_write_qcow2_run(
+		     export_handle,
+		     qcow2_writer,
+		     store,
+		     buffer,
+		     run_offset,
+		     run_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write run at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 run_offset,
+			 run_offset );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( qcow2_writer_close(
+	     qcow2_writer,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close QCOW2 writer.",
+		 function );
+
+		goto on_error;
+	}
+	if( qcow2_writer_free(
+	     &qcow2_writer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free QCOW2 writer.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( qcow2_writer != NULL )
+	{
+		qcow2_writer_free(
+		 &qcow2_writer,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Exports the stores as a chain of QCOW2 images
+ * The most recent store, or the volume, is exported as the base image.
+ * Every older store is exported as an image with the image of the next
+ * more recent store as backing file, that only contains the clusters
+ * that differ. If a store number was set the chain starts at that store
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_export_qcow2_chain(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	uint8_t backing_file_name[ QCOW2_WRITER_MAXIMUM_BACKING_FILE_NAME_SIZE + 1 ];
+
+	libvshadow_store_t **stores          = NULL;
+	libvshadow_store_t *backing_store    = NULL;
+	libvshadow_store_t *store            = NULL;
+	system_character_t *backing_filename = NULL;
+	system_character_t *filename         = NULL;
+	system_character_t *swap_filename    = NULL;
+	int *store_indexes                   = NULL;
+	static char *function                = "export_handle_export_qcow2_chain";
+	size_t backing_file_name_size        = 0;
+	size_t filename_size                 = 0;
+	int chain_index                      = 0;
+	int first_store_index                = 0;
+	int has_backing                      = 0;
+	int number_of_images                 = 0;
+	int number_of_chain_stores           = 0;
+	int number_of_stores                 = 0;
+	int result                           = 0;
+	int store_index                      = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_number_of_stores(
+	     export_handle->input_volume,
+	     &number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->store_index >= number_of_stores )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store number value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_stores > 0 )
+	{
+		stores = (libvshadow_store_t **) memory_allocate(
+		                                  sizeof( libvshadow_store_t * ) * number_of_stores );
+
+		if( stores == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create stores.",
+			 function );
+
+			goto on_error;
+		}
+		store_indexes = (int *) memory_allocate(
+		                         sizeof( int ) * number_of_stores );
+
+		if( store_indexes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create store indexes.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->store_index != -1 )
+	{
+		first_store_index = export_handle->store_index;
+	}
+	/* Stores without in-volume data cannot be read and are left out of the chain,
+	 * the more recent stores resolve their data independently
+	 */
+	for( store_index = first_store_index;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		if( libvshadow_volume_get_store(
+		     export_handle->input_volume,
+		     store_index,
+		     &store,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		result = libvshadow_store_has_in_volume_data(
+		          store,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if store: %d has in-volume data.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( libvshadow_store_free(
+			     &store,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free store: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+			continue;
+		}
+		if( export_handle->skip_unallocated != 0 )
+		{
+			result = libvshadow_store_read_allocation_bitmap(
+			          store,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read allocation bitmap of store: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				fprintf(
+				 export_handle->notify_stream,
+				 "Store: %d does not contain a supported NTFS file system, exporting all data\n",
+				 store_index + 1 );
+			}
+		}
+		stores[ number_of_chain_stores ]        = store;
+		store_indexes[ number_of_chain_stores ] = store_index;
+
+		number_of_chain_stores++;
+
+		store = NULL;
+	}
+	/* The target path is suffixed by the store number, which is at most 10 digits,
+	 * or by volume, and the .qcow2 extension
+	 */
+	filename_size = export_handle->target_path_size + 16;
+
+	filename = system_string_allocate(
+	            filename_size );
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	backing_filename = system_string_allocate(
+	                    filename_size );
+
+	if( backing_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create backing filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->use_volume_as_base != 0 )
+	{
+		if( export_handle_get_qcow2_filename(
+		     export_handle,
+		     -1,
+		     filename,
+		     filename_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename of volume.",
+			 function );
+
+			goto on_error;
+		}
+		fprintf(
+		 export_handle->notify_stream,
+		 "Exporting volume to: %" PRIs_SYSTEM "\n",
+		 filename );
+
+		if( export_handle_export_qcow2_image(
+		     export_handle,
+		     NULL,
+		     NULL,
+		     0,
+		     filename,
+		     NULL,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to export volume.",
+			 function );
+
+			goto on_error;
+		}
+		number_of_images++;
+
+		swap_filename    = backing_filename;
+		backing_filename = filename;
+		filename         = swap_filename;
+	}
+	for( chain_index = number_of_chain_stores - 1;
+	     chain_index >= 0;
+	     chain_index-- )
+	{
+		store_index = store_indexes[ chain_index ];
+
+		if( export_handle_get_qcow2_filename(
+		     export_handle,
+		     store_index,
+		     filename,
+		     filename_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename of store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		has_backing   = 0;
+		backing_store = NULL;
+
+		if( chain_index < ( number_of_chain_stores - 1 ) )
+		{
+			has_backing   = 1;
+			backing_store = stores[ chain_index + 1 ];
+		}
+		else if( export_handle->use_volume_as_base != 0 )
+		{
+			has_backing = 1;
+		}
+		if( has_backing != 0 )
+		{
+			if( export_handle_get_backing_file_name(
+			     backing_filename,
+			     backing_file_name,
+			     QCOW2_WRITER_MAXIMUM_BACKING_FILE_NAME_SIZE + 1,
+			     &backing_file_name_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve backing file name of store: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+			fprintf(
+			 export_handle->notify_stream,
+			 "Exporting store: %d to: %" PRIs_SYSTEM " with backing file: %" PRIs_SYSTEM "\n",
+			 store_index + 1,
+			 filename,
+			 backing_filename );
+		}
+		else
+		{
+			fprintf(
+			 export_handle->notify_stream,
+			 "Exporting store: %d to: %" PRIs_SYSTEM "\n",
+			 store_index + 1,
+			 filename );
+		}
+		if( export_handle_export_qcow2_image(
+		     export_handle,
+		     stores[ chain_index ],
+		     backing_store,
+		     has_backing,
+		     filename,
+		     backing_file_name,
+		     backing_file_name_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to export store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		number_of_images++;
+
+		swap_filename    = backing_filename;
+		backing_filename = filename;
+		filename         = swap_filename;
+	}
+	memory_free(
+	 backing_filename );
+
+	backing_filename = NULL;
+
+	memory_free(
+	 filename );
+
+	filename = NULL;
+
+	for( chain_index = 0;
+	     chain_index < number_of_chain_stores;
+	     chain_index++ )
+	{
+		if( libvshadow_store_free(
+		     &( stores[ chain_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free store: %d.",
+			 function,
+			 store_indexes[ chain_index ] );
+
+			number_of_chain_stores = 0;
+
+			goto on_error;
+		}
+	}
+	number_of_chain_stores = 0;
+
+	if( stores != NULL )
+	{
+		memory_free(
+		 stores );
+
+		stores = NULL;
+	}
+	if( store_indexes != NULL )
+	{
+		memory_free(
+		 store_indexes );
+
+		store_indexes = NULL;
+	}
+	fprintf(
+	 export_handle->notify_stream,
+	 "Read: %" PRIu64 " bytes from input and written: %" PRIu64 " bytes to %d image(s).\n",
+	 export_handle->input_size,
+	 export_handle->output_size,
+	 number_of_images );
+
+	return( 1 );
+
+on_error:
+	if( backing_filename != NULL )
+	{
+		memory_free(
+		 backing_filename );
+	}
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( stores != NULL )
+	{
+		for( chain_index = 0;
+		     chain_index < number_of_chain_stores;
+		     chain_index++ )
+		{
+			libvshadow_store_free(
+			 &( stores[ chain_index ] ),
+			 NULL );
+		}
+		memory_free(
+		 stores );
+	}
+	if( store_indexes != NULL )
+	{
+		memory_free(
+		 store_indexes );
+	}
+	return( -1 );
+}
+
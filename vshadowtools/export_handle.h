@@ -0,0 +1,372 @@
+/*
+ * Export handle
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EXPORT_HANDLE_H )
+#define _EXPORT_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "qcow2_writer.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcfile.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default (maximum) size of the data read from the input in one go
+ */
+#define EXPORT_HANDLE_DEFAULT_READ_SIZE		( 4 * 1024 * 1024 )
+
+enum EXPORT_HANDLE_FORMATS
+{
+	EXPORT_HANDLE_FORMAT_RAW		= 1,
+	EXPORT_HANDLE_FORMAT_QCOW2		= 2
+};
+
+typedef struct export_extent export_extent_t;
+
+/* An extent of an output (store) and where its data is found in the volume
+ */
+struct export_extent
+{
+	/* The source offset
+	 */
+	off64_t source_offset;
+
+	/* The target offset
+	 */
+	off64_t target_offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The output index
+	 */
+	int output_index;
+};
+
+typedef struct export_write_job export_write_job_t;
+
+/* A buffer read from the input and the outputs it needs to be written to
+ */
+struct export_write_job
+{
+	/* The export handle
+	 */
+	struct export_handle *export_handle;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The source offset of the buffer
+	 */
+	off64_t source_offset;
+
+	/* The extents that overlap with the buffer
+	 */
+	export_extent_t *extents;
+
+	/* The number of extents
+	 */
+	int number_of_extents;
+};
+
+typedef struct export_handle export_handle_t;
+
+struct export_handle
+{
+	/* The volume offset
+	 */
+	off64_t volume_offset;
+
+	/* The target path prefix
+	 */
+	system_character_t *target_path;
+
+	/* The target path size
+	 */
+	size_t target_path_size;
+
+	/* The store index, -1 represents all stores
+	 */
+	int store_index;
+
+	/* The number of worker threads
+	 */
+	int number_of_threads;
+
+	/* The size of the data read from the input in one go
+	 */
+	size_t read_size;
+
+	/* Value to indicate if unallocated data of the NTFS file system in a store should be skipped
+	 */
+	int skip_unallocated;
+
+	/* The output format
+	 */
+	int format;
+
+	/* Value to indicate if the volume is the base image of a QCOW2 chain
+	 * instead of the most recent store
+	 */
+	int use_volume_as_base;
+
+	/* The libbfio input file IO handle
+	 */
+	libbfio_handle_t *input_file_io_handle;
+
+	/* The libvshadow input volume
+	 */
+	libvshadow_volume_t *input_volume;
+
+	/* The volume size
+	 */
+	size64_t volume_size;
+
+	/* The extents sorted by source offset
+	 */
+	export_extent_t *extents;
+
+	/* The number of extents
+	 */
+	int number_of_extents;
+
+	/* The number of allocated extents
+	 */
+	int number_of_allocated_extents;
+
+	/* The number of outputs
+	 */
+	int number_of_outputs;
+
+	/* The store index of each output
+	 */
+	int *output_store_indexes;
+
+	/* The output files
+	 */
+	libcfile_file_t **output_files;
+
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	/* The output file mutexes
+	 */
+	libcthreads_mutex_t **output_mutexes;
+
+	/* The write thread pool
+	 */
+	libcthreads_thread_pool_t *write_thread_pool;
+#endif
+
+	/* The number of bytes read from the input
+	 */
+	size64_t input_size;
+
+	/* The number of bytes written to the outputs
+	 */
+	size64_t output_size;
+
+	/* Value to indicate a write job has failed
+	 */
+	int write_failed;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int export_handle_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int export_handle_initialize(
+     export_handle_t **export_handle,
+     libcerror_error_t **error );
+
+int export_handle_free(
+     export_handle_t **export_handle,
+     libcerror_error_t **error );
+
+int export_handle_signal_abort(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_set_volume_offset(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_store_index(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_number_of_threads(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_format(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_target_path(
+     export_handle_t *export_handle,
+     const system_character_t *target_path,
+     libcerror_error_t **error );
+
+int export_handle_open_input(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int export_handle_close(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_extent_compare_by_source_offset(
+     const export_extent_t *first_extent,
+     const export_extent_t *second_extent );
+
+int export_handle_append_extent(
+     export_handle_t *export_handle,
+     off64_t source_offset,
+     off64_t target_offset,
+     size64_t size,
+     int output_index,
+     libcerror_error_t **error );
+
+int export_handle_plan_store(
+     export_handle_t *export_handle,
+     int output_index,
+     libvshadow_store_t *store,
+     libcerror_error_t **error );
+
+int export_handle_plan(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_open_outputs(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_close_outputs(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_write_extent(
+     export_handle_t *export_handle,
+     const uint8_t *buffer,
+     off64_t buffer_source_offset,
+     export_extent_t *extent,
+     libcerror_error_t **error );
+
+int export_write_job_free(
+     export_write_job_t **write_job,
+     libcerror_error_t **error );
+
+int export_handle_process_write_job(
+     export_write_job_t *write_job,
+     export_handle_t *export_handle );
+
+int export_handle_export(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_get_qcow2_filename(
+     export_handle_t *export_handle,
+     int store_index,
+     system_character_t *filename,
+     size_t filename_size,
+     libcerror_error_t **error );
+
+int export_handle_get_backing_file_name(
+     const system_character_t *filename,
+     uint8_t *backing_file_name,
+     size_t backing_file_name_size,
+     size_t *name_size,
+     libcerror_error_t **error );
+
+int export_handle_get_image_data_source(
+     export_handle_t *export_handle,
+     libvshadow_store_t *store,
+     off64_t offset,
+     int *source_type,
+     off64_t *source_offset,
+     size64_t *source_size,
+     libcerror_error_t **error );
+
+int export_handle_write_qcow2_run(
+     export_handle_t *export_handle,
+     qcow2_writer_t *qcow2_writer,
+     libvshadow_store_t *store,
+     uint8_t *buffer,
+     off64_t run_offset,
+     size_t run_size,
+     libcerror_error_t **error );
+
+int export_handle_append_qcow2_cluster(
+     export_handle_t *export_handle,
+     qcow2_writer_t *qcow2_writer,
+     libvshadow_store_t *store,
+     uint8_t *buffer,
+     size_t buffer_size,
+     off64_t *run_offset,
+     size_t *run_size,
+     off64_t cluster_offset,
+     int has_data,
+     libcerror_error_t **error );
+
+int export_handle_export_qcow2_image(
+     export_handle_t *export_handle,
+     libvshadow_store_t *store,
+     libvshadow_store_t *backing_store,
+     int has_backing,
+     const system_character_t *filename,
+     const uint8_t *backing_file_name,
+     size_t backing_file_name_size,
+     libcerror_error_t **error );
+
+int export_handle_export_qcow2_chain(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EXPORT_HANDLE_H ) */
+
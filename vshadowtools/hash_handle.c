@@ -0,0 +1,3622 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "hash_handle.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcfile.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libhmac.h"
+#include "vshadowtools_libvshadow.h"
+
+#if !defined( LIBVSHADOW_HAVE_BFIO )
+
+extern \
+int libvshadow_volume_open_file_io_handle(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libvshadow_error_t **error );
+
+extern \
+int libvshadow_check_volume_signature_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#endif /* !defined( LIBVSHADOW_HAVE_BFIO ) */
+
+#define HASH_HANDLE_NOTIFY_STREAM		stdout
+
+static const char *hash_handle_hexadecimal_digits = "0123456789abcdef";
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "hash_handle_system_string_copy_from_64_bit_in_decimal";
+	system_character_t character_value = 0;
+	size_t string_index                = 0;
+	uint8_t maximum_string_index       = 20;
+	int8_t sign                        = 1;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	if( string[ string_index ] == (system_character_t) '-' )
+	{
+		string_index++;
+		maximum_string_index++;
+
+		sign = -1;
+	}
+	else if( string[ string_index ] == (system_character_t) '+' )
+	{
+		string_index++;
+		maximum_string_index++;
+	}
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	if( sign == -1 )
+	{
+		*value_64bit *= (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+/* Creates an hash handle
+ * Make sure the value hash_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_initialize";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*hash_handle = memory_allocate_structure(
+	                hash_handle_t );
+
+	if( *hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *hash_handle,
+	     0,
+	     sizeof( hash_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash handle.",
+		 function );
+
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_file_range_initialize(
+	     &( ( *hash_handle )->input_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_initialize(
+	     &( ( *hash_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input volume.",
+		 function );
+
+		goto on_error;
+	}
+	( *hash_handle )->store_index   = -1;
+	( *hash_handle )->block_size    = HASH_HANDLE_DEFAULT_BLOCK_SIZE;
+	( *hash_handle )->read_size     = HASH_HANDLE_DEFAULT_READ_SIZE;
+	( *hash_handle )->notify_stream = HASH_HANDLE_NOTIFY_STREAM;
+
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	( *hash_handle )->number_of_threads = 4;
+#endif
+	return( 1 );
+
+on_error:
+	if( *hash_handle != NULL )
+	{
+		if( ( *hash_handle )->input_file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *hash_handle )->input_file_io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an hash handle
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_free";
+	int result            = 1;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		if( ( *hash_handle )->output_files != NULL )
+		{
+			if( hash_handle_close_outputs(
+			     *hash_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close outputs.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libvshadow_volume_free(
+		     &( ( *hash_handle )->input_volume ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input volume.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *hash_handle )->input_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *hash_handle )->extents != NULL )
+		{
+			memory_free(
+			 ( *hash_handle )->extents );
+		}
+		if( ( *hash_handle )->target_path != NULL )
+		{
+			memory_free(
+			 ( *hash_handle )->target_path );
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the hash handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_signal_abort";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->abort = 1;
+
+	if( hash_handle->input_volume != NULL )
+	{
+		if( libvshadow_volume_signal_abort(
+		     hash_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input volume to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the volume offset
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_volume_offset(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_volume_offset";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( hash_handle_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->volume_offset = (off64_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the store index
+ * The string contains the store number, which starts at 1, or "all"
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_store_index(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_store_index";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( ( string_length == 3 )
+	 && ( system_string_compare(
+	       string,
+	       _SYSTEM_STRING( "all" ),
+	       3 ) == 0 ) )
+	{
+		hash_handle->store_index = -1;
+
+		return( 1 );
+	}
+	if( hash_handle_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->store_index = (int) value_64bit - 1;
+
+	return( 1 );
+}
+
+/* Sets the number of worker threads
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_number_of_threads(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( hash_handle_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > 64 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the block size
+ * The block size must be a multiple of 512 and not exceed the read size
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_block_size(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_block_size";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( hash_handle_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( ( value_64bit % 512 ) != 0 )
+	 || ( value_64bit > (uint64_t) hash_handle->read_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->block_size = (size_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the target path prefix
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_target_path(
+     hash_handle_t *hash_handle,
+     const system_character_t *target_path,
+     libcerror_error_t **error )
+{
+	static char *function   = "hash_handle_set_target_path";
+	size_t target_path_size = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->target_path != NULL )
+	{
+		memory_free(
+		 hash_handle->target_path );
+
+		hash_handle->target_path      = NULL;
+		hash_handle->target_path_size = 0;
+	}
+	target_path_size = system_string_length(
+	                    target_path ) + 1;
+
+	if( target_path_size == 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing target path.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->target_path = system_string_allocate(
+	                            target_path_size );
+
+	if( hash_handle->target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create target path.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     hash_handle->target_path,
+	     target_path,
+	     target_path_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy target path.",
+		 function );
+
+		goto on_error;
+	}
+	hash_handle->target_path[ target_path_size - 1 ] = 0;
+
+	hash_handle->target_path_size = target_path_size;
+
+	return( 1 );
+
+on_error:
+	if( hash_handle->target_path != NULL )
+	{
+		memory_free(
+		 hash_handle->target_path );
+
+		hash_handle->target_path = NULL;
+	}
+	hash_handle->target_path_size = 0;
+
+	return( -1 );
+}
+
+/* Opens the input of the hash handle
+ * Returns 1 if successful, 0 if no VSS enabled volume was found or -1 on error
+ */
+int hash_handle_open_input(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "hash_handle_open_input";
+	size_t filename_length = 0;
+	int result             = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_range_set_name_wide(
+	     hash_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_range_set_name(
+	     hash_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_range_set(
+	     hash_handle->input_file_io_handle,
+	     hash_handle->volume_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open set volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_check_volume_signature_file_io_handle(
+	          hash_handle->input_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if volume has a VSS signature.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libvshadow_volume_open_file_io_handle(
+		     hash_handle->input_volume,
+		     hash_handle->input_file_io_handle,
+		     LIBVSHADOW_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open input volume.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvshadow_volume_get_size(
+		     hash_handle->input_volume,
+		     &( hash_handle->volume_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve volume size.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Closes the hash handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int hash_handle_close(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_close";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_close(
+	     hash_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Compares 2 extents by their type and source offset
+ * Data extents are sorted by source offset, other extents by output index and target offset
+ * Returns -1 if the first extent is less than the second, 0 if equal or 1 if greater
+ */
+int hash_extent_compare(
+     const hash_extent_t *first_extent,
+     const hash_extent_t *second_extent )
+{
+	if( first_extent->type < second_extent->type )
+	{
+		return( -1 );
+	}
+	else if( first_extent->type > second_extent->type )
+	{
+		return( 1 );
+	}
+	if( first_extent->type == HASH_EXTENT_TYPE_DATA )
+	{
+		if( first_extent->source_offset < second_extent->source_offset )
+		{
+			return( -1 );
+		}
+		else if( first_extent->source_offset > second_extent->source_offset )
+		{
+			return( 1 );
+		}
+	}
+	if( first_extent->output_index < second_extent->output_index )
+	{
+		return( -1 );
+	}
+	else if( first_extent->output_index > second_extent->output_index )
+	{
+		return( 1 );
+	}
+	if( first_extent->target_offset < second_extent->target_offset )
+	{
+		return( -1 );
+	}
+	else if( first_extent->target_offset > second_extent->target_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Appends an extent
+ * The extent is merged with the last extent if they are of the same type and contiguous
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_append_extent(
+     hash_handle_t *hash_handle,
+     int type,
+     off64_t source_offset,
+     off64_t target_offset,
+     size64_t size,
+     int output_index,
+     libcerror_error_t **error )
+{
+	hash_extent_t *extent  = NULL;
+	hash_extent_t *extents = NULL;
+	static char *function  = "hash_handle_append_extent";
+	size_t extents_size    = 0;
+	int number_of_extents  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->number_of_extents > 0 )
+	{
+		extent = &( hash_handle->extents[ hash_handle->number_of_extents - 1 ] );
+
+		if( ( extent->type == type )
+		 && ( extent->output_index == output_index )
+		 && ( ( extent->source_offset + (off64_t) extent->size ) == source_offset )
+		 && ( ( extent->target_offset + (off64_t) extent->size ) == target_offset ) )
+		{
+			extent->size += size;
+
+			return( 1 );
+		}
+	}
+	if( hash_handle->number_of_extents >= hash_handle->number_of_allocated_extents )
+	{
+		if( hash_handle->number_of_allocated_extents == 0 )
+		{
+			number_of_extents = 1024;
+		}
+		else if( hash_handle->number_of_allocated_extents < ( INT_MAX / 2 ) )
+		{
+			number_of_extents = hash_handle->number_of_allocated_extents * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of extents value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		extents_size = sizeof( hash_extent_t ) * number_of_extents;
+
+		if( extents_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid extents size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		extents = (hash_extent_t *) memory_reallocate(
+		                             hash_handle->extents,
+		                             extents_size );
+
+		if( extents == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize extents.",
+			 function );
+
+			return( -1 );
+		}
+		hash_handle->extents                     = extents;
+		hash_handle->number_of_allocated_extents = number_of_extents;
+	}
+	extent = &( hash_handle->extents[ hash_handle->number_of_extents ] );
+
+	extent->source_offset = source_offset;
+	extent->target_offset = target_offset;
+	extent->size          = size;
+	extent->output_index  = output_index;
+	extent->type          = type;
+
+	hash_handle->number_of_extents += 1;
+
+	return( 1 );
+}
+
+/* Determines the extents of a range of a store that has a single source
+ * The blocks that are fully contained in the range are appended as a data or sparse extent
+ * A block that starts in the range but ends beyond it is appended as a mixed extent,
+ * the remainder of a block that started in a preceding range is skipped
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_plan_range(
+     hash_handle_t *hash_handle,
+     int output_index,
+     int type,
+     off64_t source_offset,
+     off64_t target_offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_plan_range";
+	size64_t block_size   = 0;
+	off64_t block_offset  = 0;
+	off64_t end_offset    = 0;
+	off64_t range_offset  = 0;
+	off64_t whole_offset  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash handle - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( target_offset < 0 )
+	 || ( (size64_t) target_offset >= hash_handle->volume_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid target offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	end_offset = target_offset + (off64_t) size;
+
+	if( (size64_t) end_offset > hash_handle->volume_size )
+	{
+		end_offset = (off64_t) hash_handle->volume_size;
+	}
+	range_offset = target_offset;
+	block_offset = target_offset % (off64_t) hash_handle->block_size;
+
+	if( block_offset != 0 )
+	{
+		range_offset += (off64_t) hash_handle->block_size - block_offset;
+
+		if( range_offset > end_offset )
+		{
+			range_offset = end_offset;
+		}
+	}
+	/* The last block of the volume can be smaller than the block size
+	 */
+	if( (size64_t) end_offset == hash_handle->volume_size )
+	{
+		whole_offset = end_offset;
+	}
+	else
+	{
+		whole_offset = end_offset - ( end_offset % (off64_t) hash_handle->block_size );
+	}
+	if( whole_offset > range_offset )
+	{
+		if( type != HASH_EXTENT_TYPE_DATA )
+		{
+			source_offset = range_offset;
+		}
+		else
+		{
+			source_offset += range_offset - target_offset;
+		}
+		if( hash_handle_append_extent(
+		     hash_handle,
+		     type,
+		     source_offset,
+		     range_offset,
+		     (size64_t) ( whole_offset - range_offset ),
+		     output_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append extent.",
+			 function );
+
+			return( -1 );
+		}
+		range_offset = whole_offset;
+	}
+	if( range_offset < end_offset )
+	{
+		block_size = hash_handle->volume_size - (size64_t) range_offset;
+
+		if( block_size > (size64_t) hash_handle->block_size )
+		{
+			block_size = (size64_t) hash_handle->block_size;
+		}
+		if( hash_handle_append_extent(
+		     hash_handle,
+		     HASH_EXTENT_TYPE_MIXED,
+		     range_offset,
+		     range_offset,
+		     block_size,
+		     output_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append mixed extent.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Determines the extents of a store
+ * Consecutive data sources that are contiguous in the volume, or that are all sparse,
+ * are combined into a single range before the range is split into blocks
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_plan_store(
+     hash_handle_t *hash_handle,
+     int output_index,
+     libvshadow_store_t *store,
+     libcerror_error_t **error )
+{
+	static char *function       = "hash_handle_plan_store";
+	size64_t range_size         = 0;
+	size64_t source_size        = 0;
+	off64_t offset              = 0;
+	off64_t range_source_offset = 0;
+	off64_t range_target_offset = 0;
+	off64_t source_offset       = 0;
+	int range_type              = 0;
+	int source_store_index      = 0;
+	int source_type             = 0;
+	int type                    = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	while( (size64_t) offset < hash_handle->volume_size )
+	{
+		if( hash_handle->abort != 0 )
+		{
+			return( -1 );
+		}
+		if( libvshadow_store_get_data_source_at_offset(
+		     store,
+		     offset,
+		     &source_type,
+		     &source_store_index,
+		     &source_offset,
+		     &source_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data source at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( source_size == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid source size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( source_type == LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE )
+		 || ( source_type == LIBVSHADOW_DATA_SOURCE_TYPE_UNALLOCATED ) )
+		{
+			type          = HASH_EXTENT_TYPE_SPARSE;
+			source_offset = offset;
+		}
+		else
+		{
+			type = HASH_EXTENT_TYPE_DATA;
+		}
+		if( ( range_size > 0 )
+		 && ( range_type == type )
+		 && ( ( range_source_offset + (off64_t) range_size ) == source_offset ) )
+		{
+			range_size += source_size;
+		}
+		else
+		{
+			if( range_size > 0 )
+			{
+				if( hash_handle_plan_range(
+				     hash_handle,
+				     output_index,
+				     range_type,
+				     range_source_offset,
+				     range_target_offset,
+				     range_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine extents of range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+					 function,
+					 range_target_offset,
+					 range_target_offset );
+
+					return( -1 );
+				}
+			}
+			range_type          = type;
+			range_source_offset = source_offset;
+			range_target_offset = offset;
+			range_size          = source_size;
+		}
+		offset += (off64_t) source_size;
+	}
+	if( range_size > 0 )
+	{
+		if( hash_handle_plan_range(
+		     hash_handle,
+		     output_index,
+		     range_type,
+		     range_source_offset,
+		     range_target_offset,
+		     range_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine extents of range at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 range_target_offset,
+			 range_target_offset );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Determines the extents of the stores to hash and sorts them by type and source offset
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_plan(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	libvshadow_store_t *store = NULL;
+	static char *function     = "hash_handle_plan";
+	size_t indexes_size       = 0;
+	int number_of_stores      = 0;
+	int output_index          = 0;
+	int result                = 0;
+	int store_index           = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->output_store_indexes != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle - output store indexes value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_number_of_stores(
+	     hash_handle->input_volume,
+	     &number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	if( hash_handle->store_index >= number_of_stores )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid store number value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_stores > 0 )
+	{
+		indexes_size = sizeof( int ) * number_of_stores;
+
+		hash_handle->output_store_indexes = (int *) memory_allocate(
+		                                             indexes_size );
+
+		if( hash_handle->output_store_indexes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create output store indexes.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		if( ( hash_handle->store_index != -1 )
+		 && ( hash_handle->store_index != store_index ) )
+		{
+			continue;
+		}
+		if( libvshadow_volume_get_store(
+		     hash_handle->input_volume,
+		     store_index,
+		     &store,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		result = libvshadow_store_has_in_volume_data(
+		          store,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if store: %d has in-volume data.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			fprintf(
+			 hash_handle->notify_stream,
+			 "Determining extents of store: %d\n",
+			 store_index + 1 );
+
+			if( hash_handle_plan_store(
+			     hash_handle,
+			     output_index,
+			     store,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine extents of store: %d.",
+				 function,
+				 store_index );
+
+				goto on_error;
+			}
+			hash_handle->output_store_indexes[ output_index++ ] = store_index;
+		}
+		if( libvshadow_store_free(
+		     &store,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+	}
+	hash_handle->number_of_outputs = output_index;
+
+	/* Sorting the data extents by source offset allows the input to be read in a single pass
+	 */
+	if( hash_handle->number_of_extents > 1 )
+	{
+		qsort(
+		 hash_handle->extents,
+		 (size_t) hash_handle->number_of_extents,
+		 sizeof( hash_extent_t ),
+		 (int (*)(const void *, const void *)) &hash_extent_compare );
+	}
+	return( 1 );
+
+on_error:
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( hash_handle->output_store_indexes != NULL )
+	{
+		memory_free(
+		 hash_handle->output_store_indexes );
+
+		hash_handle->output_store_indexes = NULL;
+	}
+	return( -1 );
+}
+
+/* Opens the outputs
+ * Every output (manifest) is created with the size of all its lines, since the lines
+ * are written in order of source offset and not in order of target offset
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_open_outputs(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	system_character_t *output_filename = NULL;
+	static char *function               = "hash_handle_open_outputs";
+	size64_t manifest_size              = 0;
+	size64_t number_of_blocks           = 0;
+	size_t array_size                   = 0;
+	size_t output_filename_size         = 0;
+	int output_index                    = 0;
+	int print_count                     = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->output_files != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle - output files value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->target_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hash handle - missing target path.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash handle - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->number_of_outputs == 0 )
+	{
+		return( 1 );
+	}
+	number_of_blocks = hash_handle->volume_size / hash_handle->block_size;
+
+	if( ( hash_handle->volume_size % hash_handle->block_size ) != 0 )
+	{
+		number_of_blocks += 1;
+	}
+	manifest_size = number_of_blocks * HASH_HANDLE_MANIFEST_LINE_SIZE;
+
+	array_size = sizeof( libcfile_file_t * ) * hash_handle->number_of_outputs;
+
+	hash_handle->output_files = (libcfile_file_t **) memory_allocate(
+	                                                  array_size );
+
+	if( hash_handle->output_files == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create output files.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     hash_handle->output_files,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear output files.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	array_size = sizeof( libcthreads_mutex_t * ) * hash_handle->number_of_outputs;
+
+	hash_handle->output_mutexes = (libcthreads_mutex_t **) memory_allocate(
+	                                                        array_size );
+
+	if( hash_handle->output_mutexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create output mutexes.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     hash_handle->output_mutexes,
+	     0,
+	     array_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear output mutexes.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	/* The target path is suffixed by the store number, which is at most 10 digits,
+	 * and the ".sha256" extension
+	 */
+	output_filename_size = hash_handle->target_path_size + 10 + 7;
+
+	output_filename = system_string_allocate(
+	                   output_filename_size );
+
+	if( output_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create output filename.",
+		 function );
+
+		goto on_error;
+	}
+	for( output_index = 0;
+	     output_index < hash_handle->number_of_outputs;
+	     output_index++ )
+	{
+		print_count = system_string_sprintf(
+		               output_filename,
+		               output_filename_size,
+		               _SYSTEM_STRING( "%" PRIs_SYSTEM "%d.sha256" ),
+		               hash_handle->target_path,
+		               hash_handle->output_store_indexes[ output_index ] + 1 );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= output_filename_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set output filename.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcfile_file_initialize(
+		     &( hash_handle->output_files[ output_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create output file: %d.",
+			 function,
+			 output_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcfile_file_open_wide(
+		     hash_handle->output_files[ output_index ],
+		     output_filename,
+		     LIBCFILE_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+#else
+		if( libcfile_file_open(
+		     hash_handle->output_files[ output_index ],
+		     output_filename,
+		     LIBCFILE_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open output file: %" PRIs_SYSTEM ".",
+			 function,
+			 output_filename );
+
+			goto on_error;
+		}
+		if( libcfile_file_resize(
+		     hash_handle->output_files[ output_index ],
+		     manifest_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to resize output file: %" PRIs_SYSTEM ".",
+			 function,
+			 output_filename );
+
+			goto on_error;
+		}
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_initialize(
+		     &( hash_handle->output_mutexes[ output_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create output mutex: %d.",
+			 function,
+			 output_index );
+
+			goto on_error;
+		}
+#endif
+		fprintf(
+		 hash_handle->notify_stream,
+		 "Writing manifest of store: %d to: %" PRIs_SYSTEM "\n",
+		 hash_handle->output_store_indexes[ output_index ] + 1,
+		 output_filename );
+	}
+	memory_free(
+	 output_filename );
+
+	return( 1 );
+
+on_error:
+	if( output_filename != NULL )
+	{
+		memory_free(
+		 output_filename );
+	}
+	if( hash_handle->output_files != NULL )
+	{
+		hash_handle_close_outputs(
+		 hash_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Closes the outputs
+ * Returns 0 if successful or -1 on error
+ */
+int hash_handle_close_outputs(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_close_outputs";
+	int output_index      = 0;
+	int result            = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->output_files != NULL )
+	{
+		for( output_index = 0;
+		     output_index < hash_handle->number_of_outputs;
+		     output_index++ )
+		{
+			if( hash_handle->output_files[ output_index ] == NULL )
+			{
+				continue;
+			}
+			if( libcfile_file_close(
+			     hash_handle->output_files[ output_index ],
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close output file: %d.",
+				 function,
+				 output_index );
+
+				result = -1;
+			}
+			if( libcfile_file_free(
+			     &( hash_handle->output_files[ output_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free output file: %d.",
+				 function,
+				 output_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 hash_handle->output_files );
+
+		hash_handle->output_files = NULL;
+	}
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	if( hash_handle->output_mutexes != NULL )
+	{
+		for( output_index = 0;
+		     output_index < hash_handle->number_of_outputs;
+		     output_index++ )
+		{
+			if( hash_handle->output_mutexes[ output_index ] == NULL )
+			{
+				continue;
+			}
+			if( libcthreads_mutex_free(
+			     &( hash_handle->output_mutexes[ output_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free output mutex: %d.",
+				 function,
+				 output_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 hash_handle->output_mutexes );
+
+		hash_handle->output_mutexes = NULL;
+	}
+#endif
+	if( hash_handle->output_store_indexes != NULL )
+	{
+		memory_free(
+		 hash_handle->output_store_indexes );
+
+		hash_handle->output_store_indexes = NULL;
+	}
+	hash_handle->number_of_outputs = 0;
+
+	return( result );
+}
+
+/* Writes a line to the manifest of an output
+ * The line of a block is stored at the block number multiplied by the line size
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_write_manifest_line(
+     hash_handle_t *hash_handle,
+     int output_index,
+     off64_t target_offset,
+     const uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error )
+{
+	uint8_t line[ HASH_HANDLE_MANIFEST_LINE_SIZE ];
+
+	libcfile_file_t *output_file = NULL;
+	static char *function        = "hash_handle_write_manifest_line";
+	size_t hash_index            = 0;
+	size_t line_index            = 0;
+	ssize_t write_count          = 0;
+	off64_t line_offset          = 0;
+	uint64_t value_64bit         = 0;
+	int result                   = 1;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash handle - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_index < 0 )
+	 || ( output_index >= hash_handle->number_of_outputs ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( target_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid target offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_size != LIBHMAC_SHA256_HASH_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	value_64bit = (uint64_t) target_offset;
+
+	for( line_index = 16;
+	     line_index > 0;
+	     line_index-- )
+	{
+		line[ line_index - 1 ] = (uint8_t) hash_handle_hexadecimal_digits[ value_64bit & 0x0f ];
+
+		value_64bit >>= 4;
+	}
+	line[ 16 ] = (uint8_t) ' ';
+
+	line_index = 17;
+
+	for( hash_index = 0;
+	     hash_index < hash_size;
+	     hash_index++ )
+	{
+		line[ line_index++ ] = (uint8_t) hash_handle_hexadecimal_digits[ hash[ hash_index ] >> 4 ];
+		line[ line_index++ ] = (uint8_t) hash_handle_hexadecimal_digits[ hash[ hash_index ] & 0x0f ];
+	}
+	line[ line_index ] = (uint8_t) '\n';
+
+	output_file = hash_handle->output_files[ output_index ];
+	line_offset = ( target_offset / (off64_t) hash_handle->block_size ) * HASH_HANDLE_MANIFEST_LINE_SIZE;
+
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     hash_handle->output_mutexes[ output_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab output mutex: %d.",
+		 function,
+		 output_index );
+
+		return( -1 );
+	}
+#endif
+	if( libcfile_file_seek_offset(
+	     output_file,
+	     line_offset,
+	     SEEK_SET,
+	     error ) != line_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in output: %d.",
+		 function,
+		 line_offset,
+		 line_offset,
+		 output_index );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		write_count = libcfile_file_write_buffer(
+		               output_file,
+		               line,
+		               HASH_HANDLE_MANIFEST_LINE_SIZE,
+		               error );
+
+		if( write_count != (ssize_t) HASH_HANDLE_MANIFEST_LINE_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write line to output: %d.",
+			 function,
+			 output_index );
+
+			result = -1;
+		}
+	}
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     hash_handle->output_mutexes[ output_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release output mutex: %d.",
+		 function,
+		 output_index );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Writes the manifest lines of the blocks of a sparse extent
+ * The sparse block data must contain 0-byte values and be at least of block size
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_hash_sparse_extent(
+     hash_handle_t *hash_handle,
+     hash_extent_t *extent,
+     const uint8_t *sparse_block_data,
+     libcerror_error_t **error )
+{
+	uint8_t hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	static char *function    = "hash_handle_hash_sparse_extent";
+	const uint8_t *block_hash = NULL;
+	size64_t block_size      = 0;
+	off64_t relative_offset  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent.",
+		 function );
+
+		return( -1 );
+	}
+	if( sparse_block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sparse block data.",
+		 function );
+
+		return( -1 );
+	}
+	while( (size64_t) relative_offset < extent->size )
+	{
+		if( hash_handle->abort != 0 )
+		{
+			return( -1 );
+		}
+		block_size = extent->size - (size64_t) relative_offset;
+
+		if( block_size >= (size64_t) hash_handle->block_size )
+		{
+			block_size = (size64_t) hash_handle->block_size;
+			block_hash = hash_handle->sparse_block_hash;
+		}
+		else
+		{
+			if( libhmac_sha256_calculate(
+			     sparse_block_data,
+			     (size_t) block_size,
+			     hash,
+			     LIBHMAC_SHA256_HASH_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to calculate SHA-256 of sparse block.",
+				 function );
+
+				return( -1 );
+			}
+			block_hash = hash;
+		}
+		if( hash_handle_write_manifest_line(
+		     hash_handle,
+		     extent->output_index,
+		     extent->target_offset + relative_offset,
+		     block_hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write manifest line of output: %d.",
+			 function,
+			 extent->output_index );
+
+			return( -1 );
+		}
+		hash_handle->number_of_manifest_blocks += 1;
+
+		relative_offset += (off64_t) block_size;
+	}
+	return( 1 );
+}
+
+/* Hashes the blocks of a mixed extent
+ * The data of these blocks is read through the store since it comes from multiple sources
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_hash_mixed_extent(
+     hash_handle_t *hash_handle,
+     hash_extent_t *extent,
+     libvshadow_store_t *store,
+     uint8_t *block_data,
+     libcerror_error_t **error )
+{
+	uint8_t hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	static char *function   = "hash_handle_hash_mixed_extent";
+	size64_t block_size     = 0;
+	ssize_t read_count      = 0;
+	off64_t relative_offset = 0;
+	off64_t target_offset   = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid block data.",
+		 function );
+
+		return( -1 );
+	}
+	while( (size64_t) relative_offset < extent->size )
+	{
+		if( hash_handle->abort != 0 )
+		{
+			return( -1 );
+		}
+		block_size = extent->size - (size64_t) relative_offset;
+
+		if( block_size > (size64_t) hash_handle->block_size )
+		{
+			block_size = (size64_t) hash_handle->block_size;
+		}
+		target_offset = extent->target_offset + relative_offset;
+
+		read_count = libvshadow_store_read_buffer_at_offset(
+		              store,
+		              block_data,
+		              (size_t) block_size,
+		              target_offset,
+		              error );
+
+		if( read_count != (ssize_t) block_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block at offset: %" PRIi64 " (0x%08" PRIx64 ") from store.",
+			 function,
+			 target_offset,
+			 target_offset );
+
+			return( -1 );
+		}
+		hash_handle->input_size += block_size;
+
+		if( libhmac_sha256_calculate(
+		     block_data,
+		     (size_t) block_size,
+		     hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate SHA-256 of block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 target_offset,
+			 target_offset );
+
+			return( -1 );
+		}
+		hash_handle->number_of_hashed_blocks += 1;
+
+		if( hash_handle_write_manifest_line(
+		     hash_handle,
+		     extent->output_index,
+		     target_offset,
+		     hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write manifest line of output: %d.",
+			 function,
+			 extent->output_index );
+
+			return( -1 );
+		}
+		hash_handle->number_of_manifest_blocks += 1;
+
+		relative_offset += (off64_t) block_size;
+	}
+	return( 1 );
+}
+
+/* Creates a hash job
+ * Make sure the value hash_job is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int hash_job_initialize(
+     hash_job_t **hash_job,
+     hash_handle_t *hash_handle,
+     off64_t source_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_job_initialize";
+
+	if( hash_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_job != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash job value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*hash_job = memory_allocate_structure(
+	             hash_job_t );
+
+	if( *hash_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash job.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *hash_job,
+	     0,
+	     sizeof( hash_job_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash job.",
+		 function );
+
+		goto on_error;
+	}
+	( *hash_job )->hash_handle   = hash_handle;
+	( *hash_job )->source_offset = source_offset;
+
+	return( 1 );
+
+on_error:
+	if( *hash_job != NULL )
+	{
+		memory_free(
+		 *hash_job );
+
+		*hash_job = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a hash job
+ * Returns 1 if successful or -1 on error
+ */
+int hash_job_free(
+     hash_job_t **hash_job,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_job_free";
+
+	if( hash_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash job.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_job != NULL )
+	{
+		if( ( *hash_job )->references != NULL )
+		{
+			memory_free(
+			 ( *hash_job )->references );
+		}
+		if( ( *hash_job )->blocks != NULL )
+		{
+			memory_free(
+			 ( *hash_job )->blocks );
+		}
+		if( ( *hash_job )->buffer != NULL )
+		{
+			memory_free(
+			 ( *hash_job )->buffer );
+		}
+		memory_free(
+		 *hash_job );
+
+		*hash_job = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends a block to a hash job
+ * The buffer size of the hash job is extended to contain the block
+ * Returns 1 if successful or -1 on error
+ */
+int hash_job_append_block(
+     hash_job_t *hash_job,
+     off64_t source_offset,
+     size_t size,
+     libcerror_error_t **error )
+{
+	hash_job_block_t *block  = NULL;
+	hash_job_block_t *blocks = NULL;
+	static char *function    = "hash_job_append_block";
+	size_t blocks_size       = 0;
+	int number_of_blocks     = 0;
+
+	if( hash_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash job.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_job->buffer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash job - buffer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( source_offset < hash_job->source_offset )
+	 || ( size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_job->number_of_blocks >= hash_job->number_of_allocated_blocks )
+	{
+		if( hash_job->number_of_allocated_blocks == 0 )
+		{
+			number_of_blocks = 64;
+		}
+		else if( hash_job->number_of_allocated_blocks < ( INT_MAX / 2 ) )
+		{
+			number_of_blocks = hash_job->number_of_allocated_blocks * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of blocks value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		blocks_size = sizeof( hash_job_block_t ) * number_of_blocks;
+
+		if( blocks_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid blocks size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		blocks = (hash_job_block_t *) memory_reallocate(
+		                               hash_job->blocks,
+		                               blocks_size );
+
+		if( blocks == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize blocks.",
+			 function );
+
+			return( -1 );
+		}
+		hash_job->blocks                     = blocks;
+		hash_job->number_of_allocated_blocks = number_of_blocks;
+	}
+	block = &( hash_job->blocks[ hash_job->number_of_blocks ] );
+
+	block->buffer_offset        = (size_t) ( source_offset - hash_job->source_offset );
+	block->size                 = size;
+	block->reference_index      = hash_job->number_of_references;
+	block->number_of_references = 0;
+
+	if( ( block->buffer_offset + size ) > hash_job->buffer_size )
+	{
+		hash_job->buffer_size = block->buffer_offset + size;
+	}
+	hash_job->number_of_blocks += 1;
+
+	return( 1 );
+}
+
+/* Appends a reference to the last block of a hash job
+ * Returns 1 if successful or -1 on error
+ */
+int hash_job_append_reference(
+     hash_job_t *hash_job,
+     off64_t target_offset,
+     int output_index,
+     libcerror_error_t **error )
+{
+	hash_job_reference_t *reference  = NULL;
+	hash_job_reference_t *references = NULL;
+	static char *function            = "hash_job_append_reference";
+	size_t references_size           = 0;
+	int number_of_references         = 0;
+
+	if( hash_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash job.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_job->number_of_blocks == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hash job - missing blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_job->number_of_references >= hash_job->number_of_allocated_references )
+	{
+		if( hash_job->number_of_allocated_references == 0 )
+		{
+			number_of_references = 64;
+		}
+		else if( hash_job->number_of_allocated_references < ( INT_MAX / 2 ) )
+		{
+			number_of_references = hash_job->number_of_allocated_references * 2;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of references value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		references_size = sizeof( hash_job_reference_t ) * number_of_references;
+
+		if( references_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid references size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		references = (hash_job_reference_t *) memory_reallocate(
+		                                       hash_job->references,
+		                                       references_size );
+
+		if( references == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize references.",
+			 function );
+
+			return( -1 );
+		}
+		hash_job->references                     = references;
+		hash_job->number_of_allocated_references = number_of_references;
+	}
+	reference = &( hash_job->references[ hash_job->number_of_references ] );
+
+	reference->target_offset = target_offset;
+	reference->output_index  = output_index;
+
+	hash_job->number_of_references += 1;
+
+	hash_job->blocks[ hash_job->number_of_blocks - 1 ].number_of_references += 1;
+
+	return( 1 );
+}
+
+/* Processes a hash job
+ * This function is used as the hash thread pool callback and frees the hash job
+ * Every block is hashed once and its hash is written to the manifests of all its references
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_process_hash_job(
+     hash_job_t *hash_job,
+     hash_handle_t *hash_handle )
+{
+	uint8_t hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	hash_job_block_t *block         = NULL;
+	hash_job_reference_t *reference = NULL;
+	libcerror_error_t *error        = NULL;
+	static char *function           = "hash_handle_process_hash_job";
+	int block_index                 = 0;
+	int reference_index             = 0;
+	int result                      = 1;
+
+	if( hash_job == NULL )
+	{
+		return( -1 );
+	}
+	if( hash_handle == NULL )
+	{
+		hash_handle = hash_job->hash_handle;
+	}
+	for( block_index = 0;
+	     block_index < hash_job->number_of_blocks;
+	     block_index++ )
+	{
+		if( ( hash_handle->abort != 0 )
+		 || ( hash_handle->hash_failed != 0 ) )
+		{
+			result = -1;
+
+			break;
+		}
+		block = &( hash_job->blocks[ block_index ] );
+
+		if( libhmac_sha256_calculate(
+		     &( hash_job->buffer[ block->buffer_offset ] ),
+		     block->size,
+		     hash,
+		     LIBHMAC_SHA256_HASH_SIZE,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate SHA-256 of block: %d.",
+			 function,
+			 block_index );
+
+			result = -1;
+		}
+		for( reference_index = 0;
+		     reference_index < block->number_of_references;
+		     reference_index++ )
+		{
+			if( result != 1 )
+			{
+				break;
+			}
+			reference = &( hash_job->references[ block->reference_index + reference_index ] );
+
+			if( hash_handle_write_manifest_line(
+			     hash_handle,
+			     reference->output_index,
+			     reference->target_offset,
+			     hash,
+			     LIBHMAC_SHA256_HASH_SIZE,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write manifest line of output: %d.",
+				 function,
+				 reference->output_index );
+
+				result = -1;
+			}
+		}
+		if( result != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			hash_handle->hash_failed = 1;
+
+			break;
+		}
+	}
+	hash_job_free(
+	 &hash_job,
+	 NULL );
+
+	return( result );
+}
+
+/* Reads the buffer of a hash job from the input and hashes it
+ * The hash job is pushed onto the hash thread pool if available, otherwise it is processed directly
+ * The hash job is freed by this function, also on error
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_submit_hash_job(
+     hash_handle_t *hash_handle,
+     hash_job_t *hash_job,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_submit_hash_job";
+	ssize_t read_count    = 0;
+	int result            = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( hash_job == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash job.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_job->buffer_size == 0 )
+	 || ( hash_job->buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash job - buffer size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	hash_job->buffer = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * hash_job->buffer_size );
+
+	if( hash_job->buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash job buffer.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer_at_offset(
+	              hash_handle->input_file_io_handle,
+	              hash_job->buffer,
+	              hash_job->buffer_size,
+	              hash_job->source_offset,
+	              error );
+
+	if( read_count != (ssize_t) hash_job->buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 hash_job->source_offset,
+		 hash_job->source_offset );
+
+		goto on_error;
+	}
+	hash_handle->input_size += hash_job->buffer_size;
+
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	if( hash_handle->hash_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_push(
+		     hash_handle->hash_thread_pool,
+		     (intptr_t *) hash_job,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push hash job onto queue.",
+			 function );
+
+			goto on_error;
+		}
+		return( 1 );
+	}
+#endif
+	result = hash_handle_process_hash_job(
+	          hash_job,
+	          hash_handle );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to process hash job.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	hash_job_free(
+	 &hash_job,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Compares 2 cursors by their source offset and size
+ * Returns -1 if the first cursor is less than the second, 0 if equal or 1 if greater
+ */
+int hash_cursor_compare(
+     const hash_cursor_t *first_cursor,
+     const hash_cursor_t *second_cursor )
+{
+	if( first_cursor->source_offset < second_cursor->source_offset )
+	{
+		return( -1 );
+	}
+	else if( first_cursor->source_offset > second_cursor->source_offset )
+	{
+		return( 1 );
+	}
+	if( first_cursor->size < second_cursor->size )
+	{
+		return( -1 );
+	}
+	else if( first_cursor->size > second_cursor->size )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Moves a cursor down in a binary min-heap of cursors until the heap is restored
+ */
+void hash_cursor_heap_sift_down(
+      hash_cursor_t *cursors,
+      int number_of_cursors,
+      int cursor_index )
+{
+	hash_cursor_t cursor;
+
+	int child_index = 0;
+
+	if( ( cursors == NULL )
+	 || ( cursor_index < 0 )
+	 || ( cursor_index >= number_of_cursors ) )
+	{
+		return;
+	}
+	cursor = cursors[ cursor_index ];
+
+	while( cursor_index < ( number_of_cursors / 2 ) )
+	{
+		child_index = ( 2 * cursor_index ) + 1;
+
+		if( ( ( child_index + 1 ) < number_of_cursors )
+		 && ( hash_cursor_compare(
+		       &( cursors[ child_index + 1 ] ),
+		       &( cursors[ child_index ] ) ) < 0 ) )
+		{
+			child_index++;
+		}
+		if( hash_cursor_compare(
+		     &cursor,
+		     &( cursors[ child_index ] ) ) <= 0 )
+		{
+			break;
+		}
+		cursors[ cursor_index ] = cursors[ child_index ];
+
+		cursor_index = child_index;
+	}
+	cursors[ cursor_index ] = cursor;
+}
+
+/* Hashes the blocks of the data extents
+ * The blocks of all data extents are merged in order of source offset, so that every
+ * distinct block is read and hashed only once, even if it is referenced by multiple outputs
+ * Consecutive blocks are combined into hash jobs of up to the read size
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_hash_data_extents(
+     hash_handle_t *hash_handle,
+     int first_extent_index,
+     int number_of_extents,
+     libcerror_error_t **error )
+{
+	hash_cursor_t *cursor    = NULL;
+	hash_cursor_t *cursors   = NULL;
+	hash_extent_t *extent    = NULL;
+	hash_job_t *hash_job     = NULL;
+	static char *function    = "hash_handle_hash_data_extents";
+	size64_t block_size      = 0;
+	off64_t job_end_offset   = 0;
+	off64_t source_offset    = 0;
+	int cursor_index         = 0;
+	int number_of_cursors    = 0;
+	int result               = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( first_extent_index < 0 )
+	 || ( number_of_extents < 0 )
+	 || ( number_of_extents > ( hash_handle->number_of_extents - first_extent_index ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extents value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extents == 0 )
+	{
+		return( 1 );
+	}
+	if( (size_t) number_of_extents > ( (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( hash_cursor_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid number of extents value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	cursors = (hash_cursor_t *) memory_allocate(
+	                             sizeof( hash_cursor_t ) * number_of_extents );
+
+	if( cursors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create cursors.",
+		 function );
+
+		goto on_error;
+	}
+	for( cursor_index = 0;
+	     cursor_index < number_of_extents;
+	     cursor_index++ )
+	{
+		extent = &( hash_handle->extents[ first_extent_index + cursor_index ] );
+		cursor = &( cursors[ cursor_index ] );
+
+		cursor->source_offset   = extent->source_offset;
+		cursor->size            = extent->size;
+		cursor->relative_offset = 0;
+		cursor->extent_index    = first_extent_index + cursor_index;
+
+		if( cursor->size > (size64_t) hash_handle->block_size )
+		{
+			cursor->size = (size64_t) hash_handle->block_size;
+		}
+	}
+	number_of_cursors = number_of_extents;
+
+	for( cursor_index = ( number_of_cursors / 2 ) - 1;
+	     cursor_index >= 0;
+	     cursor_index-- )
+	{
+		hash_cursor_heap_sift_down(
+		 cursors,
+		 number_of_cursors,
+		 cursor_index );
+	}
+	while( number_of_cursors > 0 )
+	{
+		if( ( hash_handle->abort != 0 )
+		 || ( hash_handle->hash_failed != 0 ) )
+		{
+			break;
+		}
+		source_offset = cursors[ 0 ].source_offset;
+		block_size    = cursors[ 0 ].size;
+
+		/* Start a new hash job if the block is not contiguous with the buffer of the current one
+		 * or if it would make the buffer exceed the read size
+		 */
+		if( hash_job != NULL )
+		{
+			job_end_offset = hash_job->source_offset + (off64_t) hash_job->buffer_size;
+
+			if( ( source_offset > job_end_offset )
+			 || ( ( source_offset + (off64_t) block_size ) > ( hash_job->source_offset + (off64_t) hash_handle->read_size ) ) )
+			{
+				result = hash_handle_submit_hash_job(
+				          hash_handle,
+				          hash_job,
+				          error );
+
+				hash_job = NULL;
+
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GENERIC,
+					 "%s: unable to submit hash job.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		if( hash_job == NULL )
+		{
+			if( hash_job_initialize(
+			     &hash_job,
+			     hash_handle,
+			     source_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create hash job.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( hash_job_append_block(
+		     hash_job,
+		     source_offset,
+		     (size_t) block_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append block to hash job.",
+			 function );
+
+			goto on_error;
+		}
+		hash_handle->number_of_hashed_blocks += 1;
+
+		/* Add every output block that has the same source as a reference
+		 * and advance its cursor to the next block of the extent
+		 */
+		while( ( number_of_cursors > 0 )
+		    && ( cursors[ 0 ].source_offset == source_offset )
+		    && ( cursors[ 0 ].size == block_size ) )
+		{
+			cursor = &( cursors[ 0 ] );
+			extent = &( hash_handle->extents[ cursor->extent_index ] );
+
+			if( hash_job_append_reference(
+			     hash_job,
+			     extent->target_offset + cursor->relative_offset,
+			     extent->output_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append reference to hash job.",
+				 function );
+
+				goto on_error;
+			}
+			hash_handle->number_of_manifest_blocks += 1;
+
+			cursor->relative_offset += (off64_t) block_size;
+
+			if( (size64_t) cursor->relative_offset < extent->size )
+			{
+				cursor->source_offset = extent->source_offset + cursor->relative_offset;
+				cursor->size          = extent->size - (size64_t) cursor->relative_offset;
+
+				if( cursor->size > (size64_t) hash_handle->block_size )
+				{
+					cursor->size = (size64_t) hash_handle->block_size;
+				}
+			}
+			else
+			{
+				number_of_cursors--;
+
+				cursors[ 0 ] = cursors[ number_of_cursors ];
+			}
+			hash_cursor_heap_sift_down(
+			 cursors,
+			 number_of_cursors,
+			 0 );
+		}
+	}
+	if( hash_job != NULL )
+	{
+		result = hash_handle_submit_hash_job(
+		          hash_handle,
+		          hash_job,
+		          error );
+
+		hash_job = NULL;
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to submit hash job.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 cursors );
+
+	return( 1 );
+
+on_error:
+	if( hash_job != NULL )
+	{
+		hash_job_free(
+		 &hash_job,
+		 NULL );
+	}
+	if( cursors != NULL )
+	{
+		memory_free(
+		 cursors );
+	}
+	return( -1 );
+}
+
+/* Hashes the stores
+ * The input is read in order of source offset and every distinct block that is read
+ * is hashed once and written to the manifests of all the outputs that contain it
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_hash(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	libvshadow_store_t *store = NULL;
+	hash_extent_t *extent     = NULL;
+	uint8_t *block_data       = NULL;
+	static char *function     = "hash_handle_hash";
+	int extent_index          = 0;
+	int number_of_data_extents = 0;
+	int store_output_index    = -1;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_handle->read_size == 0 )
+	 || ( hash_handle->read_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash handle - read size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_handle->block_size == 0 )
+	 || ( hash_handle->block_size > hash_handle->read_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash handle - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle_plan(
+	     hash_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( hash_handle_open_outputs(
+	     hash_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open outputs.",
+		 function );
+
+		goto on_error;
+	}
+	if( hash_handle->number_of_extents == 0 )
+	{
+		return( 1 );
+	}
+	block_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * hash_handle->block_size );
+
+	if( block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     block_data,
+	     0,
+	     sizeof( uint8_t ) * hash_handle->block_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libhmac_sha256_calculate(
+	     block_data,
+	     hash_handle->block_size,
+	     hash_handle->sparse_block_hash,
+	     LIBHMAC_SHA256_HASH_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to calculate SHA-256 of sparse block.",
+		 function );
+
+		goto on_error;
+	}
+	/* The extents are sorted by type, the data extents come first
+	 */
+	while( number_of_data_extents < hash_handle->number_of_extents )
+	{
+		if( hash_handle->extents[ number_of_data_extents ].type != HASH_EXTENT_TYPE_DATA )
+		{
+			break;
+		}
+		number_of_data_extents++;
+	}
+	/* The sparse and mixed extents are hashed on the main thread, before the
+	 * hash jobs could compete for the manifests
+	 */
+	for( extent_index = number_of_data_extents;
+	     extent_index < hash_handle->number_of_extents;
+	     extent_index++ )
+	{
+		extent = &( hash_handle->extents[ extent_index ] );
+
+		if( extent->type != HASH_EXTENT_TYPE_SPARSE )
+		{
+			continue;
+		}
+		if( hash_handle_hash_sparse_extent(
+		     hash_handle,
+		     extent,
+		     block_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to hash sparse extent: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+	}
+	for( extent_index = number_of_data_extents;
+	     extent_index < hash_handle->number_of_extents;
+	     extent_index++ )
+	{
+		extent = &( hash_handle->extents[ extent_index ] );
+
+		if( extent->type != HASH_EXTENT_TYPE_MIXED )
+		{
+			continue;
+		}
+		if( extent->output_index != store_output_index )
+		{
+			if( store != NULL )
+			{
+				if( libvshadow_store_free(
+				     &store,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free store.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			store_output_index = extent->output_index;
+
+			if( libvshadow_volume_get_store(
+			     hash_handle->input_volume,
+			     hash_handle->output_store_indexes[ store_output_index ],
+			     &store,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve store: %d.",
+				 function,
+				 hash_handle->output_store_indexes[ store_output_index ] );
+
+				goto on_error;
+			}
+		}
+		if( hash_handle_hash_mixed_extent(
+		     hash_handle,
+		     extent,
+		     store,
+		     block_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to hash mixed extent: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+	}
+	if( store != NULL )
+	{
+		if( libvshadow_store_free(
+		     &store,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free store.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 block_data );
+
+	block_data = NULL;
+
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	if( hash_handle->number_of_threads > 0 )
+	{
+		if( libcthreads_thread_pool_create(
+		     &( hash_handle->hash_thread_pool ),
+		     NULL,
+		     hash_handle->number_of_threads,
+		     hash_handle->number_of_threads * 2,
+		     (int (*)(intptr_t *, void *)) &hash_handle_process_hash_job,
+		     (void *) hash_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create hash thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( hash_handle_hash_data_extents(
+	     hash_handle,
+	     0,
+	     number_of_data_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to hash data extents.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	if( hash_handle->hash_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( hash_handle->hash_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join hash thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( hash_handle->hash_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write manifests.",
+		 function );
+
+		goto on_error;
+	}
+	if( hash_handle->abort != 0 )
+	{
+		return( -1 );
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "Read: %" PRIu64 " bytes from input and hashed: %" PRIu64 " distinct block(s) for: %" PRIu64 " block(s) in %d manifest(s).\n",
+	 hash_handle->input_size,
+	 hash_handle->number_of_hashed_blocks,
+	 hash_handle->number_of_manifest_blocks,
+	 hash_handle->number_of_outputs );
+
+	return( 1 );
+
+on_error:
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	if( hash_handle->hash_thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &( hash_handle->hash_thread_pool ),
+		 NULL );
+	}
+#endif
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	if( block_data != NULL )
+	{
+		memory_free(
+		 block_data );
+	}
+	return( -1 );
+}
+
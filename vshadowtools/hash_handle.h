@@ -0,0 +1,480 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _HASH_HANDLE_H )
+#define _HASH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcfile.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libhmac.h"
+#include "vshadowtools_libvshadow.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default size of the blocks that are hashed
+ */
+#define HASH_HANDLE_DEFAULT_BLOCK_SIZE		16384
+
+/* The default (maximum) size of the data read from the input in one go
+ */
+#define HASH_HANDLE_DEFAULT_READ_SIZE		( 4 * 1024 * 1024 )
+
+/* The size of a manifest line, which consists of the offset of the block
+ * as 16 hexadecimal digits, a space, the SHA-256 as 64 hexadecimal digits
+ * and an end-of-line character
+ */
+#define HASH_HANDLE_MANIFEST_LINE_SIZE		( 16 + 1 + ( 2 * LIBHMAC_SHA256_HASH_SIZE ) + 1 )
+
+enum HASH_EXTENT_TYPES
+{
+	/* The blocks are stored contiguously in the volume
+	 */
+	HASH_EXTENT_TYPE_DATA			= 1,
+
+	/* The blocks consist of 0-byte values
+	 */
+	HASH_EXTENT_TYPE_SPARSE			= 2,
+
+	/* The blocks consist of data from multiple sources
+	 */
+	HASH_EXTENT_TYPE_MIXED			= 3
+};
+
+typedef struct hash_extent hash_extent_t;
+
+/* An extent of blocks of an output (store) and where their data is found in the volume
+ */
+struct hash_extent
+{
+	/* The source offset
+	 */
+	off64_t source_offset;
+
+	/* The target offset
+	 */
+	off64_t target_offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The output index
+	 */
+	int output_index;
+
+	/* The type
+	 */
+	int type;
+};
+
+typedef struct hash_cursor hash_cursor_t;
+
+/* The next block of a data extent
+ */
+struct hash_cursor
+{
+	/* The source offset of the block
+	 */
+	off64_t source_offset;
+
+	/* The size of the block
+	 */
+	size64_t size;
+
+	/* The offset of the block relative to the start of the extent
+	 */
+	off64_t relative_offset;
+
+	/* The extent index
+	 */
+	int extent_index;
+};
+
+typedef struct hash_job_reference hash_job_reference_t;
+
+/* A block of an output that contains the data of a hash job block
+ */
+struct hash_job_reference
+{
+	/* The target offset
+	 */
+	off64_t target_offset;
+
+	/* The output index
+	 */
+	int output_index;
+};
+
+typedef struct hash_job_block hash_job_block_t;
+
+/* A distinct block of data in a hash job buffer
+ */
+struct hash_job_block
+{
+	/* The offset relative to the start of the buffer
+	 */
+	size_t buffer_offset;
+
+	/* The size
+	 */
+	size_t size;
+
+	/* The index of the first reference
+	 */
+	int reference_index;
+
+	/* The number of references
+	 */
+	int number_of_references;
+};
+
+typedef struct hash_job hash_job_t;
+
+/* A buffer read from the input, the distinct blocks it contains and the outputs
+ * that contain these blocks
+ */
+struct hash_job
+{
+	/* The hash handle
+	 */
+	struct hash_handle *hash_handle;
+
+	/* The buffer
+	 */
+	uint8_t *buffer;
+
+	/* The source offset of the buffer
+	 */
+	off64_t source_offset;
+
+	/* The size of the buffer
+	 */
+	size_t buffer_size;
+
+	/* The blocks
+	 */
+	hash_job_block_t *blocks;
+
+	/* The number of blocks
+	 */
+	int number_of_blocks;
+
+	/* The number of allocated blocks
+	 */
+	int number_of_allocated_blocks;
+
+	/* The references
+	 */
+	hash_job_reference_t *references;
+
+	/* The number of references
+	 */
+	int number_of_references;
+
+	/* The number of allocated references
+	 */
+	int number_of_allocated_references;
+};
+
+typedef struct hash_handle hash_handle_t;
+
+struct hash_handle
+{
+	/* The volume offset
+	 */
+	off64_t volume_offset;
+
+	/* The target path prefix
+	 */
+	system_character_t *target_path;
+
+	/* The target path size
+	 */
+	size_t target_path_size;
+
+	/* The store index, -1 represents all stores
+	 */
+	int store_index;
+
+	/* The number of worker threads
+	 */
+	int number_of_threads;
+
+	/* The size of the blocks that are hashed
+	 */
+	size_t block_size;
+
+	/* The size of the data read from the input in one go
+	 */
+	size_t read_size;
+
+	/* The libbfio input file IO handle
+	 */
+	libbfio_handle_t *input_file_io_handle;
+
+	/* The libvshadow input volume
+	 */
+	libvshadow_volume_t *input_volume;
+
+	/* The volume size
+	 */
+	size64_t volume_size;
+
+	/* The extents sorted by type and source offset
+	 */
+	hash_extent_t *extents;
+
+	/* The number of extents
+	 */
+	int number_of_extents;
+
+	/* The number of allocated extents
+	 */
+	int number_of_allocated_extents;
+
+	/* The number of outputs
+	 */
+	int number_of_outputs;
+
+	/* The store index of each output
+	 */
+	int *output_store_indexes;
+
+	/* The output (manifest) files
+	 */
+	libcfile_file_t **output_files;
+
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	/* The output file mutexes
+	 */
+	libcthreads_mutex_t **output_mutexes;
+
+	/* The hash thread pool
+	 */
+	libcthreads_thread_pool_t *hash_thread_pool;
+#endif
+
+	/* The SHA-256 of a block of 0-byte values
+	 */
+	uint8_t sparse_block_hash[ LIBHMAC_SHA256_HASH_SIZE ];
+
+	/* The number of bytes read from the input
+	 */
+	size64_t input_size;
+
+	/* The number of distinct blocks that were hashed
+	 */
+	uint64_t number_of_hashed_blocks;
+
+	/* The number of blocks written to the manifests
+	 */
+	uint64_t number_of_manifest_blocks;
+
+	/* Value to indicate a hash job has failed
+	 */
+	int hash_failed;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int hash_handle_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_set_volume_offset(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_store_index(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_number_of_threads(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_block_size(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_target_path(
+     hash_handle_t *hash_handle,
+     const system_character_t *target_path,
+     libcerror_error_t **error );
+
+int hash_handle_open_input(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int hash_handle_close(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_extent_compare(
+     const hash_extent_t *first_extent,
+     const hash_extent_t *second_extent );
+
+int hash_handle_append_extent(
+     hash_handle_t *hash_handle,
+     int type,
+     off64_t source_offset,
+     off64_t target_offset,
+     size64_t size,
+     int output_index,
+     libcerror_error_t **error );
+
+int hash_handle_plan_range(
+     hash_handle_t *hash_handle,
+     int output_index,
+     int type,
+     off64_t source_offset,
+     off64_t target_offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int hash_handle_plan_store(
+     hash_handle_t *hash_handle,
+     int output_index,
+     libvshadow_store_t *store,
+     libcerror_error_t **error );
+
+int hash_handle_plan(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_open_outputs(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_close_outputs(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_write_manifest_line(
+     hash_handle_t *hash_handle,
+     int output_index,
+     off64_t target_offset,
+     const uint8_t *hash,
+     size_t hash_size,
+     libcerror_error_t **error );
+
+int hash_handle_hash_sparse_extent(
+     hash_handle_t *hash_handle,
+     hash_extent_t *extent,
+     const uint8_t *sparse_block_data,
+     libcerror_error_t **error );
+
+int hash_handle_hash_mixed_extent(
+     hash_handle_t *hash_handle,
+     hash_extent_t *extent,
+     libvshadow_store_t *store,
+     uint8_t *block_data,
+     libcerror_error_t **error );
+
+int hash_job_initialize(
+     hash_job_t **hash_job,
+     hash_handle_t *hash_handle,
+     off64_t source_offset,
+     libcerror_error_t **error );
+
+int hash_job_free(
+     hash_job_t **hash_job,
+     libcerror_error_t **error );
+
+int hash_job_append_block(
+     hash_job_t *hash_job,
+     off64_t source_offset,
+     size_t size,
+     libcerror_error_t **error );
+
+int hash_job_append_reference(
+     hash_job_t *hash_job,
+     off64_t target_offset,
+     int output_index,
+     libcerror_error_t **error );
+
+int hash_handle_process_hash_job(
+     hash_job_t *hash_job,
+     hash_handle_t *hash_handle );
+
+int hash_handle_submit_hash_job(
+     hash_handle_t *hash_handle,
+     hash_job_t *hash_job,
+     libcerror_error_t **error );
+
+int hash_cursor_compare(
+     const hash_cursor_t *first_cursor,
+     const hash_cursor_t *second_cursor );
+
+void hash_cursor_heap_sift_down(
+      hash_cursor_t *cursors,
+      int number_of_cursors,
+      int cursor_index );
+
+int hash_handle_hash_data_extents(
+     hash_handle_t *hash_handle,
+     int first_extent_index,
+     int number_of_extents,
+     libcerror_error_t **error );
+
+int hash_handle_hash(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _HASH_HANDLE_H ) */
+
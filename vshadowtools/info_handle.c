@@ -418,6 +418,113 @@ int info_handle_set_volume_offset(
 	return( 1 );
 }
 
+/* Sets the data source range
+ * The range is specified as offset[:size] in bytes
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_set_data_source_range(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	system_character_t *size_string = NULL;
+	static char *function           = "info_handle_set_data_source_range";
+	size_t offset_string_length     = 0;
+	size_t string_length            = 0;
+	uint64_t offset_value           = 0;
+	uint64_t size_value             = 0x4000;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	size_string = system_string_search_character(
+	               string,
+	               (system_character_t) ':',
+	               string_length );
+
+	if( size_string != NULL )
+	{
+		offset_string_length = (size_t) ( size_string - string );
+	}
+	else
+	{
+		offset_string_length = string_length;
+	}
+	if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     offset_string_length,
+	     &offset_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy offset string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( size_string != NULL )
+	{
+		size_string++;
+
+		if( vshadowtools_system_string_copy_from_64_bit_in_decimal(
+		     size_string,
+		     string_length - offset_string_length,
+		     &size_value,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy size string to 64-bit decimal.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( offset_value > (uint64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size_value == 0 )
+	 || ( size_value > (uint64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	info_handle->data_source_offset = (off64_t) offset_value;
+	info_handle->data_source_size   = (size64_t) size_value;
+
+	return( 1 );
+}
+
 /* Opens the info handle
  * Returns 1 if successful, 0 if no VSS enabled volume was found or -1 on error
  */
@@ -1271,3 +1378,335 @@ on_error:
 	return( -1 );
 }
 
+/* Prints a data source range to a stream
+ */
+void info_handle_data_source_range_fprint(
+      info_handle_t *info_handle,
+      off64_t range_offset,
+      size64_t range_size,
+      int source_type,
+      int source_store_index,
+      off64_t source_offset )
+{
+	if( info_handle == NULL )
+	{
+		return;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t0x%08" PRIx64 " - 0x%08" PRIx64 "\t: ",
+	 range_offset,
+	 range_offset + (off64_t) range_size );
+
+	switch( source_type )
+	{
+		case LIBVSHADOW_DATA_SOURCE_TYPE_VOLUME:
+			fprintf(
+			 info_handle->notify_stream,
+			 "volume at offset: 0x%08" PRIx64 "\n",
+			 source_offset );
+			break;
+
+		case LIBVSHADOW_DATA_SOURCE_TYPE_STORE:
+		case LIBVSHADOW_DATA_SOURCE_TYPE_NEXT_STORE:
+			fprintf(
+			 info_handle->notify_stream,
+			 "store: %d at offset: 0x%08" PRIx64 "\n",
+			 source_store_index + 1,
+			 source_offset );
+			break;
+
+		case LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE:
+			fprintf(
+			 info_handle->notify_stream,
+			 "sparse\n" );
+			break;
+
+		default:
+			fprintf(
+			 info_handle->notify_stream,
+			 "unknown\n" );
+			break;
+	}
+}
+
+/* Prints the data sources of a specific store to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_store_data_sources_fprint(
+     info_handle_t *info_handle,
+     int store_index,
+     libvshadow_store_t *store,
+     size64_t volume_size,
+     libcerror_error_t **error )
+{
+	static char *function        = "info_handle_store_data_sources_fprint";
+	size64_t range_size          = 0;
+	size64_t source_size         = 0;
+	off64_t end_offset           = 0;
+	off64_t offset               = 0;
+	off64_t range_offset         = 0;
+	off64_t range_source_offset  = 0;
+	off64_t source_offset        = 0;
+	int range_source_store_index = -1;
+	int range_source_type        = 0;
+	int source_store_index       = -1;
+	int source_type              = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "Store: %d\n",
+	 store_index + 1 );
+
+	offset     = info_handle->data_source_offset;
+	end_offset = offset + (off64_t) info_handle->data_source_size;
+
+	if( (size64_t) end_offset > volume_size )
+	{
+		end_offset = (off64_t) volume_size;
+	}
+	while( offset < end_offset )
+	{
+		if( info_handle->abort != 0 )
+		{
+			return( -1 );
+		}
+		if( libvshadow_store_get_data_source_at_offset(
+		     store,
+		     offset,
+		     &source_type,
+		     &source_store_index,
+		     &source_offset,
+		     &source_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %d data source at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 store_index,
+			 offset,
+			 offset );
+
+			return( -1 );
+		}
+		if( source_size > (size64_t) ( end_offset - offset ) )
+		{
+			source_size = (size64_t) ( end_offset - offset );
+		}
+		/* Merge adjacent ranges that are stored contiguously in the same source
+		 */
+		if( ( range_size != 0 )
+		 && ( ( source_type != range_source_type )
+		  ||  ( source_store_index != range_source_store_index )
+		  ||  ( ( source_type != LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE )
+		   &&   ( source_offset != ( range_source_offset + (off64_t) range_size ) ) ) ) )
+		{
+			info_handle_data_source_range_fprint(
+			 info_handle,
+			 range_offset,
+			 range_size,
+			 range_source_type,
+			 range_source_store_index,
+			 range_source_offset );
+
+			range_size = 0;
+		}
+		if( range_size == 0 )
+		{
+			range_offset             = offset;
+			range_source_type        = source_type;
+			range_source_store_index = source_store_index;
+			range_source_offset      = source_offset;
+		}
+		range_size += source_size;
+		offset     += (off64_t) source_size;
+	}
+	if( range_size != 0 )
+	{
+		info_handle_data_source_range_fprint(
+		 info_handle,
+		 range_offset,
+		 range_size,
+		 range_source_type,
+		 range_source_store_index,
+		 range_source_offset );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
+/* Prints the data sources of all stores for the data source range to a stream
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_data_sources_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	libvshadow_store_t *store = NULL;
+	static char *function     = "info_handle_data_sources_fprint";
+	size64_t volume_size      = 0;
+	int number_of_stores      = 0;
+	int result                = 0;
+	int store_index           = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_volume_get_size(
+	     info_handle->input_volume,
+	     &volume_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume size.",
+		 function );
+
+		goto on_error;
+	}
+	if( (size64_t) info_handle->data_source_offset >= volume_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data source offset value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_get_number_of_stores(
+	     info_handle->input_volume,
+	     &number_of_stores,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of stores.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "Volume Shadow Snapshot data sources:\n" );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tRange\t\t\t: 0x%08" PRIx64 " - 0x%08" PRIx64 "\n",
+	 info_handle->data_source_offset,
+	 info_handle->data_source_offset + info_handle->data_source_size );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tNumber of stores\t: %d\n",
+	 number_of_stores );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	for( store_index = 0;
+	     store_index < number_of_stores;
+	     store_index++ )
+	{
+		if( libvshadow_volume_get_store(
+		     info_handle->input_volume,
+		     store_index,
+		     &store,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		result = libvshadow_store_has_in_volume_data(
+		          store,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if store: %d has in-volume data.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			if( info_handle_store_data_sources_fprint(
+			     info_handle,
+			     store_index,
+			     store,
+			     volume_size,
+			     error ) != 1 )
+			{
+				goto on_error;
+			}
+		}
+		if( libvshadow_store_free(
+		     &store,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free store: %d.",
+			 function,
+			 store_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( store != NULL )
+	{
+		libvshadow_store_free(
+		 &store,
+		 NULL );
+	}
+	return( -1 );
+}
+
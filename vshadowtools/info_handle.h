@@ -54,6 +54,14 @@ struct info_handle
 	 */
 	uint8_t show_allocation_information;
 
+	/* The data source range offset
+	 */
+	off64_t data_source_offset;
+
+	/* The data source range size
+	 */
+	size64_t data_source_size;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -86,6 +94,11 @@ int info_handle_set_volume_offset(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int info_handle_set_data_source_range(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int info_handle_open_input(
      info_handle_t *info_handle,
      const system_character_t *filename,
@@ -111,6 +124,25 @@ int info_handle_volume_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+void info_handle_data_source_range_fprint(
+      info_handle_t *info_handle,
+      off64_t range_offset,
+      size64_t range_size,
+      int source_type,
+      int source_store_index,
+      off64_t source_offset );
+
+int info_handle_store_data_sources_fprint(
+     info_handle_t *info_handle,
+     int store_index,
+     libvshadow_store_t *store,
+     size64_t volume_size,
+     libcerror_error_t **error );
+
+int info_handle_data_sources_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
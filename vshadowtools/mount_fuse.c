@@ -1301,6 +1301,72 @@ on_error:
 	return( result );
 }
 
+/* Initializes the connection with the kernel
+ * Returns the private data of the fuse context
+ */
+#if defined( HAVE_LIBFUSE3 )
+void *mount_fuse_init(
+       struct fuse_conn_info *connection,
+       struct fuse_config *configuration VSHADOWTOOLS_ATTRIBUTE_UNUSED )
+#else
+void *mount_fuse_init(
+       struct fuse_conn_info *connection )
+#endif
+{
+	struct fuse_context *fuse_context = NULL;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	static char *function             = "mount_fuse_init";
+#endif
+
+#if defined( HAVE_LIBFUSE3 )
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( configuration )
+#endif
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s\n",
+		 function );
+	}
+#endif
+	if( ( connection != NULL )
+	 && ( vshadowmount_mount_handle != NULL )
+	 && ( vshadowmount_mount_handle->immutable_data != 0 ) )
+	{
+		/* Since the data cannot change the kernel can have multiple reads in flight
+		 * Note that max_readahead is left as proposed by the kernel, a larger value
+		 * has no effect since the kernel read-ahead is bounded by the read_ahead_kb
+		 * setting of the backing device info (bdi) of the mount point
+		 */
+#if defined( HAVE_LIBFUSE3 )
+		if( ( connection->capable & FUSE_CAP_ASYNC_READ ) != 0 )
+		{
+			connection->want |= FUSE_CAP_ASYNC_READ;
+		}
+#else
+		connection->async_read = 1;
+#endif
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: maximum read-ahead\t\t: %" PRIu32 "\n",
+			 function,
+			 (uint32_t) connection->max_readahead );
+		}
+#endif
+	}
+	fuse_context = fuse_get_context();
+
+	if( fuse_context == NULL )
+	{
+		return( NULL );
+	}
+	return( fuse_context->private_data );
+}
+
 /* Cleans up when fuse is done
  */
 void mount_fuse_destroy(
@@ -58,6 +58,23 @@ extern "C" {
 
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
 
+/* The maximum size of a read with immutable data
+ */
+#define MOUNT_FUSE_IMMUTABLE_MAXIMUM_READ_SIZE	1048576
+
+/* The fuse options with immutable data
+ * The data and attributes never change while mounted, hence the kernel
+ * can keep the page cache across opens and cache entries and attributes
+ * for a day
+ */
+#if defined( HAVE_LIBOSXFUSE )
+#define MOUNT_FUSE_IMMUTABLE_OPTIONS \
+	"ro,kernel_cache,entry_timeout=86400,attr_timeout=86400,negative_timeout=86400"
+#else
+#define MOUNT_FUSE_IMMUTABLE_OPTIONS \
+	"ro,kernel_cache,entry_timeout=86400,attr_timeout=86400,negative_timeout=86400,max_read=1048576"
+#endif
+
 int mount_fuse_set_stat_info(
      struct stat *stat_info,
      size64_t size,
@@ -126,6 +143,15 @@ int mount_fuse_getattr(
      struct stat *stat_info );
 #endif
 
+#if defined( HAVE_LIBFUSE3 )
+void *mount_fuse_init(
+       struct fuse_conn_info *connection,
+       struct fuse_config *configuration );
+#else
+void *mount_fuse_init(
+       struct fuse_conn_info *connection );
+#endif
+
 void mount_fuse_destroy(
       void *private_data );
 
@@ -52,6 +52,10 @@ struct mount_handle
 	 */
 	libbfio_handle_t *file_io_handle;
 
+	/* Value to indicate the sub system can treat the data as immutable
+	 */
+	int immutable_data;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -0,0 +1,2329 @@
+/*
+ * Network Block Device (NBD) connection
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#include "nbd_connection.h"
+#include "nbd_handle.h"
+#include "nbd_protocol.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libvshadow.h"
+
+#if defined( HAVE_NBD_SUPPORT )
+
+#include <errno.h>
+#include <sys/socket.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( MSG_NOSIGNAL )
+#define NBD_CONNECTION_SEND_FLAGS	MSG_NOSIGNAL
+#else
+#define NBD_CONNECTION_SEND_FLAGS	0
+#endif
+
+/* The name of the base:allocation metadata context
+ */
+#define NBD_CONNECTION_BASE_ALLOCATION_CONTEXT_NAME		"base:allocation"
+#define NBD_CONNECTION_BASE_ALLOCATION_CONTEXT_NAME_LENGTH	15
+
+/* Creates a NBD connection
+ * Make sure the value nbd_connection is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_initialize(
+     nbd_connection_t **nbd_connection,
+     struct nbd_handle *nbd_handle,
+     int socket,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_initialize";
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_connection != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD connection value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid socket value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*nbd_connection = memory_allocate_structure(
+	                   nbd_connection_t );
+
+	if( *nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create NBD connection.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *nbd_connection,
+	     0,
+	     sizeof( nbd_connection_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear NBD connection.",
+		 function );
+
+		goto on_error;
+	}
+	( *nbd_connection )->nbd_handle  = nbd_handle;
+	( *nbd_connection )->socket      = socket;
+	( *nbd_connection )->store_index = -1;
+
+	return( 1 );
+
+on_error:
+	if( *nbd_connection != NULL )
+	{
+		memory_free(
+		 *nbd_connection );
+
+		*nbd_connection = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a NBD connection
+ * The socket of the connection is closed
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_free(
+     nbd_connection_t **nbd_connection,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_free";
+	int result            = 1;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_connection != NULL )
+	{
+		if( ( *nbd_connection )->store != NULL )
+		{
+			if( libvshadow_store_free(
+			     &( ( *nbd_connection )->store ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free store.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *nbd_connection )->socket >= 0 )
+		{
+			if( close(
+			     ( *nbd_connection )->socket ) != 0 )
+			{
+				libcerror_system_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 errno,
+				 "%s: unable to close socket.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *nbd_connection )->buffer != NULL )
+		{
+			memory_free(
+			 ( *nbd_connection )->buffer );
+		}
+		memory_free(
+		 *nbd_connection );
+
+		*nbd_connection = NULL;
+	}
+	return( result );
+}
+
+/* Signals the NBD connection to abort
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_signal_abort(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_signal_abort";
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	/* Shutting down the socket causes a blocking receive to return
+	 */
+	if( nbd_connection->socket >= 0 )
+	{
+		shutdown(
+		 nbd_connection->socket,
+		 SHUT_RDWR );
+	}
+	return( 1 );
+}
+
+/* Reads data from the connection
+ * Returns 1 if successful, 0 if the connection was closed by the client or -1 on error
+ */
+int nbd_connection_read_data(
+     nbd_connection_t *nbd_connection,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_read_data";
+	size_t data_offset    = 0;
+	ssize_t read_count    = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		read_count = recv(
+		              nbd_connection->socket,
+		              &( data[ data_offset ] ),
+		              data_size - data_offset,
+		              0 );
+
+		if( read_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to receive data.",
+			 function );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			if( data_offset == 0 )
+			{
+				return( 0 );
+			}
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: connection closed while receiving data.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += (size_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Writes data to the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_data(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_write_data";
+	size_t data_offset    = 0;
+	ssize_t write_count   = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		write_count = send(
+		               nbd_connection->socket,
+		               &( data[ data_offset ] ),
+		               data_size - data_offset,
+		               NBD_CONNECTION_SEND_FLAGS );
+
+		if( write_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to send data.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += (size_t) write_count;
+	}
+	return( 1 );
+}
+
+/* Resizes the data buffer of the connection if needed
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_resize_buffer(
+     nbd_connection_t *nbd_connection,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "nbd_connection_resize_buffer";
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size <= nbd_connection->buffer_size )
+	{
+		return( 1 );
+	}
+	buffer = (uint8_t *) memory_reallocate(
+	                      nbd_connection->buffer,
+	                      sizeof( uint8_t ) * buffer_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to resize buffer.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_connection->buffer      = buffer;
+	nbd_connection->buffer_size = buffer_size;
+
+	return( 1 );
+}
+
+/* Writes an option reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_option_reply(
+     nbd_connection_t *nbd_connection,
+     uint32_t option_type,
+     uint32_t reply_type,
+     const uint8_t *data,
+     uint32_t data_size,
+     libcerror_error_t **error )
+{
+	nbd_option_reply_header_t reply_header;
+
+	static char *function = "nbd_connection_write_option_reply";
+
+	if( ( data == NULL )
+	 && ( data_size != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 reply_header.magic,
+	 NBD_OPTION_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 reply_header.option_type,
+	 option_type );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 reply_header.reply_type,
+	 reply_type );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 reply_header.data_size,
+	 data_size );
+
+	if( nbd_connection_write_data(
+	     nbd_connection,
+	     (uint8_t *) &reply_header,
+	     sizeof( nbd_option_reply_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write option reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_connection_write_data(
+		     nbd_connection,
+		     data,
+		     (size_t) data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write option reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Selects the export by name
+ * Returns 1 if successful, 0 if no such export or -1 on error
+ */
+int nbd_connection_select_export(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *export_name,
+     uint32_t export_name_size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_connection_select_export";
+	int result            = 0;
+	int store_index       = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	result = nbd_handle_get_store_index_by_export_name(
+	          nbd_connection->nbd_handle,
+	          export_name,
+	          (size_t) export_name_size,
+	          &store_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store index by export name.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( store_index == nbd_connection->store_index )
+	{
+		return( 1 );
+	}
+	if( nbd_connection->store != NULL )
+	{
+		if( libvshadow_store_free(
+		     &( nbd_connection->store ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free store.",
+			 function );
+
+			return( -1 );
+		}
+		nbd_connection->store_index = -1;
+	}
+	/* Every connection uses its own store so that the reads of different
+	 * connections do not contend for the same store lock
+	 */
+	if( libvshadow_volume_get_store(
+	     nbd_connection->nbd_handle->input_volume,
+	     store_index,
+	     &( nbd_connection->store ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve store: %d.",
+		 function,
+		 store_index );
+
+		return( -1 );
+	}
+	if( libvshadow_store_get_volume_size(
+	     nbd_connection->store,
+	     &( nbd_connection->export_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume size of store: %d.",
+		 function,
+		 store_index );
+
+		libvshadow_store_free(
+		 &( nbd_connection->store ),
+		 NULL );
+
+		return( -1 );
+	}
+	nbd_connection->store_index = store_index;
+
+	return( 1 );
+}
+
+/* Determines the transmission flags
+ */
+uint16_t nbd_connection_get_transmission_flags(
+          nbd_connection_t *nbd_connection )
+{
+	uint16_t transmission_flags = 0;
+
+	/* Multiple connections to the same export are safe since the export is
+	 * read-only, hence every connection sees the same data and a flush has
+	 * nothing to write back. The store descriptors the connections share are
+	 * protected by their own read/write lock in the library
+	 */
+	transmission_flags = NBD_FLAG_HAS_FLAGS
+	                   | NBD_FLAG_READ_ONLY
+	                   | NBD_FLAG_SEND_FLUSH
+	                   | NBD_FLAG_CAN_MULTI_CONN
+	                   | NBD_FLAG_SEND_CACHE;
+
+	/* Reads are always answered with a single chunk
+	 */
+	if( ( nbd_connection != NULL )
+	 && ( nbd_connection->structured_replies != 0 ) )
+	{
+		transmission_flags |= NBD_FLAG_SEND_DF;
+	}
+	return( transmission_flags );
+}
+
+/* Handles the list option
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_handle_option_list(
+     nbd_connection_t *nbd_connection,
+     uint32_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t export_data[ 4 + 16 ];
+
+	static char *function  = "nbd_connection_handle_option_list";
+	int export_name_length = 0;
+	int store_index        = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size != 0 )
+	{
+		return( nbd_connection_write_option_reply(
+		         nbd_connection,
+		         NBD_OPT_LIST,
+		         NBD_REP_ERR_INVALID,
+		         NULL,
+		         0,
+		         error ) );
+	}
+	for( store_index = 0;
+	     store_index < nbd_connection->nbd_handle->number_of_stores;
+	     store_index++ )
+	{
+		export_name_length = narrow_string_snprintf(
+		                      (char *) &( export_data[ 4 ] ),
+		                      16,
+		                      "vss%d",
+		                      store_index + 1 );
+
+		if( ( export_name_length < 0 )
+		 || ( export_name_length >= 16 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set export name.",
+			 function );
+
+			return( -1 );
+		}
+		byte_stream_copy_from_uint32_big_endian(
+		 export_data,
+		 (uint32_t) export_name_length );
+
+		if( nbd_connection_write_option_reply(
+		     nbd_connection,
+		     NBD_OPT_LIST,
+		     NBD_REP_SERVER,
+		     export_data,
+		     (uint32_t) ( 4 + export_name_length ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write server reply.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( nbd_connection_write_option_reply(
+	         nbd_connection,
+	         NBD_OPT_LIST,
+	         NBD_REP_ACK,
+	         NULL,
+	         0,
+	         error ) );
+}
+
+/* Handles the info and go options
+ * Returns 1 if an export was selected, 0 if not or -1 on error
+ */
+int nbd_connection_handle_option_info(
+     nbd_connection_t *nbd_connection,
+     uint32_t option_type,
+     const uint8_t *data,
+     uint32_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t information_data[ 14 ];
+
+	static char *function            = "nbd_connection_handle_option_info";
+	uint32_t export_name_size        = 0;
+	uint32_t information_data_offset = 0;
+	uint16_t information_type        = 0;
+	uint16_t number_of_requests      = 0;
+	uint16_t request_index           = 0;
+	uint8_t send_block_size          = 0;
+	int result                       = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < 6 )
+	{
+		result = 0;
+	}
+	else
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 data,
+		 export_name_size );
+
+		if( export_name_size <= ( data_size - 6 ) )
+		{
+			byte_stream_copy_to_uint16_big_endian(
+			 &( data[ 4 + export_name_size ] ),
+			 number_of_requests );
+
+			result = ( ( 6 + export_name_size + ( 2 * (uint32_t) number_of_requests ) ) == data_size );
+		}
+	}
+	if( result == 0 )
+	{
+		if( nbd_connection_write_option_reply(
+		     nbd_connection,
+		     option_type,
+		     NBD_REP_ERR_INVALID,
+		     NULL,
+		     0,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		return( 0 );
+	}
+	for( request_index = 0;
+	     request_index < number_of_requests;
+	     request_index++ )
+	{
+		byte_stream_copy_to_uint16_big_endian(
+		 &( data[ 6 + export_name_size + ( 2 * request_index ) ] ),
+		 information_type );
+
+		if( information_type == NBD_INFO_BLOCK_SIZE )
+		{
+			send_block_size = 1;
+		}
+	}
+	result = nbd_connection_select_export(
+	          nbd_connection,
+	          &( data[ 4 ] ),
+	          export_name_size,
+	          error );
+
+	if( result == -1 )
+	{
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		if( nbd_connection_write_option_reply(
+		     nbd_connection,
+		     option_type,
+		     NBD_REP_ERR_UNKNOWN,
+		     NULL,
+		     0,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+		return( 0 );
+	}
+	byte_stream_copy_from_uint16_big_endian(
+	 information_data,
+	 NBD_INFO_EXPORT );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( information_data[ 2 ] ),
+	 nbd_connection->export_size );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( information_data[ 10 ] ),
+	 nbd_connection_get_transmission_flags(
+	  nbd_connection ) );
+
+	if( nbd_connection_write_option_reply(
+	     nbd_connection,
+	     option_type,
+	     NBD_REP_INFO,
+	     information_data,
+	     12,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( send_block_size != 0 )
+	{
+		/* The preferred block size is the size of a VSS block
+		 */
+		information_data_offset = 0;
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( information_data[ information_data_offset ] ),
+		 NBD_INFO_BLOCK_SIZE );
+
+		information_data_offset += 2;
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( information_data[ information_data_offset ] ),
+		 1 );
+
+		information_data_offset += 4;
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( information_data[ information_data_offset ] ),
+		 0x00004000UL );
+
+		information_data_offset += 4;
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( information_data[ information_data_offset ] ),
+		 NBD_MAXIMUM_REQUEST_DATA_SIZE );
+
+		information_data_offset += 4;
+
+		if( nbd_connection_write_option_reply(
+		     nbd_connection,
+		     option_type,
+		     NBD_REP_INFO,
+		     information_data,
+		     information_data_offset,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	if( nbd_connection_write_option_reply(
+	     nbd_connection,
+	     option_type,
+	     NBD_REP_ACK,
+	     NULL,
+	     0,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Handles the list and set metadata context options
+ * Only the base:allocation metadata context is supported
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_handle_option_meta_context(
+     nbd_connection_t *nbd_connection,
+     uint32_t option_type,
+     const uint8_t *data,
+     uint32_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t context_data[ 4 + NBD_CONNECTION_BASE_ALLOCATION_CONTEXT_NAME_LENGTH ];
+
+	static char *function      = "nbd_connection_handle_option_meta_context";
+	uint32_t data_offset       = 0;
+	uint32_t export_name_size  = 0;
+	uint32_t number_of_queries = 0;
+	uint32_t query_index       = 0;
+	uint32_t query_size        = 0;
+	uint32_t reply_type        = NBD_REP_ACK;
+	uint8_t base_allocation    = 0;
+	int result                 = 0;
+	int store_index            = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	/* Validate the option data before sending any metadata context reply
+	 */
+	if( data_size < 8 )
+	{
+		reply_type = NBD_REP_ERR_INVALID;
+	}
+	else
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 data,
+		 export_name_size );
+
+		if( export_name_size > ( data_size - 8 ) )
+		{
+			reply_type = NBD_REP_ERR_INVALID;
+		}
+		else
+		{
+			data_offset = 4 + export_name_size;
+
+			byte_stream_copy_to_uint32_big_endian(
+			 &( data[ data_offset ] ),
+			 number_of_queries );
+
+			data_offset += 4;
+
+			for( query_index = 0;
+			     query_index < number_of_queries;
+			     query_index++ )
+			{
+				if( ( data_size - data_offset ) < 4 )
+				{
+					reply_type = NBD_REP_ERR_INVALID;
+
+					break;
+				}
+				byte_stream_copy_to_uint32_big_endian(
+				 &( data[ data_offset ] ),
+				 query_size );
+
+				data_offset += 4;
+
+				if( query_size > ( data_size - data_offset ) )
+				{
+					reply_type = NBD_REP_ERR_INVALID;
+
+					break;
+				}
+				data_offset += query_size;
+			}
+			if( data_offset != data_size )
+			{
+				reply_type = NBD_REP_ERR_INVALID;
+			}
+		}
+	}
+	if( ( reply_type == NBD_REP_ACK )
+	 && ( option_type == NBD_OPT_SET_META_CONTEXT )
+	 && ( nbd_connection->structured_replies == 0 ) )
+	{
+		reply_type = NBD_REP_ERR_INVALID;
+	}
+	if( reply_type == NBD_REP_ACK )
+	{
+		result = nbd_handle_get_store_index_by_export_name(
+		          nbd_connection->nbd_handle,
+		          &( data[ 4 ] ),
+		          (size_t) export_name_size,
+		          &store_index,
+		          error );
+
+		if( result == -1 )
+		{
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			reply_type = NBD_REP_ERR_UNKNOWN;
+		}
+	}
+	if( reply_type != NBD_REP_ACK )
+	{
+		return( nbd_connection_write_option_reply(
+		         nbd_connection,
+		         option_type,
+		         reply_type,
+		         NULL,
+		         0,
+		         error ) );
+	}
+	data_offset = 8 + export_name_size;
+
+	/* Listing without queries returns all the supported metadata contexts
+	 */
+	if( ( number_of_queries == 0 )
+	 && ( option_type == NBD_OPT_LIST_META_CONTEXT ) )
+	{
+		base_allocation = 1;
+	}
+	for( query_index = 0;
+	     query_index < number_of_queries;
+	     query_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( data[ data_offset ] ),
+		 query_size );
+
+		data_offset += 4;
+
+		if( ( query_size == NBD_CONNECTION_BASE_ALLOCATION_CONTEXT_NAME_LENGTH )
+		 && ( memory_compare(
+		       &( data[ data_offset ] ),
+		       NBD_CONNECTION_BASE_ALLOCATION_CONTEXT_NAME,
+		       NBD_CONNECTION_BASE_ALLOCATION_CONTEXT_NAME_LENGTH ) == 0 ) )
+		{
+			base_allocation = 1;
+		}
+		else if( ( option_type == NBD_OPT_LIST_META_CONTEXT )
+		      && ( query_size == 5 )
+		      && ( memory_compare(
+		            &( data[ data_offset ] ),
+		            "base:",
+		            5 ) == 0 ) )
+		{
+			base_allocation = 1;
+		}
+		data_offset += query_size;
+	}
+	if( option_type == NBD_OPT_SET_META_CONTEXT )
+	{
+		nbd_connection->base_allocation_context = base_allocation;
+	}
+	if( base_allocation != 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 context_data,
+		 NBD_CONNECTION_BASE_ALLOCATION_CONTEXT_IDENTIFIER );
+
+		if( memory_copy(
+		     &( context_data[ 4 ] ),
+		     NBD_CONNECTION_BASE_ALLOCATION_CONTEXT_NAME,
+		     NBD_CONNECTION_BASE_ALLOCATION_CONTEXT_NAME_LENGTH ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy metadata context name.",
+			 function );
+
+			return( -1 );
+		}
+		if( nbd_connection_write_option_reply(
+		     nbd_connection,
+		     option_type,
+		     NBD_REP_META_CONTEXT,
+		     context_data,
+		     4 + NBD_CONNECTION_BASE_ALLOCATION_CONTEXT_NAME_LENGTH,
+		     error ) != 1 )
+		{
+			return( -1 );
+		}
+	}
+	return( nbd_connection_write_option_reply(
+	         nbd_connection,
+	         option_type,
+	         NBD_REP_ACK,
+	         NULL,
+	         0,
+	         error ) );
+}
+
+/* Negotiates the export with the client using the fixed newstyle handshake
+ * Returns 1 if an export was selected, 0 if the client ended the negotiation or -1 on error
+ */
+int nbd_connection_negotiate(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error )
+{
+	nbd_option_header_t option_header;
+
+	uint8_t option_data[ NBD_MAXIMUM_OPTION_DATA_SIZE ];
+	uint8_t handshake_data[ 18 ];
+	uint8_t export_data[ 10 + 124 ];
+
+	static char *function   = "nbd_connection_negotiate";
+	size_t export_data_size = 0;
+	size_t read_size        = 0;
+	uint64_t magic          = 0;
+	uint32_t client_flags   = 0;
+	uint32_t data_size      = 0;
+	uint32_t option_type    = 0;
+	int result              = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 handshake_data,
+	 NBD_INITIAL_MAGIC );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 8 ] ),
+	 NBD_OPTION_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( handshake_data[ 16 ] ),
+	 NBD_FLAG_FIXED_NEWSTYLE | NBD_FLAG_NO_ZEROES );
+
+	if( nbd_connection_write_data(
+	     nbd_connection,
+	     handshake_data,
+	     18,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write handshake.",
+		 function );
+
+		return( -1 );
+	}
+	result = nbd_connection_read_data(
+	          nbd_connection,
+	          handshake_data,
+	          4,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 handshake_data,
+	 client_flags );
+
+	if( ( client_flags & NBD_FLAG_C_FIXED_NEWSTYLE ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported client flags: 0x%08" PRIx32 ", fixed newstyle negotiation is required.",
+		 function,
+		 client_flags );
+
+		return( -1 );
+	}
+	if( ( client_flags & NBD_FLAG_C_NO_ZEROES ) != 0 )
+	{
+		nbd_connection->no_zeroes = 1;
+	}
+	while( nbd_connection->nbd_handle->abort == 0 )
+	{
+		result = nbd_connection_read_data(
+		          nbd_connection,
+		          (uint8_t *) &option_header,
+		          sizeof( nbd_option_header_t ),
+		          error );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+		byte_stream_copy_to_uint64_big_endian(
+		 option_header.magic,
+		 magic );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 option_header.option_type,
+		 option_type );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 option_header.data_size,
+		 data_size );
+
+		if( magic != NBD_OPTION_MAGIC )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported option magic: 0x%08" PRIx64 ".",
+			 function,
+			 magic );
+
+			return( -1 );
+		}
+		if( data_size > NBD_MAXIMUM_OPTION_DATA_SIZE )
+		{
+			if( option_type == NBD_OPT_EXPORT_NAME )
+			{
+				return( 0 );
+			}
+			/* Discard the option data
+			 */
+			while( data_size > 0 )
+			{
+				read_size = NBD_MAXIMUM_OPTION_DATA_SIZE;
+
+				if( (uint32_t) read_size > data_size )
+				{
+					read_size = (size_t) data_size;
+				}
+				result = nbd_connection_read_data(
+				          nbd_connection,
+				          option_data,
+				          read_size,
+				          error );
+
+				if( result != 1 )
+				{
+					return( -1 );
+				}
+				data_size -= (uint32_t) read_size;
+			}
+			if( nbd_connection_write_option_reply(
+			     nbd_connection,
+			     option_type,
+			     NBD_REP_ERR_INVALID,
+			     NULL,
+			     0,
+			     error ) != 1 )
+			{
+				return( -1 );
+			}
+			continue;
+		}
+		if( data_size > 0 )
+		{
+			result = nbd_connection_read_data(
+			          nbd_connection,
+			          option_data,
+			          (size_t) data_size,
+			          error );
+
+			if( result != 1 )
+			{
+				return( -1 );
+			}
+		}
+		switch( option_type )
+		{
+			case NBD_OPT_EXPORT_NAME:
+				/* The export name option cannot be answered with an error
+				 * hence the connection is closed if the export does not exist
+				 */
+				result = nbd_connection_select_export(
+				          nbd_connection,
+				          option_data,
+				          data_size,
+				          error );
+
+				if( result != 1 )
+				{
+					return( result );
+				}
+				byte_stream_copy_from_uint64_big_endian(
+				 export_data,
+				 nbd_connection->export_size );
+
+				byte_stream_copy_from_uint16_big_endian(
+				 &( export_data[ 8 ] ),
+				 nbd_connection_get_transmission_flags(
+				  nbd_connection ) );
+
+				export_data_size = 10;
+
+				if( nbd_connection->no_zeroes == 0 )
+				{
+					if( memory_set(
+					     &( export_data[ 10 ] ),
+					     0,
+					     124 ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+						 "%s: unable to clear export data.",
+						 function );
+
+						return( -1 );
+					}
+					export_data_size += 124;
+				}
+				if( nbd_connection_write_data(
+				     nbd_connection,
+				     export_data,
+				     export_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write export data.",
+					 function );
+
+					return( -1 );
+				}
+				return( 1 );
+
+			case NBD_OPT_ABORT:
+				if( nbd_connection_write_option_reply(
+				     nbd_connection,
+				     option_type,
+				     NBD_REP_ACK,
+				     NULL,
+				     0,
+				     error ) != 1 )
+				{
+					/* The client is allowed to close the connection without waiting for the reply
+					 */
+					libcerror_error_free(
+					 error );
+				}
+				return( 0 );
+
+			case NBD_OPT_LIST:
+				result = nbd_connection_handle_option_list(
+				          nbd_connection,
+				          data_size,
+				          error );
+				break;
+
+			case NBD_OPT_INFO:
+			case NBD_OPT_GO:
+				result = nbd_connection_handle_option_info(
+				          nbd_connection,
+				          option_type,
+				          option_data,
+				          data_size,
+				          error );
+
+				if( ( result == 1 )
+				 && ( option_type == NBD_OPT_GO ) )
+				{
+					return( 1 );
+				}
+				else if( result != -1 )
+				{
+					result = 1;
+				}
+				break;
+
+			case NBD_OPT_STRUCTURED_REPLY:
+				if( data_size != 0 )
+				{
+					result = nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option_type,
+					          NBD_REP_ERR_INVALID,
+					          NULL,
+					          0,
+					          error );
+				}
+				else
+				{
+					nbd_connection->structured_replies = 1;
+
+					result = nbd_connection_write_option_reply(
+					          nbd_connection,
+					          option_type,
+					          NBD_REP_ACK,
+					          NULL,
+					          0,
+					          error );
+				}
+				break;
+
+			case NBD_OPT_LIST_META_CONTEXT:
+			case NBD_OPT_SET_META_CONTEXT:
+				result = nbd_connection_handle_option_meta_context(
+				          nbd_connection,
+				          option_type,
+				          option_data,
+				          data_size,
+				          error );
+				break;
+
+			default:
+				result = nbd_connection_write_option_reply(
+				          nbd_connection,
+				          option_type,
+				          NBD_REP_ERR_UNSUP,
+				          NULL,
+				          0,
+				          error );
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to handle option: %" PRIu32 ".",
+			 function,
+			 option_type );
+
+			return( -1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Writes a simple reply
+ * The data is taken from the start of the data buffer of the connection
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_simple_reply(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *cookie,
+     uint32_t error_value,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	nbd_simple_reply_t simple_reply;
+
+	static char *function = "nbd_connection_write_simple_reply";
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( cookie == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cookie.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > nbd_connection->buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 simple_reply.magic,
+	 NBD_SIMPLE_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 simple_reply.error,
+	 error_value );
+
+	if( memory_copy(
+	     simple_reply.cookie,
+	     cookie,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy cookie.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_connection_write_data(
+	     nbd_connection,
+	     (uint8_t *) &simple_reply,
+	     sizeof( nbd_simple_reply_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write simple reply.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_connection_write_data(
+		     nbd_connection,
+		     nbd_connection->buffer,
+		     data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write simple reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes a structured reply header
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_structured_reply_header(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *cookie,
+     uint16_t reply_flags,
+     uint16_t reply_type,
+     uint32_t data_size,
+     libcerror_error_t **error )
+{
+	nbd_structured_reply_header_t reply_header;
+
+	static char *function = "nbd_connection_write_structured_reply_header";
+
+	if( cookie == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cookie.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 reply_header.magic,
+	 NBD_STRUCTURED_REPLY_MAGIC );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 reply_header.reply_flags,
+	 reply_flags );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 reply_header.reply_type,
+	 reply_type );
+
+	if( memory_copy(
+	     reply_header.cookie,
+	     cookie,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy cookie.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 reply_header.data_size,
+	 data_size );
+
+	if( nbd_connection_write_data(
+	     nbd_connection,
+	     (uint8_t *) &reply_header,
+	     sizeof( nbd_structured_reply_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write structured reply header.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes an error reply
+ * A structured error chunk is used when structured replies were negotiated
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_write_error_reply(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *cookie,
+     uint32_t error_value,
+     libcerror_error_t **error )
+{
+	uint8_t error_data[ 6 ];
+
+	static char *function = "nbd_connection_write_error_reply";
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_connection->structured_replies == 0 )
+	{
+		return( nbd_connection_write_simple_reply(
+		         nbd_connection,
+		         cookie,
+		         error_value,
+		         0,
+		         error ) );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 error_data,
+	 error_value );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( error_data[ 4 ] ),
+	 0 );
+
+	if( nbd_connection_write_structured_reply_header(
+	     nbd_connection,
+	     cookie,
+	     NBD_REPLY_FLAG_DONE,
+	     NBD_REPLY_TYPE_ERROR,
+	     6,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( nbd_connection_write_data(
+	     nbd_connection,
+	     error_data,
+	     6,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write error data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Handles a read command
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_handle_read(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *cookie,
+     uint64_t offset,
+     uint32_t size,
+     libcerror_error_t **error )
+{
+	uint8_t offset_data[ 8 ];
+
+	libcerror_error_t *read_error = NULL;
+	static char *function         = "nbd_connection_handle_read";
+	ssize_t read_count            = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > NBD_MAXIMUM_REQUEST_DATA_SIZE )
+	 || ( offset >= nbd_connection->export_size )
+	 || ( (uint64_t) size > ( nbd_connection->export_size - offset ) ) )
+	{
+		return( nbd_connection_write_error_reply(
+		         nbd_connection,
+		         cookie,
+		         NBD_EINVAL,
+		         error ) );
+	}
+	if( nbd_connection_resize_buffer(
+	     nbd_connection,
+	     (size_t) size,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	read_count = libvshadow_store_read_buffer_at_offset(
+	              nbd_connection->store,
+	              nbd_connection->buffer,
+	              (size_t) size,
+	              (off64_t) offset,
+	              &read_error );
+
+	if( read_count != (ssize_t) size )
+	{
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: unable to read store: %d at offset: %" PRIu64 " (0x%08" PRIx64 ").\n",
+			 function,
+			 nbd_connection->store_index,
+			 offset,
+			 offset );
+
+			libcnotify_print_error_backtrace(
+			 read_error );
+		}
+		libcerror_error_free(
+		 &read_error );
+
+		return( nbd_connection_write_error_reply(
+		         nbd_connection,
+		         cookie,
+		         NBD_EIO,
+		         error ) );
+	}
+	if( nbd_connection->structured_replies == 0 )
+	{
+		return( nbd_connection_write_simple_reply(
+		         nbd_connection,
+		         cookie,
+		         0,
+		         (size_t) size,
+		         error ) );
+	}
+	if( nbd_connection_write_structured_reply_header(
+	     nbd_connection,
+	     cookie,
+	     NBD_REPLY_FLAG_DONE,
+	     NBD_REPLY_TYPE_OFFSET_DATA,
+	     8 + size,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 offset_data,
+	 offset );
+
+	if( nbd_connection_write_data(
+	     nbd_connection,
+	     offset_data,
+	     8,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( nbd_connection_write_data(
+	     nbd_connection,
+	     nbd_connection->buffer,
+	     (size_t) size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Handles a block status command
+ * The allocation status is determined from the block descriptors of the store,
+ * where sparse ranges are reported as holes that read as zero
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_handle_block_status(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *cookie,
+     uint16_t command_flags,
+     uint64_t offset,
+     uint32_t size,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *source_error = NULL;
+	static char *function           = "nbd_connection_handle_block_status";
+	size64_t source_size            = 0;
+	size_t descriptor_offset        = 0;
+	uint64_t end_offset             = 0;
+	uint32_t descriptor_flags       = 0;
+	uint32_t descriptor_size        = 0;
+	uint32_t last_descriptor_flags  = 0;
+	off64_t source_offset           = 0;
+	int maximum_descriptors         = 0;
+	int number_of_descriptors       = 0;
+	int source_store_index          = 0;
+	int source_type                 = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( nbd_connection->structured_replies == 0 )
+	 || ( nbd_connection->base_allocation_context == 0 )
+	 || ( size == 0 )
+	 || ( offset >= nbd_connection->export_size ) )
+	{
+		return( nbd_connection_write_error_reply(
+		         nbd_connection,
+		         cookie,
+		         NBD_EINVAL,
+		         error ) );
+	}
+	end_offset = offset + size;
+
+	if( end_offset > nbd_connection->export_size )
+	{
+		end_offset = nbd_connection->export_size;
+	}
+	if( ( command_flags & NBD_CMD_FLAG_REQ_ONE ) != 0 )
+	{
+		maximum_descriptors = 1;
+	}
+	else
+	{
+		maximum_descriptors = NBD_CONNECTION_MAXIMUM_NUMBER_OF_BLOCK_STATUS_DESCRIPTORS;
+	}
+	if( nbd_connection_resize_buffer(
+	     nbd_connection,
+	     4 + ( 8 * NBD_CONNECTION_MAXIMUM_NUMBER_OF_BLOCK_STATUS_DESCRIPTORS ),
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 nbd_connection->buffer,
+	 NBD_CONNECTION_BASE_ALLOCATION_CONTEXT_IDENTIFIER );
+
+	while( offset < end_offset )
+	{
+		if( libvshadow_store_get_data_source_at_offset(
+		     nbd_connection->store,
+		     (off64_t) offset,
+		     &source_type,
+		     &source_store_index,
+		     &source_offset,
+		     &source_size,
+		     &source_error ) != 1 )
+		{
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to retrieve data source of store: %d at offset: %" PRIu64 " (0x%08" PRIx64 ").\n",
+				 function,
+				 nbd_connection->store_index,
+				 offset,
+				 offset );
+
+				libcnotify_print_error_backtrace(
+				 source_error );
+			}
+			libcerror_error_free(
+			 &source_error );
+
+			return( nbd_connection_write_error_reply(
+			         nbd_connection,
+			         cookie,
+			         NBD_EIO,
+			         error ) );
+		}
+		if( source_size > ( end_offset - offset ) )
+		{
+			source_size = end_offset - offset;
+		}
+		if( source_type == LIBVSHADOW_DATA_SOURCE_TYPE_SPARSE )
+		{
+			descriptor_flags = NBD_STATE_HOLE | NBD_STATE_ZERO;
+		}
+		else
+		{
+			descriptor_flags = 0;
+		}
+		/* Contiguous ranges with the same state are merged into a single descriptor
+		 */
+		if( ( number_of_descriptors > 0 )
+		 && ( descriptor_flags == last_descriptor_flags )
+		 && ( source_size <= (size64_t) ( 0xffffffffUL - descriptor_size ) ) )
+		{
+			descriptor_size += (uint32_t) source_size;
+		}
+		else
+		{
+			if( number_of_descriptors > 0 )
+			{
+				byte_stream_copy_from_uint32_big_endian(
+				 &( nbd_connection->buffer[ descriptor_offset ] ),
+				 descriptor_size );
+			}
+			if( number_of_descriptors >= maximum_descriptors )
+			{
+				break;
+			}
+			descriptor_offset = 4 + ( 8 * number_of_descriptors );
+
+			byte_stream_copy_from_uint32_big_endian(
+			 &( nbd_connection->buffer[ descriptor_offset + 4 ] ),
+			 descriptor_flags );
+
+			descriptor_size       = (uint32_t) source_size;
+			last_descriptor_flags = descriptor_flags;
+
+			number_of_descriptors++;
+		}
+		offset += source_size;
+	}
+	if( offset >= end_offset )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( nbd_connection->buffer[ descriptor_offset ] ),
+		 descriptor_size );
+	}
+	if( nbd_connection_write_structured_reply_header(
+	     nbd_connection,
+	     cookie,
+	     NBD_REPLY_FLAG_DONE,
+	     NBD_REPLY_TYPE_BLOCK_STATUS,
+	     (uint32_t) ( 4 + ( 8 * number_of_descriptors ) ),
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( nbd_connection_write_data(
+	     nbd_connection,
+	     nbd_connection->buffer,
+	     (size_t) ( 4 + ( 8 * number_of_descriptors ) ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write block status descriptors.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Handles the requests of the client during the transmission phase
+ * Returns 1 if the client disconnected, 0 if the connection was closed or -1 on error
+ */
+int nbd_connection_handle_requests(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error )
+{
+	nbd_request_t request;
+
+	static char *function  = "nbd_connection_handle_requests";
+	size_t read_size       = 0;
+	uint64_t offset        = 0;
+	uint32_t magic         = 0;
+	uint32_t size          = 0;
+	uint16_t command_flags = 0;
+	uint16_t command_type  = 0;
+	int result             = 0;
+
+	if( nbd_connection == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD connection.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_connection->store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid NBD connection - missing store.",
+		 function );
+
+		return( -1 );
+	}
+	while( nbd_connection->nbd_handle->abort == 0 )
+	{
+		result = nbd_connection_read_data(
+		          nbd_connection,
+		          (uint8_t *) &request,
+		          sizeof( nbd_request_t ),
+		          error );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 request.magic,
+		 magic );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 request.command_flags,
+		 command_flags );
+
+		byte_stream_copy_to_uint16_big_endian(
+		 request.command_type,
+		 command_type );
+
+		byte_stream_copy_to_uint64_big_endian(
+		 request.offset,
+		 offset );
+
+		byte_stream_copy_to_uint32_big_endian(
+		 request.size,
+		 size );
+
+		if( magic != NBD_REQUEST_MAGIC )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported request magic: 0x%08" PRIx32 ".",
+			 function,
+			 magic );
+
+			return( -1 );
+		}
+		switch( command_type )
+		{
+			case NBD_CMD_READ:
+				result = nbd_connection_handle_read(
+				          nbd_connection,
+				          request.cookie,
+				          offset,
+				          size,
+				          error );
+				break;
+
+			case NBD_CMD_BLOCK_STATUS:
+				result = nbd_connection_handle_block_status(
+				          nbd_connection,
+				          request.cookie,
+				          command_flags,
+				          offset,
+				          size,
+				          error );
+				break;
+
+			case NBD_CMD_DISC:
+				return( 1 );
+
+			case NBD_CMD_FLUSH:
+			case NBD_CMD_CACHE:
+				result = nbd_connection_write_simple_reply(
+				          nbd_connection,
+				          request.cookie,
+				          0,
+				          0,
+				          error );
+				break;
+
+			case NBD_CMD_WRITE:
+				/* Discard the data of the write request
+				 */
+				while( size > 0 )
+				{
+					read_size = 64 * 1024;
+
+					if( (uint32_t) read_size > size )
+					{
+						read_size = (size_t) size;
+					}
+					if( nbd_connection_resize_buffer(
+					     nbd_connection,
+					     read_size,
+					     error ) != 1 )
+					{
+						return( -1 );
+					}
+					if( nbd_connection_read_data(
+					     nbd_connection,
+					     nbd_connection->buffer,
+					     read_size,
+					     error ) != 1 )
+					{
+						return( -1 );
+					}
+					size -= (uint32_t) read_size;
+				}
+				result = nbd_connection_write_error_reply(
+				          nbd_connection,
+				          request.cookie,
+				          NBD_EPERM,
+				          error );
+				break;
+
+			case NBD_CMD_TRIM:
+			case NBD_CMD_WRITE_ZEROES:
+				result = nbd_connection_write_error_reply(
+				          nbd_connection,
+				          request.cookie,
+				          NBD_EPERM,
+				          error );
+				break;
+
+			default:
+				result = nbd_connection_write_error_reply(
+				          nbd_connection,
+				          request.cookie,
+				          NBD_EINVAL,
+				          error );
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to handle command: %" PRIu16 ".",
+			 function,
+			 command_type );
+
+			return( -1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Serves a client
+ * This function is used as the connection thread callback
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_connection_thread_callback(
+     nbd_connection_t *nbd_connection )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "nbd_connection_thread_callback";
+	int result               = 0;
+
+	if( nbd_connection == NULL )
+	{
+		return( -1 );
+	}
+	result = nbd_connection_negotiate(
+	          nbd_connection,
+	          &error );
+
+	if( result == 1 )
+	{
+		result = nbd_connection_handle_requests(
+		          nbd_connection,
+		          &error );
+	}
+	if( result == -1 )
+	{
+		libcnotify_printf(
+		 "%s: unable to serve client.\n",
+		 function );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	nbd_connection->is_finished = 1;
+
+	if( result == -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_NBD_SUPPORT ) */
+
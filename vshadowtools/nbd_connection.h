@@ -0,0 +1,211 @@
+/*
+ * Network Block Device (NBD) connection
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_CONNECTION_H )
+#define _NBD_CONNECTION_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libvshadow.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The identifier of the base:allocation metadata context
+ */
+#define NBD_CONNECTION_BASE_ALLOCATION_CONTEXT_IDENTIFIER	1
+
+/* The maximum number of descriptors in a block status reply
+ */
+#define NBD_CONNECTION_MAXIMUM_NUMBER_OF_BLOCK_STATUS_DESCRIPTORS	1024
+
+typedef struct nbd_connection nbd_connection_t;
+
+struct nbd_connection
+{
+	/* The NBD handle
+	 */
+	struct nbd_handle *nbd_handle;
+
+	/* The socket
+	 */
+	int socket;
+
+	/* The store index of the export, -1 represents no export selected
+	 */
+	int store_index;
+
+	/* The libvshadow store of the export
+	 */
+	libvshadow_store_t *store;
+
+	/* The export size
+	 */
+	size64_t export_size;
+
+	/* Value to indicate the client does not want the zero padding after the export information
+	 */
+	uint8_t no_zeroes;
+
+	/* Value to indicate structured replies were negotiated
+	 */
+	uint8_t structured_replies;
+
+	/* Value to indicate the base:allocation metadata context was negotiated
+	 */
+	uint8_t base_allocation_context;
+
+	/* The data buffer
+	 */
+	uint8_t *buffer;
+
+	/* The data buffer size
+	 */
+	size_t buffer_size;
+
+	/* Value to indicate the connection has finished
+	 */
+	int is_finished;
+};
+
+int nbd_connection_initialize(
+     nbd_connection_t **nbd_connection,
+     struct nbd_handle *nbd_handle,
+     int socket,
+     libcerror_error_t **error );
+
+int nbd_connection_free(
+     nbd_connection_t **nbd_connection,
+     libcerror_error_t **error );
+
+int nbd_connection_signal_abort(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error );
+
+int nbd_connection_read_data(
+     nbd_connection_t *nbd_connection,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_data(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_resize_buffer(
+     nbd_connection_t *nbd_connection,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_option_reply(
+     nbd_connection_t *nbd_connection,
+     uint32_t option_type,
+     uint32_t reply_type,
+     const uint8_t *data,
+     uint32_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_select_export(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *export_name,
+     uint32_t export_name_size,
+     libcerror_error_t **error );
+
+uint16_t nbd_connection_get_transmission_flags(
+          nbd_connection_t *nbd_connection );
+
+int nbd_connection_handle_option_list(
+     nbd_connection_t *nbd_connection,
+     uint32_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_option_info(
+     nbd_connection_t *nbd_connection,
+     uint32_t option_type,
+     const uint8_t *data,
+     uint32_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_option_meta_context(
+     nbd_connection_t *nbd_connection,
+     uint32_t option_type,
+     const uint8_t *data,
+     uint32_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_negotiate(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error );
+
+int nbd_connection_write_simple_reply(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *cookie,
+     uint32_t error_value,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_structured_reply_header(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *cookie,
+     uint16_t reply_flags,
+     uint16_t reply_type,
+     uint32_t data_size,
+     libcerror_error_t **error );
+
+int nbd_connection_write_error_reply(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *cookie,
+     uint32_t error_value,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_read(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *cookie,
+     uint64_t offset,
+     uint32_t size,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_block_status(
+     nbd_connection_t *nbd_connection,
+     const uint8_t *cookie,
+     uint16_t command_flags,
+     uint64_t offset,
+     uint32_t size,
+     libcerror_error_t **error );
+
+int nbd_connection_handle_requests(
+     nbd_connection_t *nbd_connection,
+     libcerror_error_t **error );
+
+int nbd_connection_thread_callback(
+     nbd_connection_t *nbd_connection );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NBD_CONNECTION_H ) */
+
@@ -0,0 +1,1400 @@
+/*
+ * Network Block Device (NBD) handle
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "nbd_connection.h"
+#include "nbd_handle.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+
+#if defined( HAVE_NBD_SUPPORT )
+
+#include <errno.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#endif /* defined( HAVE_NBD_SUPPORT ) */
+
+#if !defined( LIBVSHADOW_HAVE_BFIO )
+
+extern \
+int libvshadow_volume_open_file_io_handle(
+     libvshadow_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libvshadow_error_t **error );
+
+extern \
+int libvshadow_check_volume_signature_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+#endif /* !defined( LIBVSHADOW_HAVE_BFIO ) */
+
+#define NBD_HANDLE_NOTIFY_STREAM		stdout
+
+
+/* Copies a string of a decimal value to a 64-bit value
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error )
+{
+	static char *function              = "nbd_handle_system_string_copy_from_64_bit_in_decimal";
+	system_character_t character_value = 0;
+	size_t string_index                = 0;
+	uint8_t maximum_string_index       = 20;
+	int8_t sign                        = 1;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value 64-bit.",
+		 function );
+
+		return( -1 );
+	}
+	*value_64bit = 0;
+
+	if( string[ string_index ] == (system_character_t) '-' )
+	{
+		string_index++;
+		maximum_string_index++;
+
+		sign = -1;
+	}
+	else if( string[ string_index ] == (system_character_t) '+' )
+	{
+		string_index++;
+		maximum_string_index++;
+	}
+	while( string_index < string_size )
+	{
+		if( string[ string_index ] == 0 )
+		{
+			break;
+		}
+		if( string_index > (size_t) maximum_string_index )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_LARGE,
+			 "%s: string too large.",
+			 function );
+
+			return( -1 );
+		}
+		*value_64bit *= 10;
+
+		if( ( string[ string_index ] >= (system_character_t) '0' )
+		 && ( string[ string_index ] <= (system_character_t) '9' ) )
+		{
+			character_value = (system_character_t) ( string[ string_index ] - (system_character_t) '0' );
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported character value: %" PRIc_SYSTEM " at index: %d.",
+			 function,
+			 string[ string_index ],
+			 string_index );
+
+			return( -1 );
+		}
+		*value_64bit += character_value;
+
+		string_index++;
+	}
+	if( sign == -1 )
+	{
+		*value_64bit *= (uint64_t) -1;
+	}
+	return( 1 );
+}
+
+/* Creates a NBD handle
+ * Make sure the value nbd_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_initialize(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_initialize";
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*nbd_handle = memory_allocate_structure(
+	               nbd_handle_t );
+
+	if( *nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create NBD handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *nbd_handle,
+	     0,
+	     sizeof( nbd_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear NBD handle.",
+		 function );
+
+		memory_free(
+		 *nbd_handle );
+
+		*nbd_handle = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_file_range_initialize(
+	     &( ( *nbd_handle )->input_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvshadow_volume_initialize(
+	     &( ( *nbd_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input volume.",
+		 function );
+
+		goto on_error;
+	}
+	( *nbd_handle )->port          = NBD_HANDLE_DEFAULT_PORT;
+	( *nbd_handle )->listen_socket = -1;
+	( *nbd_handle )->notify_stream = NBD_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *nbd_handle != NULL )
+	{
+		if( ( *nbd_handle )->input_file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *nbd_handle )->input_file_io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *nbd_handle );
+
+		*nbd_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a NBD handle
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_free(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_free";
+	int result            = 1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_handle != NULL )
+	{
+#if defined( HAVE_NBD_SUPPORT )
+		if( nbd_handle_release_finished_connections(
+		     *nbd_handle,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release connections.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( libvshadow_volume_free(
+		     &( ( *nbd_handle )->input_volume ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input volume.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *nbd_handle )->input_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *nbd_handle )->socket_path != NULL )
+		{
+			memory_free(
+			 ( *nbd_handle )->socket_path );
+		}
+		memory_free(
+		 *nbd_handle );
+
+		*nbd_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the NBD handle to abort
+ * The connections are aborted when the serve loop terminates
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_signal_abort(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_signal_abort";
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->abort = 1;
+
+#if defined( HAVE_NBD_SUPPORT )
+	/* Shutting down the listening socket causes a blocking accept to return
+	 */
+	if( nbd_handle->listen_socket >= 0 )
+	{
+		shutdown(
+		 nbd_handle->listen_socket,
+		 SHUT_RDWR );
+	}
+#endif
+	if( nbd_handle->input_volume != NULL )
+	{
+		if( libvshadow_volume_signal_abort(
+		     nbd_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input volume to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the volume offset
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_set_volume_offset(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_set_volume_offset";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( nbd_handle_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->volume_offset = (off64_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the TCP port
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_set_port(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_set_port";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( nbd_handle_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) UINT16_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid port value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->port = (uint16_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the Unix domain socket path
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_set_socket_path(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *socket_path,
+     libcerror_error_t **error )
+{
+	static char *function   = "nbd_handle_set_socket_path";
+	size_t socket_path_size = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid socket path.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->socket_path != NULL )
+	{
+		memory_free(
+		 nbd_handle->socket_path );
+
+		nbd_handle->socket_path      = NULL;
+		nbd_handle->socket_path_size = 0;
+	}
+	socket_path_size = system_string_length(
+	                    socket_path ) + 1;
+
+	if( socket_path_size == 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing socket path.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->socket_path = system_string_allocate(
+	                           socket_path_size );
+
+	if( nbd_handle->socket_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create socket path.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     nbd_handle->socket_path,
+	     socket_path,
+	     socket_path_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy socket path.",
+		 function );
+
+		goto on_error;
+	}
+	nbd_handle->socket_path[ socket_path_size - 1 ] = 0;
+
+	nbd_handle->socket_path_size = socket_path_size;
+
+	return( 1 );
+
+on_error:
+	if( nbd_handle->socket_path != NULL )
+	{
+		memory_free(
+		 nbd_handle->socket_path );
+
+		nbd_handle->socket_path = NULL;
+	}
+	nbd_handle->socket_path_size = 0;
+
+	return( -1 );
+}
+
+/* Opens the input of the NBD handle
+ * Returns 1 if successful, 0 if no VSS enabled volume was found or -1 on error
+ */
+int nbd_handle_open_input(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "nbd_handle_open_input";
+	size_t filename_length = 0;
+	int result             = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_range_set_name_wide(
+	     nbd_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_range_set_name(
+	     nbd_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_range_set(
+	     nbd_handle->input_file_io_handle,
+	     nbd_handle->volume_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open set volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvshadow_check_volume_signature_file_io_handle(
+	          nbd_handle->input_file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if volume has a VSS signature.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( libvshadow_volume_open_file_io_handle(
+		     nbd_handle->input_volume,
+		     nbd_handle->input_file_io_handle,
+		     LIBVSHADOW_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open input volume.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvshadow_volume_get_size(
+		     nbd_handle->input_volume,
+		     &( nbd_handle->volume_size ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve volume size.",
+			 function );
+
+			return( -1 );
+		}
+		if( libvshadow_volume_get_number_of_stores(
+		     nbd_handle->input_volume,
+		     &( nbd_handle->number_of_stores ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of stores.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Closes the NBD handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int nbd_handle_close(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_close";
+	int result            = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_NBD_SUPPORT )
+	if( nbd_handle_release_finished_connections(
+	     nbd_handle,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release connections.",
+		 function );
+
+		result = -1;
+	}
+	if( nbd_handle->listen_socket >= 0 )
+	{
+		if( close(
+		     nbd_handle->listen_socket ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close listening socket.",
+			 function );
+
+			result = -1;
+		}
+		nbd_handle->listen_socket = -1;
+
+		if( nbd_handle->socket_path != NULL )
+		{
+			unlink(
+			 nbd_handle->socket_path );
+		}
+	}
+#endif
+	if( libvshadow_volume_close(
+	     nbd_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input volume.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Retrieves the store index of an export name
+ * The export names are "vss" followed by the store number, which starts at 1
+ * Returns 1 if successful, 0 if no such export or -1 on error
+ */
+int nbd_handle_get_store_index_by_export_name(
+     nbd_handle_t *nbd_handle,
+     const uint8_t *export_name,
+     size_t export_name_size,
+     int *store_index,
+     libcerror_error_t **error )
+{
+	static char *function    = "nbd_handle_get_store_index_by_export_name";
+	size_t export_name_index = 0;
+	uint8_t character_value  = 0;
+	int safe_store_index     = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_name == NULL )
+	 && ( export_name_size != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export name.",
+		 function );
+
+		return( -1 );
+	}
+	if( store_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid store index.",
+		 function );
+
+		return( -1 );
+	}
+	/* The store number must be between 1 and 9999 without leading zeros
+	 */
+	if( ( export_name_size < 4 )
+	 || ( export_name_size > 7 ) )
+	{
+		return( 0 );
+	}
+	if( ( export_name[ 0 ] != (uint8_t) 'v' )
+	 || ( export_name[ 1 ] != (uint8_t) 's' )
+	 || ( export_name[ 2 ] != (uint8_t) 's' )
+	 || ( export_name[ 3 ] == (uint8_t) '0' ) )
+	{
+		return( 0 );
+	}
+	for( export_name_index = 3;
+	     export_name_index < export_name_size;
+	     export_name_index++ )
+	{
+		character_value = export_name[ export_name_index ];
+
+		if( ( character_value < (uint8_t) '0' )
+		 || ( character_value > (uint8_t) '9' ) )
+		{
+			return( 0 );
+		}
+		safe_store_index *= 10;
+		safe_store_index += character_value - (uint8_t) '0';
+	}
+	if( safe_store_index > nbd_handle->number_of_stores )
+	{
+		return( 0 );
+	}
+	*store_index = safe_store_index - 1;
+
+	return( 1 );
+}
+
+#if defined( HAVE_NBD_SUPPORT )
+
+/* Creates the listening socket
+ * A Unix domain socket is used if a socket path was set, otherwise
+ * a TCP socket that only accepts connections from the local host
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_listen(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	struct sockaddr_in inet_address;
+	struct sockaddr_un unix_address;
+
+	struct sockaddr *address = NULL;
+	static char *function    = "nbd_handle_listen";
+	socklen_t address_size   = 0;
+	int listen_socket        = -1;
+	int option_value         = 1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->listen_socket >= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle - listening socket value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->socket_path != NULL )
+	{
+		if( nbd_handle->socket_path_size > sizeof( unix_address.sun_path ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid socket path size value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     &unix_address,
+		     0,
+		     sizeof( struct sockaddr_un ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear Unix domain socket address.",
+			 function );
+
+			goto on_error;
+		}
+		unix_address.sun_family = AF_UNIX;
+
+		if( memory_copy(
+		     unix_address.sun_path,
+		     nbd_handle->socket_path,
+		     nbd_handle->socket_path_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy socket path.",
+			 function );
+
+			goto on_error;
+		}
+		address      = (struct sockaddr *) &unix_address;
+		address_size = (socklen_t) sizeof( struct sockaddr_un );
+	}
+	else
+	{
+		if( memory_set(
+		     &inet_address,
+		     0,
+		     sizeof( struct sockaddr_in ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear TCP socket address.",
+			 function );
+
+			goto on_error;
+		}
+		inet_address.sin_family      = AF_INET;
+		inet_address.sin_port        = htons( nbd_handle->port );
+		inet_address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+
+		address      = (struct sockaddr *) &inet_address;
+		address_size = (socklen_t) sizeof( struct sockaddr_in );
+	}
+	listen_socket = socket(
+	                 address->sa_family,
+	                 SOCK_STREAM,
+	                 0 );
+
+	if( listen_socket == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to create socket.",
+		 function );
+
+		goto on_error;
+	}
+	if( address->sa_family == AF_INET )
+	{
+		if( setsockopt(
+		     listen_socket,
+		     SOL_SOCKET,
+		     SO_REUSEADDR,
+		     &option_value,
+		     (socklen_t) sizeof( int ) ) != 0 )
+		{
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 errno,
+			 "%s: unable to set socket option.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( bind(
+	     listen_socket,
+	     address,
+	     address_size ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to bind socket.",
+		 function );
+
+		goto on_error;
+	}
+	if( listen(
+	     listen_socket,
+	     NBD_HANDLE_MAXIMUM_NUMBER_OF_CONNECTIONS ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to listen on socket.",
+		 function );
+
+		if( nbd_handle->socket_path != NULL )
+		{
+			unlink(
+			 nbd_handle->socket_path );
+		}
+		goto on_error;
+	}
+	nbd_handle->listen_socket = listen_socket;
+
+	return( 1 );
+
+on_error:
+	if( listen_socket != -1 )
+	{
+		close(
+		 listen_socket );
+	}
+	return( -1 );
+}
+
+/* Releases the connections that have finished
+ * If release_all is set all connections are aborted and released
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_release_finished_connections(
+     nbd_handle_t *nbd_handle,
+     int release_all,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_release_finished_connections";
+	int connection_index  = 0;
+	int result            = 1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( connection_index = 0;
+	     connection_index < NBD_HANDLE_MAXIMUM_NUMBER_OF_CONNECTIONS;
+	     connection_index++ )
+	{
+		if( nbd_handle->connections[ connection_index ] == NULL )
+		{
+			continue;
+		}
+		if( ( release_all == 0 )
+		 && ( nbd_handle->connections[ connection_index ]->is_finished == 0 ) )
+		{
+			continue;
+		}
+		if( release_all != 0 )
+		{
+			if( nbd_connection_signal_abort(
+			     nbd_handle->connections[ connection_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal connection: %d to abort.",
+				 function,
+				 connection_index );
+
+				result = -1;
+			}
+		}
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+		if( nbd_handle->connection_threads[ connection_index ] != NULL )
+		{
+			if( libcthreads_thread_join(
+			     &( nbd_handle->connection_threads[ connection_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join connection thread: %d.",
+				 function,
+				 connection_index );
+
+				result = -1;
+			}
+		}
+#endif
+		if( nbd_connection_free(
+		     &( nbd_handle->connections[ connection_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free connection: %d.",
+			 function,
+			 connection_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Accepts and serves clients until signalled to abort
+ * Every connection is served by its own thread if multi-threading is supported
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_serve(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_serve";
+	int connection_index  = 0;
+	int connection_socket = -1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->listen_socket < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid NBD handle - missing listening socket.",
+		 function );
+
+		return( -1 );
+	}
+	while( nbd_handle->abort == 0 )
+	{
+		connection_socket = accept(
+		                     nbd_handle->listen_socket,
+		                     NULL,
+		                     NULL );
+
+		if( connection_socket == -1 )
+		{
+			if( nbd_handle->abort != 0 )
+			{
+				break;
+			}
+			if( ( errno == EINTR )
+			 || ( errno == ECONNABORTED ) )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 errno,
+			 "%s: unable to accept connection.",
+			 function );
+
+			goto on_error;
+		}
+		if( nbd_handle_release_finished_connections(
+		     nbd_handle,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to release finished connections.",
+			 function );
+
+			goto on_error;
+		}
+		for( connection_index = 0;
+		     connection_index < NBD_HANDLE_MAXIMUM_NUMBER_OF_CONNECTIONS;
+		     connection_index++ )
+		{
+			if( nbd_handle->connections[ connection_index ] == NULL )
+			{
+				break;
+			}
+		}
+		if( connection_index >= NBD_HANDLE_MAXIMUM_NUMBER_OF_CONNECTIONS )
+		{
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: maximum number of connections reached, refusing connection.\n",
+				 function );
+			}
+			close(
+			 connection_socket );
+
+			connection_socket = -1;
+
+			continue;
+		}
+		if( nbd_connection_initialize(
+		     &( nbd_handle->connections[ connection_index ] ),
+		     nbd_handle,
+		     connection_socket,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create connection.",
+			 function );
+
+			goto on_error;
+		}
+		/* The connection now owns the socket
+		 */
+		connection_socket = -1;
+
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_thread_create(
+		     &( nbd_handle->connection_threads[ connection_index ] ),
+		     NULL,
+		     (int (*)(void *)) &nbd_connection_thread_callback,
+		     (void *) nbd_handle->connections[ connection_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create connection thread.",
+			 function );
+
+			nbd_connection_free(
+			 &( nbd_handle->connections[ connection_index ] ),
+			 NULL );
+
+			goto on_error;
+		}
+#else
+		nbd_connection_thread_callback(
+		 nbd_handle->connections[ connection_index ] );
+
+		if( nbd_connection_free(
+		     &( nbd_handle->connections[ connection_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free connection.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+	}
+	if( nbd_handle_release_finished_connections(
+	     nbd_handle,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release connections.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( connection_socket != -1 )
+	{
+		close(
+		 connection_socket );
+	}
+	nbd_handle_release_finished_connections(
+	 nbd_handle,
+	 1,
+	 NULL );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_NBD_SUPPORT ) */
+
@@ -0,0 +1,177 @@
+/*
+ * Network Block Device (NBD) handle
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_HANDLE_H )
+#define _NBD_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "nbd_connection.h"
+#include "vshadowtools_libbfio.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcthreads.h"
+#include "vshadowtools_libvshadow.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#if defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) && defined( HAVE_NETINET_IN_H ) && defined( HAVE_ARPA_INET_H ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) && !defined( WINAPI )
+#define HAVE_NBD_SUPPORT
+#endif
+
+/* The default TCP port
+ */
+#define NBD_HANDLE_DEFAULT_PORT				10809
+
+/* The maximum number of simultaneous connections
+ */
+#define NBD_HANDLE_MAXIMUM_NUMBER_OF_CONNECTIONS	16
+
+typedef struct nbd_handle nbd_handle_t;
+
+struct nbd_handle
+{
+	/* The volume offset
+	 */
+	off64_t volume_offset;
+
+	/* The libbfio input file IO handle
+	 */
+	libbfio_handle_t *input_file_io_handle;
+
+	/* The libvshadow input volume
+	 */
+	libvshadow_volume_t *input_volume;
+
+	/* The volume size
+	 */
+	size64_t volume_size;
+
+	/* The number of stores
+	 */
+	int number_of_stores;
+
+	/* The Unix domain socket path
+	 */
+	system_character_t *socket_path;
+
+	/* The Unix domain socket path size
+	 */
+	size_t socket_path_size;
+
+	/* The TCP port
+	 */
+	uint16_t port;
+
+	/* The listening socket
+	 */
+	int listen_socket;
+
+	/* The connections
+	 */
+	nbd_connection_t *connections[ NBD_HANDLE_MAXIMUM_NUMBER_OF_CONNECTIONS ];
+
+#if defined( VSHADOWTOOLS_HAVE_MULTI_THREAD_SUPPORT )
+	/* The connection threads
+	 */
+	libcthreads_thread_t *connection_threads[ NBD_HANDLE_MAXIMUM_NUMBER_OF_CONNECTIONS ];
+#endif
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int nbd_handle_system_string_copy_from_64_bit_in_decimal(
+     const system_character_t *string,
+     size_t string_size,
+     uint64_t *value_64bit,
+     libcerror_error_t **error );
+
+int nbd_handle_initialize(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_free(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_signal_abort(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_set_volume_offset(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int nbd_handle_set_port(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int nbd_handle_set_socket_path(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *socket_path,
+     libcerror_error_t **error );
+
+int nbd_handle_open_input(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int nbd_handle_close(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_get_store_index_by_export_name(
+     nbd_handle_t *nbd_handle,
+     const uint8_t *export_name,
+     size_t export_name_size,
+     int *store_index,
+     libcerror_error_t **error );
+
+int nbd_handle_listen(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_release_finished_connections(
+     nbd_handle_t *nbd_handle,
+     int release_all,
+     libcerror_error_t **error );
+
+int nbd_handle_serve(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NBD_HANDLE_H ) */
+
@@ -0,0 +1,316 @@
+/*
+ * Network Block Device (NBD) protocol definitions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_PROTOCOL_H )
+#define _NBD_PROTOCOL_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define NBD_INITIAL_MAGIC				0x4e42444d41474943ULL
+#define NBD_OPTION_MAGIC				0x49484156454f5054ULL
+#define NBD_OPTION_REPLY_MAGIC				0x0003e889045565a9ULL
+#define NBD_REQUEST_MAGIC				0x25609513UL
+#define NBD_SIMPLE_REPLY_MAGIC				0x67446698UL
+#define NBD_STRUCTURED_REPLY_MAGIC			0x668e33efUL
+
+/* The maximum size of the data of an option
+ */
+#define NBD_MAXIMUM_OPTION_DATA_SIZE			4096
+
+/* The maximum size of the data of a read request
+ */
+#define NBD_MAXIMUM_REQUEST_DATA_SIZE			( 32 * 1024 * 1024 )
+
+/* The handshake flags
+ */
+enum NBD_HANDSHAKE_FLAGS
+{
+	NBD_FLAG_FIXED_NEWSTYLE				= 0x0001,
+	NBD_FLAG_NO_ZEROES				= 0x0002
+};
+
+/* The client flags
+ */
+enum NBD_CLIENT_FLAGS
+{
+	NBD_FLAG_C_FIXED_NEWSTYLE			= 0x00000001UL,
+	NBD_FLAG_C_NO_ZEROES				= 0x00000002UL
+};
+
+/* The transmission flags
+ */
+enum NBD_TRANSMISSION_FLAGS
+{
+	NBD_FLAG_HAS_FLAGS				= 0x0001,
+	NBD_FLAG_READ_ONLY				= 0x0002,
+	NBD_FLAG_SEND_FLUSH				= 0x0004,
+	NBD_FLAG_SEND_DF				= 0x0080,
+	NBD_FLAG_CAN_MULTI_CONN				= 0x0100,
+	NBD_FLAG_SEND_CACHE				= 0x0400
+};
+
+/* The option types
+ */
+enum NBD_OPTION_TYPES
+{
+	NBD_OPT_EXPORT_NAME				= 1,
+	NBD_OPT_ABORT					= 2,
+	NBD_OPT_LIST					= 3,
+	NBD_OPT_INFO					= 6,
+	NBD_OPT_GO					= 7,
+	NBD_OPT_STRUCTURED_REPLY			= 8,
+	NBD_OPT_LIST_META_CONTEXT			= 9,
+	NBD_OPT_SET_META_CONTEXT			= 10
+};
+
+/* The option reply types
+ */
+enum NBD_OPTION_REPLY_TYPES
+{
+	NBD_REP_ACK					= 1,
+	NBD_REP_SERVER					= 2,
+	NBD_REP_INFO					= 3,
+	NBD_REP_META_CONTEXT				= 4
+};
+
+/* The option reply error types
+ */
+#define NBD_REP_ERR_UNSUP				0x80000001UL
+#define NBD_REP_ERR_POLICY				0x80000002UL
+#define NBD_REP_ERR_INVALID				0x80000003UL
+#define NBD_REP_ERR_UNKNOWN				0x80000006UL
+
+/* The information types
+ */
+enum NBD_INFORMATION_TYPES
+{
+	NBD_INFO_EXPORT					= 0,
+	NBD_INFO_NAME					= 1,
+	NBD_INFO_DESCRIPTION				= 2,
+	NBD_INFO_BLOCK_SIZE				= 3
+};
+
+/* The command types
+ */
+enum NBD_COMMAND_TYPES
+{
+	NBD_CMD_READ					= 0,
+	NBD_CMD_WRITE					= 1,
+	NBD_CMD_DISC					= 2,
+	NBD_CMD_FLUSH					= 3,
+	NBD_CMD_TRIM					= 4,
+	NBD_CMD_CACHE					= 5,
+	NBD_CMD_WRITE_ZEROES				= 6,
+	NBD_CMD_BLOCK_STATUS				= 7
+};
+
+/* The command flags
+ */
+enum NBD_COMMAND_FLAGS
+{
+	NBD_CMD_FLAG_FUA				= 0x0001,
+	NBD_CMD_FLAG_NO_HOLE				= 0x0002,
+	NBD_CMD_FLAG_DF					= 0x0004,
+	NBD_CMD_FLAG_REQ_ONE				= 0x0008
+};
+
+/* The structured reply types
+ */
+enum NBD_STRUCTURED_REPLY_TYPES
+{
+	NBD_REPLY_TYPE_NONE				= 0,
+	NBD_REPLY_TYPE_OFFSET_DATA			= 1,
+	NBD_REPLY_TYPE_OFFSET_HOLE			= 2,
+	NBD_REPLY_TYPE_BLOCK_STATUS			= 5,
+	NBD_REPLY_TYPE_ERROR				= 0x8001
+};
+
+/* The structured reply flags
+ */
+enum NBD_STRUCTURED_REPLY_FLAGS
+{
+	NBD_REPLY_FLAG_DONE				= 0x0001
+};
+
+/* The base:allocation metadata context states
+ */
+enum NBD_ALLOCATION_STATES
+{
+	NBD_STATE_HOLE					= 0x00000001UL,
+	NBD_STATE_ZERO					= 0x00000002UL
+};
+
+/* The error values
+ */
+enum NBD_ERRORS
+{
+	NBD_EPERM					= 1,
+	NBD_EIO						= 5,
+	NBD_ENOMEM					= 12,
+	NBD_EINVAL					= 22,
+	NBD_ENOSPC					= 28,
+	NBD_EOVERFLOW					= 75,
+	NBD_ENOTSUP					= 95,
+	NBD_ESHUTDOWN					= 108
+};
+
+typedef struct nbd_option_header nbd_option_header_t;
+
+struct nbd_option_header
+{
+	/* The magic
+	 * Consists of 8 bytes
+	 * Contains: IHAVEOPT
+	 */
+	uint8_t magic[ 8 ];
+
+	/* The option type
+	 * Consists of 4 bytes
+	 */
+	uint8_t option_type[ 4 ];
+
+	/* The data size
+	 * Consists of 4 bytes
+	 */
+	uint8_t data_size[ 4 ];
+};
+
+typedef struct nbd_option_reply_header nbd_option_reply_header_t;
+
+struct nbd_option_reply_header
+{
+	/* The magic
+	 * Consists of 8 bytes
+	 */
+	uint8_t magic[ 8 ];
+
+	/* The option type
+	 * Consists of 4 bytes
+	 */
+	uint8_t option_type[ 4 ];
+
+	/* The reply type
+	 * Consists of 4 bytes
+	 */
+	uint8_t reply_type[ 4 ];
+
+	/* The data size
+	 * Consists of 4 bytes
+	 */
+	uint8_t data_size[ 4 ];
+};
+
+typedef struct nbd_request nbd_request_t;
+
+struct nbd_request
+{
+	/* The magic
+	 * Consists of 4 bytes
+	 */
+	uint8_t magic[ 4 ];
+
+	/* The command flags
+	 * Consists of 2 bytes
+	 */
+	uint8_t command_flags[ 2 ];
+
+	/* The command type
+	 * Consists of 2 bytes
+	 */
+	uint8_t command_type[ 2 ];
+
+	/* The cookie
+	 * Consists of 8 bytes
+	 */
+	uint8_t cookie[ 8 ];
+
+	/* The offset
+	 * Consists of 8 bytes
+	 */
+	uint8_t offset[ 8 ];
+
+	/* The size
+	 * Consists of 4 bytes
+	 */
+	uint8_t size[ 4 ];
+};
+
+typedef struct nbd_simple_reply nbd_simple_reply_t;
+
+struct nbd_simple_reply
+{
+	/* The magic
+	 * Consists of 4 bytes
+	 */
+	uint8_t magic[ 4 ];
+
+	/* The error
+	 * Consists of 4 bytes
+	 */
+	uint8_t error[ 4 ];
+
+	/* The cookie
+	 * Consists of 8 bytes
+	 */
+	uint8_t cookie[ 8 ];
+};
+
+typedef struct nbd_structured_reply_header nbd_structured_reply_header_t;
+
+struct nbd_structured_reply_header
+{
+	/* The magic
+	 * Consists of 4 bytes
+	 */
+	uint8_t magic[ 4 ];
+
+	/* The reply flags
+	 * Consists of 2 bytes
+	 */
+	uint8_t reply_flags[ 2 ];
+
+	/* The reply type
+	 * Consists of 2 bytes
+	 */
+	uint8_t reply_type[ 2 ];
+
+	/* The cookie
+	 * Consists of 8 bytes
+	 */
+	uint8_t cookie[ 8 ];
+
+	/* The data size
+	 * Consists of 4 bytes
+	 */
+	uint8_t data_size[ 4 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NBD_PROTOCOL_H ) */
+
@@ -0,0 +1,1294 @@
+/*
+ * QCOW version 2 image writer functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "qcow2_writer.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcfile.h"
+
+/* The QCOW file signature: "QFI\xfb"
+ */
+static const uint8_t qcow2_writer_file_signature[ 4 ] = {
+	'Q', 'F', 'I', 0xfb };
+
+/* The backing file format header extension, which prevents qemu from
+ * having to probe the format of the backing file
+ */
+static const uint8_t qcow2_writer_backing_file_format_extension[ 16 ] = {
+	0xe2, 0x79, 0x2a, 0xca, 0x00, 0x00, 0x00, 0x05,
+	'q', 'c', 'o', 'w', '2', 0x00, 0x00, 0x00 };
+
+/* Creates a QCOW version 2 image writer
+ * Make sure the value qcow2_writer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int qcow2_writer_initialize(
+     qcow2_writer_t **qcow2_writer,
+     libcerror_error_t **error )
+{
+	static char *function = "qcow2_writer_initialize";
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *qcow2_writer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid QCOW2 writer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*qcow2_writer = memory_allocate_structure(
+	                 qcow2_writer_t );
+
+	if( *qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create QCOW2 writer.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *qcow2_writer,
+	     0,
+	     sizeof( qcow2_writer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear QCOW2 writer.",
+		 function );
+
+		memory_free(
+		 *qcow2_writer );
+
+		*qcow2_writer = NULL;
+
+		return( -1 );
+	}
+	( *qcow2_writer )->cluster_size         = (size_t) 1 << QCOW2_WRITER_CLUSTER_BITS;
+	( *qcow2_writer )->number_of_l2_entries = (uint64_t) ( ( *qcow2_writer )->cluster_size / 8 );
+	( *qcow2_writer )->l2_table_index       = -1;
+	( *qcow2_writer )->last_media_offset    = -1;
+
+	return( 1 );
+
+on_error:
+	if( *qcow2_writer != NULL )
+	{
+		memory_free(
+		 *qcow2_writer );
+
+		*qcow2_writer = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a QCOW version 2 image writer
+ * Returns 1 if successful or -1 on error
+ */
+int qcow2_writer_free(
+     qcow2_writer_t **qcow2_writer,
+     libcerror_error_t **error )
+{
+	static char *function = "qcow2_writer_free";
+	int result            = 1;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *qcow2_writer != NULL )
+	{
+		if( ( *qcow2_writer )->file != NULL )
+		{
+			if( libcfile_file_free(
+			     &( ( *qcow2_writer )->file ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free file.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *qcow2_writer )->l1_table != NULL )
+		{
+			memory_free(
+			 ( *qcow2_writer )->l1_table );
+		}
+		if( ( *qcow2_writer )->l2_table != NULL )
+		{
+			memory_free(
+			 ( *qcow2_writer )->l2_table );
+		}
+		if( ( *qcow2_writer )->backing_file_name != NULL )
+		{
+			memory_free(
+			 ( *qcow2_writer )->backing_file_name );
+		}
+		if( ( *qcow2_writer )->cluster_buffer != NULL )
+		{
+			memory_free(
+			 ( *qcow2_writer )->cluster_buffer );
+		}
+		memory_free(
+		 *qcow2_writer );
+
+		*qcow2_writer = NULL;
+	}
+	return( result );
+}
+
+/* Opens a QCOW version 2 image for writing
+ * The backing file name is an UTF-8 string, which is stored in the image as-is,
+ * where a relative name is relative to the directory of the image
+ * Returns 1 if successful or -1 on error
+ */
+int qcow2_writer_open(
+     qcow2_writer_t *qcow2_writer,
+     const system_character_t *filename,
+     size64_t media_size,
+     const uint8_t *backing_file_name,
+     size_t backing_file_name_size,
+     libcerror_error_t **error )
+{
+	static char *function         = "qcow2_writer_open";
+	size64_t l2_table_media_size  = 0;
+	size_t l1_table_size          = 0;
+	uint64_t number_of_l1_entries = 0;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( qcow2_writer->file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid QCOW2 writer - file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( media_size == 0 )
+	 || ( media_size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( backing_file_name != NULL )
+	{
+		if( ( backing_file_name_size <= 1 )
+		 || ( backing_file_name_size > ( QCOW2_WRITER_MAXIMUM_BACKING_FILE_NAME_SIZE + 1 ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid backing file name size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	l2_table_media_size  = (size64_t) qcow2_writer->cluster_size * qcow2_writer->number_of_l2_entries;
+	number_of_l1_entries = media_size / l2_table_media_size;
+
+	if( ( media_size % l2_table_media_size ) != 0 )
+	{
+		number_of_l1_entries += 1;
+	}
+	if( number_of_l1_entries > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint64_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of L1 entries value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	l1_table_size = (size_t) number_of_l1_entries * sizeof( uint64_t );
+
+	qcow2_writer->l1_table = (uint64_t *) memory_allocate(
+	                                       l1_table_size );
+
+	if( qcow2_writer->l1_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create L1 table.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     qcow2_writer->l1_table,
+	     0,
+	     l1_table_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear L1 table.",
+		 function );
+
+		goto on_error;
+	}
+	qcow2_writer->l2_table = (uint64_t *) memory_allocate(
+	                                       qcow2_writer->cluster_size );
+
+	if( qcow2_writer->l2_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create L2 table.",
+		 function );
+
+		goto on_error;
+	}
+	qcow2_writer->cluster_buffer = (uint8_t *) memory_allocate(
+	                                            qcow2_writer->cluster_size );
+
+	if( qcow2_writer->cluster_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create cluster buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( backing_file_name != NULL )
+	{
+		qcow2_writer->backing_file_name = (uint8_t *) memory_allocate(
+		                                               backing_file_name_size );
+
+		if( qcow2_writer->backing_file_name == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create backing file name.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     qcow2_writer->backing_file_name,
+		     backing_file_name,
+		     backing_file_name_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy backing file name.",
+			 function );
+
+			goto on_error;
+		}
+		qcow2_writer->backing_file_name_size = backing_file_name_size;
+	}
+	if( libcfile_file_initialize(
+	     &( qcow2_writer->file ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     qcow2_writer->file,
+	     filename,
+	     LIBCFILE_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     qcow2_writer->file,
+	     filename,
+	     LIBCFILE_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	qcow2_writer->media_size           = media_size;
+	qcow2_writer->number_of_l1_entries = (uint32_t) number_of_l1_entries;
+
+	/* The file header is stored in the first cluster and the L1 table directly after it
+	 */
+	qcow2_writer->l1_table_offset     = (off64_t) qcow2_writer->cluster_size;
+	qcow2_writer->next_cluster_offset = qcow2_writer->l1_table_offset
+	                                  + (off64_t) ( ( ( l1_table_size + qcow2_writer->cluster_size - 1 ) / qcow2_writer->cluster_size ) * qcow2_writer->cluster_size );
+	qcow2_writer->l2_table_index      = -1;
+	qcow2_writer->last_media_offset   = -1;
+
+	return( 1 );
+
+on_error:
+	if( qcow2_writer->file != NULL )
+	{
+		libcfile_file_free(
+		 &( qcow2_writer->file ),
+		 NULL );
+	}
+	if( qcow2_writer->backing_file_name != NULL )
+	{
+		memory_free(
+		 qcow2_writer->backing_file_name );
+
+		qcow2_writer->backing_file_name = NULL;
+	}
+	qcow2_writer->backing_file_name_size = 0;
+
+	if( qcow2_writer->cluster_buffer != NULL )
+	{
+		memory_free(
+		 qcow2_writer->cluster_buffer );
+
+		qcow2_writer->cluster_buffer = NULL;
+	}
+	if( qcow2_writer->l2_table != NULL )
+	{
+		memory_free(
+		 qcow2_writer->l2_table );
+
+		qcow2_writer->l2_table = NULL;
+	}
+	if( qcow2_writer->l1_table != NULL )
+	{
+		memory_free(
+		 qcow2_writer->l1_table );
+
+		qcow2_writer->l1_table = NULL;
+	}
+	return( -1 );
+}
+
+/* Closes a QCOW version 2 image
+ * Writes the remaining L2 table, the L1 table, the reference counts and the file header
+ * Returns 0 if successful or -1 on error
+ */
+int qcow2_writer_close(
+     qcow2_writer_t *qcow2_writer,
+     libcerror_error_t **error )
+{
+	static char *function                             = "qcow2_writer_close";
+	off64_t reference_count_table_offset              = 0;
+	off64_t table_offset                              = 0;
+	uint32_t entry_index                              = 0;
+	uint32_t number_of_reference_count_table_clusters = 0;
+	size_t buffer_offset                              = 0;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( qcow2_writer->file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid QCOW2 writer - missing file.",
+		 function );
+
+		return( -1 );
+	}
+	if( qcow2_writer_flush_l2_table(
+	     qcow2_writer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush L2 table.",
+		 function );
+
+		goto on_error;
+	}
+	/* The L1 table is written one cluster at a time
+	 */
+	table_offset = qcow2_writer->l1_table_offset;
+
+	while( entry_index < qcow2_writer->number_of_l1_entries )
+	{
+		if( memory_set(
+		     qcow2_writer->cluster_buffer,
+		     0,
+		     qcow2_writer->cluster_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear cluster buffer.",
+			 function );
+
+			goto on_error;
+		}
+		for( buffer_offset = 0;
+		     buffer_offset < qcow2_writer->cluster_size;
+		     buffer_offset += 8 )
+		{
+			if( entry_index >= qcow2_writer->number_of_l1_entries )
+			{
+				break;
+			}
+			byte_stream_copy_from_uint64_big_endian(
+			 &( qcow2_writer->cluster_buffer[ buffer_offset ] ),
+			 qcow2_writer->l1_table[ entry_index ] );
+
+			entry_index++;
+		}
+		if( qcow2_writer_write_buffer_at_offset(
+		     qcow2_writer,
+		     qcow2_writer->cluster_buffer,
+		     qcow2_writer->cluster_size,
+		     table_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write L1 table.",
+			 function );
+
+			goto on_error;
+		}
+		table_offset += (off64_t) qcow2_writer->cluster_size;
+	}
+	if( qcow2_writer_write_reference_counts(
+	     qcow2_writer,
+	     &reference_count_table_offset,
+	     &number_of_reference_count_table_clusters,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reference counts.",
+		 function );
+
+		goto on_error;
+	}
+	/* The file header is written last so that an incomplete image is not recognized as valid
+	 */
+	if( qcow2_writer_write_file_header(
+	     qcow2_writer,
+	     reference_count_table_offset,
+	     number_of_reference_count_table_clusters,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_close(
+	     qcow2_writer->file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &( qcow2_writer->file ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 0 );
+
+on_error:
+	if( qcow2_writer->file != NULL )
+	{
+		libcfile_file_close(
+		 qcow2_writer->file,
+		 NULL );
+		libcfile_file_free(
+		 &( qcow2_writer->file ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes a buffer at a specific offset in the file
+ * Returns 1 if successful or -1 on error
+ */
+int qcow2_writer_write_buffer_at_offset(
+     qcow2_writer_t *qcow2_writer,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     off64_t file_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "qcow2_writer_write_buffer_at_offset";
+	ssize_t write_count   = 0;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_seek_offset(
+	     qcow2_writer->file,
+	     file_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	write_count = libcfile_file_write_buffer(
+	               qcow2_writer->file,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count != (ssize_t) buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes the current L2 table, if any
+ * Returns 1 if successful or -1 on error
+ */
+int qcow2_writer_flush_l2_table(
+     qcow2_writer_t *qcow2_writer,
+     libcerror_error_t **error )
+{
+	static char *function = "qcow2_writer_flush_l2_table";
+	uint64_t entry_index  = 0;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( qcow2_writer->l2_table_index == -1 )
+	{
+		return( 1 );
+	}
+	for( entry_index = 0;
+	     entry_index < qcow2_writer->number_of_l2_entries;
+	     entry_index++ )
+	{
+		byte_stream_copy_from_uint64_big_endian(
+		 &( qcow2_writer->cluster_buffer[ entry_index * 8 ] ),
+		 qcow2_writer->l2_table[ entry_index ] );
+	}
+	if( qcow2_writer_write_buffer_at_offset(
+	     qcow2_writer,
+	     qcow2_writer->cluster_buffer,
+	     qcow2_writer->cluster_size,
+	     qcow2_writer->l2_table_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write L2 table: %" PRIi64 ".",
+		 function,
+		 qcow2_writer->l2_table_index );
+
+		return( -1 );
+	}
+	qcow2_writer->l2_table_index = -1;
+
+	return( 1 );
+}
+
+/* Writes a cluster
+ * The media offset must be a multiple of the cluster size and larger than
+ * that of the previous cluster written. A data size smaller than the cluster
+ * size is padded with zero bytes. If data is NULL the cluster is marked to
+ * read as zeros, without storing data and without reading the backing file
+ * Returns 1 if successful or -1 on error
+ */
+int qcow2_writer_write_cluster(
+     qcow2_writer_t *qcow2_writer,
+     off64_t media_offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *cluster_data = NULL;
+	static char *function       = "qcow2_writer_write_cluster";
+	uint64_t cluster_index      = 0;
+	uint64_t entry_index        = 0;
+	int64_t l2_table_index      = 0;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( qcow2_writer->file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid QCOW2 writer - missing file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( media_offset < 0 )
+	 || ( (size64_t) media_offset >= qcow2_writer->media_size )
+	 || ( ( media_offset % (off64_t) qcow2_writer->cluster_size ) != 0 )
+	 || ( media_offset <= qcow2_writer->last_media_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > qcow2_writer->cluster_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	cluster_index  = (uint64_t) media_offset / qcow2_writer->cluster_size;
+	l2_table_index = (int64_t) ( cluster_index / qcow2_writer->number_of_l2_entries );
+	entry_index    = cluster_index % qcow2_writer->number_of_l2_entries;
+
+	if( l2_table_index != qcow2_writer->l2_table_index )
+	{
+		if( qcow2_writer_flush_l2_table(
+		     qcow2_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush L2 table.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     qcow2_writer->l2_table,
+		     0,
+		     qcow2_writer->cluster_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear L2 table.",
+			 function );
+
+			return( -1 );
+		}
+		qcow2_writer->l2_table_index       = l2_table_index;
+		qcow2_writer->l2_table_offset      = qcow2_writer->next_cluster_offset;
+		qcow2_writer->next_cluster_offset += (off64_t) qcow2_writer->cluster_size;
+
+		qcow2_writer->l1_table[ l2_table_index ] = (uint64_t) qcow2_writer->l2_table_offset | QCOW2_WRITER_FLAG_COPIED;
+	}
+	if( data == NULL )
+	{
+		qcow2_writer->l2_table[ entry_index ] = QCOW2_WRITER_FLAG_ZERO;
+	}
+	else
+	{
+		cluster_data = data;
+
+		if( data_size < qcow2_writer->cluster_size )
+		{
+			if( memory_copy(
+			     qcow2_writer->cluster_buffer,
+			     data,
+			     data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data to cluster buffer.",
+				 function );
+
+				return( -1 );
+			}
+			if( memory_set(
+			     &( qcow2_writer->cluster_buffer[ data_size ] ),
+			     0,
+			     qcow2_writer->cluster_size - data_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear cluster buffer.",
+				 function );
+
+				return( -1 );
+			}
+			cluster_data = qcow2_writer->cluster_buffer;
+		}
+		if( qcow2_writer_write_buffer_at_offset(
+		     qcow2_writer,
+		     cluster_data,
+		     qcow2_writer->cluster_size,
+		     qcow2_writer->next_cluster_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write cluster at media offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 media_offset,
+			 media_offset );
+
+			return( -1 );
+		}
+		qcow2_writer->l2_table[ entry_index ] = (uint64_t) qcow2_writer->next_cluster_offset | QCOW2_WRITER_FLAG_COPIED;
+
+		qcow2_writer->next_cluster_offset += (off64_t) qcow2_writer->cluster_size;
+	}
+	qcow2_writer->last_media_offset = media_offset;
+
+	return( 1 );
+}
+
+/* Writes the reference count table and blocks after the last cluster
+ * Every cluster in the image, including those of the reference count table
+ * and blocks, is referenced exactly once
+ * Returns 1 if successful or -1 on error
+ */
+int qcow2_writer_write_reference_counts(
+     qcow2_writer_t *qcow2_writer,
+     off64_t *reference_count_table_offset,
+     uint32_t *number_of_reference_count_table_clusters,
+     libcerror_error_t **error )
+{
+	static char *function                      = "qcow2_writer_write_reference_counts";
+	off64_t block_offset                       = 0;
+	off64_t blocks_offset                      = 0;
+	off64_t table_offset                       = 0;
+	size_t buffer_offset                       = 0;
+	uint64_t block_index                       = 0;
+	uint64_t cluster_index                     = 0;
+	uint64_t number_of_block_entries           = 0;
+	uint64_t number_of_blocks                  = 0;
+	uint64_t number_of_clusters                = 0;
+	uint64_t number_of_table_clusters          = 0;
+	uint64_t number_of_table_entries           = 0;
+	uint64_t number_of_used_clusters           = 0;
+	uint64_t previous_number_of_blocks         = 0;
+	uint64_t previous_number_of_table_clusters = 0;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( reference_count_table_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reference count table offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_reference_count_table_clusters == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of reference count table clusters.",
+		 function );
+
+		return( -1 );
+	}
+	/* The reference counts are 16-bit values
+	 */
+	number_of_block_entries = (uint64_t) ( qcow2_writer->cluster_size / 2 );
+	number_of_table_entries = (uint64_t) ( qcow2_writer->cluster_size / 8 );
+	number_of_used_clusters = (uint64_t) qcow2_writer->next_cluster_offset / qcow2_writer->cluster_size;
+
+	/* The reference count table and blocks need to account for themselves
+	 */
+	do
+	{
+		previous_number_of_blocks         = number_of_blocks;
+		previous_number_of_table_clusters = number_of_table_clusters;
+
+		number_of_clusters       = number_of_used_clusters + number_of_blocks + number_of_table_clusters;
+		number_of_blocks         = ( number_of_clusters + number_of_block_entries - 1 ) / number_of_block_entries;
+		number_of_table_clusters = ( number_of_blocks + number_of_table_entries - 1 ) / number_of_table_entries;
+	}
+	while( ( number_of_blocks != previous_number_of_blocks )
+	    || ( number_of_table_clusters != previous_number_of_table_clusters ) );
+
+	if( number_of_table_clusters > (uint64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of reference count table clusters value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_clusters = number_of_used_clusters + number_of_blocks + number_of_table_clusters;
+
+	table_offset  = qcow2_writer->next_cluster_offset;
+	blocks_offset = table_offset + (off64_t) ( number_of_table_clusters * qcow2_writer->cluster_size );
+
+	block_offset = table_offset;
+
+	while( block_index < number_of_blocks )
+	{
+		if( memory_set(
+		     qcow2_writer->cluster_buffer,
+		     0,
+		     qcow2_writer->cluster_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear cluster buffer.",
+			 function );
+
+			return( -1 );
+		}
+		for( buffer_offset = 0;
+		     buffer_offset < qcow2_writer->cluster_size;
+		     buffer_offset += 8 )
+		{
+			if( block_index >= number_of_blocks )
+			{
+				break;
+			}
+			byte_stream_copy_from_uint64_big_endian(
+			 &( qcow2_writer->cluster_buffer[ buffer_offset ] ),
+			 (uint64_t) blocks_offset + ( block_index * qcow2_writer->cluster_size ) );
+
+			block_index++;
+		}
+		if( qcow2_writer_write_buffer_at_offset(
+		     qcow2_writer,
+		     qcow2_writer->cluster_buffer,
+		     qcow2_writer->cluster_size,
+		     block_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reference count table.",
+			 function );
+
+			return( -1 );
+		}
+		block_offset += (off64_t) qcow2_writer->cluster_size;
+	}
+	block_offset = blocks_offset;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		if( memory_set(
+		     qcow2_writer->cluster_buffer,
+		     0,
+		     qcow2_writer->cluster_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear cluster buffer.",
+			 function );
+
+			return( -1 );
+		}
+		for( buffer_offset = 0;
+		     buffer_offset < qcow2_writer->cluster_size;
+		     buffer_offset += 2 )
+		{
+			if( cluster_index >= number_of_clusters )
+			{
+				break;
+			}
+			byte_stream_copy_from_uint16_big_endian(
+			 &( qcow2_writer->cluster_buffer[ buffer_offset ] ),
+			 1 );
+
+			cluster_index++;
+		}
+		if( qcow2_writer_write_buffer_at_offset(
+		     qcow2_writer,
+		     qcow2_writer->cluster_buffer,
+		     qcow2_writer->cluster_size,
+		     block_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reference count block: %" PRIu64 ".",
+			 function,
+			 block_index );
+
+			return( -1 );
+		}
+		block_offset += (off64_t) qcow2_writer->cluster_size;
+	}
+	qcow2_writer->next_cluster_offset = block_offset;
+
+	*reference_count_table_offset             = table_offset;
+	*number_of_reference_count_table_clusters = (uint32_t) number_of_table_clusters;
+
+	return( 1 );
+}
+
+/* Writes the file header, and the backing file name if set, in the first cluster
+ * Returns 1 if successful or -1 on error
+ */
+int qcow2_writer_write_file_header(
+     qcow2_writer_t *qcow2_writer,
+     off64_t reference_count_table_offset,
+     uint32_t number_of_reference_count_table_clusters,
+     libcerror_error_t **error )
+{
+	uint8_t *file_header       = NULL;
+	static char *function      = "qcow2_writer_write_file_header";
+	size_t backing_file_offset = 0;
+
+	if( qcow2_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid QCOW2 writer.",
+		 function );
+
+		return( -1 );
+	}
+	file_header = qcow2_writer->cluster_buffer;
+
+	if( memory_set(
+	     file_header,
+	     0,
+	     qcow2_writer->cluster_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     file_header,
+	     qcow2_writer_file_signature,
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( file_header[ 4 ] ),
+	 3 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( file_header[ 20 ] ),
+	 QCOW2_WRITER_CLUSTER_BITS );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( file_header[ 24 ] ),
+	 qcow2_writer->media_size );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( file_header[ 36 ] ),
+	 qcow2_writer->number_of_l1_entries );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( file_header[ 40 ] ),
+	 (uint64_t) qcow2_writer->l1_table_offset );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( file_header[ 48 ] ),
+	 (uint64_t) reference_count_table_offset );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( file_header[ 56 ] ),
+	 number_of_reference_count_table_clusters );
+
+	/* The reference count order of 4 represents 16-bit reference counts
+	 */
+	byte_stream_copy_from_uint32_big_endian(
+	 &( file_header[ 96 ] ),
+	 4 );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( file_header[ 100 ] ),
+	 QCOW2_WRITER_FILE_HEADER_SIZE );
+
+	if( qcow2_writer->backing_file_name != NULL )
+	{
+		if( memory_copy(
+		     &( file_header[ QCOW2_WRITER_FILE_HEADER_SIZE ] ),
+		     qcow2_writer_backing_file_format_extension,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy backing file format extension.",
+			 function );
+
+			return( -1 );
+		}
+		/* The header extensions are terminated by an end of extensions marker of 8 bytes
+		 */
+		backing_file_offset = QCOW2_WRITER_FILE_HEADER_SIZE + 16 + 8;
+
+		if( memory_copy(
+		     &( file_header[ backing_file_offset ] ),
+		     qcow2_writer->backing_file_name,
+		     qcow2_writer->backing_file_name_size - 1 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy backing file name.",
+			 function );
+
+			return( -1 );
+		}
+		byte_stream_copy_from_uint64_big_endian(
+		 &( file_header[ 8 ] ),
+		 (uint64_t) backing_file_offset );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( file_header[ 16 ] ),
+		 (uint32_t) ( qcow2_writer->backing_file_name_size - 1 ) );
+	}
+	if( qcow2_writer_write_buffer_at_offset(
+	     qcow2_writer,
+	     file_header,
+	     qcow2_writer->cluster_size,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
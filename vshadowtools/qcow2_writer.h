@@ -0,0 +1,179 @@
+/*
+ * QCOW version 2 image writer functions
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _QCOW2_WRITER_H )
+#define _QCOW2_WRITER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcfile.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of bits of the cluster size, 64 KiB is the default of qemu-img
+ */
+#define QCOW2_WRITER_CLUSTER_BITS		16
+
+/* The size of the file header of format version 3
+ */
+#define QCOW2_WRITER_FILE_HEADER_SIZE		104
+
+/* The maximum size of the backing file name supported by qemu
+ */
+#define QCOW2_WRITER_MAXIMUM_BACKING_FILE_NAME_SIZE	1023
+
+/* The flag of a L1 or L2 table entry that indicates the reference count is 1
+ */
+#define QCOW2_WRITER_FLAG_COPIED		0x8000000000000000ULL
+
+/* The flag of a L2 table entry that indicates the cluster reads as zeros
+ */
+#define QCOW2_WRITER_FLAG_ZERO			0x0000000000000001ULL
+
+typedef struct qcow2_writer qcow2_writer_t;
+
+/* Writes a QCOW version 2 image, of format version 3, in a single pass
+ * Clusters are written in ascending order and appended to the file,
+ * the tables and the file header are written when the image is closed
+ */
+struct qcow2_writer
+{
+	/* The output file
+	 */
+	libcfile_file_t *file;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The cluster size
+	 */
+	size_t cluster_size;
+
+	/* The number of entries in a L2 table
+	 */
+	uint64_t number_of_l2_entries;
+
+	/* The L1 table
+	 */
+	uint64_t *l1_table;
+
+	/* The number of entries in the L1 table
+	 */
+	uint32_t number_of_l1_entries;
+
+	/* The offset of the L1 table
+	 */
+	off64_t l1_table_offset;
+
+	/* The current L2 table
+	 */
+	uint64_t *l2_table;
+
+	/* The index of the current L2 table in the L1 table, -1 if not set
+	 */
+	int64_t l2_table_index;
+
+	/* The offset of the current L2 table
+	 */
+	off64_t l2_table_offset;
+
+	/* The offset of the next cluster that can be written
+	 */
+	off64_t next_cluster_offset;
+
+	/* The offset in the media of the last cluster written, -1 if not set
+	 */
+	off64_t last_media_offset;
+
+	/* The backing file name
+	 */
+	uint8_t *backing_file_name;
+
+	/* The backing file name size
+	 */
+	size_t backing_file_name_size;
+
+	/* The cluster buffer
+	 */
+	uint8_t *cluster_buffer;
+};
+
+int qcow2_writer_initialize(
+     qcow2_writer_t **qcow2_writer,
+     libcerror_error_t **error );
+
+int qcow2_writer_free(
+     qcow2_writer_t **qcow2_writer,
+     libcerror_error_t **error );
+
+int qcow2_writer_open(
+     qcow2_writer_t *qcow2_writer,
+     const system_character_t *filename,
+     size64_t media_size,
+     const uint8_t *backing_file_name,
+     size_t backing_file_name_size,
+     libcerror_error_t **error );
+
+int qcow2_writer_close(
+     qcow2_writer_t *qcow2_writer,
+     libcerror_error_t **error );
+
+int qcow2_writer_write_buffer_at_offset(
+     qcow2_writer_t *qcow2_writer,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     off64_t file_offset,
+     libcerror_error_t **error );
+
+int qcow2_writer_flush_l2_table(
+     qcow2_writer_t *qcow2_writer,
+     libcerror_error_t **error );
+
+int qcow2_writer_write_cluster(
+     qcow2_writer_t *qcow2_writer,
+     off64_t media_offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int qcow2_writer_write_reference_counts(
+     qcow2_writer_t *qcow2_writer,
+     off64_t *reference_count_table_offset,
+     uint32_t *number_of_reference_count_table_clusters,
+     libcerror_error_t **error );
+
+int qcow2_writer_write_file_header(
+     qcow2_writer_t *qcow2_writer,
+     off64_t reference_count_table_offset,
+     uint32_t number_of_reference_count_table_clusters,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _QCOW2_WRITER_H ) */
+
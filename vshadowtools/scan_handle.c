@@ -0,0 +1,603 @@
+/*
+ * Scan handle
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "scan_handle.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libvshadow.h"
+
+#define SCAN_HANDLE_NOTIFY_STREAM	stdout
+
+/* Retrieves a description of a record type
+ * Returns a string with the description
+ */
+const char *scan_handle_get_record_type_description(
+             uint32_t record_type )
+{
+	switch( record_type )
+	{
+		case LIBVSHADOW_RECORD_TYPE_VOLUME_HEADER:
+			return( "volume header" );
+
+		case LIBVSHADOW_RECORD_TYPE_CATALOG:
+			return( "catalog" );
+
+		case LIBVSHADOW_RECORD_TYPE_STORE_INDEX:
+			return( "store index" );
+
+		case LIBVSHADOW_RECORD_TYPE_STORE_HEADER:
+			return( "store header" );
+
+		case LIBVSHADOW_RECORD_TYPE_STORE_BLOCK_RANGE:
+			return( "store block range" );
+
+		case LIBVSHADOW_RECORD_TYPE_STORE_BITMAP:
+			return( "store bitmap" );
+
+		default:
+			break;
+	}
+	return( "unknown" );
+}
+
+/* Creates a scan handle
+ * Make sure the value scan_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int scan_handle_initialize(
+     scan_handle_t **scan_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "scan_handle_initialize";
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scan_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid scan handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*scan_handle = memory_allocate_structure(
+	                scan_handle_t );
+
+	if( *scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create scan handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *scan_handle,
+	     0,
+	     sizeof( scan_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear scan handle.",
+		 function );
+
+		memory_free(
+		 *scan_handle );
+
+		*scan_handle = NULL;
+
+		return( -1 );
+	}
+	if( libvshadow_scanner_initialize(
+	     &( ( *scan_handle )->scanner ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize scanner.",
+		 function );
+
+		goto on_error;
+	}
+	( *scan_handle )->notify_stream = SCAN_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *scan_handle != NULL )
+	{
+		memory_free(
+		 *scan_handle );
+
+		*scan_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a scan handle
+ * Returns 1 if successful or -1 on error
+ */
+int scan_handle_free(
+     scan_handle_t **scan_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "scan_handle_free";
+	int result            = 1;
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *scan_handle != NULL )
+	{
+		if( libvshadow_scanner_free(
+		     &( ( *scan_handle )->scanner ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free scanner.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *scan_handle )->volumes != NULL )
+		{
+			memory_free(
+			 ( *scan_handle )->volumes );
+		}
+		memory_free(
+		 *scan_handle );
+
+		*scan_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the scan handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int scan_handle_signal_abort(
+     scan_handle_t *scan_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "scan_handle_signal_abort";
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+	scan_handle->abort = 1;
+
+	if( scan_handle->scanner != NULL )
+	{
+		if( libvshadow_scanner_signal_abort(
+		     scan_handle->scanner,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal scanner to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Scans a file or device for records
+ * Returns 1 if successful or -1 on error
+ */
+int scan_handle_scan(
+     scan_handle_t *scan_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "scan_handle_scan";
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvshadow_scanner_scan_file_wide(
+	     scan_handle->scanner,
+	     filename,
+	     error ) != 1 )
+#else
+	if( libvshadow_scanner_scan_file(
+	     scan_handle->scanner,
+	     filename,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to scan file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the volume with a specific offset, the volume is added if not found
+ * Returns 1 if successful or -1 on error
+ */
+int scan_handle_get_volume(
+     scan_handle_t *scan_handle,
+     off64_t volume_offset,
+     scan_volume_t **volume,
+     libcerror_error_t **error )
+{
+	scan_volume_t *volumes          = NULL;
+	static char *function           = "scan_handle_get_volume";
+	size_t volumes_size             = 0;
+	int number_of_allocated_volumes = 0;
+	int volume_index                = 0;
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	/* The number of distinct volumes in an image is small
+	 */
+	for( volume_index = 0;
+	     volume_index < scan_handle->number_of_volumes;
+	     volume_index++ )
+	{
+		if( scan_handle->volumes[ volume_index ].offset == volume_offset )
+		{
+			*volume = &( scan_handle->volumes[ volume_index ] );
+
+			return( 1 );
+		}
+	}
+	if( scan_handle->number_of_volumes >= scan_handle->number_of_allocated_volumes )
+	{
+		if( scan_handle->number_of_allocated_volumes == 0 )
+		{
+			number_of_allocated_volumes = 16;
+		}
+		else
+		{
+			if( scan_handle->number_of_allocated_volumes > ( INT_MAX / 2 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid number of allocated volumes value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			number_of_allocated_volumes = scan_handle->number_of_allocated_volumes * 2;
+		}
+		volumes_size = sizeof( scan_volume_t ) * number_of_allocated_volumes;
+
+		volumes = (scan_volume_t *) memory_reallocate(
+		                             scan_handle->volumes,
+		                             volumes_size );
+
+		if( volumes == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize volumes.",
+			 function );
+
+			return( -1 );
+		}
+		scan_handle->volumes                     = volumes;
+		scan_handle->number_of_allocated_volumes = number_of_allocated_volumes;
+	}
+	*volume = &( scan_handle->volumes[ scan_handle->number_of_volumes ] );
+
+	if( memory_set(
+	     *volume,
+	     0,
+	     sizeof( scan_volume_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear volume.",
+		 function );
+
+		*volume = NULL;
+
+		return( -1 );
+	}
+	( *volume )->offset = volume_offset;
+
+	scan_handle->number_of_volumes += 1;
+
+	return( 1 );
+}
+
+/* Prints the records found by the scanner
+ * Returns 1 if successful or -1 on error
+ */
+int scan_handle_records_fprint(
+     scan_handle_t *scan_handle,
+     libcerror_error_t **error )
+{
+	scan_volume_t *volume = NULL;
+	static char *function = "scan_handle_records_fprint";
+	off64_t record_offset = 0;
+	off64_t volume_offset = 0;
+	uint32_t record_type  = 0;
+	int number_of_results = 0;
+	int result_index      = 0;
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvshadow_scanner_get_number_of_results(
+	     scan_handle->scanner,
+	     &number_of_results,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of results.",
+		 function );
+
+		return( -1 );
+	}
+	scan_handle->number_of_volumes = 0;
+
+	fprintf(
+	 scan_handle->notify_stream,
+	 "Volume Shadow Snapshot scan:\n" );
+
+	fprintf(
+	 scan_handle->notify_stream,
+	 "\tNumber of records:\t%d\n",
+	 number_of_results );
+
+	fprintf(
+	 scan_handle->notify_stream,
+	 "\n" );
+
+	for( result_index = 0;
+	     result_index < number_of_results;
+	     result_index++ )
+	{
+		if( scan_handle->abort != 0 )
+		{
+			break;
+		}
+		if( libvshadow_scanner_get_result_by_index(
+		     scan_handle->scanner,
+		     result_index,
+		     &record_offset,
+		     &record_type,
+		     &volume_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve result: %d.",
+			 function,
+			 result_index );
+
+			return( -1 );
+		}
+		if( scan_handle_get_volume(
+		     scan_handle,
+		     volume_offset,
+		     &volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve volume of result: %d.",
+			 function,
+			 result_index );
+
+			return( -1 );
+		}
+		if( ( record_type >= LIBVSHADOW_RECORD_TYPE_VOLUME_HEADER )
+		 && ( record_type <= LIBVSHADOW_RECORD_TYPE_STORE_BITMAP ) )
+		{
+			volume->number_of_records[ record_type ] += 1;
+		}
+		fprintf(
+		 scan_handle->notify_stream,
+		 "\t0x%08" PRIx64 "\t: %-18s",
+		 record_offset,
+		 scan_handle_get_record_type_description(
+		  record_type ) );
+
+		if( volume_offset == -1 )
+		{
+			fprintf(
+			 scan_handle->notify_stream,
+			 "volume at offset: unknown\n" );
+		}
+		else
+		{
+			fprintf(
+			 scan_handle->notify_stream,
+			 "volume at offset: 0x%08" PRIx64 "\n",
+			 volume_offset );
+		}
+	}
+	fprintf(
+	 scan_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
+/* Prints the number of records per volume
+ * Returns 1 if successful or -1 on error
+ */
+int scan_handle_volumes_fprint(
+     scan_handle_t *scan_handle,
+     libcerror_error_t **error )
+{
+	scan_volume_t *volume = NULL;
+	static char *function = "scan_handle_volumes_fprint";
+	uint32_t record_type  = 0;
+	int volume_index      = 0;
+
+	if( scan_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid scan handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( volume_index = 0;
+	     volume_index < scan_handle->number_of_volumes;
+	     volume_index++ )
+	{
+		volume = &( scan_handle->volumes[ volume_index ] );
+
+		if( volume->offset == -1 )
+		{
+			fprintf(
+			 scan_handle->notify_stream,
+			 "Volume at offset: unknown\n" );
+		}
+		else
+		{
+			fprintf(
+			 scan_handle->notify_stream,
+			 "Volume at offset: 0x%08" PRIx64 "\n",
+			 volume->offset );
+		}
+		for( record_type = LIBVSHADOW_RECORD_TYPE_VOLUME_HEADER;
+		     record_type <= LIBVSHADOW_RECORD_TYPE_STORE_BITMAP;
+		     record_type++ )
+		{
+			if( volume->number_of_records[ record_type ] == 0 )
+			{
+				continue;
+			}
+			fprintf(
+			 scan_handle->notify_stream,
+			 "\tNumber of %s records:\t%d\n",
+			 scan_handle_get_record_type_description(
+			  record_type ),
+			 volume->number_of_records[ record_type ] );
+		}
+		fprintf(
+		 scan_handle->notify_stream,
+		 "\n" );
+	}
+	return( 1 );
+}
+
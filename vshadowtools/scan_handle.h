@@ -0,0 +1,119 @@
+/*
+ * Scan handle
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _SCAN_HANDLE_H )
+#define _SCAN_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libvshadow.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct scan_volume scan_volume_t;
+
+/* A volume that contains records found by the scanner
+ */
+struct scan_volume
+{
+	/* The offset of the volume, -1 if unknown
+	 */
+	off64_t offset;
+
+	/* The number of records per record type, where index 0 is unused
+	 */
+	int number_of_records[ 7 ];
+};
+
+typedef struct scan_handle scan_handle_t;
+
+struct scan_handle
+{
+	/* The scanner
+	 */
+	libvshadow_scanner_t *scanner;
+
+	/* The volumes
+	 */
+	scan_volume_t *volumes;
+
+	/* The number of volumes
+	 */
+	int number_of_volumes;
+
+	/* The number of allocated volumes
+	 */
+	int number_of_allocated_volumes;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+const char *scan_handle_get_record_type_description(
+             uint32_t record_type );
+
+int scan_handle_initialize(
+     scan_handle_t **scan_handle,
+     libcerror_error_t **error );
+
+int scan_handle_free(
+     scan_handle_t **scan_handle,
+     libcerror_error_t **error );
+
+int scan_handle_signal_abort(
+     scan_handle_t *scan_handle,
+     libcerror_error_t **error );
+
+int scan_handle_scan(
+     scan_handle_t *scan_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int scan_handle_get_volume(
+     scan_handle_t *scan_handle,
+     off64_t volume_offset,
+     scan_volume_t **volume,
+     libcerror_error_t **error );
+
+int scan_handle_records_fprint(
+     scan_handle_t *scan_handle,
+     libcerror_error_t **error );
+
+int scan_handle_volumes_fprint(
+     scan_handle_t *scan_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _SCAN_HANDLE_H ) */
+
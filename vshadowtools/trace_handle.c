@@ -0,0 +1,1377 @@
+/*
+ * Trace handle
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <time.h>
+
+#include "byte_size_string.h"
+#include "trace_handle.h"
+#include "trace_statistics.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcfile.h"
+
+#define TRACE_HANDLE_NOTIFY_STREAM	stdout
+
+/* The signature of the trace file
+ */
+const uint8_t trace_handle_signature[ 8 ] = {
+	'v', 's', 'h', 't', 'r', 'a', 'c', 'e' };
+
+/* Creates a trace handle
+ * Make sure the value trace_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int trace_handle_initialize(
+     trace_handle_t **trace_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "trace_handle_initialize";
+
+	if( trace_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *trace_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid trace handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*trace_handle = memory_allocate_structure(
+	                 trace_handle_t );
+
+	if( *trace_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create trace handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *trace_handle,
+	     0,
+	     sizeof( trace_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear trace handle.",
+		 function );
+
+		memory_free(
+		 *trace_handle );
+
+		*trace_handle = NULL;
+
+		return( -1 );
+	}
+	if( libcfile_file_initialize(
+	     &( ( *trace_handle )->trace_file ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize trace file.",
+		 function );
+
+		goto on_error;
+	}
+	( *trace_handle )->notify_stream = TRACE_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *trace_handle != NULL )
+	{
+		memory_free(
+		 *trace_handle );
+
+		*trace_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a trace handle
+ * Returns 1 if successful or -1 on error
+ */
+int trace_handle_free(
+     trace_handle_t **trace_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "trace_handle_free";
+	int result            = 1;
+
+	if( trace_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *trace_handle != NULL )
+	{
+		if( libcfile_file_free(
+		     &( ( *trace_handle )->trace_file ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free trace file.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *trace_handle )->records_data != NULL )
+		{
+			memory_free(
+			 ( *trace_handle )->records_data );
+		}
+		memory_free(
+		 *trace_handle );
+
+		*trace_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the trace handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int trace_handle_signal_abort(
+     trace_handle_t *trace_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "trace_handle_signal_abort";
+
+	if( trace_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace handle.",
+		 function );
+
+		return( -1 );
+	}
+	trace_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Opens a trace file
+ * Returns 1 if successful or -1 on error
+ */
+int trace_handle_open(
+     trace_handle_t *trace_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	uint8_t file_header_data[ TRACE_HANDLE_FILE_HEADER_SIZE ];
+
+	static char *function   = "trace_handle_open";
+	size64_t file_size      = 0;
+	ssize_t read_count      = 0;
+	uint32_t format_version = 0;
+	int file_is_open        = 0;
+
+	if( trace_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace_handle->records_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid trace handle - records data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     trace_handle->trace_file,
+	     filename,
+	     LIBCFILE_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     trace_handle->trace_file,
+	     filename,
+	     LIBCFILE_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open trace file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	file_is_open = 1;
+
+	if( libcfile_file_get_size(
+	     trace_handle->trace_file,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve trace file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_size < TRACE_HANDLE_FILE_HEADER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid trace file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libcfile_file_read_buffer(
+	              trace_handle->trace_file,
+	              file_header_data,
+	              TRACE_HANDLE_FILE_HEADER_SIZE,
+	              error );
+
+	if( read_count != (ssize_t) TRACE_HANDLE_FILE_HEADER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     file_header_data,
+	     trace_handle_signature,
+	     8 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported trace file signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( file_header_data[ 8 ] ),
+	 format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( file_header_data[ 12 ] ),
+	 trace_handle->record_size );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header_data[ 16 ] ),
+	 trace_handle->volume_size );
+
+	if( format_version != TRACE_HANDLE_FORMAT_VERSION )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 format_version );
+
+		goto on_error;
+	}
+	/* Newer versions of the format can add values to the end of a record
+	 */
+	if( ( trace_handle->record_size < TRACE_HANDLE_RECORD_SIZE )
+	 || ( trace_handle->record_size > ( MEMORY_MAXIMUM_ALLOCATION_SIZE / TRACE_HANDLE_NUMBER_OF_RECORDS_PER_READ ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid record size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	/* A trailing partial record is ignored, it can remain when tracing was interrupted
+	 */
+	trace_handle->number_of_records = ( file_size - TRACE_HANDLE_FILE_HEADER_SIZE ) / trace_handle->record_size;
+
+	trace_handle->records_data_size = (size_t) trace_handle->record_size * TRACE_HANDLE_NUMBER_OF_RECORDS_PER_READ;
+
+	trace_handle->records_data = (uint8_t *) memory_allocate(
+	                                          sizeof( uint8_t ) * trace_handle->records_data_size );
+
+	if( trace_handle->records_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create records data.",
+		 function );
+
+		goto on_error;
+	}
+	trace_handle->record_index           = 0;
+	trace_handle->records_data_offset    = 0;
+	trace_handle->records_data_fill_size = 0;
+
+	return( 1 );
+
+on_error:
+	if( file_is_open != 0 )
+	{
+		libcfile_file_close(
+		 trace_handle->trace_file,
+		 NULL );
+	}
+	trace_handle->records_data_size = 0;
+
+	return( -1 );
+}
+
+/* Closes the trace file
+ * Returns the 0 if succesful or -1 on error
+ */
+int trace_handle_close(
+     trace_handle_t *trace_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "trace_handle_close";
+
+	if( trace_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_close(
+	     trace_handle->trace_file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close trace file.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace_handle->records_data != NULL )
+	{
+		memory_free(
+		 trace_handle->records_data );
+
+		trace_handle->records_data = NULL;
+	}
+	trace_handle->records_data_size = 0;
+
+	return( 0 );
+}
+
+/* Retrieves a timestamp in number of nanoseconds
+ * Returns 1 if successful or -1 on error
+ */
+int trace_handle_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	struct timespec time_structure;
+
+#else
+	time_t current_time   = 0;
+#endif
+
+	static char *function = "trace_handle_get_timestamp";
+
+	if( timestamp == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid timestamp.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( frequency.QuadPart <= 0 )
+	 || ( QueryPerformanceCounter(
+	       &counter ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve performance counter.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) ( counter.QuadPart / frequency.QuadPart ) * 1000000000 )
+	           + ( (uint64_t) ( counter.QuadPart % frequency.QuadPart ) * 1000000000 / (uint64_t) frequency.QuadPart );
+
+#elif defined( HAVE_CLOCK_GETTIME )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_structure ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time structure.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = ( (uint64_t) time_structure.tv_sec * 1000000000 ) + (uint64_t) time_structure.tv_nsec;
+
+#else
+	current_time = time(
+	                NULL );
+
+	if( current_time == (time_t) -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve current time.",
+		 function );
+
+		return( -1 );
+	}
+	*timestamp = (uint64_t) current_time * 1000000000;
+
+#endif /* defined( WINAPI ) */
+
+	return( 1 );
+}
+
+/* Seeks the first record in the trace file
+ * Returns 1 if successful or -1 on error
+ */
+int trace_handle_seek_first_record(
+     trace_handle_t *trace_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "trace_handle_seek_first_record";
+
+	if( trace_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_seek_offset(
+	     trace_handle->trace_file,
+	     (off64_t) TRACE_HANDLE_FILE_HEADER_SIZE,
+	     SEEK_SET,
+	     error ) != (off64_t) TRACE_HANDLE_FILE_HEADER_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek first record.",
+		 function );
+
+		return( -1 );
+	}
+	trace_handle->record_index           = 0;
+	trace_handle->records_data_offset    = 0;
+	trace_handle->records_data_fill_size = 0;
+
+	return( 1 );
+}
+
+/* Retrieves the next record from the trace file
+ * Returns 1 if successful, 0 if no more records are available or -1 on error
+ */
+int trace_handle_get_next_record(
+     trace_handle_t *trace_handle,
+     trace_record_t *record,
+     libcerror_error_t **error )
+{
+	uint8_t *record_data       = NULL;
+	static char *function      = "trace_handle_get_next_record";
+	size_t read_size           = 0;
+	ssize_t read_count         = 0;
+	uint64_t number_of_records = 0;
+	uint64_t value_64bit       = 0;
+
+	if( trace_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace_handle->records_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid trace handle - missing records data.",
+		 function );
+
+		return( -1 );
+	}
+	if( record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace_handle->record_index >= trace_handle->number_of_records )
+	{
+		return( 0 );
+	}
+	if( trace_handle->records_data_offset >= trace_handle->records_data_fill_size )
+	{
+		number_of_records = trace_handle->number_of_records - trace_handle->record_index;
+
+		if( number_of_records > TRACE_HANDLE_NUMBER_OF_RECORDS_PER_READ )
+		{
+			number_of_records = TRACE_HANDLE_NUMBER_OF_RECORDS_PER_READ;
+		}
+		read_size = (size_t) number_of_records * trace_handle->record_size;
+
+		read_count = libcfile_file_read_buffer(
+		              trace_handle->trace_file,
+		              trace_handle->records_data,
+		              read_size,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read records data.",
+			 function );
+
+			return( -1 );
+		}
+		trace_handle->records_data_offset    = 0;
+		trace_handle->records_data_fill_size = read_size;
+	}
+	record_data = &( trace_handle->records_data[ trace_handle->records_data_offset ] );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 0 ] ),
+	 record->timestamp );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 8 ] ),
+	 value_64bit );
+
+	record->physical_offset = (off64_t) value_64bit;
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( record_data[ 16 ] ),
+	 value_64bit );
+
+	record->volume_offset = (off64_t) value_64bit;
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( record_data[ 24 ] ),
+	 record->size );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( record_data[ 28 ] ),
+	 record->latency );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 &( record_data[ 32 ] ),
+	 record->store_index );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 &( record_data[ 34 ] ),
+	 record->data_store_index );
+
+	record->read_type = record_data[ 36 ];
+	record->flags     = record_data[ 37 ];
+
+	trace_handle->records_data_offset += trace_handle->record_size;
+	trace_handle->record_index        += 1;
+
+	return( 1 );
+}
+
+/* Analyzes the records in the trace file and prints the results
+ * Returns 1 if successful or -1 on error
+ */
+int trace_handle_analyze(
+     trace_handle_t *trace_handle,
+     libcerror_error_t **error )
+{
+	system_character_t byte_size_string[ 16 ];
+
+	trace_record_t record;
+
+	trace_statistics_t *trace_statistics = NULL;
+	static char *function                = "trace_handle_analyze";
+	int result                           = 0;
+
+	if( trace_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace_statistics_initialize(
+	     &trace_statistics,
+	     trace_handle->number_of_records,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create trace statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( trace_handle_seek_first_record(
+	     trace_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek first record.",
+		 function );
+
+		goto on_error;
+	}
+	while( trace_handle->abort == 0 )
+	{
+		result = trace_handle_get_next_record(
+		          trace_handle,
+		          &record,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve record: %" PRIu64 ".",
+			 function,
+			 trace_handle->record_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( trace_statistics_append_record(
+		     trace_statistics,
+		     &record,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append record: %" PRIu64 " to statistics.",
+			 function,
+			 trace_handle->record_index - 1 );
+
+			goto on_error;
+		}
+	}
+	if( trace_handle->abort != 0 )
+	{
+		goto on_abort;
+	}
+	if( trace_statistics_finalize(
+	     trace_statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize trace statistics.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 trace_handle->notify_stream,
+	 "Volume Shadow Snapshot trace analysis:\n" );
+
+	result = byte_size_string_create(
+	          byte_size_string,
+	          16,
+	          trace_handle->volume_size,
+	          BYTE_SIZE_STRING_UNIT_MEBIBYTE,
+	          NULL );
+
+	if( result == 1 )
+	{
+		fprintf(
+		 trace_handle->notify_stream,
+		 "\tVolume size\t\t\t: %" PRIs_SYSTEM " (%" PRIu64 " bytes)\n",
+		 byte_size_string,
+		 trace_handle->volume_size );
+	}
+	else
+	{
+		fprintf(
+		 trace_handle->notify_stream,
+		 "\tVolume size\t\t\t: %" PRIu64 " bytes\n",
+		 trace_handle->volume_size );
+	}
+	fprintf(
+	 trace_handle->notify_stream,
+	 "\tNumber of reads\t\t\t: %" PRIu64 "\n",
+	 trace_handle->number_of_records );
+
+	if( trace_statistics_fprint(
+	     trace_statistics,
+	     trace_handle->notify_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print trace statistics.",
+		 function );
+
+		goto on_error;
+	}
+on_abort:
+	if( trace_statistics_free(
+	     &trace_statistics,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free trace statistics.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( trace_statistics != NULL )
+	{
+		trace_statistics_free(
+		 &trace_statistics,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Replays the reads in the trace file against an image
+ * The reads are issued back to back, the recorded timing between reads is not reproduced
+ * If create_sparse_image is set the image is (re)created as a sparse file of the volume size
+ * Returns 1 if successful or -1 on error
+ */
+int trace_handle_replay(
+     trace_handle_t *trace_handle,
+     const system_character_t *filename,
+     uint8_t create_sparse_image,
+     libcerror_error_t **error )
+{
+	trace_record_t record;
+
+	libcfile_file_t *image_file     = NULL;
+	uint8_t *buffer                 = NULL;
+	static char *function           = "trace_handle_replay";
+	size_t buffer_size              = 0;
+	ssize_t read_count              = 0;
+	uint64_t end_timestamp          = 0;
+	uint64_t latency                = 0;
+	uint64_t maximum_latency        = 0;
+	uint64_t number_of_bytes        = 0;
+	uint64_t number_of_reads        = 0;
+	uint64_t number_of_short_reads  = 0;
+	uint64_t read_timestamp         = 0;
+	uint64_t recorded_latency       = 0;
+	uint64_t replay_end_timestamp   = 0;
+	uint64_t replay_start_timestamp = 0;
+	uint64_t total_latency          = 0;
+	uint64_t total_recorded_latency = 0;
+	uint64_t value_64bit            = 0;
+	int image_file_is_open          = 0;
+	int result                      = 0;
+
+	if( trace_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcfile_file_initialize(
+	     &image_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize image file.",
+		 function );
+
+		goto on_error;
+	}
+	if( create_sparse_image != 0 )
+	{
+		/* Resizing an empty file does not allocate the data on file systems that support sparse files
+		 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcfile_file_open_wide(
+		     image_file,
+		     filename,
+		     LIBCFILE_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+#else
+		if( libcfile_file_open(
+		     image_file,
+		     filename,
+		     LIBCFILE_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to create image file: %" PRIs_SYSTEM ".",
+			 function,
+			 filename );
+
+			goto on_error;
+		}
+		image_file_is_open = 1;
+
+		if( libcfile_file_resize(
+		     image_file,
+		     trace_handle->volume_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to resize image file: %" PRIs_SYSTEM ".",
+			 function,
+			 filename );
+
+			goto on_error;
+		}
+		image_file_is_open = 0;
+
+		if( libcfile_file_close(
+		     image_file,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close image file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcfile_file_open_wide(
+	     image_file,
+	     filename,
+	     LIBCFILE_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libcfile_file_open(
+	     image_file,
+	     filename,
+	     LIBCFILE_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open image file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	image_file_is_open = 1;
+
+	if( trace_handle_seek_first_record(
+	     trace_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek first record.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 trace_handle->notify_stream,
+	 "Replaying: %" PRIu64 " reads against: %" PRIs_SYSTEM "\n",
+	 trace_handle->number_of_records,
+	 filename );
+
+	if( trace_handle_get_timestamp(
+	     &replay_start_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve start timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	while( trace_handle->abort == 0 )
+	{
+		result = trace_handle_get_next_record(
+		          trace_handle,
+		          &record,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve record: %" PRIu64 ".",
+			 function,
+			 trace_handle->record_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( ( record.physical_offset < 0 )
+		 || ( record.size == 0 ) )
+		{
+			continue;
+		}
+		if( (size_t) record.size > buffer_size )
+		{
+			if( (size_t) record.size > (size_t) MEMORY_MAXIMUM_ALLOCATION_SIZE )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+				 "%s: invalid record: %" PRIu64 " - size value exceeds maximum.",
+				 function,
+				 trace_handle->record_index - 1 );
+
+				goto on_error;
+			}
+			if( buffer != NULL )
+			{
+				memory_free(
+				 buffer );
+			}
+			buffer = (uint8_t *) memory_allocate(
+			                      sizeof( uint8_t ) * record.size );
+
+			if( buffer == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create buffer.",
+				 function );
+
+				buffer_size = 0;
+
+				goto on_error;
+			}
+			buffer_size = (size_t) record.size;
+		}
+		if( trace_handle_get_timestamp(
+		     &read_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve read timestamp.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcfile_file_seek_offset(
+		     image_file,
+		     record.physical_offset,
+		     SEEK_SET,
+		     error ) != record.physical_offset )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ") in image file.",
+			 function,
+			 record.physical_offset,
+			 record.physical_offset );
+
+			goto on_error;
+		}
+		read_count = libcfile_file_read_buffer(
+		              image_file,
+		              buffer,
+		              (size_t) record.size,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 " (0x%08" PRIx64 ") from image file.",
+			 function,
+			 record.physical_offset,
+			 record.physical_offset );
+
+			goto on_error;
+		}
+		if( trace_handle_get_timestamp(
+		     &end_timestamp,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve end timestamp.",
+			 function );
+
+			goto on_error;
+		}
+		/* The image is read beyond its end when it is smaller than the volume
+		 */
+		if( read_count != (ssize_t) record.size )
+		{
+			number_of_short_reads += 1;
+		}
+		latency          = end_timestamp - read_timestamp;
+		recorded_latency = record.latency;
+
+		if( latency > maximum_latency )
+		{
+			maximum_latency = latency;
+		}
+		total_latency          += latency;
+		total_recorded_latency += recorded_latency;
+		number_of_bytes        += (uint64_t) read_count;
+		number_of_reads        += 1;
+	}
+	if( trace_handle_get_timestamp(
+	     &replay_end_timestamp,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve end timestamp.",
+		 function );
+
+		goto on_error;
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+
+		buffer = NULL;
+	}
+	image_file_is_open = 0;
+
+	if( libcfile_file_close(
+	     image_file,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close image file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcfile_file_free(
+	     &image_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free image file.",
+		 function );
+
+		goto on_error;
+	}
+	if( trace_handle->abort != 0 )
+	{
+		return( 1 );
+	}
+	value_64bit = replay_end_timestamp - replay_start_timestamp;
+
+	fprintf(
+	 trace_handle->notify_stream,
+	 "\n" );
+
+	fprintf(
+	 trace_handle->notify_stream,
+	 "Replay:\n" );
+
+	fprintf(
+	 trace_handle->notify_stream,
+	 "\tNumber of reads\t\t\t: %" PRIu64 " (%" PRIu64 " bytes)\n",
+	 number_of_reads,
+	 number_of_bytes );
+
+	fprintf(
+	 trace_handle->notify_stream,
+	 "\tShort reads\t\t\t: %" PRIu64 "\n",
+	 number_of_short_reads );
+
+	fprintf(
+	 trace_handle->notify_stream,
+	 "\tElapsed time\t\t\t: %" PRIu64 ".%06" PRIu64 " seconds\n",
+	 value_64bit / 1000000000UL,
+	 ( value_64bit % 1000000000UL ) / 1000 );
+
+	/* The throughput is calculated in milliseconds to prevent the multiplication from overflowing
+	 */
+	value_64bit /= 1000000;
+
+	if( value_64bit > 0 )
+	{
+		fprintf(
+		 trace_handle->notify_stream,
+		 "\tThroughput\t\t\t: %" PRIu64 " bytes per second\n",
+		 ( number_of_bytes * 1000 ) / value_64bit );
+	}
+	if( number_of_reads > 0 )
+	{
+		fprintf(
+		 trace_handle->notify_stream,
+		 "\tAverage latency\t\t\t: " );
+
+		trace_statistics_nanoseconds_fprint(
+		 trace_handle->notify_stream,
+		 total_latency / number_of_reads );
+
+		fprintf(
+		 trace_handle->notify_stream,
+		 "\n\tAverage recorded latency\t: " );
+
+		trace_statistics_nanoseconds_fprint(
+		 trace_handle->notify_stream,
+		 total_recorded_latency / number_of_reads );
+
+		fprintf(
+		 trace_handle->notify_stream,
+		 "\n\tMaximum latency\t\t\t: " );
+
+		trace_statistics_nanoseconds_fprint(
+		 trace_handle->notify_stream,
+		 maximum_latency );
+
+		fprintf(
+		 trace_handle->notify_stream,
+		 "\n" );
+	}
+	fprintf(
+	 trace_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( image_file_is_open != 0 )
+	{
+		libcfile_file_close(
+		 image_file,
+		 NULL );
+	}
+	if( image_file != NULL )
+	{
+		libcfile_file_free(
+		 &image_file,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,216 @@
+/*
+ * Trace handle
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _TRACE_HANDLE_H )
+#define _TRACE_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libcfile.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of the trace file header
+ */
+#define TRACE_HANDLE_FILE_HEADER_SIZE		32
+
+/* The (minimum) size of a trace record
+ */
+#define TRACE_HANDLE_RECORD_SIZE		40
+
+/* The supported format version of the trace file
+ */
+#define TRACE_HANDLE_FORMAT_VERSION		1
+
+/* The number of records that are read from the trace file in one go
+ */
+#define TRACE_HANDLE_NUMBER_OF_RECORDS_PER_READ	1024
+
+/* The size of the blocks used to determine the locality of the reads
+ */
+#define TRACE_HANDLE_BLOCK_SIZE			16384
+
+/* The store index that indicates the data was read from the current volume
+ */
+#define TRACE_HANDLE_STORE_INDEX_NONE		0xffff
+
+/* The number of seek distance classes
+ */
+#define TRACE_HANDLE_NUMBER_OF_SEEK_DISTANCE_CLASSES	6
+
+enum TRACE_READ_TYPES
+{
+	TRACE_READ_TYPE_STORE_DATA		= 1,
+	TRACE_READ_TYPE_STORE_METADATA		= 2
+};
+
+enum TRACE_RECORD_FLAGS
+{
+	TRACE_RECORD_FLAG_READ_FAILED		= 0x01
+};
+
+typedef struct trace_record trace_record_t;
+
+/* A read recorded in the trace file
+ */
+struct trace_record
+{
+	/* The number of nanoseconds since the start of the trace
+	 */
+	uint64_t timestamp;
+
+	/* The offset of the read relative to the start of the volume
+	 */
+	off64_t physical_offset;
+
+	/* The offset in the store that the read was resolved from
+	 */
+	off64_t volume_offset;
+
+	/* The size of the read
+	 */
+	uint32_t size;
+
+	/* The number of nanoseconds the read took
+	 */
+	uint32_t latency;
+
+	/* The index of the store that was read from
+	 */
+	uint16_t store_index;
+
+	/* The index of the store that contains the data
+	 */
+	uint16_t data_store_index;
+
+	/* The read type
+	 */
+	uint8_t read_type;
+
+	/* The flags
+	 */
+	uint8_t flags;
+};
+
+typedef struct trace_handle trace_handle_t;
+
+struct trace_handle
+{
+	/* The trace file
+	 */
+	libcfile_file_t *trace_file;
+
+	/* The volume size
+	 */
+	size64_t volume_size;
+
+	/* The record size
+	 */
+	uint32_t record_size;
+
+	/* The number of records
+	 */
+	uint64_t number_of_records;
+
+	/* The index of the next record
+	 */
+	uint64_t record_index;
+
+	/* The records data
+	 */
+	uint8_t *records_data;
+
+	/* The size of the records data
+	 */
+	size_t records_data_size;
+
+	/* The offset of the next record in the records data
+	 */
+	size_t records_data_offset;
+
+	/* The number of bytes of records in the records data
+	 */
+	size_t records_data_fill_size;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int trace_handle_initialize(
+     trace_handle_t **trace_handle,
+     libcerror_error_t **error );
+
+int trace_handle_free(
+     trace_handle_t **trace_handle,
+     libcerror_error_t **error );
+
+int trace_handle_signal_abort(
+     trace_handle_t *trace_handle,
+     libcerror_error_t **error );
+
+int trace_handle_open(
+     trace_handle_t *trace_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int trace_handle_close(
+     trace_handle_t *trace_handle,
+     libcerror_error_t **error );
+
+int trace_handle_get_timestamp(
+     uint64_t *timestamp,
+     libcerror_error_t **error );
+
+int trace_handle_seek_first_record(
+     trace_handle_t *trace_handle,
+     libcerror_error_t **error );
+
+int trace_handle_get_next_record(
+     trace_handle_t *trace_handle,
+     trace_record_t *record,
+     libcerror_error_t **error );
+
+int trace_handle_analyze(
+     trace_handle_t *trace_handle,
+     libcerror_error_t **error );
+
+int trace_handle_replay(
+     trace_handle_t *trace_handle,
+     const system_character_t *filename,
+     uint8_t create_sparse_image,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _TRACE_HANDLE_H ) */
+
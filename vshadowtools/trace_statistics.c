@@ -0,0 +1,850 @@
+/*
+ * Trace statistics
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "trace_handle.h"
+#include "trace_statistics.h"
+#include "vshadowtools_libcerror.h"
+
+/* Creates trace statistics
+ * Make sure the value trace_statistics is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int trace_statistics_initialize(
+     trace_statistics_t **trace_statistics,
+     uint64_t maximum_number_of_latencies,
+     libcerror_error_t **error )
+{
+	static char *function = "trace_statistics_initialize";
+
+	if( trace_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *trace_statistics != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid trace statistics value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_number_of_latencies > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / sizeof( uint32_t ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum number of latencies value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*trace_statistics = memory_allocate_structure(
+	                     trace_statistics_t );
+
+	if( *trace_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create trace statistics.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *trace_statistics,
+	     0,
+	     sizeof( trace_statistics_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear trace statistics.",
+		 function );
+
+		memory_free(
+		 *trace_statistics );
+
+		*trace_statistics = NULL;
+
+		return( -1 );
+	}
+	if( maximum_number_of_latencies > 0 )
+	{
+		( *trace_statistics )->latencies = (uint32_t *) memory_allocate(
+		                                                 sizeof( uint32_t ) * (size_t) maximum_number_of_latencies );
+
+		if( ( *trace_statistics )->latencies == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create latencies.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *trace_statistics )->maximum_number_of_latencies = maximum_number_of_latencies;
+
+	( *trace_statistics )->reads_per_store = (uint64_t *) memory_allocate(
+	                                                       sizeof( uint64_t ) * TRACE_STATISTICS_NUMBER_OF_STORE_INDEXES );
+
+	if( ( *trace_statistics )->reads_per_store == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create reads per store.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *trace_statistics )->reads_per_store,
+	     0,
+	     sizeof( uint64_t ) * TRACE_STATISTICS_NUMBER_OF_STORE_INDEXES ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear reads per store.",
+		 function );
+
+		goto on_error;
+	}
+	( *trace_statistics )->previous_end_offset = -1;
+
+	return( 1 );
+
+on_error:
+	if( *trace_statistics != NULL )
+	{
+		if( ( *trace_statistics )->reads_per_store != NULL )
+		{
+			memory_free(
+			 ( *trace_statistics )->reads_per_store );
+		}
+		if( ( *trace_statistics )->latencies != NULL )
+		{
+			memory_free(
+			 ( *trace_statistics )->latencies );
+		}
+		memory_free(
+		 *trace_statistics );
+
+		*trace_statistics = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees trace statistics
+ * Returns 1 if successful or -1 on error
+ */
+int trace_statistics_free(
+     trace_statistics_t **trace_statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "trace_statistics_free";
+
+	if( trace_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( *trace_statistics != NULL )
+	{
+		if( ( *trace_statistics )->reads_per_store != NULL )
+		{
+			memory_free(
+			 ( *trace_statistics )->reads_per_store );
+		}
+		if( ( *trace_statistics )->block_numbers != NULL )
+		{
+			memory_free(
+			 ( *trace_statistics )->block_numbers );
+		}
+		if( ( *trace_statistics )->latencies != NULL )
+		{
+			memory_free(
+			 ( *trace_statistics )->latencies );
+		}
+		memory_free(
+		 *trace_statistics );
+
+		*trace_statistics = NULL;
+	}
+	return( 1 );
+}
+
+/* Compares 2 block numbers
+ * Returns -1 if the first block number is less than the second, 0 if equal or 1 if greater
+ */
+int trace_statistics_compare_block_numbers(
+     const uint64_t *first_block_number,
+     const uint64_t *second_block_number )
+{
+	if( *first_block_number < *second_block_number )
+	{
+		return( -1 );
+	}
+	else if( *first_block_number > *second_block_number )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Compares 2 latencies
+ * Returns -1 if the first latency is less than the second, 0 if equal or 1 if greater
+ */
+int trace_statistics_compare_latencies(
+     const uint32_t *first_latency,
+     const uint32_t *second_latency )
+{
+	if( *first_latency < *second_latency )
+	{
+		return( -1 );
+	}
+	else if( *first_latency > *second_latency )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Appends the number of a block that was read
+ * Returns 1 if successful or -1 on error
+ */
+int trace_statistics_append_block_number(
+     trace_statistics_t *trace_statistics,
+     uint64_t block_number,
+     libcerror_error_t **error )
+{
+	uint64_t *block_numbers                    = NULL;
+	static char *function                      = "trace_statistics_append_block_number";
+	size_t block_numbers_size                  = 0;
+	uint64_t number_of_allocated_block_numbers = 0;
+
+	if( trace_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace_statistics->number_of_block_numbers >= trace_statistics->number_of_allocated_block_numbers )
+	{
+		if( trace_statistics->number_of_allocated_block_numbers == 0 )
+		{
+			number_of_allocated_block_numbers = 1024;
+		}
+		else
+		{
+			if( trace_statistics->number_of_allocated_block_numbers > (uint64_t) ( MEMORY_MAXIMUM_ALLOCATION_SIZE / ( sizeof( uint64_t ) * 2 ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid number of allocated block numbers value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			number_of_allocated_block_numbers = trace_statistics->number_of_allocated_block_numbers * 2;
+		}
+		block_numbers_size = sizeof( uint64_t ) * (size_t) number_of_allocated_block_numbers;
+
+		block_numbers = (uint64_t *) memory_reallocate(
+		                              trace_statistics->block_numbers,
+		                              block_numbers_size );
+
+		if( block_numbers == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize block numbers.",
+			 function );
+
+			return( -1 );
+		}
+		trace_statistics->block_numbers                     = block_numbers;
+		trace_statistics->number_of_allocated_block_numbers = number_of_allocated_block_numbers;
+	}
+	trace_statistics->block_numbers[ trace_statistics->number_of_block_numbers ] = block_number;
+
+	trace_statistics->number_of_block_numbers += 1;
+
+	return( 1 );
+}
+
+/* Appends a record
+ * Returns 1 if successful or -1 on error
+ */
+int trace_statistics_append_record(
+     trace_statistics_t *trace_statistics,
+     trace_record_t *record,
+     libcerror_error_t **error )
+{
+	static char *function  = "trace_statistics_append_record";
+	uint64_t block_number  = 0;
+	uint64_t first_block   = 0;
+	uint64_t last_block    = 0;
+	uint64_t seek_distance = 0;
+	uint8_t read_type      = 0;
+	int distance_class     = 0;
+
+	if( trace_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( record == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid record.",
+		 function );
+
+		return( -1 );
+	}
+	if( record->physical_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid record - physical offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace_statistics->number_of_latencies >= trace_statistics->maximum_number_of_latencies )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of latencies value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( record->read_type == TRACE_READ_TYPE_STORE_DATA )
+	 || ( record->read_type == TRACE_READ_TYPE_STORE_METADATA ) )
+	{
+		read_type = record->read_type;
+	}
+	trace_statistics->number_of_reads[ read_type ] += 1;
+	trace_statistics->number_of_bytes[ read_type ] += record->size;
+
+	if( ( record->read_type == TRACE_READ_TYPE_STORE_DATA )
+	 && ( record->data_store_index == TRACE_HANDLE_STORE_INDEX_NONE ) )
+	{
+		trace_statistics->number_of_current_volume_reads += 1;
+	}
+	if( ( record->flags & TRACE_RECORD_FLAG_READ_FAILED ) != 0 )
+	{
+		trace_statistics->number_of_failed_reads += 1;
+	}
+	if( record->timestamp > trace_statistics->duration )
+	{
+		trace_statistics->duration = record->timestamp;
+	}
+	trace_statistics->total_latency += record->latency;
+
+	trace_statistics->latencies[ trace_statistics->number_of_latencies ] = record->latency;
+
+	trace_statistics->number_of_latencies += 1;
+
+	/* The seek distance is the distance between the start of the read and the end of the previous read
+	 */
+	if( trace_statistics->previous_end_offset >= 0 )
+	{
+		if( record->physical_offset == trace_statistics->previous_end_offset )
+		{
+			trace_statistics->number_of_sequential_reads += 1;
+		}
+		else if( record->physical_offset > trace_statistics->previous_end_offset )
+		{
+			seek_distance = (uint64_t) ( record->physical_offset - trace_statistics->previous_end_offset );
+
+			trace_statistics->number_of_forward_seeks += 1;
+		}
+		else
+		{
+			seek_distance = (uint64_t) ( trace_statistics->previous_end_offset - record->physical_offset );
+
+			trace_statistics->number_of_backward_seeks += 1;
+		}
+		trace_statistics->total_seek_distance += seek_distance;
+
+		if( seek_distance == 0 )
+		{
+			distance_class = 0;
+		}
+		else if( seek_distance < 0x00010000UL )
+		{
+			distance_class = 1;
+		}
+		else if( seek_distance < 0x00100000UL )
+		{
+			distance_class = 2;
+		}
+		else if( seek_distance < 0x01000000UL )
+		{
+			distance_class = 3;
+		}
+		else if( seek_distance < 0x10000000UL )
+		{
+			distance_class = 4;
+		}
+		else
+		{
+			distance_class = 5;
+		}
+		trace_statistics->seek_distance_classes[ distance_class ] += 1;
+	}
+	trace_statistics->previous_end_offset = record->physical_offset + record->size;
+
+	trace_statistics->reads_per_store[ record->store_index ] += 1;
+
+	if( record->size > 0 )
+	{
+		first_block = (uint64_t) record->physical_offset / TRACE_HANDLE_BLOCK_SIZE;
+		last_block  = ( (uint64_t) record->physical_offset + record->size - 1 ) / TRACE_HANDLE_BLOCK_SIZE;
+
+		for( block_number = first_block;
+		     block_number <= last_block;
+		     block_number++ )
+		{
+			if( trace_statistics_append_block_number(
+			     trace_statistics,
+			     block_number,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append block number: %" PRIu64 ".",
+				 function,
+				 block_number );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Sorts the latencies and block numbers and determines the number of distinct blocks
+ * Returns 1 if successful or -1 on error
+ */
+int trace_statistics_finalize(
+     trace_statistics_t *trace_statistics,
+     libcerror_error_t **error )
+{
+	static char *function = "trace_statistics_finalize";
+	uint64_t block_index  = 0;
+
+	if( trace_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( trace_statistics->number_of_latencies > 1 )
+	{
+		qsort(
+		 trace_statistics->latencies,
+		 (size_t) trace_statistics->number_of_latencies,
+		 sizeof( uint32_t ),
+		 (int (*)(const void *, const void *)) &trace_statistics_compare_latencies );
+	}
+	if( trace_statistics->number_of_block_numbers > 1 )
+	{
+		qsort(
+		 trace_statistics->block_numbers,
+		 (size_t) trace_statistics->number_of_block_numbers,
+		 sizeof( uint64_t ),
+		 (int (*)(const void *, const void *)) &trace_statistics_compare_block_numbers );
+	}
+	trace_statistics->number_of_distinct_blocks = 0;
+
+	for( block_index = 0;
+	     block_index < trace_statistics->number_of_block_numbers;
+	     block_index++ )
+	{
+		if( ( block_index == 0 )
+		 || ( trace_statistics->block_numbers[ block_index ] != trace_statistics->block_numbers[ block_index - 1 ] ) )
+		{
+			trace_statistics->number_of_distinct_blocks += 1;
+		}
+	}
+	return( 1 );
+}
+
+/* Prints a value as a percentage of a total with 1 decimal
+ */
+void trace_statistics_percentage_fprint(
+      FILE *stream,
+      uint64_t value,
+      uint64_t total )
+{
+	uint64_t per_mille = 0;
+
+	if( total > 0 )
+	{
+		per_mille = ( value * 1000 ) / total;
+	}
+	fprintf(
+	 stream,
+	 "%" PRIu64 ".%" PRIu64 "%%",
+	 per_mille / 10,
+	 per_mille % 10 );
+}
+
+/* Prints a number of nanoseconds as microseconds with 3 decimals
+ */
+void trace_statistics_nanoseconds_fprint(
+      FILE *stream,
+      uint64_t nanoseconds )
+{
+	fprintf(
+	 stream,
+	 "%" PRIu64 ".%03" PRIu64 " us",
+	 nanoseconds / 1000,
+	 nanoseconds % 1000 );
+}
+
+/* Prints the trace statistics
+ * Returns 1 if successful or -1 on error
+ */
+int trace_statistics_fprint(
+     trace_statistics_t *trace_statistics,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	const char *seek_distance_class_descriptions[ TRACE_HANDLE_NUMBER_OF_SEEK_DISTANCE_CLASSES ] = {
+		"0 (sequential)",
+		"less than 64 KiB",
+		"less than 1 MiB",
+		"less than 16 MiB",
+		"less than 256 MiB",
+		"256 MiB or more" };
+
+	static char *function    = "trace_statistics_fprint";
+	uint64_t number_of_reads = 0;
+	uint64_t number_of_seeks = 0;
+	uint64_t value_64bit     = 0;
+	int distance_class       = 0;
+	int store_index          = 0;
+
+	if( trace_statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid trace statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_reads = trace_statistics->number_of_latencies;
+	number_of_seeks = trace_statistics->number_of_sequential_reads
+	                + trace_statistics->number_of_forward_seeks
+	                + trace_statistics->number_of_backward_seeks;
+
+	fprintf(
+	 stream,
+	 "\tDuration\t\t\t: %" PRIu64 ".%06" PRIu64 " seconds\n",
+	 trace_statistics->duration / 1000000000UL,
+	 ( trace_statistics->duration % 1000000000UL ) / 1000 );
+
+	fprintf(
+	 stream,
+	 "\tStore data reads\t\t: %" PRIu64 " (%" PRIu64 " bytes)\n",
+	 trace_statistics->number_of_reads[ TRACE_READ_TYPE_STORE_DATA ],
+	 trace_statistics->number_of_bytes[ TRACE_READ_TYPE_STORE_DATA ] );
+
+	fprintf(
+	 stream,
+	 "\tStore metadata reads\t\t: %" PRIu64 " (%" PRIu64 " bytes)\n",
+	 trace_statistics->number_of_reads[ TRACE_READ_TYPE_STORE_METADATA ],
+	 trace_statistics->number_of_bytes[ TRACE_READ_TYPE_STORE_METADATA ] );
+
+	if( trace_statistics->number_of_reads[ 0 ] > 0 )
+	{
+		fprintf(
+		 stream,
+		 "\tReads of unknown type\t\t: %" PRIu64 " (%" PRIu64 " bytes)\n",
+		 trace_statistics->number_of_reads[ 0 ],
+		 trace_statistics->number_of_bytes[ 0 ] );
+	}
+	fprintf(
+	 stream,
+	 "\tCurrent volume reads\t\t: %" PRIu64 "\n",
+	 trace_statistics->number_of_current_volume_reads );
+
+	fprintf(
+	 stream,
+	 "\tFailed reads\t\t\t: %" PRIu64 "\n",
+	 trace_statistics->number_of_failed_reads );
+
+	fprintf(
+	 stream,
+	 "\n" );
+
+	if( number_of_reads > 0 )
+	{
+		fprintf(
+		 stream,
+		 "Latency:\n" );
+
+		fprintf(
+		 stream,
+		 "\tAverage\t\t\t\t: " );
+
+		trace_statistics_nanoseconds_fprint(
+		 stream,
+		 trace_statistics->total_latency / number_of_reads );
+
+		fprintf(
+		 stream,
+		 "\n\tMedian\t\t\t\t: " );
+
+		trace_statistics_nanoseconds_fprint(
+		 stream,
+		 trace_statistics->latencies[ ( ( number_of_reads - 1 ) * 50 ) / 100 ] );
+
+		fprintf(
+		 stream,
+		 "\n\t99th percentile\t\t\t: " );
+
+		trace_statistics_nanoseconds_fprint(
+		 stream,
+		 trace_statistics->latencies[ ( ( number_of_reads - 1 ) * 99 ) / 100 ] );
+
+		fprintf(
+		 stream,
+		 "\n\tMaximum\t\t\t\t: " );
+
+		trace_statistics_nanoseconds_fprint(
+		 stream,
+		 trace_statistics->latencies[ number_of_reads - 1 ] );
+
+		fprintf(
+		 stream,
+		 "\n\n" );
+	}
+	if( number_of_seeks > 0 )
+	{
+		fprintf(
+		 stream,
+		 "Seek distance:\n" );
+
+		fprintf(
+		 stream,
+		 "\tSequential reads\t\t: %" PRIu64 " (",
+		 trace_statistics->number_of_sequential_reads );
+
+		trace_statistics_percentage_fprint(
+		 stream,
+		 trace_statistics->number_of_sequential_reads,
+		 number_of_seeks );
+
+		fprintf(
+		 stream,
+		 ")\n\tForward seeks\t\t\t: %" PRIu64 "\n",
+		 trace_statistics->number_of_forward_seeks );
+
+		fprintf(
+		 stream,
+		 "\tBackward seeks\t\t\t: %" PRIu64 "\n",
+		 trace_statistics->number_of_backward_seeks );
+
+		fprintf(
+		 stream,
+		 "\tAverage distance\t\t: %" PRIu64 " bytes\n",
+		 trace_statistics->total_seek_distance / number_of_seeks );
+
+		for( distance_class = 0;
+		     distance_class < TRACE_HANDLE_NUMBER_OF_SEEK_DISTANCE_CLASSES;
+		     distance_class++ )
+		{
+			fprintf(
+			 stream,
+			 "\t\t%-24s: %" PRIu64 " (",
+			 seek_distance_class_descriptions[ distance_class ],
+			 trace_statistics->seek_distance_classes[ distance_class ] );
+
+			trace_statistics_percentage_fprint(
+			 stream,
+			 trace_statistics->seek_distance_classes[ distance_class ],
+			 number_of_seeks );
+
+			fprintf(
+			 stream,
+			 ")\n" );
+		}
+		fprintf(
+		 stream,
+		 "\n" );
+	}
+	if( trace_statistics->number_of_block_numbers > 0 )
+	{
+		fprintf(
+		 stream,
+		 "Locality:\n" );
+
+		fprintf(
+		 stream,
+		 "\tBlock size\t\t\t: %d bytes\n",
+		 TRACE_HANDLE_BLOCK_SIZE );
+
+		fprintf(
+		 stream,
+		 "\tBlocks read\t\t\t: %" PRIu64 "\n",
+		 trace_statistics->number_of_block_numbers );
+
+		fprintf(
+		 stream,
+		 "\tDistinct blocks read\t\t: %" PRIu64 " (%" PRIu64 " bytes)\n",
+		 trace_statistics->number_of_distinct_blocks,
+		 trace_statistics->number_of_distinct_blocks * TRACE_HANDLE_BLOCK_SIZE );
+
+		value_64bit = trace_statistics->number_of_block_numbers - trace_statistics->number_of_distinct_blocks;
+
+		fprintf(
+		 stream,
+		 "\tRepeated block reads\t\t: %" PRIu64 " (",
+		 value_64bit );
+
+		trace_statistics_percentage_fprint(
+		 stream,
+		 value_64bit,
+		 trace_statistics->number_of_block_numbers );
+
+		fprintf(
+		 stream,
+		 ")\n\n" );
+	}
+	if( number_of_reads > 0 )
+	{
+		fprintf(
+		 stream,
+		 "Reads per store:\n" );
+
+		for( store_index = 0;
+		     store_index < (int) TRACE_STATISTICS_NUMBER_OF_STORE_INDEXES;
+		     store_index++ )
+		{
+			if( trace_statistics->reads_per_store[ store_index ] == 0 )
+			{
+				continue;
+			}
+			if( store_index == TRACE_HANDLE_STORE_INDEX_NONE )
+			{
+				fprintf(
+				 stream,
+				 "\tUnknown store\t\t\t: %" PRIu64 "\n",
+				 trace_statistics->reads_per_store[ store_index ] );
+			}
+			else
+			{
+				fprintf(
+				 stream,
+				 "\tStore: %d\t\t\t: %" PRIu64 "\n",
+				 store_index + 1,
+				 trace_statistics->reads_per_store[ store_index ] );
+			}
+		}
+		fprintf(
+		 stream,
+		 "\n" );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,175 @@
+/*
+ * Trace statistics
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _TRACE_STATISTICS_H )
+#define _TRACE_STATISTICS_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "trace_handle.h"
+#include "vshadowtools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of store indexes, including the index that indicates the current volume
+ */
+#define TRACE_STATISTICS_NUMBER_OF_STORE_INDEXES	0x00010000UL
+
+typedef struct trace_statistics trace_statistics_t;
+
+struct trace_statistics
+{
+	/* The number of reads per read type, where index 0 contains the reads of an unknown type
+	 */
+	uint64_t number_of_reads[ 3 ];
+
+	/* The number of bytes read per read type, where index 0 contains the reads of an unknown type
+	 */
+	uint64_t number_of_bytes[ 3 ];
+
+	/* The number of store data reads that were resolved to the current volume
+	 */
+	uint64_t number_of_current_volume_reads;
+
+	/* The number of failed reads
+	 */
+	uint64_t number_of_failed_reads;
+
+	/* The number of nanoseconds between the start of the trace and the start of the last read
+	 */
+	uint64_t duration;
+
+	/* The sum of the latencies
+	 */
+	uint64_t total_latency;
+
+	/* The latencies
+	 */
+	uint32_t *latencies;
+
+	/* The number of latencies
+	 */
+	uint64_t number_of_latencies;
+
+	/* The maximum number of latencies
+	 */
+	uint64_t maximum_number_of_latencies;
+
+	/* The end offset of the previous read
+	 */
+	off64_t previous_end_offset;
+
+	/* The number of reads that continued where the previous read ended
+	 */
+	uint64_t number_of_sequential_reads;
+
+	/* The number of reads after the end of the previous read
+	 */
+	uint64_t number_of_forward_seeks;
+
+	/* The number of reads before the end of the previous read
+	 */
+	uint64_t number_of_backward_seeks;
+
+	/* The sum of the seek distances
+	 */
+	uint64_t total_seek_distance;
+
+	/* The number of reads per seek distance class
+	 */
+	uint64_t seek_distance_classes[ TRACE_HANDLE_NUMBER_OF_SEEK_DISTANCE_CLASSES ];
+
+	/* The numbers of the blocks that were read
+	 */
+	uint64_t *block_numbers;
+
+	/* The number of block numbers
+	 */
+	uint64_t number_of_block_numbers;
+
+	/* The number of allocated block numbers
+	 */
+	uint64_t number_of_allocated_block_numbers;
+
+	/* The number of distinct blocks that were read
+	 */
+	uint64_t number_of_distinct_blocks;
+
+	/* The number of reads per store index
+	 */
+	uint64_t *reads_per_store;
+};
+
+int trace_statistics_initialize(
+     trace_statistics_t **trace_statistics,
+     uint64_t maximum_number_of_latencies,
+     libcerror_error_t **error );
+
+int trace_statistics_free(
+     trace_statistics_t **trace_statistics,
+     libcerror_error_t **error );
+
+int trace_statistics_compare_block_numbers(
+     const uint64_t *first_block_number,
+     const uint64_t *second_block_number );
+
+int trace_statistics_compare_latencies(
+     const uint32_t *first_latency,
+     const uint32_t *second_latency );
+
+int trace_statistics_append_block_number(
+     trace_statistics_t *trace_statistics,
+     uint64_t block_number,
+     libcerror_error_t **error );
+
+int trace_statistics_append_record(
+     trace_statistics_t *trace_statistics,
+     trace_record_t *record,
+     libcerror_error_t **error );
+
+int trace_statistics_finalize(
+     trace_statistics_t *trace_statistics,
+     libcerror_error_t **error );
+
+void trace_statistics_percentage_fprint(
+      FILE *stream,
+      uint64_t value,
+      uint64_t total );
+
+void trace_statistics_nanoseconds_fprint(
+      FILE *stream,
+      uint64_t nanoseconds );
+
+int trace_statistics_fprint(
+     trace_statistics_t *trace_statistics,
+     FILE *stream,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _TRACE_STATISTICS_H ) */
+
@@ -0,0 +1,496 @@
+/*
+ * Exports the stores in a Windows NT Volume Shadow Snapshot (VSS) volume.
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "export_handle.h"
+#include "vshadowtools_getopt.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libclocale.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_libvshadow.h"
+#include "vshadowtools_output.h"
+#include "vshadowtools_signal.h"
+#include "vshadowtools_unused.h"
+
+export_handle_t *vshadowexport_export_handle = NULL;
+int vshadowexport_abort                        = 0;
+
+/* Prints usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vshadowexport to export the stores in a Windows NT Volume Shadow\n"
+	                 "Snapshot (VSS) volume to raw or QCOW2 image files\n\n" );
+
+	fprintf( stream, "Usage: vshadowexport [ -f format ] [ -j threads ] [ -o offset ]\n"
+	                 "                     [ -s store_number ] [ -t target ] [ -hluvV ]\n"
+	                 "                     source\n\n" );
+
+	fprintf( stream, "\tsource: the source file or device\n\n" );
+
+	fprintf( stream, "\t-f:     specify the output format, options: raw or qcow2\n"
+	                 "\t        (default is raw), with qcow2 the stores are exported\n"
+	                 "\t        as a chain of images where every store is backed by\n"
+	                 "\t        the image of the next more recent store\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-j:     specify the number of worker threads that write the\n"
+	                 "\t        outputs, where 0 writes the outputs on the main thread\n"
+	                 "\t        (default is 4)\n" );
+	fprintf( stream, "\t-l:     with qcow2, also export the volume as the base image\n"
+	                 "\t        of the chain\n" );
+	fprintf( stream, "\t-o:     specify the volume offset in bytes\n" );
+	fprintf( stream, "\t-s:     specify the store number to export, options: all or\n"
+	                 "\t        a number starting at 1 (default is all), with qcow2\n"
+	                 "\t        the oldest store of the chain\n" );
+	fprintf( stream, "\t-t:     specify the target path prefix, the store number is\n"
+	                 "\t        appended to the prefix (default is vss)\n" );
+	fprintf( stream, "\t-u:     skip the data of clusters that are unallocated in the NTFS\n"
+	                 "\t        file system of a store, the data is left sparse in the\n"
+	                 "\t        output\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for vshadowexport
+ */
+void vshadowexport_signal_handler(
+      vshadowtools_signal_t signal VSHADOWTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vshadowexport_signal_handler";
+
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vshadowexport_abort = 1;
+
+	if( vshadowexport_export_handle != NULL )
+	{
+		if( export_handle_signal_abort(
+		     vshadowexport_export_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal export handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error                 = NULL;
+	system_character_t *option_format        = NULL;
+	system_character_t *option_store_number  = NULL;
+	system_character_t *option_target_path   = NULL;
+	system_character_t *option_threads       = NULL;
+	system_character_t *option_volume_offset = NULL;
+	system_character_t *source               = NULL;
+	char *program                            = "vshadowexport";
+	system_integer_t option                  = 0;
+	int result                               = 0;
+	int skip_unallocated                     = 0;
+	int use_volume_as_base                   = 0;
+	int verbose                              = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vshadowtools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vshadowtools_output_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vshadowtools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "f:hj:lo:s:t:uvV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'f':
+				option_format = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'j':
+				option_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'l':
+				use_volume_as_base = 1;
+
+				break;
+
+			case (system_integer_t) 'o':
+				option_volume_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_store_number = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_target_path = optarg;
+
+				break;
+
+			case (system_integer_t) 'u':
+				skip_unallocated = 1;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vshadowtools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file or device.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvshadow_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvshadow_notify_set_verbose(
+	 verbose );
+
+	if( export_handle_initialize(
+	     &vshadowexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize export handle.\n" );
+
+		goto on_error;
+	}
+	vshadowexport_export_handle->skip_unallocated   = skip_unallocated;
+	vshadowexport_export_handle->use_volume_as_base = use_volume_as_base;
+
+	if( option_format != NULL )
+	{
+		result = export_handle_set_format(
+		          vshadowexport_export_handle,
+		          option_format,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set format.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported format.\n" );
+
+			goto on_error;
+		}
+	}
+
+	if( option_volume_offset != NULL )
+	{
+		if( export_handle_set_volume_offset(
+		     vshadowexport_export_handle,
+		     option_volume_offset,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported volume offset defaulting to: %" PRIi64 ".\n",
+			 vshadowexport_export_handle->volume_offset );
+		}
+	}
+	if( option_store_number != NULL )
+	{
+		if( export_handle_set_store_index(
+		     vshadowexport_export_handle,
+		     option_store_number,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported store number.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_threads != NULL )
+	{
+		if( export_handle_set_number_of_threads(
+		     vshadowexport_export_handle,
+		     option_threads,
+		     &error ) != 1 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads defaulting to: %d.\n",
+			 vshadowexport_export_handle->number_of_threads );
+		}
+	}
+	if( option_target_path == NULL )
+	{
+		option_target_path = _SYSTEM_STRING( "vss" );
+	}
+	if( export_handle_set_target_path(
+	     vshadowexport_export_handle,
+	     option_target_path,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set target path.\n" );
+
+		goto on_error;
+	}
+	result = export_handle_open_input(
+	          vshadowexport_export_handle,
+	          source,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "No Volume Shadow Snapshots found.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_signal_attach(
+	     vshadowexport_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = export_handle_export(
+	          vshadowexport_export_handle,
+	          &error );
+
+	if( vshadowtools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result != 1 )
+	{
+		if( vshadowexport_abort != 0 )
+		{
+			fprintf(
+			 stdout,
+			 "Export aborted.\n" );
+		}
+		else
+		{
+			fprintf(
+			 stderr,
+			 "Unable to export stores.\n" );
+		}
+		goto on_error;
+	}
+	if( export_handle_close(
+	     vshadowexport_export_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close export handle.\n" );
+
+		goto on_error;
+	}
+	if( export_handle_free(
+	     &vshadowexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free export handle.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Export completed.\n" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowexport_export_handle != NULL )
+	{
+		export_handle_free(
+		 &vshadowexport_export_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
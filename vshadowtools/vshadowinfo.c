@@ -63,11 +63,15 @@ void usage_fprint(
 	fprintf( stream, "Use vshadowinfo to determine information about a Windows NT Volume Shadow\n"
 	                 "Snapshot (VSS) volume\n\n" );
 
-	fprintf( stream, "Usage: vshadowinfo [ -o offset ] [ -ahvV ] source\n\n" );
+	fprintf( stream, "Usage: vshadowinfo [ -b offset[:size] ] [ -o offset ] [ -ahvV ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file or device\n\n" );
 
 	fprintf( stream, "\t-a:     shows allocation information\n" );
+	fprintf( stream, "\t-b:     shows for every store the source of the data in a range\n"
+	                 "\t        of the volume: the volume, the store itself, a more recent\n"
+	                 "\t        store or sparse, where offset and size are in bytes and\n"
+	                 "\t        size defaults to 16384\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
 	fprintf( stream, "\t-o:     specify the volume offset in bytes\n" );
 	fprintf( stream, "\t-v:     verbose output to stderr\n" );
@@ -126,14 +130,15 @@ int wmain( int argc, wchar_t * const argv[] )
 int main( int argc, char * const argv[] )
 #endif
 {
-	libcerror_error_t *error                 = NULL;
-	system_character_t *option_volume_offset = NULL;
-	system_character_t *source               = NULL;
-	char *program                            = "vshadowinfo";
-	system_integer_t option                  = 0;
-	uint8_t show_allocation_information      = 0;
-	int result                               = 0;
-	int verbose                              = 0;
+	libcerror_error_t *error                     = NULL;
+	system_character_t *option_data_source_range = NULL;
+	system_character_t *option_volume_offset     = NULL;
+	system_character_t *source                   = NULL;
+	char *program                                = "vshadowinfo";
+	system_integer_t option                      = 0;
+	uint8_t show_allocation_information          = 0;
+	int result                                   = 0;
+	int verbose                                  = 0;
 
 	libcnotify_stream_set(
 	 stderr,
@@ -168,7 +173,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = vshadowtools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "aho:vV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "ab:ho:vV" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -189,6 +194,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'b':
+				option_data_source_range = optarg;
+
+				break;
+
 			case (system_integer_t) 'h':
 				usage_fprint(
 				 stdout );
@@ -261,6 +271,20 @@ int main( int argc, char * const argv[] )
 			 vshadowinfo_info_handle->volume_offset );
 		}
 	}
+	if( option_data_source_range != NULL )
+	{
+		if( info_handle_set_data_source_range(
+		     vshadowinfo_info_handle,
+		     option_data_source_range,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported data source range.\n" );
+
+			goto on_error;
+		}
+	}
 	vshadowinfo_info_handle->show_allocation_information = show_allocation_information;
 
 	result = info_handle_open_input(
@@ -285,15 +309,31 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-	if( info_handle_volume_fprint(
-	     vshadowinfo_info_handle,
-	     &error ) != 1 )
+	if( option_data_source_range != NULL )
 	{
-		fprintf(
-		 stderr,
-		 "Unable to print volume information.\n" );
+		if( info_handle_data_sources_fprint(
+		     vshadowinfo_info_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print data sources.\n" );
 
-		goto on_error;
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( info_handle_volume_fprint(
+		     vshadowinfo_info_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print volume information.\n" );
+
+			goto on_error;
+		}
 	}
 	if( info_handle_close(
 	     vshadowinfo_info_handle,
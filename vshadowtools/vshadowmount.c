@@ -66,13 +66,16 @@ void usage_fprint(
 	}
 	fprintf( stream, "Use vshadowmount to mount a Volume Service Snapshot (VSS) volume\n\n" );
 
-	fprintf( stream, "Usage: vshadowmount [ -o offset ] [ -X extended_options ] [ -hvV ] volume\n"
-	                 "                    mount_point\n\n" );
+	fprintf( stream, "Usage: vshadowmount [ -o offset ] [ -X extended_options ] [ -hIvV ]\n"
+	                 "                    volume mount_point\n\n" );
 
 	fprintf( stream, "\tvolume:      a Volume Service Snapshot (VSS) volume\n\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
 
 	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-I:          mount the stores as immutable data, which allows the kernel\n"
+	                 "\t             to cache data, attributes and entries and to issue large\n"
+	                 "\t             asynchronous reads (FUSE only)\n" );
 	fprintf( stream, "\t-o:          specify the volume offset in bytes\n" );
 	fprintf( stream, "\t-v:          verbose output to stderr, while vshadowmount will remain running in\n"
 	                 "\t             the foreground\n" );
@@ -141,6 +144,7 @@ int main( int argc, char * const argv[] )
 	char *program                                = "vshadowmount";
 	system_integer_t option                      = 0;
 	size_t path_prefix_size                      = 0;
+	int immutable_data                           = 0;
 	int result                                   = 0;
 	int verbose                                  = 0;
 
@@ -197,7 +201,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = vshadowtools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "ho:vVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "hIo:vVX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -219,6 +223,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'I':
+				immutable_data = 1;
+
+				break;
+
 			case (system_integer_t) 'o':
 				option_offset = optarg;
 
@@ -285,6 +294,8 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	vshadowmount_mount_handle->immutable_data = immutable_data;
+
 	if( option_offset != NULL )
 	{
 		if( mount_handle_set_offset(
@@ -331,7 +342,8 @@ int main( int argc, char * const argv[] )
 		goto on_error;
 	}
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBFUSE3 ) || defined( HAVE_LIBOSXFUSE )
-	if( option_extended_options != NULL )
+	if( ( option_extended_options != NULL )
+	 || ( immutable_data != 0 ) )
 	{
 		/* This argument is required but ignored
 		 */
@@ -345,6 +357,9 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
+	}
+	if( option_extended_options != NULL )
+	{
 		if( fuse_opt_add_arg(
 		     &vshadowmount_fuse_arguments,
 		     "-o" ) != 0 )
@@ -366,6 +381,29 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( immutable_data != 0 )
+	{
+		if( fuse_opt_add_arg(
+		     &vshadowmount_fuse_arguments,
+		     "-o" ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable add fuse arguments.\n" );
+
+			goto on_error;
+		}
+		if( fuse_opt_add_arg(
+		     &vshadowmount_fuse_arguments,
+		     MOUNT_FUSE_IMMUTABLE_OPTIONS ) != 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable add fuse arguments.\n" );
+
+			goto on_error;
+		}
+	}
 	if( memory_set(
 	     &vshadowmount_fuse_operations,
 	     0,
@@ -384,6 +422,7 @@ int main( int argc, char * const argv[] )
 	vshadowmount_fuse_operations.readdir    = &mount_fuse_readdir;
 	vshadowmount_fuse_operations.releasedir = &mount_fuse_releasedir;
 	vshadowmount_fuse_operations.getattr    = &mount_fuse_getattr;
+	vshadowmount_fuse_operations.init       = &mount_fuse_init;
 	vshadowmount_fuse_operations.destroy    = &mount_fuse_destroy;
 
 #if defined( HAVE_LIBFUSE3 )
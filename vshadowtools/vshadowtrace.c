@@ -0,0 +1,372 @@
+/*
+ * Analyzes and replays traces of the reads of Windows NT Volume Shadow Snapshot (VSS) volumes
+ *
+ * Copyright (C) 2011-2024, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_IO_H ) || defined( WINAPI )
+#include <io.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "trace_handle.h"
+#include "vshadowtools_getopt.h"
+#include "vshadowtools_libcerror.h"
+#include "vshadowtools_libclocale.h"
+#include "vshadowtools_libcnotify.h"
+#include "vshadowtools_output.h"
+#include "vshadowtools_signal.h"
+#include "vshadowtools_unused.h"
+
+trace_handle_t *vshadowtrace_trace_handle = NULL;
+int vshadowtrace_abort                    = 0;
+
+/* Prints usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vshadowtrace to analyze a trace of the reads of a Windows NT\n"
+	                 "Volume Shadow Snapshot (VSS) volume for seek distance and locality\n"
+	                 "and to replay the reads against an image\n\n" );
+
+	fprintf( stream, "Usage: vshadowtrace [ -r image ] [ -hsvV ] trace_file\n\n" );
+
+	fprintf( stream, "\ttrace_file: the trace file created by libvshadow_volume_set_trace_file\n\n" );
+
+	fprintf( stream, "\t-h:         shows this help\n" );
+	fprintf( stream, "\t-r:         replays the reads against the image\n" );
+	fprintf( stream, "\t-s:         creates the image as a sparse file of the volume size\n"
+	                 "\t            before replaying, an existing image is overwritten\n" );
+	fprintf( stream, "\t-v:         verbose output to stderr\n" );
+	fprintf( stream, "\t-V:         print version\n" );
+}
+
+/* Signal handler for vshadowtrace
+ */
+void vshadowtrace_signal_handler(
+      vshadowtools_signal_t signal VSHADOWTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vshadowtrace_signal_handler";
+
+	VSHADOWTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vshadowtrace_abort = 1;
+
+	if( vshadowtrace_trace_handle != NULL )
+	{
+		if( trace_handle_signal_abort(
+		     vshadowtrace_trace_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal trace handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libcerror_error_t *error       = NULL;
+	system_character_t *image      = NULL;
+	system_character_t *trace_file = NULL;
+	char *program                  = "vshadowtrace";
+	system_integer_t option        = 0;
+	uint8_t create_sparse_image    = 0;
+	int result                     = 0;
+	int verbose                    = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+	     "vshadowtools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtools_output_initialize(
+	     _IONBF,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vshadowtools_output_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vshadowtools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "hr:svV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'r':
+				image = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				create_sparse_image = 1;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vshadowtools_output_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing trace file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	trace_file = argv[ optind ];
+
+	if( ( create_sparse_image != 0 )
+	 && ( image == NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Missing image to replay the reads against.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	libcnotify_verbose_set(
+	 verbose );
+
+	if( trace_handle_initialize(
+	     &vshadowtrace_trace_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize trace handle.\n" );
+
+		goto on_error;
+	}
+	if( trace_handle_open(
+	     vshadowtrace_trace_handle,
+	     trace_file,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open trace file: %" PRIs_SYSTEM ".\n",
+		 trace_file );
+
+		goto on_error;
+	}
+	if( vshadowtools_signal_attach(
+	     vshadowtrace_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = trace_handle_analyze(
+	          vshadowtrace_trace_handle,
+	          &error );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to analyze trace file: %" PRIs_SYSTEM ".\n",
+		 trace_file );
+	}
+	else if( ( image != NULL )
+	      && ( vshadowtrace_abort == 0 ) )
+	{
+		result = trace_handle_replay(
+		          vshadowtrace_trace_handle,
+		          image,
+		          create_sparse_image,
+		          &error );
+
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to replay trace file: %" PRIs_SYSTEM " against: %" PRIs_SYSTEM ".\n",
+			 trace_file,
+			 image );
+		}
+	}
+	if( vshadowtools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowtrace_abort != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "Trace aborted.\n" );
+	}
+	if( result != 1 )
+	{
+		goto on_error;
+	}
+	if( trace_handle_close(
+	     vshadowtrace_trace_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close trace file.\n" );
+
+		goto on_error;
+	}
+	if( trace_handle_free(
+	     &vshadowtrace_trace_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free trace handle.\n" );
+
+		goto on_error;
+	}
+	if( vshadowtrace_abort != 0 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vshadowtrace_trace_handle != NULL )
+	{
+		trace_handle_free(
+		 &vshadowtrace_trace_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+